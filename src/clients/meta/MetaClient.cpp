@@ -33,6 +33,9 @@ DEFINE_int32(heartbeat_interval_secs, 10, "Heartbeat interval in seconds");
 DEFINE_int32(meta_client_retry_times, 3, "meta client retry times, 0 means no retry");
 DEFINE_int32(meta_client_retry_interval_secs, 1, "meta client sleep interval between retry");
 DEFINE_int32(meta_client_timeout_ms, 60 * 1000, "meta client timeout");
+DEFINE_string(meta_client_compression,
+              "none",
+              "Compression of the rpc payloads to metad, `none', `zstd' or `zlib'");
 DEFINE_string(cluster_id_path, "cluster.id", "file path saved clusterId");
 DEFINE_int32(check_plan_killed_frequency, 8, "check plan killed every 1<<n times");
 DEFINE_uint32(failed_login_attempts,
@@ -73,7 +76,7 @@ MetaClient::MetaClient(std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool
   CHECK(!addrs_.empty())
       << "No meta server address is specified or can be solved. Meta server is required";
   clientsMan_ = std::make_shared<thrift::ThriftClientManager<cpp2::MetaServiceAsyncClient>>(
-      FLAGS_enable_ssl || FLAGS_enable_meta_ssl);
+      FLAGS_enable_ssl || FLAGS_enable_meta_ssl, FLAGS_meta_client_compression);
   updateActive();
   updateLeader();
   bgThread_ = std::make_unique<thread::GenericWorker>();
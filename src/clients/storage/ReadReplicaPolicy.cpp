@@ -0,0 +1,130 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "clients/storage/ReadReplicaPolicy.h"
+
+#include <folly/Random.h>
+
+DEFINE_bool(enable_storage_hedged_read,
+            false,
+            "Whether to resend the slow read requests to followers");
+DEFINE_double(storage_hedged_read_percentile,
+              95,
+              "A read request is hedged when its latency exceeds the percentile of the latest "
+              "requests of the same kind");
+DEFINE_uint32(storage_hedged_read_min_delay_us,
+              1000,
+              "The minimal delay in microseconds before hedging a read request");
+DEFINE_string(storage_read_routing,
+              "leader",
+              "Where the read requests are sent, `leader' or `latency', the later one spreads "
+              "reads across replicas by observed latency");
+
+namespace nebula {
+namespace storage {
+
+// Number of the latest latencies kept for each rpc
+static constexpr size_t kLatencyWindow = 1000;
+// The percentile is refreshed after so many new samples
+static constexpr size_t kRefreshInterval = 100;
+// Weight of the new sample in the smoothed host latency
+static constexpr double kSmoothingFactor = 0.1;
+
+ReadReplicaPolicy::ReadReplicaPolicy() {
+  hedgeEnabled_ = FLAGS_enable_storage_hedged_read;
+  if (FLAGS_storage_read_routing == "latency") {
+    routeByLatency_ = true;
+  } else if (FLAGS_storage_read_routing != "leader") {
+    LOG(WARNING) << "Unknown storage read routing `" << FLAGS_storage_read_routing
+                 << "', read from leader";
+  }
+}
+
+void ReadReplicaPolicy::addRpcLatency(const std::string& rpc, uint64_t latencyInUs) {
+  std::lock_guard<std::mutex> guard(rpcLock_);
+  auto& latency = rpcLatencies_[rpc];
+  if (latency.samples.size() < kLatencyWindow) {
+    latency.samples.emplace_back(latencyInUs);
+  } else {
+    latency.samples[latency.next] = latencyInUs;
+    latency.next = (latency.next + 1) % kLatencyWindow;
+  }
+  if (++latency.sinceLastUpdate < kRefreshInterval) {
+    return;
+  }
+  latency.sinceLastUpdate = 0;
+  auto samples = latency.samples;
+  auto percentile = std::clamp(FLAGS_storage_hedged_read_percentile, 0.0, 100.0);
+  auto nth = samples.begin() + static_cast<size_t>((samples.size() - 1) * percentile / 100);
+  std::nth_element(samples.begin(), nth, samples.end());
+  latency.delayInUs = std::max<uint64_t>(*nth, FLAGS_storage_hedged_read_min_delay_us);
+}
+
+void ReadReplicaPolicy::addHostLatency(const HostAddr& host, uint64_t latencyInUs) {
+  std::lock_guard<std::mutex> guard(hostLock_);
+  auto iter = hostLatencies_.find(host);
+  if (iter == hostLatencies_.end()) {
+    hostLatencies_.emplace(host, latencyInUs);
+  } else {
+    iter->second = iter->second * (1 - kSmoothingFactor) + latencyInUs * kSmoothingFactor;
+  }
+}
+
+std::optional<std::chrono::microseconds> ReadReplicaPolicy::hedgeDelay(
+    const std::string& rpc) const {
+  std::lock_guard<std::mutex> guard(rpcLock_);
+  auto iter = rpcLatencies_.find(rpc);
+  if (iter == rpcLatencies_.end() || !iter->second.delayInUs.has_value()) {
+    return std::nullopt;
+  }
+  return std::chrono::microseconds(*iter->second.delayInUs);
+}
+
+double ReadReplicaPolicy::hostLatency(const HostAddr& host) const {
+  std::lock_guard<std::mutex> guard(hostLock_);
+  auto iter = hostLatencies_.find(host);
+  return iter == hostLatencies_.end() ? 0 : iter->second;
+}
+
+HostAddr ReadReplicaPolicy::pickReplica(const std::vector<HostAddr>& replicas,
+                                        const HostAddr& leader) const {
+  if (replicas.size() < 2) {
+    return leader;
+  }
+  // The power of two choices, which avoids sending all reads to the fastest replica
+  auto first = folly::Random::rand32(replicas.size());
+  auto second = folly::Random::rand32(replicas.size() - 1);
+  if (second >= first) {
+    second++;
+  }
+  const auto& a = replicas[first];
+  const auto& b = replicas[second];
+  auto latencyA = hostLatency(a);
+  auto latencyB = hostLatency(b);
+  if (latencyA == latencyB) {
+    return a == leader || b == leader ? leader : a;
+  }
+  return latencyA < latencyB ? a : b;
+}
+
+std::optional<HostAddr> ReadReplicaPolicy::pickFollower(const std::vector<HostAddr>& replicas,
+                                                        const HostAddr& leader) const {
+  std::optional<HostAddr> follower;
+  double minLatency = 0;
+  for (const auto& replica : replicas) {
+    if (replica == leader) {
+      continue;
+    }
+    auto latency = hostLatency(replica);
+    if (!follower.has_value() || latency < minLatency) {
+      follower = replica;
+      minLatency = latency;
+    }
+  }
+  return follower;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,86 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CLIENTS_STORAGE_READREPLICAPOLICY_H_
+#define CLIENTS_STORAGE_READREPLICAPOLICY_H_
+
+#include <boost/core/noncopyable.hpp>
+
+#include "common/base/Base.h"
+#include "common/datatypes/HostAddr.h"
+
+DECLARE_bool(enable_storage_hedged_read);
+DECLARE_double(storage_hedged_read_percentile);
+DECLARE_uint32(storage_hedged_read_min_delay_us);
+DECLARE_string(storage_read_routing);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * ReadReplicaPolicy decides where and when the read requests of storage client are sent.
+ *
+ * Hedged read: when a request to the leader is not answered within the given percentile of
+ * the latencies of the same kind of rpc, the parts are sent to followers as well, and the first
+ * good answer is taken. Routing by latency: the parts are sent to the replica with lower
+ * observed latency of two randomly chosen ones, which spreads read load across replicas.
+ *
+ * Followers wait for the read index of leader before serving these reads unless storaged turns
+ * off --follower_read_index, which adds a round trip to the leader, so both are disabled by
+ * default.
+ */
+class ReadReplicaPolicy final : private boost::noncopyable {
+ public:
+  ReadReplicaPolicy();
+
+  bool hedgeEnabled() const {
+    return hedgeEnabled_;
+  }
+
+  bool routeByLatency() const {
+    return routeByLatency_;
+  }
+
+  // Record the latency of a request sent to the leader.
+  void addRpcLatency(const std::string& rpc, uint64_t latencyInUs);
+
+  // Record the latency of any request sent to the host.
+  void addHostLatency(const HostAddr& host, uint64_t latencyInUs);
+
+  // The delay before hedging a request of the rpc, none if there are not enough samples.
+  std::optional<std::chrono::microseconds> hedgeDelay(const std::string& rpc) const;
+
+  // Pick the replica to read from, the leader is preferred if the latencies are the same.
+  HostAddr pickReplica(const std::vector<HostAddr>& replicas, const HostAddr& leader) const;
+
+  // Pick a follower to hedge to, none if there is no follower.
+  std::optional<HostAddr> pickFollower(const std::vector<HostAddr>& replicas,
+                                       const HostAddr& leader) const;
+
+ private:
+  // The latencies of the latest requests of a rpc
+  struct RpcLatency {
+    std::vector<uint64_t> samples;
+    size_t next{0};
+    size_t sinceLastUpdate{0};
+    std::optional<uint64_t> delayInUs;
+  };
+
+  // Smoothed latency of the host, 0 if the host has not been requested
+  double hostLatency(const HostAddr& host) const;
+
+  bool hedgeEnabled_{false};
+  bool routeByLatency_{false};
+
+  mutable std::mutex rpcLock_;
+  std::unordered_map<std::string, RpcLatency> rpcLatencies_;
+
+  mutable std::mutex hostLock_;
+  std::unordered_map<HostAddr, double> hostLatencies_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // CLIENTS_STORAGE_READREPLICAPOLICY_H_
@@ -557,6 +557,48 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> StorageClient::lookupIndex(
                          });
 }
 
+StorageRpcRespFuture<cpp2::TextSearchResponse> StorageClient::textSearch(
+    const CommonRequestParam& param,
+    bool isEdge,
+    int32_t tagOrEdge,
+    const std::string& indexName,
+    const std::string& query,
+    int64_t limit) {
+  auto space = param.space;
+  auto status = getHostParts(space);
+  if (!status.ok()) {
+    return folly::makeFuture<StorageRpcResponse<cpp2::TextSearchResponse>>(
+        std::runtime_error(status.status().toString()));
+  }
+  nebula::cpp2::SchemaID schemaId;
+  if (isEdge) {
+    schemaId.edge_type_ref() = tagOrEdge;
+  } else {
+    schemaId.tag_id_ref() = tagOrEdge;
+  }
+
+  auto& clusters = status.value();
+  std::unordered_map<HostAddr, cpp2::TextSearchRequest> requests;
+  auto common = param.toReqCommon();
+  for (auto& c : clusters) {
+    auto& host = c.first;
+    auto& req = requests[host];
+    req.space_id_ref() = space;
+    req.parts_ref() = std::move(c.second);
+    req.schema_id_ref() = schemaId;
+    req.index_name_ref() = indexName;
+    req.query_ref() = query;
+    req.limit_ref() = limit;
+    req.common_ref() = common;
+  }
+
+  return collectResponse(param.evb,
+                         std::move(requests),
+                         [](ThriftClientType* client, const cpp2::TextSearchRequest& r) {
+                           return client->future_textSearch(r);
+                         });
+}
+
 StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::lookupAndTraverse(
     const CommonRequestParam& param, cpp2::IndexSpec indexSpec, cpp2::TraverseSpec traverseSpec) {
   auto space = param.space;
@@ -152,6 +152,13 @@ class StorageClient
   StorageRpcRespFuture<cpp2::GetNeighborsResponse> lookupAndTraverse(
       const CommonRequestParam& param, cpp2::IndexSpec indexSpec, cpp2::TraverseSpec traverseSpec);
 
+  StorageRpcRespFuture<cpp2::TextSearchResponse> textSearch(const CommonRequestParam& param,
+                                                            bool isEdge,
+                                                            int32_t tagOrEdge,
+                                                            const std::string& indexName,
+                                                            const std::string& query,
+                                                            int64_t limit);
+
   StorageRpcRespFuture<cpp2::ScanResponse> scanEdge(const CommonRequestParam& param,
                                                     const std::vector<cpp2::EdgeProp>& vertexProp,
                                                     int64_t limit,
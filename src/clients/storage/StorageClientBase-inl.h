@@ -8,7 +8,9 @@
 
 #include <folly/ExceptionWrapper.h>
 #include <folly/Try.h>
+#include <folly/executors/GlobalExecutor.h>
 #include <folly/futures/Future.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 
 #include <optional>
 #include <unordered_map>
@@ -20,6 +22,7 @@
 #include "common/memory/MemoryTracker.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/stats/StatsManager.h"
+#include "common/thrift/RpcCompression.h"
 #include "common/thrift/ThriftTypes.h"
 #include "common/time/WallClock.h"
 #include "interface/gen-cpp2/common_types.h"
@@ -31,7 +34,9 @@ template <typename ClientType, typename ClientManagerType>
 StorageClientBase<ClientType, ClientManagerType>::StorageClientBase(
     std::shared_ptr<folly::IOThreadPoolExecutor> threadPool, meta::MetaClient* metaClient)
     : metaClient_(metaClient), ioThreadPool_(threadPool) {
-  clientsMan_ = std::make_unique<ClientManagerType>(FLAGS_enable_ssl);
+  clientsMan_ = std::make_unique<ClientManagerType>(FLAGS_enable_ssl,
+                                                    FLAGS_storage_client_compression);
+  readPolicy_ = std::make_unique<ReadReplicaPolicy>();
 }
 
 template <typename ClientType, typename ClientManagerType>
@@ -77,7 +82,12 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
     std::unordered_map<HostAddr, Request> requests,
     RemoteFunc&& remoteFunc) {
   memory::MemoryCheckOffGuard offGuard;
-  std::vector<folly::Future<StatusOr<Response>>> respFutures;
+  if constexpr (ReplicaReadTraits<Request>::kReplicaReadable) {
+    if (readPolicy_->routeByLatency()) {
+      requests = routeReadRequests(std::move(requests));
+    }
+  }
+  std::vector<folly::Future<StatusOr<std::vector<Response>>>> respFutures;
   respFutures.reserve(requests.size());
 
   auto hosts = std::make_shared<std::vector<HostAddr>>(requests.size());
@@ -91,7 +101,7 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
     // Future process code will be executed on the IO thread
     // Since all requests are sent using the same eventbase, all
     // then-callback will be executed on the same IO thread
-    auto fut = getResponse(evb, req.first, req.second, std::move(remoteFunc))
+    auto fut = getResponses<Request, RemoteFunc, Response>(evb, req.first, req.second, remoteFunc)
                    .ensure([totalLatencies, i, start]() {
                      (*totalLatencies)[i] = time::WallClock::fastNowInMicroSec() - start;
                    });
@@ -101,13 +111,13 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
 
   return folly::collectAll(respFutures)
       .deferValue([this, requests = std::move(requests), totalLatencies, hosts](
-                      std::vector<folly::Try<StatusOr<Response>>>&& resps) {
+                      std::vector<folly::Try<StatusOr<std::vector<Response>>>>&& resps) {
         // throw in MemoryCheckGuard verified
         memory::MemoryCheckGuard guard;
         StorageRpcResponse<Response> rpcResp(resps.size());
         for (size_t i = 0; i < resps.size(); i++) {
           const auto& host = hosts->at(i);
-          folly::Try<StatusOr<Response>>& tryResp = resps[i];
+          folly::Try<StatusOr<std::vector<Response>>>& tryResp = resps[i];
           if (tryResp.hasException()) {
             std::string errMsg = tryResp.exception().what().toStdString();
             rpcResp.markFailure();
@@ -116,23 +126,29 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
             const auto& parts = getReqPartsId(req);
             rpcResp.appendFailedParts(parts, nebula::cpp2::ErrorCode::E_RPC_FAILURE);
           } else {
-            StatusOr<Response> status = std::move(tryResp).value();
+            StatusOr<std::vector<Response>> status = std::move(tryResp).value();
             if (status.ok()) {
-              auto resp = std::move(status).value();
-              const auto& result = resp.get_result();
+              // There are multiple responses only if the request is hedged to followers
+              bool failed = false;
+              for (auto& resp : status.value()) {
+                const auto& result = resp.get_result();
+
+                if (!result.get_failed_parts().empty()) {
+                  failed = true;
+                  for (auto& part : result.get_failed_parts()) {
+                    rpcResp.emplaceFailedPart(part.get_part_id(), part.get_code());
+                  }
+                }
 
-              if (!result.get_failed_parts().empty()) {
+                // Adjust the latency
+                auto latency = result.get_latency_in_us();
+                rpcResp.setLatency(host, latency, totalLatencies->at(i));
+                // Keep the response
+                rpcResp.addResponse(std::move(resp));
+              }
+              if (failed) {
                 rpcResp.markFailure();
-                for (auto& part : result.get_failed_parts()) {
-                  rpcResp.emplaceFailedPart(part.get_part_id(), part.get_code());
-                }
               }
-
-              // Adjust the latency
-              auto latency = result.get_latency_in_us();
-              rpcResp.setLatency(host, latency, totalLatencies->at(i));
-              // Keep the response
-              rpcResp.addResponse(std::move(resp));
             } else {
               rpcResp.markFailure();
               Status s = std::move(status).status();
@@ -205,6 +221,7 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
               break;
           }
         }
+        sampleCompression(resp);
         return std::move(resp);
       })
       .thenError(
@@ -236,6 +253,228 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
       });
 }
 
+template <typename ClientType, typename ClientManagerType>
+template <class Response>
+void StorageClientBase<ClientType, ClientManagerType>::sampleCompression(const Response& resp) {
+  auto interval = FLAGS_storage_client_compression_sample_interval;
+  if (interval == 0 || FLAGS_storage_client_compression == "none" ||
+      numResponses_.fetch_add(1, std::memory_order_relaxed) % interval != 0) {
+    return;
+  }
+  // Only the copy is made on the io thread, the response is encoded and compressed in the same way
+  // as rocket does on the cpu executor
+  auto sampled = std::make_shared<Response>(resp);
+  folly::getGlobalCPUExecutor()->add([sampled = std::move(sampled)] {
+    auto payload = apache::thrift::CompactSerializer::serialize<std::string>(*sampled);
+    auto sample =
+        thrift::sampleCompression(FLAGS_storage_client_compression, folly::range(payload));
+    if (!sample.has_value()) {
+      return;
+    }
+    stats::StatsManager::addValue(kRpcCompressionSampledBytes, sample->rawBytes);
+    stats::StatsManager::addValue(kRpcCompressionSampledCompressedBytes, sample->compressedBytes);
+    stats::StatsManager::addValue(kRpcCompressionLatencyUs, sample->costInUs);
+  });
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class RemoteFunc, class Response>
+folly::Future<StatusOr<std::vector<Response>>>
+StorageClientBase<ClientType, ClientManagerType>::getResponses(folly::EventBase* evb,
+                                                               const HostAddr& host,
+                                                               const Request& request,
+                                                               RemoteFunc remoteFunc) {
+  auto toResponses = [](StatusOr<Response>&& resp) -> StatusOr<std::vector<Response>> {
+    if (!resp.ok()) {
+      return std::move(resp).status();
+    }
+    std::vector<Response> resps;
+    resps.emplace_back(std::move(resp).value());
+    return resps;
+  };
+  if constexpr (!ReplicaReadTraits<Request>::kReplicaReadable) {
+    return getResponse(evb, host, request, std::move(remoteFunc)).thenValue(toResponses);
+  } else {
+    if (evb == nullptr) {
+      evb = DCHECK_NOTNULL(ioThreadPool_)->getEventBase();
+    }
+    const std::string rpc = ReplicaReadTraits<Request>::kName;
+    auto start = time::WallClock::fastNowInMicroSec();
+    auto primary = getResponse(evb, host, request, RemoteFunc(remoteFunc))
+                       .ensure([this, rpc, host, start]() {
+                         auto latency = time::WallClock::fastNowInMicroSec() - start;
+                         readPolicy_->addRpcLatency(rpc, latency);
+                         readPolicy_->addHostLatency(host, latency);
+                       })
+                       .thenValue(toResponses);
+    auto delay = readPolicy_->hedgeEnabled() ? readPolicy_->hedgeDelay(rpc) : std::nullopt;
+    if (!delay.has_value()) {
+      return primary;
+    }
+
+    // Both the leader and the hedged requests report to the state, the first good answer wins
+    struct HedgeState {
+      std::atomic<bool> done{false};
+      std::atomic<int32_t> pending{2};
+      std::mutex lock;
+      std::optional<StatusOr<std::vector<Response>>> primaryResult;
+      folly::Promise<StatusOr<std::vector<Response>>> promise;
+    };
+    auto state = std::make_shared<HedgeState>();
+    auto finish = [state](StatusOr<std::vector<Response>>&& result, bool fromPrimary) {
+      bool good = result.ok() && std::all_of(result.value().begin(),
+                                             result.value().end(),
+                                             [](const Response& resp) {
+                                               return resp.get_result().get_failed_parts().empty();
+                                             });
+      if (good) {
+        if (!state->done.exchange(true)) {
+          if (!fromPrimary) {
+            stats::StatsManager::addValue(kNumHedgedRpcWon);
+          }
+          state->promise.setValue(std::move(result));
+        }
+      } else if (fromPrimary) {
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->primaryResult = std::move(result);
+      }
+      if (--state->pending == 0 && !state->done.exchange(true)) {
+        // Neither answer is good, the one from the leader is returned
+        std::lock_guard<std::mutex> guard(state->lock);
+        state->promise.setValue(std::move(state->primaryResult).value());
+      }
+    };
+    auto future = state->promise.getFuture();
+
+    std::move(primary).thenTry([finish](folly::Try<StatusOr<std::vector<Response>>>&& t) {
+      if (t.hasException()) {
+        finish(Status::Error("%s", t.exception().what().c_str()), true);
+      } else {
+        finish(std::move(t).value(), true);
+      }
+    });
+
+    folly::futures::sleep(*delay)
+        .via(evb)
+        .thenValue([this, state, evb, host, request, remoteFunc](auto&&)
+                       -> folly::Future<StatusOr<std::vector<Response>>> {
+          if (state->done) {
+            return folly::makeFuture<StatusOr<std::vector<Response>>>(Status::Error("Not hedged"));
+          }
+          auto spaceId = request.get_space_id();
+          auto requests =
+              splitRequest(host, request, [&](PartitionID partId) -> std::optional<HostAddr> {
+                auto partHosts = getPartHosts(spaceId, partId);
+                if (!partHosts.ok()) {
+                  return std::nullopt;
+                }
+                return readPolicy_->pickFollower(partHosts.value().hosts_, host);
+              });
+          if (requests.empty()) {
+            return folly::makeFuture<StatusOr<std::vector<Response>>>(
+                Status::Error("No follower to hedge"));
+          }
+          std::vector<folly::Future<StatusOr<Response>>> futures;
+          futures.reserve(requests.size());
+          for (auto& [follower, req] : requests) {
+            stats::StatsManager::addValue(kNumHedgedRpcSentToStoraged);
+            auto hedgeStart = time::WallClock::fastNowInMicroSec();
+            futures.emplace_back(getResponse(evb, follower, req, RemoteFunc(remoteFunc))
+                                     .ensure([this, follower = follower, hedgeStart]() {
+                                       readPolicy_->addHostLatency(
+                                           follower,
+                                           time::WallClock::fastNowInMicroSec() - hedgeStart);
+                                     }));
+          }
+          return folly::collectAll(futures).via(evb).thenValue(
+              [](std::vector<folly::Try<StatusOr<Response>>>&& tries)
+                  -> StatusOr<std::vector<Response>> {
+                std::vector<Response> resps;
+                resps.reserve(tries.size());
+                for (auto& t : tries) {
+                  if (t.hasException()) {
+                    return Status::Error("%s", t.exception().what().c_str());
+                  }
+                  if (!t.value().ok()) {
+                    return t.value().status();
+                  }
+                  resps.emplace_back(std::move(t.value()).value());
+                }
+                return resps;
+              });
+        })
+        .thenTry([finish](folly::Try<StatusOr<std::vector<Response>>>&& t) {
+          if (t.hasException()) {
+            finish(Status::Error("%s", t.exception().what().c_str()), false);
+          } else {
+            finish(std::move(t).value(), false);
+          }
+        });
+    return future;
+  }
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request>
+std::unordered_map<HostAddr, Request>
+StorageClientBase<ClientType, ClientManagerType>::routeReadRequests(
+    std::unordered_map<HostAddr, Request> requests) const {
+  std::unordered_map<HostAddr, Request> routed;
+  for (auto& [leader, request] : requests) {
+    auto spaceId = request.get_space_id();
+    auto pickHost = [&, &l = leader](PartitionID partId) -> std::optional<HostAddr> {
+      auto partHosts = getPartHosts(spaceId, partId);
+      if (!partHosts.ok()) {
+        return l;
+      }
+      return readPolicy_->pickReplica(partHosts.value().hosts_, l);
+    };
+    auto split = splitRequest(leader, std::move(request), std::move(pickHost));
+    for (auto& [host, req] : split) {
+      auto iter = routed.find(host);
+      if (iter == routed.end()) {
+        routed.emplace(host, std::move(req));
+        continue;
+      }
+      // The requests of different leaders only differ in parts
+      for (auto& part : *req.parts_ref()) {
+        iter->second.parts_ref()->emplace(part.first, std::move(part.second));
+      }
+      const auto& common = req.common_ref();
+      if (common.has_value() && common->read_from_follower_ref().value_or(false)) {
+        setReadFromFollower(iter->second);
+      }
+    }
+  }
+  return routed;
+}
+
+template <typename ClientType, typename ClientManagerType>
+template <class Request, class PickHost>
+std::unordered_map<HostAddr, Request>
+StorageClientBase<ClientType, ClientManagerType>::splitRequest(const HostAddr& leader,
+                                                               Request request,
+                                                               PickHost&& pickHost) const {
+  auto parts = std::move(*request.parts_ref());
+  request.parts_ref()->clear();
+  std::unordered_map<HostAddr, Request> requests;
+  for (auto& [partId, data] : parts) {
+    auto host = pickHost(partId);
+    if (!host.has_value()) {
+      return {};
+    }
+    auto iter = requests.find(*host);
+    if (iter == requests.end()) {
+      iter = requests.emplace(*host, request).first;
+      if (*host != leader) {
+        setReadFromFollower(iter->second);
+      }
+    }
+    iter->second.parts_ref()->emplace(partId, std::move(data));
+  }
+  return requests;
+}
+
 template <typename ClientType, typename ClientManagerType>
 template <class Container, class GetIdFunc>
 StatusOr<std::unordered_map<
@@ -9,6 +9,13 @@ DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
 DEFINE_uint32(storage_client_retry_interval_ms,
               1000,
               "storage client sleep interval milliseconds between retry");
+DEFINE_string(storage_client_compression,
+              "none",
+              "Compression of the rpc payloads to storaged, `none', `zstd' or `zlib'");
+DEFINE_uint32(storage_client_compression_sample_interval,
+              100,
+              "Estimate the effect of compression on one of so many storage responses, 0 means "
+              "never");
 
 namespace nebula {
 namespace storage {}  // namespace storage
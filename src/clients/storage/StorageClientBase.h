@@ -10,6 +10,7 @@
 #include <folly/futures/Future.h>
 
 #include "clients/meta/MetaClient.h"
+#include "clients/storage/ReadReplicaPolicy.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
@@ -19,6 +20,8 @@
 
 DECLARE_int32(storage_client_timeout_ms);
 DECLARE_uint32(storage_client_retry_interval_ms);
+DECLARE_string(storage_client_compression);
+DECLARE_uint32(storage_client_compression_sample_interval);
 
 namespace nebula {
 namespace storage {
@@ -104,6 +107,33 @@ class StorageRpcResponse final {
   std::vector<std::tuple<HostAddr, int32_t, int32_t>> hostLatency_;
 };
 
+/**
+ * The read requests which could be served by followers, they may be hedged or routed to the
+ * followers according to the ReadReplicaPolicy. The parts of them must be kept in `parts'.
+ */
+template <class Request>
+struct ReplicaReadTraits {
+  static constexpr bool kReplicaReadable = false;
+};
+
+template <>
+struct ReplicaReadTraits<cpp2::GetNeighborsRequest> {
+  static constexpr bool kReplicaReadable = true;
+  static constexpr const char* kName = "get_neighbors";
+};
+
+template <>
+struct ReplicaReadTraits<cpp2::GetDstBySrcRequest> {
+  static constexpr bool kReplicaReadable = true;
+  static constexpr const char* kName = "get_dst_by_src";
+};
+
+template <>
+struct ReplicaReadTraits<cpp2::GetPropRequest> {
+  static constexpr bool kReplicaReadable = true;
+  static constexpr const char* kName = "get_props";
+};
+
 /**
  * A base class for all storage clients
  */
@@ -139,6 +169,26 @@ class StorageClientBase {
                                                 const Request& request,
                                                 RemoteFunc&& remoteFunc);
 
+  // Same as getResponse, but the parts of a read request are hedged to followers if the host
+  // is slow. There are multiple responses if the hedged requests win.
+  template <class Request, class RemoteFunc, class Response>
+  folly::Future<StatusOr<std::vector<Response>>> getResponses(folly::EventBase* evb,
+                                                              const HostAddr& host,
+                                                              const Request& request,
+                                                              RemoteFunc remoteFunc);
+
+  // Split the parts of read requests to the replicas chosen by the ReadReplicaPolicy.
+  template <class Request>
+  std::unordered_map<HostAddr, Request> routeReadRequests(
+      std::unordered_map<HostAddr, Request> requests) const;
+
+  // Split the parts of a request to the hosts picked, the request sent to a follower is marked
+  // as readable from follower. Nothing is returned if no host is picked for any part.
+  template <class Request, class PickHost>
+  std::unordered_map<HostAddr, Request> splitRequest(const HostAddr& leader,
+                                                     Request request,
+                                                     PickHost&& pickHost) const;
+
   // Cluster given ids into the host they belong to
   // The method returns a map
   //  host_addr (A host, but in most case, the leader will be chosen)
@@ -194,6 +244,19 @@ class StorageClientBase {
     return {req.get_part_id()};
   }
 
+  template <typename Request>
+  static void setReadFromFollower(Request& req) {
+    if (!req.common_ref().has_value()) {
+      req.common_ref() = cpp2::RequestCommon();
+    }
+    req.common_ref()->read_from_follower_ref() = true;
+  }
+
+  // Measure the bytes and the cpu spent by compressing the response off the io thread, on one of
+  // --storage_client_compression_sample_interval responses.
+  template <class Response>
+  void sampleCompression(const Response& resp);
+
   bool isValidHostPtr(const HostAddr* addr) {
     return addr != nullptr && !addr->host.empty() && addr->port != 0;
   }
@@ -204,6 +267,8 @@ class StorageClientBase {
  private:
   std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
   std::unique_ptr<ClientManagerType> clientsMan_;
+  std::unique_ptr<ReadReplicaPolicy> readPolicy_;
+  std::atomic<uint64_t> numResponses_{0};
 };
 
 }  // namespace storage
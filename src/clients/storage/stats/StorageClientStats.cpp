@@ -9,12 +9,26 @@ namespace nebula {
 
 stats::CounterId kNumRpcSentToStoraged;
 stats::CounterId kNumRpcSentToStoragedFailed;
+stats::CounterId kNumHedgedRpcSentToStoraged;
+stats::CounterId kNumHedgedRpcWon;
+stats::CounterId kRpcCompressionSampledBytes;
+stats::CounterId kRpcCompressionSampledCompressedBytes;
+stats::CounterId kRpcCompressionLatencyUs;
 
 void initStorageClientStats() {
   kNumRpcSentToStoraged =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged", "rate, sum");
   kNumRpcSentToStoragedFailed =
       stats::StatsManager::registerStats("num_rpc_sent_to_storaged_failed", "rate, sum");
+  kNumHedgedRpcSentToStoraged =
+      stats::StatsManager::registerStats("num_hedged_rpc_sent_to_storaged", "rate, sum");
+  kNumHedgedRpcWon = stats::StatsManager::registerStats("num_hedged_rpc_won", "rate, sum");
+  kRpcCompressionSampledBytes = stats::StatsManager::registerStats(
+      "storage_client_compression_sampled_bytes", "rate, sum");
+  kRpcCompressionSampledCompressedBytes = stats::StatsManager::registerStats(
+      "storage_client_compression_sampled_compressed_bytes", "rate, sum");
+  kRpcCompressionLatencyUs = stats::StatsManager::registerHisto(
+      "storage_client_compression_latency_us", 1000, 0, 100000, "avg, p75, p95, p99");
 }
 
 }  // namespace nebula
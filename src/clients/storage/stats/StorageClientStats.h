@@ -12,6 +12,11 @@ namespace nebula {
 
 extern stats::CounterId kNumRpcSentToStoraged;
 extern stats::CounterId kNumRpcSentToStoragedFailed;
+extern stats::CounterId kNumHedgedRpcSentToStoraged;
+extern stats::CounterId kNumHedgedRpcWon;
+extern stats::CounterId kRpcCompressionSampledBytes;
+extern stats::CounterId kRpcCompressionSampledCompressedBytes;
+extern stats::CounterId kRpcCompressionLatencyUs;
 
 void initStorageClientStats();
 
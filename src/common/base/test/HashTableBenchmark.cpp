@@ -0,0 +1,191 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/base/Base.h"
+#include "common/datatypes/HashTable.h"
+
+using nebula::HashMap;
+using nebula::HashSet;
+using nebula::List;
+using nebula::Row;
+using nebula::RowHashTable;
+using nebula::Value;
+
+// Keys are repeated "dup" times on average, the same as the build side of a join on a non-unique
+// key, or the input of a group by
+std::vector<Value> makeIntKeys(size_t size, size_t dup) {
+  std::vector<Value> keys;
+  keys.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    keys.emplace_back(static_cast<int64_t>(folly::Random::rand64(size / dup + 1)));
+  }
+  return keys;
+}
+
+std::vector<Value> makeStringKeys(size_t size, size_t dup) {
+  std::vector<Value> keys;
+  keys.reserve(size);
+  for (size_t i = 0; i < size; i++) {
+    keys.emplace_back("vertex_" + folly::to<std::string>(folly::Random::rand64(size / dup + 1)));
+  }
+  return keys;
+}
+
+std::vector<List> makeListKeys(size_t size, size_t dup) {
+  std::vector<List> keys;
+  keys.reserve(size);
+  auto ints = makeIntKeys(size, dup);
+  auto strs = makeStringKeys(size, dup);
+  for (size_t i = 0; i < size; i++) {
+    keys.emplace_back(List({ints[i], strs[i]}));
+  }
+  return keys;
+}
+
+std::vector<Row> makeRows(const std::vector<Value>& keys) {
+  std::vector<Row> rows;
+  rows.reserve(keys.size());
+  for (const auto& key : keys) {
+    rows.emplace_back(Row({key, Value("name"), Value(18L)}));
+  }
+  return rows;
+}
+
+// Build a table from the rows and probe it with the keys, as what hash join does
+size_t StdJoin(size_t iters, const std::vector<Value>& keys) {
+  std::vector<Row> rows;
+  BENCHMARK_SUSPEND {
+    rows = makeRows(keys);
+  }
+  for (size_t n = 0; n < iters; n++) {
+    std::unordered_map<Value, std::vector<const Row*>> table;
+    table.reserve(rows.size());
+    for (const auto& row : rows) {
+      table[row.values[0]].emplace_back(&row);
+    }
+    size_t matched = 0;
+    for (const auto& key : keys) {
+      auto found = table.find(key);
+      if (found != table.end()) {
+        matched += found->second.size();
+      }
+    }
+    folly::doNotOptimizeAway(matched);
+  }
+  return iters * keys.size();
+}
+
+size_t RowHashTableJoin(size_t iters, const std::vector<Value>& keys) {
+  std::vector<Row> rows;
+  BENCHMARK_SUSPEND {
+    rows = makeRows(keys);
+  }
+  for (size_t n = 0; n < iters; n++) {
+    RowHashTable<Value> table;
+    table.reserve(rows.size());
+    for (const auto& row : rows) {
+      table.add(row.values[0], &row);
+    }
+    size_t matched = 0;
+    for (const auto& key : keys) {
+      const auto* found = table.find(key);
+      if (found != nullptr) {
+        matched += found->size();
+      }
+    }
+    folly::doNotOptimizeAway(matched);
+  }
+  return iters * keys.size();
+}
+
+// Count the rows of each group, as what aggregate does
+size_t StdGroupBy(size_t iters, const std::vector<List>& keys) {
+  for (size_t n = 0; n < iters; n++) {
+    std::unordered_map<List, int64_t> groups;
+    for (const auto& key : keys) {
+      groups[key]++;
+    }
+    folly::doNotOptimizeAway(groups.size());
+  }
+  return iters * keys.size();
+}
+
+size_t HashMapGroupBy(size_t iters, const std::vector<List>& keys) {
+  for (size_t n = 0; n < iters; n++) {
+    HashMap<List, int64_t> groups;
+    for (const auto& key : keys) {
+      groups[key]++;
+    }
+    folly::doNotOptimizeAway(groups.size());
+  }
+  return iters * keys.size();
+}
+
+// Remove the duplicated rows, as what dedup does
+size_t StdDedup(size_t iters, const std::vector<Value>& keys) {
+  std::vector<Row> rows;
+  BENCHMARK_SUSPEND {
+    rows = makeRows(keys);
+  }
+  for (size_t n = 0; n < iters; n++) {
+    std::unordered_set<const Row*> unique;
+    unique.reserve(rows.size());
+    for (const auto& row : rows) {
+      unique.emplace(&row);
+    }
+    folly::doNotOptimizeAway(unique.size());
+  }
+  return iters * keys.size();
+}
+
+size_t HashSetDedup(size_t iters, const std::vector<Value>& keys) {
+  std::vector<Row> rows;
+  BENCHMARK_SUSPEND {
+    rows = makeRows(keys);
+  }
+  for (size_t n = 0; n < iters; n++) {
+    HashSet<const Row*> unique;
+    unique.reserve(rows.size());
+    for (const auto& row : rows) {
+      unique.insert(&row);
+    }
+    folly::doNotOptimizeAway(unique.size());
+  }
+  return iters * keys.size();
+}
+
+static const auto kIntKeys = makeIntKeys(100000, 4);
+static const auto kStringKeys = makeStringKeys(100000, 4);
+static const auto kUniqueIntKeys = makeIntKeys(100000, 1);
+static const auto kListKeys = makeListKeys(100000, 16);
+
+BENCHMARK_NAMED_PARAM_MULTI(StdJoin, IntKey, kIntKeys)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(RowHashTableJoin, IntKey, kIntKeys)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(StdJoin, UniqueIntKey, kUniqueIntKeys)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(RowHashTableJoin, UniqueIntKey, kUniqueIntKeys)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(StdJoin, StringKey, kStringKeys)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(RowHashTableJoin, StringKey, kStringKeys)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(StdGroupBy, ListKey, kListKeys)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(HashMapGroupBy, ListKey, kListKeys)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM_MULTI(StdDedup, IntKey, kIntKeys)
+BENCHMARK_RELATIVE_NAMED_PARAM_MULTI(HashSetDedup, IntKey, kIntKeys)
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,339 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_HASHTABLE_H_
+#define COMMON_DATATYPES_HASHTABLE_H_
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+
+#include "common/base/Arena.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/Value.h"
+
+// Hash tables keyed by Value, List or row pointer, which are shared by the executors of graph,
+// such as join, aggregate, dedup, set operations and apply.
+//
+// They are built on folly F14 tables, i.e. open addressing tables whose slots are grouped into
+// chunks of 14, and the tags of a chunk are probed together by SIMD instructions (SSE2 or NEON).
+// The 64-bit hash of each key is computed only once and cached beside the key, so neither
+// growing the table nor comparing keys hashes the strings or lists again.
+
+namespace nebula {
+
+/**
+ * @brief Well mixed 64-bit hash of Value, List and row pointer. std::hash<Value> returns ints as
+ * they are, which makes the sequential ids collide in the same chunks of an open addressing table.
+ */
+struct ValueHasher {
+  uint64_t operator()(const Value& value) const {
+    return folly::hash::twang_mix64(std::hash<Value>()(value));
+  }
+
+  uint64_t operator()(const List& list) const {
+    uint64_t seed = list.values.size();
+    for (const auto& value : list.values) {
+      seed = folly::hash::hash_128_to_64(seed, (*this)(value));
+    }
+    return seed;
+  }
+
+  uint64_t operator()(const List* list) const {
+    return list == nullptr ? 0 : (*this)(*list);
+  }
+};
+
+/**
+ * @brief Key with its cached hash
+ */
+template <typename K>
+struct HashedKey {
+  HashedKey(K k, uint64_t h) : key(std::move(k)), hash(h) {}
+
+  K key;
+  uint64_t hash;
+};
+
+/**
+ * @brief Reference to a key to look up, so that looking up doesn't copy the key
+ */
+template <typename K>
+struct HashedKeyRef {
+  const K& key;
+  uint64_t hash;
+};
+
+template <typename K>
+struct HashedKeyHasher {
+  using is_transparent = void;
+  // The cached hash is well mixed already, so F14 doesn't need to mix it again
+  using folly_is_avalanching = std::true_type;
+
+  size_t operator()(const HashedKey<K>& k) const {
+    return k.hash;
+  }
+
+  size_t operator()(const HashedKeyRef<K>& k) const {
+    return k.hash;
+  }
+};
+
+template <typename K>
+struct HashedKeyEqual {
+  using is_transparent = void;
+
+  template <typename L, typename R>
+  bool operator()(const L& lhs, const R& rhs) const {
+    return lhs.hash == rhs.hash && std::equal_to<K>()(lhs.key, rhs.key);
+  }
+};
+
+/**
+ * @brief Hash map from Value, List or row pointer to V
+ */
+template <typename K, typename V>
+class HashMap final {
+ public:
+  using Map = folly::F14FastMap<HashedKey<K>, V, HashedKeyHasher<K>, HashedKeyEqual<K>>;
+  using iterator = typename Map::iterator;
+  using const_iterator = typename Map::const_iterator;
+
+  void reserve(size_t size) {
+    map_.reserve(size);
+  }
+
+  void clear() {
+    map_.clear();
+  }
+
+  size_t size() const {
+    return map_.size();
+  }
+
+  bool empty() const {
+    return map_.empty();
+  }
+
+  /**
+   * @brief Return the value of key, a default value is inserted if the key doesn't exist
+   */
+  V& operator[](const K& key) {
+    auto hash = ValueHasher()(key);
+    auto iter = map_.find(HashedKeyRef<K>{key, hash});
+    if (iter != map_.end()) {
+      return iter->second;
+    }
+    return map_.try_emplace(HashedKey<K>(key, hash)).first->second;
+  }
+
+  V& operator[](K&& key) {
+    auto hash = ValueHasher()(key);
+    auto iter = map_.find(HashedKeyRef<K>{key, hash});
+    if (iter != map_.end()) {
+      return iter->second;
+    }
+    return map_.try_emplace(HashedKey<K>(std::move(key), hash)).first->second;
+  }
+
+  /**
+   * @brief Return the value of key, nullptr if not exists
+   */
+  const V* find(const K& key) const {
+    auto iter = map_.find(HashedKeyRef<K>{key, ValueHasher()(key)});
+    return iter == map_.end() ? nullptr : &iter->second;
+  }
+
+  V* find(const K& key) {
+    auto iter = map_.find(HashedKeyRef<K>{key, ValueHasher()(key)});
+    return iter == map_.end() ? nullptr : &iter->second;
+  }
+
+  bool contains(const K& key) const {
+    return find(key) != nullptr;
+  }
+
+  // The key of an entry is "iter->first.key"
+  iterator begin() {
+    return map_.begin();
+  }
+
+  iterator end() {
+    return map_.end();
+  }
+
+  const_iterator begin() const {
+    return map_.begin();
+  }
+
+  const_iterator end() const {
+    return map_.end();
+  }
+
+ private:
+  Map map_;
+};
+
+/**
+ * @brief Hash set of Value, List or row pointer
+ */
+template <typename K>
+class HashSet final {
+ public:
+  using Set = folly::F14FastSet<HashedKey<K>, HashedKeyHasher<K>, HashedKeyEqual<K>>;
+
+  void reserve(size_t size) {
+    set_.reserve(size);
+  }
+
+  void clear() {
+    set_.clear();
+  }
+
+  size_t size() const {
+    return set_.size();
+  }
+
+  bool empty() const {
+    return set_.empty();
+  }
+
+  /**
+   * @brief Insert the key, return false if it exists already
+   */
+  template <typename Key>
+  bool insert(Key&& key) {
+    auto hash = ValueHasher()(key);
+    if (set_.find(HashedKeyRef<K>{key, hash}) != set_.end()) {
+      return false;
+    }
+    set_.emplace(std::forward<Key>(key), hash);
+    return true;
+  }
+
+  bool contains(const K& key) const {
+    return set_.find(HashedKeyRef<K>{key, ValueHasher()(key)}) != set_.end();
+  }
+
+ private:
+  Set set_;
+};
+
+/**
+ * @brief Hash table from Value or List to rows, which is the build side of hash join. The rows of
+ * a key are chained in the order they are added, the nodes of the chains are allocated from an
+ * arena instead of a vector per key.
+ *
+ * Not thread safe for adding, but it could be probed by multiple threads after built.
+ */
+template <typename K>
+class RowHashTable final {
+  struct Node {
+    const Row* row;
+    Node* next;
+  };
+
+ public:
+  /**
+   * @brief Rows of the same key
+   */
+  class Rows final {
+   public:
+    class Iterator final {
+     public:
+      explicit Iterator(const Node* node) : node_(node) {}
+
+      const Row* operator*() const {
+        return node_->row;
+      }
+
+      Iterator& operator++() {
+        node_ = node_->next;
+        return *this;
+      }
+
+      bool operator!=(const Iterator& rhs) const {
+        return node_ != rhs.node_;
+      }
+
+     private:
+      const Node* node_;
+    };
+
+    Iterator begin() const {
+      return Iterator(head_);
+    }
+
+    Iterator end() const {
+      return Iterator(nullptr);
+    }
+
+    size_t size() const {
+      return size_;
+    }
+
+    const Row* back() const {
+      return tail_->row;
+    }
+
+   private:
+    friend class RowHashTable;
+
+    Node* head_{nullptr};
+    Node* tail_{nullptr};
+    size_t size_{0};
+  };
+
+  RowHashTable() : arena_(std::make_unique<Arena>()) {}
+
+  void reserve(size_t size) {
+    map_.reserve(size);
+  }
+
+  void clear() {
+    map_.clear();
+    arena_ = std::make_unique<Arena>();
+  }
+
+  size_t size() const {
+    return map_.size();
+  }
+
+  bool empty() const {
+    return map_.empty();
+  }
+
+  /**
+   * @brief Append a row to the rows of key
+   */
+  template <typename Key>
+  void add(Key&& key, const Row* row) {
+    auto& rows = map_[std::forward<Key>(key)];
+    auto* node = new (arena_->allocateAligned(sizeof(Node))) Node{row, nullptr};
+    if (rows.tail_ == nullptr) {
+      rows.head_ = node;
+    } else {
+      rows.tail_->next = node;
+    }
+    rows.tail_ = node;
+    rows.size_++;
+  }
+
+  /**
+   * @brief Return the rows of key, nullptr if not exists
+   */
+  const Rows* find(const K& key) const {
+    return map_.find(key);
+  }
+
+ private:
+  HashMap<K, Rows> map_;
+  std::unique_ptr<Arena> arena_;
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_DATATYPES_HASHTABLE_H_
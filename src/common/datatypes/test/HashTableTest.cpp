@@ -0,0 +1,124 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/HashTable.h"
+
+namespace nebula {
+
+TEST(HashTableTest, HashMap) {
+  HashMap<Value, int64_t> map;
+  for (int64_t i = 0; i < 1000; i++) {
+    map[Value(i % 100)] += i;
+    map[Value(folly::to<std::string>(i % 10))]++;
+  }
+  EXPECT_EQ(110UL, map.size());
+  ASSERT_NE(nullptr, map.find(Value(1)));
+  EXPECT_EQ(1 + 101 + 201 + 301 + 401 + 501 + 601 + 701 + 801 + 901, *map.find(Value(1)));
+  ASSERT_NE(nullptr, map.find(Value("1")));
+  EXPECT_EQ(100, *map.find(Value("1")));
+  EXPECT_EQ(nullptr, map.find(Value(100)));
+  EXPECT_FALSE(map.contains(Value::kNullValue));
+
+  size_t count = 0;
+  for (const auto& kv : map) {
+    EXPECT_EQ(map.find(kv.first.key), &kv.second);
+    count++;
+  }
+  EXPECT_EQ(110, count);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(Value(1)));
+}
+
+TEST(HashTableTest, ListKey) {
+  HashMap<List, List> map;
+  map[List({1, "a"})].emplace_back(1);
+  map[List({1, "a"})].emplace_back(2);
+  map[List({"a", 1})].emplace_back(3);
+  map[List({1})].emplace_back(4);
+  EXPECT_EQ(3UL, map.size());
+  ASSERT_NE(nullptr, map.find(List({1, "a"})));
+  EXPECT_EQ(List({1, 2}), *map.find(List({1, "a"})));
+  ASSERT_NE(nullptr, map.find(List({"a", 1})));
+  EXPECT_EQ(List({3}), *map.find(List({"a", 1})));
+  EXPECT_EQ(nullptr, map.find(List({1, "a", 1})));
+  EXPECT_EQ(nullptr, map.find(List()));
+}
+
+TEST(HashTableTest, HashSet) {
+  HashSet<Value> set;
+  EXPECT_TRUE(set.insert(Value(1)));
+  EXPECT_FALSE(set.insert(Value(1)));
+  EXPECT_TRUE(set.insert(Value("1")));
+  EXPECT_TRUE(set.insert(Value::kNullValue));
+  EXPECT_FALSE(set.insert(Value::kNullValue));
+  EXPECT_EQ(3UL, set.size());
+  EXPECT_TRUE(set.contains(Value("1")));
+  EXPECT_FALSE(set.contains(Value(2)));
+
+  // Rows are compared by their values instead of the addresses
+  Row row1({1, "a"});
+  Row row2({1, "a"});
+  Row row3({2, "a"});
+  HashSet<const Row*> rows;
+  EXPECT_TRUE(rows.insert(&row1));
+  EXPECT_FALSE(rows.insert(&row2));
+  EXPECT_TRUE(rows.insert(&row3));
+  EXPECT_EQ(2UL, rows.size());
+  EXPECT_TRUE(rows.contains(&row2));
+}
+
+TEST(HashTableTest, RowHashTable) {
+  std::vector<Row> rows;
+  for (int64_t i = 0; i < 100; i++) {
+    rows.emplace_back(Row({i % 10, i}));
+  }
+  RowHashTable<Value> table;
+  table.reserve(rows.size());
+  for (const auto& row : rows) {
+    table.add(row.values[0], &row);
+  }
+  EXPECT_EQ(10UL, table.size());
+
+  for (int64_t key = 0; key < 10; key++) {
+    const auto* found = table.find(Value(key));
+    ASSERT_NE(nullptr, found);
+    ASSERT_EQ(10UL, found->size());
+    // The rows are kept in the order they are added
+    int64_t expected = key;
+    for (const auto* row : *found) {
+      EXPECT_EQ(&rows[expected], row);
+      expected += 10;
+    }
+    EXPECT_EQ(&rows[90 + key], found->back());
+  }
+  EXPECT_EQ(nullptr, table.find(Value(10)));
+
+  table.clear();
+  EXPECT_TRUE(table.empty());
+  EXPECT_EQ(nullptr, table.find(Value(1)));
+
+  RowHashTable<List> listTable;
+  listTable.add(List({1, 2}), &rows[0]);
+  listTable.add(List({1, 2}), &rows[1]);
+  listTable.add(List({2, 1}), &rows[2]);
+  ASSERT_NE(nullptr, listTable.find(List({1, 2})));
+  EXPECT_EQ(2UL, listTable.find(List({1, 2}))->size());
+  EXPECT_EQ(&rows[1], listTable.find(List({1, 2}))->back());
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
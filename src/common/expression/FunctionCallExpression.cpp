@@ -67,17 +67,36 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
   if (funcResult.ok()) {
     func_ = std::move(funcResult).value();
   }
+  auto pureResult = FunctionManager::getIsPure(name_, args_->numArgs());
+  isPure_ = pureResult.ok() && pureResult.value();
+  cached_ = false;
 }
 
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
+  if (cached_) {
+    return result_;
+  }
   std::vector<std::reference_wrapper<const Value>> parameter;
   for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
     parameter.emplace_back(arg->eval(ctx));
   }
   result_ = DCHECK_NOTNULL(func_)(parameter);
+  cached_ = canBeCached();
   return result_;
 }
 
+bool FunctionCallExpression::canBeCached() const {
+  if (!isPure_) {
+    return false;
+  }
+  for (const auto& arg : args_->args()) {
+    if (arg->kind() != Kind::kConstant) {
+      return false;
+    }
+  }
+  return true;
+}
+
 std::string FunctionCallExpression::toString() const {
   std::stringstream out;
 
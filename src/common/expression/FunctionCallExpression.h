@@ -112,6 +112,8 @@ class FunctionCallExpression final : public Expression {
   }
 
   ArgumentList* args() {
+    // The arguments may be rewritten
+    cached_ = false;
     return args_;
   }
 
@@ -124,9 +126,15 @@ class FunctionCallExpression final : public Expression {
       if (funcResult.ok()) {
         func_ = funcResult.value();
       }
+      auto pureResult = FunctionManager::getIsPure(name_, args_->numArgs());
+      isPure_ = pureResult.ok() && pureResult.value();
     }
   }
 
+  // Whether the result could be reused by the following evaluations, i.e. a pure function
+  // with constant arguments, such as datetime("2019-01-03T22:22:03")
+  bool canBeCached() const;
+
   void writeTo(Encoder& encoder) const override;
   void resetFrom(Decoder& decoder) override;
 
@@ -137,6 +145,8 @@ class FunctionCallExpression final : public Expression {
   // runtime cache
   Value result_;
   FunctionManager::Function func_;
+  bool isPure_{false};
+  bool cached_{false};
 };
 
 }  // namespace nebula
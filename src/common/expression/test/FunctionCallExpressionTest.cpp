@@ -129,4 +129,29 @@ TEST_F(FunctionCallExpressionTest, FunctionCallToStringTest) {
     EXPECT_EQ(ep->toString(), "now()");
   }
 }
+TEST_F(FunctionCallExpressionTest, CacheConstantResult) {
+  // pure function with constant arguments is evaluated only once
+  {
+    auto ep = FunctionCallExpression::make(
+        &pool, "datetime", {ConstantExpression::make(&pool, "2019-01-03T22:22:03+00:00")});
+    auto expected = Value(DateTime(2019, 1, 3, 22, 22, 3, 0));
+    EXPECT_EQ(expected, Expression::eval(ep, gExpCtxt));
+    EXPECT_EQ(expected, Expression::eval(ep, gExpCtxt));
+    // the cache is dropped once the arguments are rewritten
+    ep->args()->setArg(0, ConstantExpression::make(&pool, "2020-01-03T22:22:03+00:00"));
+    EXPECT_EQ(Value(DateTime(2020, 1, 3, 22, 22, 3, 0)), Expression::eval(ep, gExpCtxt));
+  }
+  // non-pure function is always evaluated
+  {
+    auto ep = FunctionCallExpression::make(
+        &pool,
+        "rand32",
+        {ConstantExpression::make(&pool, 0), ConstantExpression::make(&pool, 1000000000)});
+    std::unordered_set<Value> results;
+    for (auto i = 0; i < 10; i++) {
+      results.emplace(Expression::eval(ep, gExpCtxt));
+    }
+    EXPECT_GT(results.size(), 1);
+  }
+}
 }  // namespace nebula
@@ -2971,7 +2971,8 @@ Status FunctionManager::find(const std::string &func, const size_t arity) {
   }
 
   // If the function is not always pure, lookup the map to find purity.
-  return attr.isPure_.at(arity);
+  auto iter = attr.isPure_.find(arity);
+  return iter != attr.isPure_.end() && iter->second;
 }
 
 /*static*/ StatusOr<const FunctionManager::FunctionAttributes> FunctionManager::getInternal(
@@ -14,6 +14,7 @@
 #include <s2/s2cap.h>
 #include <s2/s2cell.h>
 #include <s2/s2cell_id.h>
+#include <s2/s2cell_union.h>
 #include <s2/s2earth.h>
 #include <s2/s2latlng.h>
 #include <s2/s2polygon.h>
@@ -124,14 +125,42 @@ std::vector<ScanRange> GeoIndex::dWithin(const Geography& g, double distance) co
   }
 }
 
+std::vector<ScanRange> GeoIndex::dWithinRing(const Geography& g,
+                                              double innerDistance,
+                                              double outerDistance) const {
+  auto r = g.asS2();
+  if (UNLIKELY(!r)) {
+    return {};
+  }
+  if (g.shape() != GeoShape::POINT) {
+    DLOG(FATAL) << "Only the ring around a point is supported";
+    return {};
+  }
+
+  const S2Point& gPoint = static_cast<S2PointRegion*>(r.get())->point();
+  S2Cap outerCap(gPoint, S2Earth::ToAngle(util::units::Meters(outerDistance)));
+  if (innerDistance <= 0) {
+    return intersects(outerCap);
+  }
+  S2Cap innerCap(gPoint, S2Earth::ToAngle(util::units::Meters(innerDistance)));
+  // The inner covering has been scanned, which may be larger than the inner cap, so the ring is
+  // the difference of coverings rather than the covering of the difference of caps
+  S2CellUnion outer(coveringCells(outerCap));
+  S2CellUnion inner(coveringCells(innerCap));
+  return scanRanges(outer.Difference(inner).cell_ids());
+}
+
 std::vector<ScanRange> GeoIndex::intersects(const S2Region& r, bool isPoint) const {
-  auto cells = coveringCells(r, isPoint);
-  std::vector<ScanRange> scanRanges;
+  return scanRanges(coveringCells(r, isPoint));
+}
+
+std::vector<ScanRange> GeoIndex::scanRanges(const std::vector<S2CellId>& cells) const {
+  std::vector<ScanRange> ranges;
   for (const S2CellId& cellId : cells) {
     if (cellId.is_leaf()) {
-      scanRanges.emplace_back(cellId.id());
+      ranges.emplace_back(cellId.id());
     } else {
-      scanRanges.emplace_back(cellId.range_min().id(), cellId.range_max().id());
+      ranges.emplace_back(cellId.range_min().id(), cellId.range_max().id());
     }
   }
 
@@ -140,11 +169,11 @@ std::vector<ScanRange> GeoIndex::intersects(const S2Region& r, bool isPoint) con
   if (!pointsOnly_) {
     auto ancestors = ancestorCells(cells);
     for (const S2CellId& cellId : ancestors) {
-      scanRanges.emplace_back(cellId.id());
+      ranges.emplace_back(cellId.id());
     }
   }
 
-  return scanRanges;
+  return ranges;
 }
 
 std::vector<S2CellId> GeoIndex::coveringCells(const S2Region& r, bool isPoint) const {
@@ -171,7 +200,10 @@ std::vector<S2CellId> GeoIndex::ancestorCells(const std::vector<S2CellId>& cells
   std::vector<S2CellId> ancestors;
   std::unordered_set<S2CellId> seen;
   for (const auto& cellId : cells) {
-    for (auto l = cellId.level() - 1; l >= rcParams_.minCellLevel_; --l) {
+    // The indexed cells are not finer than the max level, while the cells of a ring may be
+    for (auto l = std::min(cellId.level() - 1, rcParams_.maxCellLevel_);
+         l >= rcParams_.minCellLevel_;
+         --l) {
       S2CellId parentCellId = cellId.parent(l);
       if (seen.find(parentCellId) != seen.end()) {
         break;
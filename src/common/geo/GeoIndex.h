@@ -75,10 +75,18 @@ class GeoIndex {
   std::vector<ScanRange> coveredBy(const Geography& g) const;
   // ST_Distance(g, x, distance), x is the indexed geography column
   std::vector<ScanRange> dWithin(const Geography& g, double distance) const;
+  // The cells to scan when the distance of ST_DWithin(g, x, distance) grows from innerDistance to
+  // outerDistance, g should be a point. The rings of increasing distances cover the same cells as
+  // dWithin(g, outerDistance) without scanning a cell twice, which is used by the kNN search.
+  std::vector<ScanRange> dWithinRing(const Geography& g,
+                                     double innerDistance,
+                                     double outerDistance) const;
 
  private:
   std::vector<ScanRange> intersects(const S2Region& r, bool isPoint = false) const;
 
+  std::vector<ScanRange> scanRanges(const std::vector<S2CellId>& cells) const;
+
   std::vector<S2CellId> coveringCells(const S2Region& r, bool isPoint = false) const;
 
   std::vector<S2CellId> ancestorCells(const std::vector<S2CellId>& cells) const;
@@ -5,6 +5,7 @@
 
 #include <gtest/gtest.h>
 #include <s2/s2cell_id.h>
+#include <s2/s2point_region.h>
 
 #include <cstdint>
 #include <unordered_set>
@@ -306,6 +307,47 @@ TEST(indexCells, polygon) {
   }
 }
 
+TEST(dWithinRing, point) {
+  auto contains = [](const std::vector<ScanRange>& ranges, uint64_t cellId) {
+    return std::any_of(ranges.begin(), ranges.end(), [cellId](const ScanRange& range) {
+      return range.isRangeScan ? range.rangeMin <= cellId && cellId <= range.rangeMax
+                               : range.rangeMin == cellId;
+    });
+  };
+  auto leaf = [](const std::string& wkt) {
+    auto point = Geography::fromWKT(wkt).value();
+    return S2CellId(static_cast<S2PointRegion*>(point.asS2().get())->point()).id();
+  };
+
+  geo::RegionCoverParams rc(0, 30, 8);
+  geo::GeoIndex geoIndex(rc, true);
+  auto center = Geography::fromWKT("POINT(0.0 0.0)").value();
+  auto ring1 = geoIndex.dWithinRing(center, 0, 2000);
+  auto ring2 = geoIndex.dWithinRing(center, 2000, 4000);
+  EXPECT_EQ(geoIndex.dWithin(center, 2000), ring1);
+  EXPECT_FALSE(ring2.empty());
+
+  // About 1km away
+  auto near = leaf("POINT(0.009 0.0)");
+  EXPECT_TRUE(contains(ring1, near));
+  EXPECT_FALSE(contains(ring2, near));
+  // About 3km away
+  auto middle = leaf("POINT(0.027 0.0)");
+  EXPECT_TRUE(contains(ring1, middle) || contains(ring2, middle));
+  // About 111km away
+  auto far = leaf("POINT(1.0 0.0)");
+  EXPECT_FALSE(contains(ring1, far));
+  EXPECT_FALSE(contains(ring2, far));
+
+  // The rings don't overlap
+  for (const auto& range : ring2) {
+    EXPECT_FALSE(contains(ring1, range.rangeMin));
+    if (range.isRangeScan) {
+      EXPECT_FALSE(contains(ring1, range.rangeMax));
+    }
+  }
+}
+
 }  // namespace geo
 }  // namespace nebula
 
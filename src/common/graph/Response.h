@@ -63,6 +63,7 @@
   X(E_SEMANTIC_ERROR, -1009) /* semantic error */                             \
   X(E_TOO_MANY_CONNECTIONS, -1010)                                            \
   X(E_PARTIAL_SUCCEEDED, -1011)                                               \
+  X(E_PAGED_RESULT_NOT_FOUND, -1012)                                          \
                                                                               \
   /* 2xxx for metad */                                                        \
   X(E_NO_HOSTS, -2001) /* Operation Failure*/                                 \
@@ -198,5 +198,13 @@ StatusOr<std::pair<std::string, int64_t>> NebulaSchemaProvider::getTTLInfo() con
   return std::make_pair(ttlCol, ttlDuration);
 }
 
+const std::string* NebulaSchemaProvider::getAdjacencyOrderCol() const {
+  auto col = schemaProp_.adjacency_order_col_ref();
+  if (!col.has_value() || col->empty()) {
+    return nullptr;
+  }
+  return &col.value();
+}
+
 }  // namespace meta
 }  // namespace nebula
@@ -183,6 +183,14 @@ class NebulaSchemaProvider {
 
   StatusOr<std::pair<std::string, int64_t>> getTTLInfo() const;
 
+  // Return the column and whether it is descending if the edge has an adjacency order,
+  // nullptr otherwise
+  const std::string* getAdjacencyOrderCol() const;
+
+  bool isAdjacencyOrderDesc() const {
+    return schemaProp_.adjacency_order_desc_ref().value_or(false);
+  }
+
   bool hasNullableCol() const {
     return numNullableFields_ != 0;
   }
@@ -0,0 +1,273 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+
+#include <folly/Varint.h>
+
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula::plugin {
+
+static bool isWordByte(unsigned char c) {
+  return c >= 0x80 || std::isalnum(c);
+}
+
+// Remove the last character if it is cut in the middle
+static void truncateUtf8(std::string& term) {
+  auto start = term.size();
+  while (start > 0 && (static_cast<unsigned char>(term[start - 1]) & 0xC0) == 0x80) {
+    start--;
+  }
+  if (start == 0) {
+    return;
+  }
+  auto lead = static_cast<unsigned char>(term[start - 1]);
+  size_t len = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
+  if (term.size() - (start - 1) < len) {
+    term.resize(start - 1);
+  }
+}
+
+// static
+std::vector<TextTokenizer::Token> TextTokenizer::tokenize(folly::StringPiece text,
+                                                          uint32_t basePos) {
+  std::vector<Token> tokens;
+  uint32_t pos = basePos;
+  size_t i = 0;
+  while (i < text.size()) {
+    while (i < text.size() && !isWordByte(text[i])) {
+      i++;
+    }
+    if (i == text.size()) {
+      break;
+    }
+    std::string term;
+    bool truncated = false;
+    while (i < text.size() && isWordByte(text[i])) {
+      if (term.size() < kMaxTermLen) {
+        term.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(text[i]))));
+      } else {
+        truncated = true;
+      }
+      i++;
+    }
+    if (truncated) {
+      truncateUtf8(term);
+    }
+    tokens.emplace_back(Token{std::move(term), pos++});
+  }
+  return tokens;
+}
+
+// static
+std::string PostingCodec::encode(const std::vector<uint32_t>& positions) {
+  std::string data;
+  data.reserve(positions.size() * 2);
+  uint8_t buf[folly::kMaxVarintLength64];
+  uint32_t last = 0;
+  for (auto pos : positions) {
+    DCHECK_GE(pos, last);
+    auto len = folly::encodeVarint(pos - last, buf);
+    data.append(reinterpret_cast<const char*>(buf), len);
+    last = pos;
+  }
+  return data;
+}
+
+// static
+std::vector<uint32_t> PostingCodec::decode(folly::StringPiece data) {
+  std::vector<uint32_t> positions;
+  folly::ByteRange range(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+  uint32_t last = 0;
+  while (!range.empty()) {
+    auto delta = folly::tryDecodeVarint(range);
+    if (delta.hasError()) {
+      LOG(ERROR) << "Corrupted posting of builtin fulltext index";
+      break;
+    }
+    last += static_cast<uint32_t>(delta.value());
+    positions.emplace_back(last);
+  }
+  return positions;
+}
+
+// static
+StatusOr<TextQuery> TextQuery::parse(folly::StringPiece query) {
+  TextQuery result;
+  size_t i = 0;
+  while (i < query.size()) {
+    if (std::isspace(static_cast<unsigned char>(query[i]))) {
+      i++;
+      continue;
+    }
+    Clause clause;
+    folly::StringPiece text;
+    bool isPrefix = false;
+    if (query[i] == '"') {
+      auto end = query.find('"', i + 1);
+      if (end == folly::StringPiece::npos) {
+        return Status::SyntaxError("Unclosed phrase in `%s'", query.str().c_str());
+      }
+      text = query.subpiece(i + 1, end - i - 1);
+      i = end + 1;
+    } else {
+      auto begin = i;
+      while (i < query.size() && !std::isspace(static_cast<unsigned char>(query[i]))) {
+        i++;
+      }
+      text = query.subpiece(begin, i - begin);
+      if (text.endsWith('*')) {
+        isPrefix = true;
+        text.pop_back();
+      }
+    }
+    for (auto& token : TextTokenizer::tokenize(text)) {
+      clause.terms.emplace_back(std::move(token.term));
+    }
+    if (clause.terms.empty()) {
+      continue;
+    }
+    if (isPrefix) {
+      if (clause.terms.size() != 1) {
+        return Status::SyntaxError("Invalid prefix `%s*'", text.str().c_str());
+      }
+      clause.kind = Clause::Kind::kPrefix;
+    } else {
+      clause.kind = clause.terms.size() == 1 ? Clause::Kind::kTerm : Clause::Kind::kPhrase;
+    }
+    result.clauses.emplace_back(std::move(clause));
+  }
+  if (result.clauses.empty()) {
+    return Status::SyntaxError("Empty fulltext query `%s'", query.str().c_str());
+  }
+  return result;
+}
+
+// static
+std::string TextIndexKeyUtils::kindPrefix(PartitionID partId, char kind) {
+  return NebulaKeyUtils::fulltextPrefix(partId).append(1, kind);
+}
+
+// static
+std::string TextIndexKeyUtils::schemaPrefix(PartitionID partId, char kind, int32_t schemaId) {
+  return kindPrefix(partId, kind).append(reinterpret_cast<const char*>(&schemaId),
+                                         sizeof(int32_t));
+}
+
+// static
+std::string TextIndexKeyUtils::indexPrefix(PartitionID partId,
+                                           char kind,
+                                           int32_t schemaId,
+                                           folly::StringPiece indexName) {
+  std::string key;
+  key.reserve(kHeadLen + indexName.size() + 1);
+  key.append(schemaPrefix(partId, kind, schemaId))
+      .append(indexName.data(), indexName.size())
+      .append(1, '\0');
+  return key;
+}
+
+// static
+std::string TextIndexKeyUtils::postingKey(PartitionID partId,
+                                          int32_t schemaId,
+                                          folly::StringPiece indexName,
+                                          folly::StringPiece term,
+                                          folly::StringPiece docKey) {
+  auto key = indexPrefix(partId, kPosting, schemaId, indexName);
+  key.reserve(key.size() + term.size() + 1 + docKey.size());
+  key.append(term.data(), term.size()).append(1, '\0').append(docKey.data(), docKey.size());
+  return key;
+}
+
+// static
+std::string TextIndexKeyUtils::forwardKey(PartitionID partId,
+                                          int32_t schemaId,
+                                          folly::StringPiece indexName,
+                                          folly::StringPiece docKey) {
+  auto key = indexPrefix(partId, kForward, schemaId, indexName);
+  key.append(docKey.data(), docKey.size());
+  return key;
+}
+
+// static
+std::string TextIndexKeyUtils::defineKey(PartitionID partId,
+                                         int32_t schemaId,
+                                         folly::StringPiece indexName) {
+  return indexPrefix(partId, kDefine, schemaId, indexName);
+}
+
+// static
+std::string TextIndexKeyUtils::reindexKey(PartitionID partId, folly::StringPiece dataKey) {
+  return kindPrefix(partId, kReindex).append(dataKey.data(), dataKey.size());
+}
+
+// static
+std::string TextIndexKeyUtils::builtKey(PartitionID partId,
+                                        int32_t schemaId,
+                                        folly::StringPiece indexName) {
+  return indexPrefix(partId, kBuilt, schemaId, indexName);
+}
+
+// static
+std::string TextIndexKeyUtils::edgeDocKey(folly::StringPiece src,
+                                          EdgeRanking rank,
+                                          folly::StringPiece dst) {
+  std::string docKey;
+  docKey.reserve(src.size() + sizeof(EdgeRanking) + dst.size());
+  docKey.append(src.data(), src.size())
+      .append(reinterpret_cast<const char*>(&rank), sizeof(EdgeRanking))
+      .append(dst.data(), dst.size());
+  return docKey;
+}
+
+// static
+char TextIndexKeyUtils::getKind(folly::StringPiece rawKey) {
+  CHECK_GE(rawKey.size(), kHeadLen);
+  return rawKey[sizeof(PartitionID)];
+}
+
+// static
+int32_t TextIndexKeyUtils::getSchemaId(folly::StringPiece rawKey) {
+  CHECK_GE(rawKey.size(), kHeadLen);
+  return readInt<int32_t>(rawKey.data() + sizeof(PartitionID) + sizeof(char), sizeof(int32_t));
+}
+
+// static
+folly::StringPiece TextIndexKeyUtils::getIndexName(folly::StringPiece rawKey) {
+  CHECK_GE(rawKey.size(), kHeadLen);
+  auto rest = rawKey.subpiece(kHeadLen);
+  return rest.subpiece(0, rest.find('\0'));
+}
+
+// static
+folly::StringPiece TextIndexKeyUtils::getDataKey(folly::StringPiece rawKey) {
+  CHECK_GT(rawKey.size(), sizeof(PartitionID) + sizeof(char));
+  return rawKey.subpiece(sizeof(PartitionID) + sizeof(char));
+}
+
+// static
+std::pair<folly::StringPiece, folly::StringPiece> TextIndexKeyUtils::splitPosting(
+    folly::StringPiece rest) {
+  auto pos = rest.find('\0');
+  DCHECK_NE(pos, folly::StringPiece::npos);
+  return {rest.subpiece(0, pos), rest.subpiece(pos + 1)};
+}
+
+// static
+std::string TextIndexKeyUtils::encodeTerms(const std::vector<std::string>& terms) {
+  return folly::join(std::string(1, '\0'), terms);
+}
+
+// static
+std::vector<std::string> TextIndexKeyUtils::decodeTerms(folly::StringPiece data) {
+  std::vector<std::string> terms;
+  if (!data.empty()) {
+    folly::split('\0', data, terms);
+  }
+  return terms;
+}
+
+}  // namespace nebula::plugin
@@ -0,0 +1,151 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_PLUGIN_FULLTEXT_BUILTIN_TEXTINDEX_H_
+#define COMMON_PLUGIN_FULLTEXT_BUILTIN_TEXTINDEX_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/thrift/ThriftTypes.h"
+
+namespace nebula::plugin {
+
+// The fulltext index created with this analyzer is maintained by storaged itself, in the same
+// engine as the data, instead of by the elasticsearch listener. A new index is maintained and
+// searchable only after REBUILD FULLTEXT INDEX has defined and backfilled it in every part, the
+// search on a part not rebuilt yet fails with E_INDEX_NOT_FOUND instead of missing documents.
+inline constexpr char kBuiltinAnalyzer[] = "builtin";
+
+/**
+ * @brief Split the text into lowercase terms of ascii letters and digits, the bytes not in ascii
+ * are kept in terms as they are, so the utf-8 words are not broken.
+ */
+class TextTokenizer final {
+ public:
+  struct Token {
+    std::string term;
+    uint32_t pos;
+  };
+
+  // The position gap between the fields, so a phrase never matches across two fields
+  static constexpr uint32_t kFieldGap = 100;
+
+  // The terms longer than this in bytes are truncated, on the boundary of utf-8 characters
+  static constexpr size_t kMaxTermLen = 128;
+
+  static std::vector<Token> tokenize(folly::StringPiece text, uint32_t basePos = 0);
+};
+
+/**
+ * @brief The posting of a term in a document is the list of its ascending positions, which is
+ * encoded as the varint of the deltas.
+ */
+class PostingCodec final {
+ public:
+  static std::string encode(const std::vector<uint32_t>& positions);
+
+  static std::vector<uint32_t> decode(folly::StringPiece data);
+};
+
+/**
+ * @brief The query of builtin fulltext index. The clauses are separated by whitespace and all of
+ * them must be matched:
+ *   word      the term
+ *   "a b c"   the phrase, terms in consecutive positions
+ *   wor*      the terms start with the prefix
+ */
+struct TextQuery {
+  struct Clause {
+    enum class Kind : uint8_t {
+      kTerm,
+      kPhrase,
+      kPrefix,
+    };
+    Kind kind;
+    std::vector<std::string> terms;
+  };
+
+  static StatusOr<TextQuery> parse(folly::StringPiece query);
+
+  std::vector<Clause> clauses;
+};
+
+/**
+ * @brief The keys of builtin fulltext index, all of them are in the kFulltext type of part:
+ *
+ *   posting: type(1) + partId(3) + 'P' + schemaId(4) + indexName + '\0' + term + '\0' + docKey
+ *            the value is the encoded positions of term in the document
+ *   forward: type(1) + partId(3) + 'F' + schemaId(4) + indexName + '\0' + docKey
+ *            the value is the terms of the document, to remove its postings when it changes
+ *   define:  type(1) + partId(3) + 'D' + schemaId(4) + indexName + '\0'
+ *            the value is the fields of index, the indexes maintained in the part are the ones
+ *            defined, which are written through raft by the rebuild job
+ *   reindex: type(1) + partId(3) + 'R' + tag or edge key
+ *            asks to index the current value of the tag or edge again, it is never persisted
+ *   built:   type(1) + partId(3) + 'B' + schemaId(4) + indexName + '\0'
+ *            written by the rebuild job after the backfill, the index is only searched in the
+ *            part with it. It is removed when the fields of the index are defined again.
+ *
+ * The docKey is the vid for tag, or src + rank + dst for edge. The terms never contain '\0'.
+ */
+class TextIndexKeyUtils final {
+ public:
+  static constexpr char kPosting = 'P';
+  static constexpr char kForward = 'F';
+  static constexpr char kDefine = 'D';
+  static constexpr char kReindex = 'R';
+  static constexpr char kBuilt = 'B';
+
+  static std::string kindPrefix(PartitionID partId, char kind);
+
+  static std::string schemaPrefix(PartitionID partId, char kind, int32_t schemaId);
+
+  static std::string indexPrefix(PartitionID partId,
+                                 char kind,
+                                 int32_t schemaId,
+                                 folly::StringPiece indexName);
+
+  static std::string postingKey(PartitionID partId,
+                                int32_t schemaId,
+                                folly::StringPiece indexName,
+                                folly::StringPiece term,
+                                folly::StringPiece docKey);
+
+  static std::string forwardKey(PartitionID partId,
+                                int32_t schemaId,
+                                folly::StringPiece indexName,
+                                folly::StringPiece docKey);
+
+  static std::string defineKey(PartitionID partId, int32_t schemaId, folly::StringPiece indexName);
+
+  static std::string reindexKey(PartitionID partId, folly::StringPiece dataKey);
+
+  static std::string builtKey(PartitionID partId, int32_t schemaId, folly::StringPiece indexName);
+
+  static std::string edgeDocKey(folly::StringPiece src, EdgeRanking rank, folly::StringPiece dst);
+
+  static char getKind(folly::StringPiece rawKey);
+
+  static int32_t getSchemaId(folly::StringPiece rawKey);
+
+  static folly::StringPiece getIndexName(folly::StringPiece rawKey);
+
+  // The tag or edge key of the reindex key
+  static folly::StringPiece getDataKey(folly::StringPiece rawKey);
+
+  // Split the rest of posting key after the prefix returned by indexPrefix into term and docKey
+  static std::pair<folly::StringPiece, folly::StringPiece> splitPosting(folly::StringPiece rest);
+
+  static std::string encodeTerms(const std::vector<std::string>& terms);
+
+  static std::vector<std::string> decodeTerms(folly::StringPiece data);
+
+ private:
+  static constexpr size_t kHeadLen = sizeof(PartitionID) + sizeof(char) + sizeof(int32_t);
+};
+
+}  // namespace nebula::plugin
+
+#endif  // COMMON_PLUGIN_FULLTEXT_BUILTIN_TEXTINDEX_H_
@@ -0,0 +1,116 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+
+namespace nebula {
+namespace plugin {
+
+TEST(BuiltinTextIndex, Tokenize) {
+  auto tokens = TextTokenizer::tokenize("Hello, World! nebula-graph 3.0", 10);
+  std::vector<std::string> terms;
+  std::vector<uint32_t> positions;
+  for (auto& token : tokens) {
+    terms.emplace_back(token.term);
+    positions.emplace_back(token.pos);
+  }
+  EXPECT_EQ(std::vector<std::string>({"hello", "world", "nebula", "graph", "3", "0"}), terms);
+  EXPECT_EQ(std::vector<uint32_t>({10, 11, 12, 13, 14, 15}), positions);
+
+  // The non-ascii bytes are part of term
+  tokens = TextTokenizer::tokenize("星云 图数据库");
+  ASSERT_EQ(2, tokens.size());
+  EXPECT_EQ("星云", tokens[0].term);
+  EXPECT_EQ("图数据库", tokens[1].term);
+
+  EXPECT_TRUE(TextTokenizer::tokenize(" ,.;").empty());
+}
+
+TEST(BuiltinTextIndex, TruncateTerm) {
+  std::string chars;
+  for (auto i = 0; i < 50; i++) {
+    chars += "星";
+  }
+  // The long term is truncated on the boundary of utf-8 characters
+  auto tokens = TextTokenizer::tokenize("a" + chars);
+  ASSERT_EQ(1, tokens.size());
+  EXPECT_EQ("a" + chars.substr(0, 42 * 3), tokens[0].term);
+  tokens = TextTokenizer::tokenize("ab" + chars);
+  ASSERT_EQ(1, tokens.size());
+  EXPECT_EQ(TextTokenizer::kMaxTermLen, tokens[0].term.size());
+  EXPECT_EQ("ab" + chars.substr(0, 42 * 3), tokens[0].term);
+  tokens = TextTokenizer::tokenize(std::string(200, 'a'));
+  ASSERT_EQ(1, tokens.size());
+  EXPECT_EQ(std::string(TextTokenizer::kMaxTermLen, 'a'), tokens[0].term);
+}
+
+TEST(BuiltinTextIndex, PostingCodec) {
+  std::vector<uint32_t> positions = {0, 1, 127, 128, 300, 70000, 70000};
+  auto data = PostingCodec::encode(positions);
+  EXPECT_EQ(positions, PostingCodec::decode(data));
+  EXPECT_TRUE(PostingCodec::decode(PostingCodec::encode({})).empty());
+}
+
+TEST(BuiltinTextIndex, ParseQuery) {
+  using Kind = TextQuery::Clause::Kind;
+  {
+    auto ret = TextQuery::parse(R"(Nebula "graph  DATABASE" distri*)");
+    ASSERT_TRUE(ret.ok()) << ret.status();
+    auto& clauses = ret.value().clauses;
+    ASSERT_EQ(3, clauses.size());
+    EXPECT_EQ(Kind::kTerm, clauses[0].kind);
+    EXPECT_EQ(std::vector<std::string>({"nebula"}), clauses[0].terms);
+    EXPECT_EQ(Kind::kPhrase, clauses[1].kind);
+    EXPECT_EQ(std::vector<std::string>({"graph", "database"}), clauses[1].terms);
+    EXPECT_EQ(Kind::kPrefix, clauses[2].kind);
+    EXPECT_EQ(std::vector<std::string>({"distri"}), clauses[2].terms);
+  }
+  {
+    // A word with punctuation is a phrase
+    auto ret = TextQuery::parse("e-mail");
+    ASSERT_TRUE(ret.ok()) << ret.status();
+    ASSERT_EQ(1, ret.value().clauses.size());
+    EXPECT_EQ(Kind::kPhrase, ret.value().clauses[0].kind);
+  }
+  EXPECT_FALSE(TextQuery::parse("\"unclosed phrase").ok());
+  EXPECT_FALSE(TextQuery::parse("e-mai*").ok());
+  EXPECT_FALSE(TextQuery::parse("  , ").ok());
+}
+
+TEST(BuiltinTextIndex, Keys) {
+  auto docKey = TextIndexKeyUtils::edgeDocKey("src", 7, "dst");
+  auto key = TextIndexKeyUtils::postingKey(3, 5, "idx", "term", docKey);
+  EXPECT_EQ(TextIndexKeyUtils::kPosting, TextIndexKeyUtils::getKind(key));
+  EXPECT_EQ(5, TextIndexKeyUtils::getSchemaId(key));
+  EXPECT_EQ("idx", TextIndexKeyUtils::getIndexName(key));
+
+  auto prefix = TextIndexKeyUtils::indexPrefix(3, TextIndexKeyUtils::kPosting, 5, "idx");
+  ASSERT_TRUE(folly::StringPiece(key).startsWith(prefix));
+  auto rest = folly::StringPiece(key).subpiece(prefix.size());
+  auto [term, doc] = TextIndexKeyUtils::splitPosting(rest);
+  EXPECT_EQ("term", term);
+  EXPECT_EQ(docKey, doc);
+
+  key = TextIndexKeyUtils::forwardKey(3, 5, "idx", docKey);
+  EXPECT_EQ(TextIndexKeyUtils::kForward, TextIndexKeyUtils::getKind(key));
+  EXPECT_EQ("idx", TextIndexKeyUtils::getIndexName(key));
+
+  std::vector<std::string> terms = {"a", "bc", "def"};
+  EXPECT_EQ(terms, TextIndexKeyUtils::decodeTerms(TextIndexKeyUtils::encodeTerms(terms)));
+  EXPECT_TRUE(TextIndexKeyUtils::decodeTerms(TextIndexKeyUtils::encodeTerms({})).empty());
+}
+
+}  // namespace plugin
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -14,6 +14,72 @@
 namespace nebula {
 namespace stats {
 
+// Max number of values buffered by a thread for a histogram before flushed
+static constexpr size_t kMaxBufferedValues = 64;
+
+StatsCounter::StatsCounter(std::unique_ptr<StatsType> stats)
+    : stats_(std::move(stats)), buffers_([this] { return new Buffer(this); }) {}
+
+StatsCounter::StatsCounter(std::unique_ptr<HistogramType> histogram)
+    : histogram_(std::move(histogram)), buffers_([this] { return new Buffer(this); }) {}
+
+StatsCounter::Buffer::~Buffer() {
+  // The thread exits, flush its values
+  std::lock_guard<folly::MicroSpinLock> bufferGuard(lock_);
+  std::lock_guard<std::mutex> guard(counter_->lock_);
+  counter_->flushBuffer(*this);
+}
+
+void StatsCounter::addValue(VT value) {
+  auto now = time::WallClock::fastNowInSec();
+  auto& buffer = *buffers_;
+  std::lock_guard<folly::MicroSpinLock> bufferGuard(buffer.lock_);
+  if (buffer.second_ != now) {
+    if (buffer.count_ > 0) {
+      std::lock_guard<std::mutex> guard(lock_);
+      flushBuffer(buffer);
+    }
+    buffer.second_ = now;
+  }
+  buffer.sum_ += value;
+  buffer.count_++;
+  if (histogram_ != nullptr) {
+    buffer.values_.emplace_back(value);
+    if (buffer.values_.size() >= kMaxBufferedValues) {
+      std::lock_guard<std::mutex> guard(lock_);
+      flushBuffer(buffer);
+    }
+  }
+}
+
+std::unique_lock<std::mutex> StatsCounter::flush() {
+  for (auto& buffer : buffers_.accessAllThreads()) {
+    std::lock_guard<folly::MicroSpinLock> bufferGuard(buffer.lock_);
+    if (buffer.count_ > 0) {
+      std::lock_guard<std::mutex> guard(lock_);
+      flushBuffer(buffer);
+    }
+  }
+  return std::unique_lock<std::mutex>(lock_);
+}
+
+void StatsCounter::flushBuffer(Buffer& buffer) {
+  using std::chrono::seconds;
+  if (buffer.count_ == 0) {
+    return;
+  }
+  if (histogram_ != nullptr) {
+    for (auto value : buffer.values_) {
+      histogram_->addValue(seconds(buffer.second_), value);
+    }
+    buffer.values_.clear();
+  } else {
+    stats_->addValueAggregated(seconds(buffer.second_), buffer.sum_, buffer.count_);
+  }
+  buffer.sum_ = 0;
+  buffer.count_ = 0;
+}
+
 // static
 StatsManager& StatsManager::get() {
   static StatsManager smInst;
@@ -90,19 +156,19 @@ CounterId StatsManager::registerStats(folly::StringPiece counterName,
   }
 
   // Insert the Stats
-  sm.stats_.emplace(
-      counterName,
-      std::make_pair(std::make_unique<std::mutex>(),
-                     std::make_unique<StatsType>(
-                         60,
-                         std::initializer_list<StatsType::Duration>(
-                             {seconds(5), seconds(60), seconds(600), seconds(3600)}))));
+  auto counter = std::make_shared<StatsCounter>(std::make_unique<StatsType>(
+      60,
+      std::initializer_list<StatsType::Duration>(
+          {seconds(5), seconds(60), seconds(600), seconds(3600)})));
   std::string index(counterName);
   auto it2 = sm.nameMap_.emplace(
       std::piecewise_construct,
       std::forward_as_tuple(std::move(name)),
-      std::forward_as_tuple(
-          index, std::move(methods), std::vector<std::pair<std::string, double>>(), false));
+      std::forward_as_tuple(index,
+                            std::move(counter),
+                            std::move(methods),
+                            std::vector<std::pair<std::string, double>>(),
+                            false));
 
   VLOG(1) << "Registered stats " << counterName.toString();
   return it2.first->second.id_;
@@ -141,20 +207,22 @@ CounterId StatsManager::registerHisto(folly::StringPiece counterName,
   }
 
   // Insert the Histogram
-  sm.histograms_.emplace(
-      counterName,
-      std::make_pair(std::make_unique<std::mutex>(),
-                     std::make_unique<HistogramType>(
-                         bucketSize,
-                         min,
-                         max,
-                         StatsType(60, {seconds(5), seconds(60), seconds(600), seconds(3600)}))));
+  auto counter = std::make_shared<StatsCounter>(std::make_unique<HistogramType>(
+      bucketSize,
+      min,
+      max,
+      StatsType(60, {seconds(5), seconds(60), seconds(600), seconds(3600)})));
   std::string index(counterName);
-  auto it2 = sm.nameMap_.emplace(
-      std::piecewise_construct,
-      std::forward_as_tuple(std::move(name)),
-      std::forward_as_tuple(
-          index, std::move(methods), std::move(percentiles), true, bucketSize, min, max));
+  auto it2 = sm.nameMap_.emplace(std::piecewise_construct,
+                                 std::forward_as_tuple(std::move(name)),
+                                 std::forward_as_tuple(index,
+                                                       std::move(counter),
+                                                       std::move(methods),
+                                                       std::move(percentiles),
+                                                       true,
+                                                       bucketSize,
+                                                       min,
+                                                       max));
 
   VLOG(1) << "Registered histogram " << counterName.toString() << " [bucketSize: " << bucketSize
           << ", min value: " << min << ", max value: " << max << "]";
@@ -240,7 +308,6 @@ void StatsManager::removeCounterWithLabels(const CounterId& id,
   if (it != sm.nameMap_.end()) {
     sm.nameMap_.erase(it);
   }
-  sm.stats_.erase(newIndex);
 }
 
 // static
@@ -263,35 +330,16 @@ void StatsManager::removeHistoWithLabels(const CounterId& id,
   if (it != sm.nameMap_.end()) {
     sm.nameMap_.erase(it);
   }
-  sm.histograms_.erase(newIndex);
 }
 
 // static
 void StatsManager::addValue(const CounterId& id, VT value) {
-  using std::chrono::seconds;
-
-  auto& sm = get();
-  if (!id.valid()) {
+  auto* counter = id.counter();
+  if (counter == nullptr) {
     // The counter is not registered
     return;
   }
-  std::string index = id.index();
-  bool isHisto = id.isHisto();
-  if (!isHisto) {
-    // Stats
-    auto iter = sm.stats_.find(index);
-    if (iter != sm.stats_.end()) {
-      std::lock_guard<std::mutex> g(*(iter->second.first));
-      iter->second.second->addValue(seconds(time::WallClock::fastNowInSec()), value);
-    }
-  } else {
-    // Histogram
-    auto iter = sm.histograms_.find(index);
-    if (iter != sm.histograms_.end()) {
-      std::lock_guard<std::mutex> g(*(iter->second.first));
-      iter->second.second->addValue(seconds(time::WallClock::fastNowInSec()), value);
-    }
-  }
+  counter->addValue(value);
 }
 
 // static
@@ -459,27 +507,20 @@ StatusOr<StatsManager::VT> StatsManager::readStats(const CounterId& id,
                                                    StatsManager::TimeRange range,
                                                    StatsManager::StatsMethod method) {
   using std::chrono::seconds;
-  auto& sm = get();
-  std::string index = id.index();
-
-  if (index == "") {
+  auto* counter = id.counter();
+  if (counter == nullptr) {
     return Status::Error("Invalid stats");
   }
 
+  auto guard = counter->flush();
   if (!id.isHisto()) {
     // stats
-    auto iter = sm.stats_.find(index);
-    DCHECK(iter != sm.stats_.end());
-    std::lock_guard<std::mutex> g(*(iter->second.first));
-    iter->second.second->update(seconds(time::WallClock::fastNowInSec()));
-    return readValue(*(iter->second.second), range, method);
+    counter->stats()->update(seconds(time::WallClock::fastNowInSec()));
+    return readValue(*counter->stats(), range, method);
   } else {
     // histograms_
-    auto iter = sm.histograms_.find(index);
-    DCHECK(iter != sm.histograms_.end());
-    std::lock_guard<std::mutex> g(*(iter->second.first));
-    iter->second.second->update(seconds(time::WallClock::fastNowInSec()));
-    return readValue(*(iter->second.second), range, method);
+    counter->histogram()->update(seconds(time::WallClock::fastNowInSec()));
+    return readValue(*counter->histogram(), range, method);
   }
 }
 
@@ -510,22 +551,15 @@ StatusOr<StatsManager::VT> StatsManager::readHisto(const CounterId& id,
                                                    StatsManager::TimeRange range,
                                                    double pct) {
   using std::chrono::seconds;
-  auto& sm = get();
-  std::string index = id.index();
-
-  if (!id.isHisto()) {
-    return Status::Error("Invalid stats");
-  }
-
-  auto it = sm.histograms_.find(index);
-  if (it == sm.histograms_.end()) {
+  auto* counter = id.counter();
+  if (!id.isHisto() || counter == nullptr) {
     return Status::Error("Invalid stats");
   }
 
-  std::lock_guard<std::mutex> g(*(sm.histograms_[index].first));
-  sm.histograms_[index].second->update(seconds(time::WallClock::fastNowInSec()));
+  auto guard = counter->flush();
+  counter->histogram()->update(seconds(time::WallClock::fastNowInSec()));
   auto level = static_cast<size_t>(range);
-  return sm.histograms_[index].second->getPercentileEstimate(pct, level);
+  return counter->histogram()->getPercentileEstimate(pct, level);
 }
 
 // static
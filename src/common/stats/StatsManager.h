@@ -6,7 +6,9 @@
 #ifndef COMMON_STATS_STATSMANAGER_H_
 #define COMMON_STATS_STATSMANAGER_H_
 
+#include <folly/MicroSpinLock.h>
 #include <folly/RWSpinLock.h>
+#include <folly/ThreadLocal.h>
 #include <folly/concurrency/ConcurrentHashMap.h>
 #include <folly/stats/MultiLevelTimeSeries.h>
 #include <folly/stats/TimeseriesHistogram.h>
@@ -19,12 +21,16 @@
 namespace nebula {
 namespace stats {
 
+class StatsCounter;
+
 // A wrapper class of counter index. Each instance can only be writtern once.
 class CounterId final {
  public:
   CounterId() = default;
-  CounterId(const std::string& index, bool isHisto = false)  // NOLINT
-      : index_{index}, isHisto_(isHisto) {}
+  CounterId(const std::string& index,  // NOLINT
+            bool isHisto = false,
+            std::shared_ptr<StatsCounter> counter = nullptr)
+      : index_{index}, isHisto_(isHisto), counter_(std::move(counter)) {}
   CounterId(const CounterId&) = default;
 
   CounterId& operator=(const CounterId& right) {
@@ -37,6 +43,7 @@ class CounterId final {
     }
     index_ = right.index_;
     isHisto_ = right.isHisto_;
+    counter_ = right.counter_;
     return *this;
   }
 
@@ -53,13 +60,74 @@ class CounterId final {
     return isHisto_;
   }
 
-  std::string index() const {
+  const std::string& index() const {
     return index_;
   }
 
+  // The counter resolved when registered, nullptr if the id is not returned by StatsManager
+  StatsCounter* counter() const {
+    return counter_.get();
+  }
+
  private:
   std::string index_;
   bool isHisto_{false};
+  std::shared_ptr<StatsCounter> counter_;
+};
+
+/**
+ * The values of a counter, which is either a time series or a histogram.
+ *
+ * Each thread accumulates its values into its own buffer, which is flushed into the time series
+ * when the second changes (or the buffer of histogram is full), or when the counter is read. So
+ * the writers only contend on the counter once per second, rather than on every value.
+ */
+class StatsCounter final {
+ public:
+  using VT = int64_t;
+  using StatsType = folly::MultiLevelTimeSeries<VT>;
+  using HistogramType = folly::TimeseriesHistogram<VT>;
+
+  explicit StatsCounter(std::unique_ptr<StatsType> stats);
+  explicit StatsCounter(std::unique_ptr<HistogramType> histogram);
+
+  void addValue(VT value);
+
+  // Flush the buffers of all threads, the returned lock protects stats() and histogram()
+  std::unique_lock<std::mutex> flush();
+
+  StatsType* stats() const {
+    return stats_.get();
+  }
+
+  HistogramType* histogram() const {
+    return histogram_.get();
+  }
+
+ private:
+  struct Buffer {
+    explicit Buffer(StatsCounter* counter) : counter_(counter) {}
+    ~Buffer();
+
+    StatsCounter* counter_;
+    // Protect the buffer from the readers flushing it, only contended when reading
+    folly::MicroSpinLock lock_{0};
+    int64_t second_{0};
+    VT sum_{0};
+    uint64_t count_{0};
+    // Only used by histogram
+    std::vector<VT> values_;
+  };
+  struct BufferTag {};
+
+  // Move the buffered values into the time series, both locks must be held
+  void flushBuffer(Buffer& buffer);
+
+  std::mutex lock_;
+  std::unique_ptr<StatsType> stats_;
+  std::unique_ptr<HistogramType> histogram_;
+  // Destroyed first, so the buffers of alive threads are flushed into the time series
+  folly::ThreadLocal<Buffer, BufferTag, folly::AccessModeStrict> buffers_;
 };
 
 /**
@@ -86,9 +154,9 @@ class CounterId final {
  *   error.count.600    -- Total number of errors in the last ten minutes
  */
 class StatsManager final {
-  using VT = int64_t;
-  using StatsType = folly::MultiLevelTimeSeries<VT>;
-  using HistogramType = folly::TimeseriesHistogram<VT>;
+  using VT = StatsCounter::VT;
+  using StatsType = StatsCounter::StatsType;
+  using HistogramType = StatsCounter::HistogramType;
   using LabelPair = std::pair<std::string, std::string>;
 
  public:
@@ -177,13 +245,14 @@ class StatsManager final {
     VT bucketSize_, min_, max_;
 
     CounterInfo(const std::string& index,
+                std::shared_ptr<StatsCounter> counter,
                 std::vector<StatsMethod>&& methods,
                 std::vector<std::pair<std::string, double>>&& percentiles,
                 bool isHisto = false,
                 VT bucketSize = VT(),
                 VT min = VT(),
                 VT max = VT())
-        : id_(index, isHisto),
+        : id_(index, isHisto, std::move(counter)),
           methods_(std::move(methods)),
           percentiles_(std::move(percentiles)),
           bucketSize_(bucketSize),
@@ -195,21 +264,9 @@ class StatsManager final {
   HostAddr collectorAddr_{"", 0};
   int32_t interval_{0};
 
-  // <counter_name> => index
-  // when index > 0, (index - 1) is the index of stats_ list
-  // when index < 0, [- (index + 1)] is the index of histograms_ list
+  // <counter_name> => counter, the counters are owned by the ids
   folly::RWSpinLock nameMapLock_;
   std::unordered_map<std::string, CounterInfo> nameMap_;
-
-  // All time series stats
-  folly::ConcurrentHashMap<std::string,
-                           std::pair<std::unique_ptr<std::mutex>, std::unique_ptr<StatsType>>>
-      stats_;
-
-  // All histogram stats
-  std::unordered_map<std::string,
-                     std::pair<std::unique_ptr<std::mutex>, std::unique_ptr<HistogramType>>>
-      histograms_;
 };
 
 }  // namespace stats
@@ -43,6 +43,18 @@ BENCHMARK(add_stats_value_8t, iters) {
   statsBM(kCounterStats, 8, iters);
 }
 
+BENCHMARK(add_stats_value_16t, iters) {
+  statsBM(kCounterStats, 16, iters);
+}
+
+BENCHMARK(add_stats_value_32t, iters) {
+  statsBM(kCounterStats, 32, iters);
+}
+
+BENCHMARK(add_stats_value_64t, iters) {
+  statsBM(kCounterStats, 64, iters);
+}
+
 BENCHMARK_DRAW_LINE();
 
 BENCHMARK(add_histogram_value_1t, iters) {
@@ -57,6 +69,18 @@ BENCHMARK(add_histogram_value_8t, iters) {
   statsBM(kCounterHisto, 8, iters);
 }
 
+BENCHMARK(add_histogram_value_16t, iters) {
+  statsBM(kCounterHisto, 16, iters);
+}
+
+BENCHMARK(add_histogram_value_32t, iters) {
+  statsBM(kCounterHisto, 32, iters);
+}
+
+BENCHMARK(add_histogram_value_64t, iters) {
+  statsBM(kCounterHisto, 64, iters);
+}
+
 int main(int argc, char** argv) {
   folly::init(&argc, &argv, true);
 
@@ -68,7 +92,8 @@ int main(int argc, char** argv) {
 }
 
 /*
-Test on Intel i7-8650U CPU @ 1.90GHz, 8GB RAM
+Test on Intel i7-8650U CPU @ 1.90GHz, 8GB RAM, before values were buffered per thread, i.e. each
+addValue locked the counter
 
 ============================================================================
 StatsManagerBenchmark.cpp                       relative  time/iter  iters/s
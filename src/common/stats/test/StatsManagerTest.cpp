@@ -99,6 +99,30 @@ bool counterExists(const folly::dynamic& stats, const std::string& counter, int6
   return false;
 }
 
+TEST(StatsManager, ReadBufferedValuesTest) {
+  auto statId = StatsManager::registerStats("stat05", "sum");
+  auto histoId = StatsManager::registerHisto("stat06", 1, 1, 100, "p99");
+  // The values buffered by alive threads are visible to readers
+  auto worker = std::make_unique<thread::GenericWorker>();
+  ASSERT_TRUE(worker->start());
+  worker
+      ->addTask([&statId, &histoId]() {
+        for (int k = 1; k <= 10; k++) {
+          StatsManager::addValue(statId, k);
+          StatsManager::addValue(histoId, k);
+        }
+      })
+      .get();
+
+  EXPECT_EQ(55, StatsManager::readValue("stat05.sum.60").value());
+  EXPECT_EQ(10, StatsManager::readValue("stat05.count.60").value());
+  EXPECT_EQ(55, StatsManager::readValue("stat06.sum.60").value());
+  EXPECT_EQ(10, StatsManager::readValue("stat06.p99.60").value());
+
+  worker->stop();
+  worker->wait();
+}
+
 TEST(StatsManager, ReadAllTest) {
   auto statId1 = StatsManager::registerStats("stat03", "RATE, sum");
   auto statId2 = StatsManager::registerHisto("stat04", 1, 1, 100, "sum, p95, p99");
@@ -5,11 +5,20 @@
 
 #include "common/thread/GenericThreadPool.h"
 
+#include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+
 #include "common/base/Base.h"
 
 namespace nebula {
 namespace thread {
 
+namespace {
+// The pool and the index of deque which current thread belongs to
+thread_local const GenericThreadPool *tlsPool = nullptr;
+thread_local size_t tlsIndex = 0;
+}  // namespace
+
 GenericThreadPool::GenericThreadPool() {}
 
 GenericThreadPool::~GenericThreadPool() {
@@ -17,11 +26,28 @@ GenericThreadPool::~GenericThreadPool() {
   wait();
 }
 
-bool GenericThreadPool::start(size_t nrThreads, const std::string &name) {
+bool GenericThreadPool::start(size_t nrThreads, const std::string &name, bool workStealing) {
   if (nrThreads_ != 0) {
     return false;
   }
   nrThreads_ = nrThreads;
+  workStealing_ = workStealing;
+  if (workStealing_) {
+    timer_ = std::make_unique<GenericWorker>();
+    if (!timer_->start(folly::stringPrintf("%s-timer", name.c_str()))) {
+      return false;
+    }
+    stopped_.store(false, std::memory_order_release);
+    for (auto i = 0UL; i < nrThreads_; i++) {
+      queues_.emplace_back(std::make_unique<TaskQueue>());
+    }
+    for (auto i = 0UL; i < nrThreads_; i++) {
+      auto workerName = folly::stringPrintf("%s-%lu", name.c_str(), i);
+      threads_.emplace_back(
+          std::make_unique<NamedThread>(workerName, &GenericThreadPool::loop, this, i));
+    }
+    return true;
+  }
   auto ok = true;
   for (auto i = 0UL; ok && i < nrThreads_; i++) {
     pool_.emplace_back(std::make_unique<GenericWorker>());
@@ -32,6 +58,18 @@ bool GenericThreadPool::start(size_t nrThreads, const std::string &name) {
 }
 
 bool GenericThreadPool::stop() {
+  if (workStealing_) {
+    {
+      // Under the lock, so that a task is either rejected or seen by the threads before exiting
+      std::lock_guard<std::mutex> guard(sleepLock_);
+      if (stopped_.exchange(true, std::memory_order_acq_rel)) {
+        return false;
+      }
+    }
+    timer_->stop();
+    sleepCond_.notify_all();
+    return true;
+  }
   auto ok = true;
   for (auto &worker : pool_) {
     ok = worker->stop() && ok;
@@ -41,6 +79,16 @@ bool GenericThreadPool::stop() {
 
 bool GenericThreadPool::wait() {
   auto ok = true;
+  if (workStealing_) {
+    ok = timer_ != nullptr && timer_->wait();
+    // The threads exit after the queued tasks are finished
+    for (auto &thread : threads_) {
+      thread->join();
+    }
+    threads_.clear();
+    queues_.clear();
+    timer_.reset();
+  }
   for (auto &worker : pool_) {
     ok = worker->wait() && ok;
   }
@@ -49,7 +97,125 @@ bool GenericThreadPool::wait() {
   return ok;
 }
 
+size_t GenericThreadPool::queueDepth() {
+  if (workStealing_) {
+    return numPending_.load(std::memory_order_relaxed);
+  }
+  size_t depth = 0;
+  for (auto &worker : pool_) {
+    std::lock_guard<std::mutex> guard(worker->lock_);
+    depth += worker->pendingTasks_.size();
+  }
+  return depth;
+}
+
+bool GenericThreadPool::enqueue(std::function<void()> task) {
+  auto idx = tlsPool == this ? tlsIndex : nextThread_++ % nrThreads_;
+  // Hold the lock to avoid missing the wakeup of a thread going to sleep, or queuing a task after
+  // the threads exit
+  std::unique_lock<std::mutex> sleepGuard(sleepLock_);
+  if (stopped_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> guard(queues_[idx]->lock_);
+    queues_[idx]->tasks_.emplace_back(std::move(task));
+    numPending_.fetch_add(1, std::memory_order_release);
+  }
+  sleepGuard.unlock();
+  sleepCond_.notify_one();
+  return true;
+}
+
+bool GenericThreadPool::enqueueDelay(size_t ms, std::function<void()> task) {
+  if (stopped_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  // Dropped if the pool is stopped before it is due
+  timer_->addTimerTask(ms, 0, [this, task = std::move(task)]() mutable {
+    enqueue(std::move(task));
+  });
+  return true;
+}
+
+uint64_t GenericThreadPool::enqueueRepeat(size_t ms, std::function<void()> task) {
+  auto running = std::make_shared<std::atomic<bool>>(false);
+  auto shared = std::make_shared<std::function<void()>>(std::move(task));
+  return timer_->addRepeatTask(ms, [this, running, shared] {
+    if (running->exchange(true)) {
+      // The last run has not finished yet
+      return;
+    }
+    enqueue([running, shared] {
+      SCOPE_EXIT {
+        running->store(false);
+      };
+      (*shared)();
+    });
+  });
+}
+
+bool GenericThreadPool::nextTask(size_t idx, std::function<void()> &task) {
+  {
+    auto &queue = *queues_[idx];
+    std::lock_guard<std::mutex> guard(queue.lock_);
+    if (!queue.tasks_.empty()) {
+      task = std::move(queue.tasks_.front());
+      queue.tasks_.pop_front();
+      numPending_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  auto start = folly::Random::rand32(nrThreads_);
+  for (auto i = 0UL; i < nrThreads_; i++) {
+    auto victim = (start + i) % nrThreads_;
+    if (victim == idx) {
+      continue;
+    }
+    auto &queue = *queues_[victim];
+    std::lock_guard<std::mutex> guard(queue.lock_);
+    if (!queue.tasks_.empty()) {
+      // Steal the newest one, which has to wait the longest on the victim
+      task = std::move(queue.tasks_.back());
+      queue.tasks_.pop_back();
+      numPending_.fetch_sub(1, std::memory_order_relaxed);
+      numSteals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+void GenericThreadPool::loop(size_t idx) {
+  tlsPool = this;
+  tlsIndex = idx;
+  std::function<void()> task;
+  while (true) {
+    if (nextTask(idx, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(sleepLock_);
+    if (numPending_.load(std::memory_order_acquire) > 0) {
+      continue;
+    }
+    if (stopped_.load(std::memory_order_acquire)) {
+      break;
+    }
+    sleepCond_.wait(guard, [this] {
+      return numPending_.load(std::memory_order_acquire) > 0 ||
+             stopped_.load(std::memory_order_acquire);
+    });
+  }
+  tlsPool = nullptr;
+}
+
 void GenericThreadPool::purgeTimerTask(uint64_t id) {
+  if (workStealing_) {
+    timer_->purgeTimerTask(id);
+    return;
+  }
   auto idx = (id >> GenericWorker::TIMER_ID_BITS);
   id = (id & GenericWorker::TIMER_ID_MASK);
   pool_[idx]->purgeTimerTask(id);
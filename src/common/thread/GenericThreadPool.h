@@ -6,9 +6,12 @@
 #define COMMON_THREAD_GENERICTHREADPOOL_H_
 
 #include <boost/core/noncopyable.hpp>
+#include <condition_variable>
+#include <deque>
 
 #include "common/cpp/helpers.h"
 #include "common/thread/GenericWorker.h"
+#include "common/thread/NamedThread.h"
 
 /**
  * Based on GenericWorker, GenericThreadPool implements a thread pool that
@@ -17,6 +20,14 @@
  * Under the hood, GenericThreadPool distributes tasks around the internal
  * threads in a round-robin way.
  *
+ * Optionally, the pool could be started in the work-stealing mode, in which
+ * each thread owns a task deque and the idle threads steal tasks from the
+ * tail of a randomly chosen busy one, so that a long task does not delay the
+ * tasks queued behind it. The tasks added by a thread of the pool are queued
+ * to its own deque. In this mode the delayed and repeated tasks are timed by
+ * a dedicated timer thread and queued when due, and a repeated task is skipped
+ * in a period if its last run has not finished yet.
+ *
  * Please NOTE that, as the name indicates, this a thread pool for the general
  * purpose, but not for the performance critical situation.
  */
@@ -41,13 +52,18 @@ class GenericThreadPool final : public boost::noncopyable, public nebula::cpp::N
    * A GenericThreadPool MUST be `start'ed successfully before invoking
    * any other interfaces.
    *
-   * @nrThreads   number of internal threads
-   * @name        name of internal threads
+   * @nrThreads     number of internal threads
+   * @name          name of internal threads
+   * @workStealing  whether to schedule tasks by work stealing
    */
-  bool start(size_t nrThreads, const std::string &name = "");
+  bool start(size_t nrThreads, const std::string &name = "", bool workStealing = false);
 
   /**
    * Asynchronously to notify the workers to stop handling further new tasks.
+   *
+   * In the work-stealing mode, the tasks queued before are still run, and the
+   * ones added afterwards are rejected with an exception in their futures.
+   * The delayed tasks not due yet are dropped, so their futures are broken.
    */
   bool stop();
 
@@ -123,16 +139,64 @@ class GenericThreadPool final : public boost::noncopyable, public nebula::cpp::N
   template <typename F, typename... Args>
   void addRepeatTaskForAll(size_t ms, F &&f, Args &&... args);
 
+  /**
+   * Number of tasks queued but not started yet, the timer tasks not due are not included.
+   */
+  size_t queueDepth();
+
+  /**
+   * Number of tasks stolen by the idle threads since started, always 0 if not work stealing.
+   */
+  uint64_t numSteals() const {
+    return numSteals_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct TaskQueue {
+    std::mutex lock_;
+    std::deque<std::function<void()>> tasks_;
+  };
+
+  // Queue the task to the deque of current thread if it belongs to the pool,
+  // otherwise to the deques in a round-robin way. Return false if stopped
+  bool enqueue(std::function<void()> task);
+  bool enqueueDelay(size_t ms, std::function<void()> task);
+  uint64_t enqueueRepeat(size_t ms, std::function<void()> task);
+  // Pop the head of its own deque, or steal the tail of others
+  bool nextTask(size_t idx, std::function<void()> &task);
+  void loop(size_t idx);
+
  private:
   size_t nrThreads_{0};
   std::atomic<size_t> nextThread_{0};
   std::vector<std::unique_ptr<GenericWorker>> pool_;
+
+  // Only used in the work-stealing mode
+  bool workStealing_{false};
+  std::atomic<bool> stopped_{true};
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::unique_ptr<NamedThread>> threads_;
+  std::unique_ptr<GenericWorker> timer_;
+  std::mutex sleepLock_;
+  std::condition_variable sleepCond_;
+  std::atomic<size_t> numPending_{0};
+  std::atomic<uint64_t> numSteals_{0};
 };
 
 template <typename F, typename... Args>
 auto GenericThreadPool::addTask(F &&f, Args &&... args) ->
     typename std::enable_if<!std::is_void<ReturnType<F, Args...>>::value,
                             FutureType<F, Args...>>::type {
+  if (workStealing_) {
+    auto promise = std::make_shared<folly::Promise<ReturnType<F, Args...>>>();
+    auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto future = promise->getSemiFuture();
+    if (!enqueue([=] { promise->setWith(*task); })) {
+      promise->setException(std::runtime_error("The thread pool is stopped"));
+    }
+    return future;
+  }
   auto idx = nextThread_++ % nrThreads_;
   return pool_[idx]->addTask(std::forward<F>(f), std::forward<Args>(args)...);
 }
@@ -140,6 +204,16 @@ auto GenericThreadPool::addTask(F &&f, Args &&... args) ->
 template <typename F, typename... Args>
 auto GenericThreadPool::addTask(F &&f, Args &&... args) ->
     typename std::enable_if<std::is_void<ReturnType<F, Args...>>::value, UnitFutureType>::type {
+  if (workStealing_) {
+    auto promise = std::make_shared<folly::Promise<folly::Unit>>();
+    auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto future = promise->getSemiFuture();
+    if (!enqueue([=] { promise->setWith(*task); })) {
+      promise->setException(std::runtime_error("The thread pool is stopped"));
+    }
+    return future;
+  }
   auto idx = nextThread_++ % nrThreads_;
   return pool_[idx]->addTask(std::forward<F>(f), std::forward<Args>(args)...);
 }
@@ -148,6 +222,16 @@ template <typename F, typename... Args>
 auto GenericThreadPool::addDelayTask(size_t ms, F &&f, Args &&... args) ->
     typename std::enable_if<!std::is_void<ReturnType<F, Args...>>::value,
                             FutureType<F, Args...>>::type {
+  if (workStealing_) {
+    auto promise = std::make_shared<folly::Promise<ReturnType<F, Args...>>>();
+    auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto future = promise->getSemiFuture();
+    if (!enqueueDelay(ms, [=] { promise->setWith(*task); })) {
+      promise->setException(std::runtime_error("The thread pool is stopped"));
+    }
+    return future;
+  }
   auto idx = nextThread_++ % nrThreads_;
   return pool_[idx]->addDelayTask(ms, std::forward<F>(f), std::forward<Args>(args)...);
 }
@@ -155,12 +239,25 @@ auto GenericThreadPool::addDelayTask(size_t ms, F &&f, Args &&... args) ->
 template <typename F, typename... Args>
 auto GenericThreadPool::addDelayTask(size_t ms, F &&f, Args &&... args) ->
     typename std::enable_if<std::is_void<ReturnType<F, Args...>>::value, UnitFutureType>::type {
+  if (workStealing_) {
+    auto promise = std::make_shared<folly::Promise<folly::Unit>>();
+    auto task = std::make_shared<std::function<ReturnType<F, Args...>()>>(
+        std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    auto future = promise->getSemiFuture();
+    if (!enqueueDelay(ms, [=] { promise->setWith(*task); })) {
+      promise->setException(std::runtime_error("The thread pool is stopped"));
+    }
+    return future;
+  }
   auto idx = nextThread_++ % nrThreads_;
   return pool_[idx]->addDelayTask(ms, std::forward<F>(f), std::forward<Args>(args)...);
 }
 
 template <typename F, typename... Args>
 uint64_t GenericThreadPool::addRepeatTask(size_t ms, F &&f, Args &&... args) {
+  if (workStealing_) {
+    return enqueueRepeat(ms, std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+  }
   auto idx = nextThread_++ % nrThreads_;
   auto id = pool_[idx]->addRepeatTask(ms, std::forward<F>(f), std::forward<Args>(args)...);
   return ((idx << GenericWorker::TIMER_ID_BITS) | id);
@@ -169,7 +266,11 @@ uint64_t GenericThreadPool::addRepeatTask(size_t ms, F &&f, Args &&... args) {
 template <typename F, typename... Args>
 void GenericThreadPool::addRepeatTaskForAll(size_t ms, F &&f, Args &&... args) {
   for (auto idx = 0UL; idx < nrThreads_; ++idx) {
-    pool_[idx]->addRepeatTask(ms, std::forward<F>(f), std::forward<Args>(args)...);
+    if (workStealing_) {
+      enqueueRepeat(ms, std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+    } else {
+      pool_[idx]->addRepeatTask(ms, std::forward<F>(f), std::forward<Args>(args)...);
+    }
   }
 }
 }  // namespace thread
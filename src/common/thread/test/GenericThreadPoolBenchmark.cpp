@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/futures/Future.h>
+#include <folly/init/Init.h>
+
+#include "common/base/Base.h"
+#include "common/thread/GenericThreadPool.h"
+#include "common/time/Duration.h"
+
+DEFINE_uint32(pool_threads, 4, "Number of threads of pool");
+DEFINE_uint32(pool_tasks, 1024, "Number of tasks added in each iteration");
+DEFINE_uint32(long_task_every, 64, "One of every N tasks is a long one");
+DEFINE_uint32(long_task_us, 5000, "Duration of the long task in microseconds");
+DEFINE_uint32(short_task_us, 10, "Duration of the short task in microseconds");
+
+// Run the tasks of skewed durations, e.g. a snapshot or a large raft commit among the small
+// ones, on the pool scheduled in the round-robin way and by work stealing.
+
+namespace nebula {
+namespace thread {
+
+static void spin(size_t us) {
+  time::Duration clock;
+  while (clock.elapsedInUSec() < us) {
+  }
+}
+
+static void runSkewedTasks(size_t iters, bool workStealing) {
+  GenericThreadPool pool;
+  BENCHMARK_SUSPEND {
+    CHECK(pool.start(FLAGS_pool_threads, "bm", workStealing));
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    futures.reserve(FLAGS_pool_tasks);
+    for (size_t j = 0; j < FLAGS_pool_tasks; ++j) {
+      auto us = j % FLAGS_long_task_every == 0 ? FLAGS_long_task_us : FLAGS_short_task_us;
+      futures.emplace_back(pool.addTask(spin, us));
+    }
+    folly::collectAll(std::move(futures)).get();
+  }
+  BENCHMARK_SUSPEND {
+    pool.stop();
+    pool.wait();
+  }
+}
+
+BENCHMARK(RoundRobin, iters) {
+  runSkewedTasks(iters, false);
+}
+
+BENCHMARK_RELATIVE(WorkStealing, iters) {
+  runSkewedTasks(iters, true);
+}
+
+}  // namespace thread
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -3,6 +3,9 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include <folly/futures/Future.h>
+#include <folly/synchronization/Baton.h>
+#include <future>
 #include <gtest/gtest.h>
 
 #include "common/base/Base.h"
@@ -86,6 +89,106 @@ TEST(GenericThreadPool, addTask) {
   }
 }
 
+TEST(GenericThreadPool, WorkStealing) {
+  GenericThreadPool pool;
+  ASSERT_TRUE(pool.start(4, "stealing", true));
+  // the same interfaces as the round-robin mode
+  {
+    ASSERT_EQ("918", pool.addTask([](size_t i) { return std::to_string(i); }, 918).get());
+    volatile auto flag = false;
+    pool.addTask([&]() { flag = true; }).get();
+    ASSERT_TRUE(flag);
+    ASSERT_EQ(1, pool.addDelayTask(10, []() { return 1; }).get());
+  }
+  // the short tasks queued behind a long one are stolen by the idle threads
+  {
+    folly::Baton<> release;
+    std::atomic<size_t> finished{0};
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    futures.emplace_back(pool.addTask([&]() { release.wait(); }));
+    for (auto i = 0; i < 64; i++) {
+      futures.emplace_back(pool.addTask([&]() { finished++; }));
+    }
+    while (finished < 64) {
+      ::usleep(1000);
+    }
+    ASSERT_GT(pool.numSteals(), 0);
+    release.post();
+    folly::collectAll(std::move(futures)).get();
+    ASSERT_EQ(0, pool.queueDepth());
+  }
+  // the tasks added by the pool are queued to its own deque, the other threads are blocked so
+  // that the task would be stolen by the enqueuing thread if it were queued to theirs
+  {
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<size_t> blocked{0};
+    std::vector<folly::SemiFuture<folly::Unit>> blockers;
+    for (auto i = 0; i < 3; i++) {
+      blockers.emplace_back(pool.addTask([&blocked, released]() {
+        blocked++;
+        released.wait();
+      }));
+    }
+    while (blocked < 3) {
+      ::usleep(1000);
+    }
+    auto outer = pool.addTask([&]() {
+      auto steals = pool.numSteals();
+      auto inner = pool.addTask([]() { return std::this_thread::get_id(); });
+      return std::make_tuple(std::this_thread::get_id(), steals, std::move(inner));
+    });
+    auto [enqueuing, steals, inner] = std::move(outer).get();
+    ASSERT_EQ(enqueuing, std::move(inner).get());
+    ASSERT_EQ(steals, pool.numSteals());
+    release.set_value();
+    folly::collectAll(std::move(blockers)).get();
+  }
+  // the repeated task never runs concurrently with itself
+  {
+    struct State {
+      std::atomic<int> running{0};
+      std::atomic<bool> overlapped{false};
+      std::atomic<size_t> counter{0};
+    };
+    auto state = std::make_shared<State>();
+    auto id = pool.addRepeatTask(5, [state]() {
+      if (state->running++ > 0) {
+        state->overlapped = true;
+      }
+      ::usleep(20 * 1000);
+      state->counter++;
+      state->running--;
+    });
+    while (state->counter < 3) {
+      ::usleep(1000);
+    }
+    pool.purgeTimerTask(id);
+    ASSERT_FALSE(state->overlapped);
+  }
+  // the tasks queued before stopping are drained, and the ones added afterwards are rejected
+  {
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    std::atomic<size_t> finished{0};
+    for (auto i = 0; i < 4; i++) {
+      futures.emplace_back(pool.addTask([released]() { released.wait(); }));
+    }
+    for (auto i = 0; i < 16; i++) {
+      futures.emplace_back(pool.addTask([&]() { finished++; }));
+    }
+    ASSERT_TRUE(pool.stop());
+    release.set_value();
+    ASSERT_FALSE(pool.stop());
+    ASSERT_THROW(pool.addTask([]() { return 1; }).get(), std::runtime_error);
+    ASSERT_THROW(pool.addDelayTask(10, []() {}).get(), std::runtime_error);
+    folly::collectAll(std::move(futures)).get();
+    ASSERT_EQ(16, finished);
+  }
+  ASSERT_TRUE(pool.wait());
+}
+
 static testing::AssertionResult msAboutEqual(size_t expected, size_t actual) {
   if (std::max(expected, actual) - std::min(expected, actual) <= 10) {
     return testing::AssertionSuccess();
@@ -0,0 +1,79 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/thrift/RpcCompression.h"
+
+#include <folly/io/Compression.h>
+#include <folly/io/IOBuf.h>
+#include <thrift/lib/cpp2/server/ThriftServer.h>
+
+#include "common/time/Duration.h"
+
+DEFINE_int64(rpc_compression_min_bytes,
+             4096,
+             "The payload of a rpc is compressed only if it is larger than this size in bytes");
+DEFINE_bool(enable_rpc_server_compression,
+            true,
+            "Whether the server compresses the responses for the clients asking for it");
+
+namespace nebula {
+namespace thrift {
+
+static std::optional<folly::io::CodecType> codecType(const std::string& codec) {
+  if (codec == "zstd") {
+    return folly::io::CodecType::ZSTD;
+  } else if (codec == "zlib") {
+    return folly::io::CodecType::ZLIB;
+  }
+  return std::nullopt;
+}
+
+std::optional<apache::thrift::CompressionConfig> compressionConfig(const std::string& codec) {
+  if (codec.empty() || codec == "none") {
+    return std::nullopt;
+  }
+  apache::thrift::CodecConfig codecConfig;
+  if (codec == "zstd") {
+    codecConfig.set_zstdConfig(apache::thrift::ZstdCompressionCodecConfig());
+  } else if (codec == "zlib") {
+    codecConfig.set_zlibConfig(apache::thrift::ZlibCompressionCodecConfig());
+  } else {
+    // lz4 is not one of the codecs negotiated by rocket
+    LOG(WARNING) << "Unsupported rpc compression `" << codec << "', send payloads as they are";
+    return std::nullopt;
+  }
+  apache::thrift::CompressionConfig config;
+  config.codecConfig_ref() = std::move(codecConfig);
+  config.compressionSizeLimit_ref() = FLAGS_rpc_compression_min_bytes;
+  return config;
+}
+
+void setupServerCompression(apache::thrift::ThriftServer* server) {
+  if (FLAGS_enable_rpc_server_compression) {
+    server->setMinCompressBytes(static_cast<uint32_t>(FLAGS_rpc_compression_min_bytes));
+  } else {
+    // No response reaches the size, so none is compressed
+    server->setMinCompressBytes(std::numeric_limits<uint32_t>::max());
+  }
+}
+
+std::optional<CompressionSample> sampleCompression(const std::string& codec,
+                                                   folly::ByteRange payload) {
+  auto type = codecType(codec);
+  if (!type.has_value() || payload.size() < static_cast<size_t>(FLAGS_rpc_compression_min_bytes)) {
+    return std::nullopt;
+  }
+  CompressionSample sample;
+  sample.rawBytes = payload.size();
+  auto buf = folly::IOBuf::wrapBuffer(payload);
+  time::Duration duration;
+  auto compressed = folly::io::getCodec(*type)->compress(buf.get());
+  sample.costInUs = duration.elapsedInUSec();
+  sample.compressedBytes = compressed->computeChainDataLength();
+  return sample;
+}
+
+}  // namespace thrift
+}  // namespace nebula
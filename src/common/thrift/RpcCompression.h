@@ -0,0 +1,56 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_THRIFT_RPCCOMPRESSION_H_
+#define COMMON_THRIFT_RPCCOMPRESSION_H_
+
+#include <folly/Range.h>
+#include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
+
+#include "common/base/Base.h"
+
+DECLARE_int64(rpc_compression_min_bytes);
+DECLARE_bool(enable_rpc_server_compression);
+
+namespace apache {
+namespace thrift {
+class ThriftServer;
+}  // namespace thrift
+}  // namespace apache
+
+namespace nebula {
+namespace thrift {
+
+/**
+ * Build the compression config of a rpc client from the codec name, `none', `zstd' or `zlib'.
+ * The config is carried in the metadata of each request, payloads smaller than
+ * --rpc_compression_min_bytes are sent as they are, and the server compresses the response
+ * in the same way unless --enable_rpc_server_compression is off on the server.
+ */
+std::optional<apache::thrift::CompressionConfig> compressionConfig(const std::string& codec);
+
+/**
+ * Apply --enable_rpc_server_compression and --rpc_compression_min_bytes to a server, so a server
+ * short of cpu could stop compressing the responses whatever its clients ask for.
+ */
+void setupServerCompression(apache::thrift::ThriftServer* server);
+
+// The result of compressing a payload offline
+struct CompressionSample {
+  size_t rawBytes{0};
+  size_t compressedBytes{0};
+  uint64_t costInUs{0};
+};
+
+/**
+ * Compress the payload with the codec to estimate how much a compressed rpc saves, none if the
+ * codec is unknown or the payload is under --rpc_compression_min_bytes.
+ */
+std::optional<CompressionSample> sampleCompression(const std::string& codec,
+                                                   folly::ByteRange payload);
+
+}  // namespace thrift
+}  // namespace nebula
+#endif  // COMMON_THRIFT_RPCCOMPRESSION_H_
@@ -88,6 +88,11 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
   if (compatibility) {
     clientChannel->setProtocolId(apache::thrift::protocol::T_BINARY_PROTOCOL);
     //    clientChannel->setClientType(THRIFT_UNFRAMED_DEPRECATED);
+  } else {
+    clientChannel->setProtocolId(apache::thrift::protocol::T_COMPACT_PROTOCOL);
+  }
+  if (compression_.has_value()) {
+    clientChannel->setDesiredCompressionConfig(*compression_);
   }
   std::shared_ptr<ClientType> client(new ClientType(std::move(clientChannel)), [evb](auto* p) {
     evb->runImmediatelyOrRunInEventBaseThreadAndWait([p] { delete p; });
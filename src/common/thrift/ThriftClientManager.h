@@ -11,6 +11,7 @@
 
 #include "common/base/Base.h"
 #include "common/datatypes/HostAddr.h"
+#include "common/thrift/RpcCompression.h"
 
 namespace nebula {
 namespace thrift {
@@ -27,7 +28,9 @@ class ThriftClientManager final {
     VLOG(3) << "~ThriftClientManager";
   }
 
-  explicit ThriftClientManager(bool enableSSL = false) : enableSSL_(enableSSL) {
+  // compression is the codec of the rpc payloads, see thrift::compressionConfig
+  explicit ThriftClientManager(bool enableSSL = false, const std::string& compression = "none")
+      : enableSSL_(enableSSL), compression_(compressionConfig(compression)) {
     VLOG(3) << "ThriftClientManager";
   }
 
@@ -38,6 +41,8 @@ class ThriftClientManager final {
   folly::ThreadLocal<ClientMap> clientMap_;
   // whether enable ssl
   bool enableSSL_{false};
+  // none if the payloads are not compressed
+  std::optional<apache::thrift::CompressionConfig> compression_;
 };
 
 }  // namespace thrift
@@ -31,8 +31,9 @@ class LocalClientManager final {
     VLOG(3) << "~LocalClientManager";
   }
 
-  explicit LocalClientManager(bool enableSSL = false) {
+  explicit LocalClientManager(bool enableSSL = false, const std::string& compression = "none") {
     UNUSED(enableSSL);
+    UNUSED(compression);
     VLOG(3) << "LocalClientManager";
   }
 };
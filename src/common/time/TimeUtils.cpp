@@ -10,6 +10,7 @@
 #include "common/fs/FileUtils.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/time/parser/DatetimeReader.h"
+#include "common/time/parser/FastDatetimeReader.h"
 
 namespace nebula {
 namespace time {
@@ -209,6 +210,10 @@ StatusOr<Value> TimeUtils::toTimestamp(const Value &val) {
 }
 
 /*static*/ StatusOr<Result> TimeUtils::parseDateTime(const std::string &str) {
+  Result fast;
+  if (FastDatetimeReader::readDatetime(str, fast)) {
+    return fast;
+  }
   auto p = DatetimeReader();
   auto result = p.readDatetime(str);
   NG_RETURN_IF_ERROR(result);
@@ -216,6 +221,10 @@ StatusOr<Value> TimeUtils::toTimestamp(const Value &val) {
 }
 
 /*static*/ StatusOr<Date> TimeUtils::parseDate(const std::string &str) {
+  Date fast;
+  if (FastDatetimeReader::readDate(str, fast)) {
+    return fast;
+  }
   auto p = DatetimeReader();
   auto result = p.readDate(str);
   NG_RETURN_IF_ERROR(result);
@@ -223,6 +232,10 @@ StatusOr<Value> TimeUtils::toTimestamp(const Value &val) {
 }
 
 /*static*/ StatusOr<TimeResult> TimeUtils::parseTime(const std::string &str) {
+  TimeResult fast;
+  if (FastDatetimeReader::readTime(str, fast)) {
+    return fast;
+  }
   auto p = DatetimeReader();
   return p.readTime(str);
 }
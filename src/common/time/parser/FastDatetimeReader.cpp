@@ -0,0 +1,171 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/time/parser/FastDatetimeReader.h"
+
+#include "common/time/TimeConversion.h"
+#include "common/time/TimeUtils.h"
+
+namespace nebula {
+namespace time {
+
+namespace {
+
+// Read n digits, return -1 if any of them is not a digit
+inline int64_t readDigits(const char *pos, size_t n) {
+  int64_t val = 0;
+  bool ok = true;
+  for (size_t i = 0; i < n; ++i) {
+    auto digit = static_cast<uint8_t>(pos[i] - '0');
+    ok &= digit <= 9;
+    val = val * 10 + digit;
+  }
+  return ok ? val : -1;
+}
+
+// YYYY-MM-DD
+bool readDatePart(const char *&pos, const char *end, Date &date) {
+  if (end - pos < 10 || pos[4] != '-' || pos[7] != '-') {
+    return false;
+  }
+  auto year = readDigits(pos, 4);
+  auto month = readDigits(pos + 5, 2);
+  auto day = readDigits(pos + 8, 2);
+  if ((year | month | day) < 0) {
+    return false;
+  }
+  date = Date(year, month, day);
+  if (!TimeUtils::validateDate(date).ok()) {
+    return false;
+  }
+  pos += 10;
+  return true;
+}
+
+// hh:mm[:ss[.ffffff]]
+bool readTimePart(const char *&pos, const char *end, Time &time) {
+  if (end - pos < 5 || pos[2] != ':') {
+    return false;
+  }
+  auto hour = readDigits(pos, 2);
+  auto minute = readDigits(pos + 3, 2);
+  int64_t sec = 0;
+  int64_t microsec = 0;
+  pos += 5;
+  if (pos < end && *pos == ':') {
+    if (end - pos < 3) {
+      return false;
+    }
+    sec = readDigits(pos + 1, 2);
+    pos += 3;
+    if (pos < end && *pos == '.') {
+      ++pos;
+      // Leave the fractions beyond microsecond to DatetimeReader, which rounds them
+      size_t n = 0;
+      while (pos + n < end && n <= 6 && std::isdigit(static_cast<unsigned char>(pos[n]))) {
+        ++n;
+      }
+      if (n == 0 || n > 6) {
+        return false;
+      }
+      microsec = readDigits(pos, n);
+      for (auto i = n; i < 6; ++i) {
+        microsec *= 10;
+      }
+      pos += n;
+    }
+  }
+  if ((hour | minute | sec) < 0) {
+    return false;
+  }
+  time = Time(hour, minute, sec, microsec);
+  return TimeUtils::validateTime(time).ok();
+}
+
+// (+|-)hh:mm
+bool readOffsetPart(const char *&pos, const char *end, int64_t &offset) {
+  if (end - pos != 6 || (pos[0] != '+' && pos[0] != '-') || pos[3] != ':') {
+    return false;
+  }
+  auto hour = readDigits(pos + 1, 2);
+  auto minute = readDigits(pos + 4, 2);
+  if ((hour | minute) < 0) {
+    return false;
+  }
+  auto time = Time(hour, minute, 0, 0);
+  if (!TimeUtils::validateTime(time).ok()) {
+    return false;
+  }
+  offset = TimeConversion::timeToSeconds(time);
+  if (pos[0] == '-') {
+    offset = -offset;
+  }
+  pos += 6;
+  return true;
+}
+
+}  // namespace
+
+// static
+bool FastDatetimeReader::readDatetime(folly::StringPiece input, Result &result) {
+  const char *pos = input.begin();
+  const char *end = input.end();
+  Date date;
+  if (!readDatePart(pos, end, date)) {
+    return false;
+  }
+  if (pos == end) {
+    result = Result{DateTime(date), false};
+    return true;
+  }
+  if (*pos != 'T' && *pos != ' ') {
+    return false;
+  }
+  ++pos;
+  Time time;
+  if (!readTimePart(pos, end, time)) {
+    return false;
+  }
+  if (pos == end) {
+    result = Result{DateTime(date, time), false};
+    return true;
+  }
+  int64_t offset = 0;
+  if (!readOffsetPart(pos, end, offset)) {
+    return false;
+  }
+  result = Result{TimeConversion::dateTimeShift(DateTime(date, time), -offset), true};
+  return true;
+}
+
+// static
+bool FastDatetimeReader::readDate(folly::StringPiece input, Date &date) {
+  const char *pos = input.begin();
+  return readDatePart(pos, input.end(), date) && pos == input.end();
+}
+
+// static
+bool FastDatetimeReader::readTime(folly::StringPiece input, TimeResult &result) {
+  const char *pos = input.begin();
+  const char *end = input.end();
+  Time time;
+  if (!readTimePart(pos, end, time)) {
+    return false;
+  }
+  auto dt = DateTime(1970, 1, 1, time.hour, time.minute, time.sec, time.microsec);
+  if (pos == end) {
+    result = TimeResult{dt.time(), false};
+    return true;
+  }
+  int64_t offset = 0;
+  if (!readOffsetPart(pos, end, offset)) {
+    return false;
+  }
+  result = TimeResult{TimeConversion::dateTimeShift(dt, -offset).time(), true};
+  return true;
+}
+
+}  // namespace time
+}  // namespace nebula
@@ -0,0 +1,34 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_TIME_PARSER_FASTDATETIMEREADER_H
+#define COMMON_TIME_PARSER_FASTDATETIMEREADER_H
+
+#include "common/base/Base.h"
+#include "common/datatypes/Date.h"
+#include "common/time/parser/Result.h"
+
+namespace nebula {
+namespace time {
+
+// Read the canonical ISO-8601 forms by hand, without the scanner and parser set up by
+// DatetimeReader for each string:
+//   date:      YYYY-MM-DD
+//   time:      hh:mm[:ss[.ffffff]][(+|-)hh:mm]
+//   datetime:  date[(T| )time]
+// It returns false for any other form or invalid value, which should be read by
+// DatetimeReader then, so the results and error messages are the same as before.
+class FastDatetimeReader {
+ public:
+  static bool readDatetime(folly::StringPiece input, Result &result);
+
+  static bool readDate(folly::StringPiece input, Date &date);
+
+  static bool readTime(folly::StringPiece input, TimeResult &result);
+};
+
+}  // namespace time
+}  // namespace nebula
+#endif
@@ -8,6 +8,7 @@
 #include "common/base/Base.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/time/parser/DatetimeReader.h"
+#include "common/time/parser/FastDatetimeReader.h"
 #include "common/time/parser/Result.h"
 
 namespace nebula {
@@ -372,6 +373,55 @@ TEST(DatetimeReader, TimeFailed) {
   }
 }
 
+TEST(FastDatetimeReader, SameAsDatetimeReader) {
+  // canonical forms
+  for (const auto &str : {"2019-01-03",
+                          "2019-01-03T22:22",
+                          "2019-01-03 22:22:03",
+                          "2019-01-03T22:22:03.2333",
+                          "2019-01-03T22:22:03.000001",
+                          "2019-01-03T22:22:03.999999+02:30",
+                          "2019-12-31T23:59:59-11:00",
+                          "2020-02-29T00:00:00+00:00"}) {
+    time::Result result;
+    ASSERT_TRUE(time::FastDatetimeReader::readDatetime(str, result)) << str;
+    auto expected = time::DatetimeReader().readDatetime(str);
+    ASSERT_TRUE(expected.ok()) << expected.status();
+    EXPECT_EQ(expected.value(), result) << str;
+  }
+  for (const auto &str : {"2019-01-03", "2020-02-29", "0001-12-31"}) {
+    Date result;
+    ASSERT_TRUE(time::FastDatetimeReader::readDate(str, result)) << str;
+    auto expected = time::DatetimeReader().readDate(str);
+    ASSERT_TRUE(expected.ok()) << expected.status();
+    EXPECT_EQ(expected.value(), result) << str;
+  }
+  for (const auto &str : {"22:22", "22:22:03", "22:22:03.2333", "00:00:00.5-08:00"}) {
+    time::TimeResult result;
+    ASSERT_TRUE(time::FastDatetimeReader::readTime(str, result)) << str;
+    auto expected = time::DatetimeReader().readTime(str);
+    ASSERT_TRUE(expected.ok()) << expected.status();
+    EXPECT_EQ(expected.value(), result) << str;
+  }
+  // left to DatetimeReader
+  for (const auto &str : {"2019",
+                          "2019-01",
+                          "-2019-01-03",
+                          "2019-1-3",
+                          "2019-02-30",
+                          "2019-01-03T22:22:3",
+                          "2019-01-03T22:22:03.1234567",
+                          "2019-01-03T24:00:00",
+                          "2019-01-03T22:22:03Z",
+                          "2019-01-03T22:22:03[Asia/Shanghai]",
+                          "2019-01-03T22:22:03+02:30[Asia/Shanghai]",
+                          " 2019-01-03",
+                          "2019-01-03 "}) {
+    time::Result result;
+    EXPECT_FALSE(time::FastDatetimeReader::readDatetime(str, result)) << str;
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char **argv) {
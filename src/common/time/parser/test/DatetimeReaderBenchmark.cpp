@@ -0,0 +1,69 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "common/base/Base.h"
+#include "common/time/parser/DatetimeReader.h"
+#include "common/time/parser/FastDatetimeReader.h"
+
+DEFINE_uint32(datetime_strings, 1000000, "Number of datetime strings read in each iteration");
+
+namespace nebula {
+namespace time {
+
+static std::vector<std::string> makeDatetimes(size_t num) {
+  std::vector<std::string> strs;
+  strs.reserve(num);
+  for (size_t i = 0; i < num; ++i) {
+    strs.emplace_back(folly::stringPrintf("%04lu-%02lu-%02luT%02lu:%02lu:%02lu.%06lu",
+                                          1970 + i % 100,
+                                          1 + i % 12,
+                                          1 + i % 28,
+                                          i % 24,
+                                          i % 60,
+                                          (i / 60) % 60,
+                                          i % 1000000));
+  }
+  return strs;
+}
+
+BENCHMARK(DatetimeReader, iters) {
+  std::vector<std::string> strs;
+  BENCHMARK_SUSPEND {
+    strs = makeDatetimes(FLAGS_datetime_strings);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    for (const auto& str : strs) {
+      auto result = DatetimeReader().readDatetime(str);
+      CHECK(result.ok()) << result.status();
+      folly::doNotOptimizeAway(result);
+    }
+  }
+}
+
+BENCHMARK_RELATIVE(FastDatetimeReader, iters) {
+  std::vector<std::string> strs;
+  BENCHMARK_SUSPEND {
+    strs = makeDatetimes(FLAGS_datetime_strings);
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    for (const auto& str : strs) {
+      Result result;
+      CHECK(FastDatetimeReader::readDatetime(str, result)) << str;
+      folly::doNotOptimizeAway(result);
+    }
+  }
+}
+
+}  // namespace time
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -130,6 +130,17 @@ std::string NebulaKeyUtils::systemBalanceKey(PartitionID partId) {
   return key;
 }
 
+// static
+std::string NebulaKeyUtils::systemStatsKey(PartitionID partId) {
+  uint32_t item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kSystem);
+  uint32_t type = static_cast<uint32_t>(NebulaSystemKeyType::kSystemStats);
+  std::string key;
+  key.reserve(kSystemLen);
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+      .append(reinterpret_cast<const char*>(&type), sizeof(NebulaSystemKeyType));
+  return key;
+}
+
 // static
 std::string NebulaKeyUtils::kvKey(PartitionID partId, const folly::StringPiece& name) {
   std::string key;
@@ -148,6 +159,92 @@ std::string NebulaKeyUtils::kvPrefix(PartitionID partId) {
   return key;
 }
 
+std::string NebulaKeyUtils::fulltextPrefix(PartitionID partId) {
+  PartitionID item = (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kFulltext);
+  std::string key;
+  key.reserve(sizeof(PartitionID));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+  return key;
+}
+
+// static
+std::string NebulaKeyUtils::adjacencyKey(size_t vIdLen,
+                                         PartitionID partId,
+                                         const VertexID& srcId,
+                                         EdgeType type,
+                                         const std::string& sortValue,
+                                         EdgeRanking rank,
+                                         const VertexID& dstId) {
+  CHECK_GE(vIdLen, dstId.size());
+  std::string key = adjacencyPrefix(vIdLen, partId, srcId, type);
+  key.reserve(key.size() + sortValue.size() + sizeof(EdgeRanking) + vIdLen);
+  key.append(sortValue)
+      .append(NebulaKeyUtils::encodeRank(rank))
+      .append(dstId.data(), dstId.size())
+      .append(vIdLen - dstId.size(), '\0');
+  return key;
+}
+
+// static
+std::string NebulaKeyUtils::encodeAdjacencyValue(const Value& v, bool desc) {
+  std::string raw;
+  if (v.isNull() || v.empty()) {
+    raw.append(1, '\1');
+  } else {
+    raw.append(1, '\0');
+    raw.append(IndexKeyUtils::encodeValue(v));
+  }
+  if (desc) {
+    for (auto& c : raw) {
+      c = ~c;
+    }
+  }
+  return raw;
+}
+
+// static
+std::string NebulaKeyUtils::adjacencyPrefix(size_t vIdLen,
+                                            PartitionID partId,
+                                            const VertexID& srcId,
+                                            EdgeType type) {
+  CHECK_GE(vIdLen, srcId.size());
+  PartitionID item =
+      (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kAdjacency);
+  std::string key;
+  key.reserve(sizeof(PartitionID) + vIdLen + sizeof(EdgeType));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+      .append(srcId.data(), srcId.size())
+      .append(vIdLen - srcId.size(), '\0')
+      .append(reinterpret_cast<const char*>(&type), sizeof(EdgeType));
+  return key;
+}
+
+// static
+std::string NebulaKeyUtils::adjacencyPrefix(PartitionID partId) {
+  PartitionID item =
+      (partId << kPartitionOffset) | static_cast<uint32_t>(NebulaKeyType::kAdjacency);
+  std::string key;
+  key.reserve(sizeof(PartitionID));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID));
+  return key;
+}
+
+// static
+std::string NebulaKeyUtils::adjacencyToEdgeKey(size_t vIdLen, const folly::StringPiece& rawKey) {
+  auto prefixLen = sizeof(PartitionID) + vIdLen + sizeof(EdgeType);
+  auto suffixLen = sizeof(EdgeRanking) + vIdLen;
+  CHECK_GE(rawKey.size(), prefixLen + suffixLen);
+  PartitionID item = (getPart(rawKey) << kPartitionOffset) |
+                     static_cast<uint32_t>(NebulaKeyType::kEdge);
+  std::string key;
+  key.reserve(kEdgeLen + (vIdLen << 1));
+  key.append(reinterpret_cast<const char*>(&item), sizeof(PartitionID))
+      .append(rawKey.data() + sizeof(PartitionID), vIdLen + sizeof(EdgeType))
+      .append(rawKey.data() + rawKey.size() - suffixLen, suffixLen)
+      .append(1, kEdgeVersion);
+  return key;
+}
+
 // static
 std::string NebulaKeyUtils::tagPrefix(size_t vIdLen,
                                       PartitionID partId,
@@ -258,6 +355,8 @@ std::vector<std::string> NebulaKeyUtils::snapshotPrefix(PartitionID partId) {
     result.emplace_back(edgePrefix(partId));
     result.emplace_back(IndexKeyUtils::indexPrefix(partId));
     result.emplace_back(kvPrefix(partId));
+    result.emplace_back(fulltextPrefix(partId));
+    result.emplace_back(adjacencyPrefix(partId));
     // kSystem will be written when balance data
     // kOperation will be blocked by jobmanager later
   }
@@ -6,6 +6,7 @@
 #ifndef COMMON_UTILS_NEBULAKEYUTILS_H_
 #define COMMON_UTILS_NEBULAKEYUTILS_H_
 
+#include "common/datatypes/Value.h"
 #include "common/utils/Types.h"
 
 namespace nebula {
@@ -25,6 +26,10 @@ namespace nebula {
  * LockKeyUtils:
  * type(1) + partId(3) + srcId(*) + edgeType(4) + edgeRank(8) + dstId(*) +
  * placeHolder(1)
+ *
+ * AdjacencyKeyUtils:
+ * type(1) + partId(3) + srcId(*) + edgeType(4) + sortValue(*) + edgeRank(8) + dstId(*)
+ * The sortValue is the encoded value of the adjacency order column, see encodeAdjacencyValue
  * */
 
 /**
@@ -79,9 +84,43 @@ class NebulaKeyUtils final {
 
   static std::string systemBalanceKey(PartitionID partId);
 
+  static std::string systemStatsKey(PartitionID partId);
+
   static std::string kvKey(PartitionID partId, const folly::StringPiece& name);
   static std::string kvPrefix(PartitionID partId);
 
+  /**
+   * Prefix for the builtin fulltext index
+   * */
+  static std::string fulltextPrefix(PartitionID partId);
+
+  /**
+   * Key of the adjacency index, the out (or in) edges of srcId are sorted by sortValue, which is
+   * returned by encodeAdjacencyValue
+   * */
+  static std::string adjacencyKey(size_t vIdLen,
+                                  PartitionID partId,
+                                  const VertexID& srcId,
+                                  EdgeType type,
+                                  const std::string& sortValue,
+                                  EdgeRanking rank,
+                                  const VertexID& dstId);
+
+  /**
+   * Encode the value of adjacency order column to keep the order in bytes. The first byte is 0 if
+   * the value is not null, and 1 if null, then the order-preserving encoding of value follows. All
+   * bytes are flipped in descending order. So null is the last one in ascending order and the
+   * first one in descending order, the same as how Value is compared.
+   * */
+  static std::string encodeAdjacencyValue(const Value& v, bool desc);
+
+  static std::string adjacencyPrefix(size_t vIdLen,
+                                     PartitionID partId,
+                                     const VertexID& srcId,
+                                     EdgeType type);
+
+  static std::string adjacencyPrefix(PartitionID partId);
+
   /**
    * Prefix for tag
    * */
@@ -155,6 +194,34 @@ class NebulaKeyUtils final {
     return static_cast<NebulaKeyType>(type) == NebulaKeyType::kEdge;
   }
 
+  static bool isFulltext(const folly::StringPiece& rawKey) {
+    constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+    auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+    return static_cast<NebulaKeyType>(type) == NebulaKeyType::kFulltext;
+  }
+
+  static bool isAdjacency(const folly::StringPiece& rawKey) {
+    constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
+    auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
+    return static_cast<NebulaKeyType>(type) == NebulaKeyType::kAdjacency;
+  }
+
+  /**
+   * @brief Get the key of the edge which the adjacency key points to. The length of sortValue
+   * depends on the column type, so the rank and dstId are located from the end.
+   */
+  static std::string adjacencyToEdgeKey(size_t vIdLen, const folly::StringPiece& rawKey);
+
+  /**
+   * @brief Get the encoded sortValue in adjacency key
+   */
+  static folly::StringPiece getAdjacencyValue(size_t vIdLen, const folly::StringPiece& rawKey) {
+    auto prefixLen = sizeof(PartitionID) + vIdLen + sizeof(EdgeType);
+    auto suffixLen = sizeof(EdgeRanking) + vIdLen;
+    DCHECK_GE(rawKey.size(), prefixLen + suffixLen);
+    return rawKey.subpiece(prefixLen, rawKey.size() - prefixLen - suffixLen);
+  }
+
   static bool isVertex(const folly::StringPiece& rawKey) {
     constexpr int32_t len = static_cast<int32_t>(sizeof(NebulaKeyType));
     auto type = readInt<uint32_t>(rawKey.data(), len) & kTypeMask;
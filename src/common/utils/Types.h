@@ -21,12 +21,15 @@ enum class NebulaKeyType : uint32_t {
   kVertex = 0x00000007,
   kPrime = 0x00000008,        // used in TOSS, if we write a lock succeed
   kDoublePrime = 0x00000009,  // used in TOSS, if we get RPC back from remote.
+  kFulltext = 0x0000000A,     // used by the builtin fulltext index
+  kAdjacency = 0x0000000B,    // used by the adjacency index sorted by an edge property
 };
 
 enum class NebulaSystemKeyType : uint32_t {
   kSystemCommit = 0x00000001,
   kSystemPart = 0x00000002,
   kSystemBalance = 0x00000003,
+  kSystemStats = 0x00000004,
 };
 
 enum class NebulaOperationType : uint32_t {
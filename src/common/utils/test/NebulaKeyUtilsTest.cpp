@@ -177,6 +177,43 @@ TEST_F(V2LongTest, RankTest) {
   verifyEdge(partId, srcId, type, rank, dstId, edgeVersion, 10);
 }
 
+TEST(KeyUtilsTest, AdjacencyTest) {
+  size_t vIdLen = 8;
+  PartitionID partId = 123;
+  VertexID srcId = "src", dstId = "dst";
+  EdgeType type = 101;
+  std::vector<Value> values = {Value(-100L), Value(-1L), Value(0L), Value(1L), Value(100L)};
+  values.emplace_back(Value::kNullValue);
+  for (bool desc : {false, true}) {
+    std::vector<std::string> keys;
+    for (size_t i = 0; i < values.size(); i++) {
+      auto sortValue = NebulaKeyUtils::encodeAdjacencyValue(values[i], desc);
+      auto key = NebulaKeyUtils::adjacencyKey(vIdLen, partId, srcId, type, sortValue, i, dstId);
+      ASSERT_TRUE(NebulaKeyUtils::isAdjacency(key));
+      ASSERT_FALSE(NebulaKeyUtils::isEdge(vIdLen, key));
+      ASSERT_EQ(0, key.find(NebulaKeyUtils::adjacencyPrefix(vIdLen, partId, srcId, type)));
+      ASSERT_EQ(0, key.find(NebulaKeyUtils::adjacencyPrefix(partId)));
+      ASSERT_EQ(sortValue, NebulaKeyUtils::getAdjacencyValue(vIdLen, key));
+      ASSERT_EQ(NebulaKeyUtils::edgeKey(vIdLen, partId, srcId, type, i, dstId),
+                NebulaKeyUtils::adjacencyToEdgeKey(vIdLen, key));
+      keys.emplace_back(std::move(key));
+    }
+    // The keys are in the order of values, and null is the greatest one
+    auto sorted = keys;
+    std::sort(sorted.begin(), sorted.end());
+    if (desc) {
+      std::reverse(sorted.begin(), sorted.end());
+    }
+    ASSERT_EQ(keys, sorted);
+  }
+
+  // The edges with the same value are in the order of rank
+  auto sortValue = NebulaKeyUtils::encodeAdjacencyValue(Value(1.5), false);
+  auto key1 = NebulaKeyUtils::adjacencyKey(vIdLen, partId, srcId, type, sortValue, -1, dstId);
+  auto key2 = NebulaKeyUtils::adjacencyKey(vIdLen, partId, srcId, type, sortValue, 1, dstId);
+  ASSERT_LT(key1, key2);
+}
+
 TEST(KeyUtilsTest, MiscTest) {
   PartitionID partId = 123;
   auto commitKey = NebulaKeyUtils::systemCommitKey(partId);
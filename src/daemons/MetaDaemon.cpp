@@ -17,6 +17,7 @@
 #include "common/process/ProcessUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/thread/GenericThreadPool.h"
+#include "common/thrift/RpcCompression.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "daemons/SetupLogging.h"
@@ -201,6 +202,7 @@ int main(int argc, char* argv[]) {
   try {
     metaServer->setPort(FLAGS_port);
     metaServer->setIdleTimeout(std::chrono::seconds(0));  // No idle timeout on client connection
+    nebula::thrift::setupServerCompression(metaServer.get());
     metaServer->setInterface(std::move(handler));
     if (FLAGS_enable_ssl || FLAGS_enable_meta_ssl) {
       metaServer->setSSLConfig(nebula::sslContextConfig());
@@ -19,6 +19,7 @@
 #include "common/network/NetworkUtils.h"
 #include "common/process/ProcessUtils.h"
 #include "common/ssl/SSLConfig.h"
+#include "common/thrift/RpcCompression.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "daemons/SetupLogging.h"
@@ -236,6 +237,7 @@ int main(int argc, char *argv[]) {
       gMetaServer = std::make_unique<apache::thrift::ThriftServer>();
       gMetaServer->setPort(FLAGS_meta_port);
       gMetaServer->setIdleTimeout(std::chrono::seconds(0));  // No idle timeout on client connection
+      nebula::thrift::setupServerCompression(gMetaServer.get());
       gMetaServer->setInterface(std::move(handler));
       if (FLAGS_enable_ssl || FLAGS_enable_meta_ssl) {
         gMetaServer->setSSLConfig(nebula::sslContextConfig());
@@ -26,16 +26,32 @@ void ExecutionContext::setResult(const std::string& name, Result&& result) {
   hist.emplace_back(std::move(result));
 }
 
-void ExecutionContext::dropResult(const std::string& name) {
-  folly::RWSpinLock::WriteHolder holder(lock_);
-  if (valueMap_.count(name) == 0) {
+ExecutionContext::~ExecutionContext() {
+  if (!FLAGS_enable_async_gc) {
     return;
   }
-  auto& val = valueMap_[name];
+  // Hand over all results of the query to GC at once instead of releasing them in the query thread
+  std::vector<Result> garbage;
+  for (auto& entry : valueMap_) {
+    auto& hist = entry.second;
+    std::move(hist.begin(), hist.end(), std::back_inserter(garbage));
+  }
+  GC::instance().clear(std::move(garbage));
+}
+
+void ExecutionContext::dropResult(const std::string& name) {
+  std::vector<Result> garbage;
+  {
+    folly::RWSpinLock::WriteHolder holder(lock_);
+    auto it = valueMap_.find(name);
+    if (it == valueMap_.end()) {
+      return;
+    }
+    garbage.swap(it->second);
+  }
+  // Release outside the lock, the results may be big
   if (FLAGS_enable_async_gc) {
-    GC::instance().clear(std::move(val));
-  } else {
-    val.clear();
+    GC::instance().clear(std::move(garbage));
   }
 }
 
@@ -38,7 +38,7 @@ class ExecutionContext {
 
   ExecutionContext() = default;
 
-  virtual ~ExecutionContext() = default;
+  virtual ~ExecutionContext();
 
   void initVar(const std::string& name) {
     folly::RWSpinLock::WriteHolder holder(lock_);
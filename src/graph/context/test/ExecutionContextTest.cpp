@@ -7,6 +7,8 @@
 
 #include "common/base/Base.h"
 #include "graph/context/ExecutionContext.h"
+#include "graph/gc/GC.h"
+#include "graph/service/GraphFlags.h"
 
 namespace nebula {
 namespace graph {
@@ -59,5 +61,35 @@ TEST(ExecutionContextTest, TestResult) {
   EXPECT_TRUE(result.valuePtr()->isDataSet());
 }
 
+TEST(ExecutionContextTest, AsyncGC) {
+  DataSet ds({"col"});
+  for (int i = 0; i < 100; i++) {
+    ds.rows.emplace_back(Row({std::string(100, 'a')}));
+  }
+  auto bytes = GC::estimateBytes(Value(ds));
+  EXPECT_GE(bytes, 100 * (sizeof(Value) + 100));
+  EXPECT_LT(bytes, 100 * (sizeof(Row) + 2 * sizeof(Value) + 200));
+
+  auto enableGC = FLAGS_enable_async_gc;
+  FLAGS_enable_async_gc = true;
+  {
+    ExecutionContext ctx;
+    ctx.setValue("ds", Value(ds));
+    ctx.setValue("ds", Value(ds));
+    ctx.setValue("other", Value(ds));
+    ctx.dropResult("ds");
+    EXPECT_TRUE(ctx.exist("ds"));
+    EXPECT_EQ(0, ctx.numVersions("ds"));
+    EXPECT_EQ(1, ctx.numVersions("other"));
+  }
+  // The results dropped and left by the query are released by the workers eventually
+  for (int i = 0; i < 100 && GC::instance().pendingBytes() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  EXPECT_EQ(0, GC::instance().pendingBytes());
+
+  FLAGS_enable_async_gc = enableGC;
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -73,6 +73,7 @@
 #include "graph/executor/query/ExpandExecutor.h"
 #include "graph/executor/query/FilterExecutor.h"
 #include "graph/executor/query/FulltextIndexScanExecutor.h"
+#include "graph/executor/query/GeoKnnIndexScanExecutor.h"
 #include "graph/executor/query/GetEdgesExecutor.h"
 #include "graph/executor/query/GetNeighborsExecutor.h"
 #include "graph/executor/query/GetVerticesExecutor.h"
@@ -234,6 +235,14 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
       }
       return pool->makeAndAdd<IndexScanExecutor>(node, qctx);
     }
+    case PlanNode::Kind::kGeoKnnIndexScan: {
+      stats::StatsManager::addValue(kNumIndexScanExecutors);
+      if (FLAGS_enable_space_level_metrics && spaceName != "") {
+        stats::StatsManager::addValue(
+            stats::StatsManager::counterWithLabels(kNumIndexScanExecutors, {{"space", spaceName}}));
+      }
+      return pool->makeAndAdd<GeoKnnIndexScanExecutor>(node, qctx);
+    }
     case PlanNode::Kind::kStart: {
       return pool->makeAndAdd<StartExecutor>(node, qctx);
     }
@@ -4,6 +4,7 @@
 
 #include "graph/executor/admin/SpaceExecutor.h"
 
+#include "common/plugin/fulltext/builtin/TextIndex.h"
 #include "common/stats/StatsManager.h"
 #include "graph/planner/plan/Admin.h"
 #include "graph/service/PermissionManager.h"
@@ -110,8 +111,12 @@ folly::Future<Status> DropSpaceExecutor::execute() {
     auto ftIndexesRet = qctx()->getMetaClient()->getFTIndexBySpaceFromCache(spaceIdRet.value());
     NG_RETURN_IF_ERROR(ftIndexesRet);
     auto map = std::move(ftIndexesRet).value();
-    auto get = [](const auto &ptr) { return ptr.first; };
-    std::transform(map.begin(), map.end(), std::back_inserter(ftIndexes), get);
+    for (const auto &index : map) {
+      // The builtin indexes are stored with the data in storage
+      if (index.second.get_analyzer() != plugin::kBuiltinAnalyzer) {
+        ftIndexes.emplace_back(index.first);
+      }
+    }
   } else {
     LOG(WARNING) << "Get space ID failed when prepare text index: " << dsNode->getSpaceName();
   }
@@ -172,8 +177,12 @@ folly::Future<Status> ClearSpaceExecutor::execute() {
     auto ftIndexesRet = qctx()->getMetaClient()->getFTIndexBySpaceFromCache(spaceIdRet.value());
     NG_RETURN_IF_ERROR(ftIndexesRet);
     auto map = std::move(ftIndexesRet).value();
-    auto get = [](const auto &ptr) { return ptr.first; };
-    std::transform(map.begin(), map.end(), std::back_inserter(ftIndexes), get);
+    for (const auto &index : map) {
+      // The builtin indexes are stored with the data in storage
+      if (index.second.get_analyzer() != plugin::kBuiltinAnalyzer) {
+        ftIndexes.emplace_back(index.first);
+      }
+    }
   } else {
     LOG(WARNING) << "Get space ID failed when prepare text index: " << csNode->getSpaceName();
   }
@@ -189,7 +189,7 @@ void AllPathsExecutor::expand(GetNeighborsIter* iter, bool reverse) {
       continue;
     }
     const auto& dst = edge.getEdge().dst;
-    if (adjList.find(dst) == adjList.end() && uniqueVids.emplace(dst).second) {
+    if (!adjList.contains(dst) && uniqueVids.emplace(dst).second) {
       nextStepVids.emplace_back(dst);
     }
     const auto& vertex = iter->getVertex();
@@ -274,12 +274,12 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
   if (step == 1) {
     auto& initVids = reverse ? rightInitVids_ : leftInitVids_;
     for (auto& vid : initVids) {
-      auto vidIter = adjList.find(vid);
-      if (vidIter == adjList.end()) {
+      auto* adj = adjList.find(vid);
+      if (adj == nullptr) {
         continue;
       }
-      auto& src = vidIter->first;
-      auto& adjEdges = vidIter->second;
+      auto& src = adj->vertex;
+      auto& adjEdges = adj->edges;
       if (adjEdges.empty()) {
         continue;
       }
@@ -294,11 +294,11 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
       auto& edgeValue = path->edge;
       DCHECK(edgeValue.isEdge());
       auto& dst = edgeValue.getEdge().dst;
-      auto adjIter = adjList.find(dst);
-      if (adjIter == adjList.end()) {
+      auto* adj = adjList.find(dst);
+      if (adj == nullptr) {
         continue;
       }
-      auto& adjEdges = adjIter->second;
+      auto& adjEdges = adj->edges;
       for (auto& edge : adjEdges) {
         if (noLoop_) {
           if (hasSameVertices(path, edge.getEdge())) {
@@ -309,7 +309,7 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
             continue;
           }
         }
-        threadLocalPtr_->emplace_back(NPath(path, adjIter->first, edge));
+        threadLocalPtr_->emplace_back(NPath(path, adj->vertex, edge));
         newPathsPtr->emplace_back(&threadLocalPtr_->back());
       }
     }
@@ -7,6 +7,7 @@
 
 #include "folly/ThreadLocal.h"
 #include "graph/executor/StorageAccessExecutor.h"
+#include "graph/util/VidDict.h"
 
 // Using the two-way BFS algorithm, a heuristic algorithm is used in the expansion process
 // when the number of vid to be expanded on the left and right
@@ -25,6 +26,7 @@
 // adjList is an adjacency list structure
 // which saves the vids and all adjacent edges that expand one step
 // when expanding, if the vid has already been visited, do not visit again
+// the adjList is keyed by the dense ids of the vids in a query local dictionary
 // leftAdjList_ save result of forward expansion
 // rightAdjList_ save result of backward expansion
 namespace nebula {
@@ -121,8 +123,8 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   VidHashSet leftInitVids_;
   VidHashSet rightInitVids_;
 
-  VertexMap<Value> leftAdjList_;
-  VertexMap<Value> rightAdjList_;
+  VidAdjList leftAdjList_;
+  VidAdjList rightAdjList_;
 
   DataSet result_;
   std::vector<Value> emptyPropVids_;
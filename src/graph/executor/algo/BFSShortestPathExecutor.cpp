@@ -16,15 +16,13 @@ folly::Future<Status> BFSShortestPathExecutor::execute() {
   terminateEarlyVar_ = pathNode_->terminateEarlyVar();
 
   if (step_ == 1) {
-    allRightEdges_.emplace_back();
-    auto& currentEdges = allRightEdges_.back();
+    right_.steps.emplace_back();
+    auto& currentEdges = right_.steps.back();
     auto rIter = ectx_->getResult(pathNode_->rightVidVar()).iter();
-    HashSet rightVids;
     for (; rIter->valid(); rIter->next()) {
-      auto& vid = rIter->getColumn(0);
-      if (rightVids.emplace(vid).second) {
-        Edge dummy;
-        currentEdges.emplace(vid, std::move(dummy));
+      auto id = right_.intern(rIter->getColumn(0));
+      if (currentEdges.find(id) == currentEdges.end()) {
+        currentEdges.emplace(id, ParentLink());
       }
     }
   }
@@ -71,80 +69,85 @@ Status BFSShortestPathExecutor::buildPath(bool reverse) {
   auto iter = reverse ? ectx_->getResult(pathNode_->rightInputVar()).iter()
                       : ectx_->getResult(pathNode_->leftInputVar()).iter();
   DCHECK(!!iter);
-  auto& visitedVids = reverse ? rightVisitedVids_ : leftVisitedVids_;
-  auto& allEdges = reverse ? allRightEdges_ : allLeftEdges_;
-  allEdges.emplace_back();
-  auto& currentEdges = allEdges.back();
+  auto& side = reverse ? right_ : left_;
+  side.steps.emplace_back();
+  auto& currentEdges = side.steps.back();
 
   auto iterSize = iter->size();
-  visitedVids.reserve(visitedVids.size() + iterSize);
+  side.dict.reserve(side.dict.size() + iterSize);
+  side.marks.reserve(side.dict.size() + iterSize);
 
-  HashSet uniqueDst;
-  uniqueDst.reserve(iterSize);
+  // The vertices reached in this step are marked as (step + 1)
+  const auto currentMark = static_cast<uint32_t>(step_ + 1);
+  size_t numDst = 0;
   DataSet nextStepVids;
   nextStepVids.colNames = {nebula::kVid};
-  if (step_ == 1) {
-    for (; iter->valid(); iter->next()) {
-      auto edgeVal = iter->getEdge();
-      if (UNLIKELY(!edgeVal.isEdge())) {
-        continue;
-      }
-      auto& edge = edgeVal.getEdge();
-      auto dst = edge.dst;
-      visitedVids.emplace(edge.src);
-      if (uniqueDst.emplace(dst).second) {
-        nextStepVids.rows.emplace_back(Row({dst}));
-      }
-      currentEdges.emplace(std::move(dst), std::move(edge));
+  for (; iter->valid(); iter->next()) {
+    auto edgeVal = iter->getEdge();
+    if (UNLIKELY(!edgeVal.isEdge())) {
+      continue;
     }
-  } else {
-    for (; iter->valid(); iter->next()) {
-      auto edgeVal = iter->getEdge();
-      if (UNLIKELY(!edgeVal.isEdge())) {
-        continue;
+    auto& edge = edgeVal.getEdge();
+    auto srcId = side.intern(edge.src);
+    auto dstId = side.intern(edge.dst);
+    auto& dstMark = side.marks[dstId];
+    if (step_ == 1) {
+      if (side.marks[srcId] == 0) {
+        side.marks[srcId] = 1;
       }
-      auto& edge = edgeVal.getEdge();
-      auto dst = edge.dst;
-      if (visitedVids.find(dst) != visitedVids.end()) {
-        continue;
-      }
-      if (uniqueDst.emplace(dst).second) {
-        nextStepVids.rows.emplace_back(Row({dst}));
-      }
-      currentEdges.emplace(std::move(dst), std::move(edge));
+    } else if (dstMark != 0 && dstMark != currentMark) {
+      // Visited in the previous steps
+      continue;
+    }
+    if (dstMark != currentMark) {
+      dstMark = currentMark;
+      nextStepVids.rows.emplace_back(Row({edge.dst}));
+      ++numDst;
     }
+    if (side.edgeNames.find(edge.type) == side.edgeNames.end()) {
+      side.edgeNames.emplace(edge.type, edge.name);
+    }
+    currentEdges.emplace(dstId, ParentLink{srcId, edge.type, edge.ranking});
   }
 
   // set nextVid
   const auto& nextVidVar = reverse ? pathNode_->rightVidVar() : pathNode_->leftVidVar();
   ectx_->setResult(nextVidVar, ResultBuilder().value(std::move(nextStepVids)).build());
-  if (uniqueDst.size() == 0) {
+  if (numDst == 0) {
     ectx_->setValue(terminateEarlyVar_, true);
-    return Status::OK();
   }
-  visitedVids.insert(std::make_move_iterator(uniqueDst.begin()),
-                     std::make_move_iterator(uniqueDst.end()));
   return Status::OK();
 }
 
-folly::Future<Status> BFSShortestPathExecutor::conjunctPath() {
-  const auto& leftEdges = allLeftEdges_.back();
-  const auto& preRightEdges = allRightEdges_[step_ - 1];
-  HashSet meetVids;
-  bool oddStep = true;
+std::vector<BFSShortestPathExecutor::MeetVid> BFSShortestPathExecutor::findMeetVids(
+    const StepEdges& leftEdges, const StepEdges& rightEdges) const {
+  std::vector<MeetVid> meetVids;
+  if (rightEdges.empty()) {
+    return meetVids;
+  }
+  // Equivalent keys are adjacent in the multimap, so each vid is checked only once
+  const VidDict::Id* prev = nullptr;
   for (const auto& edge : leftEdges) {
-    if (preRightEdges.find(edge.first) != preRightEdges.end()) {
-      meetVids.emplace(edge.first);
+    if (prev != nullptr && *prev == edge.first) {
+      continue;
+    }
+    prev = &edge.first;
+    auto rightId = right_.dict.find(left_.dict.vid(edge.first));
+    if (rightId != VidDict::kInvalidId && rightEdges.find(rightId) != rightEdges.end()) {
+      meetVids.emplace_back(edge.first, rightId);
     }
   }
+  return meetVids;
+}
+
+folly::Future<Status> BFSShortestPathExecutor::conjunctPath() {
+  const auto& leftEdges = left_.steps.back();
+  const auto& preRightEdges = right_.steps[step_ - 1];
+  bool oddStep = true;
+  auto meetVids = findMeetVids(leftEdges, preRightEdges);
   if (meetVids.empty() && step_ * 2 <= pathNode_->steps()) {
-    const auto& rightEdges = allRightEdges_.back();
-    for (const auto& edge : leftEdges) {
-      if (rightEdges.find(edge.first) != rightEdges.end()) {
-        meetVids.emplace(edge.first);
-        oddStep = false;
-      }
-    }
+    meetVids = findMeetVids(leftEdges, right_.steps.back());
+    oddStep = false;
   }
   if (meetVids.empty()) {
     return Status::OK();
@@ -152,7 +155,7 @@ folly::Future<Status> BFSShortestPathExecutor::conjunctPath() {
   size_t i = 0;
   size_t totalSize = meetVids.size();
   size_t batchSize = totalSize / static_cast<size_t>(FLAGS_num_operator_threads);
-  std::vector<Value> batchVids;
+  std::vector<MeetVid> batchVids;
   batchVids.reserve(batchSize);
   std::vector<folly::Future<DataSet>> futures;
   for (auto& vid : meetVids) {
@@ -175,63 +178,78 @@ folly::Future<Status> BFSShortestPathExecutor::conjunctPath() {
   });
 }
 
-DataSet BFSShortestPathExecutor::doConjunct(const std::vector<Value>& meetVids,
+DataSet BFSShortestPathExecutor::doConjunct(const std::vector<MeetVid>& meetVids,
                                             bool oddStep) const {
   DataSet ds;
-  auto leftPaths = createPath(meetVids, false, oddStep);
-  auto rightPaths = createPath(meetVids, true, oddStep);
-  for (auto& leftPath : leftPaths) {
-    auto range = rightPaths.equal_range(leftPath.first);
-    for (auto& rightPath = range.first; rightPath != range.second; ++rightPath) {
-      Path result = leftPath.second;
-      result.reverse();
-      result.append(rightPath->second);
-      Row row;
-      row.emplace_back(std::move(result));
-      ds.rows.emplace_back(std::move(row));
+  for (const auto& meetVid : meetVids) {
+    auto leftPaths = createPath(meetVid.first, false, oddStep);
+    auto rightPaths = createPath(meetVid.second, true, oddStep);
+    for (auto& leftPath : leftPaths) {
+      for (auto& rightPath : rightPaths) {
+        Path result = leftPath;
+        result.reverse();
+        result.append(rightPath);
+        Row row;
+        row.emplace_back(std::move(result));
+        ds.rows.emplace_back(std::move(row));
+      }
     }
   }
   return ds;
 }
 
-std::unordered_multimap<Value, Path> BFSShortestPathExecutor::createPath(
-    std::vector<Value> meetVids, bool reverse, bool oddStep) const {
-  std::unordered_multimap<Value, Path> result;
-  auto& allEdges = reverse ? allRightEdges_ : allLeftEdges_;
-  for (auto& meetVid : meetVids) {
-    Path start;
-    start.src = Vertex(meetVid, {});
-    std::vector<Path> interimPaths = {std::move(start)};
-    auto iter = (reverse && oddStep) ? allEdges.rbegin() + 1 : allEdges.rbegin();
-    auto end = reverse ? allEdges.rend() - 1 : allEdges.rend();
-    if (iter == end) {
-      result.emplace(meetVid, std::move(start));
-      return result;
+std::vector<Path> BFSShortestPathExecutor::createPath(VidDict::Id meetVid,
+                                                      bool reverse,
+                                                      bool oddStep) const {
+  // The interim paths are kept as a tree of parent links on ids, and the vids are restored
+  // only for the complete paths.
+  struct PathNode {
+    VidDict::Id vid;
+    EdgeType type;
+    EdgeRanking ranking;
+    size_t parent;
+  };
+  constexpr size_t kNoParent = std::numeric_limits<size_t>::max();
+
+  const auto& side = reverse ? right_ : left_;
+  const auto& allEdges = side.steps;
+  std::vector<PathNode> nodes{{meetVid, 0, 0, kNoParent}};
+  std::vector<size_t> interimPaths{0};
+  auto iter = (reverse && oddStep) ? allEdges.rbegin() + 1 : allEdges.rbegin();
+  auto end = reverse ? allEdges.rend() - 1 : allEdges.rend();
+  for (; iter != end && !interimPaths.empty(); ++iter) {
+    std::vector<size_t> temp;
+    for (auto interimPath : interimPaths) {
+      auto range = iter->equal_range(nodes[interimPath].vid);
+      for (auto edgeIter = range.first; edgeIter != range.second; ++edgeIter) {
+        const auto& link = edgeIter->second;
+        nodes.emplace_back(PathNode{link.src, link.type, link.ranking, interimPath});
+        temp.emplace_back(nodes.size() - 1);
+      }
+    }
+    interimPaths = std::move(temp);
+  }
+
+  std::vector<Path> result;
+  result.reserve(interimPaths.size());
+  std::vector<size_t> chain;
+  for (auto leaf : interimPaths) {
+    chain.clear();
+    for (auto cur = leaf; nodes[cur].parent != kNoParent; cur = nodes[cur].parent) {
+      chain.emplace_back(cur);
     }
-    for (; iter != end; ++iter) {
-      std::vector<Path> temp;
-      for (auto& interimPath : interimPaths) {
-        Value id;
-        if (interimPath.steps.empty()) {
-          id = interimPath.src.vid;
-        } else {
-          id = interimPath.steps.back().dst.vid;
-        }
-        auto range = iter->equal_range(id);
-        for (auto edgeIter = range.first; edgeIter != range.second; ++edgeIter) {
-          Path p = interimPath;
-          auto& edge = edgeIter->second;
-          p.steps.emplace_back(Step(Vertex(edge.src, {}), -edge.type, edge.name, edge.ranking, {}));
-
-          if (iter == end - 1) {
-            result.emplace(p.src.vid, std::move(p));
-          } else {
-            temp.emplace_back(std::move(p));
-          }
-        }  //  edgeIter
-      }    // interimPath
-      interimPaths = std::move(temp);
+    Path path;
+    path.src = Vertex(side.dict.vid(meetVid), {});
+    path.steps.reserve(chain.size());
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+      const auto& node = nodes[*it];
+      path.steps.emplace_back(Step(Vertex(side.dict.vid(node.vid), {}),
+                                   -node.type,
+                                   side.edgeNames.at(node.type),
+                                   node.ranking,
+                                   {}));
     }
+    result.emplace_back(std::move(path));
   }
   return result;
 }
@@ -4,9 +4,8 @@
 
 #ifndef GRAPH_EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
 #define GRAPH_EXECUTOR_ALGO_BFSSHORTESTPATHEXECUTOR_H_
-#include <robin_hood.h>
-
 #include "graph/executor/Executor.h"
+#include "graph/util/VidDict.h"
 
 // BFSShortestPath has two inputs.  GetNeighbors(From) & GetNeighbors(To)
 // There are two Main functions
@@ -16,58 +15,85 @@
 //
 //
 // Functions:
-// `buildPath`: extract edges from GetNeighbors put it into allLeftEdges or allRightEdges
+// `buildPath`: extract edges from GetNeighbors put it into the steps of left or right side
 //   and set the vid that needs to be expanded in the next step
 //
 // `conjunctPath`: concatenate the path(From) and the path(To) into a complete path
-//   allLeftEdges needs to match the previous step of the allRightEdges
-//   then current step of the allRightEdges each time
+//   the last step of left side needs to match the previous step of the right side
+//   then current step of the right side each time
 //   Eg. a->b->c->d
-//   firstStep:  allLeftEdges [<b, a->b>]  allRightEdges [<c, d<-c>],   can't find common vid
-//   secondStep: allLeftEdges [<b, a->b>, <c, b->c>] allRightEdges [<b, c<-b>, <c, d<-c>]
-//   we should use allLeftEdges(secondStep) to match allRightEdges(firstStep) first
-//   if find common vid, no need to match allRightEdges(secondStep)
+//   firstStep:  left steps [<b, a->b>]  right steps [<c, d<-c>],   can't find common vid
+//   secondStep: left steps [<b, a->b>, <c, b->c>] right steps [<b, c<-b>, <c, d<-c>]
+//   we should use left steps(secondStep) to match right steps(firstStep) first
+//   if find common vid, no need to match right steps(secondStep)
 //
 // Member:
-// `allLeftEdges_` : is a array, each element in the array is a hashTable
-//  hash table
-//    KEY   : the VID of the vertex
-//    VALUE : edges visited at the current step (the destination is KEY)
-//
-// `allRightEdges_` : same as allLeftEdges_
+// `left_` : the expansion state from the source vertices
+//   `dict`  : maps the vids of this side to dense integer ids, all the other members work on ids
+//             and the vids are only restored when building the result paths
+//   `marks` : indexed by id, 0 means not visited yet, otherwise it's (step + 1) when the vertex
+//             is reached, the start vertices are marked as 1
+//   `steps` : is a array, each element in the array is a hashTable
+//    hash table
+//      KEY   : the id of the vertex
+//      VALUE : parent links of edges visited at the current step (the destination is KEY)
+//   `edgeNames` : edge type to edge name, used to restore the edges in the result paths
 //
-// `leftVisitedVids_` : keep already visited vid to avoid repeated visits (left)
-// `rightVisitedVids_` : keep already visited vid to avoid repeated visits (right)
+// `right_` : same as left_
 // `currentDs_`: keep the paths matched in current step
 namespace nebula {
 namespace graph {
 class BFSShortestPath;
 class BFSShortestPathExecutor final : public Executor {
  public:
-  using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
   BFSShortestPathExecutor(const PlanNode* node, QueryContext* qctx)
       : Executor("BFSShortestPath", node, qctx) {}
 
   folly::Future<Status> execute() override;
 
  private:
+  struct ParentLink {
+    VidDict::Id src{VidDict::kInvalidId};
+    EdgeType type{0};
+    EdgeRanking ranking{0};
+  };
+
+  using StepEdges = std::unordered_multimap<VidDict::Id, ParentLink>;
+
+  struct Side {
+    VidDict dict;
+    std::vector<uint32_t> marks;
+    std::vector<StepEdges> steps;
+    std::unordered_map<EdgeType, std::string> edgeNames;
+
+    VidDict::Id intern(const Value& vid) {
+      auto id = dict.intern(vid);
+      if (id >= marks.size()) {
+        marks.resize(id + 1, 0);
+      }
+      return id;
+    }
+  };
+
+  // The meeting vertex id in the left and right dictionary
+  using MeetVid = std::pair<VidDict::Id, VidDict::Id>;
+
   Status buildPath(bool reverse);
 
   folly::Future<Status> conjunctPath();
 
-  DataSet doConjunct(const std::vector<Value>& meetVids, bool oddStep) const;
+  std::vector<MeetVid> findMeetVids(const StepEdges& leftEdges,
+                                    const StepEdges& rightEdges) const;
+
+  DataSet doConjunct(const std::vector<MeetVid>& meetVids, bool oddStep) const;
 
-  std::unordered_multimap<Value, Path> createPath(std::vector<Value> meetVids,
-                                                  bool reverse,
-                                                  bool oddStep) const;
+  std::vector<Path> createPath(VidDict::Id meetVid, bool reverse, bool oddStep) const;
 
  private:
   const BFSShortestPath* pathNode_{nullptr};
   size_t step_{1};
-  HashSet leftVisitedVids_;
-  HashSet rightVisitedVids_;
-  std::vector<std::unordered_multimap<Value, Edge>> allLeftEdges_;
-  std::vector<std::unordered_multimap<Value, Edge>> allRightEdges_;
+  Side left_;
+  Side right_;
   DataSet currentDs_;
   std::string terminateEarlyVar_;
 };
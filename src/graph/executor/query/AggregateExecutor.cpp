@@ -4,6 +4,7 @@
 
 #include "graph/executor/query/AggregateExecutor.h"
 
+#include "common/datatypes/HashTable.h"
 #include "graph/planner/plan/Query.h"
 
 namespace nebula {
@@ -30,7 +31,7 @@ folly::Future<Status> AggregateExecutor::execute() {
     }
   }
 
-  std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
+  HashMap<List, std::vector<std::unique_ptr<AggData>>> result;
 
   // generate default result when input dataset is empty
   if (UNLIKELY(!iter->valid())) {
@@ -53,7 +54,7 @@ folly::Future<Status> AggregateExecutor::execute() {
         cols.emplace_back(new AggData());
         cols[i]->setResult(defaultValues[i]);
       }
-      result.emplace(std::make_pair(dummyKey, std::move(cols)));
+      result[std::move(dummyKey)] = std::move(cols);
     }
   }
 
@@ -63,24 +64,24 @@ folly::Future<Status> AggregateExecutor::execute() {
       list.values.emplace_back(key->eval(ctx(iter.get())));
     }
 
-    auto it = result.find(list);
-    if (it == result.end()) {
-      std::vector<std::unique_ptr<AggData>> cols;
+    // Look up the group only once per row
+    auto& cols = result[std::move(list)];
+    if (cols.empty()) {
+      cols.reserve(groupItems.size());
       for (size_t i = 0; i < groupItems.size(); ++i) {
         cols.emplace_back(new AggData());
       }
-      result.emplace(std::make_pair(list, std::move(cols)));
     } else {
-      DCHECK_EQ(it->second.size(), groupItems.size());
+      DCHECK_EQ(cols.size(), groupItems.size());
     }
 
     for (size_t i = 0; i < groupItems.size(); ++i) {
       auto* item = groupItems[i];
       if (item->kind() == Expression::Kind::kAggregate) {
-        static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
+        static_cast<AggregateExpression*>(item)->setAggData(cols[i].get());
         item->eval(ctx(iter.get()));
       } else {
-        result[list][i]->setResult(item->eval(ctx(iter.get())));
+        cols[i]->setResult(item->eval(ctx(iter.get())));
       }
     }
   }
@@ -4,8 +4,7 @@
 
 #include "graph/executor/query/DedupExecutor.h"
 
-#include <robin_hood.h>
-
+#include "common/datatypes/HashTable.h"
 #include "graph/planner/plan/Query.h"
 namespace nebula {
 namespace graph {
@@ -25,10 +24,10 @@ folly::Future<Status> DedupExecutor::execute() {
   if (UNLIKELY(iter->isGetNeighborsIter() || iter->isDefaultIter())) {
     return Status::Error("Invalid iterator kind, %d", static_cast<uint16_t>(iter->kind()));
   }
-  robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> unique;
+  HashSet<const Row*> unique;
   unique.reserve(iter->size());
   while (iter->valid()) {
-    if (!unique.emplace(iter->row()).second) {
+    if (!unique.insert(iter->row())) {
       iter->unstableErase();
     } else {
       iter->next();
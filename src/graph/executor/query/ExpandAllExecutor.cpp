@@ -154,7 +154,7 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
                      nullptr,
                      false,
                      false,
-                     std::vector<storage::cpp2::OrderBy>(),
+                     expand_->orderBy(),
                      expand_->limit(qec),
                      expand_->filter(),
                      nullptr)
@@ -6,6 +6,7 @@
 
 #include "common/datatypes/DataSet.h"
 #include "common/datatypes/Edge.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/util/Constants.h"
 #include "graph/util/FTIndexUtils.h"
@@ -13,10 +14,15 @@
 using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetPropResponse;
+using nebula::storage::cpp2::TextSearchResponse;
 
 namespace nebula::graph {
 
 folly::Future<Status> FulltextIndexScanExecutor::execute() {
+  auto* tsExpr = asNode<FulltextIndexScan>(node())->searchExpression();
+  if (tsExpr->kind() == Expression::Kind::kESQUERY && isBuiltinIndex(tsExpr->arg()->index())) {
+    return textSearch();
+  }
   auto esAdapterResult = FTIndexUtils::getESAdapter(qctx_->getMetaClient());
   if (!esAdapterResult.ok()) {
     return esAdapterResult.status();
@@ -74,6 +80,98 @@ folly::Future<Status> FulltextIndexScanExecutor::execute() {
   return Status::OK();
 }
 
+bool FulltextIndexScanExecutor::isBuiltinIndex(const std::string& index) const {
+  const auto& space = qctx()->rctx()->session()->space();
+  auto ret = qctx()->getMetaClient()->getFTIndexBySpaceFromCache(space.id);
+  if (!ret.ok()) {
+    return false;
+  }
+  auto iter = ret.value().find(index);
+  return iter != ret.value().end() && iter->second.get_analyzer() == plugin::kBuiltinAnalyzer;
+}
+
+folly::Future<Status> FulltextIndexScanExecutor::textSearch() {
+  auto* ftIndexScan = asNode<FulltextIndexScan>(node());
+  auto* arg = ftIndexScan->searchExpression()->arg();
+  int64_t offset = ftIndexScan->getValidOffset();
+  auto limit = ftIndexScan->limit();
+  if (limit < 0 || limit > std::numeric_limits<int32_t>::max()) {
+    limit = std::numeric_limits<int32_t>::max();
+  }
+  if (limit <= offset) {
+    return finish(ResultBuilder()
+                      .value(Value(DataSet({"id", kScore})))
+                      .iter(Iterator::Kind::kProp)
+                      .build());
+  }
+
+  const auto& space = qctx()->rctx()->session()->space();
+  StorageClient::CommonRequestParam param(space.id,
+                                          qctx()->rctx()->session()->id(),
+                                          qctx()->plan()->id(),
+                                          qctx()->plan()->isProfileEnabled());
+  return qctx()
+      ->getStorageClient()
+      ->textSearch(param,
+                   ftIndexScan->isEdge(),
+                   ftIndexScan->schemaId(),
+                   arg->index(),
+                   arg->query(),
+                   limit)
+      .via(runner())
+      .thenValue([this, offset, limit](StorageRpcResponse<TextSearchResponse>&& rpcResp) {
+        memory::MemoryCheckGuard guard;
+        addStats(rpcResp);
+        // The partial result of an index not rebuilt on all parts is never accepted
+        for (const auto& [partId, code] : rpcResp.failedParts()) {
+          if (code == nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND) {
+            auto* scan = asNode<FulltextIndexScan>(node());
+            return Status::Error("Fulltext index `%s' is not built on part %d yet, "
+                                 "run REBUILD FULLTEXT INDEX first",
+                                 scan->searchExpression()->arg()->index().c_str(),
+                                 partId);
+          }
+        }
+        auto completeness = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
+        if (!completeness.ok()) {
+          return std::move(completeness).status();
+        }
+        // Each part returns its own top documents, which are merged by the score
+        std::vector<Row> rows;
+        for (auto& resp : rpcResp.responses()) {
+          if (resp.data_ref().has_value()) {
+            auto& data = *resp.data_ref();
+            std::move(data.rows.begin(), data.rows.end(), std::back_inserter(rows));
+          }
+        }
+        std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+          return a.values.back().getFloat() > b.values.back().getFloat();
+        });
+
+        auto* ftIndexScan = asNode<FulltextIndexScan>(node());
+        DataSet result({"id", kScore});
+        auto end = std::min(static_cast<size_t>(limit), rows.size());
+        for (auto i = static_cast<size_t>(offset); i < end; i++) {
+          auto& values = rows[i].values;
+          if (ftIndexScan->isEdge()) {
+            Edge edge;
+            edge.src = std::move(values[0]);
+            edge.ranking = values[1].getInt();
+            edge.dst = std::move(values[2]);
+            edge.type = ftIndexScan->schemaId();
+            result.emplace_back(Row({std::move(edge), values[3]}));
+          } else {
+            result.emplace_back(Row({std::move(values[0]), values[1]}));
+          }
+        }
+        return finish(ResultBuilder()
+                          .value(Value(std::move(result)))
+                          .iter(Iterator::Kind::kProp)
+                          .state(completeness.value())
+                          .build());
+      });
+}
+
 StatusOr<plugin::ESQueryResult> FulltextIndexScanExecutor::accessFulltextIndex(
     TextSearchExpression* tsExpr) {
   std::function<StatusOr<nebula::plugin::ESQueryResult>()> execFunc;
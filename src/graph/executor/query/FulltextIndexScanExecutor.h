@@ -11,16 +11,22 @@
 
 namespace nebula::graph {
 class FulltextIndexScan;
-class FulltextIndexScanExecutor final : public Executor {
+class FulltextIndexScanExecutor final : public StorageAccessExecutor {
  public:
   FulltextIndexScanExecutor(const PlanNode* node, QueryContext* qctx)
-      : Executor("FulltextIndexScanExecutor", node, qctx) {}
+      : StorageAccessExecutor("FulltextIndexScanExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
 
  private:
   StatusOr<plugin::ESQueryResult> accessFulltextIndex(TextSearchExpression* expr);
 
+  // Whether the index is the builtin one maintained by storage
+  bool isBuiltinIndex(const std::string& index) const;
+
+  // Search the builtin index in storage instead of elasticsearch
+  folly::Future<Status> textSearch();
+
   bool isIntVidType(const SpaceInfo& space) const {
     return (*space.spaceDesc.vid_type_ref()).type == nebula::cpp2::PropertyType::INT64;
   }
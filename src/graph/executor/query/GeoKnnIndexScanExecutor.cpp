@@ -0,0 +1,197 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/query/GeoKnnIndexScanExecutor.h"
+
+#include <s2/s2earth.h>
+
+#include "common/geo/GeoFunction.h"
+#include "graph/service/GraphFlags.h"
+
+using nebula::storage::StorageClient;
+using nebula::storage::StorageRpcResponse;
+using nebula::storage::cpp2::IndexQueryContext;
+using nebula::storage::cpp2::LookupIndexResp;
+
+namespace nebula {
+namespace graph {
+
+namespace {
+// The radius of ring grows by the factor after each scan
+constexpr double kRingGrowth = 4.0;
+// The cap with the radius covers the whole earth
+const double kMaxRadius = M_PI * S2Earth::RadiusMeters();
+}  // namespace
+
+folly::Future<Status> GeoKnnIndexScanExecutor::execute() {
+  const auto &ictxs = gn_->queryContext();
+  if (ictxs.size() != 1 || !ictxs.front().index_id_ref().is_set()) {
+    return Status::Error("There is no geo index to use at runtime");
+  }
+  auto *metaClient = qctx()->getMetaClient();
+  auto indexId = ictxs.front().get_index_id();
+  auto index = gn_->isEdge() ? metaClient->getEdgeIndexFromCache(gn_->space(), indexId)
+                             : metaClient->getTagIndexFromCache(gn_->space(), indexId);
+  NG_RETURN_IF_ERROR(index);
+  auto indexItem = std::move(index).value();
+  const auto &fields = indexItem->get_fields();
+  if (fields.size() != 1 || fields.back().get_name() != gn_->geoColumn()) {
+    return Status::Error("The index `%s' is not a geo index on `%s'",
+                         indexItem->get_index_name().c_str(),
+                         gn_->geoColumn().c_str());
+  }
+  const auto &geoColumnTypeDef = fields.back().get_type();
+  bool isPointColumn = geoColumnTypeDef.geo_shape_ref().has_value() &&
+                       geoColumnTypeDef.geo_shape_ref().value() == meta::cpp2::GeoShape::POINT;
+  geo::RegionCoverParams rc;
+  const auto *indexParams = indexItem->get_index_params();
+  if (indexParams) {
+    if (indexParams->s2_max_level_ref().has_value()) {
+      rc.maxCellLevel_ = indexParams->s2_max_level_ref().value();
+    }
+    if (indexParams->s2_max_cells_ref().has_value()) {
+      rc.maxCellNum_ = indexParams->s2_max_cells_ref().value();
+    }
+  }
+  geoIndex_ = std::make_unique<geo::GeoIndex>(rc, isPointColumn);
+
+  const auto &returnCols = gn_->returnColumns();
+  auto found = std::find(returnCols.begin(), returnCols.end(), gn_->geoColumn());
+  if (found == returnCols.end()) {
+    return Status::Error("The geo column `%s' is not returned", gn_->geoColumn().c_str());
+  }
+  geoColIdx_ = std::distance(returnCols.begin(), found);
+
+  auto limit = gn_->limit(qctx_);
+  if (limit <= 0) {
+    return finish(ResultBuilder().value(Value(DataSet(gn_->colNames()))).build());
+  }
+  k_ = limit;
+  heap_.reserve(k_);
+  maxRadius_ = std::min(FLAGS_geo_knn_max_radius, kMaxRadius);
+  outerRadius_ = std::min(FLAGS_geo_knn_initial_radius, maxRadius_);
+  return scanRing();
+}
+
+folly::Future<Status> GeoKnnIndexScanExecutor::scanRing() {
+  auto ranges = geoIndex_->dWithinRing(gn_->point(), innerRadius_, outerRadius_);
+  if (ranges.empty()) {
+    // The covering of the outer cap is the same as the inner one
+    return nextRing();
+  }
+  std::vector<IndexQueryContext> ictxs;
+  ictxs.reserve(ranges.size());
+  const auto &proto = gn_->queryContext().front();
+  for (const auto &range : ranges) {
+    IndexQueryContext ictx = proto;
+    auto hint = range.toIndexColumnHint();
+    hint.column_name_ref() = gn_->geoColumn();
+    ictx.column_hints_ref() = {std::move(hint)};
+    ictxs.emplace_back(std::move(ictx));
+  }
+  return scan(std::move(ictxs));
+}
+
+folly::Future<Status> GeoKnnIndexScanExecutor::scanAll() {
+  scannedAll_ = true;
+  return scan({gn_->queryContext().front()});
+}
+
+folly::Future<Status> GeoKnnIndexScanExecutor::scan(std::vector<IndexQueryContext> ictxs) {
+  StorageClient *storageClient = qctx_->getStorageClient();
+  StorageClient::CommonRequestParam param(gn_->space(),
+                                          qctx()->rctx()->session()->id(),
+                                          qctx()->plan()->id(),
+                                          qctx()->plan()->isProfileEnabled());
+  return storageClient
+      ->lookupIndex(param,
+                    ictxs,
+                    gn_->isEdge(),
+                    gn_->schemaId(),
+                    gn_->returnColumns(),
+                    {},
+                    std::numeric_limits<int64_t>::max())
+      .via(runner())
+      .thenValue([this](StorageRpcResponse<LookupIndexResp> &&rpcResp) -> folly::Future<Status> {
+        // MemoryTrackerVerified
+        memory::MemoryCheckGuard guard;
+        addStats(rpcResp);
+        NG_RETURN_IF_ERROR(handleResp(std::move(rpcResp)));
+        return nextRing();
+      });
+}
+
+folly::Future<Status> GeoKnnIndexScanExecutor::nextRing() {
+  // All the geographies within the outer radius have been scanned
+  bool done = heap_.size() == k_ && heap_.front().first <= outerRadius_;
+  if (!done && !scannedAll_ && outerRadius_ < kMaxRadius) {
+    if (outerRadius_ >= maxRadius_) {
+      return scanAll();
+    }
+    innerRadius_ = outerRadius_;
+    outerRadius_ = std::min(outerRadius_ * kRingGrowth, maxRadius_);
+    return scanRing();
+  }
+
+  std::sort(heap_.begin(), heap_.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+  DataSet ds(node()->colNames().empty() ? std::move(colNames_) : node()->colNames());
+  ds.rows.reserve(heap_.size());
+  for (auto &candidate : heap_) {
+    ds.rows.emplace_back(std::move(candidate.second));
+  }
+  heap_.clear();
+  seen_.clear();
+  return finish(
+      ResultBuilder().value(std::move(ds)).iter(Iterator::Kind::kProp).state(state_).build());
+}
+
+Status GeoKnnIndexScanExecutor::handleResp(StorageRpcResponse<LookupIndexResp> &&rpcResp) {
+  auto completeness = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
+  if (!completeness.ok()) {
+    return std::move(completeness).status();
+  }
+  if (completeness.value() != Result::State::kSuccess) {
+    state_ = completeness.value();
+  }
+  for (auto &resp : rpcResp.responses()) {
+    if (!resp.data_ref().has_value()) {
+      state_ = Result::State::kPartialSuccess;
+      continue;
+    }
+    auto &data = *resp.data_ref();
+    if (colNames_.empty()) {
+      colNames_ = data.colNames;
+    }
+    for (auto &row : data.rows) {
+      const auto &geog = row.values[geoColIdx_];
+      if (!geog.isGeography()) {
+        continue;
+      }
+      auto distance = geo::GeoFunction::distance(gn_->point(), geog.getGeography());
+      if (heap_.size() == k_ && distance >= heap_.front().first) {
+        continue;
+      }
+      if (!seen_.emplace(row).second) {
+        continue;
+      }
+      addCandidate(distance, std::move(row));
+    }
+  }
+  return Status::OK();
+}
+
+void GeoKnnIndexScanExecutor::addCandidate(double distance, Row &&row) {
+  auto cmp = [](const auto &a, const auto &b) { return a.first < b.first; };
+  if (heap_.size() == k_) {
+    std::pop_heap(heap_.begin(), heap_.end(), cmp);
+    heap_.pop_back();
+  }
+  heap_.emplace_back(distance, std::move(row));
+  std::push_heap(heap_.begin(), heap_.end(), cmp);
+}
+
+}  // namespace graph
+}  // namespace nebula
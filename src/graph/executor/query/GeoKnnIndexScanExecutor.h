@@ -0,0 +1,63 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_QUERY_GEOKNNINDEXSCANEXECUTOR_H_
+#define GRAPH_EXECUTOR_QUERY_GEOKNNINDEXSCANEXECUTOR_H_
+
+#include "common/geo/GeoIndex.h"
+#include "graph/executor/StorageAccessExecutor.h"
+#include "graph/planner/plan/Query.h"
+
+// Find the k nearest geographies to a point by the geo index.
+// The rings of cells around the point are scanned outward, and the k nearest candidates are kept
+// by their exact distances. Once the distance of the scanned rings exceeds the k-th nearest one,
+// no geography in the outer rings could be nearer, so the scan stops. The radius of rings is
+// capped, beyond which the rest of index is scanned at once instead of by the growing coverings.
+namespace nebula {
+namespace graph {
+
+class GeoKnnIndexScanExecutor final : public StorageAccessExecutor {
+ public:
+  GeoKnnIndexScanExecutor(const PlanNode *node, QueryContext *qctx)
+      : StorageAccessExecutor("GeoKnnIndexScanExecutor", node, qctx) {
+    gn_ = asNode<GeoKnnIndexScan>(node);
+  }
+
+ private:
+  folly::Future<Status> execute() override;
+
+  folly::Future<Status> scanRing();
+
+  // Scan the whole index, the geographies scanned before are skipped
+  folly::Future<Status> scanAll();
+
+  folly::Future<Status> scan(std::vector<storage::cpp2::IndexQueryContext> ictxs);
+
+  folly::Future<Status> nextRing();
+
+  Status handleResp(storage::StorageRpcResponse<storage::cpp2::LookupIndexResp> &&rpcResp);
+
+  void addCandidate(double distance, Row &&row);
+
+ private:
+  const GeoKnnIndexScan *gn_;
+  std::unique_ptr<geo::GeoIndex> geoIndex_;
+  size_t geoColIdx_{0};
+  size_t k_{0};
+  double innerRadius_{0};
+  double outerRadius_{0};
+  double maxRadius_{0};
+  bool scannedAll_{false};
+  Result::State state_{Result::State::kSuccess};
+  std::vector<std::string> colNames_;
+  // Max heap of the k nearest candidates on distance
+  std::vector<std::pair<double, Row>> heap_;
+  // The geographies on the border of rings may be returned more than once
+  std::unordered_set<Row> seen_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_QUERY_GEOKNNINDEXSCANEXECUTOR_H_
@@ -39,7 +39,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
   }
 
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
+    RowHashTable<Value> hashTable;
     hashTable.reserve(bucketSize);
     if (lhsIter_->size() < rhsIter_->size()) {
       buildSingleKeyHashTable(hashKeys.front(), lhsIter_.get(), hashTable);
@@ -52,7 +52,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    RowHashTable<List> hashTable;
     hashTable.reserve(bucketSize);
     if (lhsIter_->size() < rhsIter_->size()) {
       buildHashTable(hashKeys, lhsIter_.get(), hashTable);
@@ -72,7 +72,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
 DataSet InnerJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+    const RowHashTable<List>& hashTable) const {
   DataSet ds;
   QueryExpressionContext ctx(ectx_);
   ds.rows.reserve(probeIter->size());
@@ -97,7 +97,7 @@ DataSet InnerJoinExecutor::probe(
 DataSet InnerJoinExecutor::singleKeyProbe(
     Expression* probeKey,
     Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
+    const RowHashTable<Value>& hashTable) const {
   DataSet ds;
   QueryExpressionContext ctx(ectx_);
   for (; probeIter->valid(); probeIter->next()) {
@@ -223,26 +223,27 @@ folly::Future<Status> InnerJoinExecutor::singleKeyProbe(Expression* probeKey, It
 }
 
 template <class T>
-void InnerJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
+void InnerJoinExecutor::buildNewRow(const RowHashTable<T>& hashTable,
                                     const T& val,
                                     Row rRow,
                                     DataSet& ds) const {
-  const auto& range = hashTable.find(val);
-  if (range == hashTable.end()) {
+  const auto* rows = hashTable.find(val);
+  if (rows == nullptr) {
     return;
   }
-  for (std::size_t i = 0, e = range->second.size() - 1; i < e; ++i) {
+  auto iter = rows->begin();
+  for (std::size_t i = 0, e = rows->size() - 1; i < e; ++i, ++iter) {
     if (exchange_) {
-      ds.rows.emplace_back(newRow(rRow, *range->second[i]));
+      ds.rows.emplace_back(newRow(rRow, **iter));
     } else {
-      ds.rows.emplace_back(newRow(*range->second[i], rRow));
+      ds.rows.emplace_back(newRow(**iter, rRow));
     }
   }
   // Move probe row in last new row creating
   if (exchange_) {
-    ds.rows.emplace_back(newRow(std::move(rRow), *range->second.back()));
+    ds.rows.emplace_back(newRow(std::move(rRow), *rows->back()));
   } else {
-    ds.rows.emplace_back(newRow(*range->second.back(), std::move(rRow)));
+    ds.rows.emplace_back(newRow(*rows->back(), std::move(rRow)));
   }
 }
 
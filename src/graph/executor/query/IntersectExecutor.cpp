@@ -4,6 +4,7 @@
 
 #include "graph/executor/query/IntersectExecutor.h"
 
+#include "common/datatypes/HashTable.h"
 #include "graph/planner/plan/Query.h"
 
 namespace nebula {
@@ -17,7 +18,8 @@ folly::Future<Status> IntersectExecutor::execute() {
   auto left = getLeftInputData();
   auto right = getRightInputData();
 
-  std::unordered_set<const Row*> hashSet;
+  HashSet<const Row*> hashSet;
+  hashSet.reserve(right.iterRef()->size());
   for (; right.iterRef()->valid(); right.iterRef()->next()) {
     hashSet.insert(right.iterRef()->row());
     // TODO: should test duplicate rows
@@ -34,8 +36,7 @@ folly::Future<Status> IntersectExecutor::execute() {
   }
 
   while (lIter->valid()) {
-    auto iter = hashSet.find(lIter->row());
-    if (iter == hashSet.end()) {
+    if (!hashSet.contains(lIter->row())) {
       lIter->unstableErase();
     } else {
       lIter->next();
@@ -75,7 +75,7 @@ Status JoinExecutor::checkBiInputDataSets() {
 
 void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
                                   Iterator* iter,
-                                  std::unordered_map<List, std::vector<const Row*>>& hashTable) {
+                                  RowHashTable<List>& hashTable) {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     List list;
@@ -85,21 +85,17 @@ void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
       list.values.emplace_back(std::move(val));
     }
 
-    auto& vals = hashTable[list];
-    vals.emplace_back(iter->row());
+    hashTable.add(std::move(list), iter->row());
   }
 }
 
-void JoinExecutor::buildSingleKeyHashTable(
-    Expression* hashKey,
-    Iterator* iter,
-    std::unordered_map<Value, std::vector<const Row*>>& hashTable) {
+void JoinExecutor::buildSingleKeyHashTable(Expression* hashKey,
+                                           Iterator* iter,
+                                           RowHashTable<Value>& hashTable) {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     auto& val = hashKey->eval(ctx(iter));
-
-    auto& vals = hashTable[val];
-    vals.emplace_back(iter->row());
+    hashTable.add(val, iter->row());
   }
 }
 
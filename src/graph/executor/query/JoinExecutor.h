@@ -5,6 +5,7 @@
 #ifndef GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 #define GRAPH_EXECUTOR_QUERY_JOINEXECUTOR_H_
 
+#include "common/datatypes/HashTable.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -22,11 +23,11 @@ class JoinExecutor : public Executor {
 
   void buildHashTable(const std::vector<Expression*>& hashKeys,
                       Iterator* iter,
-                      std::unordered_map<List, std::vector<const Row*>>& hashTable);
+                      RowHashTable<List>& hashTable);
 
   void buildSingleKeyHashTable(Expression* hashKey,
                                Iterator* iter,
-                               std::unordered_map<Value, std::vector<const Row*>>& hashTable);
+                               RowHashTable<Value>& hashTable);
 
   // concat rows
   Row newRow(Row left, Row right) const;
@@ -40,8 +41,8 @@ class JoinExecutor : public Executor {
   // If the join is natural join, rhsOutputColIdxs_ will be used to record the output column index
   // of the right. If not, rhsOutputColIdxs_ will be empty.
   std::optional<std::vector<size_t>> rhsOutputColIdxs_;
-  std::unordered_map<Value, std::vector<const Row*>> hashTable_;
-  std::unordered_map<List, std::vector<const Row*>> listHashTable_;
+  RowHashTable<Value> hashTable_;
+  RowHashTable<List> listHashTable_;
 };
 }  // namespace graph
 }  // namespace nebula
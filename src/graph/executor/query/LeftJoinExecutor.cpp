@@ -35,7 +35,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
   DCHECK_EQ(hashKeys.size(), probeKeys.size());
   DataSet result;
   if (hashKeys.size() == 1 && probeKeys.size() == 1) {
-    std::unordered_map<Value, std::vector<const Row*>> hashTable;
+    RowHashTable<Value> hashTable;
     hashTable.reserve(rhsIter_->empty() ? 1 : rhsIter_->size());
     if (!lhsIter_->empty()) {
       buildSingleKeyHashTable(probeKeys.front(), rhsIter_.get(), hashTable);
@@ -43,7 +43,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    RowHashTable<List> hashTable;
     hashTable.reserve(rhsIter_->empty() ? 1 : rhsIter_->size());
     if (!lhsIter_->empty()) {
       buildHashTable(probeKeys, rhsIter_.get(), hashTable);
@@ -59,7 +59,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
 DataSet LeftJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+    const RowHashTable<List>& hashTable) const {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -85,7 +85,7 @@ DataSet LeftJoinExecutor::probe(
 DataSet LeftJoinExecutor::singleKeyProbe(
     Expression* probeKey,
     Iterator* probeIter,
-    const std::unordered_map<Value, std::vector<const Row*>>& hashTable) const {
+    const RowHashTable<Value>& hashTable) const {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -199,12 +199,12 @@ folly::Future<Status> LeftJoinExecutor::singleKeyProbe(Expression* probeKey, Ite
 }
 
 template <class T>
-void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
+void LeftJoinExecutor::buildNewRow(const RowHashTable<T>& hashTable,
                                    const T& val,
                                    Row lRow,
                                    DataSet& ds) const {
-  auto range = hashTable.find(val);
-  if (range == hashTable.end()) {
+  const auto* rows = hashTable.find(val);
+  if (rows == nullptr) {
     auto lRowSize = lRow.size();
     Row newRow;
     newRow.reserve(colSize_);
@@ -215,11 +215,12 @@ void LeftJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const
     values.insert(values.end(), colSize_ - lRowSize, Value::kNullValue);
     ds.rows.emplace_back(std::move(newRow));
   } else {
-    for (std::size_t i = 0; i < (range->second.size() - 1); ++i) {
-      ds.rows.emplace_back(newRow(lRow, *range->second[i]));
+    auto iter = rows->begin();
+    for (std::size_t i = 0; i < (rows->size() - 1); ++i, ++iter) {
+      ds.rows.emplace_back(newRow(lRow, **iter));
     }
     // Move probe row in last new row creating
-    ds.rows.emplace_back(newRow(std::move(lRow), *range->second.back()));
+    ds.rows.emplace_back(newRow(std::move(lRow), *rows->back()));
   }
 }
 
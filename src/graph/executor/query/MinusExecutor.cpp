@@ -4,8 +4,7 @@
 
 #include "graph/executor/query/MinusExecutor.h"
 
-#include <robin_hood.h>
-
+#include "common/datatypes/HashTable.h"
 #include "graph/planner/plan/Query.h"
 
 namespace nebula {
@@ -19,7 +18,7 @@ folly::Future<Status> MinusExecutor::execute() {
   auto left = getLeftInputData();
   auto right = getRightInputData();
 
-  robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> hashSet;
+  HashSet<const Row*> hashSet;
   hashSet.reserve(right.iterRef()->size());
   for (; right.iterRef()->valid(); right.iterRef()->next()) {
     hashSet.insert(right.iterRef()->row());
@@ -29,8 +28,7 @@ folly::Future<Status> MinusExecutor::execute() {
   auto* lIter = left.iterRef();
   if (!hashSet.empty()) {
     while (lIter->valid()) {
-      auto iter = hashSet.find(lIter->row());
-      if (iter == hashSet.end()) {
+      if (!hashSet.contains(lIter->row())) {
         lIter->next();
       } else {
         lIter->unstableErase();
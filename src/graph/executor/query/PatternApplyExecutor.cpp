@@ -40,7 +40,7 @@ Status PatternApplyExecutor::checkBiInputDataSets() {
 
 void PatternApplyExecutor::collectValidKeys(const std::vector<Expression*>& keyCols,
                                             Iterator* iter,
-                                            std::unordered_set<List>& validKeys) const {
+                                            HashSet<List>& validKeys) const {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     List list;
@@ -49,17 +49,17 @@ void PatternApplyExecutor::collectValidKeys(const std::vector<Expression*>& keyC
       Value val = col->eval(ctx(iter));
       list.values.emplace_back(std::move(val));
     }
-    validKeys.emplace(std::move(list));
+    validKeys.insert(std::move(list));
   }
 }
 
 void PatternApplyExecutor::collectValidKey(Expression* keyCol,
                                            Iterator* iter,
-                                           std::unordered_set<Value>& validKey) const {
+                                           HashSet<Value>& validKey) const {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     auto& val = keyCol->eval(ctx(iter));
-    validKey.emplace(val);
+    validKey.insert(val);
   }
 }
 
@@ -78,13 +78,13 @@ DataSet PatternApplyExecutor::applyZeroKey(Iterator* appliedIter, const bool all
 
 DataSet PatternApplyExecutor::applySingleKey(Expression* appliedKey,
                                              Iterator* appliedIter,
-                                             const std::unordered_set<Value>& validKey) {
+                                             const HashSet<Value>& validKey) {
   DataSet ds;
   ds.rows.reserve(appliedIter->size());
   QueryExpressionContext ctx(ectx_);
   for (; appliedIter->valid(); appliedIter->next()) {
     auto& val = appliedKey->eval(ctx(appliedIter));
-    bool applyFlag = (validKey.find(val) != validKey.end()) ^ isAntiPred_;
+    bool applyFlag = validKey.contains(val) ^ isAntiPred_;
     if (applyFlag) {
       Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
       ds.rows.emplace_back(std::move(row));
@@ -95,7 +95,7 @@ DataSet PatternApplyExecutor::applySingleKey(Expression* appliedKey,
 
 DataSet PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys,
                                             Iterator* appliedIter,
-                                            const std::unordered_set<List>& validKeys) {
+                                            const HashSet<List>& validKeys) {
   DataSet ds;
   ds.rows.reserve(appliedIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -107,7 +107,7 @@ DataSet PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys
       list.values.emplace_back(std::move(val));
     }
 
-    bool applyFlag = (validKeys.find(list) != validKeys.end()) ^ isAntiPred_;
+    bool applyFlag = validKeys.contains(list) ^ isAntiPred_;
     if (applyFlag) {
       Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
       ds.rows.emplace_back(std::move(row));
@@ -127,7 +127,7 @@ folly::Future<Status> PatternApplyExecutor::patternApply() {
     // Reverse the valid flag if the pattern predicate is an anti-predicate
     applyZeroKey(lhsIter_.get(), (rhsIter_->size() > 0) ^ isAntiPred_);
   } else if (keyCols.size() == 1) {
-    std::unordered_set<Value> validKey;
+    HashSet<Value> validKey;
     collectValidKey(keyCols[0]->clone(), rhsIter_.get(), validKey);
     result = applySingleKey(keyCols[0]->clone(), lhsIter_.get(), validKey);
   } else {
@@ -141,7 +141,7 @@ folly::Future<Status> PatternApplyExecutor::patternApply() {
       return applyColsCopy;
     };
 
-    std::unordered_set<List> validKeys;
+    HashSet<List> validKeys;
     collectValidKeys(cloneExpr(keyCols), rhsIter_.get(), validKeys);
     result = applyMultiKey(cloneExpr(keyCols), lhsIter_.get(), validKeys);
   }
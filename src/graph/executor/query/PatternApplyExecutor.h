@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "common/datatypes/HashTable.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -22,21 +23,21 @@ class PatternApplyExecutor : public Executor {
 
   void collectValidKeys(const std::vector<Expression*>& keyCols,
                         Iterator* iter,
-                        std::unordered_set<List>& validKeys) const;
+                        HashSet<List>& validKeys) const;
 
   void collectValidKey(Expression* keyCol,
                        Iterator* iter,
-                       std::unordered_set<Value>& validKey) const;
+                       HashSet<Value>& validKey) const;
 
   DataSet applyZeroKey(Iterator* appliedIter, const bool allValid);
 
   DataSet applySingleKey(Expression* appliedCol,
                          Iterator* appliedIter,
-                         const std::unordered_set<Value>& validKey);
+                         const HashSet<Value>& validKey);
 
   DataSet applyMultiKey(std::vector<Expression*> appliedKeys,
                         Iterator* appliedIter,
-                        const std::unordered_set<List>& validKeys);
+                        const HashSet<List>& validKeys);
 
   folly::Future<Status> patternApply();
   std::unique_ptr<Iterator> lhsIter_;
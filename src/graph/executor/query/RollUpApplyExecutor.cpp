@@ -40,7 +40,7 @@ Status RollUpApplyExecutor::checkBiInputDataSets() {
 void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compareCols,
                                          const InputPropertyExpression* collectCol,
                                          Iterator* iter,
-                                         std::unordered_map<List, List>& hashTable) const {
+                                         HashMap<List, List>& hashTable) const {
   QueryExpressionContext ctx(ectx_);
 
   for (; iter->valid(); iter->next()) {
@@ -51,16 +51,15 @@ void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compare
       list.values.emplace_back(std::move(val));
     }
 
-    auto& vals = hashTable[list];
+    auto& vals = hashTable[std::move(list)];
     vals.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
   }
 }
 
-void RollUpApplyExecutor::buildSingleKeyHashTable(
-    Expression* compareCol,
-    const InputPropertyExpression* collectCol,
-    Iterator* iter,
-    std::unordered_map<Value, List>& hashTable) const {
+void RollUpApplyExecutor::buildSingleKeyHashTable(Expression* compareCol,
+                                                  const InputPropertyExpression* collectCol,
+                                                  Iterator* iter,
+                                                  HashMap<Value, List>& hashTable) const {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     auto& val = compareCol->eval(ctx(iter));
@@ -94,16 +93,16 @@ DataSet RollUpApplyExecutor::probeZeroKey(Iterator* probeIter, const List& hashT
 
 DataSet RollUpApplyExecutor::probeSingleKey(Expression* probeKey,
                                             Iterator* probeIter,
-                                            const std::unordered_map<Value, List>& hashTable) {
+                                            const HashMap<Value, List>& hashTable) {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
   for (; probeIter->valid(); probeIter->next()) {
     auto& val = probeKey->eval(ctx(probeIter));
     List vals;
-    auto found = hashTable.find(val);
-    if (found != hashTable.end()) {
-      vals = found->second;
+    const auto* found = hashTable.find(val);
+    if (found != nullptr) {
+      vals = *found;
     }
     Row row = mv_ ? probeIter->moveRow() : *probeIter->row();
     row.emplace_back(std::move(vals));
@@ -114,7 +113,7 @@ DataSet RollUpApplyExecutor::probeSingleKey(Expression* probeKey,
 
 DataSet RollUpApplyExecutor::probe(std::vector<Expression*> probeKeys,
                                    Iterator* probeIter,
-                                   const std::unordered_map<List, List>& hashTable) {
+                                   const HashMap<List, List>& hashTable) {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -127,9 +126,9 @@ DataSet RollUpApplyExecutor::probe(std::vector<Expression*> probeKeys,
     }
 
     List vals;
-    auto found = hashTable.find(list);
-    if (found != hashTable.end()) {
-      vals = found->second;
+    const auto* found = hashTable.find(list);
+    if (found != nullptr) {
+      vals = *found;
     }
     Row row = mv_ ? probeIter->moveRow() : *probeIter->row();
     row.emplace_back(std::move(vals));
@@ -151,7 +150,7 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
     buildZeroKeyHashTable(rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
     result = probeZeroKey(lhsIter_.get(), hashTable);
   } else if (compareCols.size() == 1) {
-    std::unordered_map<Value, List> hashTable;
+    HashMap<Value, List> hashTable;
     buildSingleKeyHashTable(
         compareCols[0]->clone(), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
     result = probeSingleKey(compareCols[0]->clone(), lhsIter_.get(), hashTable);
@@ -166,7 +165,7 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
       return collectColsCopy;
     };
 
-    std::unordered_map<List, List> hashTable;
+    HashMap<List, List> hashTable;
     buildHashTable(
         cloneExpr(compareCols), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
 
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "common/datatypes/HashTable.h"
 #include "graph/executor/Executor.h"
 
 namespace nebula {
@@ -25,12 +26,12 @@ class RollUpApplyExecutor : public Executor {
   void buildHashTable(const std::vector<Expression*>& compareCols,
                       const InputPropertyExpression* collectCol,
                       Iterator* iter,
-                      std::unordered_map<List, List>& hashTable) const;
+                      HashMap<List, List>& hashTable) const;
 
   void buildSingleKeyHashTable(Expression* compareCol,
                                const InputPropertyExpression* collectCol,
                                Iterator* iter,
-                               std::unordered_map<Value, List>& hashTable) const;
+                               HashMap<Value, List>& hashTable) const;
 
   void buildZeroKeyHashTable(const InputPropertyExpression* collectCol,
                              Iterator* iter,
@@ -40,11 +41,11 @@ class RollUpApplyExecutor : public Executor {
 
   DataSet probeSingleKey(Expression* probeKey,
                          Iterator* probeIter,
-                         const std::unordered_map<Value, List>& hashTable);
+                         const HashMap<Value, List>& hashTable);
 
   DataSet probe(std::vector<Expression*> probeKeys,
                 Iterator* probeIter,
-                const std::unordered_map<List, List>& hashTable);
+                const HashMap<List, List>& hashTable);
 
   folly::Future<Status> rollUpApply();
 
@@ -187,11 +187,11 @@ void TraverseExecutor::buildAdjList(DataSet& dataset,
     VidHashSet dstSet;
     auto adjEdges = iter.getAdjEdges(&dstSet);
     for (const Value& dst : dstSet) {
-      if (adjList_.find(dst) == adjList_.end()) {
+      if (!adjList_.contains(dst)) {
         vids.emplace(dst);
       }
     }
-    DCHECK(adjList_.find(v) == adjList_.end())
+    DCHECK(!adjList_.contains(v))
         << "The adjacency list should not contain the source vertex: " << v;
     adjList.emplace(v, std::move(adjEdges));
   }
@@ -238,6 +238,8 @@ folly::Future<Status> TraverseExecutor::asyncExpandOneStep(RpcResponse&& resps)
           }
         }
 
+        // The adjacency lists of the responses are built concurrently on the vertex keyed maps,
+        // and merged into the list keyed by the dense ids here
         adjList_.reserve(adjList_.size() + sizeOf(*adjLists));
         for (auto& adjList : *adjLists) {
           for (auto& p : adjList) {
@@ -263,10 +265,15 @@ folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
   }
 
   initVertices_.reserve(numRows);
+  adjList_.reserve(adjList_.size() + numRows);
   for (auto& resp : resps.responses()) {
     auto dataset = resp.get_vertices();
     if (dataset) {
-      buildAdjList(*dataset, initVertices_, vids_, adjList_);
+      VertexMap<Value> adjList;
+      buildAdjList(*dataset, initVertices_, vids_, adjList);
+      for (auto& p : adjList) {
+        adjList_.emplace(std::move(p.first), std::move(p.second));
+      }
     }
   }
 
@@ -347,7 +354,7 @@ void TraverseExecutor::expand(GetNeighborsIter* iter) {
       continue;
     }
     const auto& dst = edge.getEdge().dst;
-    if (adjList_.find(dst) == adjList_.end()) {
+    if (!adjList_.contains(dst)) {
       vids_.emplace(dst);
     }
     const auto& vertex = iter->getVertex();
@@ -479,12 +486,12 @@ std::vector<Row> TraverseExecutor::buildPath(const Value& initVertex,
                                              size_t minStep,
                                              size_t maxStep) {
   memory::MemoryCheckGuard guard;
-  auto vidIter = adjList_.find(initVertex);
-  if (vidIter == adjList_.end()) {
+  auto* adj = adjList_.find(initVertex);
+  if (adj == nullptr) {
     return std::vector<Row>();
   }
-  auto& src = vidIter->first;
-  auto& adjEdges = vidIter->second;
+  auto& src = adj->vertex;
+  auto& adjEdges = adj->edges;
   if (adjEdges.empty()) {
     return std::vector<Row>();
   }
@@ -537,8 +544,8 @@ std::vector<Row> TraverseExecutor::buildPath(const Value& initVertex,
     }
 
     --adjSize;
-    auto dstIter = adjList_.find(dst);
-    if (dstIter == adjList_.end()) {
+    auto* dstAdj = adjList_.find(dst);
+    if (dstAdj == nullptr) {
       if (adjSize == 0) {
         if (++step > maxStep) {
           break;
@@ -548,7 +555,7 @@ std::vector<Row> TraverseExecutor::buildPath(const Value& initVertex,
       continue;
     }
 
-    auto& adjedges = dstIter->second;
+    auto& adjedges = dstAdj->edges;
     for (auto& edge : adjedges) {
       if (hasSameEdge(*edgeListPtr, edge.getEdge())) {
         continue;
@@ -559,7 +566,7 @@ std::vector<Row> TraverseExecutor::buildPath(const Value& initVertex,
       std::unique_ptr<std::vector<Value>> newVertexEdgeListPtr = nullptr;
       if (genPath_) {
         newVertexEdgeListPtr = std::make_unique<std::vector<Value>>(*vertexEdgeListPtr);
-        newVertexEdgeListPtr->emplace_back(dstIter->first);
+        newVertexEdgeListPtr->emplace_back(dstAdj->vertex);
         newVertexEdgeListPtr->emplace_back(edge);
       }
 
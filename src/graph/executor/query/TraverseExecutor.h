@@ -9,6 +9,7 @@
 
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/util/VidDict.h"
 #include "interface/gen-cpp2/storage_types.h"
 
 // only used in match scenarios
@@ -97,8 +98,8 @@ class TraverseExecutor final : public StorageAccessExecutor {
   VidHashSet vids_;
   std::vector<Value> initVertices_;
   DataSet result_;
-  // Key : vertex  Value : adjacent edges
-  VertexMap<Value> adjList_;
+  // Key : dense id of the vertex  Value : the vertex and its adjacent edges
+  VidAdjList adjList_;
   VertexMap<Row> dst2PathsMap_;
   const Traverse* traverse_{nullptr};
   MatchStepRange range_;
@@ -584,6 +584,88 @@ TEST_F(FindPathTest, multiSourceShortestPath) {
   }
 }
 
+// a->b, a->c, b->d, c->d
+// The paths meet at both b and c in the first step, and each of them has one parent link on
+// each side, so the vids restored from the dictionaries make two paths.
+TEST_F(FindPathTest, shortestPathMeetAtMultipleVids) {
+  auto gnDataSet = [this](
+                       const std::string& src, const std::vector<std::string>& dsts, bool reverse) {
+    DataSet ds;
+    ds.colNames = gnColNames_;
+    Row row;
+    row.values.emplace_back(src);
+    row.values.emplace_back(Value());
+    List edges;
+    for (const auto& dst : dsts) {
+      List edge;
+      edge.values.emplace_back(reverse ? -EDGE_TYPE : EDGE_TYPE);
+      edge.values.emplace_back(dst);
+      edge.values.emplace_back(EDGE_RANK);
+      edges.values.emplace_back(std::move(edge));
+    }
+    row.values.emplace_back(std::move(edges));
+    row.values.emplace_back(Value());
+    ds.rows.emplace_back(std::move(row));
+    return ds;
+  };
+  auto vidDataSet = [](const std::string& vid) {
+    DataSet ds;
+    ds.colNames = {nebula::kVid};
+    ds.rows.emplace_back(Row({vid}));
+    return ds;
+  };
+
+  std::string leftVidVar = "leftVid";
+  std::string rightVidVar = "rightVid";
+  std::string fromGNInput = "fromGNInput";
+  std::string toGNInput = "toGNInput";
+  for (const auto& var : {leftVidVar, rightVidVar, fromGNInput, toGNInput}) {
+    qctx_->symTable()->newVariable(var);
+  }
+  qctx_->ectx()->setResult(
+      leftVidVar,
+      ResultBuilder().value(vidDataSet("a")).iter(Iterator::Kind::kSequential).build());
+  qctx_->ectx()->setResult(
+      rightVidVar,
+      ResultBuilder().value(vidDataSet("d")).iter(Iterator::Kind::kSequential).build());
+  {
+    List datasets;
+    datasets.values.emplace_back(gnDataSet("a", {"b", "c"}, false));
+    qctx_->ectx()->setResult(
+        fromGNInput,
+        ResultBuilder().value(std::move(datasets)).iter(Iterator::Kind::kGetNeighbors).build());
+  }
+  {
+    List datasets;
+    datasets.values.emplace_back(gnDataSet("d", {"b", "c"}, true));
+    qctx_->ectx()->setResult(
+        toGNInput,
+        ResultBuilder().value(std::move(datasets)).iter(Iterator::Kind::kGetNeighbors).build());
+  }
+
+  auto* path = BFSShortestPath::make(
+      qctx_.get(), StartNode::make(qctx_.get()), StartNode::make(qctx_.get()), 5);
+  path->setLeftVar(fromGNInput);
+  path->setRightVar(toGNInput);
+  path->setLeftVidVar(leftVidVar);
+  path->setRightVidVar(rightVidVar);
+  path->setColNames(pathColNames_);
+  auto pathExe = std::make_unique<BFSShortestPathExecutor>(path, qctx_.get());
+  auto status = pathExe->execute().get();
+  ASSERT_TRUE(status.ok()) << status;
+
+  DataSet expected;
+  expected.colNames = pathColNames_;
+  for (const auto& p : std::vector<std::vector<std::string>>{{"a", "b", "d"}, {"a", "c", "d"}}) {
+    expected.rows.emplace_back(Row({createPath(p)}));
+  }
+  auto& result = qctx_->ectx()->getResult(path->outputVar());
+  auto resultDs = result.value().getDataSet();
+  std::sort(resultDs.rows.begin(), resultDs.rows.end());
+  EXPECT_EQ(expected, resultDs);
+  EXPECT_EQ(result.state(), Result::State::kSuccess);
+}
+
 TEST_F(FindPathTest, empthInput) {
   int steps = 5;
   std::string leftVidVar = "leftVid";
@@ -106,6 +106,11 @@ folly::Future<cpp2::LookupIndexResp> GraphStorageLocalServer::future_lookupIndex
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::LookupIndexResp, future_lookupIndex);
 }
 
+folly::Future<cpp2::TextSearchResponse> GraphStorageLocalServer::future_textSearch(
+    const cpp2::TextSearchRequest& request) {
+  LOCAL_RETURN_FUTURE(threadManager_, cpp2::TextSearchResponse, future_textSearch);
+}
+
 folly::Future<cpp2::GetNeighborsResponse> GraphStorageLocalServer::future_lookupAndTraverse(
     const cpp2::LookupAndTraverseRequest& request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetNeighborsResponse, future_lookupAndTraverse);
@@ -5,11 +5,16 @@
 #include "graph/gc/GC.h"
 
 #include "common/memory/MemoryTracker.h"
+#include "common/time/WallClock.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
 
 namespace nebula {
 namespace graph {
 
+// Number of the elements of a container inspected to estimate its memory
+static constexpr size_t kNumSamples = 16;
+
 GC& GC::instance() {
   static GC gc;
   return gc;
@@ -25,14 +30,85 @@ GC::GC() {
 }
 
 void GC::clear(std::vector<Result>&& garbage) {
+  if (garbage.empty()) {
+    return;
+  }
   memory::MemoryCheckOffGuard guard;
+  int64_t bytes = 0;
+  for (const auto& result : garbage) {
+    if (result.valuePtr() != nullptr) {
+      bytes += estimateBytes(result.value());
+    }
+  }
+  // The limit changes with the available memory if the memory tracker is self adaptive
+  auto maxPending = static_cast<int64_t>(memory::MemoryStats::instance().getLimit() *
+                                         FLAGS_gc_max_pending_ratio);
+  auto pending = pendingBytes_.fetch_add(bytes, std::memory_order_relaxed);
+  if (pending > 0 && pending + bytes > maxPending) {
+    // Back-pressure, release in the calling thread until the workers catch up
+    pendingBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    garbage.clear();
+    stats::StatsManager::addValue(kNumGCInlineReleases);
+    stats::StatsManager::addValue(kGCReclaimedBytes, bytes);
+    return;
+  }
+  stats::StatsManager::addValue(kGCPendingBytes, bytes);
   // do not bother folly
-  queue_.enqueue(std::move(garbage));
+  queue_.enqueue(Garbage{std::move(garbage), bytes, time::WallClock::fastNowInMicroSec()});
 }
 
 void GC::periodicTask() {
-  while (!queue_.empty()) {
-    queue_.try_dequeue();
+  while (auto garbage = queue_.try_dequeue()) {
+    // All results of a dropped variable or a finished query are released in one go
+    garbage->results.clear();
+    auto bytes = garbage->bytes;
+    pendingBytes_.fetch_sub(bytes, std::memory_order_relaxed);
+    stats::StatsManager::decValue(kGCPendingBytes, bytes);
+    stats::StatsManager::addValue(kGCReclaimedBytes, bytes);
+    stats::StatsManager::addValue(kGCLagUs,
+                                  time::WallClock::fastNowInMicroSec() - garbage->enqueueTime);
+  }
+}
+
+// static
+size_t GC::estimateBytes(const Value& value) {
+  // Estimate the memory of a container by the average of its first few elements
+  auto sampled = [](const auto& elems, auto&& bytesOf) -> size_t {
+    auto num = std::min(elems.size(), kNumSamples);
+    if (num == 0) {
+      return 0;
+    }
+    size_t bytes = 0;
+    for (size_t i = 0; i < num; i++) {
+      bytes += bytesOf(elems[i]);
+    }
+    return bytes / num * elems.size();
+  };
+  auto valueBytes = [](const Value& v) { return estimateBytes(v); };
+  switch (value.type()) {
+    case Value::Type::STRING:
+      return sizeof(Value) + value.getStr().capacity();
+    case Value::Type::LIST:
+      return sizeof(Value) + sizeof(List) + sampled(value.getList().values, valueBytes);
+    case Value::Type::SET:
+      return sizeof(Value) + sizeof(Set) + value.getSet().values.size() * sizeof(Value) * 2;
+    case Value::Type::MAP:
+      return sizeof(Value) + sizeof(Map) + value.getMap().kvs.size() * sizeof(Value) * 2;
+    case Value::Type::DATASET: {
+      const auto& ds = value.getDataSet();
+      auto rowBytes = [&valueBytes, &sampled](const Row& row) {
+        return sizeof(Row) + sampled(row.values, valueBytes);
+      };
+      return sizeof(Value) + sizeof(DataSet) + sampled(ds.rows, rowBytes);
+    }
+    case Value::Type::VERTEX:
+      return sizeof(Value) + sizeof(Vertex) + value.getVertex().tags.size() * sizeof(Tag);
+    case Value::Type::EDGE:
+      return sizeof(Value) + sizeof(Edge) + value.getEdge().props.size() * sizeof(Value) * 2;
+    case Value::Type::PATH:
+      return sizeof(Value) + sizeof(Path) + value.getPath().steps.size() * sizeof(Step);
+    default:
+      return sizeof(Value);
   }
 }
 
@@ -15,6 +15,12 @@ namespace graph {
 // Clean the unused memory on background threads, this is helpful
 // for big queries since the memory release of interim results may
 // cost too much time.
+//
+// The garbage pending in the queue is bounded by gc_max_pending_ratio of the
+// memory limit of the memory tracker. Once the bound is reached, the garbage
+// is released in the calling thread, so the queries producing garbage faster
+// than the workers could release are slowed down instead of holding unbounded
+// memory. The bound is lifted with the limit if the memory tracker is disabled.
 class GC {
  public:
   static GC& instance();
@@ -25,10 +31,27 @@ class GC {
 
   void clear(std::vector<Result>&& garbage);
 
+  // Estimated bytes of the garbage which is not released yet
+  int64_t pendingBytes() const {
+    return pendingBytes_.load(std::memory_order_relaxed);
+  }
+
+  // Estimated memory held by the value, only a few rows of a big dataset or
+  // list are inspected.
+  static size_t estimateBytes(const Value& value);
+
  private:
+  struct Garbage {
+    std::vector<Result> results;
+    int64_t bytes;
+    // When the garbage is enqueued, in microseconds
+    int64_t enqueueTime;
+  };
+
   GC();
   void periodicTask();
-  folly::UMPMCQueue<std::vector<Result>, false> queue_;
+  folly::UMPMCQueue<Garbage, false> queue_;
+  std::atomic<int64_t> pendingBytes_{0};
   thread::GenericThreadPool workers_;
 };
 }  // namespace graph
@@ -0,0 +1,160 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/GeoKnnIndexScanRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/util/OptimizerUtils.h"
+
+using nebula::graph::GeoKnnIndexScan;
+using nebula::graph::IndexScan;
+using nebula::graph::OptimizerUtils;
+using nebula::graph::Project;
+using nebula::graph::TopN;
+using nebula::storage::cpp2::IndexQueryContext;
+
+namespace nebula {
+namespace opt {
+
+/*static*/ const std::initializer_list<graph::PlanNode::Kind>
+    GeoKnnIndexScanRule::kIndexScanKinds{
+        graph::PlanNode::Kind::kIndexScan,
+        graph::PlanNode::Kind::kTagIndexFullScan,
+        graph::PlanNode::Kind::kEdgeIndexFullScan,
+    };
+
+std::unique_ptr<OptRule> GeoKnnIndexScanRule::kInstance =
+    std::unique_ptr<GeoKnnIndexScanRule>(new GeoKnnIndexScanRule());
+
+GeoKnnIndexScanRule::GeoKnnIndexScanRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &GeoKnnIndexScanRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      graph::PlanNode::Kind::kTopN,
+      {Pattern::create(graph::PlanNode::Kind::kProject, {Pattern::create(kIndexScanKinds)})});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> GeoKnnIndexScanRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto qctx = octx->qctx();
+  auto topNGroupNode = matched.node;
+  auto projectGroupNode = matched.dependencies.front().node;
+  auto indexScanGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto topN = static_cast<const TopN *>(topNGroupNode->node());
+  const auto project = static_cast<const Project *>(projectGroupNode->node());
+  const auto indexScan = indexScanGroupNode->node()->asNode<IndexScan>();
+
+  const auto &factors = topN->factors();
+  if (factors.size() != 1 || factors.front().second != OrderFactor::OrderType::ASCEND) {
+    return TransformResult::noTransform();
+  }
+  if (indexScan->filter() != nullptr || !indexScan->orderBy().empty()) {
+    return TransformResult::noTransform();
+  }
+  for (auto &ictx : indexScan->queryContext()) {
+    if (!ictx.get_column_hints().empty() || !ictx.get_filter().empty()) {
+      return TransformResult::noTransform();
+    }
+  }
+
+  // ST_Distance(x, point) or ST_Distance(point, x)
+  auto *expr = project->columns()->columns()[factors.front().first]->expr();
+  if (expr->kind() != Expression::Kind::kFunctionCall) {
+    return TransformResult::noTransform();
+  }
+  auto *func = static_cast<const FunctionCallExpression *>(expr);
+  std::string funcName = func->name();
+  folly::toLowerAscii(funcName);
+  if (funcName != "st_distance" || func->args()->numArgs() != 2) {
+    return TransformResult::noTransform();
+  }
+  auto propKind =
+      indexScan->isEdge() ? Expression::Kind::kEdgeProperty : Expression::Kind::kTagProperty;
+  const PropertyExpression *propExpr = nullptr;
+  Expression *pointExpr = nullptr;
+  for (size_t i = 0; i < 2; ++i) {
+    auto *arg = func->args()->args()[i];
+    auto *other = func->args()->args()[1 - i];
+    if (arg->kind() == propKind && graph::ExpressionUtils::isEvaluableExpr(other, qctx)) {
+      propExpr = static_cast<const PropertyExpression *>(arg);
+      pointExpr = other;
+      break;
+    }
+  }
+  if (propExpr == nullptr) {
+    return TransformResult::noTransform();
+  }
+  auto pointVal = pointExpr->eval(graph::QueryExpressionContext(qctx->ectx())());
+  if (!pointVal.isGeography() || pointVal.getGeography().shape() != GeoShape::POINT) {
+    return TransformResult::noTransform();
+  }
+  const auto &prop = propExpr->prop();
+  const auto &returnCols = indexScan->returnColumns();
+  if (std::find(returnCols.begin(), returnCols.end(), prop) == returnCols.end()) {
+    return TransformResult::noTransform();
+  }
+
+  auto metaClient = qctx->getMetaClient();
+  auto status = indexScan->isEdge() ? metaClient->getEdgeIndexesFromCache(indexScan->space())
+                                    : metaClient->getTagIndexesFromCache(indexScan->space());
+  NG_RETURN_IF_ERROR(status);
+  auto indexItems = std::move(status).value();
+  OptimizerUtils::eraseInvalidIndexItems(indexScan->schemaId(), &indexItems);
+  auto geoIndex = std::find_if(indexItems.begin(), indexItems.end(), [&prop](const auto &item) {
+    const auto &fields = item->get_fields();
+    return fields.size() == 1 && fields.back().get_name() == prop &&
+           fields.back().get_type().get_type() == nebula::cpp2::PropertyType::GEOGRAPHY;
+  });
+  if (geoIndex == indexItems.end()) {
+    return TransformResult::noTransform();
+  }
+
+  auto newTopN = static_cast<TopN *>(topN->clone());
+  newTopN->setOutputVar(topN->outputVar());
+  auto newTopNGroupNode = OptGroupNode::create(octx, newTopN, topNGroupNode->group());
+
+  auto newProject = static_cast<Project *>(project->clone());
+  auto newProjectGroup = OptGroup::create(octx);
+  auto newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+
+  auto newScan = GeoKnnIndexScan::make(qctx, nullptr, prop, pointVal.getGeography());
+  OptimizerUtils::copyIndexScanData(indexScan, newScan, qctx);
+  newScan->setLimit(topN->offset() + topN->count());
+  IndexQueryContext ictx;
+  ictx.index_id_ref() = (*geoIndex)->get_index_id();
+  newScan->setIndexQueryContext({std::move(ictx)});
+  newScan->setOutputVar(indexScan->outputVar());
+  newScan->setColNames(indexScan->colNames());
+  auto newScanGroup = OptGroup::create(octx);
+  auto newScanGroupNode = newScanGroup->makeGroupNode(newScan);
+
+  newTopNGroupNode->dependsOn(newProjectGroup);
+  newTopN->setInputVar(newProject->outputVar());
+  newProjectGroupNode->dependsOn(newScanGroup);
+  newProject->setInputVar(newScan->outputVar());
+  for (auto dep : indexScanGroupNode->dependencies()) {
+    newScanGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newTopNGroupNode);
+  return result;
+}
+
+std::string GeoKnnIndexScanRule::toString() const {
+  return "GeoKnnIndexScanRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
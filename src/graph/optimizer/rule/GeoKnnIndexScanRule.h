@@ -0,0 +1,74 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_GEOKNNINDEXSCANRULE_H
+#define GRAPH_OPTIMIZER_RULE_GEOKNNINDEXSCANRULE_H
+
+#include <initializer_list>
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Turn `ORDER BY ST_Distance(x, point) LIMIT k` on an index full scan into a kNN search
+//  of the geo index on x
+//  Required conditions:
+//   1. Match the pattern
+//   2. TopN sorts by only one column ascending, which is ST_Distance of a property and a
+//      constant point
+//   3. The scan doesn't have any column hint or filter, and there is a geo index on the property
+//  Benefits:
+//   1. Only the rings of cells around the point are scanned, instead of the whole index
+//
+//  Transformation:
+//  Before:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//   +---------+---------+
+//   |  kIndexScanKinds  |
+//   +---------+---------+
+//
+//  After:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//   +---------+---------+
+//   |  GeoKnnIndexScan  |
+//   | (limit_=limitRows)|
+//   +---------+---------+
+
+class GeoKnnIndexScanRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  GeoKnnIndexScanRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+  static const std::initializer_list<graph::PlanNode::Kind> kIndexScanKinds;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -0,0 +1,162 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushTopNDownGetNeighborsRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::ExpandAll;
+using nebula::graph::Explore;
+using nebula::graph::GetNeighbors;
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+using nebula::graph::TopN;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushTopNDownGetNeighborsRule::kInstance =
+    std::unique_ptr<PushTopNDownGetNeighborsRule>(new PushTopNDownGetNeighborsRule());
+
+PushTopNDownGetNeighborsRule::PushTopNDownGetNeighborsRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushTopNDownGetNeighborsRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      graph::PlanNode::Kind::kTopN,
+      {Pattern::create(graph::PlanNode::Kind::kProject,
+                       {Pattern::create({graph::PlanNode::Kind::kGetNeighbors,
+                                         graph::PlanNode::Kind::kExpandAll})})});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushTopNDownGetNeighborsRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto topNGroupNode = matched.node;
+  auto projectGroupNode = matched.dependencies.front().node;
+  auto exploreGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto topN = static_cast<const TopN *>(topNGroupNode->node());
+  const auto project = static_cast<const Project *>(projectGroupNode->node());
+  const auto explore = static_cast<const Explore *>(exploreGroupNode->node());
+
+  const auto &factors = topN->factors();
+  if (factors.size() != 1 || !explore->orderBy().empty()) {
+    return TransformResult::noTransform();
+  }
+  const auto &columns = project->columns()->columns();
+  auto factor = factors.front();
+  if (factor.first >= columns.size()) {
+    return TransformResult::noTransform();
+  }
+
+  // The storage could only sort the edges of one edge type by its adjacency order
+  EdgeType edgeType = 0;
+  const Expression *sortExpr = nullptr;
+  if (explore->kind() == PlanNode::Kind::kGetNeighbors) {
+    const auto gn = static_cast<const GetNeighbors *>(explore);
+    const auto *edgeProps = gn->edgeProps();
+    if (gn->random() || gn->edgeTypes().size() != 1 || edgeProps == nullptr ||
+        edgeProps->size() != 1 || edgeProps->front().get_type() != gn->edgeTypes().front()) {
+      return TransformResult::noTransform();
+    }
+    edgeType = gn->edgeTypes().front();
+    sortExpr = columns[factor.first]->expr();
+  } else {
+    // ExpandAll goes more than one step if minSteps < maxSteps, then the limit would also drop
+    // the paths to the next steps
+    const auto expandAll = static_cast<const ExpandAll *>(explore);
+    const auto *edgeProps = expandAll->edgeProps();
+    if (expandAll->sample() || expandAll->minSteps() != expandAll->maxSteps() ||
+        !expandAll->stepLimits().empty() || edgeProps == nullptr || edgeProps->size() != 1 ||
+        expandAll->edgeColumns() == nullptr) {
+      return TransformResult::noTransform();
+    }
+    edgeType = edgeProps->front().get_type();
+    // The project reads the edge property from the column of ExpandAll
+    const auto *colExpr = columns[factor.first]->expr();
+    if (colExpr->kind() != Expression::Kind::kVarProperty) {
+      return TransformResult::noTransform();
+    }
+    const auto &alias = static_cast<const PropertyExpression *>(colExpr)->prop();
+    for (const auto *col : expandAll->edgeColumns()->columns()) {
+      if (col->alias() == alias) {
+        sortExpr = col->expr();
+        break;
+      }
+    }
+  }
+  if (sortExpr == nullptr || sortExpr->kind() != Expression::Kind::kEdgeProperty) {
+    return TransformResult::noTransform();
+  }
+  const auto *propExpr = static_cast<const EdgePropertyExpression *>(sortExpr);
+
+  auto edgeName = qctx->schemaMng()->toEdgeName(explore->space(), std::abs(edgeType));
+  if (!edgeName.ok() || edgeName.value() != propExpr->sym()) {
+    return TransformResult::noTransform();
+  }
+  auto schema = qctx->schemaMng()->getEdgeSchema(explore->space(), std::abs(edgeType));
+  if (schema == nullptr) {
+    return TransformResult::noTransform();
+  }
+  const auto *orderCol = schema->getAdjacencyOrderCol();
+  bool desc = factor.second == OrderFactor::OrderType::DESCEND;
+  if (orderCol == nullptr || *orderCol != propExpr->prop() ||
+      desc != schema->isAdjacencyOrderDesc()) {
+    return TransformResult::noTransform();
+  }
+
+  // The first offset + count edges of each vertex are enough for the TopN of all vertices
+  int64_t limitRows = topN->offset() + topN->count();
+  if (explore->limitExpr() != nullptr && explore->limit(qctx) >= 0 &&
+      limitRows > explore->limit(qctx)) {
+    return TransformResult::noTransform();
+  }
+
+  storage::cpp2::OrderBy orderBy;
+  orderBy.prop_ref() = propExpr->prop();
+  orderBy.direction_ref() = desc ? storage::cpp2::OrderDirection::DESCENDING
+                                 : storage::cpp2::OrderDirection::ASCENDING;
+
+  auto newTopN = static_cast<TopN *>(topN->clone());
+  newTopN->setOutputVar(topN->outputVar());
+  auto newTopNGroupNode = OptGroupNode::create(octx, newTopN, topNGroupNode->group());
+
+  auto newProject = static_cast<Project *>(project->clone());
+  auto newProjectGroup = OptGroup::create(octx);
+  auto newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+
+  auto newExplore = static_cast<Explore *>(explore->clone());
+  newExplore->setLimit(limitRows);
+  newExplore->setOrderBy({std::move(orderBy)});
+  auto newExploreGroup = OptGroup::create(octx);
+  auto newExploreGroupNode = newExploreGroup->makeGroupNode(newExplore);
+
+  newTopNGroupNode->dependsOn(newProjectGroup);
+  newTopN->setInputVar(newProject->outputVar());
+  newProjectGroupNode->dependsOn(newExploreGroup);
+  newProject->setInputVar(newExplore->outputVar());
+  for (auto dep : exploreGroupNode->dependencies()) {
+    newExploreGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newTopNGroupNode);
+  return result;
+}
+
+std::string PushTopNDownGetNeighborsRule::toString() const {
+  return "PushTopNDownGetNeighborsRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
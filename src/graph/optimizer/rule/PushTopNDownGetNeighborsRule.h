@@ -0,0 +1,74 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNGETNEIGHBORSRULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNGETNEIGHBORSRULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embedding order by and limit of TopN to [[GetNeighbors]] or [[ExpandAll]] of GO, so the storage
+//  reads the first edges of each vertex from the adjacency index instead of all edges
+//  Required conditions:
+//   1. Match the pattern
+//   2. GetNeighbors (or ExpandAll of the last step only) goes over a single edge type in one
+//      direction, not random
+//   3. TopN sorts by one property of the edge, which is the adjacency order of the edge type in
+//      the same direction
+//  Benefits:
+//   1. Only offset + count edges of each vertex are read, no matter how many edges it has
+//
+//  Transformation:
+//  Before:
+//
+//  +--------+--------+
+//  |      TopN       |
+//  | (e.ts DESC, 3)  |
+//  +--------+--------+
+//           |
+//  +--------+--------+
+//  |     Project     |
+//  +--------+--------+
+//           |
+// +---------+---------+
+// |    GetNeighbors   |
+// +---------+---------+
+//
+//  After:
+//
+//  +--------+--------+
+//  |      TopN       |
+//  | (e.ts DESC, 3)  |
+//  +--------+--------+
+//           |
+//  +--------+--------+
+//  |     Project     |
+//  +--------+--------+
+//           |
+// +---------+---------+
+// |    GetNeighbors   |
+// |(ts DESC, limit=3) |
+// +---------+---------+
+
+class PushTopNDownGetNeighborsRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushTopNDownGetNeighborsRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -58,6 +58,8 @@ const char* PlanNode::toString(PlanNode::Kind kind) {
       return "EdgeIndexFullScan";
     case Kind::kEdgeIndexRangeScan:
       return "EdgeIndexRangeScan";
+    case Kind::kGeoKnnIndexScan:
+      return "GeoKnnIndexScan";
     case Kind::kEdgeIndexPrefixScan:
       return "EdgeIndexPrefixScan";
     case Kind::kScanVertices:
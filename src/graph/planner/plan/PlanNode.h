@@ -42,6 +42,7 @@ class PlanNode {
     kEdgeIndexFullScan,
     kEdgeIndexPrefixScan,
     kEdgeIndexRangeScan,
+    kGeoKnnIndexScan,
     kScanVertices,
     kScanEdges,
     kFulltextIndexScan,
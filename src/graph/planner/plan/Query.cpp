@@ -289,6 +289,26 @@ void IndexScan::cloneMembers(const IndexScan& g) {
   yieldColumns_ = g.yieldColumns();
 }
 
+std::unique_ptr<PlanNodeDescription> GeoKnnIndexScan::explain() const {
+  auto desc = IndexScan::explain();
+  addDescription("geoColumn", geoColumn_, desc.get());
+  addDescription("point", point_.asWKT(), desc.get());
+  return desc;
+}
+
+PlanNode* GeoKnnIndexScan::clone() const {
+  auto* newScan = GeoKnnIndexScan::make(qctx_, nullptr);
+  newScan->cloneMembers(*this);
+  return newScan;
+}
+
+void GeoKnnIndexScan::cloneMembers(const GeoKnnIndexScan& g) {
+  IndexScan::cloneMembers(g);
+
+  geoColumn_ = g.geoColumn_;
+  point_ = g.point_;
+}
+
 std::unique_ptr<PlanNodeDescription> ScanVertices::explain() const {
   auto desc = Explore::explain();
   addDescription("props", props_ ? folly::toJson(util::toJson(*props_)) : "", desc.get());
@@ -755,6 +755,56 @@ class IndexScan : public Explore {
   bool lazyIndexHint_{false};
 };
 
+// Scan the geo index for the k geographies nearest to the point, k is the limit of node.
+// The rings of S2 cells around the point are scanned outward until the distance of ring
+// exceeds the k-th nearest one.
+class GeoKnnIndexScan final : public IndexScan {
+ public:
+  static GeoKnnIndexScan* make(QueryContext* qctx,
+                               PlanNode* input,
+                               std::string geoColumn = "",
+                               Geography point = Geography()) {
+    return qctx->objPool()->makeAndAdd<GeoKnnIndexScan>(
+        qctx, input, std::move(geoColumn), std::move(point));
+  }
+
+  // The geography property in return columns
+  const std::string& geoColumn() const {
+    return geoColumn_;
+  }
+
+  const Geography& point() const {
+    return point_;
+  }
+
+  PlanNode* clone() const override;
+  std::unique_ptr<PlanNodeDescription> explain() const override;
+
+ private:
+  friend ObjectPool;
+  GeoKnnIndexScan(QueryContext* qctx, PlanNode* input, std::string geoColumn, Geography point)
+      : IndexScan(qctx,
+                  input,
+                  -1,
+                  {},
+                  {},
+                  false,
+                  -1,
+                  false,
+                  {},
+                  std::numeric_limits<int64_t>::max(),
+                  nullptr,
+                  Kind::kGeoKnnIndexScan),
+        geoColumn_(std::move(geoColumn)),
+        point_(std::move(point)) {}
+
+  void cloneMembers(const GeoKnnIndexScan&);
+
+ private:
+  std::string geoColumn_;
+  Geography point_;
+};
+
 class FulltextIndexScan : public Explore {
  public:
   static FulltextIndexScan* make(QueryContext* qctx,
@@ -0,0 +1,280 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/scheduler/ResourceGroup.h"
+
+#include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+
+#include "common/stats/StatsManager.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
+
+namespace nebula {
+namespace graph {
+
+ResourceGroup::ResourceGroup(ResourceGroupSpec spec) : spec_(std::move(spec)) {
+  if (spec_.numThreads > 0) {
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        spec_.numThreads, std::make_shared<folly::NamedThreadFactory>("rg-" + spec_.name));
+  }
+}
+
+ResourceGroup::~ResourceGroup() {
+  if (executor_ != nullptr) {
+    executor_->join();
+  }
+}
+
+StatusOr<folly::Future<folly::Unit>> ResourceGroup::admit(SessionID sessionId) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (spec_.maxConcurrency == 0 || running_ < spec_.maxConcurrency) {
+    running_++;
+    addQueueLatency(0);
+    return folly::makeFuture();
+  }
+  if (spec_.maxQueueSize != 0 && queue_.size() >= spec_.maxQueueSize) {
+    stats::StatsManager::addValue(stats::StatsManager::counterWithLabels(
+        kNumResourceGroupRejectedQueries, {{"resource_group", spec_.name}}));
+    return Status::Error("Too many queries waiting in resource group `%s'", spec_.name.c_str());
+  }
+  queue_.emplace_back();
+  queue_.back().sessionId = sessionId;
+  stats::StatsManager::addValue(stats::StatsManager::counterWithLabels(
+      kNumResourceGroupQueuedQueries, {{"resource_group", spec_.name}}));
+  return queue_.back().promise.getFuture();
+}
+
+void ResourceGroup::release(uint64_t latencyInUs) {
+  stats::StatsManager::addValue(
+      stats::StatsManager::histoWithLabels(kResourceGroupQueryLatencyUs,
+                                           {{"resource_group", spec_.name}}),
+      latencyInUs);
+  folly::Promise<folly::Unit> next;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (queue_.empty()) {
+      DCHECK_GT(running_, 0);
+      running_--;
+      return;
+    }
+    // The slot is handed over to the next query directly, so running_ is unchanged
+    auto& waiter = queue_.front();
+    addQueueLatency(waiter.duration.elapsedInUSec());
+    next = std::move(waiter.promise);
+    queue_.pop_front();
+  }
+  stats::StatsManager::decValue(stats::StatsManager::counterWithLabels(
+      kNumResourceGroupQueuedQueries, {{"resource_group", spec_.name}}));
+  // Fulfill the promise out of the lock since the continuation may run inline
+  next.setValue();
+}
+
+void ResourceGroup::addQueueLatency(uint64_t latencyInUs) const {
+  stats::StatsManager::addValue(
+      stats::StatsManager::histoWithLabels(kResourceGroupQueueLatencyUs,
+                                           {{"resource_group", spec_.name}}),
+      latencyInUs);
+}
+
+size_t ResourceGroup::removeSessions(const std::unordered_set<SessionID>& sessions) {
+  std::vector<Waiter> removed;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (auto iter = queue_.begin(); iter != queue_.end();) {
+      if (sessions.count(iter->sessionId) > 0) {
+        removed.emplace_back(std::move(*iter));
+        iter = queue_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+  for (auto& waiter : removed) {
+    stats::StatsManager::decValue(stats::StatsManager::counterWithLabels(
+        kNumResourceGroupQueuedQueries, {{"resource_group", spec_.name}}));
+    // Fail the promise out of the lock since the continuation may run inline
+    waiter.promise.setException(std::runtime_error(folly::stringPrintf(
+        "Session %ld is removed before the query is admitted", waiter.sessionId)));
+  }
+  return removed.size();
+}
+
+size_t ResourceGroup::numRunning() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return running_;
+}
+
+size_t ResourceGroup::numQueued() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return queue_.size();
+}
+
+Status ResourceGroupManager::init() {
+  if (FLAGS_resource_groups.empty()) {
+    return Status::OK();
+  }
+  auto specs = parseSpecs(FLAGS_resource_groups);
+  NG_RETURN_IF_ERROR(specs);
+  auto mapping = parseUserMapping(FLAGS_resource_group_users);
+  NG_RETURN_IF_ERROR(mapping);
+
+  for (auto& spec : specs.value()) {
+    auto name = spec.name;
+    groups_.emplace(name, std::make_unique<ResourceGroup>(std::move(spec)));
+  }
+  for (auto& [user, names] : mapping.value()) {
+    for (auto& name : names) {
+      if (groups_.find(name) == groups_.end()) {
+        return Status::Error(
+            "Resource group `%s' of user `%s' not found", name.c_str(), user.c_str());
+      }
+    }
+  }
+  userToGroups_ = std::move(mapping).value();
+
+  auto found = groups_.find(FLAGS_default_resource_group);
+  if (found == groups_.end()) {
+    // Queries not assigned to any group are not limited
+    ResourceGroupSpec spec;
+    spec.name = FLAGS_default_resource_group;
+    found = groups_.emplace(spec.name, std::make_unique<ResourceGroup>(std::move(spec))).first;
+  }
+  defaultGroup_ = found->second.get();
+  return Status::OK();
+}
+
+ResourceGroup* ResourceGroupManager::resolve(const std::string& query,
+                                             const std::string& sessionGroup,
+                                             const std::string& user,
+                                             bool isGod) const {
+  auto found = userToGroups_.find(user);
+  auto granted = [&found, isGod, this](const std::string& name) -> ResourceGroup* {
+    if (!isGod && (found == userToGroups_.end() ||
+                   std::find(found->second.begin(), found->second.end(), name) ==
+                       found->second.end())) {
+      return nullptr;
+    }
+    return group(name);
+  };
+  auto hint = extractHint(query);
+  if (!hint.empty()) {
+    auto* hinted = granted(hint);
+    if (hinted != nullptr) {
+      return hinted;
+    }
+    VLOG(1) << "Resource group `" << hint << "' in the hint not found or not granted to user `"
+            << user << "', ignore it";
+  }
+  if (!sessionGroup.empty()) {
+    auto* assigned = granted(sessionGroup);
+    if (assigned != nullptr) {
+      return assigned;
+    }
+  }
+  if (found != userToGroups_.end()) {
+    return DCHECK_NOTNULL(group(found->second.front()));
+  }
+  return defaultGroup_;
+}
+
+ResourceGroup* ResourceGroupManager::group(const std::string& name) const {
+  auto found = groups_.find(name);
+  return found == groups_.end() ? nullptr : found->second.get();
+}
+
+void ResourceGroupManager::removeSessions(const std::vector<SessionID>& ids) {
+  if (groups_.empty() || ids.empty()) {
+    return;
+  }
+  std::unordered_set<SessionID> sessions(ids.begin(), ids.end());
+  for (auto& group : groups_) {
+    auto num = group.second->removeSessions(sessions);
+    if (num > 0) {
+      VLOG(1) << "Remove " << num << " queued queries from resource group `" << group.first << "'";
+    }
+  }
+}
+
+// static
+StatusOr<std::vector<ResourceGroupSpec>> ResourceGroupManager::parseSpecs(
+    const std::string& groups) {
+  std::vector<std::string> items;
+  folly::split(",", groups, items, true);
+  std::vector<ResourceGroupSpec> specs;
+  std::unordered_set<std::string> names;
+  for (auto& item : items) {
+    std::vector<std::string> fields;
+    folly::split(":", folly::trimWhitespace(item), fields);
+    if (fields.size() != 4 || fields[0].empty()) {
+      return Status::Error("Invalid resource group `%s'", item.c_str());
+    }
+    ResourceGroupSpec spec;
+    spec.name = fields[0];
+    try {
+      spec.numThreads = folly::to<size_t>(fields[1]);
+      spec.maxConcurrency = folly::to<size_t>(fields[2]);
+      spec.maxQueueSize = folly::to<size_t>(fields[3]);
+    } catch (const std::exception& e) {
+      return Status::Error("Invalid resource group `%s': %s", item.c_str(), e.what());
+    }
+    if (!names.emplace(spec.name).second) {
+      return Status::Error("Duplicate resource group `%s'", spec.name.c_str());
+    }
+    specs.emplace_back(std::move(spec));
+  }
+  return specs;
+}
+
+// static
+StatusOr<std::unordered_map<std::string, std::vector<std::string>>>
+ResourceGroupManager::parseUserMapping(const std::string& mapping) {
+  std::vector<std::string> items;
+  folly::split(",", mapping, items, true);
+  std::unordered_map<std::string, std::vector<std::string>> userToGroups;
+  for (auto& item : items) {
+    std::vector<std::string> fields;
+    folly::split(":", folly::trimWhitespace(item), fields);
+    if (fields.size() != 2 || fields[0].empty() || fields[1].empty()) {
+      return Status::Error("Invalid resource group user mapping `%s'", item.c_str());
+    }
+    std::vector<std::string> names;
+    folly::split("|", fields[1], names);
+    if (std::any_of(names.begin(), names.end(), [](const auto& name) { return name.empty(); })) {
+      return Status::Error("Invalid resource group user mapping `%s'", item.c_str());
+    }
+    userToGroups[fields[0]] = std::move(names);
+  }
+  return userToGroups;
+}
+
+// static
+std::string ResourceGroupManager::extractHint(const std::string& query) {
+  static const std::string kHintBegin = "/*+";
+  static const std::string kHintKey = "resource_group(";
+  folly::StringPiece sp(query);
+  sp = folly::ltrimWhitespace(sp);
+  if (!sp.startsWith(kHintBegin)) {
+    return "";
+  }
+  auto end = sp.find("*/");
+  if (end == folly::StringPiece::npos) {
+    return "";
+  }
+  auto hint = sp.subpiece(kHintBegin.size(), end - kHintBegin.size());
+  auto begin = hint.find(kHintKey);
+  if (begin == folly::StringPiece::npos) {
+    return "";
+  }
+  hint.advance(begin + kHintKey.size());
+  auto close = hint.find(')');
+  if (close == folly::StringPiece::npos) {
+    return "";
+  }
+  return folly::trimWhitespace(hint.subpiece(0, close)).str();
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,138 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SCHEDULER_RESOURCEGROUP_H_
+#define GRAPH_SCHEDULER_RESOURCEGROUP_H_
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include <boost/core/noncopyable.hpp>
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/cpp/helpers.h"
+#include "common/thrift/ThriftTypes.h"
+#include "common/time/Duration.h"
+
+namespace nebula {
+namespace graph {
+
+struct ResourceGroupSpec {
+  std::string name;
+  // Number of dedicated worker threads, 0 means sharing the thrift worker threads.
+  size_t numThreads{0};
+  // Max number of queries running concurrently, 0 means no limit.
+  size_t maxConcurrency{0};
+  // Max number of queries waiting for admission, 0 means no limit.
+  size_t maxQueueSize{0};
+};
+
+/**
+ * A ResourceGroup isolates a class of workload from the others. Each group owns an optional
+ * thread pool on which its queries' executors run, a concurrency limit and a FIFO queue of
+ * queries waiting for a free slot. A query holds its slot from `admit' until `release'.
+ */
+class ResourceGroup final : private boost::noncopyable, private cpp::NonMovable {
+ public:
+  explicit ResourceGroup(ResourceGroupSpec spec);
+  ~ResourceGroup();
+
+  const std::string& name() const {
+    return spec_.name;
+  }
+
+  const ResourceGroupSpec& spec() const {
+    return spec_;
+  }
+
+  // The dedicated runner of this group, nullptr if the group shares the default runner.
+  folly::Executor* runner() const {
+    return executor_.get();
+  }
+
+  // Ask for a slot to run a query of the session. The returned future is fulfilled once the slot
+  // is granted, it's ready immediately if the group has a free slot. An error is returned if the
+  // queue is full.
+  StatusOr<folly::Future<folly::Unit>> admit(SessionID sessionId);
+
+  // Give back the slot taken by a finished query, the slot is handed over to the next queued
+  // query if any.
+  void release(uint64_t latencyInUs);
+
+  // Remove the queued queries of the sessions, their futures are failed. Returns the number of
+  // the removed queries.
+  size_t removeSessions(const std::unordered_set<SessionID>& sessions);
+
+  size_t numRunning() const;
+
+  size_t numQueued() const;
+
+ private:
+  struct Waiter {
+    SessionID sessionId;
+    folly::Promise<folly::Unit> promise;
+    time::Duration duration;
+  };
+
+  void addQueueLatency(uint64_t latencyInUs) const;
+
+  ResourceGroupSpec spec_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  mutable std::mutex lock_;
+  size_t running_{0};
+  std::deque<Waiter> queue_;
+};
+
+// ResourceGroupManager holds all resource groups of a graphd and decides which group a query
+// belongs to. The group is chosen with the following precedence:
+//   1. The statement hint, e.g. `/*+ resource_group(olap) */ MATCH ...'
+//   2. The `resource_group' config of the session
+//   3. The first group mapped to the user by `--resource_group_users'
+//   4. The default group
+// The hint and the session config could only choose the groups mapped to the user, unless the
+// user is the god user. Otherwise they are ignored, so a user can't escape the limits of its
+// groups.
+class ResourceGroupManager final : private boost::noncopyable, private cpp::NonMovable {
+ public:
+  ResourceGroupManager() = default;
+
+  // Build groups from `--resource_groups', which looks like
+  // "name:threads:concurrency:queue_size,name:threads:concurrency:queue_size".
+  // Nothing is created when the flag is empty, and all queries run as before.
+  Status init();
+
+  bool enabled() const {
+    return !groups_.empty();
+  }
+
+  ResourceGroup* resolve(const std::string& query,
+                         const std::string& sessionGroup,
+                         const std::string& user,
+                         bool isGod) const;
+
+  ResourceGroup* group(const std::string& name) const;
+
+  // Remove the queued queries of the killed or expired sessions from all groups.
+  void removeSessions(const std::vector<SessionID>& ids);
+
+  static StatusOr<std::vector<ResourceGroupSpec>> parseSpecs(const std::string& groups);
+
+  // Parse `--resource_group_users', which looks like "user1:group1|group2,user2:group3".
+  static StatusOr<std::unordered_map<std::string, std::vector<std::string>>> parseUserMapping(
+      const std::string& mapping);
+
+  // Extract the group name from a leading hint comment of the query, empty if not found.
+  static std::string extractHint(const std::string& query);
+
+ private:
+  std::unordered_map<std::string, std::unique_ptr<ResourceGroup>> groups_;
+  // The groups a user could choose, the first one is used if the query doesn't choose any
+  std::unordered_map<std::string, std::vector<std::string>> userToGroups_;
+  ResourceGroup* defaultGroup_{nullptr};
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SCHEDULER_RESOURCEGROUP_H_
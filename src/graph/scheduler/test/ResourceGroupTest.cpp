@@ -0,0 +1,160 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "graph/scheduler/ResourceGroup.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/stats/GraphStats.h"
+
+namespace nebula {
+namespace graph {
+
+class ResourceGroupTest : public testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    initGraphStats();
+  }
+};
+
+TEST_F(ResourceGroupTest, ParseSpecs) {
+  {
+    auto specs = ResourceGroupManager::parseSpecs("oltp:0:256:4096, olap:4:2:16");
+    ASSERT_TRUE(specs.ok()) << specs.status();
+    auto& groups = specs.value();
+    ASSERT_EQ(2, groups.size());
+    EXPECT_EQ("oltp", groups[0].name);
+    EXPECT_EQ(0, groups[0].numThreads);
+    EXPECT_EQ(256, groups[0].maxConcurrency);
+    EXPECT_EQ(4096, groups[0].maxQueueSize);
+    EXPECT_EQ("olap", groups[1].name);
+    EXPECT_EQ(4, groups[1].numThreads);
+    EXPECT_EQ(2, groups[1].maxConcurrency);
+    EXPECT_EQ(16, groups[1].maxQueueSize);
+  }
+  {
+    EXPECT_FALSE(ResourceGroupManager::parseSpecs("oltp:0:256").ok());
+    EXPECT_FALSE(ResourceGroupManager::parseSpecs("oltp:a:1:1").ok());
+    EXPECT_FALSE(ResourceGroupManager::parseSpecs("oltp:0:1:1,oltp:0:2:2").ok());
+  }
+  {
+    auto mapping = ResourceGroupManager::parseUserMapping("root:oltp,analyst:olap|oltp");
+    ASSERT_TRUE(mapping.ok()) << mapping.status();
+    EXPECT_EQ(std::vector<std::string>{"oltp"}, mapping.value().at("root"));
+    EXPECT_EQ((std::vector<std::string>{"olap", "oltp"}), mapping.value().at("analyst"));
+    EXPECT_FALSE(ResourceGroupManager::parseUserMapping("root").ok());
+    EXPECT_FALSE(ResourceGroupManager::parseUserMapping("root:oltp|").ok());
+  }
+}
+
+TEST_F(ResourceGroupTest, ExtractHint) {
+  EXPECT_EQ("olap", ResourceGroupManager::extractHint("/*+ resource_group(olap) */ MATCH (v)"));
+  EXPECT_EQ("olap", ResourceGroupManager::extractHint("  /*+resource_group( olap )*/GO FROM 1"));
+  EXPECT_EQ("", ResourceGroupManager::extractHint("/* resource_group(olap) */ MATCH (v)"));
+  EXPECT_EQ("", ResourceGroupManager::extractHint("MATCH (v) /*+ resource_group(olap) */"));
+  EXPECT_EQ("", ResourceGroupManager::extractHint("/*+ resource_group(olap"));
+}
+
+TEST_F(ResourceGroupTest, Resolve) {
+  auto groups = FLAGS_resource_groups;
+  auto users = FLAGS_resource_group_users;
+  FLAGS_resource_groups = "oltp:0:256:4096,olap:0:2:16,etl:0:1:1";
+  FLAGS_resource_group_users = "analyst:olap|oltp,loader:etl";
+  ResourceGroupManager manager;
+  ASSERT_TRUE(manager.init().ok());
+  FLAGS_resource_groups = groups;
+  FLAGS_resource_group_users = users;
+
+  // The first mapped group is used by default, the others could be chosen
+  EXPECT_EQ("olap", manager.resolve("MATCH (v)", "", "analyst", false)->name());
+  EXPECT_EQ("oltp",
+            manager.resolve("/*+ resource_group(oltp) */ MATCH (v)", "", "analyst", false)->name());
+  EXPECT_EQ("oltp", manager.resolve("MATCH (v)", "oltp", "analyst", false)->name());
+
+  // The groups not mapped to the user are ignored
+  auto* chosen = manager.resolve("/*+ resource_group(etl) */ MATCH (v)", "etl", "analyst", false);
+  EXPECT_EQ("olap", chosen->name());
+  EXPECT_EQ(FLAGS_default_resource_group,
+            manager.resolve("/*+ resource_group(oltp) */ MATCH (v)", "", "guest", false)->name());
+
+  // The god user could choose any group
+  EXPECT_EQ("etl",
+            manager.resolve("/*+ resource_group(etl) */ MATCH (v)", "", "root", true)->name());
+  EXPECT_EQ(FLAGS_default_resource_group,
+            manager.resolve("/*+ resource_group(none) */ MATCH (v)", "", "root", true)->name());
+}
+
+TEST_F(ResourceGroupTest, Admission) {
+  ResourceGroupSpec spec;
+  spec.name = "test";
+  spec.maxConcurrency = 2;
+  spec.maxQueueSize = 1;
+  ResourceGroup group(std::move(spec));
+  EXPECT_EQ(nullptr, group.runner());
+
+  auto first = group.admit(1);
+  ASSERT_TRUE(first.ok());
+  EXPECT_TRUE(first.value().isReady());
+  auto second = group.admit(1);
+  ASSERT_TRUE(second.ok());
+  EXPECT_TRUE(second.value().isReady());
+  EXPECT_EQ(2, group.numRunning());
+
+  // Queued until one of the running queries finishes
+  auto third = group.admit(1);
+  ASSERT_TRUE(third.ok());
+  EXPECT_FALSE(third.value().isReady());
+  EXPECT_EQ(1, group.numQueued());
+
+  // The queue is full
+  EXPECT_FALSE(group.admit(1).ok());
+
+  group.release(100);
+  EXPECT_TRUE(third.value().isReady());
+  EXPECT_EQ(0, group.numQueued());
+  EXPECT_EQ(2, group.numRunning());
+
+  group.release(100);
+  group.release(100);
+  EXPECT_EQ(0, group.numRunning());
+}
+
+TEST_F(ResourceGroupTest, RemoveSessions) {
+  ResourceGroupSpec spec;
+  spec.name = "test";
+  spec.maxConcurrency = 1;
+  ResourceGroup group(std::move(spec));
+
+  auto running = group.admit(1);
+  ASSERT_TRUE(running.ok());
+  EXPECT_TRUE(running.value().isReady());
+  auto queued1 = group.admit(1);
+  auto queued2 = group.admit(2);
+  auto queued3 = group.admit(1);
+  ASSERT_TRUE(queued1.ok() && queued2.ok() && queued3.ok());
+  EXPECT_EQ(3, group.numQueued());
+
+  // The queued queries of session 1 are failed, and the running one is not affected
+  EXPECT_EQ(2, group.removeSessions({1}));
+  EXPECT_EQ(1, group.numQueued());
+  EXPECT_EQ(1, group.numRunning());
+  ASSERT_TRUE(queued1.value().isReady());
+  EXPECT_TRUE(queued1.value().hasException());
+  ASSERT_TRUE(queued3.value().isReady());
+  EXPECT_TRUE(queued3.value().hasException());
+  EXPECT_FALSE(queued2.value().isReady());
+
+  // The slot is handed over to the query of session 2
+  group.release(100);
+  ASSERT_TRUE(queued2.value().isReady());
+  EXPECT_FALSE(queued2.value().hasException());
+  EXPECT_EQ(0, group.numQueued());
+  EXPECT_EQ(1, group.numRunning());
+  group.release(100);
+  EXPECT_EQ(0, group.numRunning());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,306 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/BatchInserter.h"
+
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+#include "common/expression/Expression.h"
+#include "graph/context/QueryExpressionContext.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+Status checkVid(const Value& vid, Value::Type vidType) {
+  if (vid.type() != vidType) {
+    return Status::SemanticError("Wrong vertex id type: %s", vid.toString().c_str());
+  }
+  return Status::OK();
+}
+
+Status checkValue(const Value& value) {
+  // The same as the values evaluated from the INSERT statement
+  if (value.isNull() && value.getNull() != NullType::__NULL__) {
+    return Status::SemanticError("Wrong value type: %s", value.toString().c_str());
+  }
+  return Status::OK();
+}
+
+// Resolve the property names of batch, all properties of schema if none is given
+StatusOr<std::vector<std::string>> propNamesOf(const meta::NebulaSchemaProvider& schema,
+                                               const std::vector<std::string>& names,
+                                               const std::vector<std::vector<Value>>& columns,
+                                               size_t numRows) {
+  std::vector<std::string> propNames;
+  if (names.empty()) {
+    for (size_t i = 0; i < schema.getNumFields(); ++i) {
+      propNames.emplace_back(schema.getFieldName(i));
+    }
+  } else {
+    for (const auto& name : names) {
+      if (schema.getFieldIndex(name) < 0) {
+        return Status::SemanticError("Unknown column `%s' in schema", name.c_str());
+      }
+      propNames.emplace_back(name);
+    }
+  }
+  if (columns.size() != propNames.size()) {
+    return Status::SemanticError("Column count doesn't match value count.");
+  }
+  for (const auto& column : columns) {
+    if (column.size() != numRows) {
+      return Status::SemanticError("Column count doesn't match value count.");
+    }
+    for (const auto& value : column) {
+      NG_RETURN_IF_ERROR(checkValue(value));
+    }
+  }
+  return propNames;
+}
+
+// The non-nullable properties given could not be null, as checked by storage when writing
+Status checkNotNull(const meta::NebulaSchemaProvider& schema,
+                    const std::vector<std::string>& propNames,
+                    const std::vector<std::vector<Value>>& columns) {
+  for (size_t i = 0; i < propNames.size(); ++i) {
+    const auto* field = schema.field(propNames[i]);
+    if (field->nullable()) {
+      continue;
+    }
+    for (const auto& value : columns[i]) {
+      if (value.isNull()) {
+        return Status::SemanticError("The non-nullable property `%s' could not be NULL.",
+                                     field->name());
+      }
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+// static
+StatusOr<BatchInserter::Batch> BatchInserter::prepare(meta::SchemaManager* schemaMng,
+                                                      GraphSpaceID space,
+                                                      Value::Type vidType,
+                                                      const cpp2::BatchInsertRequest& req) {
+  if (req.get_vertices().empty() && req.get_edges().empty()) {
+    return Status::SemanticError("VALUES cannot be empty");
+  }
+  Batch batch;
+  batch.space = space;
+  batch.ifNotExists = req.get_if_not_exists();
+  batch.ignoreExistedIndex = req.get_ignore_existed_index();
+  for (const auto& vertexBatch : req.get_vertices()) {
+    NG_RETURN_IF_ERROR(prepareVertices(schemaMng, vidType, vertexBatch, batch));
+  }
+  for (const auto& edgeBatch : req.get_edges()) {
+    NG_RETURN_IF_ERROR(prepareEdges(schemaMng, vidType, edgeBatch, batch));
+  }
+  return batch;
+}
+
+// static
+Status BatchInserter::prepareVertices(meta::SchemaManager* schemaMng,
+                                      Value::Type vidType,
+                                      const cpp2::VertexBatch& vertexBatch,
+                                      Batch& batch) {
+  const auto& tagName = vertexBatch.get_tag_name();
+  auto tagStatus = schemaMng->toTagID(batch.space, tagName);
+  if (!tagStatus.ok()) {
+    return Status::SemanticError("No schema found for `%s'", tagName.c_str());
+  }
+  auto tagId = tagStatus.value();
+  auto schema = schemaMng->getTagSchema(batch.space, tagId);
+  if (schema == nullptr) {
+    return Status::SemanticError("No schema found for `%s'", tagName.c_str());
+  }
+  if (batch.tagPropNames.find(tagId) != batch.tagPropNames.end()) {
+    return Status::SemanticError("Duplicate tag `%s' in batch", tagName.c_str());
+  }
+
+  const auto& vids = vertexBatch.get_vids();
+  const auto& columns = vertexBatch.get_prop_columns();
+  auto propNames = propNamesOf(*schema, vertexBatch.get_prop_names(), columns, vids.size());
+  NG_RETURN_IF_ERROR(propNames);
+  NG_RETURN_IF_ERROR(checkNotNull(*schema, propNames.value(), columns));
+  batch.tagPropNames.emplace(tagId, std::move(propNames).value());
+
+  batch.vertices.reserve(batch.vertices.size() + vids.size());
+  for (size_t row = 0; row < vids.size(); ++row) {
+    NG_RETURN_IF_ERROR(checkVid(vids[row], vidType));
+    std::vector<Value> props;
+    props.reserve(columns.size());
+    for (const auto& column : columns) {
+      props.emplace_back(column[row]);
+    }
+    storage::cpp2::NewTag tag;
+    tag.tag_id_ref() = tagId;
+    tag.props_ref() = std::move(props);
+    storage::cpp2::NewVertex vertex;
+    vertex.id_ref() = vids[row];
+    vertex.tags_ref() = {std::move(tag)};
+    batch.vertices.emplace_back(std::move(vertex));
+  }
+  return Status::OK();
+}
+
+// static
+Status BatchInserter::prepareEdges(meta::SchemaManager* schemaMng,
+                                   Value::Type vidType,
+                                   const cpp2::EdgeBatch& edgeBatch,
+                                   Batch& batch) {
+  const auto& edgeName = edgeBatch.get_edge_name();
+  auto edgeStatus = schemaMng->toEdgeType(batch.space, edgeName);
+  if (!edgeStatus.ok()) {
+    return Status::SemanticError("No schema found for `%s'", edgeName.c_str());
+  }
+  auto edgeType = edgeStatus.value();
+  auto schema = schemaMng->getEdgeSchema(batch.space, edgeType);
+  if (schema == nullptr) {
+    return Status::SemanticError("No schema found for `%s'", edgeName.c_str());
+  }
+
+  const auto& srcIds = edgeBatch.get_src_ids();
+  const auto& dstIds = edgeBatch.get_dst_ids();
+  const auto& ranks = edgeBatch.get_ranks();
+  if (dstIds.size() != srcIds.size() || (!ranks.empty() && ranks.size() != srcIds.size())) {
+    return Status::SemanticError("The numbers of src ids, dst ids and ranks don't match.");
+  }
+  const auto& columns = edgeBatch.get_prop_columns();
+  auto propNamesStatus =
+      propNamesOf(*schema, edgeBatch.get_prop_names(), columns, srcIds.size());
+  NG_RETURN_IF_ERROR(propNamesStatus);
+  auto propNames = std::move(propNamesStatus).value();
+  NG_RETURN_IF_ERROR(checkNotNull(*schema, propNames, columns));
+
+  // Storage takes all properties of edges, so map each field of schema to the column given, or
+  // to the default value which is evaluated once for the whole batch
+  EdgeBatch edges;
+  size_t numFields = schema->getNumFields();
+  std::vector<int64_t> columnOfField(numFields, -1);
+  std::vector<Value> defaults(numFields);
+  for (size_t i = 0; i < numFields; ++i) {
+    const auto* field = schema->field(i);
+    edges.propNames.emplace_back(field->name());
+    auto iter = std::find(propNames.begin(), propNames.end(), field->name());
+    if (iter != propNames.end()) {
+      columnOfField[i] = std::distance(propNames.begin(), iter);
+    } else if (field->hasDefault()) {
+      const auto& defaultValue = field->defaultValue();
+      DCHECK(!defaultValue.empty());
+      ObjectPool pool;
+      auto expr =
+          Expression::decode(&pool, folly::StringPiece(defaultValue.data(), defaultValue.size()));
+      defaults[i] = expr->eval(QueryExpressionContext()(nullptr));
+    } else if (field->nullable()) {
+      defaults[i] = Value(NullType::__NULL__);
+    } else {
+      return Status::SemanticError("The property `%s' is not nullable and has no default value.",
+                                   field->name());
+    }
+  }
+
+  edges.edges.reserve(srcIds.size() * 2);
+  for (size_t row = 0; row < srcIds.size(); ++row) {
+    NG_RETURN_IF_ERROR(checkVid(srcIds[row], vidType));
+    NG_RETURN_IF_ERROR(checkVid(dstIds[row], vidType));
+    std::vector<Value> props;
+    props.reserve(numFields);
+    for (size_t i = 0; i < numFields; ++i) {
+      props.emplace_back(columnOfField[i] < 0 ? defaults[i] : columns[columnOfField[i]][row]);
+    }
+
+    storage::cpp2::EdgeKey key;
+    key.src_ref() = srcIds[row];
+    key.dst_ref() = dstIds[row];
+    key.edge_type_ref() = edgeType;
+    key.ranking_ref() = ranks.empty() ? 0 : ranks[row];
+    storage::cpp2::NewEdge edge;
+    edge.key_ref() = key;
+    edge.props_ref() = props;
+    edges.edges.emplace_back(std::move(edge));
+    {
+      // inbound
+      key.src_ref() = dstIds[row];
+      key.dst_ref() = srcIds[row];
+      key.edge_type_ref() = -edgeType;
+      storage::cpp2::NewEdge inEdge;
+      inEdge.key_ref() = std::move(key);
+      inEdge.props_ref() = std::move(props);
+      edges.edges.emplace_back(std::move(inEdge));
+    }
+  }
+  batch.edgeBatches.emplace_back(std::move(edges));
+  return Status::OK();
+}
+
+// static
+folly::Future<Status> BatchInserter::insert(storage::StorageClient* storage,
+                                            SessionID session,
+                                            Batch batch,
+                                            folly::Executor* runner) {
+  // The batch has no execution plan, so is the plan id of the requests
+  storage::StorageClient::CommonRequestParam param(batch.space, session, 0);
+  auto future = folly::makeFuture(Status::OK()).via(runner);
+  if (!batch.vertices.empty()) {
+    future = storage
+                 ->addVertices(param,
+                               std::move(batch.vertices),
+                               std::move(batch.tagPropNames),
+                               batch.ifNotExists,
+                               batch.ignoreExistedIndex)
+                 .via(runner)
+                 .thenValue([](auto&& resp) { return handleCompleteness(resp); });
+  }
+  for (auto& edges : batch.edgeBatches) {
+    future = std::move(future).thenValue(
+        [storage,
+         runner,
+         param,
+         edges = std::move(edges),
+         ifNotExists = batch.ifNotExists,
+         ignoreExistedIndex = batch.ignoreExistedIndex](Status status) mutable {
+          if (!status.ok()) {
+            return folly::makeFuture(std::move(status));
+          }
+          return storage
+              ->addEdges(param,
+                         std::move(edges.edges),
+                         std::move(edges.propNames),
+                         ifNotExists,
+                         ignoreExistedIndex)
+              .via(runner)
+              .thenValue([](auto&& resp) { return handleCompleteness(resp); });
+        });
+  }
+  return future;
+}
+
+// static
+Status BatchInserter::handleCompleteness(
+    const storage::StorageRpcResponse<storage::cpp2::ExecResponse>& resp) {
+  if (resp.completeness() == 100) {
+    return Status::OK();
+  }
+  const auto& failedParts = resp.failedParts();
+  for (const auto& part : failedParts) {
+    LOG(ERROR) << "Batch insert failed, error " << apache::thrift::util::enumNameSafe(part.second)
+               << ", part " << part.first;
+  }
+  if (failedParts.empty()) {
+    return Status::Error("Request to storage failed, without failedCodes.");
+  }
+  const auto& failed = *failedParts.begin();
+  return Status::Error("Storage Error: part: %d, error: %s(%d).",
+                       failed.first,
+                       apache::thrift::util::enumNameSafe(failed.second).c_str(),
+                       static_cast<int32_t>(failed.second));
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,77 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_BATCHINSERTER_H_
+#define GRAPH_SERVICE_BATCHINSERTER_H_
+
+#include "clients/storage/StorageClient.h"
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/meta/SchemaManager.h"
+#include "interface/gen-cpp2/graph_types.h"
+#include "interface/gen-cpp2/storage_types.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * BatchInserter writes the vertices and edges of a BatchInsertRequest to storage.
+ *
+ * The request carries the values in columns, so it needs neither the parser nor the planner,
+ * which dominate the cost of INSERT statements with many rows. The checks are the same as the
+ * ones of InsertVerticesValidator and InsertEdgesValidator: the schemas and properties must
+ * exist, the vids must be of the vid type of the space, and the missing edge properties are
+ * filled by their default values.
+ */
+class BatchInserter final {
+ public:
+  struct EdgeBatch {
+    std::vector<storage::cpp2::NewEdge> edges;
+    // All properties of the edge type in the order of its schema
+    std::vector<std::string> propNames;
+  };
+
+  struct Batch {
+    GraphSpaceID space{0};
+    std::vector<storage::cpp2::NewVertex> vertices;
+    std::unordered_map<TagID, std::vector<std::string>> tagPropNames;
+    // One for each edge batch of request, with both the outbound and inbound edges
+    std::vector<EdgeBatch> edgeBatches;
+    bool ifNotExists{false};
+    bool ignoreExistedIndex{false};
+  };
+
+  // Check the request against the schemas of space, and convert it to storage requests.
+  static StatusOr<Batch> prepare(meta::SchemaManager* schemaMng,
+                                 GraphSpaceID space,
+                                 Value::Type vidType,
+                                 const cpp2::BatchInsertRequest& req);
+
+  // Send the vertices and then the edges of batch to storage, the responses are handled in
+  // the runner.
+  static folly::Future<Status> insert(storage::StorageClient* storage,
+                                      SessionID session,
+                                      Batch batch,
+                                      folly::Executor* runner);
+
+ private:
+  static Status prepareVertices(meta::SchemaManager* schemaMng,
+                                Value::Type vidType,
+                                const cpp2::VertexBatch& vertexBatch,
+                                Batch& batch);
+
+  static Status prepareEdges(meta::SchemaManager* schemaMng,
+                             Value::Type vidType,
+                             const cpp2::EdgeBatch& edgeBatch,
+                             Batch& batch);
+
+  static Status handleCompleteness(
+      const storage::StorageRpcResponse<storage::cpp2::ExecResponse>& resp);
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_BATCHINSERTER_H_
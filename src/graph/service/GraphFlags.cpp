@@ -81,6 +81,21 @@ DEFINE_int32(max_sessions_per_ip_per_user,
              300,
              "Maximum number of sessions that can be created per IP and per user");
 
+DEFINE_int32(default_result_page_size,
+             1000,
+             "Number of rows in a page returned by executeWithPaging and fetchNextPage, if the "
+             "page size is not given by the client");
+DEFINE_int32(max_paged_results_per_session,
+             16,
+             "Maximum number of paged results of a session which are not fetched to the end");
+DEFINE_int64(max_paged_result_bytes,
+             1024L * 1024L * 1024L,
+             "Maximum bytes of the rows kept by all paged results of the graphd, the result "
+             "which leaves more bytes than the rest of the buffer is returned in one page");
+DEFINE_int32(paged_result_idle_timeout_secs,
+             600,
+             "The number of seconds before a paged result which is not fetched expires");
+
 DEFINE_bool(optimize_appendvertices, false, "if true, return directly without go through RPC");
 
 DEFINE_uint32(num_path_thread, 10, "number of threads to build path");
@@ -105,10 +120,39 @@ DEFINE_int32(min_batch_size,
              "max_job_size is greater than 1.");
 DEFINE_int32(max_job_size, 1, "The max job size in multi job mode.");
 
-DEFINE_bool(enable_async_gc, false, "If enable async gc.");
+DEFINE_bool(enable_async_gc, true, "If enable async gc.");
 DEFINE_uint32(
     gc_worker_size,
     0,
     "Background garbage clean workers, default number is 0 which means using hardware core size.");
+DEFINE_double(gc_max_pending_ratio,
+              0.1,
+              "Max estimated bytes of the garbage waiting for the background workers, as a ratio "
+              "of the memory limit of the memory tracker, the garbage is released in the query "
+              "thread once it's exceeded.");
 
 DEFINE_bool(graph_use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_string(resource_groups,
+              "",
+              "Resource groups to isolate workloads, the format looks like "
+              "name:threads:concurrency:queue_size,name:threads:concurrency:queue_size. "
+              "0 threads means sharing the worker threads, 0 concurrency or queue_size means "
+              "no limit. Empty to disable the resource groups.");
+DEFINE_string(resource_group_users,
+              "",
+              "Map users to resource groups, the format looks like "
+              "user1:group1|group2,user2:group3. The first group is used by default, the others "
+              "could be chosen by the statement hint or the session config");
+DEFINE_string(default_resource_group,
+              "default",
+              "The resource group of queries which are not assigned to any group");
+
+DEFINE_double(geo_knn_initial_radius,
+              1000,
+              "The radius in meters of the first ring scanned by the geo kNN search, the radius "
+              "grows until the k nearest geographies are found.");
+DEFINE_double(geo_knn_max_radius,
+              1000 * 1000,
+              "The max radius in meters of the rings scanned by the geo kNN search, the rest of "
+              "index is scanned at once if the k nearest geographies are not found within it.");
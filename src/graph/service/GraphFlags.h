@@ -42,6 +42,12 @@ DECLARE_string(cloud_http_url);
 DECLARE_uint32(max_allowed_statements);
 DECLARE_int32(max_sessions_per_ip_per_user);
 
+// Result paging
+DECLARE_int32(default_result_page_size);
+DECLARE_int32(max_paged_results_per_session);
+DECLARE_int64(max_paged_result_bytes);
+DECLARE_int32(paged_result_idle_timeout_secs);
+
 // Failed login attempt
 // value of failed_login_attempts is in the range from 0 to 32767.
 // The deault value is 0. A value of 0 disables the option.
@@ -70,7 +76,16 @@ DECLARE_int32(max_job_size);
 
 DECLARE_bool(enable_async_gc);
 DECLARE_uint32(gc_worker_size);
+DECLARE_double(gc_max_pending_ratio);
 
 DECLARE_bool(graph_use_vertex_key);
 
+// Resource group
+DECLARE_string(resource_groups);
+DECLARE_string(resource_group_users);
+DECLARE_string(default_resource_group);
+
+DECLARE_double(geo_knn_initial_radius);
+DECLARE_double(geo_knn_max_radius);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
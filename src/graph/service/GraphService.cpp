@@ -58,16 +58,20 @@ Status GraphService::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecuto
     return status;
   }
 
+  queryEngine_ = std::make_unique<QueryEngine>();
+  NG_RETURN_IF_ERROR(queryEngine_->init(std::move(ioExecutor), metaClient_.get()));
+
   sessionManager_ = std::make_unique<GraphSessionManager>(metaClient_.get(), hostAddr);
+  // The queued queries of the killed or expired sessions should not run any more
+  sessionManager_->setSessionsRemovedCallback(
+      [engine = queryEngine_.get()](const auto& ids) { engine->removeQueuedQueries(ids); });
   auto initSessionMgrStatus = sessionManager_->init();
   if (!initSessionMgrStatus.ok()) {
     LOG(ERROR) << "Failed to initialize session manager: " << initSessionMgrStatus.toString();
     return Status::Error("Failed to initialize session manager: %s",
                          initSessionMgrStatus.toString().c_str());
   }
-
-  queryEngine_ = std::make_unique<QueryEngine>();
-  return queryEngine_->init(std::move(ioExecutor), metaClient_.get());
+  return Status::OK();
 }
 
 folly::Future<AuthResponse> GraphService::future_authenticate(const std::string& username,
@@ -203,6 +207,87 @@ folly::Future<ExecutionResponse> GraphService::future_execute(int64_t sessionId,
   return future_executeWithParameter(sessionId, query, std::unordered_map<std::string, Value>{});
 }
 
+folly::Future<ExecutionResponse> GraphService::future_batchInsert(
+    const cpp2::BatchInsertRequest& req) {
+  auto ctx = std::make_unique<RequestContext<ExecutionResponse>>();
+  ctx->setRunner(getThreadManager());
+  ctx->setSessionMgr(sessionManager_.get());
+  auto future = ctx->future();
+  auto sessionId = req.get_session_id();
+  if (sessionId == 0) {
+    ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+    ctx->resp().errorMsg = std::make_unique<std::string>("Invalid session id");
+    ctx->finish();
+    return future;
+  }
+  // The session is checked before any schema work. A cached session lets the request be converted
+  // at once, otherwise the request is copied to outlive the lookup in metad.
+  auto session = sessionManager_->findSessionFromCache(sessionId);
+  if (session != nullptr) {
+    batchInsert(std::move(ctx), std::move(session), req);
+    return future;
+  }
+  auto cb = [this, sessionId, ctx = std::move(ctx), req](
+                StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
+    if (!ret.ok() || ret.value() == nullptr) {
+      LOG(ERROR) << "Get session for sessionId: " << sessionId << " failed";
+      ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+      ctx->resp().errorMsg.reset(
+          new std::string(folly::stringPrintf("SessionId[%ld] does not exist", sessionId)));
+      return ctx->finish();
+    }
+    batchInsert(std::move(ctx), std::move(ret).value(), req);
+  };
+  sessionManager_->findSession(sessionId, getThreadManager()).thenValue(std::move(cb));
+  return future;
+}
+
+void GraphService::batchInsert(std::unique_ptr<RequestContext<ExecutionResponse>> ctx,
+                               std::shared_ptr<ClientSession> session,
+                               const cpp2::BatchInsertRequest& req) {
+  stats::StatsManager::addValue(kNumQueries);
+  ctx->setSession(std::move(session));
+  auto batch = queryEngine_->prepareBatchInsert(req);
+  if (!batch.ok()) {
+    return QueryEngine::finishWithStatus(ctx.get(), batch.status());
+  }
+  queryEngine_->batchInsert(std::move(ctx), std::move(batch).value());
+}
+
+folly::Future<cpp2::ExecutionPage> GraphService::future_executeWithPaging(
+    int64_t sessionId,
+    const std::string& query,
+    const std::unordered_map<std::string, Value>& parameterMap,
+    int32_t pageSize) {
+  auto* pager = sessionManager_->resultPager();
+  // Fail fast before executing the query if the session has too many paged results
+  if (!pager->canOpen(sessionId)) {
+    cpp2::ExecutionPage page;
+    page.result_id_ref() = 0;
+    page.response_ref()->errorCode = ErrorCode::E_EXECUTION_ERROR;
+    page.response_ref()->errorMsg = std::make_unique<std::string>(
+        "Too many paged results of the session, please fetch or close them");
+    return folly::makeFuture<cpp2::ExecutionPage>(std::move(page));
+  }
+  return future_executeWithParameter(sessionId, query, parameterMap)
+      .thenValue([pager, sessionId, pageSize](ExecutionResponse&& resp) {
+        return pager->open(sessionId, std::move(resp), pageSize);
+      });
+}
+
+folly::Future<cpp2::ExecutionPage> GraphService::future_fetchNextPage(int64_t sessionId,
+                                                                      int64_t resultId) {
+  time::Duration duration;
+  auto page = sessionManager_->resultPager()->fetchNextPage(sessionId, resultId);
+  page.response_ref()->latencyInUs = duration.elapsedInUSec();
+  return folly::makeFuture<cpp2::ExecutionPage>(std::move(page));
+}
+
+void GraphService::closePagedResult(int64_t sessionId, int64_t resultId) {
+  VLOG(2) << "Close paged result " << resultId << " of session " << sessionId;
+  sessionManager_->resultPager()->close(sessionId, resultId);
+}
+
 folly::Future<std::string> GraphService::future_executeJson(int64_t sessionId,
                                                             const std::string& query) {
   return future_executeJsonWithParameter(
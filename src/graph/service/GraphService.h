@@ -51,13 +51,34 @@ class GraphService final : public cpp2::GraphServiceSvIf {
   folly::Future<cpp2::VerifyClientVersionResp> future_verifyClientVersion(
       const cpp2::VerifyClientVersionReq& req) override;
 
+  folly::Future<ExecutionResponse> future_batchInsert(
+      const cpp2::BatchInsertRequest& req) override;
+
+  folly::Future<cpp2::ExecutionPage> future_executeWithPaging(
+      int64_t sessionId,
+      const std::string& stmt,
+      const std::unordered_map<std::string, Value>& parameterMap,
+      int32_t pageSize) override;
+
+  folly::Future<cpp2::ExecutionPage> future_fetchNextPage(int64_t sessionId,
+                                                          int64_t resultId) override;
+
+  void closePagedResult(int64_t sessionId, int64_t resultId) override;
+
   std::unique_ptr<meta::MetaClient> metaClient_;
 
  private:
   Status auth(const std::string& username, const std::string& password);
 
-  std::unique_ptr<GraphSessionManager> sessionManager_;
+  // Convert the request of a valid session and write it to storage
+  void batchInsert(std::unique_ptr<RequestContext<ExecutionResponse>> ctx,
+                   std::shared_ptr<ClientSession> session,
+                   const cpp2::BatchInsertRequest& req);
+
+  // The query engine outlives the session manager, whose background thread removes the queued
+  // queries of the expired sessions from the engine
   std::unique_ptr<QueryEngine> queryEngine_;
+  std::unique_ptr<GraphSessionManager> sessionManager_;
 };
 
 }  // namespace graph
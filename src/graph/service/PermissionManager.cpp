@@ -200,6 +200,23 @@ Status PermissionManager::canWriteRole(ClientSession *session,
   return Status::PermissionError("No permission to write data.");
 }
 
+/* static */ Status PermissionManager::canWriteData(ClientSession *session, GraphSpaceID space) {
+  if (!FLAGS_enable_authorize) {
+    return Status::OK();
+  }
+  if (session->isGod()) {
+    return Status::OK();
+  }
+  auto roleResult = session->roleWithSpace(space);
+  if (!roleResult.ok()) {
+    return Status::PermissionError("No permission to write data.");
+  }
+  if (roleResult.value() == meta::cpp2::RoleType::GUEST) {
+    return Status::PermissionError("No permission to write data.");
+  }
+  return Status::OK();
+}
+
 StatusOr<meta::cpp2::RoleType> PermissionManager::checkRoleWithSpace(ClientSession *session,
                                                                      ValidateContext *vctx) {
   if (!vctx->spaceChosen()) {
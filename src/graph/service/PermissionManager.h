@@ -31,6 +31,8 @@ class PermissionManager final {
                              GraphSpaceID spaceId,
                              const std::string &targetUser);
   static Status canWriteData(ClientSession *session, ValidateContext *vctx);
+  // The same as above, for the requests which name the space explicitly.
+  static Status canWriteData(ClientSession *session, GraphSpaceID space);
 
  private:
   static StatusOr<meta::cpp2::RoleType> checkRoleWithSpace(ClientSession *session,
@@ -13,7 +13,9 @@
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/PlannersRegister.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/service/PermissionManager.h"
 #include "graph/service/QueryInstance.h"
+#include "graph/util/SchemaUtil.h"
 #include "version/Version.h"
 
 DECLARE_bool(local_config);
@@ -21,6 +23,9 @@ DECLARE_bool(enable_optimizer);
 DECLARE_string(meta_server_addrs);
 DEFINE_int32(check_memory_interval_in_secs, 1, "Memory check interval in seconds");
 
+// The session config to assign the queries of a session to a resource group
+static const char* kResourceGroupConfig = "resource_group";
+
 namespace nebula {
 namespace graph {
 
@@ -42,21 +47,150 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
 
+  resourceGroupManager_ = std::make_unique<ResourceGroupManager>();
+  NG_RETURN_IF_ERROR(resourceGroupManager_->init());
+
   return setupMemoryMonitorThread();
 }
 
-// Create query context and query instance and execute it
 void QueryEngine::execute(RequestContextPtr rctx) {
+  admit(std::move(rctx), [this](RequestContextPtr ctx, ResourceGroup* group) {
+    runQuery(std::move(ctx), group);
+  });
+}
+
+// Find the resource group of the request, and run it once the group admits it
+void QueryEngine::admit(RequestContextPtr rctx, RunCallback run) {
+  if (!resourceGroupManager_->enabled()) {
+    run(std::move(rctx), nullptr);
+    return;
+  }
+
+  auto* session = rctx->session();
+  auto sessionGroup = session->getConfig(kResourceGroupConfig);
+  auto* group = resourceGroupManager_->resolve(rctx->query(),
+                                               sessionGroup.isStr() ? sessionGroup.getStr() : "",
+                                               session->user(),
+                                               session->isGod());
+  auto admission = group->admit(session->id());
+  if (!admission.ok()) {
+    LOG(WARNING) << admission.status() << ", query: " << rctx->query();
+    rctx->resp().errorCode = ErrorCode::E_EXECUTION_ERROR;
+    rctx->resp().errorMsg = std::make_unique<std::string>(admission.status().toString());
+    rctx->resp().latencyInUs = rctx->duration().elapsedInUSec();
+    rctx->finish();
+    return;
+  }
+  if (group->runner() != nullptr) {
+    rctx->setRunner(group->runner());
+  }
+
+  auto future = std::move(admission).value();
+  if (future.isReady() && group->runner() == nullptr) {
+    run(std::move(rctx), group);
+    return;
+  }
+  auto* runner = rctx->runner();
+  std::move(future).via(runner).thenTry(
+      [group, run = std::move(run), rctx = std::move(rctx)](folly::Try<folly::Unit>&& t) mutable {
+        if (t.hasException()) {
+          // The session is killed or expired while the query is queued
+          rctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+          rctx->resp().errorMsg = std::make_unique<std::string>(t.exception().what().toStdString());
+          rctx->resp().latencyInUs = rctx->duration().elapsedInUSec();
+          rctx->finish();
+          return;
+        }
+        run(std::move(rctx), group);
+      });
+}
+
+void QueryEngine::removeQueuedQueries(const std::vector<SessionID>& ids) {
+  if (resourceGroupManager_ != nullptr) {
+    resourceGroupManager_->removeSessions(ids);
+  }
+}
+
+// Create query context and query instance and execute it
+void QueryEngine::runQuery(RequestContextPtr rctx, ResourceGroup* group) {
   auto qctx = std::make_unique<QueryContext>(std::move(rctx),
                                              schemaManager_.get(),
                                              indexManager_.get(),
                                              storage_.get(),
                                              metaClient_,
                                              charsetInfo_);
-  auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
+  auto* instance = new QueryInstance(std::move(qctx), optimizer_.get(), group);
   instance->execute();
 }
 
+StatusOr<BatchInserter::Batch> QueryEngine::prepareBatchInsert(
+    const cpp2::BatchInsertRequest& req) {
+  auto spaceRet = schemaManager_->toGraphSpaceID(req.get_space_name());
+  if (!spaceRet.ok()) {
+    return Status::SemanticError("Space `%s' not found", req.get_space_name().c_str());
+  }
+  auto space = spaceRet.value();
+  auto vidTypeRet = schemaManager_->getSpaceVidType(space);
+  NG_RETURN_IF_ERROR(vidTypeRet);
+  auto vidType = SchemaUtil::propTypeToValueType(vidTypeRet.value());
+  return BatchInserter::prepare(schemaManager_.get(), space, vidType, req);
+}
+
+void QueryEngine::batchInsert(RequestContextPtr rctx, BatchInserter::Batch batch) {
+  auto status = PermissionManager::canWriteData(rctx->session(), batch.space);
+  if (!status.ok()) {
+    finishWithStatus(rctx.get(), status);
+    return;
+  }
+  admit(std::move(rctx),
+        [this, batch = std::move(batch)](RequestContextPtr ctx, ResourceGroup* group) mutable {
+          runBatchInsert(std::move(ctx), std::move(batch), group);
+        });
+}
+
+void QueryEngine::runBatchInsert(RequestContextPtr rctx,
+                                 BatchInserter::Batch batch,
+                                 ResourceGroup* group) {
+  auto* runner = rctx->runner();
+  auto sessionId = rctx->session()->id();
+  BatchInserter::insert(storage_.get(), sessionId, std::move(batch), runner)
+      .thenTry([group, rctx = std::move(rctx)](folly::Try<Status>&& result) {
+        if (result.hasException()) {
+          LOG(ERROR) << "Batch insert failed: " << result.exception().what();
+          finishWithStatus(rctx.get(), Status::Error("%s", result.exception().what().c_str()));
+        } else {
+          finishWithStatus(rctx.get(), result.value());
+        }
+        if (group != nullptr) {
+          group->release(rctx->resp().latencyInUs);
+        }
+      });
+}
+
+// static
+void QueryEngine::finishWithStatus(RequestContext<ExecutionResponse>* rctx,
+                                   const Status& status) {
+  switch (status.code()) {
+    case Status::Code::kOk:
+      rctx->resp().errorCode = ErrorCode::SUCCEEDED;
+      break;
+    case Status::Code::kSemanticError:
+      rctx->resp().errorCode = ErrorCode::E_SEMANTIC_ERROR;
+      break;
+    case Status::Code::kPermissionError:
+      rctx->resp().errorCode = ErrorCode::E_BAD_PERMISSION;
+      break;
+    default:
+      rctx->resp().errorCode = ErrorCode::E_EXECUTION_ERROR;
+      break;
+  }
+  if (!status.ok()) {
+    rctx->resp().errorMsg = std::make_unique<std::string>(status.toString());
+  }
+  rctx->resp().latencyInUs = rctx->duration().elapsedInUSec();
+  rctx->finish();
+}
+
 Status QueryEngine::setupMemoryMonitorThread() {
   memoryMonitorThread_ = std::make_unique<thread::GenericWorker>();
   if (!memoryMonitorThread_ || !memoryMonitorThread_->start("graph-memory-monitor")) {
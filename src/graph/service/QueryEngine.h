@@ -6,6 +6,7 @@
 #ifndef GRAPH_SERVICE_QUERYENGINE_H_
 #define GRAPH_SERVICE_QUERYENGINE_H_
 
+#include <folly/Function.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 
 #include <boost/core/noncopyable.hpp>
@@ -18,6 +19,8 @@
 #include "common/meta/SchemaManager.h"
 #include "common/network/NetworkUtils.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/scheduler/ResourceGroup.h"
+#include "graph/service/BatchInserter.h"
 #include "graph/service/RequestContext.h"
 #include "interface/gen-cpp2/GraphService.h"
 
@@ -40,6 +43,18 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
   using RequestContextPtr = std::unique_ptr<RequestContext<ExecutionResponse>>;
   void execute(RequestContextPtr rctx);
 
+  // Remove the queries of the sessions which are waiting in the resource groups.
+  void removeQueuedQueries(const std::vector<SessionID>& ids);
+
+  // Check the batch insert request against the schemas, before the session is looked up.
+  StatusOr<BatchInserter::Batch> prepareBatchInsert(const cpp2::BatchInsertRequest& req);
+
+  // Write the prepared batch once the resource group of the session admits it, as a query.
+  void batchInsert(RequestContextPtr rctx, BatchInserter::Batch batch);
+
+  // Fill the error code and message of the response by status, and finish the request.
+  static void finishWithStatus(RequestContext<ExecutionResponse>* rctx, const Status& status);
+
   meta::MetaClient* metaClient() {
     return metaClient_;
   }
@@ -47,10 +62,18 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
  private:
   Status setupMemoryMonitorThread();
 
+  using RunCallback = folly::Function<void(RequestContextPtr, ResourceGroup*)>;
+  void admit(RequestContextPtr rctx, RunCallback run);
+
+  void runQuery(RequestContextPtr rctx, ResourceGroup* group);
+
+  void runBatchInsert(RequestContextPtr rctx, BatchInserter::Batch batch, ResourceGroup* group);
+
   std::unique_ptr<meta::SchemaManager> schemaManager_;
   std::unique_ptr<meta::IndexManager> indexManager_;
   std::unique_ptr<storage::StorageClient> storage_;
   std::unique_ptr<opt::Optimizer> optimizer_;
+  std::unique_ptr<ResourceGroupManager> resourceGroupManager_;
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
@@ -29,9 +29,12 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
-QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
+QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx,
+                             Optimizer *optimizer,
+                             ResourceGroup *group) {
   qctx_ = std::move(qctx);
   optimizer_ = DCHECK_NOTNULL(optimizer);
+  group_ = group;
   scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
   qctx_->rctx()->session()->addQuery(qctx_.get());
 }
@@ -138,6 +141,7 @@ void QueryInstance::onFinish() {
 
   rctx->session()->deleteQuery(qctx_.get());
   scheduler_->waitFinish();
+  releaseResourceGroup(latency);
   // The `QueryInstance' is the root node holding all resources during the
   // execution. When the whole query process is done, it's safe to release this
   // object, as long as no other contexts have chances to access these resources
@@ -208,6 +212,7 @@ void QueryInstance::onError(Status status) {
   addSlowQueryStats(latency, spaceName);
   rctx->session()->deleteQuery(qctx_.get());
   rctx->finish();
+  releaseResourceGroup(latency);
   delete this;
 }
 
@@ -230,6 +235,13 @@ void QueryInstance::addSlowQueryStats(uint64_t latency, const std::string &space
   }
 }
 
+void QueryInstance::releaseResourceGroup(uint64_t latency) {
+  if (group_ != nullptr) {
+    group_->release(latency);
+    group_ = nullptr;
+  }
+}
+
 // Get result from query context and fill the response
 void QueryInstance::fillRespData(ExecutionResponse *resp) {
   auto ectx = DCHECK_NOTNULL(qctx_->ectx());
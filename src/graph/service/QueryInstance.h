@@ -12,6 +12,7 @@
 #include "common/cpp/helpers.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/Optimizer.h"
+#include "graph/scheduler/ResourceGroup.h"
 #include "graph/scheduler/Scheduler.h"
 #include "parser/GQLParser.h"
 
@@ -26,7 +27,10 @@ namespace graph {
 
 class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
  public:
-  QueryInstance(std::unique_ptr<QueryContext> qctx, opt::Optimizer* optimizer);
+  // The slot taken in the resource group, if any, is released when the query is done.
+  QueryInstance(std::unique_ptr<QueryContext> qctx,
+                opt::Optimizer* optimizer,
+                ResourceGroup* group = nullptr);
   ~QueryInstance() = default;
 
   // Entrance of the Validate, Optimize, Schedule, Execute process
@@ -57,11 +61,13 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   void addSlowQueryStats(uint64_t latency, const std::string& spaceName) const;
   void fillRespData(ExecutionResponse* resp);
   Status findBestPlan();
+  void releaseResourceGroup(uint64_t latency);
 
   std::unique_ptr<Sentence> sentence_;
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
+  ResourceGroup* group_{nullptr};
 };
 
 }  // namespace graph
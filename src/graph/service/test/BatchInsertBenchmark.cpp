@@ -0,0 +1,113 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "common/base/Base.h"
+#include "graph/context/QueryContext.h"
+#include "graph/service/BatchInserter.h"
+#include "graph/validator/Validator.h"
+#include "graph/validator/test/MockSchemaManager.h"
+#include "parser/GQLParser.h"
+
+DEFINE_uint32(batch_insert_rows, 1000, "Number of edges inserted in each iteration");
+
+// Compare the cost before the requests are sent to storage of an INSERT EDGE statement and of
+// the BatchInsertRequest with the same edges.
+
+namespace nebula {
+namespace graph {
+
+static std::shared_ptr<ClientSession> makeSession() {
+  meta::cpp2::Session session;
+  session.session_id_ref() = 0;
+  session.user_name_ref() = "root";
+  auto clientSession = ClientSession::create(std::move(session), nullptr);
+  SpaceInfo spaceInfo;
+  spaceInfo.name = "test_space";
+  spaceInfo.id = 1;
+  spaceInfo.spaceDesc.space_name_ref() = "test_space";
+  clientSession->setSpace(std::move(spaceInfo));
+  return clientSession;
+}
+
+static std::string insertStatement(size_t rows) {
+  std::string stmt = "INSERT EDGE like(start, end, likeness) VALUES ";
+  for (size_t i = 0; i < rows; ++i) {
+    if (i != 0) {
+      stmt += ", ";
+    }
+    stmt += folly::stringPrintf("\"%lu\"->\"%lu\":(%lu, %lu, %lu)", i, i + 1, i, i + 1, i % 100);
+  }
+  return stmt;
+}
+
+static cpp2::BatchInsertRequest insertRequest(size_t rows) {
+  cpp2::EdgeBatch edges;
+  edges.edge_name_ref() = "like";
+  edges.prop_names_ref() = {"start", "end", "likeness"};
+  edges.prop_columns_ref()->resize(3);
+  for (size_t i = 0; i < rows; ++i) {
+    edges.src_ids_ref()->emplace_back(std::to_string(i));
+    edges.dst_ids_ref()->emplace_back(std::to_string(i + 1));
+    auto& columns = *edges.prop_columns_ref();
+    columns[0].emplace_back(static_cast<int64_t>(i));
+    columns[1].emplace_back(static_cast<int64_t>(i + 1));
+    columns[2].emplace_back(static_cast<int64_t>(i % 100));
+  }
+  cpp2::BatchInsertRequest req;
+  req.space_name_ref() = "test_space";
+  req.edges_ref() = {std::move(edges)};
+  return req;
+}
+
+BENCHMARK(InsertStatement, iters) {
+  std::string stmt;
+  std::unique_ptr<MockSchemaManager> schemaMng;
+  std::shared_ptr<ClientSession> session;
+  BENCHMARK_SUSPEND {
+    stmt = insertStatement(FLAGS_batch_insert_rows);
+    schemaMng = MockSchemaManager::makeUnique();
+    session = makeSession();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto rctx = std::make_unique<RequestContext<ExecutionResponse>>();
+    rctx->setSession(session);
+    auto qctx = std::make_unique<QueryContext>();
+    qctx->setRCtx(std::move(rctx));
+    qctx->setSchemaManager(schemaMng.get());
+    qctx->setCharsetInfo(CharsetInfo::instance());
+    auto result = GQLParser(qctx.get()).parse(stmt);
+    CHECK(result.ok()) << result.status();
+    auto sentences = std::move(result).value();
+    auto status = Validator::validate(sentences.get(), qctx.get());
+    CHECK(status.ok()) << status;
+    folly::doNotOptimizeAway(qctx);
+  }
+}
+
+BENCHMARK_RELATIVE(BatchInsertRequest, iters) {
+  cpp2::BatchInsertRequest req;
+  std::unique_ptr<MockSchemaManager> schemaMng;
+  BENCHMARK_SUSPEND {
+    req = insertRequest(FLAGS_batch_insert_rows);
+    schemaMng = MockSchemaManager::makeUnique();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto batch = BatchInserter::prepare(schemaMng.get(), 1, Value::Type::STRING, req);
+    CHECK(batch.ok()) << batch.status();
+    folly::doNotOptimizeAway(batch);
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  folly::runBenchmarks();
+  return 0;
+}
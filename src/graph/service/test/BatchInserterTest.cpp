@@ -0,0 +1,191 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/service/BatchInserter.h"
+#include "graph/validator/test/MockSchemaManager.h"
+
+namespace nebula {
+namespace graph {
+
+class BatchInserterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schemaMng_ = MockSchemaManager::makeUnique();
+  }
+
+  StatusOr<BatchInserter::Batch> prepare(const cpp2::BatchInsertRequest& req) {
+    return BatchInserter::prepare(schemaMng_.get(), 1, Value::Type::STRING, req);
+  }
+
+  static cpp2::VertexBatch persons(std::vector<Value> vids,
+                                   std::vector<std::string> propNames,
+                                   std::vector<std::vector<Value>> columns) {
+    cpp2::VertexBatch batch;
+    batch.tag_name_ref() = "person";
+    batch.vids_ref() = std::move(vids);
+    batch.prop_names_ref() = std::move(propNames);
+    batch.prop_columns_ref() = std::move(columns);
+    return batch;
+  }
+
+  static cpp2::EdgeBatch likes(std::vector<std::string> propNames,
+                               std::vector<std::vector<Value>> columns) {
+    cpp2::EdgeBatch batch;
+    batch.edge_name_ref() = "like";
+    batch.src_ids_ref() = {"Tim", "Tony"};
+    batch.dst_ids_ref() = {"Tony", "Manu"};
+    batch.prop_names_ref() = std::move(propNames);
+    batch.prop_columns_ref() = std::move(columns);
+    return batch;
+  }
+
+ protected:
+  std::unique_ptr<MockSchemaManager> schemaMng_;
+};
+
+TEST_F(BatchInserterTest, Vertices) {
+  {
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({"Tim", "Tony"}, {}, {{"Tim", "Tony"}, {42, 38}})};
+    auto result = prepare(req);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto batch = std::move(result).value();
+    ASSERT_EQ(2, batch.vertices.size());
+    EXPECT_EQ(Value("Tony"), *batch.vertices[1].id_ref());
+    const auto& tag = batch.vertices[1].tags_ref()->front();
+    EXPECT_EQ(2, *tag.tag_id_ref());
+    EXPECT_EQ((std::vector<Value>{"Tony", 38}), *tag.props_ref());
+    EXPECT_EQ((std::vector<std::string>{"name", "age"}), batch.tagPropNames[2]);
+  }
+  {
+    // Properties given partially
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({"Tim"}, {"age"}, {{42}})};
+    auto result = prepare(req);
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(std::vector<std::string>{"age"}, result.value().tagPropNames[2]);
+  }
+  {
+    // Unknown tag
+    cpp2::BatchInsertRequest req;
+    auto vertices = persons({"Tim"}, {}, {{"Tim"}, {42}});
+    vertices.tag_name_ref() = "player";
+    req.vertices_ref() = {std::move(vertices)};
+    auto result = prepare(req);
+    ASSERT_FALSE(result.ok());
+    EXPECT_TRUE(result.status().isSemanticError());
+  }
+  {
+    // Null value of not nullable property
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({"Tim", "Tony"}, {}, {{"Tim", "Tony"}, {42, Value::kNullValue}})};
+    auto result = prepare(req);
+    ASSERT_FALSE(result.ok());
+    EXPECT_TRUE(result.status().isSemanticError());
+  }
+  {
+    // Unknown property
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({"Tim"}, {"height"}, {{2.11}})};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+  {
+    // Missing values
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({"Tim", "Tony"}, {}, {{"Tim", "Tony"}, {42}})};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+  {
+    // Wrong vid type
+    cpp2::BatchInsertRequest req;
+    req.vertices_ref() = {persons({1}, {}, {{"Tim"}, {42}})};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+}
+
+TEST_F(BatchInserterTest, Edges) {
+  {
+    cpp2::BatchInsertRequest req;
+    req.edges_ref() = {likes({}, {{2000, 2001}, {2010, 2011}, {90, 80}})};
+    auto result = prepare(req);
+    ASSERT_TRUE(result.ok()) << result.status();
+    auto batch = std::move(result).value();
+    ASSERT_EQ(1, batch.edgeBatches.size());
+    const auto& edges = batch.edgeBatches.front();
+    EXPECT_EQ((std::vector<std::string>{"start", "end", "likeness"}), edges.propNames);
+    // Both the outbound and inbound edges
+    ASSERT_EQ(4, edges.edges.size());
+    const auto& out = *edges.edges[2].key_ref();
+    EXPECT_EQ(Value("Tony"), *out.src_ref());
+    EXPECT_EQ(Value("Manu"), *out.dst_ref());
+    EXPECT_EQ(3, *out.edge_type_ref());
+    EXPECT_EQ(0, *out.ranking_ref());
+    const auto& in = *edges.edges[3].key_ref();
+    EXPECT_EQ(Value("Manu"), *in.src_ref());
+    EXPECT_EQ(Value("Tony"), *in.dst_ref());
+    EXPECT_EQ(-3, *in.edge_type_ref());
+    EXPECT_EQ((std::vector<Value>{2001, 2011, 80}), *edges.edges[3].props_ref());
+  }
+  {
+    // Properties in another order
+    cpp2::BatchInsertRequest req;
+    auto edges = likes({"likeness", "end", "start"}, {{90, 80}, {2010, 2011}, {2000, 2001}});
+    edges.ranks_ref() = {1, 2};
+    req.edges_ref() = {std::move(edges)};
+    auto result = prepare(req);
+    ASSERT_TRUE(result.ok()) << result.status();
+    const auto& edge = result.value().edgeBatches.front().edges[0];
+    EXPECT_EQ(1, *edge.key_ref()->ranking_ref());
+    EXPECT_EQ((std::vector<Value>{2000, 2010, 90}), *edge.props_ref());
+  }
+  {
+    // Not nullable property without default value
+    cpp2::BatchInsertRequest req;
+    req.edges_ref() = {likes({"start", "end"}, {{2000, 2001}, {2010, 2011}})};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+  {
+    // Null value of not nullable property
+    cpp2::BatchInsertRequest req;
+    req.edges_ref() = {likes({}, {{2000, 2001}, {2010, 2011}, {90, Value::kNullValue}})};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+  {
+    // Unknown edge type
+    cpp2::BatchInsertRequest req;
+    auto edges = likes({}, {{2000, 2001}, {2010, 2011}, {90, 80}});
+    edges.edge_name_ref() = "follow";
+    req.edges_ref() = {std::move(edges)};
+    auto result = prepare(req);
+    ASSERT_FALSE(result.ok());
+    EXPECT_TRUE(result.status().isSemanticError());
+  }
+  {
+    // Ranks not matched
+    cpp2::BatchInsertRequest req;
+    auto edges = likes({}, {{2000, 2001}, {2010, 2011}, {90, 80}});
+    edges.ranks_ref() = {1};
+    req.edges_ref() = {std::move(edges)};
+    EXPECT_FALSE(prepare(req).ok());
+  }
+}
+
+TEST_F(BatchInserterTest, Empty) {
+  cpp2::BatchInsertRequest req;
+  EXPECT_FALSE(prepare(req).ok());
+}
+
+}  // namespace graph
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
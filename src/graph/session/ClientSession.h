@@ -136,6 +136,14 @@ class ClientSession final {
     return session_;
   }
 
+  // Gets a session level config, returns an empty value if it's not set.
+  Value getConfig(const std::string& key) const {
+    folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+    auto& configs = session_.get_configs();
+    auto found = configs.find(key);
+    return found == configs.end() ? Value() : found->second;
+  }
+
   void updateSpaceName(const std::string& spaceName) {
     folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
     session_.space_name_ref() = spaceName;
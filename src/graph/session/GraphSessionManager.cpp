@@ -22,6 +22,14 @@ GraphSessionManager::GraphSessionManager(meta::MetaClient* metaClient, const Hos
       FLAGS_session_reclaim_interval_secs * 1000, &GraphSessionManager::threadFunc, this);
 }
 
+GraphSessionManager::~GraphSessionManager() {
+  if (scavenger_ != nullptr) {
+    scavenger_->stop();
+    scavenger_->wait();
+    scavenger_.reset();
+  }
+}
+
 folly::Future<StatusOr<std::shared_ptr<ClientSession>>> GraphSessionManager::findSession(
     SessionID id, folly::Executor* runner) {
   auto sessionPtr = findSessionFromCache(id);
@@ -177,6 +185,7 @@ int32_t GraphSessionManager::removeMultiSessions(const std::vector<SessionID>& i
 
 void GraphSessionManager::threadFunc() {
   reclaimExpiredSessions();
+  resultPager_.reclaimExpiredResults();
   updateSessionsToMeta();
   scavenger_->addDelayTask(
       FLAGS_session_reclaim_interval_secs * 1000, &GraphSessionManager::threadFunc, this);
@@ -339,6 +348,10 @@ Status GraphSessionManager::init() {
 }
 
 void GraphSessionManager::removeSessionFromLocalCache(const std::vector<SessionID>& ids) {
+  resultPager_.removeSessions(ids);
+  if (sessionsRemovedCallback_) {
+    sessionsRemovedCallback_(ids);
+  }
   for (auto& id : ids) {
     // if the session is not in the current graph, ignore it
     auto iter = activeSessions_.find(id);
@@ -12,6 +12,7 @@
 #include "common/thread/GenericWorker.h"
 #include "common/thrift/ThriftTypes.h"
 #include "graph/session/ClientSession.h"
+#include "graph/session/ResultPager.h"
 #include "interface/gen-cpp2/GraphService.h"
 #include "interface/gen-cpp2/meta_types.h"
 
@@ -35,7 +36,8 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
   // metaClient: The client of the meta server.
   // hostAddr: The address of the current graph server.
   GraphSessionManager(meta::MetaClient* metaClient, const HostAddr& hostAddr);
-  ~GraphSessionManager() {}
+  // The background thread is stopped before the paged results are destroyed.
+  ~GraphSessionManager();
 
   // Pulls sessions from the meta server and chooses its own sessions for management.
   Status init();
@@ -86,6 +88,17 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
   // return: All sessions of the local cache.
   std::vector<meta::cpp2::Session> getSessionFromLocalCache() const;
 
+  // The paged results of the sessions, which are closed when the sessions are removed or expired.
+  ResultPager* resultPager() {
+    return &resultPager_;
+  }
+
+  // Sets the callback invoked with the ids of the sessions removed from the local cache, e.g. to
+  // drop their queued queries. It should be set before the manager serves any request.
+  void setSessionsRemovedCallback(std::function<void(const std::vector<SessionID>&)> cb) {
+    sessionsRemovedCallback_ = std::move(cb);
+  }
+
  private:
   // Finds an existing session only from the meta server.
   // id: The id of the session which will be found.
@@ -95,7 +108,7 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
       SessionID id, folly::Executor* runner);
 
   // Entry function of the background thread.
-  // It will reclaim expired sessions and update sessions info to meta.
+  // It will reclaim expired sessions and paged results, and update sessions info to meta.
   void threadFunc();
 
   // Removes a session from the local cache.
@@ -112,6 +125,9 @@ class GraphSessionManager final : public SessionManager<ClientSession> {
   // Updates session info locally.
   // session: ClientSession which will be updated.
   void updateSessionInfo(ClientSession* session);
+
+  ResultPager resultPager_;
+  std::function<void(const std::vector<SessionID>&)> sessionsRemovedCallback_;
 };
 
 }  // namespace graph
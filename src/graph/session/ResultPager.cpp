@@ -0,0 +1,176 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/session/ResultPager.h"
+
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
+
+#include "common/datatypes/ListOps-inl.h"
+#include "common/time/WallClock.h"
+#include "graph/service/GraphFlags.h"
+
+namespace nebula {
+namespace graph {
+
+cpp2::ExecutionPage ResultPager::open(SessionID sessionId,
+                                     ExecutionResponse&& resp,
+                                     int32_t pageSize) {
+  cpp2::ExecutionPage page;
+  page.result_id_ref() = 0;
+  auto size = static_cast<size_t>(pageSize > 0 ? pageSize
+                                               : std::max(FLAGS_default_result_page_size, 1));
+  if (resp.errorCode != ErrorCode::SUCCEEDED || resp.data == nullptr ||
+      resp.data->rowSize() <= size) {
+    page.response_ref() = std::move(resp);
+    return page;
+  }
+
+  // Measure a row by its size in the response, which is cheap to get and grows with its memory
+  apache::thrift::CompactProtocolWriter writer;
+  std::vector<uint32_t> rowBytes;
+  rowBytes.reserve(resp.data->rowSize());
+  int64_t total = 0;
+  int64_t rest = 0;
+  for (size_t i = 0; i < resp.data->rowSize(); i++) {
+    rowBytes.emplace_back(
+        apache::thrift::Cpp2Ops<Row>::serializedSize(&writer, &resp.data->rows[i]));
+    total += rowBytes.back();
+    if (i >= size) {
+      rest += rowBytes.back();
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(lock_);
+  auto sessionIter = numResultsOfSession_.find(sessionId);
+  auto numResults = sessionIter == numResultsOfSession_.end() ? 0 : sessionIter->second;
+  if (bufferedBytes_ + rest > FLAGS_max_paged_result_bytes ||
+      numResults >= static_cast<size_t>(FLAGS_max_paged_results_per_session)) {
+    // The result is in memory already, return it in one page rather than fail the query
+    LOG(WARNING) << "Return " << resp.data->rowSize() << " rows in one page for session "
+                 << sessionId << ", " << bufferedBytes_ << " bytes are kept by "
+                 << results_.size() << " paged results";
+    page.response_ref() = std::move(resp);
+    return page;
+  }
+  PagedResult result;
+  result.sessionId = sessionId;
+  result.pageSize = size;
+  result.data = std::move(*resp.data);
+  result.rowBytes = std::move(rowBytes);
+  result.restBytes = total;
+  if (resp.spaceName != nullptr) {
+    result.spaceName = std::make_unique<std::string>(*resp.spaceName);
+  }
+  result.accessTime = time::WallClock::fastNowInSec();
+  auto firstPage = nextPage(&result);
+  resp.data = std::move(firstPage.response_ref()->data);
+
+  auto resultId = nextResultId_++;
+  results_.emplace(resultId, std::move(result));
+  numResultsOfSession_[sessionId]++;
+  bufferedBytes_ += rest;
+  page.response_ref() = std::move(resp);
+  page.result_id_ref() = resultId;
+  return page;
+}
+
+cpp2::ExecutionPage ResultPager::fetchNextPage(SessionID sessionId, int64_t resultId) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = results_.find(resultId);
+  if (iter == results_.end() || iter->second.sessionId != sessionId) {
+    cpp2::ExecutionPage page;
+    page.result_id_ref() = 0;
+    page.response_ref()->errorCode = ErrorCode::E_PAGED_RESULT_NOT_FOUND;
+    page.response_ref()->errorMsg = std::make_unique<std::string>(folly::stringPrintf(
+        "Paged result %ld of session %ld does not exist or has expired", resultId, sessionId));
+    return page;
+  }
+  auto& result = iter->second;
+  result.accessTime = time::WallClock::fastNowInSec();
+  auto restBytes = result.restBytes;
+  auto page = nextPage(&result);
+  bufferedBytes_ -= restBytes - result.restBytes;
+  if (result.next < result.data.rowSize()) {
+    page.result_id_ref() = resultId;
+  } else {
+    removeLocked(iter);
+  }
+  return page;
+}
+
+bool ResultPager::canOpen(SessionID sessionId) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = numResultsOfSession_.find(sessionId);
+  return iter == numResultsOfSession_.end() ||
+         iter->second < static_cast<size_t>(FLAGS_max_paged_results_per_session);
+}
+
+void ResultPager::close(SessionID sessionId, int64_t resultId) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = results_.find(resultId);
+  if (iter != results_.end() && iter->second.sessionId == sessionId) {
+    removeLocked(iter);
+  }
+}
+
+void ResultPager::removeSessions(const std::vector<SessionID>& ids) {
+  std::unordered_set<SessionID> sessions(ids.begin(), ids.end());
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto iter = results_.begin(); iter != results_.end();) {
+    auto cur = iter++;
+    if (sessions.count(cur->second.sessionId) > 0) {
+      removeLocked(cur);
+    }
+  }
+}
+
+void ResultPager::reclaimExpiredResults() {
+  auto now = time::WallClock::fastNowInSec();
+  std::lock_guard<std::mutex> guard(lock_);
+  for (auto iter = results_.begin(); iter != results_.end();) {
+    auto cur = iter++;
+    if (now - cur->second.accessTime >= FLAGS_paged_result_idle_timeout_secs) {
+      VLOG(1) << "Paged result " << cur->first << " of session " << cur->second.sessionId
+              << " has expired";
+      removeLocked(cur);
+    }
+  }
+}
+
+int64_t ResultPager::bufferedBytes() const {
+  std::lock_guard<std::mutex> guard(lock_);
+  return bufferedBytes_;
+}
+
+cpp2::ExecutionPage ResultPager::nextPage(PagedResult* result) {
+  auto& rows = result->data.rows;
+  auto end = std::min(result->next + result->pageSize, rows.size());
+  auto data = std::make_unique<DataSet>(result->data.colNames);
+  data->rows.reserve(end - result->next);
+  for (; result->next < end; result->next++) {
+    data->rows.emplace_back(std::move(rows[result->next]));
+    result->restBytes -= result->rowBytes[result->next];
+  }
+  cpp2::ExecutionPage page;
+  page.result_id_ref() = 0;
+  page.response_ref()->errorCode = ErrorCode::SUCCEEDED;
+  page.response_ref()->data = std::move(data);
+  if (result->spaceName != nullptr) {
+    page.response_ref()->spaceName = std::make_unique<std::string>(*result->spaceName);
+  }
+  return page;
+}
+
+void ResultPager::removeLocked(std::unordered_map<int64_t, PagedResult>::iterator iter) {
+  bufferedBytes_ -= iter->second.restBytes;
+  auto sessionIter = numResultsOfSession_.find(iter->second.sessionId);
+  if (sessionIter != numResultsOfSession_.end() && --sessionIter->second == 0) {
+    numResultsOfSession_.erase(sessionIter);
+  }
+  results_.erase(iter);
+}
+
+}  // namespace graph
+}  // namespace nebula
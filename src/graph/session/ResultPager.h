@@ -0,0 +1,84 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SESSION_RESULTPAGER_H_
+#define GRAPH_SESSION_RESULTPAGER_H_
+
+#include "common/base/Base.h"
+#include "common/graph/Response.h"
+#include "common/thrift/ThriftTypes.h"
+#include "interface/gen-cpp2/graph_types.h"
+
+namespace nebula {
+namespace graph {
+
+// ResultPager splits the result of a query into pages. It doesn't stream the result: the query is
+// executed to the end as usual, then the first page is returned and the rest rows are kept in a
+// paged result until they are fetched, the result is closed, the session is removed, or the
+// result is idle for paged_result_idle_timeout_secs.
+//
+// The rows are moved out of the paged result when they are fetched, so the memory is released page
+// by page. The rows kept by all paged results, measured by their bytes in the response, are bounded
+// by max_paged_result_bytes. A result which doesn't fit is returned in one page as execute() does,
+// since it's in memory already.
+class ResultPager final {
+ public:
+  // Returns the first page of the response, and keeps the rest rows in a new paged result.
+  // sessionId: The session which executes the query, only it could fetch the rest pages.
+  // resp: The response of the query.
+  // pageSize: Number of rows of each page, default_result_page_size if not positive.
+  // return: The first page, whose result id is 0 if all rows are in it.
+  cpp2::ExecutionPage open(SessionID sessionId, ExecutionResponse&& resp, int32_t pageSize);
+
+  // Returns the next page of the result, the result is closed if it's the last page.
+  cpp2::ExecutionPage fetchNextPage(SessionID sessionId, int64_t resultId);
+
+  // Whether the session could open a new paged result.
+  bool canOpen(SessionID sessionId) const;
+
+  // Closes a paged result and releases its rows.
+  void close(SessionID sessionId, int64_t resultId);
+
+  // Closes all paged results of the sessions.
+  void removeSessions(const std::vector<SessionID>& ids);
+
+  // Closes the paged results which are idle for paged_result_idle_timeout_secs.
+  void reclaimExpiredResults();
+
+  // Bytes of the rows kept by all paged results.
+  int64_t bufferedBytes() const;
+
+ private:
+  struct PagedResult {
+    SessionID sessionId;
+    size_t pageSize;
+    // The column names and rows of the result, rows before next are fetched already
+    DataSet data;
+    size_t next{0};
+    // Bytes of each row in data, and the sum of them from next
+    std::vector<uint32_t> rowBytes;
+    int64_t restBytes{0};
+    std::unique_ptr<std::string> spaceName;
+    // Last time the result is fetched, in seconds
+    int64_t accessTime;
+  };
+
+  // Moves the next page out of the paged result.
+  static cpp2::ExecutionPage nextPage(PagedResult* result);
+
+  // Removes a paged result with the lock held.
+  void removeLocked(std::unordered_map<int64_t, PagedResult>::iterator iter);
+
+  mutable std::mutex lock_;
+  std::unordered_map<int64_t, PagedResult> results_;
+  std::unordered_map<SessionID, size_t> numResultsOfSession_;
+  int64_t bufferedBytes_{0};
+  int64_t nextResultId_{1};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SESSION_RESULTPAGER_H_
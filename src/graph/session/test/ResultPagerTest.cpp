@@ -0,0 +1,143 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "graph/service/GraphFlags.h"
+#include "graph/session/ResultPager.h"
+
+namespace nebula {
+namespace graph {
+
+// All rows have the same bytes in response, since the ids are small
+static ExecutionResponse makeResponse(int64_t numRows) {
+  ExecutionResponse resp;
+  resp.data = std::make_unique<DataSet>(std::vector<std::string>{"id"});
+  for (int64_t i = 0; i < numRows; i++) {
+    resp.data->rows.emplace_back(Row({i}));
+  }
+  resp.spaceName = std::make_unique<std::string>("test");
+  return resp;
+}
+
+TEST(ResultPagerTest, FetchPages) {
+  ResultPager pager;
+  {
+    // All rows are in the first page, no paged result is opened
+    auto page = pager.open(1, makeResponse(3), 3);
+    EXPECT_EQ(0, page.get_result_id());
+    EXPECT_EQ(3, page.get_response().data->rowSize());
+    EXPECT_EQ(0, pager.bufferedBytes());
+  }
+  {
+    auto page = pager.open(1, makeResponse(10), 4);
+    auto resultId = page.get_result_id();
+    ASSERT_NE(0, resultId);
+    auto rowBytes = pager.bufferedBytes() / 6;
+    ASSERT_LT(0, rowBytes);
+    EXPECT_EQ(6 * rowBytes, pager.bufferedBytes());
+    std::vector<int64_t> ids;
+    while (true) {
+      const auto& resp = page.get_response();
+      ASSERT_EQ(ErrorCode::SUCCEEDED, resp.errorCode);
+      EXPECT_EQ(std::vector<std::string>{"id"}, resp.data->colNames);
+      EXPECT_EQ("test", *resp.spaceName);
+      for (const auto& row : resp.data->rows) {
+        ids.emplace_back(row.values[0].getInt());
+      }
+      if (page.get_result_id() == 0) {
+        break;
+      }
+      page = pager.fetchNextPage(1, resultId);
+      EXPECT_EQ(static_cast<int64_t>(10 - ids.size() - page.get_response().data->rowSize()) *
+                    rowBytes,
+                pager.bufferedBytes());
+    }
+    std::vector<int64_t> expected(10);
+    std::iota(expected.begin(), expected.end(), 0);
+    EXPECT_EQ(expected, ids);
+    EXPECT_EQ(0, pager.bufferedBytes());
+
+    // The paged result is closed after the last page
+    page = pager.fetchNextPage(1, resultId);
+    EXPECT_EQ(ErrorCode::E_PAGED_RESULT_NOT_FOUND, page.get_response().errorCode);
+  }
+  {
+    // Error response is returned as it is
+    ExecutionResponse resp;
+    resp.errorCode = ErrorCode::E_SYNTAX_ERROR;
+    auto page = pager.open(1, std::move(resp), 4);
+    EXPECT_EQ(0, page.get_result_id());
+    EXPECT_EQ(ErrorCode::E_SYNTAX_ERROR, page.get_response().errorCode);
+  }
+}
+
+TEST(ResultPagerTest, Reclaim) {
+  ResultPager pager;
+  auto result1 = pager.open(1, makeResponse(10), 2).get_result_id();
+  auto result2 = pager.open(1, makeResponse(10), 2).get_result_id();
+  auto result3 = pager.open(2, makeResponse(10), 2).get_result_id();
+  auto rowBytes = pager.bufferedBytes() / 24;
+  EXPECT_EQ(24 * rowBytes, pager.bufferedBytes());
+
+  // Only the session which opens the result could fetch it
+  EXPECT_EQ(ErrorCode::E_PAGED_RESULT_NOT_FOUND,
+            pager.fetchNextPage(2, result1).get_response().errorCode);
+
+  pager.close(1, result1);
+  EXPECT_EQ(16 * rowBytes, pager.bufferedBytes());
+  EXPECT_EQ(ErrorCode::E_PAGED_RESULT_NOT_FOUND,
+            pager.fetchNextPage(1, result1).get_response().errorCode);
+
+  pager.removeSessions({1});
+  EXPECT_EQ(8 * rowBytes, pager.bufferedBytes());
+  EXPECT_EQ(ErrorCode::E_PAGED_RESULT_NOT_FOUND,
+            pager.fetchNextPage(1, result2).get_response().errorCode);
+
+  auto timeout = FLAGS_paged_result_idle_timeout_secs;
+  FLAGS_paged_result_idle_timeout_secs = 0;
+  pager.reclaimExpiredResults();
+  FLAGS_paged_result_idle_timeout_secs = timeout;
+  EXPECT_EQ(0, pager.bufferedBytes());
+  EXPECT_EQ(ErrorCode::E_PAGED_RESULT_NOT_FOUND,
+            pager.fetchNextPage(2, result3).get_response().errorCode);
+}
+
+TEST(ResultPagerTest, BufferLimit) {
+  ResultPager pager;
+  auto maxBytes = FLAGS_max_paged_result_bytes;
+  auto maxResults = FLAGS_max_paged_results_per_session;
+  FLAGS_max_paged_results_per_session = 2;
+
+  auto page = pager.open(1, makeResponse(10), 2);
+  EXPECT_NE(0, page.get_result_id());
+  auto rowBytes = pager.bufferedBytes() / 8;
+  // The buffer could keep 10 rows
+  FLAGS_max_paged_result_bytes = 10 * rowBytes;
+  EXPECT_TRUE(pager.canOpen(1));
+  // 8 rows are buffered, the rest of the buffer is not enough, all rows are in one page
+  page = pager.open(1, makeResponse(10), 2);
+  EXPECT_EQ(0, page.get_result_id());
+  EXPECT_EQ(ErrorCode::SUCCEEDED, page.get_response().errorCode);
+  EXPECT_EQ(10, page.get_response().data->rowSize());
+  EXPECT_EQ(8 * rowBytes, pager.bufferedBytes());
+
+  page = pager.open(1, makeResponse(3), 2);
+  EXPECT_NE(0, page.get_result_id());
+  EXPECT_EQ(9 * rowBytes, pager.bufferedBytes());
+  // Too many paged results of session 1
+  EXPECT_FALSE(pager.canOpen(1));
+  // The buffer is full, but the queries still run
+  FLAGS_max_paged_result_bytes = rowBytes;
+  EXPECT_TRUE(pager.canOpen(2));
+
+  FLAGS_max_paged_result_bytes = maxBytes;
+  FLAGS_max_paged_results_per_session = maxResults;
+}
+
+}  // namespace graph
+}  // namespace nebula
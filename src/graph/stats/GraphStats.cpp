@@ -30,10 +30,20 @@ stats::CounterId kNumQueriesHitMemoryWatermark;
 
 stats::CounterId kOptimizerLatencyUs;
 
+stats::CounterId kNumResourceGroupQueuedQueries;
+stats::CounterId kNumResourceGroupRejectedQueries;
+stats::CounterId kResourceGroupQueueLatencyUs;
+stats::CounterId kResourceGroupQueryLatencyUs;
+
 stats::CounterId kNumAggregateExecutors;
 stats::CounterId kNumSortExecutors;
 stats::CounterId kNumIndexScanExecutors;
 
+stats::CounterId kGCReclaimedBytes;
+stats::CounterId kGCPendingBytes;
+stats::CounterId kGCLagUs;
+stats::CounterId kNumGCInlineReleases;
+
 stats::CounterId kNumOpenedSessions;
 stats::CounterId kNumAuthFailedSessions;
 stats::CounterId kNumAuthFailedSessionsBadUserNamePassword;
@@ -60,12 +70,28 @@ void initGraphStats() {
   kOptimizerLatencyUs = stats::StatsManager::registerHisto(
       "optimizer_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
 
+  kNumResourceGroupQueuedQueries =
+      stats::StatsManager::registerStats("num_resource_group_queued_queries", "sum");
+  kNumResourceGroupRejectedQueries =
+      stats::StatsManager::registerStats("num_resource_group_rejected_queries", "rate, sum");
+  kResourceGroupQueueLatencyUs = stats::StatsManager::registerHisto(
+      "resource_group_queue_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+  kResourceGroupQueryLatencyUs = stats::StatsManager::registerHisto(
+      "resource_group_query_latency_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+
   kNumAggregateExecutors =
       stats::StatsManager::registerStats("num_aggregate_executors", "rate, sum");
   kNumSortExecutors = stats::StatsManager::registerStats("num_sort_executors", "rate, sum");
   kNumIndexScanExecutors =
       stats::StatsManager::registerStats("num_indexscan_executors", "rate, sum");
 
+  kGCReclaimedBytes = stats::StatsManager::registerStats("gc_reclaimed_bytes", "rate, sum");
+  kGCPendingBytes = stats::StatsManager::registerStats("gc_pending_bytes", "sum");
+  kGCLagUs =
+      stats::StatsManager::registerHisto("gc_lag_us", 1000, 0, 2000, "avg, p75, p95, p99, p999");
+  kNumGCInlineReleases =
+      stats::StatsManager::registerStats("num_gc_inline_releases", "rate, sum");
+
   kNumOpenedSessions = stats::StatsManager::registerStats("num_opened_sessions", "rate, sum");
   kNumAuthFailedSessions =
       stats::StatsManager::registerStats("num_auth_failed_sessions", "rate, sum");
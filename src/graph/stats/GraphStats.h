@@ -30,11 +30,23 @@ extern stats::CounterId kNumQueriesHitMemoryWatermark;
 
 extern stats::CounterId kOptimizerLatencyUs;
 
+// Resource group, labeled with the group name
+extern stats::CounterId kNumResourceGroupQueuedQueries;
+extern stats::CounterId kNumResourceGroupRejectedQueries;
+extern stats::CounterId kResourceGroupQueueLatencyUs;
+extern stats::CounterId kResourceGroupQueryLatencyUs;
+
 // Executor
 extern stats::CounterId kNumAggregateExecutors;
 extern stats::CounterId kNumSortExecutors;
 extern stats::CounterId kNumIndexScanExecutors;
 
+// Async GC of the intermediate results, in estimated bytes
+extern stats::CounterId kGCReclaimedBytes;
+extern stats::CounterId kGCPendingBytes;
+extern stats::CounterId kGCLagUs;
+extern stats::CounterId kNumGCInlineReleases;
+
 // Server client traffic
 // extern stats::CounterId kReceivedBytes;
 // extern stats::CounterId kSentBytes;
@@ -17,7 +17,8 @@ namespace graph {
 
 // static
 Status SchemaUtil::validateProps(const std::vector<SchemaPropItem *> &schemaProps,
-                                 meta::cpp2::Schema &schema) {
+                                 meta::cpp2::Schema &schema,
+                                 bool isEdge) {
   auto status = Status::OK();
   if (!schemaProps.empty()) {
     for (auto &schemaProp : schemaProps) {
@@ -38,6 +39,14 @@ Status SchemaUtil::validateProps(const std::vector<SchemaPropItem *> &schemaProp
           status = setComment(schemaProp, schema);
           NG_RETURN_IF_ERROR(status);
           break;
+        case SchemaPropItem::ADJACENCY_ORDER:
+        case SchemaPropItem::ADJACENCY_ORDER_DESC:
+          if (!isEdge) {
+            return Status::Error("Adjacency order is only supported by edge");
+          }
+          status = setAdjacencyOrder(schemaProp, schema);
+          NG_RETURN_IF_ERROR(status);
+          break;
       }
     }
 
@@ -113,6 +122,41 @@ Status SchemaUtil::setTTLCol(SchemaPropItem *schemaProp, meta::cpp2::Schema &sch
   return Status::Error("Ttl column name not exist in columns");
 }
 
+// static
+Status SchemaUtil::setAdjacencyOrder(SchemaPropItem *schemaProp, meta::cpp2::Schema &schema) {
+  auto ret = schemaProp->getAdjacencyOrderCol();
+  NG_RETURN_IF_ERROR(ret);
+  auto colName = std::move(ret).value();
+  for (auto &col : *schema.columns_ref()) {
+    if (col.name == colName) {
+      // The column is encoded into the key of adjacency index, only the types which could be
+      // encoded in fixed length and keep the order are allowed
+      switch (col.type.type) {
+        case nebula::cpp2::PropertyType::BOOL:
+        case nebula::cpp2::PropertyType::INT8:
+        case nebula::cpp2::PropertyType::INT16:
+        case nebula::cpp2::PropertyType::INT32:
+        case nebula::cpp2::PropertyType::INT64:
+        case nebula::cpp2::PropertyType::TIMESTAMP:
+        case nebula::cpp2::PropertyType::FLOAT:
+        case nebula::cpp2::PropertyType::DOUBLE:
+        case nebula::cpp2::PropertyType::DATE:
+        case nebula::cpp2::PropertyType::TIME:
+        case nebula::cpp2::PropertyType::DATETIME:
+          break;
+        default:
+          return Status::Error("Adjacency order column type illegal");
+      }
+      auto &prop = schema.schema_prop_ref().value();
+      prop.adjacency_order_col_ref() = colName;
+      prop.adjacency_order_desc_ref() =
+          schemaProp->getPropType() == SchemaPropItem::ADJACENCY_ORDER_DESC;
+      return Status::OK();
+    }
+  }
+  return Status::Error("Adjacency order column name not exist in columns");
+}
+
 // static
 Status SchemaUtil::setComment(SchemaPropItem *schemaProp, meta::cpp2::Schema &schema) {
   auto ret = schemaProp->getComment();
@@ -246,6 +290,12 @@ StatusOr<DataSet> SchemaUtil::toShowCreateSchema(bool isTag,
   } else {
     createStr += "\"\"";
   }
+  if (prop.adjacency_order_col_ref().has_value() && !(*prop.adjacency_order_col_ref()).empty()) {
+    createStr += ", adjacency_order = \"" + *prop.adjacency_order_col_ref() + "\"";
+    if (prop.adjacency_order_desc_ref().value_or(false)) {
+      createStr += " DESC";
+    }
+  }
   if (prop.comment_ref().has_value()) {
     createStr += ", comment = \"";
     createStr += *prop.comment_ref();
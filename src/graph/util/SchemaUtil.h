@@ -27,8 +27,10 @@ class SchemaUtil final {
  public:
   // Iterates schemaProps and sets the each shchemaProp into schema.
   // Returns Status error when when failed to set.
+  // The adjacency order is only allowed for edges.
   static Status validateProps(const std::vector<SchemaPropItem*>& schemaProps,
-                              meta::cpp2::Schema& schema);
+                              meta::cpp2::Schema& schema,
+                              bool isEdge = false);
 
   // Generates a NebulaSchemaProvider that contains schema info from the schema.
   static std::shared_ptr<const meta::NebulaSchemaProvider> generateSchemaProvider(
@@ -40,6 +42,9 @@ class SchemaUtil final {
   // Sets TTLCol from shcemaProp into shcema.
   static Status setTTLCol(SchemaPropItem* schemaProp, meta::cpp2::Schema& schema);
 
+  // Sets the column and direction of adjacency order from schemaProp into schema.
+  static Status setAdjacencyOrder(SchemaPropItem* schemaProp, meta::cpp2::Schema& schema);
+
   // Sets Comment from shcemaProp into shcema.
   static Status setComment(SchemaPropItem* schemaProp, meta::cpp2::Schema& schema);
 
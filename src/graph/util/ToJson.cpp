@@ -143,6 +143,10 @@ folly::dynamic toJson(const meta::cpp2::SchemaProp &prop) {
   if (prop.ttl_duration_ref()) {
     object.insert("ttlDuration", *prop.ttl_duration_ref());
   }
+  if (prop.adjacency_order_col_ref().has_value()) {
+    object.insert("adjacencyOrderCol", *prop.adjacency_order_col_ref());
+    object.insert("adjacencyOrderDesc", prop.adjacency_order_desc_ref().value_or(false));
+  }
   return object;
 }
 
@@ -0,0 +1,125 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_VIDDICT_H_
+#define GRAPH_UTIL_VIDDICT_H_
+
+#include <robin_hood.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// A query local dictionary which maps vids to dense integer ids.
+//
+// Traversal executors use it to keep their frontiers, visited marks and parent links on
+// 32-bit integers instead of full vid values, so each vid is hashed and stored only once.
+// The original vid is restored by `vid(id)' when building the output rows.
+//
+// The dictionary is not thread safe, each concurrent expansion should own its dictionary.
+class VidDict final {
+ public:
+  using Id = uint32_t;
+  static constexpr Id kInvalidId = std::numeric_limits<Id>::max();
+
+  VidDict() = default;
+
+  // Returns the id of the vid, a new id is assigned if the vid is seen the first time.
+  Id intern(const Value& vid) {
+    auto next = static_cast<Id>(vids_.size());
+    auto ret = ids_.emplace(vid, next);
+    if (ret.second) {
+      DCHECK_LT(next, kInvalidId) << "Too many vids in the dictionary";
+      vids_.emplace_back(&ret.first->first);
+    }
+    return ret.first->second;
+  }
+
+  // Returns the id of the vid, kInvalidId if the vid is not in the dictionary.
+  Id find(const Value& vid) const {
+    auto found = ids_.find(vid);
+    return found == ids_.end() ? kInvalidId : found->second;
+  }
+
+  const Value& vid(Id id) const {
+    DCHECK_LT(id, vids_.size());
+    return *vids_[id];
+  }
+
+  size_t size() const {
+    return vids_.size();
+  }
+
+  void reserve(size_t size) {
+    ids_.reserve(size);
+    vids_.reserve(size);
+  }
+
+ private:
+  // The node map keeps the address of each vid stable, so the reverse mapping only holds
+  // pointers to the keys.
+  robin_hood::unordered_node_map<Value, Id, std::hash<Value>> ids_;
+  std::vector<const Value*> vids_;
+};
+
+// The adjacency list of a traversal keyed by the dense ids of the expanded vertices.
+//
+// Each vid is hashed into the dictionary once, the entries are kept in a deque indexed by the
+// ids, so the lookups during the path building are a probe of the dictionary plus an index, and
+// the references to the entries are stable while new vertices are expanded. A vertex could be
+// looked up either by the vertex value or by its vid, just like `VidHashSet'.
+//
+// Like the dictionary, the list is not thread safe, but concurrent lookups are fine.
+class VidAdjList final {
+ public:
+  struct Entry {
+    // The vertex with its properties, or the vid if the vertex is not fetched
+    Value vertex;
+    std::vector<Value> edges;
+  };
+
+  // Adds the adjacent edges of the vertex, returns false and drops the edges if the vertex is
+  // expanded already.
+  bool emplace(Value vertex, std::vector<Value>&& edges) {
+    auto size = dict_.size();
+    auto id = dict_.intern(vidOf(vertex));
+    if (id < size) {
+      return false;
+    }
+    entries_.emplace_back(Entry{std::move(vertex), std::move(edges)});
+    return true;
+  }
+
+  // Returns the entry of the vertex or vid, nullptr if it's not expanded.
+  const Entry* find(const Value& vertex) const {
+    auto id = dict_.find(vidOf(vertex));
+    return id == VidDict::kInvalidId ? nullptr : &entries_[id];
+  }
+
+  bool contains(const Value& vertex) const {
+    return dict_.find(vidOf(vertex)) != VidDict::kInvalidId;
+  }
+
+  size_t size() const {
+    return entries_.size();
+  }
+
+  void reserve(size_t size) {
+    dict_.reserve(size);
+  }
+
+ private:
+  static const Value& vidOf(const Value& vertex) {
+    return vertex.isVertex() ? vertex.getVertex().vid : vertex;
+  }
+
+  VidDict dict_;
+  std::deque<Entry> entries_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_UTIL_VIDDICT_H_
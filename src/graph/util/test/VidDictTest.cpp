@@ -0,0 +1,63 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/util/VidDict.h"
+
+namespace nebula {
+namespace graph {
+TEST(VidDictTest, StringVid) {
+  VidDict dict;
+  EXPECT_EQ(0, dict.size());
+  EXPECT_EQ(VidDict::kInvalidId, dict.find("a"));
+
+  auto a = dict.intern("a");
+  auto b = dict.intern("b");
+  EXPECT_EQ(0, a);
+  EXPECT_EQ(1, b);
+  EXPECT_EQ(a, dict.intern("a"));
+  EXPECT_EQ(2, dict.size());
+  EXPECT_EQ(b, dict.find("b"));
+  EXPECT_EQ(Value("a"), dict.vid(a));
+  EXPECT_EQ(Value("b"), dict.vid(b));
+}
+
+TEST(VidDictTest, StableAfterRehash) {
+  VidDict dict;
+  constexpr int64_t kNum = 100000;
+  for (int64_t i = 0; i < kNum; ++i) {
+    EXPECT_EQ(i, dict.intern(Value(i)));
+  }
+  EXPECT_EQ(kNum, dict.size());
+  for (int64_t i = 0; i < kNum; ++i) {
+    EXPECT_EQ(Value(i), dict.vid(static_cast<VidDict::Id>(i)));
+    EXPECT_EQ(i, dict.find(Value(i)));
+  }
+}
+
+TEST(VidDictTest, AdjList) {
+  VidAdjList adjList;
+  Vertex a("a", {});
+  EXPECT_FALSE(adjList.contains("a"));
+  EXPECT_TRUE(adjList.emplace(Value(a), {Value(Edge("a", "b", 1, "like", 0, {}))}));
+  EXPECT_TRUE(adjList.emplace(Value("b"), {}));
+  // Expanded already, whether it's looked up by the vertex or the vid
+  EXPECT_FALSE(adjList.emplace(Value("a"), {}));
+  EXPECT_EQ(2, adjList.size());
+
+  auto* entry = adjList.find("a");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(Value(a), entry->vertex);
+  ASSERT_EQ(1, entry->edges.size());
+  EXPECT_EQ("b", entry->edges[0].getEdge().dst.getStr());
+  EXPECT_EQ(entry, adjList.find(Value(a)));
+  ASSERT_NE(nullptr, adjList.find("b"));
+  EXPECT_TRUE(adjList.find("b")->edges.empty());
+  EXPECT_EQ(nullptr, adjList.find("c"));
+}
+
+}  // namespace graph
+}  // namespace nebula
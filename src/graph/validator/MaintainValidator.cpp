@@ -10,6 +10,7 @@
 #include "common/base/Status.h"
 #include "common/charset/Charset.h"
 #include "common/expression/ConstantExpression.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
 #include "common/plugin/fulltext/elasticsearch/ESAdapter.h"
 #include "graph/planner/plan/Admin.h"
 #include "graph/planner/plan/Maintain.h"
@@ -190,7 +191,7 @@ Status CreateEdgeValidator::validateImpl() {
   meta::cpp2::Schema schema;
   NG_RETURN_IF_ERROR(checkColName(sentence->columnSpecs()));
   NG_RETURN_IF_ERROR(validateColumns(sentence->columnSpecs(), schema));
-  NG_RETURN_IF_ERROR(SchemaUtil::validateProps(sentence->getSchemaProps(), schema));
+  NG_RETURN_IF_ERROR(SchemaUtil::validateProps(sentence->getSchemaProps(), schema, true));
   // Save the schema in validateContext
   auto schemaPro = SchemaUtil::generateSchemaProvider(0, schema);
   vctx_->addSchema(name, schemaPro);
@@ -615,13 +616,16 @@ Status CreateFTIndexValidator::validateImpl() {
   if (!ok) {
     return Status::SyntaxError("Fulltext index name can only contain [_0-9a-z].");
   }
-  auto esAdapterRet = FTIndexUtils::getESAdapter(qctx_->getMetaClient());
-  NG_RETURN_IF_ERROR(esAdapterRet);
-  auto esAdapter = std::move(esAdapterRet).value();
-  auto existResult = esAdapter.isIndexExist(name.toString());
-  NG_RETURN_IF_ERROR(existResult);
-  if (existResult.value()) {
-    return Status::Error(fmt::format("text search index exist : {}", name));
+  // The builtin index is maintained by storage, which doesn't need the elasticsearch
+  if (sentence->analyzer() != plugin::kBuiltinAnalyzer) {
+    auto esAdapterRet = FTIndexUtils::getESAdapter(qctx_->getMetaClient());
+    NG_RETURN_IF_ERROR(esAdapterRet);
+    auto esAdapter = std::move(esAdapterRet).value();
+    auto existResult = esAdapter.isIndexExist(name.toString());
+    NG_RETURN_IF_ERROR(existResult);
+    if (existResult.value()) {
+      return Status::Error(fmt::format("text search index exist : {}", name));
+    }
   }
   auto space = vctx_->whichSpace();
   auto status = sentence->isEdge()
@@ -357,6 +357,7 @@ enum ErrorCode {
     E_SEMANTIC_ERROR                  = -1009,  // Semantic error
     E_TOO_MANY_CONNECTIONS            = -1010,  // Maximum number of connections exceeded
     E_PARTIAL_SUCCEEDED               = -1011,  // Access to storage failed (only some requests succeeded)
+    E_PAGED_RESULT_NOT_FOUND          = -1012,  // Paged result does not exist or has expired
 
     // 2xxx for metad
     E_NO_HOSTS                        = -2001,  // Host does not exist
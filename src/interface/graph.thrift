@@ -88,6 +88,14 @@ struct ExecutionResponse {
     7: optional binary                  comment;        // Supplementary instruction
 } (cpp.type = "nebula::ExecutionResponse", cpp.noncopyable)
 
+// A page of the result returned by executeWithPaging or fetchNextPage
+struct ExecutionPage {
+    // The data of the response is the rows of this page
+    1: required ExecutionResponse       response;
+    // Id to fetch the next page by fetchNextPage, 0 if this is the last page
+    2: required i64                     result_id;
+} (cpp.noncopyable)
+
 
 struct AuthResponse {
     1: required common.ErrorCode   error_code;
@@ -109,6 +117,40 @@ struct VerifyClientVersionReq {
 }
 
 
+// The vertices of a tag, each property column has a value for each vid
+struct VertexBatch {
+    1: binary                       tag_name,
+    2: list<common.Value>           vids,
+    // Empty means all properties of the tag in the order of its schema
+    3: list<binary>                 prop_names,
+    4: list<list<common.Value>>     prop_columns,
+}
+
+
+// The edges of an edge type, each property column has a value for each edge
+struct EdgeBatch {
+    1: binary                       edge_name,
+    2: list<common.Value>           src_ids,
+    3: list<common.Value>           dst_ids,
+    // Empty means the ranks are all 0
+    4: list<i64>                    ranks,
+    // Empty means all properties of the edge type in the order of its schema
+    5: list<binary>                 prop_names,
+    6: list<list<common.Value>>     prop_columns,
+}
+
+
+// Same as INSERT VERTEX/EDGE of the batches, without parsing and validating the statement
+struct BatchInsertRequest {
+    1: i64                          session_id,
+    2: binary                       space_name,
+    3: list<VertexBatch>            vertices,
+    4: list<EdgeBatch>              edges,
+    5: bool                         if_not_exists = false,
+    6: bool                         ignore_existed_index = false,
+}
+
+
 service GraphService {
     AuthResponse authenticate(1: binary username, 2: binary password)
 
@@ -121,4 +163,16 @@ service GraphService {
     binary executeJsonWithParameter(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
     
     VerifyClientVersionResp verifyClientVersion(1: VerifyClientVersionReq req)
+
+    ExecutionResponse batchInsert(1: BatchInsertRequest req)
+
+    // Same as executeWithParameter(), but only the first pageSize rows are returned, the rest are
+    // kept in graphd and fetched by fetchNextPage() until the result id of the page is 0. The
+    // default page size is used if pageSize is not positive. It only pages the result, the query
+    // is still executed to the end before the first page is returned, and the result is returned
+    // in one page if graphd could not keep more rows.
+    ExecutionPage executeWithPaging(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap, 4: i32 pageSize)
+    ExecutionPage fetchNextPage(1: i64 sessionId, 2: i64 resultId)
+    // Release the rows kept by a paged result before all of them are fetched
+    oneway void closePagedResult(1: i64 sessionId, 2: i64 resultId)
 }
@@ -88,6 +88,9 @@ struct SchemaProp {
     1: optional i64      ttl_duration,
     2: optional binary   ttl_col,
     3: optional binary   comment,
+    // Edge only, the adjacency list of each vertex is indexed in the order of this column
+    4: optional binary   adjacency_order_col,
+    5: optional bool     adjacency_order_desc,
 }
 
 struct Schema {
@@ -137,10 +137,24 @@ struct GetStateResponse {
     9: list<binary>     peers;
 }
 
+struct ReadIndexRequest {
+    1: GraphSpaceID space;              // Graphspace ID
+    2: PartitionID  part;               // Partition ID
+    3: LogID        committed_log_id;   // Follower's committed log id
+}
+
+struct ReadIndexResponse {
+    1: common.ErrorCode error_code;
+    2: TermID           current_term;
+    // The committed log id of leader when the read index is requested
+    3: LogID            read_index;
+}
+
 service RaftexService {
     AskForVoteResponse askForVote(1: AskForVoteRequest req);
     AppendLogResponse appendLog(1: AppendLogRequest req);
     SendSnapshotResponse sendSnapshot(1: SendSnapshotRequest req);
     HeartbeatResponse heartbeat(1: HeartbeatRequest req) (thread = 'eb');
     GetStateResponse getState(1: GetStateRequest req);
+    ReadIndexResponse readIndex(1: ReadIndexRequest req);
 }
@@ -25,6 +25,8 @@ struct RequestCommon {
     1: optional common.SessionID session_id,
     2: optional common.ExecutionPlanID plan_id,
     3: optional bool profile_detail,
+    // The read request could be served by a follower, which may return stale data
+    4: optional bool read_from_follower,
 }
 
 struct PartitionResult {
@@ -583,6 +585,28 @@ struct LookupAndTraverseRequest {
     5: optional RequestCommon               common,
 }
 
+// Search the builtin fulltext index, which is maintained by storaged itself
+struct TextSearchRequest {
+    1: common.GraphSpaceID                  space_id,
+    2: list<common.PartitionID>             parts,
+    3: common.SchemaID                      schema_id,
+    4: binary                               index_name,
+    // The terms separated by whitespace, which should be all matched.
+    // "a b" matches the phrase and "ab*" matches the terms with the prefix
+    5: binary                               query,
+    // max row count of each partition in this response
+    6: i64                                  limit,
+    7: optional RequestCommon               common,
+}
+
+struct TextSearchResponse {
+    1: required ResponseCommon              result,
+    // Each row is one document matched, ordered by the score descending
+    //   vertex: [vid, score]
+    //   edge:   [src, rank, dst, score]
+    2: optional common.DataSet              data,
+}
+
 /*
  * End of Index section
  */
@@ -641,6 +665,22 @@ struct ScanResponse {
                                             cursors;
 }
 
+// The counters of a part maintained by the writes, see SpaceStatsManager
+struct PartStats {
+    1: i64                                  space_vertices = 0,
+    2: i64                                  space_edges = 0,
+    3: map<common.TagID, i64>
+        (cpp.template = "std::unordered_map") tag_vertices,
+    // Only the outbound edges are counted
+    4: map<common.EdgeType, i64>
+        (cpp.template = "std::unordered_map") edges,
+    // When the counters were recalculated by scanning the part, in seconds
+    5: i64                                  reconciled_at = 0,
+    // The term of the leader which recalculated the counters, the rows expired are removed by
+    // the compaction of each replica, so the counters are only valid in this term
+    6: common.TermID                        reconciled_term = 0,
+}
+
 struct TaskPara {
     1: common.GraphSpaceID                  space_id,
     2: optional list<common.PartitionID>    parts,
@@ -707,6 +747,8 @@ service GraphStorageService {
 
     GetNeighborsResponse lookupAndTraverse(1: LookupAndTraverseRequest req);
 
+    TextSearchResponse textSearch(1: TextSearchRequest req);
+
     UpdateResponse chainUpdateEdge(1: UpdateEdgeRequest req);
     ExecResponse chainAddEdges(1: AddEdgesRequest req);
     ExecResponse chainDeleteEdges(1: DeleteEdgesRequest req);
@@ -0,0 +1,72 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_COMMITHOOK_H_
+#define KVSTORE_COMMITHOOK_H_
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftTypes.h"
+#include "interface/gen-cpp2/common_types.h"
+#include "kvstore/KVEngine.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief Derive extra keys from the logs when they are committed, in the same write batch of
+ * the logs. So the derived keys are always consistent with the data on every peer, like the
+ * listener consumes the logs, but without any external system.
+ */
+class CommitHook {
+ public:
+  /**
+   * @brief Applier sees the data operations of one write batch in order
+   */
+  class Applier {
+   public:
+    virtual ~Applier() = default;
+
+    virtual nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) = 0;
+
+    virtual nebula::cpp2::ErrorCode remove(folly::StringPiece key) = 0;
+
+    /**
+     * @brief Called after the write batch is committed into engine, the state kept in memory
+     * should only be changed here, since the batch could be given up half way.
+     */
+    virtual void committed() {}
+  };
+
+  virtual ~CommitHook() = default;
+
+  /**
+   * @brief Load the state of part kept in memory from engine, called when the part starts and
+   * when its data is replaced, e.g. by a snapshot or cleanup
+   */
+  virtual void load(GraphSpaceID spaceId, PartitionID partId, KVEngine* engine) {
+    UNUSED(spaceId);
+    UNUSED(partId);
+    UNUSED(engine);
+  }
+
+  /**
+   * @brief Start to apply a write batch of the part
+   *
+   * @param engine The engine of part, which doesn't see the operations in batch yet
+   * @param batch The derived operations should be written into it
+   * @return Applier, nullptr if there is nothing to derive in the part. The put and remove of
+   * applier could return E_WRITE_STALLED if it can't derive the keys for now, e.g. the schema
+   * is not known yet, then the logs are committed again later.
+   */
+  virtual std::unique_ptr<Applier> begin(GraphSpaceID spaceId,
+                                         PartitionID partId,
+                                         KVEngine* engine,
+                                         WriteBatch* batch) = 0;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_COMMITHOOK_H_
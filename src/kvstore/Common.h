@@ -269,6 +269,30 @@ inline rocksdb::Slice toSlice(const folly::StringPiece& str) {
   return rocksdb::Slice(str.begin(), str.size());
 }
 
+/**
+ * @brief Value of pinned read. When read from rocksdb, it refers to the block in block cache or
+ * memtable directly instead of copying it out, and keeps the block pinned until the value is reset
+ * or destroyed, so don't hold it longer than necessary.
+ */
+using PinnedValue = rocksdb::PinnableSlice;
+
+/**
+ * @brief rocksdb::Slice to folly::StringPiece
+ */
+inline folly::StringPiece toStringPiece(const rocksdb::Slice& slice) {
+  return folly::StringPiece(slice.data(), slice.size());
+}
+
+/**
+ * @brief How an iterator reads data. kBulk is for background and analytical full scans, the blocks
+ * read are not filled into block cache so the hot data of online queries is not evicted, and the
+ * following blocks are read ahead.
+ */
+enum class ScanMode : uint8_t {
+  kDefault = 0,
+  kBulk = 1,
+};
+
 using KVMap = std::unordered_map<std::string, std::string>;
 using KVArrayIterator = std::vector<KV>::const_iterator;
 
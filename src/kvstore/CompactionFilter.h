@@ -84,7 +84,7 @@ class KVCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
       // See CompactionFilterFactory::ShouldFilterTableFileCreation.
       LOG(INFO) << "Do automatic or periodic compaction!";
     }
-    return std::make_unique<KVCompactionFilter>(spaceId_, createKVFilter());
+    return std::make_unique<KVCompactionFilter>(spaceId_, createKVFilter(context));
   }
 
   const char* Name() const override {
@@ -93,6 +93,14 @@ class KVCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
 
   virtual std::unique_ptr<KVFilter> createKVFilter() = 0;
 
+  /**
+   * @brief Create the filter of a compaction, the filters which depend on the compaction
+   * override it
+   */
+  virtual std::unique_ptr<KVFilter> createKVFilter(const rocksdb::CompactionFilter::Context&) {
+    return createKVFilter();
+  }
+
  private:
   GraphSpaceID spaceId_;
 };
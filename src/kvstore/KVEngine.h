@@ -132,17 +132,66 @@ class KVEngine {
   virtual std::vector<Status> multiGet(const std::vector<std::string>& keys,
                                        std::vector<std::string>* values) = 0;
 
+  /**
+   * @brief Read a single key without copying the value out of engine if possible. The default
+   * implementation reads a copy and pins it in the value itself.
+   *
+   * @param key Key to read
+   * @param value Pointer of pinned value, it is reset before read
+   * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode getPinned(const std::string& key,
+                                            PinnedValue* value,
+                                            const void* snapshot = nullptr) {
+    value->Reset();
+    auto code = get(key, value->GetSelf(), snapshot);
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      value->PinSelf();
+    }
+    return code;
+  }
+
+  /**
+   * @brief Read a list of keys without copying the values out of engine if possible
+   *
+   * @param keys Keys to read
+   * @param values Pointers of pinned values, resized to the size of keys
+   * @return std::vector<Status> Result status of each key, if key[i] does not exist, the i-th value
+   * in return value would be Status::KeyNotFound
+   */
+  virtual std::vector<Status> multiGetPinned(const std::vector<std::string>& keys,
+                                             std::vector<PinnedValue>* values) {
+    std::vector<Status> ret;
+    ret.reserve(keys.size());
+    values->clear();
+    values->resize(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      auto code = getPinned(keys[i], &(*values)[i]);
+      if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        ret.emplace_back(Status::OK());
+      } else if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        ret.emplace_back(Status::KeyNotFound());
+      } else {
+        ret.emplace_back(Status::Error());
+      }
+    }
+    return ret;
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
    * @param start Start key, inclusive
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode range(const std::string& start,
                                         const std::string& end,
-                                        std::unique_ptr<KVIterator>* iter) = 0;
+                                        std::unique_ptr<KVIterator>* iter,
+                                        ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -150,11 +199,13 @@ class KVEngine {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix', returns by kv engine
    * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode prefix(const std::string& prefix,
                                          std::unique_ptr<KVIterator>* iter,
-                                         const void* snapshot = nullptr) = 0;
+                                         const void* snapshot = nullptr,
+                                         ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -162,11 +213,13 @@ class KVEngine {
    * @param start Start key, inclusive
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                                   const std::string& prefix,
-                                                  std::unique_ptr<KVIterator>* iter) = 0;
+                                                  std::unique_ptr<KVIterator>* iter,
+                                                  ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief Scan all keys in kv engine
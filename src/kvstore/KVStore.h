@@ -13,6 +13,7 @@
 #include "common/base/ErrorOr.h"
 #include "common/base/Status.h"
 #include "common/meta/SchemaManager.h"
+#include "kvstore/CommitHook.h"
 #include "kvstore/Common.h"
 #include "kvstore/CompactionFilter.h"
 #include "kvstore/KVEngine.h"
@@ -49,6 +50,9 @@ struct KVOptions {
 
   // Custom CompactionFilter used in compaction.
   std::unique_ptr<CompactionFilterFactoryBuilder> cffBuilder_{nullptr};
+
+  // Custom CommitHook which derives extra keys when logs are committed.
+  std::shared_ptr<CommitHook> commitHook_{nullptr};
 };
 
 struct StoreCapability {
@@ -153,6 +157,61 @@ class KVStore {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) = 0;
 
+  /**
+   * @brief Read a single key, the value is pinned in engine without copy if possible. The default
+   * implementation reads a copy and pins it in the value itself.
+   *
+   * @param spaceId
+   * @param partId
+   * @param key
+   * @param value Pinned value, which must be released before the part is removed
+   * @param canReadFromFollower
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode getPinned(GraphSpaceID spaceId,
+                                            PartitionID partId,
+                                            const std::string& key,
+                                            PinnedValue* value,
+                                            bool canReadFromFollower = false,
+                                            const void* snapshot = nullptr) {
+    value->Reset();
+    auto code = get(spaceId, partId, key, value->GetSelf(), canReadFromFollower, snapshot);
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      value->PinSelf();
+    }
+    return code;
+  }
+
+  /**
+   * @brief Read a list of keys, the values are pinned in engine without copy if possible. The
+   * default implementation reads copies and pins them in the values themselves.
+   *
+   * @param spaceId
+   * @param partId
+   * @param keys Keys to read
+   * @param values Pinned values, which must be released before the part is removed
+   * @param canReadFromFollower
+   * @return Return std::vector<Status> when succeeded: Result status of each key, if key[i] does
+   * not exist, the i-th value in return value would be Status::KeyNotFound. Return ErrorCode when
+   * failed
+   */
+  virtual std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> multiGetPinned(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      const std::vector<std::string>& keys,
+      std::vector<PinnedValue>* values,
+      bool canReadFromFollower = false) {
+    std::vector<std::string> copies;
+    auto ret = multiGet(spaceId, partId, keys, &copies, canReadFromFollower);
+    values->clear();
+    values->resize(copies.size());
+    for (size_t i = 0; i < copies.size(); i++) {
+      *(*values)[i].GetSelf() = std::move(copies[i]);
+      (*values)[i].PinSelf();
+    }
+    return ret;
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -162,6 +221,7 @@ class KVStore {
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
    * @param canReadFromFollower
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode range(GraphSpaceID spaceId,
@@ -169,7 +229,8 @@ class KVStore {
                                         const std::string& start,
                                         const std::string& end,
                                         std::unique_ptr<KVIterator>* iter,
-                                        bool canReadFromFollower = false) = 0;
+                                        bool canReadFromFollower = false,
+                                        ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief To forbid to pass rvalue via the 'range' parameter.
@@ -179,7 +240,8 @@ class KVStore {
                                         std::string&& start,
                                         std::string&& end,
                                         std::unique_ptr<KVIterator>* iter,
-                                        bool canReadFromFollower = false) = delete;
+                                        bool canReadFromFollower = false,
+                                        ScanMode mode = ScanMode::kDefault) = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -190,6 +252,7 @@ class KVStore {
    * @param iter Iterator of keys starts with 'prefix', returns by kv engine
    * @param canReadFromFollower
    * @param snapshot If set, read from snapshot.
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode prefix(GraphSpaceID spaceId,
@@ -197,7 +260,8 @@ class KVStore {
                                          const std::string& prefix,
                                          std::unique_ptr<KVIterator>* iter,
                                          bool canReadFromFollower = false,
-                                         const void* snapshot = nullptr) = 0;
+                                         const void* snapshot = nullptr,
+                                         ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief To forbid to pass rvalue via the 'prefix' parameter.
@@ -207,7 +271,8 @@ class KVStore {
                                          std::string&& prefix,
                                          std::unique_ptr<KVIterator>* iter,
                                          bool canReadFromFollower = false,
-                                         const void* snapshot = nullptr) = delete;
+                                         const void* snapshot = nullptr,
+                                         ScanMode mode = ScanMode::kDefault) = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -218,6 +283,7 @@ class KVStore {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
    * @param canReadFromFollower
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
@@ -225,7 +291,8 @@ class KVStore {
                                                   const std::string& start,
                                                   const std::string& prefix,
                                                   std::unique_ptr<KVIterator>* iter,
-                                                  bool canReadFromFollower = false) = 0;
+                                                  bool canReadFromFollower = false,
+                                                  ScanMode mode = ScanMode::kDefault) = 0;
 
   /**
    * @brief To forbid to pass rvalue via the 'rangeWithPrefix' parameter.
@@ -235,7 +302,8 @@ class KVStore {
                                                   std::string&& start,
                                                   std::string&& prefix,
                                                   std::unique_ptr<KVIterator>* iter,
-                                                  bool canReadFromFollower = false) = delete;
+                                                  bool canReadFromFollower = false,
+                                                  ScanMode mode = ScanMode::kDefault) = delete;
 
   /**
    * @brief Synchronize the kvstore across multiple replica
@@ -246,6 +314,16 @@ class KVStore {
    */
   virtual nebula::cpp2::ErrorCode sync(GraphSpaceID spaceId, PartitionID partId) = 0;
 
+  /**
+   * @brief Wait until the replica could serve linearizable reads, i.e. the logs committed by
+   * leader when this method is called have been applied locally. It works on follower as well.
+   *
+   * @param spaceId
+   * @param partId
+   * @param cb Callback when the replica is ready to read or error occurs
+   */
+  virtual void asyncReadIndex(GraphSpaceID spaceId, PartitionID partId, KVCallback cb) = 0;
+
   /**
    * @brief Write multiple key/values to kvstore asynchronously
    *
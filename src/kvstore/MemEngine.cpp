@@ -0,0 +1,671 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/MemEngine.h"
+
+#include <folly/FileUtil.h>
+#include <folly/hash/Checksum.h>
+
+#include "common/fs/FileUtils.h"
+#include "common/utils/MetaKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace kvstore {
+
+using fs::FileUtils;
+
+namespace {
+constexpr char kCheckpointFile[] = "checkpoint";
+// The layout of checkpoint file:
+// magic | version | count | (key length, key, value length, value) * count | crc
+constexpr uint32_t kMagic = 0x4e4d454d;  // "NMEM"
+constexpr uint32_t kVersion = 1;
+// Flush the checkpoint into file when the buffer exceeds the size
+constexpr size_t kWriteBufferSize = 4 * 1024 * 1024;
+
+template <typename T>
+void appendValue(std::string& buf, T val) {
+  buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+bool readValue(folly::StringPiece& data, T* val) {
+  if (data.size() < sizeof(T)) {
+    return false;
+  }
+  memcpy(val, data.data(), sizeof(T));
+  data.advance(sizeof(T));
+  return true;
+}
+
+bool readString(folly::StringPiece& data, std::string* str) {
+  uint32_t len;
+  if (!readValue(data, &len) || data.size() < len) {
+    return false;
+  }
+  str->assign(data.data(), len);
+  data.advance(len);
+  return true;
+}
+}  // namespace
+
+MemEngine::MemEngine(GraphSpaceID spaceId, const std::string& dataPath, const std::string& walPath)
+    : KVEngine(spaceId), dataPath_(folly::stringPrintf("%s/nebula/%d", dataPath.c_str(), spaceId)) {
+  // set wal path as dataPath by default
+  if (walPath.empty()) {
+    walPath_ = dataPath_;
+  } else {
+    walPath_ = folly::stringPrintf("%s/nebula/%d", walPath.c_str(), spaceId);
+  }
+  checkpointDir_ = folly::stringPrintf("%s/mem", dataPath_.c_str());
+  if (!FileUtils::exist(checkpointDir_) && !FileUtils::makeDir(checkpointDir_)) {
+    LOG(FATAL) << "makeDir " << checkpointDir_ << " failed";
+  }
+  if (!loadCheckpoint(checkpointDir_)) {
+    LOG(FATAL) << "Failed to load the checkpoint in " << checkpointDir_;
+  }
+  std::string version;
+  if (spaceId_ != kDefaultSpaceId /* only for storage*/ &&
+      get(NebulaKeyUtils::dataVersionKey(), &version) == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    put(NebulaKeyUtils::dataVersionKey(), NebulaKeyUtils::dataVersionValue());
+  }
+  partsNum_ = allParts().size();
+  LOG(INFO) << "open in-memory engine on " << dataPath_ << " with " << numKeys_ << " keys";
+}
+
+MemEngine::~MemEngine() {
+  saveCheckpoint(checkpointDir_);
+  LOG(INFO) << "Release in-memory engine on " << dataPath_;
+}
+
+const void* MemEngine::GetSnapshot() {
+  folly::SharedMutex::ReadHolder rh(lock_);
+  return new Snapshot{acquireSnapshotLocked()};
+}
+
+void MemEngine::ReleaseSnapshot(const void* snapshot) {
+  const auto* s = reinterpret_cast<const Snapshot*>(snapshot);
+  releaseSnapshot(s->seq);
+  delete s;
+}
+
+std::unique_ptr<WriteBatch> MemEngine::startBatchWrite() {
+  return std::make_unique<MemWriteBatch>();
+}
+
+nebula::cpp2::ErrorCode MemEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                                    bool disableWAL,
+                                                    bool sync,
+                                                    bool wait) {
+  UNUSED(disableWAL);
+  UNUSED(sync);
+  UNUSED(wait);
+  auto* b = static_cast<MemWriteBatch*>(batch.get());
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  for (auto& op : b->ops()) {
+    switch (op.type) {
+      case MemWriteBatch::OpType::kPut:
+        putLocked(std::move(op.first), std::move(op.second));
+        break;
+      case MemWriteBatch::OpType::kRemove: {
+        auto it = data_.find(op.first);
+        if (it != data_.end()) {
+          removeLocked(it);
+        }
+        break;
+      }
+      case MemWriteBatch::OpType::kRemoveRange:
+        removeRangeLocked(op.first, op.second);
+        break;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::get(const std::string& key,
+                                       std::string* value,
+                                       const void* snapshot) {
+  folly::SharedMutex::ReadHolder rh(lock_);
+  auto it = data_.find(key);
+  if (it != data_.end()) {
+    auto seq = snapshot == nullptr ? seq_ : reinterpret_cast<const Snapshot*>(snapshot)->seq;
+    const auto* version = visible(it->second, seq);
+    if (version != nullptr && version->value != nullptr) {
+      *value = *version->value;
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+  }
+  VLOG(4) << "Get: " << key << " Not Found";
+  return nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND;
+}
+
+std::vector<Status> MemEngine::multiGet(const std::vector<std::string>& keys,
+                                        std::vector<std::string>* values) {
+  std::vector<Status> ret;
+  ret.reserve(keys.size());
+  values->clear();
+  values->resize(keys.size());
+  folly::SharedMutex::ReadHolder rh(lock_);
+  for (size_t i = 0; i < keys.size(); i++) {
+    auto it = data_.find(keys[i]);
+    if (it == data_.end() || it->second.front().value == nullptr) {
+      ret.emplace_back(Status::KeyNotFound());
+    } else {
+      (*values)[i] = *it->second.front().value;
+      ret.emplace_back(Status::OK());
+    }
+  }
+  return ret;
+}
+
+nebula::cpp2::ErrorCode MemEngine::range(const std::string& start,
+                                         const std::string& end,
+                                         std::unique_ptr<KVIterator>* iter,
+                                         ScanMode) {
+  iter->reset(new MemIter(this, nullptr, start, start < end ? end : start));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::prefix(const std::string& prefix,
+                                          std::unique_ptr<KVIterator>* iter,
+                                          const void* snapshot,
+                                          ScanMode) {
+  iter->reset(new MemIter(this, snapshot, prefix, std::nullopt, prefix));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::rangeWithPrefix(const std::string& start,
+                                                   const std::string& prefix,
+                                                   std::unique_ptr<KVIterator>* iter,
+                                                   ScanMode) {
+  iter->reset(new MemIter(this, nullptr, start, std::nullopt, prefix));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
+  storageIter->reset(new MemIter(this, nullptr, "", std::nullopt));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::put(std::string key, std::string value) {
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  putLocked(std::move(key), std::move(value));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::multiPut(std::vector<KV> keyValues) {
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  for (auto& kv : keyValues) {
+    putLocked(std::move(kv.first), std::move(kv.second));
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::remove(const std::string& key) {
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  auto it = data_.find(key);
+  if (it != data_.end()) {
+    removeLocked(it);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::multiRemove(std::vector<std::string> keys) {
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  for (const auto& key : keys) {
+    auto it = data_.find(key);
+    if (it != data_.end()) {
+      removeLocked(it);
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::removeRange(const std::string& start, const std::string& end) {
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  removeRangeLocked(start, end);
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void MemEngine::addPart(PartitionID partId, const Peers& raftPeers) {
+  auto ret = put(NebulaKeyUtils::systemPartKey(partId), "");
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    partsNum_++;
+    CHECK_GE(partsNum_, 0);
+  }
+
+  if (!raftPeers.allNormalPeers()) {
+    put(NebulaKeyUtils::systemBalanceKey(partId), raftPeers.toString());
+  }
+}
+
+nebula::cpp2::ErrorCode MemEngine::updatePart(PartitionID partId, const Peer& raftPeer) {
+  auto balanceKey = NebulaKeyUtils::systemBalanceKey(partId);
+  std::string val;
+  auto ret = get(balanceKey, &val);
+
+  Peers peers;
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    peers = Peers::fromString(val);
+  } else if (ret != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    LOG(INFO) << "Update part failed when get, partId=" << partId;
+    return ret;
+  }
+
+  peers.addOrUpdate(raftPeer);
+  // When all replica become normal peers, delete this temp key
+  if (peers.allNormalPeers()) {
+    return remove(balanceKey);
+  }
+  return put(balanceKey, peers.toString());
+}
+
+void MemEngine::removePart(PartitionID partId) {
+  auto code = multiRemove({NebulaKeyUtils::systemPartKey(partId),
+                           NebulaKeyUtils::systemBalanceKey(partId),
+                           NebulaKeyUtils::systemCommitKey(partId)});
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    partsNum_--;
+    CHECK_GE(partsNum_, 0);
+  }
+}
+
+std::vector<PartitionID> MemEngine::allParts() {
+  std::unique_ptr<KVIterator> iter;
+  std::vector<PartitionID> parts;
+  prefix(NebulaKeyUtils::systemPrefix(), &iter);
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    if (NebulaKeyUtils::isSystemPart(key)) {
+      PartitionID partId = *reinterpret_cast<const PartitionID*>(key.data());
+      parts.emplace_back(partId >> 8);
+    }
+  }
+  return parts;
+}
+
+std::map<PartitionID, Peers> MemEngine::balancePartPeers() {
+  std::unique_ptr<KVIterator> iter;
+  std::map<PartitionID, Peers> partRaftPeers;
+  prefix(NebulaKeyUtils::systemPrefix(), &iter);
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    if (NebulaKeyUtils::isSystemBalance(key)) {
+      PartitionID partId = *reinterpret_cast<const PartitionID*>(key.data());
+      partRaftPeers.emplace(partId >> 8, Peers::fromString(iter->val().toString()));
+    }
+  }
+  return partRaftPeers;
+}
+
+nebula::cpp2::ErrorCode MemEngine::ingest(const std::vector<std::string>& files,
+                                          bool verifyFileChecksum) {
+  UNUSED(verifyFileChecksum);
+  if (files.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  LOG(WARNING) << "Ingest sst files is not supported by in-memory engine " << dataPath_;
+  return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::setOption(const std::string& configKey,
+                                             const std::string& configValue) {
+  LOG(WARNING) << "SetOption Failed: " << configKey << ":" << configValue
+               << ", in-memory engine has no option";
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+nebula::cpp2::ErrorCode MemEngine::setDBOption(const std::string& configKey,
+                                               const std::string& configValue) {
+  LOG(WARNING) << "SetDBOption Failed: " << configKey << ":" << configValue
+               << ", in-memory engine has no option";
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> MemEngine::getProperty(
+    const std::string& property) {
+  folly::SharedMutex::ReadHolder rh(lock_);
+  if (property == "mem.num-keys") {
+    return folly::to<std::string>(numKeys_);
+  } else if (property == "mem.num-versions") {
+    return folly::to<std::string>(numVersions_);
+  } else if (property == "mem.data-size") {
+    return folly::to<std::string>(dataSize_);
+  }
+  return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+}
+
+nebula::cpp2::ErrorCode MemEngine::flush() {
+  return saveCheckpoint(checkpointDir_);
+}
+
+nebula::cpp2::ErrorCode MemEngine::createCheckpoint(const std::string& checkpointPath) {
+  LOG(INFO) << "Target checkpoint data path : " << checkpointPath;
+  if (fs::FileUtils::exist(checkpointPath) && !fs::FileUtils::remove(checkpointPath.data(), true)) {
+    LOG(WARNING) << "Remove exist checkpoint data dir failed: " << checkpointPath;
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  if (!FileUtils::makeDir(checkpointPath)) {
+    LOG(WARNING) << "Make checkpoint dir failed: " << checkpointPath;
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  return saveCheckpoint(checkpointPath);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::string> MemEngine::backupTable(
+    const std::string& path,
+    const std::string& tablePrefix,
+    std::function<bool(const folly::StringPiece& key)> filter) {
+  UNUSED(path);
+  UNUSED(tablePrefix);
+  UNUSED(filter);
+  return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+}
+
+nebula::cpp2::ErrorCode MemEngine::backup() {
+  return saveCheckpoint(checkpointDir_);
+}
+
+// static
+const MemEngine::Version* MemEngine::visible(const Versions& versions, uint64_t seq) {
+  for (const auto& version : versions) {
+    if (version.seq <= seq) {
+      return &version;
+    }
+  }
+  return nullptr;
+}
+
+uint64_t MemEngine::acquireSnapshotLocked() {
+  std::lock_guard<std::mutex> guard(snapshotLock_);
+  snapshots_.emplace(seq_);
+  return seq_;
+}
+
+void MemEngine::releaseSnapshot(uint64_t seq) {
+  std::lock_guard<std::mutex> guard(snapshotLock_);
+  auto it = snapshots_.find(seq);
+  CHECK(it != snapshots_.end());
+  snapshots_.erase(it);
+}
+
+void MemEngine::beginWriteLocked() {
+  {
+    std::lock_guard<std::mutex> guard(snapshotLock_);
+    oldest_ = snapshots_.empty() ? std::numeric_limits<uint64_t>::max() : *snapshots_.begin();
+  }
+  // The versions kept for the released snapshots are dropped by the next write
+  if (stale_.empty() || oldest_ == sweptOldest_) {
+    return;
+  }
+  sweptOldest_ = oldest_;
+  auto stale = std::move(stale_);
+  stale_.clear();
+  for (const auto& key : stale) {
+    auto it = data_.find(key);
+    if (it != data_.end()) {
+      pruneLocked(it);
+    }
+  }
+}
+
+void MemEngine::putLocked(std::string key, std::string value) {
+  auto it = data_.lower_bound(key);
+  if (it == data_.end() || it->first != key) {
+    it = data_.emplace_hint(it, std::move(key), Versions());
+  }
+  auto& versions = it->second;
+  if (!versions.empty() && versions.front().value != nullptr) {
+    dataSize_ -= it->first.size() + versions.front().value->size();
+  } else {
+    numKeys_++;
+  }
+  dataSize_ += it->first.size() + value.size();
+  versions.insert(versions.begin(),
+                  Version{++seq_, std::make_shared<const std::string>(std::move(value))});
+  numVersions_++;
+  pruneLocked(it);
+}
+
+MemEngine::KVMap::iterator MemEngine::removeLocked(KVMap::iterator it) {
+  auto& versions = it->second;
+  if (versions.front().value == nullptr) {
+    return std::next(it);
+  }
+  dataSize_ -= it->first.size() + versions.front().value->size();
+  numKeys_--;
+  versions.insert(versions.begin(), Version{++seq_, nullptr});
+  numVersions_++;
+  return pruneLocked(it);
+}
+
+void MemEngine::removeRangeLocked(const std::string& start, const std::string& end) {
+  if (end <= start) {
+    return;
+  }
+  auto it = data_.lower_bound(start);
+  while (it != data_.end() && it->first < end) {
+    it = removeLocked(it);
+  }
+}
+
+MemEngine::KVMap::iterator MemEngine::pruneLocked(KVMap::iterator it) {
+  auto& versions = it->second;
+  // Keep the versions newer than the oldest snapshot, and the one visible to it
+  auto keep = std::find_if(versions.begin(), versions.end(), [this](const auto& version) {
+    return version.seq <= oldest_;
+  });
+  if (keep != versions.end() && keep + 1 != versions.end()) {
+    numVersions_ -= static_cast<size_t>(versions.end() - (keep + 1));
+    versions.erase(keep + 1, versions.end());
+  }
+  if (versions.size() == 1) {
+    if (versions.front().value != nullptr) {
+      return std::next(it);
+    }
+    if (versions.front().seq <= oldest_) {
+      // No iterator is positioned on the key, since it is invisible to all snapshots
+      numVersions_--;
+      return data_.erase(it);
+    }
+  }
+  stale_.emplace(it->first);
+  return std::next(it);
+}
+
+nebula::cpp2::ErrorCode MemEngine::saveCheckpoint(const std::string& dir) {
+  std::lock_guard<std::mutex> guard(checkpointLock_);
+  // Write from a snapshot, so the writers are not blocked during writing file
+  Snapshot snapshot;
+  uint64_t count;
+  {
+    folly::SharedMutex::ReadHolder rh(lock_);
+    snapshot.seq = acquireSnapshotLocked();
+    count = numKeys_;
+  }
+  SCOPE_EXIT {
+    releaseSnapshot(snapshot.seq);
+  };
+
+  auto path = FileUtils::joinPath(dir, kCheckpointFile);
+  auto tmpPath = path + ".tmp";
+  int fd = open(tmpPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Failed to open checkpoint \"" << tmpPath << "\" (" << errno
+                 << "): " << strerror(errno);
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  SCOPE_EXIT {
+    close(fd);
+  };
+
+  uint32_t crc = 0;
+  std::string buf;
+  buf.reserve(kWriteBufferSize);
+  auto flushBuffer = [&]() {
+    crc = folly::crc32c(reinterpret_cast<const uint8_t*>(buf.data()), buf.size(), crc);
+    bool ok = folly::writeFull(fd, buf.data(), buf.size()) == static_cast<ssize_t>(buf.size());
+    buf.clear();
+    return ok;
+  };
+  appendValue<uint32_t>(buf, kMagic);
+  appendValue<uint32_t>(buf, kVersion);
+  appendValue<uint64_t>(buf, count);
+  for (MemIter iter(this, &snapshot, "", std::nullopt); iter.valid(); iter.next()) {
+    auto key = iter.key();
+    auto value = iter.val();
+    appendValue<uint32_t>(buf, key.size());
+    buf.append(key.data(), key.size());
+    appendValue<uint32_t>(buf, value.size());
+    buf.append(value.data(), value.size());
+    if (buf.size() >= kWriteBufferSize && !flushBuffer()) {
+      break;
+    }
+  }
+  bool ok = flushBuffer();
+  appendValue<uint32_t>(buf, crc);
+  ok = ok && folly::writeFull(fd, buf.data(), buf.size()) == static_cast<ssize_t>(buf.size()) &&
+       ::fsync(fd) == 0;
+  if (!ok) {
+    LOG(WARNING) << "Failed to write checkpoint \"" << tmpPath << "\" (" << errno
+                 << "): " << strerror(errno);
+    unlink(tmpPath.c_str());
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  if (!FileUtils::rename(tmpPath, path)) {
+    return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
+  }
+  VLOG(1) << "Save " << count << " keys into checkpoint " << path;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+bool MemEngine::loadCheckpoint(const std::string& dir) {
+  auto path = FileUtils::joinPath(dir, kCheckpointFile);
+  if (!FileUtils::exist(path)) {
+    LOG(INFO) << "No checkpoint found in " << dir;
+    return true;
+  }
+  std::string content;
+  if (!folly::readFile(path.c_str(), content)) {
+    LOG(ERROR) << "Failed to read checkpoint \"" << path << "\" (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  if (content.size() < sizeof(uint32_t)) {
+    LOG(ERROR) << "The checkpoint \"" << path << "\" is truncated";
+    return false;
+  }
+  auto dataSize = content.size() - sizeof(uint32_t);
+  uint32_t crc;
+  memcpy(&crc, content.data() + dataSize, sizeof(uint32_t));
+  if (crc != folly::crc32c(reinterpret_cast<const uint8_t*>(content.data()), dataSize)) {
+    LOG(ERROR) << "Checksum mismatch of checkpoint \"" << path << "\"";
+    return false;
+  }
+
+  folly::StringPiece data(content.data(), dataSize);
+  uint32_t magic, version;
+  uint64_t count;
+  if (!readValue(data, &magic) || magic != kMagic || !readValue(data, &version) ||
+      version != kVersion || !readValue(data, &count)) {
+    LOG(ERROR) << "Invalid checkpoint \"" << path << "\"";
+    return false;
+  }
+  folly::SharedMutex::WriteHolder wh(lock_);
+  beginWriteLocked();
+  for (uint64_t i = 0; i < count; i++) {
+    std::string key, value;
+    if (!readString(data, &key) || !readString(data, &value)) {
+      LOG(ERROR) << "The checkpoint \"" << path << "\" is corrupted";
+      return false;
+    }
+    putLocked(std::move(key), std::move(value));
+  }
+  LOG(INFO) << "Load " << count << " keys from checkpoint " << path;
+  return true;
+}
+
+MemIter::MemIter(MemEngine* engine,
+                 const void* snapshot,
+                 std::string start,
+                 std::optional<std::string> end,
+                 std::string prefix)
+    : engine_(engine),
+      ownSnapshot_(snapshot == nullptr),
+      start_(std::move(start)),
+      end_(std::move(end)),
+      prefix_(std::move(prefix)) {
+  folly::SharedMutex::ReadHolder rh(engine_->lock_);
+  seq_ = ownSnapshot_ ? engine_->acquireSnapshotLocked()
+                      : reinterpret_cast<const MemEngine::Snapshot*>(snapshot)->seq;
+  cur_ = engine_->data_.lower_bound(start_);
+  settleLocked(true);
+}
+
+MemIter::~MemIter() {
+  if (ownSnapshot_) {
+    engine_->releaseSnapshot(seq_);
+  }
+}
+
+void MemIter::next() {
+  if (!valid_) {
+    return;
+  }
+  folly::SharedMutex::ReadHolder rh(engine_->lock_);
+  ++cur_;
+  settleLocked(true);
+}
+
+void MemIter::prev() {
+  if (!valid_) {
+    return;
+  }
+  folly::SharedMutex::ReadHolder rh(engine_->lock_);
+  if (cur_ == engine_->data_.begin()) {
+    valid_ = false;
+    value_.reset();
+    return;
+  }
+  --cur_;
+  settleLocked(false);
+}
+
+bool MemIter::inRange(const std::string& key) const {
+  return key >= start_ && (!end_.has_value() || key < *end_) &&
+         folly::StringPiece(key).startsWith(prefix_);
+}
+
+void MemIter::settleLocked(bool forward) {
+  const auto& data = engine_->data_;
+  while (cur_ != data.end() && inRange(cur_->first)) {
+    const auto* version = MemEngine::visible(cur_->second, seq_);
+    if (version != nullptr && version->value != nullptr) {
+      value_ = version->value;
+      valid_ = true;
+      return;
+    }
+    if (!forward && cur_ == data.begin()) {
+      break;
+    }
+    if (forward) {
+      ++cur_;
+    } else {
+      --cur_;
+    }
+  }
+  valid_ = false;
+  value_.reset();
+}
+
+}  // namespace kvstore
+}  // namespace nebula
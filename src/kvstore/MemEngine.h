@@ -0,0 +1,371 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_MEMENGINE_H_
+#define KVSTORE_MEMENGINE_H_
+
+#include <folly/SharedMutex.h>
+#include <folly/small_vector.h>
+
+#include <optional>
+
+#include "common/base/Base.h"
+#include "kvstore/KVEngine.h"
+#include "kvstore/KVIterator.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief Write batch of in-memory engine, the operations are applied in order when committed
+ */
+class MemWriteBatch : public WriteBatch {
+ public:
+  enum class OpType : uint8_t {
+    kPut,
+    kRemove,
+    kRemoveRange,
+  };
+
+  struct Op {
+    OpType type;
+    std::string first;
+    // value of put, or end key of removeRange
+    std::string second;
+  };
+
+  nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
+    ops_.emplace_back(Op{OpType::kPut, key.toString(), value.toString()});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
+    ops_.emplace_back(Op{OpType::kRemove, key.toString(), ""});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // Remove all keys in the range [start, end)
+  nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
+    ops_.emplace_back(Op{OpType::kRemoveRange, start.toString(), end.toString()});
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  std::vector<Op>& ops() {
+    return ops_;
+  }
+
+ private:
+  std::vector<Op> ops_;
+};
+
+/**
+ * @brief An implementation of KVEngine which keeps all data in an ordered map in memory, for
+ * small and latency-critical spaces.
+ *
+ * The engine doesn't have its own wal. The data are checkpointed into "<data root>/mem" when
+ * flush or backup is called (backup is triggered every rocksdb_backup_interval_secs by
+ * NebulaStore) and when the engine is closed. After restart, the latest checkpoint is loaded, and
+ * the logs committed after it are replayed from the raft wal, since the commit log id of each part
+ * is saved in the engine as well.
+ */
+class MemEngine : public KVEngine {
+  friend class MemIter;
+
+ public:
+  /**
+   * @brief Construct a new in-memory engine, and load the latest checkpoint if exists
+   *
+   * @param spaceId
+   * @param dataPath Data path, the checkpoint is saved in "dataPath/nebula/spaceId/mem"
+   * @param walPath Raft wal path
+   */
+  MemEngine(GraphSpaceID spaceId, const std::string& dataPath, const std::string& walPath = "");
+
+  ~MemEngine() override;
+
+  void stop() override {}
+
+  /**
+   * @brief Return path to a spaceId, e.g. "/DataPath/nebula/spaceId"
+   */
+  const char* getDataRoot() const override {
+    return dataPath_.c_str();
+  }
+
+  /**
+   * @brief Return the wal path
+   */
+  const char* getWalRoot() const override {
+    return walPath_.c_str();
+  }
+
+  /**
+   * @brief Get a snapshot, which only records the current sequence, the versions visible to it are
+   * kept until it is released
+   */
+  const void* GetSnapshot() override;
+
+  /**
+   * @brief Release the given snapshot
+   */
+  void ReleaseSnapshot(const void* snapshot) override;
+
+  std::unique_ptr<WriteBatch> startBatchWrite() override;
+
+  nebula::cpp2::ErrorCode commitBatchWrite(std::unique_ptr<WriteBatch> batch,
+                                           bool disableWAL,
+                                           bool sync,
+                                           bool wait) override;
+
+  /*********************
+   * Data retrieval
+   ********************/
+  nebula::cpp2::ErrorCode get(const std::string& key,
+                              std::string* value,
+                              const void* snapshot = nullptr) override;
+
+  std::vector<Status> multiGet(const std::vector<std::string>& keys,
+                               std::vector<std::string>* values) override;
+
+  // The scan mode is ignored, since there is no cache or io in memory
+
+  nebula::cpp2::ErrorCode range(const std::string& start,
+                                const std::string& end,
+                                std::unique_ptr<KVIterator>* iter,
+                                ScanMode mode = ScanMode::kDefault) override;
+
+  nebula::cpp2::ErrorCode prefix(const std::string& prefix,
+                                 std::unique_ptr<KVIterator>* iter,
+                                 const void* snapshot = nullptr,
+                                 ScanMode mode = ScanMode::kDefault) override;
+
+  nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
+                                          const std::string& prefix,
+                                          std::unique_ptr<KVIterator>* iter,
+                                          ScanMode mode = ScanMode::kDefault) override;
+
+  nebula::cpp2::ErrorCode scan(std::unique_ptr<KVIterator>* storageIter) override;
+
+  /*********************
+   * Data modification
+   ********************/
+  nebula::cpp2::ErrorCode put(std::string key, std::string value) override;
+
+  nebula::cpp2::ErrorCode multiPut(std::vector<KV> keyValues) override;
+
+  nebula::cpp2::ErrorCode remove(const std::string& key) override;
+
+  nebula::cpp2::ErrorCode multiRemove(std::vector<std::string> keys) override;
+
+  nebula::cpp2::ErrorCode removeRange(const std::string& start, const std::string& end) override;
+
+  /*********************
+   * Non-data operation
+   ********************/
+  void addPart(PartitionID partId, const Peers& raftPeers = {}) override;
+
+  nebula::cpp2::ErrorCode updatePart(PartitionID partId, const Peer& raftPeer) override;
+
+  void removePart(PartitionID partId) override;
+
+  std::vector<PartitionID> allParts() override;
+
+  std::map<PartitionID, Peers> balancePartPeers() override;
+
+  int32_t totalPartsNum() override {
+    return partsNum_;
+  }
+
+  /**
+   * @brief Ingest is not supported by in-memory engine
+   */
+  nebula::cpp2::ErrorCode ingest(const std::vector<std::string>& files,
+                                 bool verifyFileChecksum = false) override;
+
+  nebula::cpp2::ErrorCode setOption(const std::string& configKey,
+                                    const std::string& configValue) override;
+
+  nebula::cpp2::ErrorCode setDBOption(const std::string& configKey,
+                                      const std::string& configValue) override;
+
+  /**
+   * @brief Get engine property, "mem.num-keys", "mem.num-versions" and "mem.data-size" are
+   * supported
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> getProperty(const std::string& property) override;
+
+  /**
+   * @brief Nothing to compact in memory
+   */
+  nebula::cpp2::ErrorCode compact() override {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  /**
+   * @brief Save a checkpoint of all data
+   */
+  nebula::cpp2::ErrorCode flush() override;
+
+  /**
+   * @brief Save a checkpoint of all data into the given directory
+   */
+  nebula::cpp2::ErrorCode createCheckpoint(const std::string& checkpointPath) override;
+
+  /**
+   * @brief Backup table is only used by meta, which is not supported by in-memory engine
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> backupTable(
+      const std::string& path,
+      const std::string& tablePrefix,
+      std::function<bool(const folly::StringPiece& key)> filter) override;
+
+  /**
+   * @brief Save a checkpoint of all data, called periodically
+   */
+  nebula::cpp2::ErrorCode backup() override;
+
+ private:
+  struct Version {
+    uint64_t seq;
+    // nullptr means the key is removed
+    std::shared_ptr<const std::string> value;
+  };
+  // All versions of a key, the newest first
+  using Versions = folly::small_vector<Version, 1>;
+  using KVMap = std::map<std::string, Versions>;
+
+  struct Snapshot {
+    uint64_t seq;
+  };
+
+  /**
+   * @brief Return the newest version visible to the sequence, or nullptr if none
+   */
+  static const Version* visible(const Versions& versions, uint64_t seq);
+
+  // Must be called with the read or write lock held, so no write is in progress
+  uint64_t acquireSnapshotLocked();
+
+  void releaseSnapshot(uint64_t seq);
+
+  // The modifications below must be called with the write lock held, after beginWriteLocked
+  void beginWriteLocked();
+
+  void putLocked(std::string key, std::string value);
+
+  KVMap::iterator removeLocked(KVMap::iterator it);
+
+  void removeRangeLocked(const std::string& start, const std::string& end);
+
+  /**
+   * @brief Drop the versions of the key which no snapshot could see, and the key itself if only a
+   * removal seen by all snapshots is left.
+   *
+   * @return Iterator of the next key
+   */
+  KVMap::iterator pruneLocked(KVMap::iterator it);
+
+  /**
+   * @brief Write all data into the file atomically
+   */
+  nebula::cpp2::ErrorCode saveCheckpoint(const std::string& dir);
+
+  /**
+   * @brief Load data from the checkpoint file in dir
+   */
+  bool loadCheckpoint(const std::string& dir);
+
+ private:
+  std::string dataPath_;
+  std::string walPath_;
+  std::string checkpointDir_;
+
+  KVMap data_;
+  // Sequence of the latest write
+  uint64_t seq_{0};
+  // Number and size of all keys and values, the old versions are not counted
+  size_t numKeys_{0};
+  size_t dataSize_{0};
+  size_t numVersions_{0};
+  mutable folly::SharedMutex lock_;
+
+  // Sequences of the live snapshots and iterators
+  std::mutex snapshotLock_;
+  std::multiset<uint64_t> snapshots_;
+  // The oldest live snapshot when the current write starts
+  uint64_t oldest_{std::numeric_limits<uint64_t>::max()};
+  uint64_t sweptOldest_{std::numeric_limits<uint64_t>::max()};
+  // Keys which have versions kept for the snapshots, they are pruned once the oldest snapshot
+  // moves on. Note that a key is not necessarily in the map anymore.
+  std::set<std::string> stale_;
+
+  // Only one checkpoint is written at a time
+  std::mutex checkpointLock_;
+  std::atomic<int32_t> partsNum_{0};
+};
+
+/**
+ * @brief Iterator of in-memory engine. It reads the versions visible to its snapshot in place, so
+ * it is a consistent view without copying any data, and the read lock is only held while moving.
+ * The iterator must not outlive the engine.
+ */
+class MemIter : public KVIterator {
+ public:
+  /**
+   * @brief Iterate the keys in [start, end) which start with prefix
+   *
+   * @param engine
+   * @param snapshot Snapshot to read, the iterator takes its own one if nullptr
+   * @param start
+   * @param end std::nullopt means no upper bound
+   * @param prefix
+   */
+  MemIter(MemEngine* engine,
+          const void* snapshot,
+          std::string start,
+          std::optional<std::string> end,
+          std::string prefix = "");
+
+  ~MemIter() override;
+
+  bool valid() const override {
+    return valid_;
+  }
+
+  void next() override;
+
+  void prev() override;
+
+  folly::StringPiece key() const override {
+    return cur_->first;
+  }
+
+  folly::StringPiece val() const override {
+    return *value_;
+  }
+
+ private:
+  bool inRange(const std::string& key) const;
+
+  // Move to the first visible entry from cur_ in the direction, the read lock must be held
+  void settleLocked(bool forward);
+
+ private:
+  MemEngine* engine_;
+  uint64_t seq_;
+  bool ownSnapshot_;
+  std::string start_;
+  std::optional<std::string> end_;
+  std::string prefix_;
+  // The key of cur_ is never erased while it is visible to the snapshot, and the value is held
+  MemEngine::KVMap::const_iterator cur_;
+  std::shared_ptr<const std::string> value_;
+  bool valid_{false};
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+
+#endif  // KVSTORE_MEMENGINE_H_
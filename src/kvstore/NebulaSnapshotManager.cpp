@@ -108,7 +108,7 @@ bool NebulaSnapshotManager::accessTable(GraphSpaceID spaceId,
                                         int64_t& totalSize,
                                         kvstore::RateLimiter* rateLimiter) {
   std::unique_ptr<KVIterator> iter;
-  auto ret = store_->prefix(spaceId, partId, prefix, &iter, false, snapshot);
+  auto ret = store_->prefix(spaceId, partId, prefix, &iter, false, snapshot, ScanMode::kBulk);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "[spaceId:" << spaceId << ", partId:" << partId << "] access prefix failed"
             << ", error code:" << static_cast<int32_t>(ret);
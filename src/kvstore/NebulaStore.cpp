@@ -13,16 +13,33 @@
 
 #include "common/fs/FileUtils.h"
 #include "common/network/NetworkUtils.h"
+#include "common/thread/GenericThreadPool.h"
 #include "common/time/WallClock.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/MemEngine.h"
 #include "kvstore/NebulaSnapshotManager.h"
 #include "kvstore/RocksEngine.h"
 #include "kvstore/listener/elasticsearch/ESListener.h"
+#include "kvstore/stats/KVStats.h"
 
 DEFINE_string(engine_type, "rocksdb", "rocksdb, memory...");
+DEFINE_string(memory_engine_spaces,
+              "",
+              "Comma separated ids of the spaces which are kept in the in-memory engine, "
+              "no matter what engine_type is");
 DEFINE_int32(num_workers, 4, "Number of worker threads");
+DEFINE_bool(bg_workers_work_stealing,
+            false,
+            "Whether the background workers schedule tasks by work stealing, so a long task "
+            "(e.g. snapshot or wal cleanup) does not delay the tasks queued behind it");
 DEFINE_int32(clean_wal_interval_secs, 600, "interval to trigger clean expired wal");
 DEFINE_bool(auto_remove_invalid_space, true, "whether remove data of invalid space when restart");
+DEFINE_int32(num_part_loaders,
+             16,
+             "Number of threads to open the local parts in parallel when storaged starts");
+DEFINE_int32(raft_read_index_timeout_ms,
+             1000,
+             "Max milliseconds to wait for the leader's read index and the logs before it applied");
 
 DECLARE_bool(rocksdb_disable_wal);
 DECLARE_int32(rocksdb_backup_interval_secs);
@@ -47,7 +64,7 @@ NebulaStore::~NebulaStore() {
 bool NebulaStore::init() {
   LOG(INFO) << "Start the raft service...";
   bgWorkers_ = std::make_shared<thread::GenericThreadPool>();
-  bgWorkers_->start(FLAGS_num_workers, "nebula-bgworkers");
+  bgWorkers_->start(FLAGS_num_workers, "nebula-bgworkers", FLAGS_bg_workers_work_stealing);
   storeWorker_ = std::make_shared<thread::GenericWorker>();
   CHECK(storeWorker_->start());
   snapshot_.reset(new NebulaSnapshotManager(this));
@@ -72,6 +89,7 @@ bool NebulaStore::init() {
   storeWorker_->addDelayTask(FLAGS_clean_wal_interval_secs * 1000, &NebulaStore::cleanWAL, this);
   storeWorker_->addRepeatTask(
       FLAGS_rocksdb_backup_interval_secs * 1000, &NebulaStore::backup, this);
+  storeWorker_->addRepeatTask(1000, &NebulaStore::reportBgWorkersStats, this);
   LOG(INFO) << "Register handler...";
   options_.partMan_->registerHandler(this);
   return true;
@@ -80,6 +98,7 @@ bool NebulaStore::init() {
 void NebulaStore::loadPartFromDataPath() {
   CHECK(!!options_.partMan_);
   LOG(INFO) << "Scan the local path, and init the spaces_";
+  auto startTime = time::WallClock::fastNowInMilliSec();
 
   std::vector<folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>>> futures;
   std::vector<std::string> enginesPath;
@@ -125,6 +144,14 @@ void NebulaStore::loadPartFromDataPath() {
     ++index;
   }
 
+  // The parts of all engines are opened in parallel, recovering the wal and starting raft of
+  // each part are independent. The counter holds one more reference until all parts are added.
+  auto loaders = std::make_unique<thread::GenericThreadPool>();
+  loaders->start(std::max(FLAGS_num_part_loaders, 1), "nebula-part-loader");
+  std::atomic<size_t> counter(1);
+  folly::Baton<true, std::atomic> baton;
+  size_t numParts = 0;
+
   // avoid duplicate engine created
   std::unordered_set<std::pair<GraphSpaceID, PartitionID>> partSet;
   for (auto& spaceEngine : spaceEngines) {
@@ -224,15 +251,16 @@ void NebulaStore::loadPartFromDataPath() {
         enginePtr = spaceIt->second->engines_.back().get();
       }
 
-      std::atomic<size_t> counter(partRaftPeers.size());
-      folly::Baton<true, std::atomic> baton;
       LOG(INFO) << "Need to open " << partRaftPeers.size() << " parts of space " << spaceId;
+      numParts += partRaftPeers.size();
+      counter.fetch_add(partRaftPeers.size());
       for (auto& it : partRaftPeers) {
         auto& partId = it.first;
-        Peers& raftPeers = it.second;
 
-        bgWorkers_->addTask(
-            [spaceId, partId, &raftPeers, enginePtr, &counter, &baton, this]() mutable {
+        loaders->addTask(
+            [spaceId, partId, raftPeers = std::move(it.second), enginePtr, &counter, &baton, this]()
+                mutable {
+              auto partStartTime = time::WallClock::fastNowInMicroSec();
               // create part
               bool isLearner = false;
               std::vector<HostAddr> addrs;  // raft peers
@@ -276,16 +304,24 @@ void NebulaStore::loadPartFromDataPath() {
                   LOG(FATAL) << "Part already exists, partId " << partId;
                 }
               }
-              counter.fetch_sub(1);
-              if (counter.load() == 0) {
+              stats::StatsManager::addValue(
+                  kLoadPartLatencyUs, time::WallClock::fastNowInMicroSec() - partStartTime);
+              if (counter.fetch_sub(1) == 1) {
                 baton.post();
               }
             });
       }
-      baton.wait();
-      LOG(INFO) << "Load space " << spaceId << " complete";
     }
   }
+  if (counter.fetch_sub(1) != 1) {
+    baton.wait();
+  }
+  loaders->stop();
+  loaders->wait();
+
+  auto elapsed = time::WallClock::fastNowInMilliSec() - startTime;
+  stats::StatsManager::addValue(kLoadPartsFromDiskLatencyMs, elapsed);
+  LOG(INFO) << "Load " << numParts << " parts from disk complete in " << elapsed << "ms";
 }
 
 void NebulaStore::loadPartFromPartManager() {
@@ -351,11 +387,29 @@ void NebulaStore::stop() {
   }
 }
 
+// static
+bool NebulaStore::isMemEngineSpace(GraphSpaceID spaceId) {
+  if (FLAGS_memory_engine_spaces.empty()) {
+    return false;
+  }
+  std::vector<folly::StringPiece> ids;
+  folly::split(',', FLAGS_memory_engine_spaces, ids, true);
+  for (auto id : ids) {
+    auto ret = folly::tryTo<GraphSpaceID>(folly::trimWhitespace(id));
+    if (ret.hasValue() && ret.value() == spaceId) {
+      return true;
+    }
+  }
+  return false;
+}
+
 folly::Future<std::pair<GraphSpaceID, std::unique_ptr<KVEngine>>> NebulaStore::newEngineAsync(
     GraphSpaceID spaceId, const std::string& dataPath, const std::string& walPath) {
   return folly::via(folly::getGlobalIOExecutor().get(), [this, spaceId, dataPath, walPath]() {
     std::unique_ptr<KVEngine> engine;
-    if (FLAGS_engine_type == "rocksdb") {
+    if (FLAGS_engine_type == "memory" || isMemEngineSpace(spaceId)) {
+      engine = std::make_unique<MemEngine>(spaceId, dataPath, walPath);
+    } else if (FLAGS_engine_type == "rocksdb") {
       std::shared_ptr<KVCompactionFilterFactory> cfFactory = nullptr;
       if (options_.cffBuilder_ != nullptr) {
         cfFactory = options_.cffBuilder_->buildCfFactory(spaceId);
@@ -499,6 +553,7 @@ std::shared_ptr<Part> NebulaStore::newPart(GraphSpaceID spaceId,
                                      clientMan_,
                                      diskMan_,
                                      getSpaceVidLen(spaceId));
+  part->setCommitHook(options_.commitHook_);
   std::vector<HostAddr> peersWithoutMe;
   for (auto& p : raftPeers) {
     if (p != raftAddr_) {
@@ -805,12 +860,55 @@ std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGet(
   }
 }
 
+nebula::cpp2::ErrorCode NebulaStore::getPinned(GraphSpaceID spaceId,
+                                               PartitionID partId,
+                                               const std::string& key,
+                                               PinnedValue* value,
+                                               bool canReadFromFollower,
+                                               const void* snapshot) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return error(ret);
+  }
+  auto part = nebula::value(ret);
+  if (!checkLeader(part, canReadFromFollower)) {
+    return part->isLeader() ? nebula::cpp2::ErrorCode::E_LEADER_LEASE_FAILED
+                            : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+  }
+  return part->engine()->getPinned(key, value, snapshot);
+}
+
+std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGetPinned(
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    const std::vector<std::string>& keys,
+    std::vector<PinnedValue>* values,
+    bool canReadFromFollower) {
+  std::vector<Status> status;
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return {error(ret), status};
+  }
+  auto part = nebula::value(ret);
+  if (!checkLeader(part, canReadFromFollower)) {
+    return {nebula::cpp2::ErrorCode::E_LEADER_CHANGED, status};
+  }
+  status = part->engine()->multiGetPinned(keys, values);
+  auto allExist = std::all_of(status.begin(), status.end(), [](const auto& s) { return s.ok(); });
+  if (allExist) {
+    return {nebula::cpp2::ErrorCode::SUCCEEDED, status};
+  } else {
+    return {nebula::cpp2::ErrorCode::E_PARTIAL_RESULT, status};
+  }
+}
+
 nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
                                            PartitionID partId,
                                            const std::string& start,
                                            const std::string& end,
                                            std::unique_ptr<KVIterator>* iter,
-                                           bool canReadFromFollower) {
+                                           bool canReadFromFollower,
+                                           ScanMode mode) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -819,7 +917,7 @@ nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->range(start, end, iter);
+  return part->engine()->range(start, end, iter, mode);
 }
 
 nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
@@ -827,7 +925,8 @@ nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
                                             const std::string& prefix,
                                             std::unique_ptr<KVIterator>* iter,
                                             bool canReadFromFollower,
-                                            const void* snapshot) {
+                                            const void* snapshot,
+                                            ScanMode mode) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -836,7 +935,7 @@ nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->prefix(prefix, iter, snapshot);
+  return part->engine()->prefix(prefix, iter, snapshot, mode);
 }
 
 nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
@@ -844,7 +943,8 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
                                                      const std::string& start,
                                                      const std::string& prefix,
                                                      std::unique_ptr<KVIterator>* iter,
-                                                     bool canReadFromFollower) {
+                                                     bool canReadFromFollower,
+                                                     ScanMode mode) {
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     return error(ret);
@@ -853,7 +953,7 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->rangeWithPrefix(start, prefix, iter);
+  return part->engine()->rangeWithPrefix(start, prefix, iter, mode);
 }
 
 nebula::cpp2::ErrorCode NebulaStore::sync(GraphSpaceID spaceId, PartitionID partId) {
@@ -875,6 +975,27 @@ nebula::cpp2::ErrorCode NebulaStore::sync(GraphSpaceID spaceId, PartitionID part
   return ret;
 }
 
+void NebulaStore::asyncReadIndex(GraphSpaceID spaceId, PartitionID partId, KVCallback cb) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    cb(error(ret));
+    return;
+  }
+  auto part = nebula::value(ret);
+  part->readIndex()
+      .within(std::chrono::milliseconds(FLAGS_raft_read_index_timeout_ms))
+      .thenTry([spaceId, partId, cb = std::move(cb)](
+                   folly::Try<nebula::cpp2::ErrorCode>&& t) mutable {
+        if (t.hasException()) {
+          VLOG(2) << "Read index of space " << spaceId << " part " << partId
+                  << " failed: " << t.exception().what();
+          cb(nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION);
+          return;
+        }
+        cb(t.value());
+      });
+}
+
 void NebulaStore::asyncAppendBatch(GraphSpaceID spaceId,
                                    PartitionID partId,
                                    std::string&& batch,
@@ -1320,6 +1441,13 @@ void NebulaStore::cleanWAL() {
   }
 }
 
+void NebulaStore::reportBgWorkersStats() {
+  stats::StatsManager::addValue(kBgWorkersQueueDepth, bgWorkers_->queueDepth());
+  auto steals = bgWorkers_->numSteals();
+  stats::StatsManager::addValue(kNumBgWorkersSteals, steals - lastBgWorkersSteals_);
+  lastBgWorkersSteals_ = steals;
+}
+
 nebula::cpp2::ErrorCode NebulaStore::backup() {
   for (const auto& spaceEntry : spaces_) {
     for (const auto& engine : spaceEntry.second->engines_) {
@@ -23,6 +23,8 @@
 #include "kvstore/raftex/RaftexService.h"
 #include "kvstore/raftex/SnapshotManager.h"
 
+DECLARE_string(raft_client_compression);
+
 namespace nebula {
 namespace kvstore {
 
@@ -78,7 +80,7 @@ class NebulaStore : public KVStore, public Handler {
     CHECK_NOTNULL(options_.partMan_);
     clientMan_ =
         std::make_shared<thrift::ThriftClientManager<raftex::cpp2::RaftexServiceAsyncClient>>(
-            FLAGS_enable_ssl);
+            FLAGS_enable_ssl, FLAGS_raft_client_compression);
   }
 
   ~NebulaStore();
@@ -240,6 +242,42 @@ class NebulaStore : public KVStore, public Handler {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) override;
 
+  /**
+   * @brief Read a single key, the value refers to the engine's memory without copy if possible
+   *
+   * @param spaceId
+   * @param partId
+   * @param key
+   * @param value Pinned value, which must be released before the part is removed
+   * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode getPinned(GraphSpaceID spaceId,
+                                    PartitionID partId,
+                                    const std::string& key,
+                                    PinnedValue* value,
+                                    bool canReadFromFollower = false,
+                                    const void* snapshot = nullptr) override;
+
+  /**
+   * @brief Read a list of keys, the values refer to the engine's memory without copy if possible
+   *
+   * @param spaceId
+   * @param partId
+   * @param keys Keys to read
+   * @param values Pinned values, which must be released before the part is removed
+   * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @return Return std::vector<Status> when succeeded: Result status of each key, if key[i] does
+   * not exist, the i-th value in return value would be Status::KeyNotFound. Return ErrorCode when
+   * failed
+   */
+  std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> multiGetPinned(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      const std::vector<std::string>& keys,
+      std::vector<PinnedValue>* values,
+      bool canReadFromFollower = false) override;
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -249,6 +287,7 @@ class NebulaStore : public KVStore, public Handler {
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
    * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode range(GraphSpaceID spaceId,
@@ -256,7 +295,8 @@ class NebulaStore : public KVStore, public Handler {
                                 const std::string& start,
                                 const std::string& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool canReadFromFollower = false) override;
+                                bool canReadFromFollower = false,
+                                ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief To forbid to pass rvalue via the 'range' parameter.
@@ -266,7 +306,8 @@ class NebulaStore : public KVStore, public Handler {
                                 std::string&& start,
                                 std::string&& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool canReadFromFollower = false) override = delete;
+                                bool canReadFromFollower = false,
+                                ScanMode mode = ScanMode::kDefault) override = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -276,6 +317,7 @@ class NebulaStore : public KVStore, public Handler {
    * @param prefix Key of prefix to seek
    * @param iter Iterator of keys starts with 'prefix', returns by kv engine
    * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode prefix(GraphSpaceID spaceId,
@@ -283,7 +325,8 @@ class NebulaStore : public KVStore, public Handler {
                                  const std::string& prefix,
                                  std::unique_ptr<KVIterator>* iter,
                                  bool canReadFromFollower = false,
-                                 const void* snapshot = nullptr) override;
+                                 const void* snapshot = nullptr,
+                                 ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief To forbid to pass rvalue via the 'prefix' parameter.
@@ -293,7 +336,8 @@ class NebulaStore : public KVStore, public Handler {
                                  std::string&& prefix,
                                  std::unique_ptr<KVIterator>* iter,
                                  bool canReadFromFollower = false,
-                                 const void* snapshot = nullptr) override = delete;
+                                 const void* snapshot = nullptr,
+                                 ScanMode mode = ScanMode::kDefault) override = delete;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -304,6 +348,7 @@ class NebulaStore : public KVStore, public Handler {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
    * @param canReadFromFollower Whether check if current kvstore is leader of given partition
+   * @param mode Use ScanMode::kBulk for background and analytical full scans
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
@@ -311,7 +356,8 @@ class NebulaStore : public KVStore, public Handler {
                                           const std::string& start,
                                           const std::string& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override;
+                                          bool canReadFromFollower = false,
+                                          ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief To forbid to pass rvalue via the 'rangeWithPrefix' parameter.
@@ -321,7 +367,8 @@ class NebulaStore : public KVStore, public Handler {
                                           std::string&& start,
                                           std::string&& prefix,
                                           std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override = delete;
+                                          bool canReadFromFollower = false,
+                                          ScanMode mode = ScanMode::kDefault) override = delete;
 
   /**
    * @brief Synchronize the kvstore across multiple replica by add a empty log
@@ -332,6 +379,15 @@ class NebulaStore : public KVStore, public Handler {
    */
   nebula::cpp2::ErrorCode sync(GraphSpaceID spaceId, PartitionID partId) override;
 
+  /**
+   * @brief Wait until the replica could serve linearizable reads by raft read index
+   *
+   * @param spaceId
+   * @param partId
+   * @param cb Callback when the replica is ready to read or error occurs
+   */
+  void asyncReadIndex(GraphSpaceID spaceId, PartitionID partId, KVCallback cb) override;
+
   /**
    * @brief Write multiple key/values to kvstore asynchronously
    *
@@ -774,6 +830,11 @@ class NebulaStore : public KVStore, public Handler {
                          const std::unordered_map<std::string, std::string>& options,
                          bool isDbOption) override;
 
+  /**
+   * @brief Whether the space is listed in memory_engine_spaces, which is kept by MemEngine
+   */
+  static bool isMemEngineSpace(GraphSpaceID spaceId);
+
   /**
    * @brief Asynchronously start a new KV engine on specified path
    *
@@ -851,6 +912,11 @@ class NebulaStore : public KVStore, public Handler {
    */
   void cleanWAL();
 
+  /**
+   * @brief Report the queue depth and steals of background workers
+   */
+  void reportBgWorkersStats();
+
   /**
    * @brief Get the vertex id length of given space
    *
@@ -873,6 +939,7 @@ class NebulaStore : public KVStore, public Handler {
   std::shared_ptr<folly::IOThreadPoolExecutor> ioPool_;
   std::shared_ptr<thread::GenericWorker> storeWorker_;
   std::shared_ptr<thread::GenericThreadPool> bgWorkers_;
+  uint64_t lastBgWorkersSteals_{0};
   HostAddr storeSvcAddr_;
   std::shared_ptr<folly::Executor> workers_;
   HostAddr raftAddr_;
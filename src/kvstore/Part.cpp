@@ -220,6 +220,10 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
     stats::StatsManager::addValue(kCommitLogLatencyUs, elapsedTime);
   });
   auto batch = engine_->startBatchWrite();
+  std::unique_ptr<CommitHook::Applier> applier;
+  if (commitHook_ != nullptr) {
+    applier = commitHook_->begin(spaceId_, partId_, engine_, batch.get());
+  }
   LogID lastId = kNoCommitLogId;
   TermID lastTerm = kNoCommitLogTerm;
   while (iter->valid()) {
@@ -238,6 +242,9 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
         auto pieces = decodeMultiValues(log);
         DCHECK_EQ(2, pieces.size());
         auto code = batch->put(pieces[0], pieces[1]);
+        if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+          code = applier->put(pieces[0], pieces[1]);
+        }
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -252,6 +259,9 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           VLOG(4) << "OP_MULTI_PUT " << folly::hexlify(kvs[i])
                   << ", val = " << folly::hexlify(kvs[i + 1]);
           auto code = batch->put(kvs[i], kvs[i + 1]);
+          if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+            code = applier->put(kvs[i], kvs[i + 1]);
+          }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -262,6 +272,9 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       case OP_REMOVE: {
         auto key = decodeSingleValue(log);
         auto code = batch->remove(key);
+        if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+          code = applier->remove(key);
+        }
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -272,6 +285,9 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
         auto keys = decodeMultiValues(log);
         for (auto k : keys) {
           auto code = batch->remove(k);
+          if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+            code = applier->remove(k);
+          }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -297,8 +313,14 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
           auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
           if (op.first == BatchLogType::OP_BATCH_PUT) {
             code = batch->put(op.second.first, op.second.second);
+            if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+              code = applier->put(op.second.first, op.second.second);
+            }
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
             code = batch->remove(op.second.first);
+            if (code == nebula::cpp2::ErrorCode::SUCCEEDED && applier != nullptr) {
+              code = applier->remove(op.second.first);
+            }
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
             code = batch->removeRange(op.second.first, op.second.second);
           }
@@ -357,6 +379,9 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   auto code = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
   if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    if (applier != nullptr) {
+      applier->committed();
+    }
     return {code, lastId, lastTerm};
   } else {
     return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -397,6 +422,9 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     return {code, kNoSnapshotCount, kNoSnapshotSize};
   }
+  if (finished && commitHook_ != nullptr) {
+    commitHook_->load(spaceId_, partId_, engine_);
+  }
   return {code, count, size};
 }
 
@@ -549,6 +577,24 @@ nebula::cpp2::ErrorCode Part::cleanup() {
     return ret;
   }
 
+  const auto& fulltextPre = NebulaKeyUtils::fulltextPrefix(partId_);
+  ret = batch->removeRange(NebulaKeyUtils::firstKey(fulltextPre, 128),
+                           NebulaKeyUtils::lastKey(fulltextPre, 128));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    VLOG(3) << idStr_ << "Failed to encode removeRange() when cleanup fulltext, error "
+            << apache::thrift::util::enumNameSafe(ret);
+    return ret;
+  }
+
+  const auto& adjacencyPre = NebulaKeyUtils::adjacencyPrefix(partId_);
+  ret = batch->removeRange(NebulaKeyUtils::firstKey(adjacencyPre, 128),
+                           NebulaKeyUtils::lastKey(adjacencyPre, 128));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    VLOG(3) << idStr_ << "Failed to encode removeRange() when cleanup adjacency, error "
+            << apache::thrift::util::enumNameSafe(ret);
+    return ret;
+  }
+
   // todo(doodle): toss prime and double prime
 
   ret = batch->remove(NebulaKeyUtils::systemCommitKey(partId_));
@@ -557,8 +603,12 @@ nebula::cpp2::ErrorCode Part::cleanup() {
             << apache::thrift::util::enumNameSafe(ret);
     return ret;
   }
-  return engine_->commitBatchWrite(
+  ret = engine_->commitBatchWrite(
       std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, true);
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && commitHook_ != nullptr) {
+    commitHook_->load(spaceId_, partId_, engine_);
+  }
+  return ret;
 }
 
 nebula::cpp2::ErrorCode Part::metaCleanup() {
@@ -8,6 +8,7 @@
 
 #include "common/base/Base.h"
 #include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/CommitHook.h"
 #include "kvstore/Common.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/raftex/SnapshotManager.h"
@@ -188,6 +189,17 @@ class Part : public raftex::RaftPart {
     newLeaderCb_ = nullptr;
   }
 
+  /**
+   * @brief Set the hook which derives extra keys when logs are committed, must be called before
+   * the part starts. The hook loads its state of part here.
+   */
+  void setCommitHook(std::shared_ptr<CommitHook> hook) {
+    commitHook_ = std::move(hook);
+    if (commitHook_ != nullptr) {
+      commitHook_->load(spaceId_, partId_, engine_);
+    }
+  }
+
   /**
    * @brief Clean up all data about this part.
    */
@@ -346,6 +358,7 @@ class Part : public raftex::RaftPart {
   NewLeaderCallback newLeaderCb_ = nullptr;
   std::vector<LeaderChangeCB> leaderReadyCB_;
   std::vector<LeaderChangeCB> leaderLostCB_;
+  std::shared_ptr<CommitHook> commitHook_;
 
  private:
   KVEngine* engine_ = nullptr;
@@ -7,6 +7,8 @@
 
 #include <folly/String.h>
 #include <rocksdb/convenience.h>
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
 
 #include "common/base/Base.h"
 #include "common/fs/FileUtils.h"
@@ -25,6 +27,94 @@ namespace kvstore {
 using fs::FileType;
 using fs::FileUtils;
 
+namespace {
+// The key types kept in each column family besides the default one
+const std::vector<std::pair<std::string, std::vector<NebulaKeyType>>> kColumnFamilyKeyTypes = {
+    {kVertexColumnFamily, {NebulaKeyType::kTag_, NebulaKeyType::kVertex}},
+    {kEdgeColumnFamily, {NebulaKeyType::kEdge}},
+    {kIndexColumnFamily,
+     {NebulaKeyType::kIndex, NebulaKeyType::kFulltext, NebulaKeyType::kAdjacency}},
+};
+
+// Bulk scans read each block only once, so don't let them evict the hot blocks from block cache,
+// and read ahead since the blocks are read sequentially
+void setScanMode(rocksdb::ReadOptions& options, ScanMode mode) {
+  if (mode == ScanMode::kBulk) {
+    options.fill_cache = false;
+    options.readahead_size = FLAGS_rocksdb_bulk_scan_readahead_size;
+    options.async_io = FLAGS_rocksdb_bulk_scan_async_io;
+  }
+}
+
+// Replay a write batch into a RocksWriteBatch, so the keys are routed to their column families
+class RocksWriteBatchRouter : public rocksdb::WriteBatch::Handler {
+ public:
+  explicit RocksWriteBatchRouter(RocksWriteBatch* batch) : batch_(batch) {}
+
+  nebula::cpp2::ErrorCode route(rocksdb::WriteBatch* src) {
+    auto status = src->Iterate(this);
+    if (code_ != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code_;
+    }
+    if (!status.ok()) {
+      LOG(WARNING) << "Route write batch failed: " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+    return code_;
+  }
+
+  rocksdb::Status PutCF(uint32_t,
+                        const rocksdb::Slice& key,
+                        const rocksdb::Slice& value) override {
+    return check(batch_->put(toStringPiece(key), toStringPiece(value)));
+  }
+
+  rocksdb::Status DeleteCF(uint32_t, const rocksdb::Slice& key) override {
+    return check(batch_->remove(toStringPiece(key)));
+  }
+
+  rocksdb::Status DeleteRangeCF(uint32_t,
+                                const rocksdb::Slice& start,
+                                const rocksdb::Slice& end) override {
+    return check(batch_->removeRange(toStringPiece(start), toStringPiece(end)));
+  }
+
+ private:
+  rocksdb::Status check(nebula::cpp2::ErrorCode code) {
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      code_ = code;
+      return rocksdb::Status::Aborted();
+    }
+    return rocksdb::Status::OK();
+  }
+
+  RocksWriteBatch* batch_;
+  nebula::cpp2::ErrorCode code_{nebula::cpp2::ErrorCode::SUCCEEDED};
+};
+}  // namespace
+
+/***************************************
+ *
+ * Implementation of RocksColumnFamilyRouter
+ *
+ **************************************/
+std::vector<RocksColumnFamilyRouter::Range> RocksColumnFamilyRouter::split(
+    const std::string& start, const std::string& end) const {
+  std::vector<Range> ranges;
+  uint32_t first = start.empty() ? 0 : static_cast<uint8_t>(start[0]);
+  uint32_t last = end.empty() ? 0xFF : static_cast<uint8_t>(end[0]);
+  std::string from = start;
+  for (auto type = first; type < last; type++) {
+    if (cfs_[type] != cfs_[type + 1]) {
+      std::string to(1, static_cast<char>(type + 1));
+      ranges.emplace_back(Range{cfs_[type], std::move(from), to});
+      from = std::move(to);
+    }
+  }
+  ranges.emplace_back(Range{cfs_[last], std::move(from), end});
+  return ranges;
+}
+
 /***************************************
  *
  * Implementation of RocksEngine
@@ -74,12 +164,31 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     options.compaction_filter_factory = cfFactory;
   }
 
+  std::vector<rocksdb::ColumnFamilyDescriptor> cfDescs;
+  for (const auto& cfName : columnFamilies(path, options)) {
+    rocksdb::ColumnFamilyOptions cfOpts;
+    status = initRocksdbCFOptions(cfOpts, options, cfName);
+    CHECK(status.ok()) << status.ToString();
+    cfDescs.emplace_back(cfName, cfOpts);
+  }
+  options.create_missing_column_families = true;
   if (readonly) {
-    status = rocksdb::DB::OpenForReadOnly(options, path, &db);
+    status = rocksdb::DB::OpenForReadOnly(options, path, cfDescs, &cfHandles_, &db);
   } else {
-    status = rocksdb::DB::Open(options, path, &db);
+    status = rocksdb::DB::Open(options, path, cfDescs, &cfHandles_, &db);
   }
   CHECK(status.ok()) << status.ToString();
+  router_ = std::make_unique<RocksColumnFamilyRouter>(cfHandles_[0]);
+  for (auto* cf : cfHandles_) {
+    for (const auto& [cfName, types] : kColumnFamilyKeyTypes) {
+      if (cf->GetName() != cfName) {
+        continue;
+      }
+      for (auto type : types) {
+        router_->set(type, cf);
+      }
+    }
+  }
   if (!readonly && spaceId_ != kDefaultSpaceId /* only for storage*/) {
     rocksdb::ReadOptions readOptions;
     std::string dataVersionValue = "";
@@ -104,11 +213,41 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     extractorLen_ = sizeof(PartitionID);
   }
   partsNum_ = allParts().size();
-  LOG(INFO) << "open rocksdb on " << path;
+  LOG(INFO) << "open rocksdb on " << path << " with " << cfHandles_.size() << " column families";
 
   backup();
 }
 
+RocksEngine::~RocksEngine() {
+  for (auto* cf : cfHandles_) {
+    db_->DestroyColumnFamilyHandle(cf);
+  }
+  LOG(INFO) << "Release rocksdb on " << dataPath_;
+}
+
+std::vector<std::string> RocksEngine::columnFamilies(const std::string& path,
+                                                     const rocksdb::Options& options) {
+  std::vector<std::string> cfNames;
+  auto status = rocksdb::DB::ListColumnFamilies(options, path, &cfNames);
+  if (status.ok()) {
+    // The layout could not be changed once the db is created
+    bool separated = cfNames.size() > 1;
+    if (separated != FLAGS_rocksdb_separate_column_families && spaceId_ != kDefaultSpaceId) {
+      LOG(WARNING) << "Space " << spaceId_ << " is opened with " << cfNames.size()
+                   << " column families on disk, rocksdb_separate_column_families is ignored";
+    }
+    return cfNames;
+  }
+  cfNames = {rocksdb::kDefaultColumnFamilyName};
+  // The keys of meta are not typed, so they are always in the default one
+  if (FLAGS_rocksdb_separate_column_families && spaceId_ != kDefaultSpaceId) {
+    for (const auto& cf : kColumnFamilyKeyTypes) {
+      cfNames.emplace_back(cf.first);
+    }
+  }
+  return cfNames;
+}
+
 void RocksEngine::stop() {
   if (db_) {
     // Because we trigger compaction in WebService, we need to stop all
@@ -118,7 +257,7 @@ void RocksEngine::stop() {
 }
 
 std::unique_ptr<WriteBatch> RocksEngine::startBatchWrite() {
-  return std::make_unique<RocksWriteBatch>();
+  return std::make_unique<RocksWriteBatch>(router_.get());
 }
 
 nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
@@ -130,6 +269,15 @@ nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch
   options.sync = sync;
   options.no_slowdown = !wait;
   auto* b = static_cast<RocksWriteBatch*>(batch.get());
+  if (UNLIKELY(b->router() != router_.get() && router_->separated())) {
+    // The batch is not started by this engine, all keys are in the default column family
+    auto routed = std::make_unique<RocksWriteBatch>(router_.get());
+    auto ret = RocksWriteBatchRouter(routed.get()).route(b->data());
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    return commitBatchWrite(std::move(routed), disableWAL, sync, wait);
+  }
   rocksdb::Status status = db_->Write(options, b->data());
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -148,7 +296,7 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
   if (UNLIKELY(snapshot != nullptr)) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
-  rocksdb::Status status = db_->Get(options, rocksdb::Slice(key), value);
+  rocksdb::Status status = db_->Get(options, router_->route(key), rocksdb::Slice(key), value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else if (status.IsNotFound()) {
@@ -164,12 +312,14 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
                                           std::vector<std::string>* values) {
   memory::MemoryCheckOffGuard guard;
   rocksdb::ReadOptions options;
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs;
   std::vector<rocksdb::Slice> slices;
   for (size_t index = 0; index < keys.size(); index++) {
+    cfs.emplace_back(router_->route(keys[index]));
     slices.emplace_back(keys[index]);
   }
 
-  auto status = db_->MultiGet(options, slices, values);
+  auto status = db_->MultiGet(options, cfs, slices, values);
   std::vector<Status> ret;
   std::transform(status.begin(), status.end(), std::back_inserter(ret), [](const auto& s) {
     if (s.ok()) {
@@ -183,19 +333,76 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
   return ret;
 }
 
+nebula::cpp2::ErrorCode RocksEngine::getPinned(const std::string& key,
+                                               PinnedValue* value,
+                                               const void* snapshot) {
+  memory::MemoryCheckOffGuard guard;
+  rocksdb::ReadOptions options;
+  if (UNLIKELY(snapshot != nullptr)) {
+    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  }
+  value->Reset();
+  rocksdb::Status status = db_->Get(options, router_->route(key), rocksdb::Slice(key), value);
+  if (status.ok()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  } else if (status.IsNotFound()) {
+    VLOG(4) << "Get: " << key << " Not Found";
+    return nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND;
+  } else {
+    VLOG(4) << "Get Failed: " << key << " " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+}
+
+std::vector<Status> RocksEngine::multiGetPinned(const std::vector<std::string>& keys,
+                                                std::vector<PinnedValue>* values) {
+  memory::MemoryCheckOffGuard guard;
+  rocksdb::ReadOptions options;
+  std::vector<rocksdb::ColumnFamilyHandle*> cfs;
+  std::vector<rocksdb::Slice> slices;
+  cfs.reserve(keys.size());
+  slices.reserve(keys.size());
+  for (const auto& key : keys) {
+    cfs.emplace_back(router_->route(key));
+    slices.emplace_back(key);
+  }
+  values->clear();
+  values->resize(keys.size());
+  std::vector<rocksdb::Status> status(keys.size());
+
+  db_->MultiGet(options, keys.size(), cfs.data(), slices.data(), values->data(), status.data());
+  std::vector<Status> ret;
+  ret.reserve(keys.size());
+  std::transform(status.begin(), status.end(), std::back_inserter(ret), [](const auto& s) {
+    if (s.ok()) {
+      return Status::OK();
+    } else if (s.IsNotFound()) {
+      return Status::KeyNotFound();
+    } else {
+      return Status::Error();
+    }
+  });
+  return ret;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
                                            const std::string& end,
-                                           std::unique_ptr<KVIterator>* storageIter) {
+                                           std::unique_ptr<KVIterator>* storageIter,
+                                           ScanMode mode) {
   memory::MemoryCheckOffGuard guard;
+  if (router_->separated() && start < end && router_->split(start, end).size() > 1) {
+    return concatRange(start, end, nullptr, storageIter, mode);
+  }
   storageIter->reset(new RocksRangeIter(start, end));
   rocksdb::ReadOptions options;
+  setScanMode(options, mode);
   options.iterate_upper_bound = dynamic_cast<RocksRangeIter*>(storageIter->get())->upperBound();
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, router_->route(start)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksRangeIter*>(storageIter->get())->reset(std::move(iter));
@@ -205,29 +412,35 @@ nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
 
 nebula::cpp2::ErrorCode RocksEngine::prefix(const std::string& prefix,
                                             std::unique_ptr<KVIterator>* storageIter,
-                                            const void* snapshot) {
+                                            const void* snapshot,
+                                            ScanMode mode) {
   memory::MemoryCheckOffGuard guard;
+  if (prefix.empty() && router_->separated()) {
+    return concatRange("", "", snapshot, storageIter, mode);
+  }
   // In fact, we don't need to check prefix.size() >= extractorLen_, which is caller's duty to make
   // sure the prefix bloom filter exists. But this is quite error-prone, so we do a check here.
   if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen_) {
-    return prefixWithExtractor(prefix, snapshot, storageIter);
+    return prefixWithExtractor(prefix, snapshot, storageIter, mode);
   } else {
-    return prefixWithoutExtractor(prefix, snapshot, storageIter);
+    return prefixWithoutExtractor(prefix, snapshot, storageIter, mode);
   }
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefixWithExtractor(const std::string& prefix,
                                                          const void* snapshot,
-                                                         std::unique_ptr<KVIterator>* storageIter) {
+                                                         std::unique_ptr<KVIterator>* storageIter,
+                                                         ScanMode mode) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
+  setScanMode(options, mode);
   options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
   if (UNLIKELY(snapshot != nullptr)) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
   options.prefix_same_as_start = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, router_->route(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(prefix));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -236,17 +449,21 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithExtractor(const std::string& pref
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
-    const std::string& prefix, const void* snapshot, std::unique_ptr<KVIterator>* storageIter) {
+    const std::string& prefix,
+    const void* snapshot,
+    std::unique_ptr<KVIterator>* storageIter,
+    ScanMode mode) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
+  setScanMode(options, mode);
   options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
   if (snapshot != nullptr) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
   // prefix_same_as_start is false by default
   options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, router_->route(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(prefix));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -256,17 +473,22 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
 
 nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
                                                      const std::string& prefix,
-                                                     std::unique_ptr<KVIterator>* storageIter) {
+                                                     std::unique_ptr<KVIterator>* storageIter,
+                                                     ScanMode mode) {
   memory::MemoryCheckOffGuard guard;
+  if (prefix.empty() && router_->separated()) {
+    return concatRange(start, "", nullptr, storageIter, mode);
+  }
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
+  setScanMode(options, mode);
   options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, router_->route(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -276,6 +498,9 @@ nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
 
 nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIter) {
   memory::MemoryCheckOffGuard guard;
+  if (router_->separated()) {
+    return concatRange("", "", nullptr, storageIter);
+  }
   rocksdb::ReadOptions options;
   options.total_order_seek = true;
   std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
@@ -284,10 +509,40 @@ nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIt
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+nebula::cpp2::ErrorCode RocksEngine::concatRange(const std::string& start,
+                                                 const std::string& end,
+                                                 const void* snapshot,
+                                                 std::unique_ptr<KVIterator>* storageIter,
+                                                 ScanMode mode) {
+  auto* concatIter = new RocksConcatIter(router_->split(start, end));
+  storageIter->reset(concatIter);
+  for (const auto& range : concatIter->ranges()) {
+    rocksdb::ReadOptions options;
+    setScanMode(options, mode);
+    options.total_order_seek = true;
+    if (snapshot != nullptr) {
+      options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+    }
+    if (range.end.empty()) {
+      std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, range.cf));
+      iter->Seek(rocksdb::Slice(range.start));
+      concatIter->add(std::make_unique<RocksCommonIter>(std::move(iter)));
+    } else {
+      auto rangeIter = std::make_unique<RocksRangeIter>(range.start, range.end);
+      options.iterate_upper_bound = rangeIter->upperBound();
+      std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, range.cf));
+      iter->Seek(rocksdb::Slice(range.start));
+      rangeIter->reset(std::move(iter));
+      concatIter->add(std::move(rangeIter));
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  rocksdb::Status status = db_->Put(options, key, value);
+  rocksdb::Status status = db_->Put(options, router_->route(key), key, value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -299,7 +554,7 @@ nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
 nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
   rocksdb::WriteBatch updates(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keyValues.size(); i++) {
-    updates.Put(keyValues[i].first, keyValues[i].second);
+    updates.Put(router_->route(keyValues[i].first), keyValues[i].first, keyValues[i].second);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -315,7 +570,7 @@ nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
 nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->Delete(options, key);
+  auto status = db_->Delete(options, router_->route(key), key);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -327,7 +582,7 @@ nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
 nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys) {
   rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keys.size(); i++) {
-    deletes.Delete(keys[i]);
+    deletes.Delete(router_->route(keys[i]), keys[i]);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -343,7 +598,16 @@ nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys)
 nebula::cpp2::ErrorCode RocksEngine::removeRange(const std::string& start, const std::string& end) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+  rocksdb::Status status;
+  if (router_->separated() && start < end) {
+    rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
+    for (const auto& range : router_->split(start, end)) {
+      deletes.DeleteRange(range.cf, range.start, range.end);
+    }
+    status = db_->Write(options, &deletes);
+  } else {
+    status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -477,7 +741,42 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   rocksdb::IngestExternalFileOptions options;
   options.move_files = FLAGS_move_files;
   options.verify_file_checksum = verifyFileChecksum;
-  rocksdb::Status status = db_->IngestExternalFile(files, options);
+  if (!router_->separated()) {
+    rocksdb::Status status = db_->IngestExternalFile(files, options);
+    if (status.ok()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    } else {
+      LOG(WARNING) << "Ingest Failed: " << status.ToString();
+      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    }
+  }
+
+  auto tmpDir = folly::stringPrintf("%s/ingest_split", dataPath_.c_str());
+  SCOPE_EXIT {
+    if (FileUtils::exist(tmpDir)) {
+      FileUtils::remove(tmpDir.c_str(), true);
+    }
+  };
+  std::unordered_map<rocksdb::ColumnFamilyHandle*, std::vector<std::string>> cfFiles;
+  for (const auto& file : files) {
+    auto code = routeSstFile(file, tmpDir, &cfFiles);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+  }
+  // Ingest the files of all column families atomically
+  std::vector<rocksdb::IngestExternalFileArg> args;
+  for (auto& [cf, cfPaths] : cfFiles) {
+    rocksdb::IngestExternalFileArg arg;
+    arg.column_family = cf;
+    arg.external_files = std::move(cfPaths);
+    arg.options = options;
+    args.emplace_back(std::move(arg));
+  }
+  if (args.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  rocksdb::Status status = db_->IngestExternalFiles(args);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -486,11 +785,82 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::routeSstFile(
+    const std::string& file,
+    const std::string& tmpDir,
+    std::unordered_map<rocksdb::ColumnFamilyHandle*, std::vector<std::string>>* cfFiles) {
+  rocksdb::Options options;
+  rocksdb::SstFileReader reader(options);
+  auto status = reader.Open(file);
+  if (!status.ok()) {
+    LOG(WARNING) << "Open sst file " << file << " failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+  iter->SeekToFirst();
+  if (!iter->Valid()) {
+    // empty file
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  auto first = iter->key().ToString();
+  iter->SeekToLast();
+  auto last = iter->key().ToString();
+  if (router_->split(first, last).size() == 1) {
+    (*cfFiles)[router_->route(first)].emplace_back(file);
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // The keys are across column families, write them into one file for each column family
+  if (!FileUtils::exist(tmpDir) && !FileUtils::makeDir(tmpDir)) {
+    LOG(WARNING) << "Make dir " << tmpDir << " failed";
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  std::unordered_map<rocksdb::ColumnFamilyHandle*, std::unique_ptr<rocksdb::SstFileWriter>> writers;
+  for (iter->SeekToFirst(); iter->Valid() && status.ok(); iter->Next()) {
+    auto key = iter->key();
+    auto* cf = router_->route(folly::StringPiece(key.data(), key.size()));
+    auto& writer = writers[cf];
+    if (writer == nullptr) {
+      writer = std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), options, cf);
+      auto path = folly::stringPrintf("%s/%s.%s",
+                                      tmpDir.c_str(),
+                                      FileUtils::basename(file.c_str()).c_str(),
+                                      cf->GetName().c_str());
+      status = writer->Open(path);
+      if (!status.ok()) {
+        break;
+      }
+      (*cfFiles)[cf].emplace_back(std::move(path));
+    }
+    status = writer->Put(key, iter->value());
+  }
+  if (status.ok()) {
+    status = iter->status();
+  }
+  for (auto& [cf, writer] : writers) {
+    auto s = writer->Finish();
+    if (status.ok()) {
+      status = s;
+    }
+  }
+  if (!status.ok()) {
+    LOG(WARNING) << "Split sst file " << file << " failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::setOption(const std::string& configKey,
                                                const std::string& configValue) {
   std::unordered_map<std::string, std::string> configOptions = {{configKey, configValue}};
 
-  rocksdb::Status status = db_->SetOptions(configOptions);
+  rocksdb::Status status;
+  for (auto* cf : cfHandles_) {
+    status = db_->SetOptions(cf, configOptions);
+    if (!status.ok()) {
+      break;
+    }
+  }
   if (status.ok()) {
     LOG(INFO) << "SetOption Succeeded: " << configKey << ":" << configValue;
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -516,6 +886,11 @@ nebula::cpp2::ErrorCode RocksEngine::setDBOption(const std::string& configKey,
 
 ErrorOr<nebula::cpp2::ErrorCode, std::string> RocksEngine::getProperty(
     const std::string& property) {
+  uint64_t intValue;
+  if (router_->separated() && db_->GetAggregatedIntProperty(property, &intValue)) {
+    // Sum up the property of all column families
+    return folly::to<std::string>(intValue);
+  }
   std::string value;
   if (!db_->GetProperty(property, &value)) {
     return nebula::cpp2::ErrorCode::E_INVALID_PARM;
@@ -528,7 +903,13 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   rocksdb::CompactRangeOptions options;
   options.change_level = FLAGS_rocksdb_compact_change_level;
   options.target_level = FLAGS_rocksdb_compact_target_level;
-  rocksdb::Status status = db_->CompactRange(options, nullptr, nullptr);
+  rocksdb::Status status;
+  for (auto* cf : cfHandles_) {
+    status = db_->CompactRange(options, cf, nullptr, nullptr);
+    if (!status.ok()) {
+      break;
+    }
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -539,7 +920,7 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
 
 nebula::cpp2::ErrorCode RocksEngine::flush() {
   rocksdb::FlushOptions options;
-  rocksdb::Status status = db_->Flush(options);
+  rocksdb::Status status = db_->Flush(options, cfHandles_);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
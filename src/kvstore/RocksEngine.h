@@ -11,6 +11,7 @@
 #include <rocksdb/utilities/backup_engine.h>
 #include <rocksdb/utilities/checkpoint.h>
 
+#include <array>
 #include <memory>
 
 #include "common/base/Base.h"
@@ -173,6 +174,116 @@ class RocksCommonIter : public KVIterator {
   std::unique_ptr<rocksdb::Iterator> iter_;
 };
 
+/**
+ * @brief Route the keys to rocksdb column families by NebulaKeyType. The type is the lowest byte
+ * of the leading int32 of a key, i.e. the first byte in little endian, so a key or a non-empty
+ * prefix always belongs to exactly one column family.
+ */
+class RocksColumnFamilyRouter {
+ public:
+  /**
+   * @brief A range of keys [start, end) in one column family, end is unbounded if it is empty
+   */
+  struct Range {
+    rocksdb::ColumnFamilyHandle* cf;
+    std::string start;
+    std::string end;
+  };
+
+  explicit RocksColumnFamilyRouter(rocksdb::ColumnFamilyHandle* defaultCf) {
+    cfs_.fill(defaultCf);
+  }
+
+  /**
+   * @brief Keep the keys of given type in the column family
+   */
+  void set(NebulaKeyType type, rocksdb::ColumnFamilyHandle* cf) {
+    cfs_[static_cast<uint8_t>(type)] = cf;
+    separated_ = true;
+  }
+
+  /**
+   * @brief Whether there are column families other than the default one
+   */
+  bool separated() const {
+    return separated_;
+  }
+
+  rocksdb::ColumnFamilyHandle* route(folly::StringPiece key) const {
+    return key.empty() ? cfs_[0] : cfs_[static_cast<uint8_t>(key[0])];
+  }
+
+  /**
+   * @brief Split [start, end) into ranges in key order, each range is in one column family
+   *
+   * @param start Start key, inclusive
+   * @param end End key, exclusive, unbounded if it is empty
+   * @return std::vector<Range>
+   */
+  std::vector<Range> split(const std::string& start, const std::string& end) const;
+
+ private:
+  std::array<rocksdb::ColumnFamilyHandle*, 256> cfs_;
+  bool separated_{false};
+};
+
+/**
+ * @brief Iterate the ranges of several column families in order, which are built by
+ * RocksColumnFamilyRouter::split. Note that prev only moves inside the current range.
+ */
+class RocksConcatIter : public KVIterator {
+ public:
+  explicit RocksConcatIter(std::vector<RocksColumnFamilyRouter::Range> ranges)
+      : ranges_(std::move(ranges)) {}
+
+  bool valid() const override {
+    return idx_ < iters_.size() && iters_[idx_]->valid();
+  }
+
+  void next() override {
+    iters_[idx_]->next();
+    skipInvalid();
+  }
+
+  void prev() override {
+    iters_[idx_]->prev();
+  }
+
+  folly::StringPiece key() const override {
+    return iters_[idx_]->key();
+  }
+
+  folly::StringPiece val() const override {
+    return iters_[idx_]->val();
+  }
+
+  /**
+   * @brief The ranges to iterate, the child iterators could refer to the keys in them
+   */
+  const std::vector<RocksColumnFamilyRouter::Range>& ranges() const {
+    return ranges_;
+  }
+
+  /**
+   * @brief Add the iterator of next range, then skip to the first valid one when all added
+   */
+  void add(std::unique_ptr<KVIterator> iter) {
+    iters_.emplace_back(std::move(iter));
+    skipInvalid();
+  }
+
+ private:
+  void skipInvalid() {
+    while (idx_ < iters_.size() && !iters_[idx_]->valid()) {
+      idx_++;
+    }
+  }
+
+  std::vector<RocksColumnFamilyRouter::Range> ranges_;
+  std::vector<std::unique_ptr<KVIterator>> iters_;
+  size_t idx_{0};
+};
+
 /***************************************
  *
  * Implementation of WriteBatch
@@ -181,14 +292,24 @@ class RocksCommonIter : public KVIterator {
 class RocksWriteBatch : public WriteBatch {
  private:
   rocksdb::WriteBatch batch_;
+  // Column families of the engine which the batch is written to, all keys are written into the
+  // default column family if it is null
+  const RocksColumnFamilyRouter* router_{nullptr};
 
  public:
-  RocksWriteBatch() : batch_(FLAGS_rocksdb_batch_size) {}
+  explicit RocksWriteBatch(const RocksColumnFamilyRouter* router = nullptr)
+      : batch_(FLAGS_rocksdb_batch_size), router_(router) {}
 
   virtual ~RocksWriteBatch() = default;
 
   nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
-    if (batch_.Put(toSlice(key), toSlice(value)).ok()) {
+    rocksdb::Status status;
+    if (router_ == nullptr) {
+      status = batch_.Put(toSlice(key), toSlice(value));
+    } else {
+      status = batch_.Put(router_->route(key), toSlice(key), toSlice(value));
+    }
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -196,7 +317,13 @@ class RocksWriteBatch : public WriteBatch {
   }
 
   nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
-    if (batch_.Delete(toSlice(key)).ok()) {
+    rocksdb::Status status;
+    if (router_ == nullptr) {
+      status = batch_.Delete(toSlice(key));
+    } else {
+      status = batch_.Delete(router_->route(key), toSlice(key));
+    }
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -205,16 +332,28 @@ class RocksWriteBatch : public WriteBatch {
 
   // Remove all keys in the range [start, end)
   nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
-    if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
-      return nebula::cpp2::ErrorCode::SUCCEEDED;
-    } else {
-      return nebula::cpp2::ErrorCode::E_UNKNOWN;
+    if (router_ == nullptr || !router_->separated() || start >= end) {
+      if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      } else {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+    }
+    for (const auto& range : router_->split(start.str(), end.str())) {
+      if (!batch_.DeleteRange(range.cf, range.start, range.end).ok()) {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
     }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
   rocksdb::WriteBatch* data() {
     return &batch_;
   }
+
+  const RocksColumnFamilyRouter* router() const {
+    return router_;
+  }
 };
 /**
  * @brief An implementation of KVEngine based on Rocksdb
@@ -243,9 +382,7 @@ class RocksEngine : public KVEngine {
               std::shared_ptr<rocksdb::CompactionFilterFactory> cfFactory = nullptr,
               bool readonly = false);
 
-  ~RocksEngine() {
-    LOG(INFO) << "Release rocksdb on " << dataPath_;
-  }
+  ~RocksEngine();
 
   void stop() override;
 
@@ -329,28 +466,55 @@ class RocksEngine : public KVEngine {
   std::vector<Status> multiGet(const std::vector<std::string>& keys,
                                std::vector<std::string>* values) override;
 
+  /**
+   * @brief Read a single key, the value refers to the block cache or memtable without copy
+   *
+   * @param key Key to read
+   * @param value Pointer of pinned value
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode getPinned(const std::string& key,
+                                    PinnedValue* value,
+                                    const void* snapshot = nullptr) override;
+
+  /**
+   * @brief Read a list of keys by batched MultiGet, the values refer to the block cache or memtable
+   * without copy
+   *
+   * @param keys Keys to read
+   * @param values Pointers of pinned values
+   * @return std::vector<Status> Result status of each key, if key[i] does not exist, the i-th value
+   * in return value would be Status::KeyNotFound
+   */
+  std::vector<Status> multiGetPinned(const std::vector<std::string>& keys,
+                                     std::vector<PinnedValue>* values) override;
+
   /**
    * @brief Get all results in range [start, end)
    *
    * @param start Start key, inclusive
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end)
+   * @param mode Bulk scan doesn't fill block cache and reads ahead
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode range(const std::string& start,
                                 const std::string& end,
-                                std::unique_ptr<KVIterator>* iter) override;
+                                std::unique_ptr<KVIterator>* iter,
+                                ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
    *
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix'
+   * @param mode Bulk scan doesn't fill block cache and reads ahead
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode prefix(const std::string& prefix,
                                  std::unique_ptr<KVIterator>* iter,
-                                 const void* snapshot = nullptr) override;
+                                 const void* snapshot = nullptr,
+                                 ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -358,11 +522,13 @@ class RocksEngine : public KVEngine {
    * @param start Start key, inclusive
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start'
+   * @param mode Bulk scan doesn't fill block cache and reads ahead
    * @return nebula::cpp2::ErrorCode
    */
   nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                           const std::string& prefix,
-                                          std::unique_ptr<KVIterator>* iter) override;
+                                          std::unique_ptr<KVIterator>* iter,
+                                          ScanMode mode = ScanMode::kDefault) override;
 
   /**
    * @brief Prefix scan with prefix extractor
@@ -373,7 +539,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode prefixWithExtractor(const std::string& prefix,
                                               const void* snapshot,
-                                              std::unique_ptr<KVIterator>* storageIter);
+                                              std::unique_ptr<KVIterator>* storageIter,
+                                              ScanMode mode = ScanMode::kDefault);
 
   /**
    * @brief Prefix scan without prefix extractor, use total order seek
@@ -384,7 +551,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode prefixWithoutExtractor(const std::string& prefix,
                                                  const void* snapshot,
-                                                 std::unique_ptr<KVIterator>* storageIter);
+                                                 std::unique_ptr<KVIterator>* storageIter,
+                                                 ScanMode mode = ScanMode::kDefault);
 
   /**
    * @brief Scan all data in rocksdb
@@ -594,11 +762,53 @@ class RocksEngine : public KVEngine {
    */
   void openBackupEngine(GraphSpaceID spaceId);
 
+  /**
+   * @brief Return the column families to open. Use the ones on disk if the db exists, otherwise
+   * decided by rocksdb_separate_column_families
+   *
+   * @param path Rocksdb data path
+   * @param options Rocksdb options
+   * @return std::vector<std::string> Column family names, the first one is default
+   */
+  std::vector<std::string> columnFamilies(const std::string& path, const rocksdb::Options& options);
+
+  /**
+   * @brief Iterate the range [start, end) which crosses column families
+   *
+   * @param start Start key, inclusive
+   * @param end End key, exclusive, unbounded if it is empty
+   * @param snapshot Rocksdb snapshot
+   * @param storageIter Iterator of the range
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode concatRange(const std::string& start,
+                                      const std::string& end,
+                                      const void* snapshot,
+                                      std::unique_ptr<KVIterator>* storageIter,
+                                      ScanMode mode = ScanMode::kDefault);
+
+  /**
+   * @brief Find the column family of the keys in a sst file. If the keys belong to several column
+   * families, split it into files of each column family in tmpDir.
+   *
+   * @param file Sst file path
+   * @param tmpDir Dir to write the split files
+   * @param cfFiles Files to ingest of each column family
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode routeSstFile(
+      const std::string& file,
+      const std::string& tmpDir,
+      std::unordered_map<rocksdb::ColumnFamilyHandle*, std::vector<std::string>>* cfFiles);
+
  private:
   GraphSpaceID spaceId_;
   std::string dataPath_;
   std::string walPath_;
   std::unique_ptr<rocksdb::DB> db_{nullptr};
+  // All column family handles, the first one is default
+  std::vector<rocksdb::ColumnFamilyHandle*> cfHandles_;
+  std::unique_ptr<RocksColumnFamilyRouter> router_;
   std::string backupPath_;
   std::unique_ptr<rocksdb::BackupEngine> backupDb_{nullptr};
   int32_t partsNum_ = -1;
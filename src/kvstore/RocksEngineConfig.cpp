@@ -38,6 +38,39 @@ DEFINE_string(rocksdb_block_based_table_options,
               "{}",
               "json string of BlockBasedTableOptions, all keys and values are string");
 
+DEFINE_bool(rocksdb_separate_column_families,
+            false,
+            "Whether to keep vertices, edges and indexes of a space in separate column families, "
+            "only takes effect when the space is created on this storaged");
+
+// [CFOptions "vertex"], [CFOptions "edge"] and [CFOptions "index"]
+DEFINE_string(rocksdb_vertex_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the vertex column family, which overrides "
+              "rocksdb_column_family_options");
+DEFINE_string(rocksdb_edge_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the edge column family, which overrides "
+              "rocksdb_column_family_options");
+DEFINE_string(rocksdb_index_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions of the index column family, which overrides "
+              "rocksdb_column_family_options");
+
+// [TableOptions/BlockBasedTable "vertex"], [... "edge"] and [... "index"]
+DEFINE_string(rocksdb_vertex_block_based_table_options,
+              "{}",
+              "json string of BlockBasedTableOptions of the vertex column family, which overrides "
+              "rocksdb_block_based_table_options. Whole key bloom filter is on by default");
+DEFINE_string(rocksdb_edge_block_based_table_options,
+              "{}",
+              "json string of BlockBasedTableOptions of the edge column family, which overrides "
+              "rocksdb_block_based_table_options");
+DEFINE_string(rocksdb_index_block_based_table_options,
+              "{}",
+              "json string of BlockBasedTableOptions of the index column family, which overrides "
+              "rocksdb_block_based_table_options. Bloom filter is off by default");
+
 DEFINE_int32(rocksdb_batch_size, 4 * 1024, "default reserved bytes for one batch operation");
 
 /*
@@ -122,6 +155,15 @@ DEFINE_int32(rocksdb_backup_interval_secs,
              300,
              "Rocksdb backup directory, only used in PlainTable format");
 
+DEFINE_int64(rocksdb_bulk_scan_readahead_size,
+             2 * 1024 * 1024,
+             "Readahead size in bytes of bulk scans, which are used by full scans such as scan "
+             "vertex/edge, stats, rebuild index and snapshot, 0 means rocksdb's auto readahead");
+
+DEFINE_bool(rocksdb_bulk_scan_async_io,
+            true,
+            "Whether bulk scans prefetch the next blocks asynchronously");
+
 DEFINE_bool(rocksdb_enable_kv_separation,
             false,
             "Whether or not to enable BlobDB (RocksDB key-value separation support)");
@@ -361,6 +403,66 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
   return s;
 }
 
+rocksdb::Status initRocksdbCFOptions(rocksdb::ColumnFamilyOptions& cfOpts,
+                                     const rocksdb::Options& baseOpts,
+                                     const std::string& cfName) {
+  rocksdb::ColumnFamilyOptions baseCfOpts(baseOpts);
+  if (cfName == rocksdb::kDefaultColumnFamilyName) {
+    cfOpts = baseCfOpts;
+    return rocksdb::Status::OK();
+  }
+  const std::string* cfOptsFlag = nullptr;
+  const std::string* bbtOptsFlag = nullptr;
+  if (cfName == kVertexColumnFamily) {
+    cfOptsFlag = &FLAGS_rocksdb_vertex_column_family_options;
+    bbtOptsFlag = &FLAGS_rocksdb_vertex_block_based_table_options;
+  } else if (cfName == kEdgeColumnFamily) {
+    cfOptsFlag = &FLAGS_rocksdb_edge_column_family_options;
+    bbtOptsFlag = &FLAGS_rocksdb_edge_block_based_table_options;
+  } else if (cfName == kIndexColumnFamily) {
+    cfOptsFlag = &FLAGS_rocksdb_index_column_family_options;
+    bbtOptsFlag = &FLAGS_rocksdb_index_block_based_table_options;
+  } else {
+    return rocksdb::Status::InvalidArgument("Unknown column family " + cfName);
+  }
+
+  std::unordered_map<std::string, std::string> cfOptsMap;
+  if (!loadOptionsMap(cfOptsMap, *cfOptsFlag)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  auto s = GetColumnFamilyOptionsFromMap(baseCfOpts, cfOptsMap, &cfOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+
+  const auto* baseBbtOpts = baseOpts.table_factory->GetOptions<rocksdb::BlockBasedTableOptions>();
+  if (FLAGS_rocksdb_table_format != "BlockBasedTable" || baseBbtOpts == nullptr) {
+    return s;
+  }
+  // Tags are mostly read by point lookups, edges by prefix scan of a vertex, and indexes by range
+  // scan, so the bloom filters are different by default
+  rocksdb::BlockBasedTableOptions bbtOpts = *baseBbtOpts;
+  if (cfName == kVertexColumnFamily) {
+    bbtOpts.whole_key_filtering = true;
+  } else if (cfName == kIndexColumnFamily) {
+    bbtOpts.filter_policy.reset();
+    if (cfOptsMap.find("prefix_extractor") == cfOptsMap.end()) {
+      cfOpts.prefix_extractor.reset();
+    }
+  }
+  std::unordered_map<std::string, std::string> bbtOptsMap;
+  if (!loadOptionsMap(bbtOptsMap, *bbtOptsFlag)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  rocksdb::BlockBasedTableOptions cfBbtOpts;
+  s = GetBlockBasedTableOptionsFromMap(bbtOpts, bbtOptsMap, &cfBbtOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+  cfOpts.table_factory.reset(NewBlockBasedTableFactory(cfBbtOpts));
+  return s;
+}
+
 bool loadOptionsMap(std::unordered_map<std::string, std::string>& map, const std::string& gflags) {
   conf::Configuration conf;
   auto status = conf.parseFromString(gflags);
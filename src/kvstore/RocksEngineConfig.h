@@ -20,9 +20,21 @@ DECLARE_string(rocksdb_db_options);
 // [CFOptions "default"]
 DECLARE_string(rocksdb_column_family_options);
 
+DECLARE_bool(rocksdb_separate_column_families);
+
+// [CFOptions "vertex"], [CFOptions "edge"] and [CFOptions "index"]
+DECLARE_string(rocksdb_vertex_column_family_options);
+DECLARE_string(rocksdb_edge_column_family_options);
+DECLARE_string(rocksdb_index_column_family_options);
+
 //  [TableOptions/BlockBasedTable "default"]
 DECLARE_string(rocksdb_block_based_table_options);
 
+// [TableOptions/BlockBasedTable "vertex"], [... "edge"] and [... "index"]
+DECLARE_string(rocksdb_vertex_block_based_table_options);
+DECLARE_string(rocksdb_edge_block_based_table_options);
+DECLARE_string(rocksdb_index_block_based_table_options);
+
 // memtable_factory
 DECLARE_string(memtable_factory);
 
@@ -63,6 +75,10 @@ DECLARE_string(rocksdb_wal_dir);
 DECLARE_string(rocksdb_backup_dir);
 DECLARE_int32(rocksdb_backup_interval_secs);
 
+// rocksdb bulk scan options
+DECLARE_int64(rocksdb_bulk_scan_readahead_size);
+DECLARE_bool(rocksdb_bulk_scan_async_io);
+
 // rocksdb key value separation options
 DECLARE_bool(rocksdb_enable_kv_separation);
 DECLARE_uint64(rocksdb_kv_separation_threshold);
@@ -70,6 +86,12 @@ DECLARE_uint64(rocksdb_kv_separation_threshold);
 namespace nebula {
 namespace kvstore {
 
+// Column families of a space when rocksdb_separate_column_families is on, other keys such as
+// system keys are kept in the default column family
+constexpr char kVertexColumnFamily[] = "vertex";
+constexpr char kEdgeColumnFamily[] = "edge";
+constexpr char kIndexColumnFamily[] = "index";
+
 /**
  * @brief Build rocksdb options form gflags
  *
@@ -82,6 +104,19 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options &baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen = 8);
 
+/**
+ * @brief Build the options of a column family, which are the options of default column family
+ * overridden by the gflags of the column family
+ *
+ * @param cfOpts Column family options
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param cfName Column family name
+ * @return rocksdb::Status
+ */
+rocksdb::Status initRocksdbCFOptions(rocksdb::ColumnFamilyOptions &cfOpts,
+                                     const rocksdb::Options &baseOpts,
+                                     const std::string &cfName);
+
 /**
  * @brief Load a gflag into map
  *
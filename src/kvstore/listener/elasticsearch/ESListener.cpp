@@ -5,6 +5,7 @@
 
 #include "kvstore/listener/elasticsearch/ESListener.h"
 
+#include "common/plugin/fulltext/builtin/TextIndex.h"
 #include "common/plugin/fulltext/elasticsearch/ESAdapter.h"
 #include "common/utils/NebulaKeyUtils.h"
 
@@ -131,6 +132,10 @@ void ESListener::pickTagAndEdgeData(BatchLogType type,
   }
 
   for (auto& index : ftIndexes) {
+    // The builtin index is maintained by storage when the logs are committed
+    if (index.second.get_analyzer() == plugin::kBuiltinAnalyzer) {
+      continue;
+    }
     std::map<std::string, std::string> data;
     std::string indexName = index.first;
     if (type == BatchLogType::OP_BATCH_PUT) {
@@ -35,6 +35,11 @@ DEFINE_uint32(max_batch_size, 256, "The max number of logs in a batch");
 
 DEFINE_bool(trace_raft, false, "Enable trace one raft request");
 
+DEFINE_string(raft_client_compression,
+              "none",
+              "Compression of the raft rpc payloads, `none', `zstd' or `zlib'");
+
+DECLARE_int32(raft_rpc_timeout_ms);
 DECLARE_int32(wal_ttl);
 DECLARE_int64(wal_file_size);
 DECLARE_int32(wal_buffer_size);
@@ -464,6 +469,10 @@ void RaftPart::stop() {
     role_ = Role::FOLLOWER;
 
     hosts = std::move(hosts_);
+    for (auto& waiter : applyWaiters_) {
+      waiter.second.setValue(nebula::cpp2::ErrorCode::E_RAFT_STOPPED);
+    }
+    applyWaiters_.clear();
   }
 
   for (auto& h : hosts) {
@@ -1076,11 +1085,21 @@ void RaftPart::processAppendLogResponses(const AppendLogResponses& resps,
       true so the second parameters need to be true.
       */
       auto [code, lastCommitId, lastCommitTerm] = commitLogs(std::move(walIt), true, true);
+      // The engine never stalls the leader which waits, but the state machine could ask to commit
+      // the logs later, e.g. the schema of data is not in the local cache yet
+      while (code == nebula::cpp2::ErrorCode::E_WRITE_STALLED) {
+        VLOG(2) << idStr_ << "Leader delay committing log " << committedId + 1 << " to "
+                << lastLogId;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        std::tie(code, lastCommitId, lastCommitTerm) =
+            commitLogs(wal_->iterator(committedId + 1, lastLogId), true, true);
+      }
       if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
         std::lock_guard<std::mutex> g(raftLock_);
         CHECK_EQ(lastLogId, lastCommitId);
         committedLogId_ = lastCommitId;
         committedLogTerm_ = lastCommitTerm;
+        notifyApplyWaiters();
         auto nowCostMs = lastMsgSentDur_.elapsedInMSec();
         auto nowTime = static_cast<uint64_t>(time::WallClock::fastNowInMilliSec());
         if (nowTime - nowCostMs >= lastMsgAcceptedTime_ - lastMsgAcceptedCostMs_) {
@@ -1801,6 +1820,7 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
       CHECK_EQ(lastLogIdCanCommit, lastCommitId);
       committedLogId_ = lastCommitId;
       committedLogTerm_ = lastCommitTerm;
+      notifyApplyWaiters();
       resp.committed_log_id_ref() = lastLogIdCanCommit;
       resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
     } else if (code == nebula::cpp2::ErrorCode::E_WRITE_STALLED) {
@@ -2026,6 +2046,7 @@ void RaftPart::processSendSnapshotRequest(const cpp2::SendSnapshotRequest& req,
     committedLogTerm_ = req.get_committed_log_term();
     lastLogId_ = committedLogId_;
     lastLogTerm_ = committedLogTerm_;
+    notifyApplyWaiters();
     // there should be no wal after state converts to WAITING_SNAPSHOT, the RaftPart has been reset
     DCHECK_EQ(wal_->firstLogId(), 0);
     DCHECK_EQ(wal_->lastLogId(), 0);
@@ -2047,7 +2068,10 @@ void RaftPart::sendHeartbeat() {
       appendLogAsync(clusterId_, LogType::NORMAL, std::move(log));
     });
   }
+  broadcastHeartbeat();
+}
 
+folly::Future<bool> RaftPart::broadcastHeartbeat() {
   using namespace folly;  // NOLINT since the fancy overload of | operator
   VLOG(2) << idStr_ << "Send heartbeat";
   TermID currTerm = 0;
@@ -2060,7 +2084,7 @@ void RaftPart::sendHeartbeat() {
     std::lock_guard<std::mutex> g(raftLock_);
     nebula::cpp2::ErrorCode rc = canAppendLogs();
     if (rc != nebula::cpp2::ErrorCode::SUCCEEDED) {
-      return;
+      return folly::makeFuture(false);
     }
     currTerm = term_;
     commitLogId = committedLogId_;
@@ -2071,7 +2095,7 @@ void RaftPart::sendHeartbeat() {
   }
   auto eb = ioThreadPool_->getEventBase();
   auto startMs = time::WallClock::fastNowInMilliSec();
-  collectNSucceeded(
+  return collectNSucceeded(
       gen::from(hosts) |
           gen::map([self = shared_from_this(), eb, currTerm, commitLogId, prevLogId, prevLogTerm](
                        std::shared_ptr<Host> hostPtr) {
@@ -2106,7 +2130,7 @@ void RaftPart::sendHeartbeat() {
             term_ = highestTerm;
             role_ = Role::FOLLOWER;
             leader_ = HostAddr("", 0);
-            return;
+            return false;
           }
         }
         if (numSucceeded >= replica) {
@@ -2118,7 +2142,9 @@ void RaftPart::sendHeartbeat() {
             lastMsgAcceptedCostMs_ = nowCostMs;
             lastMsgAcceptedTime_ = nowTime;
           }
+          return role_ == Role::LEADER && term_ == currTerm;
         }
+        return false;
       });
 }
 
@@ -2267,5 +2293,201 @@ bool RaftPart::leaseValid() {
          FLAGS_raft_heartbeat_interval_secs * 1000 - lastMsgAcceptedCostMs_;
 }
 
+folly::Future<nebula::cpp2::ErrorCode> RaftPart::readIndex() {
+  return requestReadIndex().thenValue(
+      [self = shared_from_this()](cpp2::ReadIndexResponse&& resp) {
+        if (resp.get_error_code() != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return folly::makeFuture(resp.get_error_code());
+        }
+        return self->waitForApply(resp.get_read_index());
+      });
+}
+
+folly::Future<cpp2::ReadIndexResponse> RaftPart::processReadIndexRequest(
+    const cpp2::ReadIndexRequest& req) {
+  VLOG(4) << idStr_ << "Receive read index request of space " << req.get_space() << ", part "
+          << req.get_part();
+  {
+    std::lock_guard<std::mutex> g(raftLock_);
+    if (role_ != Role::LEADER) {
+      // Only leader could serve read index, let the follower retry on the new leader
+      cpp2::ReadIndexResponse resp;
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+      resp.current_term_ref() = term_;
+      return folly::makeFuture(std::move(resp));
+    }
+  }
+  auto committedLogId = req.get_committed_log_id();
+  return requestReadIndex().thenValue(
+      [self = shared_from_this(), committedLogId](cpp2::ReadIndexResponse&& resp) {
+        // The follower could not apply logs to the read index until it knows they are committed,
+        // so send an empty log to carry the committed log id instead of waiting for heartbeat
+        if (resp.get_error_code() == nebula::cpp2::ErrorCode::SUCCEEDED &&
+            resp.get_read_index() > committedLogId) {
+          self->appendEmptyLogFor(resp.get_read_index());
+        }
+        return std::move(resp);
+      });
+}
+
+void RaftPart::appendEmptyLogFor(LogID readIndex) {
+  // Any log appended from now on carries a committed log id no less than readIndex, so the
+  // followers lagging behind the same read index share one empty log
+  auto carried = emptyLogCarriedId_.load(std::memory_order_acquire);
+  while (readIndex > carried) {
+    if (emptyLogCarriedId_.compare_exchange_weak(carried, readIndex, std::memory_order_acq_rel)) {
+      folly::via(executor_.get(), [self = shared_from_this()] {
+        std::string log = "";
+        self->appendLogAsync(self->clusterId_, LogType::NORMAL, std::move(log));
+      });
+      return;
+    }
+  }
+}
+
+folly::Future<cpp2::ReadIndexResponse> RaftPart::requestReadIndex() {
+  // When the leader lease is valid, no other peer could be elected as leader, so the committed log
+  // id could be used as read index directly
+  if (isLeader() && leaseValid()) {
+    std::lock_guard<std::mutex> g(raftLock_);
+    if (role_ == Role::LEADER) {
+      cpp2::ReadIndexResponse resp;
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
+      resp.current_term_ref() = term_;
+      resp.read_index_ref() = committedLogId_;
+      return folly::makeFuture(std::move(resp));
+    }
+  }
+
+  folly::Promise<cpp2::ReadIndexResponse> promise;
+  auto future = promise.getFuture();
+  bool startRound = false;
+  {
+    std::lock_guard<std::mutex> g(readIndexLock_);
+    readIndexWaiters_.emplace_back(std::move(promise));
+    if (!readIndexInFlight_) {
+      readIndexInFlight_ = true;
+      startRound = true;
+    }
+  }
+  // The requests arrived during a round must wait for next round, because the read index of the
+  // round in flight may be obtained before they arrived
+  if (startRound) {
+    startReadIndexRound();
+  }
+  return future;
+}
+
+void RaftPart::startReadIndexRound() {
+  std::vector<folly::Promise<cpp2::ReadIndexResponse>> batch;
+  {
+    std::lock_guard<std::mutex> g(readIndexLock_);
+    batch.swap(readIndexWaiters_);
+  }
+  VLOG(4) << idStr_ << "Request read index for " << batch.size() << " reads";
+  fetchReadIndex().thenTry([self = shared_from_this(), batch = std::move(batch)](
+                               folly::Try<cpp2::ReadIndexResponse>&& t) mutable {
+    cpp2::ReadIndexResponse resp;
+    if (t.hasException()) {
+      VLOG(3) << self->idStr_ << "Read index failed: " << t.exception().what();
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+    } else {
+      resp = std::move(t).value();
+    }
+    for (auto& promise : batch) {
+      promise.setValue(resp);
+    }
+    bool nextRound = false;
+    {
+      std::lock_guard<std::mutex> g(self->readIndexLock_);
+      if (self->readIndexWaiters_.empty()) {
+        self->readIndexInFlight_ = false;
+      } else {
+        nextRound = true;
+      }
+    }
+    if (nextRound) {
+      self->startReadIndexRound();
+    }
+  });
+}
+
+folly::Future<cpp2::ReadIndexResponse> RaftPart::fetchReadIndex() {
+  cpp2::ReadIndexResponse resp;
+  HostAddr leader;
+  LogID committedLogId = 0;
+  {
+    std::lock_guard<std::mutex> g(raftLock_);
+    if (UNLIKELY(status_ != Status::RUNNING)) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_NOT_READY;
+      return folly::makeFuture(std::move(resp));
+    }
+    if (role_ == Role::LEADER) {
+      if (!commitInThisTerm_) {
+        // The logs of previous term may not be applied yet
+        resp.error_code_ref() = nebula::cpp2::ErrorCode::E_LEADER_LEASE_FAILED;
+        return folly::makeFuture(std::move(resp));
+      }
+      resp.current_term_ref() = term_;
+      resp.read_index_ref() = committedLogId_;
+    } else if (leader_ == HostAddr("", 0)) {
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+      return folly::makeFuture(std::move(resp));
+    } else {
+      leader = leader_;
+      committedLogId = committedLogId_;
+    }
+  }
+
+  if (leader == HostAddr("", 0)) {
+    // I am the leader, the read index is valid once a majority still regards me as leader
+    return broadcastHeartbeat().thenValue([resp = std::move(resp)](bool confirmed) mutable {
+      resp.error_code_ref() = confirmed ? nebula::cpp2::ErrorCode::SUCCEEDED
+                                        : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+      return std::move(resp);
+    });
+  }
+
+  cpp2::ReadIndexRequest req;
+  req.space_ref() = spaceId_;
+  req.part_ref() = partId_;
+  req.committed_log_id_ref() = committedLogId;
+  auto eb = ioThreadPool_->getEventBase();
+  return folly::via(eb, [self = shared_from_this(), eb, leader, req = std::move(req)] {
+    auto client = self->clientMan_->client(leader, eb, false, FLAGS_raft_rpc_timeout_ms);
+    return client->future_readIndex(req);
+  });
+}
+
+folly::Future<nebula::cpp2::ErrorCode> RaftPart::waitForApply(LogID readIndex) {
+  std::lock_guard<std::mutex> g(raftLock_);
+  if (committedLogId_ >= readIndex) {
+    return folly::makeFuture(nebula::cpp2::ErrorCode::SUCCEEDED);
+  }
+  VLOG(4) << idStr_ << "Wait for log " << readIndex << " to be applied, committed log id "
+          << committedLogId_;
+  auto iter = applyWaiters_.emplace(readIndex, folly::Promise<nebula::cpp2::ErrorCode>());
+  return iter->second.getFuture();
+}
+
+void RaftPart::notifyApplyWaiters() {
+  CHECK(!raftLock_.try_lock());
+  if (applyWaiters_.empty() || applyWaiters_.begin()->first > committedLogId_) {
+    return;
+  }
+  auto end = applyWaiters_.upper_bound(committedLogId_);
+  std::vector<folly::Promise<nebula::cpp2::ErrorCode>> ready;
+  for (auto iter = applyWaiters_.begin(); iter != end; ++iter) {
+    ready.emplace_back(std::move(iter->second));
+  }
+  applyWaiters_.erase(applyWaiters_.begin(), end);
+  // Fulfill the promises out of raftLock_
+  executor_->add([ready = std::move(ready)]() mutable {
+    for (auto& promise : ready) {
+      promise.setValue(nebula::cpp2::ErrorCode::SUCCEEDED);
+    }
+  });
+}
+
 }  // namespace raftex
 }  // namespace nebula
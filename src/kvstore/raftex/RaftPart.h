@@ -360,6 +360,23 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    */
   bool leaseValid();
 
+  /**
+   * @brief Get a read index confirmed by the leader, and wait until the logs before it have been
+   * applied locally. Once succeeded, reads served by this replica are linearizable even if it is a
+   * follower. The concurrent requests of a partition share one round trip to the leader.
+   *
+   * @return folly::Future<nebula::cpp2::ErrorCode>
+   */
+  folly::Future<nebula::cpp2::ErrorCode> readIndex();
+
+  /**
+   * @brief Process read index request from follower
+   *
+   * @param req
+   * @return folly::Future<cpp2::ReadIndexResponse>
+   */
+  folly::Future<cpp2::ReadIndexResponse> processReadIndexRequest(const cpp2::ReadIndexRequest& req);
+
   /**
    * @brief Return whether we need to clean expired wal
    */
@@ -625,6 +642,49 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    */
   void sendHeartbeat();
 
+  /**
+   * @brief Send heartbeat to all peers, return true if it is accepted by majority in current term
+   */
+  folly::Future<bool> broadcastHeartbeat();
+
+  /****************************************************
+   *
+   * Methods used by read index
+   *
+   ***************************************************/
+
+  /**
+   * @brief Get the read index, the request is batched with the concurrent ones
+   */
+  folly::Future<cpp2::ReadIndexResponse> requestReadIndex();
+
+  /**
+   * @brief Append an empty log to carry the committed log id to the followers waiting for
+   * readIndex, unless an empty log has been appended for a read index no less than it
+   */
+  void appendEmptyLogFor(LogID readIndex);
+
+  /**
+   * @brief Serve all batched read index requests by one heartbeat round if I am leader, or by one
+   * rpc to the leader if I am follower
+   */
+  void startReadIndexRound();
+
+  /**
+   * @brief Get the read index from the leader, or confirm I am still the leader by heartbeat
+   */
+  folly::Future<cpp2::ReadIndexResponse> fetchReadIndex();
+
+  /**
+   * @brief Wait until the logs before read index have been applied to state machine
+   */
+  folly::Future<nebula::cpp2::ErrorCode> waitForApply(LogID readIndex);
+
+  /**
+   * @brief Fulfill the read requests whose read index has been applied, raftLock_ must be held
+   */
+  void notifyApplyWaiters();
+
   /**
    * @brief Return whether need to trigger leader election
    */
@@ -884,6 +944,15 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   int64_t startTimeMs_ = 0;
 
   std::atomic<bool> blocking_{false};
+
+  // The read index requests waiting for next round, and whether a round is in flight
+  std::mutex readIndexLock_;
+  std::vector<folly::Promise<cpp2::ReadIndexResponse>> readIndexWaiters_;
+  bool readIndexInFlight_{false};
+  // The largest read index which an appended empty log has been sent to carry
+  std::atomic<LogID> emptyLogCarriedId_{0};
+  // The read requests waiting for logs to be applied, keyed by read index, protected by raftLock_
+  std::multimap<LogID, folly::Promise<nebula::cpp2::ErrorCode>> applyWaiters_;
 };
 
 }  // namespace raftex
@@ -10,6 +10,7 @@
 #include "common/base/Base.h"
 #include "common/base/ErrorOr.h"
 #include "common/ssl/SSLConfig.h"
+#include "common/thrift/RpcCompression.h"
 #include "kvstore/raftex/RaftPart.h"
 
 namespace nebula {
@@ -29,6 +30,7 @@ std::shared_ptr<RaftexService> RaftexService::createService(
     auto server = std::make_unique<apache::thrift::ThriftServer>();
     server->setPort(port);
     server->setIdleTimeout(std::chrono::seconds(0));
+    thrift::setupServerCompression(server.get());
     if (ioPool != nullptr) {
       server->setIOThreadPool(ioPool);
     }
@@ -174,5 +176,17 @@ void RaftexService::async_eb_heartbeat(
   callback->result(resp);
 }
 
+folly::Future<cpp2::ReadIndexResponse> RaftexService::future_readIndex(
+    const cpp2::ReadIndexRequest& req) {
+  auto part = findPart(req.get_space(), req.get_part());
+  if (!part) {
+    // Not found
+    cpp2::ReadIndexResponse resp;
+    resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_UNKNOWN_PART;
+    return folly::makeFuture(std::move(resp));
+  }
+  return part->processReadIndexRequest(req);
+}
+
 }  // namespace raftex
 }  // namespace nebula
@@ -111,6 +111,15 @@ class RaftexService : public cpp2::RaftexServiceSvIf {
       std::unique_ptr<apache::thrift::HandlerCallback<cpp2::HeartbeatResponse>> callback,
       const cpp2::HeartbeatRequest& req) override;
 
+  /**
+   * @brief Handle read index request in worker thread
+   *
+   * @param req
+   * @return folly::Future<cpp2::ReadIndexResponse>
+   */
+  folly::Future<cpp2::ReadIndexResponse> future_readIndex(
+      const cpp2::ReadIndexRequest& req) override;
+
   /**
    * @brief Register the RaftPart to the service
    */
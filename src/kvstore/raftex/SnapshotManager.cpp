@@ -14,10 +14,12 @@ DEFINE_int32(snapshot_io_threads, 4, "Threads number for snapshot");
 DEFINE_int32(snapshot_send_retry_times, 3, "Retry times if send failed");
 DEFINE_int32(snapshot_send_timeout_ms, 60000, "Rpc timeout for sending snapshot");
 
+DECLARE_string(raft_client_compression);
+
 namespace nebula {
 namespace raftex {
 
-SnapshotManager::SnapshotManager() {
+SnapshotManager::SnapshotManager() : connManager_(false, FLAGS_raft_client_compression) {
   executor_.reset(new folly::IOThreadPoolExecutor(
       FLAGS_snapshot_worker_threads,
       std::make_shared<folly::NamedThreadFactory>("snapshot-worker")));
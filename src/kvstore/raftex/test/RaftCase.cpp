@@ -100,6 +100,127 @@ TEST_F(ThreeRaftTest, ConsensusWhenFollowDisconnect) {
   LOG(INFO) << "<===== Done ConsensusWhenFollowDisconnect test";
 }
 
+TEST_F(ThreeRaftTest, ReadIndex) {
+  LOG(INFO) << "=====> Start ReadIndex test";
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 9, leader_, msgs, true);
+
+  // Once read index succeeded, all logs committed on leader must be readable on every copy
+  for (auto& copy : copies_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, copy->readIndex().get());
+    EXPECT_TRUE(checkLog(copy, 0, 9, msgs));
+  }
+
+  // The concurrent requests are batched, and all of them succeed
+  std::vector<folly::Future<nebula::cpp2::ErrorCode>> futures;
+  appendLogs(10, 19, leader_, msgs, true);
+  for (int i = 0; i < 100; i++) {
+    futures.emplace_back(copies_[i % copies_.size()]->readIndex());
+  }
+  for (auto& result : folly::collectAll(futures).get()) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, result.value());
+  }
+  for (auto& copy : copies_) {
+    EXPECT_TRUE(checkLog(copy, 10, 19, msgs));
+  }
+
+  LOG(INFO) << "<===== Done ReadIndex test";
+}
+
+TEST_F(ThreeRaftTest, ReadIndexCoalesceEmptyLogs) {
+  LOG(INFO) << "=====> Start ReadIndexCoalesceEmptyLogs test";
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 9, leader_, msgs, true);
+  auto lastLogId = leader_->lastLogInfo().first;
+
+  // The followers lag behind the same read index, so they share the empty log carrying it instead
+  // of appending one for each read
+  std::vector<folly::Future<nebula::cpp2::ErrorCode>> futures;
+  for (int i = 0; i < 100; i++) {
+    auto& copy = copies_[i % copies_.size()];
+    if (copy != leader_) {
+      futures.emplace_back(copy->readIndex());
+    }
+  }
+  for (auto& result : folly::collectAll(futures).get()) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, result.value());
+  }
+  // The read index may move forward by the empty log itself, at most once per round of a follower
+  EXPECT_LE(leader_->lastLogInfo().first, lastLogId + 2 * (copies_.size() - 1));
+
+  LOG(INFO) << "<===== Done ReadIndexCoalesceEmptyLogs test";
+}
+
+TEST_F(ThreeRaftTest, ReadIndexWithoutQuorum) {
+  FLAGS_raft_heartbeat_interval_secs = 1;
+  LOG(INFO) << "=====> Start ReadIndexWithoutQuorum test";
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 9, leader_, msgs, true);
+
+  LOG(INFO) << "=====> Now let's kill both followers";
+  auto leader = leader_;
+  size_t leaderIdx = leader->index();
+  for (size_t i = 1; i < copies_.size(); i++) {
+    killOneCopy(services_, copies_, leader_, (leaderIdx + i) % copies_.size());
+  }
+
+  // Once the lease expired, the old leader could not confirm it is still the leader, so it must not
+  // serve the read, otherwise it may return the data overwritten by a new leader
+  sleep(FLAGS_raft_heartbeat_interval_secs + 1);
+  EXPECT_NE(nebula::cpp2::ErrorCode::SUCCEEDED, leader->readIndex().get());
+
+  LOG(INFO) << "=====> Now followers rejoin, read index could be served again";
+  for (size_t i = 1; i < copies_.size(); i++) {
+    rebootOneCopy(services_, copies_, allHosts_, (leaderIdx + i) % copies_.size());
+  }
+  waitUntilAllHasLeader(copies_);
+  checkLeadership(copies_, leader_);
+  for (auto& copy : copies_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, copy->readIndex().get());
+    EXPECT_TRUE(checkLog(copy, 0, 9, msgs));
+  }
+
+  LOG(INFO) << "<===== Done ReadIndexWithoutQuorum test";
+}
+
+TEST_F(ThreeRaftTest, ReadIndexAfterLeaderChange) {
+  FLAGS_raft_heartbeat_interval_secs = 1;
+  LOG(INFO) << "=====> Start ReadIndexAfterLeaderChange test";
+
+  std::vector<std::string> msgs;
+  appendLogs(0, 9, leader_, msgs, true);
+
+  LOG(INFO) << "=====> Now let's kill the old leader";
+  size_t idx = leader_->index();
+  killOneCopy(services_, copies_, leader_, idx);
+  waitUntilLeaderElected(copies_, leader_);
+
+  // The new leader serves read index only after it committed a log in its term, and the logs
+  // committed by the old leader are readable on the remaining copies
+  appendLogs(10, 19, leader_, msgs, true);
+  for (auto& copy : copies_) {
+    if (copy->index() == idx) {
+      continue;
+    }
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, copy->readIndex().get());
+    EXPECT_TRUE(checkLog(copy, 0, 19, msgs));
+  }
+
+  LOG(INFO) << "=====> Now the old leader comes back as follower";
+  rebootOneCopy(services_, copies_, allHosts_, idx);
+  waitUntilAllHasLeader(copies_);
+  checkLeadership(copies_, leader_);
+  for (auto& copy : copies_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, copy->readIndex().get());
+    EXPECT_TRUE(checkLog(copy, 0, 19, msgs));
+  }
+
+  LOG(INFO) << "<===== Done ReadIndexAfterLeaderChange test";
+}
+
 TEST_F(ThreeRaftTest, LeaderCrashRebootWithLogs) {
   LOG(INFO) << "=====> Start LeaderNetworkFailure test";
 
@@ -19,6 +19,10 @@ stats::CounterId kTransferLeaderLatencyUs;
 stats::CounterId kNumStartElect;
 stats::CounterId kNumGrantVotes;
 stats::CounterId kNumSendSnapshot;
+stats::CounterId kBgWorkersQueueDepth;
+stats::CounterId kNumBgWorkersSteals;
+stats::CounterId kLoadPartLatencyUs;
+stats::CounterId kLoadPartsFromDiskLatencyMs;
 
 void initKVStats() {
   kCommitLogLatencyUs = stats::StatsManager::registerHisto(
@@ -36,6 +40,13 @@ void initKVStats() {
   kNumStartElect = stats::StatsManager::registerStats("num_start_elect", "rate, sum");
   kNumGrantVotes = stats::StatsManager::registerStats("num_grant_votes", "rate, sum");
   kNumSendSnapshot = stats::StatsManager::registerStats("num_send_snapshot", "rate, sum");
+  kBgWorkersQueueDepth = stats::StatsManager::registerHisto(
+      "bg_workers_queue_depth", 10, 0, 1000, "avg, p95, p99");
+  kNumBgWorkersSteals = stats::StatsManager::registerStats("num_bg_workers_steals", "rate, sum");
+  kLoadPartLatencyUs = stats::StatsManager::registerHisto(
+      "load_part_latency_us", 10000, 0, 10000000, "avg, p95, p99, p999");
+  kLoadPartsFromDiskLatencyMs =
+      stats::StatsManager::registerStats("load_parts_from_disk_latency_ms", "sum");
 }
 
 }  // namespace nebula
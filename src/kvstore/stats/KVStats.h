@@ -21,6 +21,12 @@ extern stats::CounterId kTransferLeaderLatencyUs;
 extern stats::CounterId kNumStartElect;
 extern stats::CounterId kNumGrantVotes;
 extern stats::CounterId kNumSendSnapshot;
+// Background workers related stats
+extern stats::CounterId kBgWorkersQueueDepth;
+extern stats::CounterId kNumBgWorkersSteals;
+// Startup related stats
+extern stats::CounterId kLoadPartLatencyUs;
+extern stats::CounterId kLoadPartsFromDiskLatencyMs;
 
 void initKVStats();
 
@@ -0,0 +1,304 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/FileUtils.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/MemEngine.h"
+#include "kvstore/RocksEngine.h"
+
+namespace nebula {
+namespace kvstore {
+
+const int32_t kDefaultVIdLen = 8;
+
+template <typename Engine>
+std::unique_ptr<KVEngine> newEngine(GraphSpaceID spaceId, const std::string& path);
+
+template <>
+std::unique_ptr<KVEngine> newEngine<RocksEngine>(GraphSpaceID spaceId, const std::string& path) {
+  return std::make_unique<RocksEngine>(spaceId, kDefaultVIdLen, path);
+}
+
+template <>
+std::unique_ptr<KVEngine> newEngine<MemEngine>(GraphSpaceID spaceId, const std::string& path) {
+  return std::make_unique<MemEngine>(spaceId, path);
+}
+
+/**
+ * The same cases run against both engines, to make sure the in-memory engine behaves the same as
+ * rocksdb
+ */
+template <typename Engine>
+class KVEngineTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    rootPath_ = std::make_unique<fs::TempDir>("/tmp/kv_engine_test.XXXXXX");
+    engine_ = newEngine<Engine>(1, rootPath_->path());
+  }
+
+  void reopen() {
+    engine_.reset();
+    engine_ = newEngine<Engine>(1, rootPath_->path());
+  }
+
+  std::vector<std::string> collect(std::unique_ptr<KVIterator> iter) {
+    std::vector<std::string> keys;
+    for (; iter->valid(); iter->next()) {
+      keys.emplace_back(iter->key().str());
+    }
+    return keys;
+  }
+
+  std::unique_ptr<fs::TempDir> rootPath_;
+  std::unique_ptr<KVEngine> engine_;
+};
+
+using Engines = ::testing::Types<RocksEngine, MemEngine>;
+TYPED_TEST_SUITE(KVEngineTest, Engines);
+
+TYPED_TEST(KVEngineTest, SimpleTest) {
+  auto& engine = this->engine_;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key", "val"));
+  std::string val;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get("key", &val));
+  EXPECT_EQ("val", val);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key", "newVal"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get("key", &val));
+  EXPECT_EQ("newVal", val);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->remove("key"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get("key", &val));
+}
+
+TYPED_TEST(KVEngineTest, MultiGetTest) {
+  auto& engine = this->engine_;
+  std::vector<KV> data;
+  for (auto i = 0; i < 10; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), folly::stringPrintf("val_%d", i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+  std::vector<std::string> keys = {"key_0", "key_10", "key_9"};
+  std::vector<std::string> values;
+  auto status = engine->multiGet(keys, &values);
+  ASSERT_EQ(3, status.size());
+  ASSERT_EQ(3, values.size());
+  EXPECT_TRUE(status[0].ok());
+  EXPECT_EQ("val_0", values[0]);
+  EXPECT_TRUE(status[1].isKeyNotFound());
+  EXPECT_TRUE(status[2].ok());
+  EXPECT_EQ("val_9", values[2]);
+}
+
+TYPED_TEST(KVEngineTest, RangeAndPrefixTest) {
+  auto& engine = this->engine_;
+  std::vector<KV> data;
+  for (auto i = 10; i < 20; i++) {
+    data.emplace_back(folly::stringPrintf("a_%d", i), "");
+    data.emplace_back(folly::stringPrintf("b_%d", i), "");
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->range("a_15", "b_11", &iter));
+  EXPECT_EQ((std::vector<std::string>{"a_15", "a_16", "a_17", "a_18", "a_19", "b_10"}),
+            this->collect(std::move(iter)));
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("b_1", &iter));
+  EXPECT_EQ(10, this->collect(std::move(iter)).size());
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->rangeWithPrefix("a_18", "a_", &iter));
+  EXPECT_EQ((std::vector<std::string>{"a_18", "a_19"}), this->collect(std::move(iter)));
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("c_", &iter));
+  EXPECT_FALSE(iter->valid());
+}
+
+TYPED_TEST(KVEngineTest, RemoveRangeTest) {
+  auto& engine = this->engine_;
+  std::vector<KV> data;
+  for (auto i = 10; i < 20; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), "");
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(std::move(data)));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->removeRange("key_12", "key_18"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->multiRemove({"key_10", "key_19", "key_not_exist"}));
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter));
+  EXPECT_EQ((std::vector<std::string>{"key_11", "key_18"}), this->collect(std::move(iter)));
+}
+
+TYPED_TEST(KVEngineTest, BatchWriteTest) {
+  auto& engine = this->engine_;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_0", "val"));
+  auto batch = engine->startBatchWrite();
+  for (auto i = 1; i < 10; i++) {
+    batch->put(folly::stringPrintf("key_%d", i), "val");
+  }
+  batch->remove("key_0");
+  batch->removeRange("key_3", "key_6");
+  batch->put("key_4", "val");
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->commitBatchWrite(std::move(batch), false, false, true));
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter));
+  EXPECT_EQ((std::vector<std::string>{"key_1", "key_2", "key_4", "key_6", "key_7", "key_8",
+                                      "key_9"}),
+            this->collect(std::move(iter)));
+}
+
+TYPED_TEST(KVEngineTest, SnapshotTest) {
+  auto& engine = this->engine_;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_0", "val"));
+  const void* snapshot = engine->GetSnapshot();
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_0", "newVal"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->put("key_1", "val"));
+
+  std::string val;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get("key_0", &val, snapshot));
+  EXPECT_EQ("val", val);
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter, snapshot));
+  EXPECT_EQ((std::vector<std::string>{"key_0"}), this->collect(std::move(iter)));
+  engine->ReleaseSnapshot(snapshot);
+
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter));
+  EXPECT_EQ((std::vector<std::string>{"key_0", "key_1"}), this->collect(std::move(iter)));
+}
+
+TYPED_TEST(KVEngineTest, PartsTest) {
+  auto& engine = this->engine_;
+  EXPECT_TRUE(engine->allParts().empty());
+  engine->addPart(1);
+  engine->addPart(2, Peers(std::vector<Peer>{Peer(HostAddr("1", 1), Peer::Status::kLearner)}));
+  EXPECT_EQ(2, engine->totalPartsNum());
+  EXPECT_EQ((std::vector<PartitionID>{1, 2}), engine->allParts());
+  EXPECT_EQ(1, engine->balancePartPeers().size());
+
+  engine->removePart(1);
+  EXPECT_EQ(1, engine->totalPartsNum());
+  EXPECT_EQ((std::vector<PartitionID>{2}), engine->allParts());
+}
+
+TYPED_TEST(KVEngineTest, ReopenTest) {
+  std::vector<KV> data;
+  for (auto i = 0; i < 1000; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), std::string(i, 'v'));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, this->engine_->multiPut(std::move(data)));
+  this->engine_->addPart(1);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, this->engine_->flush());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, this->engine_->remove("key_0"));
+
+  this->reopen();
+  auto& engine = this->engine_;
+  std::string val;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get("key_0", &val));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get("key_999", &val));
+  EXPECT_EQ(std::string(999, 'v'), val);
+  EXPECT_EQ(1, engine->totalPartsNum());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->get(NebulaKeyUtils::dataVersionKey(), &val));
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter));
+  EXPECT_EQ(999, this->collect(std::move(iter)).size());
+}
+
+TEST(MemEngineTest, IteratorTest) {
+  fs::TempDir rootPath("/tmp/mem_engine_IteratorTest.XXXXXX");
+  MemEngine engine(1, rootPath.path());
+  std::vector<KV> data;
+  for (auto i = 10; i < 20; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), "val");
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.multiPut(std::move(data)));
+  EXPECT_EQ("11", value(engine.getProperty("mem.num-versions")));
+
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.prefix("key_", &iter));
+  ASSERT_TRUE(iter->valid());
+  EXPECT_EQ("key_10", iter->key());
+  // The writes after the iterator is created are invisible to it
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.put("key_10", "newVal"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.put("key_111", "val"));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.removeRange("key_12", "key_18"));
+  EXPECT_EQ("key_10", iter->key());
+  EXPECT_EQ("val", iter->val());
+  std::vector<std::string> keys;
+  for (; iter->valid(); iter->next()) {
+    EXPECT_EQ("val", iter->val());
+    keys.emplace_back(iter->key().str());
+  }
+  EXPECT_EQ(10, keys.size());
+  // Including the data version key
+  EXPECT_EQ("6", value(engine.getProperty("mem.num-keys")));
+  // The old versions are kept for the iterator
+  EXPECT_EQ("19", value(engine.getProperty("mem.num-versions")));
+
+  // Move backward
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.rangeWithPrefix("key_19", "key_", &iter));
+  ASSERT_TRUE(iter->valid());
+  iter->prev();
+  ASSERT_TRUE(iter->valid());
+  EXPECT_EQ("key_18", iter->key());
+  iter->prev();
+  ASSERT_TRUE(iter->valid());
+  EXPECT_EQ("key_111", iter->key());
+  iter.reset();
+
+  // The old versions are dropped by the next write once the iterators are released
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.remove("key_not_exist"));
+  EXPECT_EQ("6", value(engine.getProperty("mem.num-versions")));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.prefix("key_", &iter));
+  keys.clear();
+  for (; iter->valid(); iter->next()) {
+    keys.emplace_back(iter->key().str());
+  }
+  EXPECT_EQ((std::vector<std::string>{"key_10", "key_11", "key_111", "key_18", "key_19"}), keys);
+}
+
+TEST(MemEngineTest, CorruptedCheckpointTest) {
+  fs::TempDir rootPath("/tmp/mem_engine_CorruptedCheckpointTest.XXXXXX");
+  {
+    MemEngine engine(1, rootPath.path());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.put("key", "val"));
+    EXPECT_EQ("2", value(engine.getProperty("mem.num-keys")));
+  }
+  auto checkpoint = folly::stringPrintf("%s/nebula/1/mem/checkpoint", rootPath.path());
+  ASSERT_TRUE(fs::FileUtils::exist(checkpoint));
+  {
+    // A checkpoint left by an interrupted flush is never loaded
+    auto fd = open((checkpoint + ".tmp").c_str(), O_CREAT | O_WRONLY, 0644);
+    ASSERT_EQ(5, write(fd, "dummy", 5));
+    close(fd);
+    MemEngine engine(1, rootPath.path());
+    std::string val;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine.get("key", &val));
+    EXPECT_EQ("val", val);
+  }
+  {
+    auto fd = open(checkpoint.c_str(), O_WRONLY);
+    ASSERT_EQ(5, pwrite(fd, "dummy", 5, 16));
+    close(fd);
+    EXPECT_DEATH({ MemEngine engine(1, rootPath.path()); }, "Failed to load the checkpoint");
+  }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -333,6 +333,50 @@ TEST(NebulaStoreTest, PartsTest) {
   ASSERT_TRUE(store->spaces_.find(space1) == store->spaces_.end());
 }
 
+TEST(NebulaStoreTest, LoadManyPartsTest) {
+  fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
+  auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+  auto partMan = std::make_unique<MemPartManager>();
+
+  // A synthetic layout of 1000 parts spread on two disks, all of them are opened in parallel
+  GraphSpaceID spaceId = 1;
+  PartitionID numParts = 1000;
+  for (auto partId = 1; partId <= numParts; partId++) {
+    partMan->partsMap_[spaceId][partId] = PartHosts();
+  }
+  std::vector<std::string> paths;
+  paths.emplace_back(folly::stringPrintf("%s/disk1", rootPath.path()));
+  paths.emplace_back(folly::stringPrintf("%s/disk2", rootPath.path()));
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto db = std::make_unique<RocksEngine>(spaceId, kDefaultVidLen, paths[i]);
+    for (PartitionID partId = i + 1; partId <= numParts; partId += paths.size()) {
+      db->addPart(partId);
+    }
+  }
+
+  KVOptions options;
+  options.dataPaths_ = paths;
+  options.partMan_ = std::move(partMan);
+  HostAddr local = {"", 0};
+  auto store =
+      std::make_unique<NebulaStore>(std::move(options), ioThreadPool, local, getHandlers());
+  store->init();
+
+  ASSERT_EQ(1, store->spaces_.size());
+  ASSERT_EQ(numParts, store->spaces_[spaceId]->parts_.size());
+  for (size_t i = 0; i < paths.size(); i++) {
+    auto parts = store->spaces_[spaceId]->engines_[i]->allParts();
+    ASSERT_EQ(numParts / paths.size(), parts.size());
+    for (auto partId : parts) {
+      EXPECT_EQ(i + 1, (partId - 1) % paths.size() + 1);
+    }
+  }
+  for (auto partId = 1; partId <= numParts; partId++) {
+    auto part = store->part(spaceId, partId);
+    ASSERT_TRUE(ok(part));
+  }
+}
+
 TEST(NebulaStoreTest, PersistPeersTest) {
   fs::TempDir rootPath("/tmp/nebula_store_test.XXXXXX");
   auto ioThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
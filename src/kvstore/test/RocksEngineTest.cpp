@@ -10,6 +10,7 @@
 
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
+#include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/RocksEngine.h"
 #include "kvstore/RocksEngineConfig.h"
@@ -130,6 +131,37 @@ TEST_P(RocksEngineTest, PrefixTest) {
   checkPrefix("key_c", 20, 20);
 }
 
+TEST_P(RocksEngineTest, PinnedGetTest) {
+  fs::TempDir rootPath("/tmp/rocksdb_engine_PinnedGetTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 10; i++) {
+    data.emplace_back(folly::stringPrintf("key_%d", i), std::string(100 + i, 'a' + i));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(data));
+  if (flush_) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+  }
+
+  PinnedValue value;
+  for (const auto& kv : data) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->getPinned(kv.first, &value));
+    EXPECT_EQ(kv.second, value.ToString());
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->getPinned("key_10", &value));
+
+  std::vector<std::string> keys = {"key_1", "key_10", "key_5"};
+  std::vector<PinnedValue> values;
+  auto status = engine->multiGetPinned(keys, &values);
+  ASSERT_EQ(3, status.size());
+  ASSERT_EQ(3, values.size());
+  EXPECT_TRUE(status[0].ok());
+  EXPECT_EQ(data[1].second, values[0].ToString());
+  EXPECT_TRUE(status[1].isKeyNotFound());
+  EXPECT_TRUE(status[2].ok());
+  EXPECT_EQ(data[5].second, values[2].ToString());
+}
+
 TEST_P(RocksEngineTest, RemoveTest) {
   fs::TempDir rootPath("/tmp/rocksdb_engine_RemoveTest.XXXXXX");
   auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
@@ -669,6 +701,136 @@ TEST(PlainTableTest, BackupRestoreWithData) {
   FLAGS_enable_rocksdb_prefix_filtering = false;
 }
 
+TEST(RocksEngineBulkScanTest, NotFillCacheTest) {
+  FLAGS_rocksdb_table_format = "BlockBasedTable";
+  fs::TempDir rootPath("/tmp/rocksdb_engine_NotFillCacheTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(0, kDefaultVIdLen, rootPath.path());
+  std::vector<KV> data;
+  for (int32_t i = 0; i < 1000; i++) {
+    data.emplace_back(folly::stringPrintf("key_%04d", i), std::string(1024, 'a' + i % 26));
+  }
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(data));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->flush());
+
+  auto cacheUsage = [&engine]() {
+    auto ret = engine->getProperty("rocksdb.block-cache-usage");
+    CHECK(ok(ret));
+    return folly::to<int64_t>(value(ret));
+  };
+  auto scan = [&engine](ScanMode mode) {
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->prefix("key_", &iter, nullptr, mode));
+    int32_t count = 0;
+    for (; iter->valid(); iter->next()) {
+      EXPECT_EQ(1024, iter->val().size());
+      count++;
+    }
+    EXPECT_EQ(1000, count);
+  };
+
+  // a bulk scan reads every block, but none of the data blocks is put into block cache
+  auto before = cacheUsage();
+  scan(ScanMode::kBulk);
+  auto afterBulkScan = cacheUsage();
+  scan(ScanMode::kDefault);
+  auto afterScan = cacheUsage();
+  EXPECT_GT(afterScan - afterBulkScan, 1000 * 1024 / 2);
+  EXPECT_LT(afterBulkScan - before, afterScan - afterBulkScan);
+}
+
+TEST(RocksEngineColumnFamilyTest, SeparateKeyTypesTest) {
+  FLAGS_rocksdb_separate_column_families = true;
+  SCOPE_EXIT {
+    FLAGS_rocksdb_separate_column_families = false;
+  };
+  fs::TempDir rootPath("/tmp/rocksdb_engine_SeparateKeyTypesTest.XXXXXX");
+  auto engine = std::make_unique<RocksEngine>(1, kDefaultVIdLen, rootPath.path());
+  auto tagKey = NebulaKeyUtils::tagKey(kDefaultVIdLen, 1, "v1", 1);
+  auto edgeKey = NebulaKeyUtils::edgeKey(kDefaultVIdLen, 1, "v1", 1, 0, "v2");
+  auto indexKey = IndexKeyUtils::indexPrefix(1, 1) + "index";
+  auto sysKey = NebulaKeyUtils::systemCommitKey(1);
+  std::vector<KV> data = {{tagKey, "tag"}, {edgeKey, "edge"}, {indexKey, "index"}, {sysKey, ""}};
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->multiPut(data));
+
+  std::vector<std::string> keys = {tagKey, edgeKey, indexKey};
+  std::vector<std::string> values;
+  for (const auto& status : engine->multiGet(keys, &values)) {
+    EXPECT_TRUE(status.ok());
+  }
+  EXPECT_EQ((std::vector<std::string>{"tag", "edge", "index"}), values);
+
+  auto collect = [](std::unique_ptr<KVIterator> iter) {
+    std::vector<std::string> result;
+    for (; iter->valid(); iter->next()) {
+      result.emplace_back(iter->key().str());
+    }
+    return result;
+  };
+  // All keys are scanned in order across column families
+  std::unique_ptr<KVIterator> iter;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->scan(&iter));
+  EXPECT_EQ((std::vector<std::string>{tagKey, edgeKey, indexKey, sysKey,
+                                      NebulaKeyUtils::dataVersionKey()}),
+            collect(std::move(iter)));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->prefix(NebulaKeyUtils::tagPrefix(kDefaultVIdLen, 1, "v1"), &iter));
+  EXPECT_EQ((std::vector<std::string>{tagKey}), collect(std::move(iter)));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->range(tagKey, sysKey, &iter));
+  EXPECT_EQ((std::vector<std::string>{tagKey, edgeKey, indexKey}), collect(std::move(iter)));
+
+  // Remove the edge and index across column families
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->removeRange(edgeKey, sysKey));
+  std::string val;
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get(edgeKey, &val));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND, engine->get(indexKey, &val));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(sysKey, &val));
+
+  // A batch which is not started by the engine is routed when committed
+  auto batch = std::make_unique<RocksWriteBatch>();
+  batch->put(edgeKey, "edge");
+  batch->put(indexKey, "index");
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->commitBatchWrite(std::move(batch), false, false, true));
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+            engine->prefix(IndexKeyUtils::indexPrefix(1, 1), &iter));
+  EXPECT_EQ((std::vector<std::string>{indexKey}), collect(std::move(iter)));
+
+  // Ingest a file with keys of all types
+  rocksdb::Options options;
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+  auto file = folly::stringPrintf("%s/%s", rootPath.path(), "data.sst");
+  ASSERT_TRUE(writer.Open(file).ok());
+  std::vector<std::string> ingested = {NebulaKeyUtils::tagKey(kDefaultVIdLen, 2, "v1", 1),
+                                       NebulaKeyUtils::edgeKey(kDefaultVIdLen, 2, "v1", 1, 0, "v2"),
+                                       IndexKeyUtils::indexPrefix(2, 1) + "index",
+                                       NebulaKeyUtils::systemCommitKey(2)};
+  std::sort(ingested.begin(), ingested.end());
+  for (const auto& key : ingested) {
+    ASSERT_TRUE(writer.Put(key, "ingested").ok());
+  }
+  ASSERT_TRUE(writer.Finish().ok());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->ingest({file}));
+  for (const auto& key : ingested) {
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(key, &val));
+    EXPECT_EQ("ingested", val);
+  }
+
+  // The layout on disk is kept even if the flag is turned off
+  engine.reset();
+  std::vector<std::string> cfNames;
+  ASSERT_TRUE(rocksdb::DB::ListColumnFamilies(
+                  rocksdb::DBOptions(), folly::stringPrintf("%s/nebula/1/data", rootPath.path()),
+                  &cfNames)
+                  .ok());
+  EXPECT_EQ(4, cfNames.size());
+  FLAGS_rocksdb_separate_column_families = false;
+  engine = std::make_unique<RocksEngine>(1, kDefaultVIdLen, rootPath.path());
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(tagKey, &val));
+  EXPECT_EQ("tag", val);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, engine->get(edgeKey, &val));
+  EXPECT_EQ("edge", val);
+}
+
 TEST(RebuildPrefixBloomFilter, RebuildPrefixBloomFilter) {
   GraphSpaceID spaceId = 1;
   // previously default config (prefix off whole on)
@@ -11,6 +11,7 @@
 #include "common/fs/FileUtils.h"
 #include "common/time/WallClock.h"
 #include "kvstore/wal/WalFileIterator.h"
+#include "kvstore/wal/WalFileReader.h"
 
 DEFINE_int32(wal_ttl, 14400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
@@ -65,6 +66,8 @@ FileBasedWal::FileBasedWal(const folly::StringPiece dir,
     lastLogTerm_ = info->lastTerm();
     VLOG(2) << idStr_ << "lastLogId in wal is " << lastLogId_ << ", lastLogTerm is " << lastLogTerm_
             << ", path is " << info->path();
+    // The last file will be appended, so its index is out of date
+    WalFileIndex::remove(info->path());
     currFd_ = open(info->path(), O_WRONLY | O_APPEND);
     currInfo_ = info;
     if (currFd_ < 0) {
@@ -226,11 +229,23 @@ void FileBasedWal::scanAllWalFiles() {
 
   if (!walFiles_.empty()) {
     auto it = walFiles_.rbegin();
-    // Try to scan last wal, if it is invalid or empty, scan the previous one
-    scanLastWal(it->second, it->second->firstId());
+    // The last wal has a valid index if it was closed normally, then there is no need to scan it.
+    // Otherwise try to scan last wal, if it is invalid or empty, scan the previous one
+    if (currIndex_.load(*it->second)) {
+      VLOG(2) << idStr_ << "Load the index of last wal " << it->second->path();
+      it->second->setLastId(currIndex_.lastId());
+      it->second->setLastTerm(currIndex_.lastTerm());
+    } else {
+      scanLastWal(it->second, it->second->firstId());
+    }
     if (it->second->lastId() <= 0) {
+      WalFileIndex::remove(it->second->path());
       unlink(it->second->path());
       walFiles_.erase(it->first);
+      if (!walFiles_.empty() && !currIndex_.load(*walFiles_.rbegin()->second)) {
+        // The offsets of logs in the file are unknown, seeking in it will start from the head
+        currIndex_.reset(walFiles_.rbegin()->second->firstId());
+      }
     }
   }
 
@@ -253,6 +268,7 @@ void FileBasedWal::scanAllWalFiles() {
       it = walFiles_.begin();
       while (it->second->firstId() < logIdAfterLastGap) {
         LOG(WARNING) << "Removing the wal file \"" << it->second->path() << "\"";
+        WalFileIndex::remove(it->second->path());
         unlink(it->second->path());
         it = walFiles_.erase(it);
       }
@@ -286,6 +302,9 @@ void FileBasedWal::closeCurrFile() {
   timebuf.actime = currInfo_->mtime();
   VLOG(4) << "Close cur file " << currInfo_->path() << ", mtime: " << currInfo_->mtime();
   utime(currInfo_->path(), &timebuf);
+  if (currInfo_->lastId() > 0) {
+    currIndex_.save(*currInfo_);
+  }
   currInfo_.reset();
 }
 
@@ -306,6 +325,7 @@ void FileBasedWal::prepareNewFile(LogID startLogId) {
                << "): " << strerror(errno);
   }
   currInfo_ = info;
+  currIndex_.reset(startLogId);
 }
 
 void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
@@ -315,30 +335,35 @@ void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
     LOG(FATAL) << "Failed to open file \"" << path << "\" (errno: " << errno
                << "): " << strerror(errno);
   }
+  // The file will be truncated, the index is rebuilt during scanning
+  WalFileIndex::remove(path);
+  currIndex_.reset(info->firstId());
 
+  WalFileReader reader(fd);
   size_t pos = 0;
   LogID id = 0;
   TermID term = 0;
   while (true) {
     // Read the log Id
-    if (pread(fd, &id, sizeof(LogID), pos) != sizeof(LogID)) {
+    if (!reader.read(pos, &id, sizeof(LogID))) {
       LOG(ERROR) << "Failed to read the log id (errno " << errno << "): " << strerror(errno);
       break;
     }
 
     // Read the term Id
-    if (pread(fd, &term, sizeof(TermID), pos + sizeof(LogID)) != sizeof(TermID)) {
+    if (!reader.read(pos + sizeof(LogID), &term, sizeof(TermID))) {
       LOG(ERROR) << "Failed to read the term id (errno " << errno << "): " << strerror(errno);
       break;
     }
 
     // Read the message length
     int32_t len;
-    if (pread(fd, &len, sizeof(int32_t), pos + sizeof(LogID) + sizeof(TermID)) != sizeof(int32_t)) {
+    if (!reader.read(pos + sizeof(LogID) + sizeof(TermID), &len, sizeof(int32_t))) {
       LOG(ERROR) << "Failed to read the message length (errno " << errno
                  << "): " << strerror(errno);
       break;
     }
+    currIndex_.add(id, pos);
 
     // Move to the next log
     pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + 2 * sizeof(int32_t) + len;
@@ -366,6 +391,8 @@ void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
   info->setLastId(id);
   info->setLastTerm(term);
   close(fd);
+  // The next log will be written to a new file, so the file is closed now
+  currIndex_.save(*info);
 }
 
 void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
@@ -375,7 +402,9 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
     LOG(FATAL) << "Failed to open file \"" << path << "\" (errno: " << errno
                << "): " << strerror(errno);
   }
+  currIndex_.reset(firstId);
 
+  WalFileReader reader(fd);
   LogID curLogId = firstId;
   size_t pos = 0;
   LogID id = 0;
@@ -384,7 +413,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
   int32_t foot = 0;
   while (true) {
     // Read the log Id
-    if (pread(fd, &id, sizeof(LogID), pos) != sizeof(LogID)) {
+    if (!reader.read(pos, &id, sizeof(LogID))) {
       break;
     }
 
@@ -394,21 +423,19 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
     }
 
     // Read the term Id
-    if (pread(fd, &term, sizeof(TermID), pos + sizeof(LogID)) != sizeof(TermID)) {
+    if (!reader.read(pos + sizeof(LogID), &term, sizeof(TermID))) {
       break;
     }
 
     // Read the message length
-    if (pread(fd, &head, sizeof(int32_t), pos + sizeof(LogID) + sizeof(TermID)) !=
-        sizeof(int32_t)) {
+    if (!reader.read(pos + sizeof(LogID) + sizeof(TermID), &head, sizeof(int32_t))) {
       break;
     }
 
-    if (pread(fd,
-              &foot,
-              sizeof(int32_t),
-              pos + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID) + head) !=
-        sizeof(int32_t)) {
+    if (!reader.read(
+            pos + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID) + head,
+            &foot,
+            sizeof(int32_t))) {
       break;
     }
 
@@ -419,6 +446,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
 
     info->setLastTerm(term);
     info->setLastId(id);
+    currIndex_.add(id, pos);
 
     // Move to the next log
     pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + sizeof(int32_t) + head +
@@ -476,6 +504,7 @@ bool FileBasedWal::appendLogInternal(LogID id,
     std::lock_guard<std::mutex> g(walFilesMutex_);
     prepareNewFile(id);
   }
+  currIndex_.add(id, currInfo_->size());
 
   ssize_t bytesWritten = write(currFd_, strBuf.data(), strBuf.size());
   if (bytesWritten != (ssize_t)strBuf.size()) {
@@ -591,6 +620,7 @@ bool FileBasedWal::rollbackToLog(LogID id) {
       while (it != walFiles_.end()) {
         // Need to remove the file
         VLOG(4) << "Removing file " << it->second->path();
+        WalFileIndex::remove(it->second->path());
         unlink(it->second->path());
         it = walFiles_.erase(it);
       }
@@ -632,6 +662,10 @@ bool FileBasedWal::reset() {
     VLOG(3) << "Removing " << absFn;
     unlink(absFn.c_str());
   }
+  auto indexDir = WalFileIndex::dir(dir_);
+  if (FileUtils::exist(indexDir)) {
+    FileUtils::remove(indexDir.c_str(), true);
+  }
   lastLogId_ = firstLogId_ = 0;
   lastLogTerm_ = 0;
   return true;
@@ -660,6 +694,7 @@ void FileBasedWal::cleanWAL() {
     if (index++ < size - 2 && (now - it->second->mtime() > walTTL)) {
       VLOG(3) << "Clean wals, Remove " << it->second->path() << ", now: " << now
               << ", mtime: " << it->second->mtime();
+      WalFileIndex::remove(it->second->path());
       unlink(it->second->path());
       it = walFiles_.erase(it);
       count++;
@@ -696,6 +731,7 @@ void FileBasedWal::cleanWAL(LogID id) {
   while (iter != walFiles_.end()) {
     if (iter->second->lastId() < id && index < size - 2 && (now - iter->second->mtime() > walTTL)) {
       VLOG(3) << "Clean wals, Remove " << iter->second->path();
+      WalFileIndex::remove(iter->second->path());
       unlink(iter->second->path());
       iter = walFiles_.erase(iter);
       index++;
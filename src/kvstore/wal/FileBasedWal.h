@@ -14,6 +14,7 @@
 #include "kvstore/DiskManager.h"
 #include "kvstore/wal/AtomicLogBuffer.h"
 #include "kvstore/wal/Wal.h"
+#include "kvstore/wal/WalFileIndex.h"
 #include "kvstore/wal/WalFileInfo.h"
 
 namespace nebula {
@@ -278,6 +279,8 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
   int32_t currFd_{-1};
   // The WalFileInfo corresponding to the currFd_
   WalFileInfoPtr currInfo_;
+  // The index of currFd_, saved when the file is closed
+  WalFileIndex currIndex_;
 
   std::shared_ptr<AtomicLogBuffer> logBuffer_;
 
@@ -0,0 +1,184 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/wal/WalFileIndex.h"
+
+#include <folly/hash/Checksum.h>
+
+#include "common/fs/FileUtils.h"
+
+namespace nebula {
+namespace wal {
+
+using nebula::fs::FileUtils;
+
+namespace {
+constexpr char kIndexDir[] = "index";
+// The layout of index file:
+// magic | version | firstId | lastId | lastTerm | wal size | count | (logId, offset) * count | crc
+constexpr uint32_t kMagic = 0x4e57494e;  // "NWIN"
+constexpr uint32_t kVersion = 1;
+constexpr size_t kHeaderSize = sizeof(uint32_t) * 2 + sizeof(LogID) * 2 + sizeof(TermID) +
+                               sizeof(uint64_t) * 2;
+constexpr size_t kEntrySize = sizeof(LogID) + sizeof(uint64_t);
+
+template <typename T>
+void appendValue(std::string& buf, T val) {
+  buf.append(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+T readValue(const char*& ptr) {
+  T val;
+  memcpy(&val, ptr, sizeof(T));
+  ptr += sizeof(T);
+  return val;
+}
+}  // namespace
+
+// static
+std::string WalFileIndex::path(const char* walPath) {
+  return FileUtils::joinPath(dir(FileUtils::dirname(walPath)),
+                             FileUtils::basename(walPath) + ".idx");
+}
+
+// static
+std::string WalFileIndex::dir(const std::string& walDir) {
+  return FileUtils::joinPath(walDir, kIndexDir);
+}
+
+// static
+void WalFileIndex::remove(const char* walPath) {
+  auto idxPath = path(walPath);
+  if (unlink(idxPath.c_str()) < 0 && errno != ENOENT) {
+    LOG(WARNING) << "Failed to remove wal index \"" << idxPath << "\" (" << errno
+                 << "): " << strerror(errno);
+  }
+}
+
+void WalFileIndex::reset(LogID firstId) {
+  firstId_ = firstId;
+  lastId_ = 0;
+  lastTerm_ = 0;
+  offsets_.clear();
+}
+
+void WalFileIndex::add(LogID id, size_t offset) {
+  if ((id - firstId_) % kInterval == 0) {
+    DCHECK(offsets_.empty() || offsets_.back().first < id);
+    offsets_.emplace_back(id, offset);
+  }
+}
+
+std::pair<LogID, size_t> WalFileIndex::seek(LogID id) const {
+  auto it = std::upper_bound(
+      offsets_.begin(), offsets_.end(), id, [](LogID target, const auto& entry) {
+        return target < entry.first;
+      });
+  if (it == offsets_.begin()) {
+    return {firstId_, 0};
+  }
+  return *(--it);
+}
+
+bool WalFileIndex::save(const WalFileInfo& info) const {
+  CHECK_EQ(firstId_, info.firstId());
+  std::string buf;
+  buf.reserve(kHeaderSize + offsets_.size() * kEntrySize + sizeof(uint32_t));
+  appendValue<uint32_t>(buf, kMagic);
+  appendValue<uint32_t>(buf, kVersion);
+  appendValue<LogID>(buf, info.firstId());
+  appendValue<LogID>(buf, info.lastId());
+  appendValue<TermID>(buf, info.lastTerm());
+  appendValue<uint64_t>(buf, info.size());
+  appendValue<uint64_t>(buf, offsets_.size());
+  for (const auto& entry : offsets_) {
+    appendValue<LogID>(buf, entry.first);
+    appendValue<uint64_t>(buf, entry.second);
+  }
+  appendValue<uint32_t>(buf, folly::crc32c(reinterpret_cast<const uint8_t*>(buf.data()),
+                                           buf.size()));
+
+  auto idxDir = dir(FileUtils::dirname(info.path()));
+  if (!FileUtils::exist(idxDir) && !FileUtils::makeDir(idxDir)) {
+    LOG(WARNING) << "Failed to make wal index dir \"" << idxDir << "\"";
+    return false;
+  }
+  // Write to a temp file first, so a crash would never leave a broken index
+  auto idxPath = path(info.path());
+  auto tmpPath = idxPath + ".tmp";
+  int fd = open(tmpPath.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    LOG(WARNING) << "Failed to open wal index \"" << tmpPath << "\" (" << errno
+                 << "): " << strerror(errno);
+    return false;
+  }
+  bool ok = write(fd, buf.data(), buf.size()) == static_cast<ssize_t>(buf.size()) &&
+            ::fsync(fd) == 0;
+  close(fd);
+  if (!ok) {
+    LOG(WARNING) << "Failed to write wal index \"" << tmpPath << "\" (" << errno
+                 << "): " << strerror(errno);
+    unlink(tmpPath.c_str());
+    return false;
+  }
+  return FileUtils::rename(tmpPath, idxPath);
+}
+
+bool WalFileIndex::load(const WalFileInfo& info) {
+  auto idxPath = path(info.path());
+  int fd = open(idxPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) < 0 || static_cast<size_t>(st.st_size) < kHeaderSize + sizeof(uint32_t)) {
+    close(fd);
+    return false;
+  }
+  std::string buf;
+  buf.resize(st.st_size);
+  bool ok = pread(fd, &buf[0], buf.size(), 0) == static_cast<ssize_t>(buf.size());
+  close(fd);
+  if (!ok) {
+    return false;
+  }
+
+  auto dataSize = buf.size() - sizeof(uint32_t);
+  const char* ptr = buf.data() + dataSize;
+  if (readValue<uint32_t>(ptr) !=
+      folly::crc32c(reinterpret_cast<const uint8_t*>(buf.data()), dataSize)) {
+    LOG(WARNING) << "Checksum mismatch of wal index \"" << idxPath << "\", ignore it";
+    return false;
+  }
+  ptr = buf.data();
+  if (readValue<uint32_t>(ptr) != kMagic || readValue<uint32_t>(ptr) != kVersion) {
+    return false;
+  }
+  auto firstId = readValue<LogID>(ptr);
+  auto lastId = readValue<LogID>(ptr);
+  auto lastTerm = readValue<TermID>(ptr);
+  auto walSize = readValue<uint64_t>(ptr);
+  auto count = readValue<uint64_t>(ptr);
+  if (firstId != info.firstId() || walSize != info.size() || lastId < firstId ||
+      dataSize != kHeaderSize + count * kEntrySize) {
+    VLOG(2) << "The wal index \"" << idxPath << "\" is out of date";
+    return false;
+  }
+
+  reset(firstId);
+  lastId_ = lastId;
+  lastTerm_ = lastTerm;
+  offsets_.reserve(count);
+  for (uint64_t i = 0; i < count; i++) {
+    auto id = readValue<LogID>(ptr);
+    auto offset = readValue<uint64_t>(ptr);
+    offsets_.emplace_back(id, offset);
+  }
+  return true;
+}
+
+}  // namespace wal
+}  // namespace nebula
@@ -0,0 +1,102 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WAL_WALFILEINDEX_H_
+#define WAL_WALFILEINDEX_H_
+
+#include "common/base/Base.h"
+#include "kvstore/wal/WalFileInfo.h"
+
+namespace nebula {
+namespace wal {
+
+/**
+ * @brief Sparse index of a closed wal file, saved as "index/<wal file>.idx" in the wal dir. It
+ * records the last log of the file and the offset of every kInterval logs, so that the last wal
+ * file doesn't need to be scanned after a normal shutdown, and an iterator could seek to a log
+ * without reading all logs before it.
+ *
+ * The index is only valid when the size of wal file matches, it is removed once the wal file will
+ * be appended or truncated.
+ */
+class WalFileIndex final {
+ public:
+  // Record the offset of one log in every kInterval logs
+  static constexpr LogID kInterval = 64;
+
+  /**
+   * @brief Return the index file path of a wal file
+   */
+  static std::string path(const char* walPath);
+
+  /**
+   * @brief Return the dir of index files in a wal dir
+   */
+  static std::string dir(const std::string& walDir);
+
+  /**
+   * @brief Remove the index file of a wal file if exists
+   */
+  static void remove(const char* walPath);
+
+  /**
+   * @brief Clear the index, the first log will be firstId
+   */
+  void reset(LogID firstId);
+
+  /**
+   * @brief Add a log which is written at given offset, logs must be added in order
+   */
+  void add(LogID id, size_t offset);
+
+  /**
+   * @brief Find the indexed log which is nearest to id, but not after it
+   *
+   * @return std::pair<LogID, size_t> The log id and its offset, {firstId, 0} if not found
+   */
+  std::pair<LogID, size_t> seek(LogID id) const;
+
+  /**
+   * @brief Save the index of a closed wal file
+   *
+   * @param info Wal file info, its last log and size are saved in the index
+   * @return Whether succeed
+   */
+  bool save(const WalFileInfo& info) const;
+
+  /**
+   * @brief Load the index of a wal file
+   *
+   * @param info Wal file info, its first log id and size must be the same as the index
+   * @return Whether the index exists and is valid
+   */
+  bool load(const WalFileInfo& info);
+
+  /**
+   * @brief Last log id in the loaded index
+   */
+  LogID lastId() const {
+    return lastId_;
+  }
+
+  /**
+   * @brief Last log term in the loaded index
+   */
+  TermID lastTerm() const {
+    return lastTerm_;
+  }
+
+ private:
+  LogID firstId_{0};
+  LogID lastId_{0};
+  TermID lastTerm_{0};
+  // (log id, offset in file)
+  std::vector<std::pair<LogID, size_t>> offsets_;
+};
+
+}  // namespace wal
+}  // namespace nebula
+
+#endif  // WAL_WALFILEINDEX_H_
@@ -7,6 +7,7 @@
 
 #include "common/base/Base.h"
 #include "kvstore/wal/FileBasedWal.h"
+#include "kvstore/wal/WalFileIndex.h"
 #include "kvstore/wal/WalFileInfo.h"
 
 namespace nebula {
@@ -28,7 +29,8 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
   }
 
   // We need to read from the WAL files
-  wal_->accessAllWalInfo([this](WalFileInfoPtr info) {
+  WalFileInfoPtr firstInfo;
+  wal_->accessAllWalInfo([this, &firstInfo](WalFileInfoPtr info) {
     int fd = open(info->path(), O_RDONLY);
     if (fd < 0) {
       LOG(WARNING) << "Failed to open wal file \"" << info->path() << "\" (" << errno
@@ -41,6 +43,7 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
 
     if (info->firstId() <= currId_) {
       // Go no further
+      firstInfo = info;
       return false;
     } else {
       return true;
@@ -62,30 +65,17 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
   }
 
   if (!idRanges_.empty()) {
-    // Find the correct position in the first WAL file
+    // Find the correct position in the first WAL file, start from the nearest indexed log if the
+    // file has been closed
+    reader_ = std::make_unique<WalFileReader>(fds_.front());
     currPos_ = 0;
+    WalFileIndex index;
+    if (firstInfo != nullptr && index.load(*firstInfo)) {
+      currPos_ = index.seek(currId_).second;
+    }
     while (true) {
       LogID logId;
-      // Read the logID
-      int fd = fds_.front();
-      if (pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), currPos_) !=
-          static_cast<ssize_t>(sizeof(LogID))) {
-        eof_ = true;
-        break;
-      }
-      // Read the termID
-      if (pread(
-              fd, reinterpret_cast<char*>(&currTerm_), sizeof(TermID), currPos_ + sizeof(LogID)) !=
-          static_cast<ssize_t>(sizeof(TermID))) {
-        eof_ = true;
-        break;
-      }
-      // Read the log length
-      if (pread(fd,
-                reinterpret_cast<char*>(&currMsgLen_),
-                sizeof(int32_t),
-                currPos_ + sizeof(LogID) + sizeof(TermID)) !=
-          static_cast<ssize_t>(sizeof(int32_t))) {
+      if (!readLogHeader(&logId)) {
         eof_ = true;
         break;
       }
@@ -125,6 +115,7 @@ LogIterator& WalFileIterator::operator++() {
     nextFirstId_ = getFirstIdInNextFile();
     CHECK_EQ(currId_, idRanges_.front().first);
     currPos_ = 0;
+    reader_ = std::make_unique<WalFileReader>(fds_.front());
   } else {
     // Move to the next log
     currPos_ +=
@@ -137,35 +128,12 @@ LogIterator& WalFileIterator::operator++() {
     return *this;
   } else {
     LogID logId;
-    int fd = fds_.front();
-    do {
-      // Read the logID
-      if (pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), currPos_) !=
-          static_cast<ssize_t>(sizeof(LogID))) {
-        VLOG(3) << "Failed to read logId currPos = " << currPos_;
-        eof_ = true;
-        break;
-      }
+    if (!readLogHeader(&logId)) {
+      VLOG(3) << "Failed to read log currPos = " << currPos_;
+      eof_ = true;
+    } else {
       CHECK_EQ(currId_, logId);
-      // Read the termID
-      if (pread(
-              fd, reinterpret_cast<char*>(&currTerm_), sizeof(TermID), currPos_ + sizeof(LogID)) !=
-          static_cast<ssize_t>(sizeof(TermID))) {
-        VLOG(3) << "Failed to read term currPos = " << currPos_;
-        eof_ = true;
-        break;
-      }
-      // Read the log length
-      if (pread(fd,
-                reinterpret_cast<char*>(&currMsgLen_),
-                sizeof(int32_t),
-                currPos_ + sizeof(TermID) + sizeof(LogID)) !=
-          static_cast<ssize_t>(sizeof(int32_t))) {
-        VLOG(3) << "Failed to read log length currPos = " << currPos_;
-        eof_ = true;
-        break;
-      }
-    } while (false);
+    }
   }
 
   return *this;
@@ -187,11 +155,8 @@ ClusterID WalFileIterator::logSource() const {
   // Retrieve from the file
   DCHECK(!fds_.empty());
   ClusterID cluster = 0;
-  CHECK_EQ(pread(fds_.front(),
-                 &(cluster),
-                 sizeof(ClusterID),
-                 currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t)),
-           static_cast<ssize_t>(sizeof(ClusterID)))
+  CHECK(reader_->read(
+      currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t), &(cluster), sizeof(ClusterID)))
       << "Failed to read. Curr position is " << currPos_ << ", expected read length is "
       << sizeof(ClusterID) << " (errno: " << errno << "): " << strerror(errno);
 
@@ -203,17 +168,22 @@ folly::StringPiece WalFileIterator::logMsg() const {
   DCHECK(!fds_.empty());
 
   currLog_.resize(currMsgLen_);
-  CHECK_EQ(pread(fds_.front(),
-                 &(currLog_[0]),
-                 currMsgLen_,
-                 currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID)),
-           static_cast<ssize_t>(currMsgLen_))
+  CHECK(reader_->read(
+      currPos_ + sizeof(LogID) + sizeof(TermID) + sizeof(int32_t) + sizeof(ClusterID),
+      &(currLog_[0]),
+      currMsgLen_))
       << "Failed to read. Curr position is " << currPos_ << ", expected read length is "
       << currMsgLen_ << " (errno: " << errno << "): " << strerror(errno);
 
   return currLog_;
 }
 
+bool WalFileIterator::readLogHeader(LogID* logId) {
+  return reader_->read(currPos_, logId, sizeof(LogID)) &&
+         reader_->read(currPos_ + sizeof(LogID), &currTerm_, sizeof(TermID)) &&
+         reader_->read(currPos_ + sizeof(LogID) + sizeof(TermID), &currMsgLen_, sizeof(int32_t));
+}
+
 LogID WalFileIterator::getFirstIdInNextFile() const {
   auto it = idRanges_.begin();
   ++it;
@@ -8,6 +8,7 @@
 
 #include "common/base/Base.h"
 #include "common/utils/LogIterator.h"
+#include "kvstore/wal/WalFileReader.h"
 
 namespace nebula {
 namespace wal {
@@ -71,6 +72,14 @@ class WalFileIterator final : public LogIterator {
    */
   LogID getFirstIdInNextFile() const;
 
+  /**
+   * @brief Read the log id, term and message length at currPos_ in current wal file
+   *
+   * @param logId Log id read
+   * @return Whether succeed
+   */
+  bool readLogHeader(LogID* logId);
+
  private:
   // Holds the Wal object, so that it will not be destroyed before the iterator
   std::shared_ptr<FileBasedWal> wal_;
@@ -86,6 +95,8 @@ class WalFileIterator final : public LogIterator {
   // [firstId, lastId]
   std::list<std::pair<LogID, LogID>> idRanges_;
   std::list<int> fds_;
+  // Reader of fds_.front()
+  std::unique_ptr<WalFileReader> reader_;
   int64_t currPos_{0};
   int32_t currMsgLen_{0};
   // Whether we have encounter end of wal file during building iterator or iterating
@@ -0,0 +1,60 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/wal/WalFileReader.h"
+
+DEFINE_int32(wal_read_buffer_size,
+             1024 * 1024,
+             "The max size of chunk read at once when scanning wal files");
+
+namespace nebula {
+namespace wal {
+
+namespace {
+constexpr size_t kMinReadAhead = 4096;
+}  // namespace
+
+WalFileReader::WalFileReader(int fd, size_t maxBufferSize)
+    : fd_(fd),
+      maxBufferSize_(std::max(maxBufferSize, kMinReadAhead)),
+      readAhead_(kMinReadAhead) {}
+
+bool WalFileReader::read(size_t pos, void* data, size_t len) {
+  if (pos < bufferPos_ || pos + len > bufferPos_ + bufferLen_) {
+    if (len >= maxBufferSize_) {
+      // Too large to be buffered, read it directly
+      return pread(fd_, data, len, pos) == static_cast<ssize_t>(len);
+    }
+    fill(pos, len);
+    if (pos + len > bufferPos_ + bufferLen_) {
+      return false;
+    }
+  }
+  memcpy(data, buffer_.data() + (pos - bufferPos_), len);
+  return true;
+}
+
+void WalFileReader::fill(size_t pos, size_t len) {
+  auto size = std::max(readAhead_, len);
+  readAhead_ = std::min(readAhead_ * 2, maxBufferSize_);
+  if (buffer_.size() < size) {
+    buffer_.resize(size);
+  }
+  bufferPos_ = pos;
+  bufferLen_ = 0;
+  while (bufferLen_ < size) {
+    auto n = pread(fd_, &buffer_[bufferLen_], size - bufferLen_, pos + bufferLen_);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    bufferLen_ += n;
+  }
+}
+
+}  // namespace wal
+}  // namespace nebula
@@ -0,0 +1,67 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WAL_WALFILEREADER_H_
+#define WAL_WALFILEREADER_H_
+
+#include "common/base/Base.h"
+
+DECLARE_int32(wal_read_buffer_size);
+
+namespace nebula {
+namespace wal {
+
+/**
+ * @brief Buffered reader of a wal file. The wal logs are almost always read one by one, so each
+ * pread fetches a chunk of the file, which serves the id, term, length and message of many logs.
+ * The chunk starts small and doubles on every refill, so reading a single log stays cheap.
+ */
+class WalFileReader final {
+ public:
+  /**
+   * @brief Construct a new wal file reader, the fd is owned by the caller
+   *
+   * @param fd The opened wal file
+   * @param maxBufferSize The max size of the chunk read at once
+   */
+  explicit WalFileReader(int fd, size_t maxBufferSize = FLAGS_wal_read_buffer_size);
+
+  /**
+   * @brief Read len bytes at the given offset of the file
+   *
+   * @param pos Offset in file
+   * @param data Buffer to fill
+   * @param len Bytes to read
+   * @return Whether all len bytes are read
+   */
+  bool read(size_t pos, void* data, size_t len);
+
+  /**
+   * @brief Return the underlying fd
+   */
+  int fd() const {
+    return fd_;
+  }
+
+ private:
+  /**
+   * @brief Refill the buffer from pos, at least len bytes are wanted
+   */
+  void fill(size_t pos, size_t len);
+
+ private:
+  const int fd_;
+  const size_t maxBufferSize_;
+  size_t readAhead_;
+  std::string buffer_;
+  // The buffer holds file content in [bufferPos_, bufferPos_ + bufferLen_)
+  size_t bufferPos_{0};
+  size_t bufferLen_{0};
+};
+
+}  // namespace wal
+}  // namespace nebula
+
+#endif  // WAL_WALFILEREADER_H_
@@ -8,6 +8,7 @@
 #include "common/base/Base.h"
 #include "common/fs/TempDir.h"
 #include "kvstore/wal/FileBasedWal.h"
+#include "kvstore/wal/WalFileIndex.h"
 
 DECLARE_int32(wal_ttl);
 
@@ -602,6 +603,86 @@ TEST(FileBasedWal, getLogTermTest) {
   EXPECT_EQ(10, wal->getLogTerm(10));
 }
 
+TEST(FileBasedWal, IndexTest) {
+  TempDir walDir("/tmp/testWal.XXXXXX");
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 1024L * 1024L;
+  policy.bufferSize = 1024L * 1024L;
+
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  // Append > 3MB logs in total
+  for (int i = 1; i <= 3000; i++) {
+    ASSERT_TRUE(
+        wal->appendLog(i /*id*/, i /*term*/, 0 /*cluster*/, folly::stringPrintf(kLongMsg, i)));
+  }
+  // All files except the last one are indexed when rolling over
+  auto walFiles = FileUtils::listAllFilesInDir(walDir.path(), true, "*.wal");
+  std::sort(walFiles.begin(), walFiles.end());
+  auto indexDir = WalFileIndex::dir(walDir.path());
+  ASSERT_EQ(walFiles.size() - 1, FileUtils::listAllFilesInDir(indexDir.c_str()).size());
+
+  // The last file is indexed when closed
+  wal.reset();
+  ASSERT_EQ(walFiles.size(), FileUtils::listAllFilesInDir(indexDir.c_str()).size());
+
+  auto checkLogs = [&](LogID start, LogID end) {
+    auto it = wal->iterator(start, end);
+    LogID id = start;
+    while (it->valid()) {
+      ASSERT_EQ(id, it->logId());
+      ASSERT_EQ(id, it->logTerm());
+      ASSERT_EQ(folly::stringPrintf(kLongMsg, id), it->logMsg());
+      ++(*it);
+      ++id;
+    }
+    EXPECT_EQ(end + 1, id);
+  };
+
+  // The last log is got from the index, and the iterator seeks by the index
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(3000, wal->lastLogId());
+  EXPECT_EQ(3000, wal->lastLogTerm());
+  // The last file is being appended, so its index is removed
+  ASSERT_EQ(walFiles.size() - 1, FileUtils::listAllFilesInDir(indexDir.c_str()).size());
+  for (LogID start : {1, 63, 64, 65, 129, 1000, 2500}) {
+    checkLogs(start, 3000);
+  }
+  wal.reset();
+
+  // A broken index is ignored, the last file is scanned instead
+  auto lastIndex = WalFileIndex::path(walFiles.back().c_str());
+  auto fd = open(lastIndex.c_str(), O_WRONLY);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(static_cast<ssize_t>(sizeof(LogID)), pwrite(fd, "bad index", sizeof(LogID), 8));
+  close(fd);
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(3000, wal->lastLogId());
+  EXPECT_EQ(3000, wal->lastLogTerm());
+  checkLogs(2990, 3000);
+
+  // Rollback rebuilds the index of the file rolled back
+  ASSERT_TRUE(wal->rollbackToLog(1500));
+  EXPECT_EQ(1500, wal->lastLogId());
+  wal.reset();
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(1500, wal->lastLogId());
+  EXPECT_EQ(1500, wal->lastLogTerm());
+  checkLogs(1400, 1500);
+}
+
 }  // namespace wal
 }  // namespace nebula
 
@@ -115,6 +115,11 @@ nebula::cpp2::ErrorCode MetaServiceUtils::alterColumnDefs(
             LOG(INFO) << "Column: " << colName << " as ttl_col, change not allowed";
             return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
           }
+          // The adjacency index is sorted by the column, change not allowed
+          if (prop.get_adjacency_order_col() && (*prop.get_adjacency_order_col() == colName)) {
+            LOG(INFO) << "Column: " << colName << " as adjacency_order, change not allowed";
+            return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+          }
           if (!isLegalTypeConversion(it->get_type(), col.get_type())) {
             LOG(ERROR) << "Update colume type " << colName << " from "
                        << apache::thrift::util::enumNameSafe(it->get_type().get_type()) << " to "
@@ -135,6 +140,10 @@ nebula::cpp2::ErrorCode MetaServiceUtils::alterColumnDefs(
       for (auto it = cols.begin(); it != cols.end(); ++it) {
         auto colName = col.get_name();
         if (colName == it->get_name()) {
+          if (prop.get_adjacency_order_col() && (*prop.get_adjacency_order_col() == colName)) {
+            LOG(INFO) << "Column: " << colName << " as adjacency_order, drop not allowed";
+            return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+          }
           if (prop.get_ttl_col() && (*prop.get_ttl_col() == colName)) {
             prop.ttl_duration_ref() = 0;
             prop.ttl_col_ref() = "";
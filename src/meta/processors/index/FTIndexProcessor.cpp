@@ -6,6 +6,7 @@
 #include "meta/processors/index/FTIndexProcessor.h"
 
 #include "common/base/CommonMacro.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
 #include "common/plugin/fulltext/elasticsearch/ESAdapter.h"
 #include "kvstore/LogEncoder.h"
 
@@ -104,39 +105,43 @@ void CreateFTIndexProcessor::process(const cpp2::CreateFTIndexReq& req) {
     // }
     it->next();
   }
-  const auto& serviceKey = MetaKeyUtils::serviceKey(cpp2::ExternalServiceType::ELASTICSEARCH);
-  auto getRet = doGet(serviceKey);
-  if (!nebula::ok(getRet)) {
-    auto retCode = nebula::error(getRet);
-    LOG(INFO) << "Create fulltext index failed, error: "
-              << apache::thrift::util::enumNameSafe(retCode);
-    handleErrorCode(retCode);
-    onFinished();
-    return;
-  }
+  // The builtin index is maintained by storage itself, without elasticsearch
+  if (index.get_analyzer() != plugin::kBuiltinAnalyzer) {
+    const auto& serviceKey = MetaKeyUtils::serviceKey(cpp2::ExternalServiceType::ELASTICSEARCH);
+    auto getRet = doGet(serviceKey);
+    if (!nebula::ok(getRet)) {
+      auto retCode = nebula::error(getRet);
+      LOG(INFO) << "Create fulltext index failed, error: "
+                << apache::thrift::util::enumNameSafe(retCode);
+      handleErrorCode(retCode);
+      onFinished();
+      return;
+    }
 
-  auto clients = MetaKeyUtils::parseServiceClients(nebula::value(getRet));
-  if (clients.size() <= 0) {
-    handleErrorCode(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND);
-    onFinished();
-    return;
-  }
-  std::vector<plugin::ESClient> esClients;
-  for (auto& client : clients) {
-    std::string protocol = client.conn_type_ref().has_value() ? *client.get_conn_type() : "http";
-    std::string user = client.user_ref().has_value() ? *client.get_user() : "";
-    std::string password = client.pwd_ref().has_value() ? *client.get_pwd() : "";
-    esClients.emplace_back(
-        HttpClient::instance(), protocol, client.get_host().toRawString(), user, password);
-  }
-  plugin::ESAdapter esAdapter(std::move(esClients));
-  auto createIndexresult = esAdapter.createIndex(name, index.get_fields(), index.get_analyzer());
-  if (!createIndexresult.ok()) {
-    LOG(ERROR) << createIndexresult.message();
-    handleErrorCode(nebula::cpp2::ErrorCode::E_ACCESS_ES_FAILURE);
-    onFinished();
-    return;
+    auto clients = MetaKeyUtils::parseServiceClients(nebula::value(getRet));
+    if (clients.size() <= 0) {
+      handleErrorCode(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND);
+      onFinished();
+      return;
+    }
+    std::vector<plugin::ESClient> esClients;
+    for (auto& client : clients) {
+      std::string protocol = client.conn_type_ref().has_value() ? *client.get_conn_type() : "http";
+      std::string user = client.user_ref().has_value() ? *client.get_user() : "";
+      std::string password = client.pwd_ref().has_value() ? *client.get_pwd() : "";
+      esClients.emplace_back(
+          HttpClient::instance(), protocol, client.get_host().toRawString(), user, password);
+    }
+    plugin::ESAdapter esAdapter(std::move(esClients));
+    auto createIndexresult = esAdapter.createIndex(name, index.get_fields(), index.get_analyzer());
+    if (!createIndexresult.ok()) {
+      LOG(ERROR) << createIndexresult.message();
+      handleErrorCode(nebula::cpp2::ErrorCode::E_ACCESS_ES_FAILURE);
+      onFinished();
+      return;
+    }
   }
+
   std::vector<kvstore::KV> data;
   data.emplace_back(MetaKeyUtils::fulltextIndexKey(name), MetaKeyUtils::fulltextIndexVal(index));
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
@@ -166,38 +171,41 @@ void DropFTIndexProcessor::process(const cpp2::DropFTIndexReq& req) {
     return;
   }
 
-  const auto& serviceKey = MetaKeyUtils::serviceKey(cpp2::ExternalServiceType::ELASTICSEARCH);
-  auto getRet = doGet(serviceKey);
-  if (!nebula::ok(getRet)) {
-    auto retCode = nebula::error(getRet);
-    LOG(INFO) << "Drop fulltext index failed, error: "
-              << apache::thrift::util::enumNameSafe(retCode);
-    handleErrorCode(retCode);
-    onFinished();
-    return;
-  }
+  auto index = MetaKeyUtils::parsefulltextIndex(nebula::value(ret));
+  if (index.get_analyzer() != plugin::kBuiltinAnalyzer) {
+    const auto& serviceKey = MetaKeyUtils::serviceKey(cpp2::ExternalServiceType::ELASTICSEARCH);
+    auto getRet = doGet(serviceKey);
+    if (!nebula::ok(getRet)) {
+      auto retCode = nebula::error(getRet);
+      LOG(INFO) << "Drop fulltext index failed, error: "
+                << apache::thrift::util::enumNameSafe(retCode);
+      handleErrorCode(retCode);
+      onFinished();
+      return;
+    }
 
-  auto clients = MetaKeyUtils::parseServiceClients(nebula::value(getRet));
-  if (clients.size() <= 0) {
-    handleErrorCode(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND);
-    onFinished();
-    return;
-  }
-  std::vector<plugin::ESClient> esClients;
-  for (auto& client : clients) {
-    std::string protocol = client.conn_type_ref().has_value() ? *client.get_conn_type() : "http";
-    std::string user = client.user_ref().has_value() ? *client.get_user() : "";
-    std::string password = client.pwd_ref().has_value() ? *client.get_pwd() : "";
-    esClients.emplace_back(
-        HttpClient::instance(), protocol, client.get_host().toRawString(), user, password);
-  }
-  plugin::ESAdapter esAdapter(std::move(esClients));
-  auto dropIndexresult = esAdapter.dropIndex(req.get_fulltext_index_name());
-  if (!dropIndexresult.ok()) {
-    LOG(ERROR) << dropIndexresult.message();
-    handleErrorCode(nebula::cpp2::ErrorCode::E_ACCESS_ES_FAILURE);
-    onFinished();
-    return;
+    auto clients = MetaKeyUtils::parseServiceClients(nebula::value(getRet));
+    if (clients.size() <= 0) {
+      handleErrorCode(nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND);
+      onFinished();
+      return;
+    }
+    std::vector<plugin::ESClient> esClients;
+    for (auto& client : clients) {
+      std::string protocol = client.conn_type_ref().has_value() ? *client.get_conn_type() : "http";
+      std::string user = client.user_ref().has_value() ? *client.get_user() : "";
+      std::string password = client.pwd_ref().has_value() ? *client.get_pwd() : "";
+      esClients.emplace_back(
+          HttpClient::instance(), protocol, client.get_host().toRawString(), user, password);
+    }
+    plugin::ESAdapter esAdapter(std::move(esClients));
+    auto dropIndexresult = esAdapter.dropIndex(req.get_fulltext_index_name());
+    if (!dropIndexresult.ok()) {
+      LOG(ERROR) << dropIndexresult.message();
+      handleErrorCode(nebula::cpp2::ErrorCode::E_ACCESS_ES_FAILURE);
+      onFinished();
+      return;
+    }
   }
 
   auto batchHolder = std::make_unique<kvstore::BatchHolder>();
@@ -27,9 +27,22 @@ nebula::cpp2::ErrorCode DownloadJobExecutor::check() {
   }
 
   auto& url = paras_[0];
+  // The files are copied from a path of each storaged, which is usually a shared one
+  std::string localPrefix = "file://";
+  if (url.find(localPrefix) == 0) {
+    host_ = std::make_unique<std::string>();
+    port_ = 0;
+    path_ = std::make_unique<std::string>(url.substr(localPrefix.size()));
+    if (path_->empty() || path_->front() != '/') {
+      LOG(ERROR) << "Local path should be absolute: " << url;
+      return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   std::string hdfsPrefix = "hdfs://";
   if (url.find(hdfsPrefix) != 0) {
-    LOG(ERROR) << "URL should start with " << hdfsPrefix;
+    LOG(ERROR) << "URL should start with " << hdfsPrefix << " or " << localPrefix;
     return nebula::cpp2::ErrorCode::E_INVALID_JOB;
   }
 
@@ -67,12 +80,15 @@ nebula::cpp2::ErrorCode DownloadJobExecutor::prepare() {
     return nebula::error(errOrHost);
   }
 
-  LOG(INFO) << "HDFS host: " << *host_.get() << " port: " << port_ << " path: " << *path_.get();
-
-  auto listResult = helper_->ls(*host_.get(), port_, *path_.get());
-  if (!listResult.ok()) {
-    LOG(ERROR) << "Dispatch SSTFile Failed";
-    return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+  if (host_->empty()) {
+    LOG(INFO) << "Local path: " << *path_.get();
+  } else {
+    LOG(INFO) << "HDFS host: " << *host_.get() << " port: " << port_ << " path: " << *path_.get();
+    auto listResult = helper_->ls(*host_.get(), port_, *path_.get());
+    if (!listResult.ok()) {
+      LOG(ERROR) << "Dispatch SSTFile Failed";
+      return nebula::cpp2::ErrorCode::E_INVALID_JOB;
+    }
   }
 
   taskParameters_.emplace_back(*host_.get());
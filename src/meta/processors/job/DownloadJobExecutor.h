@@ -17,6 +17,7 @@ namespace meta {
  */
 class DownloadJobExecutor : public SimpleConcurrentJobExecutor {
   FRIEND_TEST(JobManagerTest, DownloadJob);
+  FRIEND_TEST(JobManagerTest, DownloadJobFromLocal);
   FRIEND_TEST(JobManagerTest, IngestJob);
 
  public:
@@ -5,9 +5,36 @@
 
 #include "meta/processors/job/RebuildFTJobExecutor.h"
 
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+#include "common/utils/MetaKeyUtils.h"
+
 namespace nebula {
 namespace meta {
 
+nebula::cpp2::ErrorCode RebuildFTJobExecutor::prepare() {
+  auto code = RebuildJobExecutor::prepare();
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  std::unique_ptr<kvstore::KVIterator> iter;
+  code = kvstore_->prefix(
+      kDefaultSpaceId, kDefaultPartId, MetaKeyUtils::fulltextIndexPrefix(), &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  bool external = false;
+  for (; iter->valid(); iter->next()) {
+    auto index = MetaKeyUtils::parsefulltextIndex(iter->val());
+    if (index.get_space_id() == space_ && index.get_analyzer() != plugin::kBuiltinAnalyzer) {
+      external = true;
+    }
+  }
+  // The builtin indexes are rebuilt by the leaders, which also remove the dropped ones, and the
+  // others by the elasticsearch listeners
+  toHost_ = external ? TargetHosts::LEADER_AND_LISTENER : TargetHosts::LEADER;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 folly::Future<Status> RebuildFTJobExecutor::executeInternal(HostAddr&& address,
                                                             std::vector<PartitionID>&& parts) {
   folly::Promise<Status> pro;
@@ -22,6 +22,8 @@ class RebuildFTJobExecutor : public RebuildJobExecutor {
     toHost_ = TargetHosts::LISTENER;
   }
 
+  nebula::cpp2::ErrorCode prepare() override;
+
   nebula::cpp2::ErrorCode stop() override {
     // Unlike rebuild tag/edge idnex, rebuild full text job is not stoppable
     return nebula::cpp2::ErrorCode::E_JOB_NOT_STOPPABLE;
@@ -150,6 +150,21 @@ folly::Future<nebula::cpp2::ErrorCode> StorageJobExecutor::execute() {
       addressesRet = getTargetHost(space_);
       break;
     }
+    case TargetHosts::LEADER_AND_LISTENER: {
+      addressesRet = getLeaderHost(space_);
+      if (!nebula::ok(addressesRet)) {
+        break;
+      }
+      auto listenersRet = getListenerHost(space_, cpp2::ListenerType::ELASTICSEARCH);
+      if (!nebula::ok(listenersRet)) {
+        addressesRet = nebula::error(listenersRet);
+        break;
+      }
+      auto& leaders = nebula::value(addressesRet);
+      auto& listeners = nebula::value(listenersRet);
+      leaders.insert(leaders.end(), listeners.begin(), listeners.end());
+      break;
+    }
   }
 
   if (!nebula::ok(addressesRet)) {
@@ -22,7 +22,7 @@ using ErrOrHosts = ErrorOr<nebula::cpp2::ErrorCode, std::vector<PartsOfHost>>;
 
 class StorageJobExecutor : public JobExecutor {
  public:
-  enum class TargetHosts { LEADER = 0, LISTENER, DEFAULT };
+  enum class TargetHosts { LEADER = 0, LISTENER, DEFAULT, LEADER_AND_LISTENER };
 
   StorageJobExecutor(GraphSpaceID space,
                      JobID jobId,
@@ -1306,6 +1306,37 @@ TEST_F(JobManagerTest, DownloadJob) {
   ASSERT_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
 }
 
+TEST_F(JobManagerTest, DownloadJobFromLocal) {
+  auto rootPath = std::make_unique<fs::TempDir>("/tmp/JobManagerTest.XXXXXX");
+  mock::MockCluster cluster;
+  std::unique_ptr<kvstore::KVStore> kv = cluster.initMetaKV(rootPath->path());
+  ASSERT_TRUE(TestUtils::createSomeHosts(kv.get()));
+  TestUtils::assembleSpace(kv.get(), 1, 1);
+  GraphSpaceID space = 1;
+  {
+    std::vector<std::string> paras{"file://relative/test_space"};
+    JobDescription job(space, 12, cpp2::JobType::DOWNLOAD, paras);
+    auto executor = std::make_unique<DownloadJobExecutor>(
+        space, job.getJobId(), kv.get(), adminClient_.get(), job.getParas());
+    ASSERT_EQ(executor->check(), nebula::cpp2::ErrorCode::E_INVALID_JOB);
+  }
+  {
+    std::vector<std::string> paras{"file:///data/test_space"};
+    JobDescription job(space, 13, cpp2::JobType::DOWNLOAD, paras);
+    std::vector<std::string> taskParas{"", "0", "/data/test_space"};
+    EXPECT_CALL(*adminClient_, addTask(_, _, _, _, _, taskParas, _))
+        .WillOnce(Return(ByMove(folly::makeFuture<StatusOr<bool>>(true))));
+
+    auto executor = std::make_unique<DownloadJobExecutor>(
+        space, job.getJobId(), kv.get(), adminClient_.get(), job.getParas());
+    // Nothing is listed on hdfs for a local path
+    executor->helper_ = std::make_unique<meta::MockHdfsNotExistHelper>();
+    ASSERT_EQ(executor->check(), nebula::cpp2::ErrorCode::SUCCEEDED);
+    ASSERT_EQ(executor->prepare(), nebula::cpp2::ErrorCode::SUCCEEDED);
+    ASSERT_EQ(executor->execute().get(), nebula::cpp2::ErrorCode::SUCCEEDED);
+  }
+}
+
 TEST_F(JobManagerTest, IngestJob) {
   auto rootPath = std::make_unique<fs::TempDir>("/tmp/DownloadAndIngestTest.XXXXXX");
   mock::MockCluster cluster;
@@ -308,5 +308,31 @@ void AdHocSchemaManager::addServiceClient(const nebula::meta::cpp2::ServiceClien
   serviceClients_.emplace_back(client);
 }
 
+StatusOr<std::unordered_map<std::string, nebula::meta::cpp2::FTIndex>>
+AdHocSchemaManager::getFTIndex(GraphSpaceID space, int32_t schemaId) {
+  folly::RWSpinLock::ReadHolder rh(ftIndexLock_);
+  std::unordered_map<std::string, nebula::meta::cpp2::FTIndex> indexes;
+  for (const auto& [name, index] : ftIndexes_) {
+    const auto& schema = index.get_depend_schema();
+    auto id = schema.getType() == nebula::cpp2::SchemaID::Type::edge_type ? schema.get_edge_type()
+                                                                          : schema.get_tag_id();
+    if (index.get_space_id() == space && id == schemaId) {
+      indexes.emplace(name, index);
+    }
+  }
+  return indexes;
+}
+
+void AdHocSchemaManager::addFTIndex(const std::string& name,
+                                    const nebula::meta::cpp2::FTIndex& index) {
+  folly::RWSpinLock::WriteHolder wh(ftIndexLock_);
+  ftIndexes_[name] = index;
+}
+
+void AdHocSchemaManager::removeFTIndex(const std::string& name) {
+  folly::RWSpinLock::WriteHolder wh(ftIndexLock_);
+  ftIndexes_.erase(name);
+}
+
 }  // namespace mock
 }  // namespace nebula
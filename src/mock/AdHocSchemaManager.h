@@ -103,10 +103,11 @@ class AdHocSchemaManager final : public nebula::meta::SchemaManager {
   void addServiceClient(const nebula::meta::cpp2::ServiceClient& client);
 
   StatusOr<std::unordered_map<std::string, nebula::meta::cpp2::FTIndex>> getFTIndex(
-      GraphSpaceID, int32_t) override {
-    LOG(FATAL) << "Unimplemented";
-    return Status::Error("Unimplemented");
-  }
+      GraphSpaceID space, int32_t schemaId) override;
+
+  void addFTIndex(const std::string& name, const nebula::meta::cpp2::FTIndex& index);
+
+  void removeFTIndex(const std::string& name);
 
   StatusOr<int32_t> getPartsNum(GraphSpaceID) override {
     return partNum_;
@@ -144,6 +145,8 @@ class AdHocSchemaManager final : public nebula::meta::SchemaManager {
       edgeSchemasInMap_;
 
   std::vector<nebula::meta::cpp2::ServiceClient> serviceClients_;
+  folly::RWSpinLock ftIndexLock_;
+  std::unordered_map<std::string, nebula::meta::cpp2::FTIndex> ftIndexes_;
   int32_t partNum_;
 };
 
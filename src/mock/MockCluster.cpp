@@ -200,6 +200,9 @@ void MockCluster::initStorageKV(const char* dataPath,
         new storage::StorageCompactionFilterFactoryBuilder(schemaMan_.get(), indexMan_.get()));
     options.cffBuilder_ = std::move(cffBuilder);
   }
+  if (commitHookFactory_) {
+    options.commitHook_ = commitHookFactory_(schemaMan_.get());
+  }
   storageKV_ = initKV(std::move(options), addr);
   waitUntilAllElected(storageKV_.get(), 1, parts);
 
@@ -138,6 +138,8 @@ class MockCluster {
   std::unique_ptr<meta::SchemaManager> lSchemaMan_;
   std::unique_ptr<meta::MetaClient> lMetaClient_{nullptr};
   std::unique_ptr<storage::TransactionManager> txnMan_{nullptr};
+  // Create the commit hook of storage kvstore if set before initStorageKV
+  std::function<std::shared_ptr<kvstore::CommitHook>(meta::SchemaManager*)> commitHookFactory_;
 
   ObjectPool pool_;
 };
@@ -24,6 +24,12 @@ std::string SchemaPropItem::toString() const {
       return folly::stringPrintf("ttl_col = \"%s\"", std::get<std::string>(propValue_).c_str());
     case COMMENT:
       return folly::stringPrintf("comment = \"%s\"", std::get<std::string>(propValue_).c_str());
+    case ADJACENCY_ORDER:
+      return folly::stringPrintf("adjacency_order = \"%s\"",
+                                 std::get<std::string>(propValue_).c_str());
+    case ADJACENCY_ORDER_DESC:
+      return folly::stringPrintf("adjacency_order = \"%s\" DESC",
+                                 std::get<std::string>(propValue_).c_str());
   }
   DLOG(FATAL) << "Schema property type illegal";
   return "";
@@ -190,7 +190,8 @@ class SchemaPropItem final {
  public:
   using Value = std::variant<int64_t, bool, std::string>;
 
-  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT };
+  // ADJACENCY_ORDER and ADJACENCY_ORDER_DESC are only for edges, which differ in the direction
+  enum PropType : uint8_t { TTL_DURATION, TTL_COL, COMMENT, ADJACENCY_ORDER, ADJACENCY_ORDER_DESC };
 
   SchemaPropItem(PropType op, int64_t val) {
     propType_ = op;
@@ -227,6 +228,14 @@ class SchemaPropItem final {
     }
   }
 
+  StatusOr<std::string> getAdjacencyOrderCol() {
+    if (propType_ == ADJACENCY_ORDER || propType_ == ADJACENCY_ORDER_DESC) {
+      return asString();
+    } else {
+      return Status::Error("Adjacency_order value illegal");
+    }
+  }
+
   StatusOr<std::string> getComment() {
     if (propType_ == COMMENT) {
       return asString();
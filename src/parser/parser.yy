@@ -181,7 +181,7 @@ using namespace nebula;
 %token KW_IF KW_NOT KW_EXISTS KW_WITH
 %token KW_BY KW_DOWNLOAD KW_HDFS KW_UUID KW_CONFIGS KW_FORCE
 %token KW_GET KW_DECLARE KW_GRAPH KW_META KW_STORAGE KW_AGENT
-%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_DATA KW_STOP
+%token KW_TTL KW_TTL_DURATION KW_TTL_COL KW_ADJACENCY_ORDER KW_DATA KW_STOP
 %token KW_FETCH KW_PROP KW_UPDATE KW_UPSERT KW_WHEN
 %token KW_ORDER KW_ASC KW_LIMIT KW_SAMPLE KW_OFFSET KW_ASCENDING KW_DESCENDING
 %token KW_DISTINCT KW_ALL KW_OF
@@ -501,6 +501,7 @@ unreserved_keyword
     | KW_ATOMIC_EDGE        { $$ = new std::string("atomic_edge"); }
     | KW_TTL_DURATION       { $$ = new std::string("ttl_duration"); }
     | KW_TTL_COL            { $$ = new std::string("ttl_col"); }
+    | KW_ADJACENCY_ORDER    { $$ = new std::string("adjacency_order"); }
     | KW_SNAPSHOT           { $$ = new std::string("snapshot"); }
     | KW_SNAPSHOTS          { $$ = new std::string("snapshots"); }
     | KW_GRAPH              { $$ = new std::string("graph"); }
@@ -2354,6 +2355,18 @@ create_schema_prop_item
         $$ = new SchemaPropItem(SchemaPropItem::TTL_COL, *$3);
         delete $3;
     }
+    | KW_ADJACENCY_ORDER ASSIGN STRING {
+        $$ = new SchemaPropItem(SchemaPropItem::ADJACENCY_ORDER, *$3);
+        delete $3;
+    }
+    | KW_ADJACENCY_ORDER ASSIGN STRING KW_ASC {
+        $$ = new SchemaPropItem(SchemaPropItem::ADJACENCY_ORDER, *$3);
+        delete $3;
+    }
+    | KW_ADJACENCY_ORDER ASSIGN STRING KW_DESC {
+        $$ = new SchemaPropItem(SchemaPropItem::ADJACENCY_ORDER_DESC, *$3);
+        delete $3;
+    }
     | comment_prop_assignment {
         $$ = new SchemaPropItem(SchemaPropItem::COMMENT, *$1);
         delete $1;
@@ -450,6 +450,29 @@ TEST_F(ParserTest, EdgeOperation) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    std::string query = "CREATE EDGE follow(ts timestamp) adjacency_order = \"ts\"";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query =
+        "CREATE EDGE follow(ts timestamp, degree int) "
+        "ttl_duration = 100, ttl_col = \"ts\", adjacency_order = \"ts\" DESC";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "CREATE EDGE follow(ts timestamp) adjacency_order = \"ts\" ASC";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    // The adjacency order could not be altered
+    std::string query = "ALTER EDGE follow adjacency_order = \"ts\"";
+    auto result = parse(query);
+    ASSERT_FALSE(result.ok());
+  }
   {
     std::string query =
         "ALTER EDGE e1 ADD (col1 int, col2 string), "
@@ -341,6 +341,9 @@ TEST(Scanner, Basic) {
       CHECK_SEMANTIC_TYPE("TTL_COL", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("ttl_col", TokenType::KW_TTL_COL),
       CHECK_SEMANTIC_TYPE("Ttl_col", TokenType::KW_TTL_COL),
+      CHECK_SEMANTIC_TYPE("ADJACENCY_ORDER", TokenType::KW_ADJACENCY_ORDER),
+      CHECK_SEMANTIC_TYPE("adjacency_order", TokenType::KW_ADJACENCY_ORDER),
+      CHECK_SEMANTIC_TYPE("Adjacency_order", TokenType::KW_ADJACENCY_ORDER),
       CHECK_SEMANTIC_TYPE("DOWNLOAD", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("download", TokenType::KW_DOWNLOAD),
       CHECK_SEMANTIC_TYPE("Download", TokenType::KW_DOWNLOAD),
@@ -46,6 +46,12 @@ void BaseProcessor<RESP>::handleAsync(GraphSpaceID spaceId,
   {
     std::lock_guard<std::mutex> lg(this->lock_);
     handleErrorCode(code, spaceId, partId);
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED && this->env_->spaceStats_ != nullptr) {
+      auto iter = statsDeltas_.find(partId);
+      if (iter != statsDeltas_.end()) {
+        this->env_->spaceStats_->add(spaceId, partId, iter->second.first, iter->second.second);
+      }
+    }
     this->callingNum_--;
     if (this->callingNum_ == 0) {
       finished = true;
@@ -138,6 +144,67 @@ void BaseProcessor<RESP>::doRemoveRange(GraphSpaceID spaceId,
       });
 }
 
+template <typename RESP>
+ErrorOr<nebula::cpp2::ErrorCode, bool> BaseProcessor<RESP>::keyExists(GraphSpaceID spaceId,
+                                                                      PartitionID partId,
+                                                                      const std::string& key) {
+  std::string val;
+  auto ret = this->env_->kvstore_->get(spaceId, partId, key, &val);
+  if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return true;
+  } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return false;
+  }
+  return ret;
+}
+
+template <typename RESP>
+ErrorOr<nebula::cpp2::ErrorCode, std::vector<bool>> BaseProcessor<RESP>::keysExist(
+    GraphSpaceID spaceId, PartitionID partId, const std::vector<std::string>& keys) {
+  std::vector<bool> exists(keys.size(), false);
+  if (keys.empty()) {
+    return exists;
+  }
+  std::vector<std::string> values;
+  auto ret = this->env_->kvstore_->multiGet(spaceId, partId, keys, &values);
+  if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+      ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+    return ret.first;
+  }
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (ret.second[i].ok()) {
+      exists[i] = true;
+    } else if (ret.second[i].code() != Status::Code::kKeyNotFound) {
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+  }
+  return exists;
+}
+
+template <typename RESP>
+ErrorOr<nebula::cpp2::ErrorCode, bool> BaseProcessor<RESP>::vertexExists(GraphSpaceID spaceId,
+                                                                         PartitionID partId,
+                                                                         const std::string& vId) {
+  if (FLAGS_use_vertex_key) {
+    return keyExists(spaceId, partId, NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vId));
+  }
+  auto prefix = NebulaKeyUtils::tagPrefix(spaceVidLen_, partId, vId);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto ret = this->env_->kvstore_->prefix(spaceId, partId, prefix, &iter);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  return iter->valid();
+}
+
+template <typename RESP>
+void BaseProcessor<RESP>::setStatsDelta(PartitionID partId,
+                                        const SpaceStatsManager::Fence& fence,
+                                        cpp2::PartStats delta) {
+  std::lock_guard<std::mutex> lg(this->lock_);
+  statsDeltas_[partId] = std::make_pair(fence, std::move(delta));
+}
+
 template <typename RESP>
 StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(const meta::NebulaSchemaProvider* schema,
                                                         const std::vector<std::string>& propNames,
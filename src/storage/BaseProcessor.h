@@ -17,7 +17,10 @@
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
 #include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
 #include "storage/CommonUtils.h"
+#include "storage/SpaceStatsManager.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -138,6 +141,36 @@ class BaseProcessor {
                                      const std::vector<Value>& props,
                                      WriteResult& wRet);
 
+  // Whether the writes count the changes of the space stats
+  bool countStats() const {
+    return env_->spaceStats_ != nullptr;
+  }
+
+  ErrorOr<nebula::cpp2::ErrorCode, bool> keyExists(GraphSpaceID spaceId,
+                                                   PartitionID partId,
+                                                   const std::string& key);
+
+  // Whether each of the keys exists, read by one multiGet
+  ErrorOr<nebula::cpp2::ErrorCode, std::vector<bool>> keysExist(
+      GraphSpaceID spaceId, PartitionID partId, const std::vector<std::string>& keys);
+
+  // Whether the vertex is counted in the space stats, by its vertex key if use_vertex_key is on,
+  // otherwise by any of its tags
+  ErrorOr<nebula::cpp2::ErrorCode, bool> vertexExists(GraphSpaceID spaceId,
+                                                      PartitionID partId,
+                                                      const std::string& vId);
+
+  // Taken before reading the existence of the keys written to the part
+  SpaceStatsManager::Fence statsFence(GraphSpaceID spaceId, PartitionID partId) {
+    return countStats() ? env_->spaceStats_->fence(spaceId, partId) : SpaceStatsManager::Fence();
+  }
+
+  // The changes of the space stats made in the part, they are added to the space stats once the
+  // part is written successfully. Set again if the writes of part are retried.
+  void setStatsDelta(PartitionID partId,
+                     const SpaceStatsManager::Fence& fence,
+                     cpp2::PartStats delta);
+
   virtual void profileDetail(const std::string& name, int32_t latency) {
     if (!profileDetail_.count(name)) {
       profileDetail_[name] = latency;
@@ -164,6 +197,9 @@ class BaseProcessor {
   std::mutex profileMut_;
   bool profileDetailFlag_{false};
   bool memoryExceeded_{false};
+  // Protected by lock_
+  std::unordered_map<PartitionID, std::pair<SpaceStatsManager::Fence, cpp2::PartStats>>
+      statsDeltas_;
 };
 
 /// Helper class wrap the passed in Func in a MemoryTracker turned on scope.
@@ -5,6 +5,7 @@
 
 #include "storage/CommonUtils.h"
 
+#include "common/utils/NebulaKeyUtils.h"
 #include "storage/exec/QueryUtils.h"
 
 DEFINE_bool(ttl_use_ms,
@@ -81,5 +82,26 @@ StatusOr<Value> CommonUtils::ttlValue(const meta::NebulaSchemaProvider* schema,
   return reader->getValueByName(std::move(ttlProp).second.second);
 }
 
+std::string CommonUtils::adjacencyValue(const meta::NebulaSchemaProvider* schema,
+                                        RowReaderWrapper* reader) {
+  const auto* col = schema->getAdjacencyOrderCol();
+  DCHECK(col != nullptr);
+  return NebulaKeyUtils::encodeAdjacencyValue(reader->getValueByName(*col),
+                                              schema->isAdjacencyOrderDesc());
+}
+
+std::string CommonUtils::adjacencyKey(size_t vIdLen,
+                                      const folly::StringPiece& edgeKey,
+                                      const meta::NebulaSchemaProvider* schema,
+                                      RowReaderWrapper* reader) {
+  return NebulaKeyUtils::adjacencyKey(vIdLen,
+                                      NebulaKeyUtils::getPart(edgeKey),
+                                      NebulaKeyUtils::getSrcId(vIdLen, edgeKey).str(),
+                                      NebulaKeyUtils::getEdgeType(vIdLen, edgeKey),
+                                      adjacencyValue(schema, reader),
+                                      NebulaKeyUtils::getRank(vIdLen, edgeKey),
+                                      NebulaKeyUtils::getDstId(vIdLen, edgeKey).str());
+}
+
 }  // namespace storage
 }  // namespace nebula
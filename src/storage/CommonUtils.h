@@ -62,6 +62,7 @@ using EdgesMemLock = MemoryLockCore<EMLI>;
 
 class TransactionManager;
 class InternalStorageClient;
+class SpaceStatsManager;
 
 // unify TagID, EdgeType
 using SchemaID = TagID;
@@ -81,6 +82,8 @@ class StorageEnv {
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
   int32_t adminSeqId_{0};
+  // Only set when enable_incremental_stats is on
+  SpaceStatsManager* spaceStats_{nullptr};
 
   IndexState getIndexState(GraphSpaceID space, PartitionID part) {
     auto key = std::make_tuple(space, part);
@@ -164,6 +167,7 @@ class PlanContext {
       auto& common = commonRef.value();
       sessionId_ = common.session_id_ref().value_or(0);
       planId_ = common.plan_id_ref().value_or(0);
+      canReadFromFollower_ = common.read_from_follower_ref().value_or(false);
     }
   }
 
@@ -183,6 +187,9 @@ class PlanContext {
   // will be true if query is killed during execution
   bool isKilled_ = false;
 
+  // whether the request could be served by a follower
+  bool canReadFromFollower_ = false;
+
   // Manage expressions
   ObjectPool objPool_;
 };
@@ -214,6 +221,10 @@ struct RuntimeContext {
     return planContext_->isEdge_;
   }
 
+  bool canReadFromFollower() const {
+    return planContext_->canReadFromFollower_;
+  }
+
   ObjectPool* objPool() {
     return &planContext_->objPool_;
   }
@@ -275,6 +286,29 @@ class CommonUtils final {
 
   static StatusOr<Value> ttlValue(const meta::NebulaSchemaProvider* schema,
                                   RowReaderWrapper* reader);
+
+  /**
+   * @brief Encode the value of adjacency order column of an edge, see
+   * NebulaKeyUtils::encodeAdjacencyValue
+   *
+   * @param schema **Latest** schema, which must have an adjacency order
+   * @param reader RowReader of the edge
+   */
+  static std::string adjacencyValue(const meta::NebulaSchemaProvider* schema,
+                                    RowReaderWrapper* reader);
+
+  /**
+   * @brief Generate the adjacency index key of an edge
+   *
+   * @param vIdLen
+   * @param edgeKey Key of the edge
+   * @param schema **Latest** schema, which must have an adjacency order
+   * @param reader RowReader of the edge
+   */
+  static std::string adjacencyKey(size_t vIdLen,
+                                  const folly::StringPiece& edgeKey,
+                                  const meta::NebulaSchemaProvider* schema,
+                                  RowReaderWrapper* reader);
 };
 
 }  // namespace storage
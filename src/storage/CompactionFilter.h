@@ -14,6 +14,7 @@
 #include "common/utils/OperationKeyUtils.h"
 #include "kvstore/CompactionFilter.h"
 #include "storage/CommonUtils.h"
+#include "storage/SpaceStatsManager.h"
 #include "storage/StorageFlags.h"
 
 DEFINE_int32(min_level_for_custom_filter,
@@ -27,8 +28,9 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
  public:
   StorageCompactionFilter(meta::SchemaManager* schemaMan,
                           meta::IndexManager* indexMan,
-                          size_t vIdLen)
-      : schemaMan_(schemaMan), indexMan_(indexMan), vIdLen_(vIdLen) {
+                          size_t vIdLen,
+                          SpaceStatsManager* spaceStats = nullptr)
+      : schemaMan_(schemaMan), indexMan_(indexMan), vIdLen_(vIdLen), spaceStats_(spaceStats) {
     CHECK_NOTNULL(schemaMan_);
   }
 
@@ -51,8 +53,11 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
       return true;
     } else if (NebulaKeyUtils::isLock(vIdLen_, key)) {
       return !lockValid(spaceId, key);
+    } else if (NebulaKeyUtils::isAdjacency(key)) {
+      return !adjacencyValid(spaceId, key);
     } else {
-      // skip uuid/system/operation
+      // skip uuid/system/operation, the builtin fulltext keys of dropped indexes are removed by
+      // the rebuild job through raft, so they are the same on all peers
       VLOG(3) << "Skip the system key inside, key " << key;
     }
     return false;
@@ -75,6 +80,12 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     }
     if (ttlExpired(schema.get(), reader.get())) {
       VLOG(3) << "Ttl expired";
+      if (spaceStats_ != nullptr) {
+        cpp2::PartStats delta;
+        (*delta.tag_vertices_ref())[tagId] = -1;
+        auto part = NebulaKeyUtils::getPart(key);
+        spaceStats_->add(spaceId, part, spaceStats_->fence(spaceId, part), delta);
+      }
       return false;
     }
     return true;
@@ -100,6 +111,13 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     }
     if (ttlExpired(schema.get(), reader.get())) {
       VLOG(3) << "Ttl expired";
+      if (spaceStats_ != nullptr && edgeType > 0) {
+        cpp2::PartStats delta;
+        delta.space_edges_ref() = -1;
+        (*delta.edges_ref())[edgeType] = -1;
+        auto part = NebulaKeyUtils::getPart(key);
+        spaceStats_->add(spaceId, part, spaceStats_->fence(spaceId, part), delta);
+      }
       return false;
     }
     return true;
@@ -115,6 +133,19 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     return true;
   }
 
+  // The adjacency index keys are removed once the edge type is dropped. The keys of the edges
+  // which are expired or removed without updating the index are skipped when read, and left here
+  bool adjacencyValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
+    // The srcId and edgeType are at the same offset as edge key
+    auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen_, key);
+    auto schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
+    if (!schema) {
+      VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
+      return false;
+    }
+    return schema->getAdjacencyOrderCol() != nullptr;
+  }
+
   // TODO(panda) Optimize the method in the future
   bool ttlExpired(const meta::NebulaSchemaProvider* schema,
                   nebula::RowReaderWrapper* reader) const {
@@ -183,6 +214,10 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
   meta::SchemaManager* schemaMan_ = nullptr;
   meta::IndexManager* indexMan_ = nullptr;
   size_t vIdLen_;
+  // The rows expired are counted in the space stats only by the full compactions on the leader,
+  // so each row is counted once and only the latest version of it is seen. The vertices are left
+  // to be reconciled since whether the vertex has other tags is unknown here
+  SpaceStatsManager* spaceStats_ = nullptr;
 };
 
 class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterFactory {
@@ -190,14 +225,22 @@ class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterF
   StorageCompactionFilterFactory(meta::SchemaManager* schemaMan,
                                  meta::IndexManager* indexMan,
                                  GraphSpaceID spaceId,
-                                 size_t vIdLen)
+                                 size_t vIdLen,
+                                 SpaceStatsManager* spaceStats = nullptr)
       : KVCompactionFilterFactory(spaceId),
         schemaMan_(schemaMan),
         indexMan_(indexMan),
-        vIdLen_(vIdLen) {}
+        vIdLen_(vIdLen),
+        spaceStats_(spaceStats) {}
 
   std::unique_ptr<kvstore::KVFilter> createKVFilter() override {
-    return std::make_unique<StorageCompactionFilter>(schemaMan_, indexMan_, vIdLen_);
+    return std::make_unique<StorageCompactionFilter>(schemaMan_, indexMan_, vIdLen_, nullptr);
+  }
+
+  std::unique_ptr<kvstore::KVFilter> createKVFilter(
+      const rocksdb::CompactionFilter::Context& context) override {
+    return std::make_unique<StorageCompactionFilter>(
+        schemaMan_, indexMan_, vIdLen_, context.is_full_compaction ? spaceStats_ : nullptr);
   }
 
   const char* Name() const override {
@@ -208,13 +251,15 @@ class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterF
   meta::SchemaManager* schemaMan_ = nullptr;
   meta::IndexManager* indexMan_ = nullptr;
   size_t vIdLen_;
+  SpaceStatsManager* spaceStats_ = nullptr;
 };
 
 class StorageCompactionFilterFactoryBuilder : public kvstore::CompactionFilterFactoryBuilder {
  public:
   StorageCompactionFilterFactoryBuilder(meta::SchemaManager* schemaMan,
-                                        meta::IndexManager* indexMan)
-      : schemaMan_(schemaMan), indexMan_(indexMan) {}
+                                        meta::IndexManager* indexMan,
+                                        SpaceStatsManager* spaceStats = nullptr)
+      : schemaMan_(schemaMan), indexMan_(indexMan), spaceStats_(spaceStats) {}
 
   virtual ~StorageCompactionFilterFactoryBuilder() = default;
 
@@ -225,12 +270,13 @@ class StorageCompactionFilterFactoryBuilder : public kvstore::CompactionFilterFa
       return nullptr;
     }
     return std::make_shared<StorageCompactionFilterFactory>(
-        schemaMan_, indexMan_, spaceId, vIdLen.value());
+        schemaMan_, indexMan_, spaceId, vIdLen.value(), spaceStats_);
   }
 
  private:
   meta::SchemaManager* schemaMan_ = nullptr;
   meta::IndexManager* indexMan_ = nullptr;
+  SpaceStatsManager* spaceStats_ = nullptr;
 };
 
 }  // namespace storage
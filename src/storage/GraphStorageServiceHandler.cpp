@@ -7,6 +7,7 @@
 
 #include "common/memory/MemoryTracker.h"
 #include "storage/index/LookupProcessor.h"
+#include "storage/index/TextSearchProcessor.h"
 #include "storage/kv/GetProcessor.h"
 #include "storage/kv/PutProcessor.h"
 #include "storage/kv/RemoveProcessor.h"
@@ -78,6 +79,7 @@ GraphStorageServiceHandler::GraphStorageServiceHandler(StorageEnv* env) : env_(e
   kGetDstBySrcCounters.init("get_dst_by_src");
   kGetPropCounters.init("get_prop");
   kLookupCounters.init("lookup");
+  kTextSearchCounters.init("text_search");
   kScanVertexCounters.init("scan_vertex");
   kScanEdgeCounters.init("scan_edge");
   kPutCounters.init("kv_put");
@@ -161,6 +163,12 @@ folly::Future<cpp2::LookupIndexResp> GraphStorageServiceHandler::future_lookupIn
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::TextSearchResponse> GraphStorageServiceHandler::future_textSearch(
+    const cpp2::TextSearchRequest& req) {
+  auto* processor = TextSearchProcessor::instance(env_);
+  RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::ScanResponse> GraphStorageServiceHandler::future_scanVertex(
     const cpp2::ScanVertexRequest& req) {
   auto* processor = ScanVertexProcessor::instance(env_, &kScanVertexCounters, readerPool_.get());
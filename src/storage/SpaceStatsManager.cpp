@@ -0,0 +1,247 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/SpaceStatsManager.h"
+
+#include <folly/synchronization/Baton.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/time/WallClock.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/Part.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+SpaceStatsManager::~SpaceStatsManager() {
+  stop();
+}
+
+// static
+bool SpaceStatsManager::enabled() {
+  return FLAGS_enable_incremental_stats;
+}
+
+bool SpaceStatsManager::init(kvstore::KVStore* kvstore, Reconciler reconciler) {
+  CHECK_NOTNULL(kvstore);
+  kvstore_ = kvstore;
+  reconciler_ = std::move(reconciler);
+  bgWorker_ = std::make_unique<thread::GenericWorker>();
+  if (!bgWorker_->start("space-stats")) {
+    LOG(ERROR) << "Start the flush thread of space stats failed";
+    return false;
+  }
+  bgWorker_->addRepeatTask(FLAGS_incremental_stats_flush_interval_secs * 1000,
+                           &SpaceStatsManager::flush,
+                           this);
+  if (reconciler_ != nullptr) {
+    bgWorker_->addRepeatTask(FLAGS_incremental_stats_flush_interval_secs * 1000,
+                             &SpaceStatsManager::reconcile,
+                             this);
+  }
+  return true;
+}
+
+void SpaceStatsManager::stop() {
+  if (bgWorker_ != nullptr) {
+    bgWorker_->stop();
+    bgWorker_->wait();
+    bgWorker_.reset();
+    flush();
+  }
+}
+
+TermID SpaceStatsManager::leaderTerm(GraphSpaceID space, PartitionID part) {
+  if (kvstore_ == nullptr) {
+    return -1;
+  }
+  auto ret = kvstore_->part(space, part);
+  if (!nebula::ok(ret) || !nebula::value(ret)->isLeader()) {
+    return -1;
+  }
+  return nebula::value(ret)->termId();
+}
+
+SpaceStatsManager::Fence SpaceStatsManager::fence(GraphSpaceID space, PartitionID part) {
+  Fence fence;
+  fence.term = leaderTerm(space, part);
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = generations_.find(std::make_pair(space, part));
+  if (iter != generations_.end()) {
+    fence.generation = iter->second;
+  }
+  return fence;
+}
+
+void SpaceStatsManager::add(GraphSpaceID space,
+                            PartitionID part,
+                            const Fence& fence,
+                            const cpp2::PartStats& delta) {
+  if (fence.term < 0) {
+    return;
+  }
+  auto key = std::make_pair(space, part);
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = generations_.find(key);
+  if (fence.generation != (iter == generations_.end() ? 0 : iter->second)) {
+    // The part is reconciled after the changes are computed, they may be counted by the scan
+    return;
+  }
+  auto& partDelta = deltas_[key];
+  if (partDelta.term != fence.term) {
+    if (partDelta.term > fence.term) {
+      return;
+    }
+    partDelta.term = fence.term;
+    partDelta.stats = cpp2::PartStats();
+  }
+  merge(partDelta.stats, delta);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, cpp2::PartStats> SpaceStatsManager::get(GraphSpaceID space,
+                                                                         PartitionID part) {
+  std::lock_guard<std::mutex> flushGuard(flushLock_);
+  auto ret = load(space, part);
+  if (!nebula::ok(ret)) {
+    return ret;
+  }
+  auto stats = std::move(nebula::value(ret));
+  std::lock_guard<std::mutex> guard(lock_);
+  auto iter = deltas_.find(std::make_pair(space, part));
+  if (iter != deltas_.end()) {
+    merge(stats, iter->second.stats);
+  }
+  return stats;
+}
+
+bool SpaceStatsManager::isReconciled(GraphSpaceID space,
+                                     PartitionID part,
+                                     const cpp2::PartStats& stats) {
+  auto reconciledAt = *stats.reconciled_at_ref();
+  return reconciledAt != 0 &&
+         time::WallClock::fastNowInSec() - reconciledAt < FLAGS_stats_reconcile_interval_secs &&
+         *stats.reconciled_term_ref() == leaderTerm(space, part);
+}
+
+nebula::cpp2::ErrorCode SpaceStatsManager::reset(GraphSpaceID space,
+                                                 PartitionID part,
+                                                 cpp2::PartStats stats) {
+  std::lock_guard<std::mutex> flushGuard(flushLock_);
+  stats.reconciled_term_ref() = leaderTerm(space, part);
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto key = std::make_pair(space, part);
+    deltas_.erase(key);
+    generations_[key]++;
+  }
+  return save(space, part, stats);
+}
+
+void SpaceStatsManager::flush() {
+  if (kvstore_ == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> flushGuard(flushLock_);
+  decltype(deltas_) deltas;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    deltas.swap(deltas_);
+  }
+  for (const auto& [key, delta] : deltas) {
+    auto [space, part] = key;
+    if (leaderTerm(space, part) != delta.term) {
+      VLOG(2) << folly::sformat(
+          "Drop the stats changes of space {}, part {} in term {}", space, part, delta.term);
+      continue;
+    }
+    auto ret = load(space, part);
+    if (!nebula::ok(ret)) {
+      VLOG(2) << folly::sformat("Drop the stats changes of space {}, part {}: {}",
+                                space,
+                                part,
+                                apache::thrift::util::enumNameSafe(nebula::error(ret)));
+      continue;
+    }
+    auto stats = std::move(nebula::value(ret));
+    merge(stats, delta.stats);
+    auto code = save(space, part, stats);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(2) << folly::sformat("Drop the stats changes of space {}, part {}: {}",
+                                space,
+                                part,
+                                apache::thrift::util::enumNameSafe(code));
+    }
+  }
+}
+
+void SpaceStatsManager::reconcile() {
+  if (kvstore_ == nullptr || reconciler_ == nullptr || FLAGS_stats_reconcile_interval_secs <= 0) {
+    return;
+  }
+  std::unordered_map<GraphSpaceID, std::vector<meta::cpp2::LeaderInfo>> leaders;
+  kvstore_->allLeader(leaders);
+  for (const auto& [space, infos] : leaders) {
+    for (const auto& info : infos) {
+      auto part = info.get_part_id();
+      auto ret = get(space, part);
+      if (!nebula::ok(ret) || isReconciled(space, part, nebula::value(ret))) {
+        continue;
+      }
+      // Only one part each time, since it scans the whole part
+      auto code = reconciler_(space, part);
+      LOG(INFO) << folly::sformat("Reconcile the stats counters of space {}, part {}: {}",
+                                  space,
+                                  part,
+                                  apache::thrift::util::enumNameSafe(code));
+      return;
+    }
+  }
+}
+
+// static
+void SpaceStatsManager::merge(cpp2::PartStats& stats, const cpp2::PartStats& delta) {
+  *stats.space_vertices_ref() += *delta.space_vertices_ref();
+  *stats.space_edges_ref() += *delta.space_edges_ref();
+  for (const auto& [tagId, count] : *delta.tag_vertices_ref()) {
+    (*stats.tag_vertices_ref())[tagId] += count;
+  }
+  for (const auto& [edgeType, count] : *delta.edges_ref()) {
+    (*stats.edges_ref())[edgeType] += count;
+  }
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, cpp2::PartStats> SpaceStatsManager::load(GraphSpaceID space,
+                                                                          PartitionID part) {
+  std::string val;
+  auto code = kvstore_->get(space, part, NebulaKeyUtils::systemStatsKey(part), &val);
+  cpp2::PartStats stats;
+  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    apache::thrift::CompactSerializer::deserialize(val, stats);
+  } else if (code != nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return code;
+  }
+  return stats;
+}
+
+nebula::cpp2::ErrorCode SpaceStatsManager::save(GraphSpaceID space,
+                                                PartitionID part,
+                                                const cpp2::PartStats& stats) {
+  std::string val;
+  apache::thrift::CompactSerializer::serialize(stats, &val);
+  std::vector<kvstore::KV> data;
+  data.emplace_back(NebulaKeyUtils::systemStatsKey(part), std::move(val));
+  folly::Baton<true, std::atomic> baton;
+  auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
+  kvstore_->asyncMultiPut(space, part, std::move(data), [&](nebula::cpp2::ErrorCode code) {
+    ret = code;
+    baton.post();
+  });
+  baton.wait();
+  return ret;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,123 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_SPACESTATSMANAGER_H_
+#define STORAGE_SPACESTATSMANAGER_H_
+
+#include "common/base/Base.h"
+#include "common/base/ErrorOr.h"
+#include "common/thread/GenericWorker.h"
+#include "interface/gen-cpp2/storage_types.h"
+#include "kvstore/KVStore.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Maintain the vertex and edge counters of each part incrementally.
+ *
+ * The mutate processors add the changes of the counters once their writes succeed, the changes
+ * are kept in memory and merged into the counters persisted in the system key of part by the
+ * leader periodically. So the stats job could read the counters instead of scanning the parts.
+ *
+ * The changes are fenced by the term of leader and the times the part is reconciled, so the
+ * ones computed by a former leader or before a reconciliation are dropped instead of counted
+ * twice. The counters could still drift, e.g. the changes not flushed are lost when the leader
+ * changes, so the background thread recalculates the counters of a part by scanning it if they
+ * are not recalculated in stats_reconcile_interval_secs, see StatsTask::reconcile.
+ */
+class SpaceStatsManager final {
+ public:
+  // Taken before the changes are computed, they are dropped if the fence is stale when added
+  struct Fence {
+    TermID term{-1};
+    int64_t generation{0};
+  };
+
+  // Recalculate the counters of part by scanning it
+  using Reconciler = std::function<nebula::cpp2::ErrorCode(GraphSpaceID, PartitionID)>;
+
+  SpaceStatsManager() = default;
+
+  ~SpaceStatsManager();
+
+  static bool enabled();
+
+  /**
+   * @brief Start the background thread which flushes the changes and reconciles the counters.
+   */
+  bool init(kvstore::KVStore* kvstore, Reconciler reconciler = nullptr);
+
+  void stop();
+
+  /**
+   * @brief Get the fence of part, the term is -1 if it is not the leader.
+   */
+  Fence fence(GraphSpaceID space, PartitionID part);
+
+  /**
+   * @brief Add the changes of the counters of part, dropped if the fence is stale.
+   */
+  void add(GraphSpaceID space, PartitionID part, const Fence& fence, const cpp2::PartStats& delta);
+
+  /**
+   * @brief Get the counters of part, including the changes not flushed yet.
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, cpp2::PartStats> get(GraphSpaceID space, PartitionID part);
+
+  /**
+   * @brief Whether the counters are recalculated in stats_reconcile_interval_secs, by the current
+   * leader of part.
+   */
+  bool isReconciled(GraphSpaceID space, PartitionID part, const cpp2::PartStats& stats);
+
+  /**
+   * @brief Replace the counters of part by the ones recalculated, the changes added before are
+   * dropped.
+   */
+  nebula::cpp2::ErrorCode reset(GraphSpaceID space, PartitionID part, cpp2::PartStats stats);
+
+  /**
+   * @brief Merge the changes into the persisted counters of the parts, the changes of the parts
+   * which are not leader or have changed the term are dropped.
+   */
+  void flush();
+
+  /**
+   * @brief Reconcile the counters of one leader part which are not reconciled, see isReconciled.
+   */
+  void reconcile();
+
+  static void merge(cpp2::PartStats& stats, const cpp2::PartStats& delta);
+
+ private:
+  ErrorOr<nebula::cpp2::ErrorCode, cpp2::PartStats> load(GraphSpaceID space, PartitionID part);
+
+  nebula::cpp2::ErrorCode save(GraphSpaceID space, PartitionID part, const cpp2::PartStats& stats);
+
+  // The term of part if it is the leader, otherwise -1
+  TermID leaderTerm(GraphSpaceID space, PartitionID part);
+
+  struct PartDelta {
+    TermID term{-1};
+    cpp2::PartStats stats;
+  };
+
+  kvstore::KVStore* kvstore_{nullptr};
+  Reconciler reconciler_;
+  std::unique_ptr<thread::GenericWorker> bgWorker_;
+
+  std::mutex lock_;
+  std::unordered_map<std::pair<GraphSpaceID, PartitionID>, PartDelta> deltas_;
+  // The times each part is reconciled
+  std::unordered_map<std::pair<GraphSpaceID, PartitionID>, int64_t> generations_;
+  // Serialize the read-modify-write of the persisted counters
+  std::mutex flushLock_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_SPACESTATSMANAGER_H_
@@ -28,6 +28,11 @@ DEFINE_uint32(rebuild_index_part_rate_limit,
 
 DEFINE_uint32(rebuild_index_batch_size, 1024 * 128, "batch size for rebuild index, in bytes");
 
+DEFINE_uint32(ingest_sort_buffer_mb,
+              256,
+              "memory to sort the adjacency keys of the edges in the ingested files of a part, the "
+              "sorted keys are spilled to disk once it is full");
+
 DEFINE_int32(reader_handlers, 32, "Total reader handlers");
 
 DEFINE_uint64(default_mvcc_ver,
@@ -47,4 +52,33 @@ DEFINE_bool(query_concurrently,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
 
+DEFINE_bool(query_adaptive_concurrency,
+            true,
+            "whether to split the input of a read request into morsels which run on the idle "
+            "threads of the reader pool, get neighbors, get props and lookup are supported");
+
+DEFINE_int32(query_morsel_size,
+             256,
+             "min number of vertices or edges in a morsel when splitting a read request");
+
 DEFINE_bool(use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_bool(follower_read_index,
+            true,
+            "whether the reads served by follower wait for the read index of leader, which makes "
+            "them linearizable");
+
+DEFINE_bool(enable_incremental_stats,
+            false,
+            "whether the writes maintain the counters of parts, which are read by the stats job "
+            "instead of scanning the parts");
+
+DEFINE_int32(incremental_stats_flush_interval_secs,
+             10,
+             "interval to persist the changes of the counters of parts");
+
+DEFINE_int32(stats_reconcile_interval_secs,
+             86400,
+             "the counters of a part are recalculated by scanning it in background if they are "
+             "not recalculated in this interval or by the current leader, the stats job does so "
+             "as well, 0 to disable the background one");
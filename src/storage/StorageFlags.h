@@ -22,6 +22,8 @@ DECLARE_uint32(rebuild_index_part_rate_limit);
 
 DECLARE_uint32(rebuild_index_batch_size);
 
+DECLARE_uint32(ingest_sort_buffer_mb);
+
 DECLARE_int32(reader_handlers);
 
 DECLARE_uint64(default_mvcc_ver);
@@ -34,6 +36,18 @@ DECLARE_int32(max_edge_returned_per_vertex);
 
 DECLARE_bool(query_concurrently);
 
+DECLARE_bool(query_adaptive_concurrency);
+
+DECLARE_int32(query_morsel_size);
+
 DECLARE_bool(use_vertex_key);
 
+DECLARE_bool(follower_read_index);
+
+DECLARE_bool(enable_incremental_stats);
+
+DECLARE_int32(incremental_stats_flush_interval_secs);
+
+DECLARE_int32(stats_reconcile_interval_secs);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
@@ -16,6 +16,7 @@
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
 #include "common/thread/GenericThreadPool.h"
+#include "common/thrift/RpcCompression.h"
 #include "common/time/TimezoneInfo.h"
 #include "common/utils/Utils.h"
 #include "kvstore/PartManager.h"
@@ -26,9 +27,11 @@
 #include "storage/GraphStorageServiceHandler.h"
 #include "storage/StorageAdminServiceHandler.h"
 #include "storage/StorageFlags.h"
+#include "storage/admin/StatsTask.h"
 #include "storage/http/StorageHttpAdminHandler.h"
 #include "storage/http/StorageHttpPropertyHandler.h"
 #include "storage/http/StorageHttpStatsHandler.h"
+#include "storage/index/TextIndexCommitHook.h"
 #include "storage/transaction/TransactionManager.h"
 #include "version/Version.h"
 #include "webservice/Router.h"
@@ -100,8 +103,9 @@ std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   options.partMan_ =
       std::make_unique<kvstore::MetaServerBasedPartManager>(localHost_, metaClient_.get());
   if (!FLAGS_storage_kv_mode) {
-    options.cffBuilder_ =
-        std::make_unique<StorageCompactionFilterFactoryBuilder>(schemaMan_.get(), indexMan_.get());
+    options.cffBuilder_ = std::make_unique<StorageCompactionFilterFactoryBuilder>(
+        schemaMan_.get(), indexMan_.get(), spaceStats_.get());
+    options.commitHook_ = std::make_shared<TextIndexCommitHook>(schemaMan_.get());
   }
   options.schemaMan_ = schemaMan_.get();
   if (FLAGS_store_type == "nebula") {
@@ -253,6 +257,10 @@ bool StorageServer::start() {
   LOG(INFO) << "Init index manager";
   indexMan_ = meta::ServerBasedIndexManager::create(metaClient_.get());
 
+  if (SpaceStatsManager::enabled()) {
+    spaceStats_ = std::make_unique<SpaceStatsManager>();
+  }
+
   LOG(INFO) << "Init kvstore";
   kvstore_ = getStoreInstance();
 
@@ -284,6 +292,16 @@ bool StorageServer::start() {
     LOG(ERROR) << "Get admin store seq id failed!";
     return false;
   }
+  if (spaceStats_ != nullptr) {
+    env_->spaceStats_ = spaceStats_.get();
+    auto reconciler = [env = env_.get()](GraphSpaceID space, PartitionID part) {
+      return StatsTask::reconcile(env, space, part);
+    };
+    if (!spaceStats_->init(kvstore_.get(), std::move(reconciler))) {
+      LOG(ERROR) << "Init space stats failed!";
+      return false;
+    }
+  }
 
   taskMgr_ = AdminTaskManager::instance(env_.get());
   if (!taskMgr_->init()) {
@@ -335,6 +353,11 @@ void StorageServer::stop() {
   // Stop http service
   webSvc_.reset();
 
+  // Flush the changes of space stats before raft is stopped
+  if (spaceStats_) {
+    spaceStats_->stop();
+  }
+
   // Stop all thrift server: raft/storage/admin
   if (kvstore_) {
     // stop kvstore background job and raft services
@@ -373,6 +396,7 @@ std::unique_ptr<apache::thrift::ThriftServer> StorageServer::getStorageServer()
     server->setIOThreadPool(ioThreadPool_);
     server->setThreadManager(workers_);
     server->setMaxConnections(FLAGS_num_max_connections);
+    thrift::setupServerCompression(server.get());
     if (FLAGS_enable_ssl) {
       server->setSSLConfig(nebula::sslContextConfig());
     }
@@ -17,6 +17,7 @@
 #include "kvstore/NebulaStore.h"
 #include "storage/CommonUtils.h"
 #include "storage/GraphStorageLocalServer.h"
+#include "storage/SpaceStatsManager.h"
 #include "storage/admin/AdminTaskManager.h"
 #include "storage/transaction/TransactionManager.h"
 #include "webservice/WebService.h"
@@ -103,6 +104,8 @@ class StorageServer final {
 
   std::unique_ptr<nebula::WebService> webSvc_;
   std::unique_ptr<meta::MetaClient> metaClient_;
+  // Must outlive kvstore_, which counts the rows expired by compaction in it
+  std::unique_ptr<SpaceStatsManager> spaceStats_;
   std::unique_ptr<kvstore::KVStore> kvstore_;
 
   std::unique_ptr<nebula::hdfs::HdfsHelper> hdfsHelper_;
@@ -5,6 +5,8 @@
 
 #include "storage/admin/DownloadTask.h"
 
+#include <boost/filesystem.hpp>
+
 #include "common/fs/FileUtils.h"
 
 namespace nebula {
@@ -50,6 +52,10 @@ nebula::cpp2::ErrorCode DownloadTask::subTask(GraphSpaceID space, PartitionID pa
     }
   }
 
+  if (hdfsHost_.empty()) {
+    return copyFromLocal(hdfsPartPath, folly::stringPrintf("%s%d", localPath.c_str(), part));
+  }
+
   auto listResult = helper_->ls(hdfsHost_, hdfsPort_, hdfsPartPath);
   if (!listResult.ok()) {
     LOG(INFO) << "Can't found data of space: " << space << ", part: " << part
@@ -62,5 +68,29 @@ nebula::cpp2::ErrorCode DownloadTask::subTask(GraphSpaceID space, PartitionID pa
                      : nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
 }
 
+nebula::cpp2::ErrorCode DownloadTask::copyFromLocal(const std::string& srcPath,
+                                                   const std::string& dstPath) {
+  if (!fs::FileUtils::exist(srcPath)) {
+    LOG(INFO) << "Can't found " << srcPath << ", just skip the part";
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (!fs::FileUtils::exist(dstPath) && !fs::FileUtils::makeDir(dstPath)) {
+    return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+  }
+  auto files = fs::FileUtils::listAllFilesInDir(srcPath.c_str(), false, "*.sst");
+  for (const auto& file : files) {
+    auto dstFile = fs::FileUtils::joinPath(dstPath, file);
+    try {
+      boost::filesystem::remove(dstFile);
+      boost::filesystem::copy_file(fs::FileUtils::joinPath(srcPath, file), dstFile);
+    } catch (const boost::filesystem::filesystem_error& e) {
+      LOG(ERROR) << "Failed to copy " << file << " from " << srcPath << ": " << e.what();
+      return nebula::cpp2::ErrorCode::E_TASK_EXECUTION_FAILED;
+    }
+  }
+  LOG(INFO) << "Copied " << files.size() << " files from " << srcPath;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -29,8 +29,12 @@ class DownloadTask : public AdminTask {
  private:
   nebula::cpp2::ErrorCode subTask(GraphSpaceID space, PartitionID part);
 
+  // Copy the sst files of a part from a local path
+  nebula::cpp2::ErrorCode copyFromLocal(const std::string& srcPath, const std::string& dstPath);
+
  private:
   std::string hdfsPath_;
+  // Empty if the files are copied from a local path
   std::string hdfsHost_;
   int32_t hdfsPort_;
   std::unique_ptr<nebula::hdfs::HdfsHelper> helper_;
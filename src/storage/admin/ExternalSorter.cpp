@@ -0,0 +1,156 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/admin/ExternalSorter.h"
+
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "common/fs/FileUtils.h"
+
+namespace nebula {
+namespace storage {
+
+ExternalSorter::ExternalSorter(std::string dir, size_t bufferLimit)
+    : dir_(std::move(dir)), bufferLimit_(bufferLimit) {}
+
+ExternalSorter::~ExternalSorter() {
+  if (fs::FileUtils::exist(dir_)) {
+    fs::FileUtils::remove(dir_.c_str(), true);
+  }
+}
+
+nebula::cpp2::ErrorCode ExternalSorter::add(std::string key, std::string val) {
+  bufferSize_ += key.size() + val.size();
+  buffer_.emplace_back(std::move(key), std::move(val));
+  if (bufferSize_ >= bufferLimit_) {
+    return spill();
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode ExternalSorter::spill() {
+  if (buffer_.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (runs_.empty() && !fs::FileUtils::exist(dir_) && !fs::FileUtils::makeDir(dir_)) {
+    LOG(ERROR) << "Make dir " << dir_ << " failed";
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  std::sort(buffer_.begin(), buffer_.end(), [](const auto& a, const auto& b) {
+    return a.first < b.first;
+  });
+
+  auto path = folly::stringPrintf("%s/run-%lu.sst", dir_.c_str(), runs_.size());
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options());
+  auto s = writer.Open(path);
+  for (size_t i = 0; s.ok() && i < buffer_.size(); i++) {
+    // The same row could derive the same key more than once
+    if (i > 0 && buffer_[i].first == buffer_[i - 1].first) {
+      continue;
+    }
+    s = writer.Put(buffer_[i].first, buffer_[i].second);
+  }
+  if (s.ok()) {
+    s = writer.Finish();
+  }
+  if (!s.ok()) {
+    LOG(ERROR) << "Write sst " << path << " failed: " << s.ToString();
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  VLOG(1) << "Spill " << buffer_.size() << " entries to " << path;
+  runs_.emplace_back(std::move(path));
+  buffer_.clear();
+  bufferSize_ = 0;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode ExternalSorter::finish(size_t batchSize, const Writer& write) {
+  auto code = spill();
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  if (runs_.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  return merge(batchSize, write);
+}
+
+nebula::cpp2::ErrorCode ExternalSorter::merge(size_t batchSize, const Writer& write) {
+  std::vector<std::unique_ptr<rocksdb::SstFileReader>> readers;
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+  rocksdb::Options options;
+  for (const auto& run : runs_) {
+    auto reader = std::make_unique<rocksdb::SstFileReader>(options);
+    auto s = reader->Open(run);
+    if (!s.ok()) {
+      LOG(ERROR) << "Open sst " << run << " failed: " << s.ToString();
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+    rocksdb::ReadOptions readOptions;
+    readOptions.fill_cache = false;
+    std::unique_ptr<rocksdb::Iterator> iter(reader->NewIterator(readOptions));
+    iter->SeekToFirst();
+    iters.emplace_back(std::move(iter));
+    readers.emplace_back(std::move(reader));
+  }
+
+  // The min heap of the runs by their current key
+  auto greater = [&iters](size_t a, size_t b) {
+    return iters[a]->key().compare(iters[b]->key()) > 0;
+  };
+  std::priority_queue<size_t, std::vector<size_t>, decltype(greater)> heap(greater);
+  for (size_t i = 0; i < iters.size(); i++) {
+    if (iters[i]->Valid()) {
+      heap.push(i);
+    }
+  }
+
+  std::vector<kvstore::KV> batch;
+  size_t size = 0;
+  size_t total = 0;
+  while (!heap.empty()) {
+    auto i = heap.top();
+    heap.pop();
+    auto* iter = iters[i].get();
+    // The same key could be in more than one run
+    if (batch.empty() || iter->key() != batch.back().first) {
+      batch.emplace_back(iter->key().ToString(), iter->value().ToString());
+      size += batch.back().first.size() + batch.back().second.size();
+    }
+    iter->Next();
+    if (iter->Valid()) {
+      heap.push(i);
+    }
+    // Keep the last key of the batch to dedup against the next entry
+    if (size >= batchSize && (heap.empty() || iters[heap.top()]->key() != batch.back().first)) {
+      total += batch.size();
+      auto code = write(std::move(batch));
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      batch.clear();
+      size = 0;
+    }
+  }
+  for (const auto& iter : iters) {
+    if (!iter->status().ok()) {
+      LOG(ERROR) << "Read sst failed: " << iter->status().ToString();
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+  }
+  if (!batch.empty()) {
+    total += batch.size();
+    auto code = write(std::move(batch));
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+  }
+  VLOG(1) << "Merge " << runs_.size() << " runs to " << total << " entries";
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+}  // namespace storage
+}  // namespace nebula
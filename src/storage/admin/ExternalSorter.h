@@ -0,0 +1,59 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADMIN_EXTERNALSORTER_H_
+#define STORAGE_ADMIN_EXTERNALSORTER_H_
+
+#include "common/base/Base.h"
+#include "common/base/ErrorOr.h"
+#include "interface/gen-cpp2/common_types.h"
+#include "kvstore/Common.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Sort the key values derived from a part externally, e.g. the adjacency keys of the edges
+ * in an ingested file.
+ *
+ * The entries are buffered in memory and spilled to a sorted run of sst when the buffer is
+ * full, the runs are merged in key order at last. All files are written under the given
+ * directory, which is removed when the sorter is destroyed.
+ */
+class ExternalSorter final {
+ public:
+  ExternalSorter(std::string dir, size_t bufferLimit);
+
+  ~ExternalSorter();
+
+  nebula::cpp2::ErrorCode add(std::string key, std::string val);
+
+  using Writer = std::function<nebula::cpp2::ErrorCode(std::vector<kvstore::KV>)>;
+
+  /**
+   * @brief Pass all entries added to write in key order without duplicates.
+   *
+   * @param batchSize The bytes of entries passed to each call of write
+   * @param write Stop and return its error code once it fails
+   */
+  nebula::cpp2::ErrorCode finish(size_t batchSize, const Writer& write);
+
+ private:
+  // Sort the entries in buffer and write them to a new run
+  nebula::cpp2::ErrorCode spill();
+
+  nebula::cpp2::ErrorCode merge(size_t batchSize, const Writer& write);
+
+  std::string dir_;
+  size_t bufferLimit_;
+  size_t bufferSize_{0};
+  std::vector<kvstore::KV> buffer_;
+  std::vector<std::string> runs_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_ADMIN_EXTERNALSORTER_H_
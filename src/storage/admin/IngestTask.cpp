@@ -5,7 +5,15 @@
 
 #include "storage/admin/IngestTask.h"
 
+#include <rocksdb/sst_file_reader.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "codec/RowReaderWrapper.h"
 #include "common/fs/FileUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "storage/CommonUtils.h"
+#include "storage/StorageFlags.h"
+#include "storage/admin/ExternalSorter.h"
 
 namespace nebula {
 namespace storage {
@@ -17,14 +25,15 @@ bool IngestTask::check() {
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTasks() {
   std::vector<AdminSubTask> results;
   auto* store = dynamic_cast<kvstore::NebulaStore*>(env_->kvstore_);
-  auto errOrSpace = store->space(*ctx_.parameters_.space_id_ref());
+  auto spaceId = *ctx_.parameters_.space_id_ref();
+  auto errOrSpace = store->space(spaceId);
   if (!ok(errOrSpace)) {
     LOG(ERROR) << "Space not found";
     return error(errOrSpace);
   }
 
   auto space = nebula::value(errOrSpace);
-  results.emplace_back([space = space]() {
+  results.emplace_back([this, spaceId, space = space]() {
     for (auto& engine : space->engines_) {
       auto parts = engine->allParts();
       for (auto part : parts) {
@@ -35,8 +44,18 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
         }
 
         auto files = nebula::fs::FileUtils::listAllFilesInDir(path.c_str(), true, "*.sst");
+        auto dir = folly::stringPrintf("%s/ingest_adjacency/%d", engine->getDataRoot(), part);
+        SCOPE_EXIT {
+          if (fs::FileUtils::exist(dir)) {
+            fs::FileUtils::remove(dir.c_str(), true);
+          }
+        };
+        auto code = buildAdjacencySst(spaceId, dir, files);
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return code;
+        }
         LOG(INFO) << "Ingest files: " << files.size();
-        auto code = engine->ingest(std::vector<std::string>(files));
+        code = engine->ingest(std::vector<std::string>(files));
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return code;
         }
@@ -47,5 +66,102 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> IngestTask::genSubTa
   return results;
 }
 
+nebula::cpp2::ErrorCode IngestTask::buildAdjacencySst(GraphSpaceID space,
+                                                      const std::string& dir,
+                                                      std::vector<std::string>& files) {
+  auto schemasRet = env_->schemaMan_->getAllLatestVerEdgeSchema(space);
+  if (!schemasRet.ok()) {
+    LOG(ERROR) << "Get edge schemas of space " << space << " failed";
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  auto schemas = std::move(schemasRet).value();
+  for (auto iter = schemas.begin(); iter != schemas.end();) {
+    if (iter->second->getAdjacencyOrderCol() == nullptr) {
+      iter = schemas.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+  if (schemas.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  auto vIdLenRet = env_->schemaMan_->getSpaceVidLen(space);
+  if (!vIdLenRet.ok()) {
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  auto vIdLen = vIdLenRet.value();
+
+  ExternalSorter sorter(dir + "/runs",
+                        static_cast<size_t>(FLAGS_ingest_sort_buffer_mb) * 1024 * 1024);
+  rocksdb::Options options;
+  rocksdb::ReadOptions readOptions;
+  readOptions.fill_cache = false;
+  for (const auto& file : files) {
+    rocksdb::SstFileReader reader(options);
+    auto s = reader.Open(file);
+    if (!s.ok()) {
+      LOG(ERROR) << "Open sst " << file << " failed: " << s.ToString();
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+    std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(readOptions));
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      folly::StringPiece key(iter->key().data(), iter->key().size());
+      if (!NebulaKeyUtils::isEdge(vIdLen, key)) {
+        continue;
+      }
+      auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, key);
+      auto schemaIter = schemas.find(std::abs(edgeType));
+      if (schemaIter == schemas.end()) {
+        continue;
+      }
+      folly::StringPiece val(iter->value().data(), iter->value().size());
+      auto edgeReader =
+          RowReaderWrapper::getEdgePropReader(env_->schemaMan_, space, std::abs(edgeType), val);
+      if (edgeReader == nullptr) {
+        LOG(WARNING) << "Bad format row of edge in " << file;
+        continue;
+      }
+      auto code = sorter.add(
+          CommonUtils::adjacencyKey(vIdLen, key, schemaIter->second.get(), edgeReader.get()), "");
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+    }
+    if (!iter->status().ok()) {
+      LOG(ERROR) << "Read sst " << file << " failed: " << iter->status().ToString();
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+  }
+
+  auto path = dir + "/adjacency.sst";
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+  bool opened = false;
+  auto code = sorter.finish(
+      static_cast<size_t>(FLAGS_ingest_sort_buffer_mb) * 1024 * 1024,
+      [&](std::vector<kvstore::KV> batch) {
+        auto s = opened ? rocksdb::Status::OK() : writer.Open(path);
+        opened = true;
+        for (size_t i = 0; s.ok() && i < batch.size(); i++) {
+          s = writer.Put(batch[i].first, batch[i].second);
+        }
+        if (!s.ok()) {
+          LOG(ERROR) << "Write sst " << path << " failed: " << s.ToString();
+          return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+        }
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      });
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED || !opened) {
+    return code;
+  }
+  auto s = writer.Finish();
+  if (!s.ok()) {
+    LOG(ERROR) << "Finish sst " << path << " failed: " << s.ToString();
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  LOG(INFO) << "Generate adjacency index of ingested edges to " << path;
+  files.emplace_back(std::move(path));
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace storage
 }  // namespace nebula
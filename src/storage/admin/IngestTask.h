@@ -22,6 +22,19 @@ class IngestTask : public AdminTask {
   bool check() override;
 
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> genSubTasks() override;
+
+ private:
+  /**
+   * @brief The downloaded sst files only contain edges, generate the adjacency index keys of the
+   * edges whose type has an adjacency order into a new sst, which is ingested together with them.
+   *
+   * @param space
+   * @param dir Directory to write the sst, it is removed by caller after ingested
+   * @param files Sst files to ingest, path of the new sst is appended if any key is generated
+   */
+  nebula::cpp2::ErrorCode buildAdjacencySst(GraphSpaceID space,
+                                            const std::string& dir,
+                                            std::vector<std::string>& files);
 };
 
 }  // namespace storage
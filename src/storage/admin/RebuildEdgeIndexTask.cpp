@@ -53,7 +53,8 @@ nebula::cpp2::ErrorCode RebuildEdgeIndexTask::buildIndexGlobal(GraphSpaceID spac
   auto vidSize = vidSizeRet.value();
   std::unique_ptr<kvstore::KVIterator> iter;
   const auto& prefix = NebulaKeyUtils::edgePrefix(part);
-  auto ret = env_->kvstore_->prefix(space, part, prefix, &iter);
+  auto ret = env_->kvstore_->prefix(
+      space, part, prefix, &iter, false, nullptr, kvstore::ScanMode::kBulk);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Processing Part " << part << " Failed";
     return ret;
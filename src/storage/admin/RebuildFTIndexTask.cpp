@@ -6,6 +6,9 @@
 #include "storage/admin/RebuildFTIndexTask.h"
 
 #include "common/base/Logging.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "storage/StorageFlags.h"
 
 DECLARE_uint32(raft_heartbeat_interval_secs);
 
@@ -21,6 +24,19 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> RebuildFTIndexTask::
   VLOG(1) << "Begin rebuild fulltext indexes, space : " << *ctx_.parameters_.space_id_ref();
   auto parts = *ctx_.parameters_.parts_ref();
   auto* store = dynamic_cast<kvstore::NebulaStore*>(env_->kvstore_);
+  if (store == nullptr || !store->isListener()) {
+    // The builtin indexes are rebuilt by the leaders of data parts
+    auto code = getBuiltinIndexes(*ctx_.parameters_.space_id_ref());
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+    for (const auto& part : parts) {
+      TaskFunction task = std::bind(
+          &RebuildFTIndexTask::builtinTaskByPart, this, *ctx_.parameters_.space_id_ref(), part);
+      tasks.emplace_back(std::move(task));
+    }
+    return tasks;
+  }
   auto listenerRet = store->spaceListener(*ctx_.parameters_.space_id_ref());
   if (!ok(listenerRet)) {
     return error(listenerRet);
@@ -72,5 +88,150 @@ nebula::cpp2::ErrorCode RebuildFTIndexTask::taskByPart(nebula::kvstore::Listener
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+nebula::cpp2::ErrorCode RebuildFTIndexTask::getBuiltinIndexes(GraphSpaceID space) {
+  auto tags = env_->schemaMan_->getAllLatestVerTagSchema(space);
+  auto edges = env_->schemaMan_->getAllLatestVerEdgeSchema(space);
+  if (!tags.ok() || !edges.ok()) {
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  auto addIndexes = [this, space](int32_t schemaId) {
+    auto ret = env_->schemaMan_->getFTIndex(space, schemaId);
+    if (!ret.ok()) {
+      return;
+    }
+    for (auto& [name, index] : ret.value()) {
+      if (index.get_analyzer() == plugin::kBuiltinAnalyzer) {
+        builtinIndexes_[schemaId][name] = index.get_fields();
+      }
+    }
+  };
+  for (const auto& tag : tags.value()) {
+    addIndexes(tag.first);
+  }
+  for (const auto& edge : edges.value()) {
+    addIndexes(edge.first);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode RebuildFTIndexTask::builtinTaskByPart(GraphSpaceID space,
+                                                              PartitionID part) {
+  using plugin::TextIndexKeyUtils;
+  auto vIdLenRet = env_->schemaMan_->getSpaceVidLen(space);
+  if (!vIdLenRet.ok()) {
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  auto vIdLen = vIdLenRet.value();
+  auto rateLimiter = std::make_unique<kvstore::RateLimiter>();
+
+  // Define the indexes in the part as the ones in meta, the keys of the dropped ones are removed
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code = env_->kvstore_->prefix(
+      space, part, TextIndexKeyUtils::kindPrefix(part, TextIndexKeyUtils::kDefine), &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto batchHolder = std::make_unique<kvstore::BatchHolder>();
+  for (; iter->valid(); iter->next()) {
+    auto schemaId = TextIndexKeyUtils::getSchemaId(iter->key());
+    auto name = TextIndexKeyUtils::getIndexName(iter->key());
+    auto found = builtinIndexes_.find(schemaId);
+    if (found != builtinIndexes_.end() && found->second.count(name.str()) != 0) {
+      continue;
+    }
+    batchHolder->remove(iter->key().str());
+    for (auto kind : {TextIndexKeyUtils::kPosting, TextIndexKeyUtils::kForward}) {
+      auto start = TextIndexKeyUtils::indexPrefix(part, kind, schemaId, name);
+      // The prefix ends with '\0', so all keys of index are before the end
+      auto end = start;
+      end.back() = '\1';
+      batchHolder->rangeRemove(std::move(start), std::move(end));
+    }
+  }
+  for (const auto& [schemaId, indexes] : builtinIndexes_) {
+    for (const auto& [name, fields] : indexes) {
+      batchHolder->put(TextIndexKeyUtils::defineKey(part, schemaId, name),
+                       TextIndexKeyUtils::encodeTerms(fields));
+    }
+  }
+  code = writeBatch(space, part, batchHolder.get(), rateLimiter.get());
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED || builtinIndexes_.empty()) {
+    return code;
+  }
+
+  // Backfill the tags and edges written before the indexes are defined. They are indexed by their
+  // values when the reindex keys are committed, so the ones changed during the scan are right.
+  for (const auto& prefix : {NebulaKeyUtils::tagPrefix(part), NebulaKeyUtils::edgePrefix(part)}) {
+    code = env_->kvstore_->prefix(
+        space, part, prefix, &iter, false, nullptr, kvstore::ScanMode::kBulk);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+    batchHolder = std::make_unique<kvstore::BatchHolder>();
+    for (; iter->valid(); iter->next()) {
+      if (UNLIKELY(canceled_)) {
+        return nebula::cpp2::ErrorCode::E_USER_CANCEL;
+      }
+      auto key = iter->key();
+      int32_t schemaId = 0;
+      if (NebulaKeyUtils::isTag(vIdLen, key)) {
+        schemaId = NebulaKeyUtils::getTagId(vIdLen, key);
+      } else if (NebulaKeyUtils::isEdge(vIdLen, key)) {
+        schemaId = NebulaKeyUtils::getEdgeType(vIdLen, key);
+      } else {
+        continue;
+      }
+      if (builtinIndexes_.count(schemaId) == 0) {
+        continue;
+      }
+      batchHolder->put(TextIndexKeyUtils::reindexKey(part, key), "");
+      if (batchHolder->size() > FLAGS_rebuild_index_batch_size) {
+        code = writeBatch(space, part, batchHolder.get(), rateLimiter.get());
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return code;
+        }
+        batchHolder = std::make_unique<kvstore::BatchHolder>();
+      }
+    }
+    code = writeBatch(space, part, batchHolder.get(), rateLimiter.get());
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+  }
+
+  // The indexes are searched in the part only after they are backfilled
+  batchHolder = std::make_unique<kvstore::BatchHolder>();
+  for (const auto& [schemaId, indexes] : builtinIndexes_) {
+    for (const auto& index : indexes) {
+      batchHolder->put(TextIndexKeyUtils::builtKey(part, schemaId, index.first), "");
+    }
+  }
+  return writeBatch(space, part, batchHolder.get(), rateLimiter.get());
+}
+
+nebula::cpp2::ErrorCode RebuildFTIndexTask::writeBatch(GraphSpaceID space,
+                                                       PartitionID part,
+                                                       kvstore::BatchHolder* batchHolder,
+                                                       kvstore::RateLimiter* rateLimiter) {
+  if (batchHolder->size() == 0) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  folly::Baton<true, std::atomic> baton;
+  auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
+  auto encoded = kvstore::encodeBatchValue(batchHolder->getBatch());
+  rateLimiter->consume(static_cast<double>(batchHolder->size()),                   // toConsume
+                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit),   // rate
+                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit));  // burstSize
+  env_->kvstore_->asyncAppendBatch(
+      space, part, std::move(encoded), [&result, &baton](nebula::cpp2::ErrorCode code) {
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          result = code;
+        }
+        baton.post();
+      });
+  baton.wait();
+  return result;
+}
+
 }  // namespace storage
 }  // namespace nebula
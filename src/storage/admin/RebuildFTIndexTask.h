@@ -7,7 +7,9 @@
 #define STORAGE_ADMIN_REBUILDFTINDEXTASK_H_
 
 #include "kvstore/KVEngine.h"
+#include "kvstore/LogEncoder.h"
 #include "kvstore/NebulaStore.h"
+#include "kvstore/RateLimiter.h"
 #include "storage/admin/AdminTask.h"
 
 namespace nebula {
@@ -32,6 +34,24 @@ class RebuildFTIndexTask : public AdminTask {
 
  protected:
   nebula::cpp2::ErrorCode taskByPart(nebula::kvstore::Listener* listener);
+
+  /**
+   * @brief Rebuild the builtin indexes of part on its leader. The indexes in meta are defined in
+   * the part through raft, then the existing tags and edges are indexed by the reindex keys. At
+   * last the built keys make the indexes searchable in the part.
+   */
+  nebula::cpp2::ErrorCode builtinTaskByPart(GraphSpaceID space, PartitionID part);
+
+ private:
+  nebula::cpp2::ErrorCode getBuiltinIndexes(GraphSpaceID space);
+
+  nebula::cpp2::ErrorCode writeBatch(GraphSpaceID space,
+                                     PartitionID part,
+                                     kvstore::BatchHolder* batchHolder,
+                                     kvstore::RateLimiter* rateLimiter);
+
+  // The fields of builtin fulltext indexes in meta, by schema and index name
+  std::unordered_map<int32_t, std::map<std::string, std::vector<std::string>>> builtinIndexes_;
 };
 
 }  // namespace storage
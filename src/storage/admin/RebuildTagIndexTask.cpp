@@ -53,7 +53,8 @@ nebula::cpp2::ErrorCode RebuildTagIndexTask::buildIndexGlobal(GraphSpaceID space
   auto vidSize = vidSizeRet.value();
   std::unique_ptr<kvstore::KVIterator> iter;
   auto prefix = NebulaKeyUtils::tagPrefix(part);
-  auto ret = env_->kvstore_->prefix(space, part, prefix, &iter);
+  auto ret = env_->kvstore_->prefix(
+      space, part, prefix, &iter, false, nullptr, kvstore::ScanMode::kBulk);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Processing Part " << part << " Failed";
     return ret;
@@ -8,8 +8,10 @@
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include "common/base/MurmurHash2.h"
+#include "common/time/WallClock.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/Common.h"
+#include "storage/SpaceStatsManager.h"
 #include "storage/StorageFlags.h"
 
 DEFINE_int32(stats_sleep_interval_ms,
@@ -86,6 +88,10 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     return nebula::cpp2::ErrorCode::E_USER_CANCEL;
   }
 
+  if (env_->spaceStats_ != nullptr && !scanOnly_ && statsByCounters(spaceId, part, tags, edges)) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   auto vIdLenRet = env_->schemaMan_->getSpaceVidLen(spaceId);
   if (!vIdLenRet.ok()) {
     LOG(INFO) << "Get space vid length failed";
@@ -116,19 +122,23 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   std::unique_ptr<kvstore::KVIterator> vertexIter;
 
   // When the storage occurs leader change, continue to read data from the
-  // follower instead of reporting an error.
-  auto ret = env_->kvstore_->prefix(spaceId, part, tagPrefix, &tagIter, true);
+  // follower instead of reporting an error. All data of the part are scanned, so use bulk scan to
+  // keep the block cache for online queries.
+  auto ret = env_->kvstore_->prefix(
+      spaceId, part, tagPrefix, &tagIter, true, nullptr, kvstore::ScanMode::kBulk);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Stats task failed";
     return ret;
   }
-  ret = env_->kvstore_->prefix(spaceId, part, edgePrefix, &edgeIter, true);
+  ret = env_->kvstore_->prefix(
+      spaceId, part, edgePrefix, &edgeIter, true, nullptr, kvstore::ScanMode::kBulk);
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Stats task failed";
     return ret;
   }
   if (FLAGS_use_vertex_key) {
-    ret = env_->kvstore_->prefix(spaceId, part, vertexPrefix, &vertexIter, true);
+    ret = env_->kvstore_->prefix(
+        spaceId, part, vertexPrefix, &vertexIter, true, nullptr, kvstore::ScanMode::kBulk);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       LOG(INFO) << "Stats task failed";
       return ret;
@@ -304,10 +314,78 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   statsItem.negative_part_correlativity_ref() = std::move(negativePartCorrelativities);
 
   statistics_.emplace(part, std::move(statsItem));
+
+  if (env_->spaceStats_ != nullptr) {
+    // Reconcile the counters maintained by the writes
+    cpp2::PartStats counters;
+    counters.space_vertices_ref() = FLAGS_use_vertex_key ? verticesCountByVertexKey : spaceVertices;
+    counters.space_edges_ref() = spaceEdges;
+    counters.tag_vertices_ref()->insert(tagsVertices.begin(), tagsVertices.end());
+    counters.edges_ref()->insert(edgetypeEdges.begin(), edgetypeEdges.end());
+    counters.reconciled_at_ref() = time::WallClock::fastNowInSec();
+    auto code = env_->spaceStats_->reset(spaceId, part, std::move(counters));
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << folly::sformat("Reconcile the stats counters of space {}, part {} failed: {}",
+                                  spaceId,
+                                  part,
+                                  apache::thrift::util::enumNameSafe(code));
+    }
+  }
   LOG(INFO) << "Stats task finished";
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+// static
+nebula::cpp2::ErrorCode StatsTask::reconcile(StorageEnv* env,
+                                             GraphSpaceID space,
+                                             PartitionID part) {
+  cpp2::TaskPara para;
+  para.space_id_ref() = space;
+  para.parts_ref() = {part};
+  cpp2::AddTaskRequest req;
+  req.job_type_ref() = nebula::meta::cpp2::JobType::STATS;
+  req.para_ref() = std::move(para);
+  StatsTask task(env, TaskContext(req, [](nebula::cpp2::ErrorCode, auto&) {}));
+  task.scanOnly_ = true;
+  auto code = task.getSchemas(space);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  return task.genSubTask(space, part, task.tags_, task.edges_);
+}
+
+bool StatsTask::statsByCounters(GraphSpaceID spaceId,
+                                PartitionID part,
+                                const std::unordered_map<TagID, std::string>& tags,
+                                const std::unordered_map<EdgeType, std::string>& edges) {
+  auto ret = env_->spaceStats_->get(spaceId, part);
+  if (!nebula::ok(ret)) {
+    return false;
+  }
+  const auto& counters = nebula::value(ret);
+  if (!env_->spaceStats_->isReconciled(spaceId, part, counters)) {
+    // Not recently reconciled or reconciled by another leader, scan the part instead
+    return false;
+  }
+
+  nebula::meta::cpp2::StatsItem statsItem;
+  for (const auto& [tagId, tagName] : tags) {
+    auto iter = counters.tag_vertices_ref()->find(tagId);
+    auto count = iter == counters.tag_vertices_ref()->end() ? 0 : iter->second;
+    statsItem.tag_vertices_ref()->emplace(tagName, count);
+  }
+  for (const auto& [edgeType, edgeName] : edges) {
+    auto iter = counters.edges_ref()->find(edgeType);
+    auto count = iter == counters.edges_ref()->end() ? 0 : iter->second;
+    statsItem.edges_ref()->emplace(edgeName, count);
+  }
+  statsItem.space_vertices_ref() = *counters.space_vertices_ref();
+  statsItem.space_edges_ref() = *counters.space_edges_ref();
+  statistics_.emplace(part, std::move(statsItem));
+  LOG(INFO) << folly::sformat("Stats of space {}, part {} read from counters", spaceId, part);
+  return true;
+}
+
 void StatsTask::finish(nebula::cpp2::ErrorCode rc) {
   FLOG_INFO("task(%d, %d) finished, rc=[%s]",
             ctx_.jobId_,
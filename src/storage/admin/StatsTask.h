@@ -43,6 +43,12 @@ class StatsTask : public AdminTask {
    */
   void finish(nebula::cpp2::ErrorCode rc) override;
 
+  /**
+   * @brief Recalculate the counters of part maintained by the writes by scanning it, which is
+   * not reported to meta.
+   */
+  static nebula::cpp2::ErrorCode reconcile(StorageEnv* env, GraphSpaceID space, PartitionID part);
+
  protected:
   nebula::cpp2::ErrorCode genSubTask(GraphSpaceID space,
                                      PartitionID part,
@@ -52,6 +58,12 @@ class StatsTask : public AdminTask {
  private:
   nebula::cpp2::ErrorCode getSchemas(GraphSpaceID spaceId);
 
+  // Stats the part by the counters maintained by the writes if they are reconciled recently
+  bool statsByCounters(GraphSpaceID spaceId,
+                       PartitionID part,
+                       const std::unordered_map<TagID, std::string>& tags,
+                       const std::unordered_map<EdgeType, std::string>& edges);
+
   void sleepIfScannedSomeRecord(size_t& countToSleep);
 
  protected:
@@ -68,6 +80,9 @@ class StatsTask : public AdminTask {
   // The number of subtasks equals to the number of parts in request
   size_t subTaskSize_{0};
 
+  // Scan the parts even if their counters are reconciled
+  bool scanOnly_{false};
+
   static constexpr size_t kRecordsToSleep{1000};
 };
 
@@ -108,7 +108,7 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
   }
 
   folly::StringPiece val() const override {
-    return val_;
+    return kvstore::toStringPiece(val_);
   }
 
   RowReaderWrapper* reader() const override {
@@ -133,9 +133,12 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
                                    *edgeKey.edge_type_ref(),
                                    *edgeKey.ranking_ref(),
                                    (*edgeKey.dst_ref()).getStr());
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &val_);
+    // decode the value in place, it is pinned until the next read or clear
+    ret = context_->env()->kvstore_->getPinned(
+        context_->spaceId(), partId, key_, &val_, context_->canReadFromFollower());
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
-      return doExecute(key_, val_);
+      resetReader();
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       // regard key not found as succeed as well, upper node will handle it
       return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -143,9 +146,10 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
     return ret;
   }
 
-  nebula::cpp2::ErrorCode doExecute(const std::string& key, const std::string& value) {
-    key_ = key;
-    val_ = value;
+  nebula::cpp2::ErrorCode doExecute(folly::StringPiece key, folly::StringPiece value) {
+    key_.assign(key.data(), key.size());
+    // the value may come from an iterator which moves on, so keep a copy of it
+    val_.PinSelf(kvstore::toSlice(value));
     resetReader();
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
@@ -153,13 +157,13 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
   void clear() {
     valid_ = false;
     key_.clear();
-    val_.clear();
+    val_.Reset();
     reader_.reset();
   }
 
  private:
   void resetReader() {
-    reader_.reset(*schemas_, val_);
+    reader_.reset(*schemas_, val());
     if (!reader_ ||
         (ttl_.has_value() &&
          CommonUtils::checkDataExpiredForTTL(
@@ -172,7 +176,7 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
 
   bool valid_ = false;
   std::string key_;
-  std::string val_;
+  kvstore::PinnedValue val_;
   RowReaderWrapper reader_;
 };
 
@@ -225,8 +229,21 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", edgeType " << edgeType_
             << ", prop size " << props_->size();
     std::unique_ptr<kvstore::KVIterator> iter;
-    prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
-    ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+    if (edgeContext_->adjacencyOrder_) {
+      prefix_ = NebulaKeyUtils::adjacencyPrefix(context_->vIdLen(), partId, vId, edgeType_);
+      ret = context_->env()->kvstore_->prefix(
+          context_->spaceId(), partId, prefix_, &iter, context_->canReadFromFollower());
+      if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter) {
+        auto adjacencyIter =
+            std::make_unique<AdjacencyIterator>(context_, partId, std::move(iter), schemas_);
+        ret = adjacencyIter->code();
+        iter = std::move(adjacencyIter);
+      }
+    } else {
+      prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
+      ret = context_->env()->kvstore_->prefix(
+          context_->spaceId(), partId, prefix_, &iter, context_->canReadFromFollower());
+    }
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter && iter->valid()) {
       if (!skipDecode_) {
         iter_.reset(new SingleEdgeIterator(context_, std::move(iter), edgeType_, schemas_, &ttl_));
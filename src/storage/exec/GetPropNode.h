@@ -39,7 +39,7 @@ class GetTagPropNode : public QueryNode<VertexID> {
     if (resultDataSet_->size() >= limit_) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     }
-    auto ret = RelNode::doExecute(partId, vId);
+    auto ret = readTags(partId, vId);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
     }
@@ -54,8 +54,10 @@ class GetTagPropNode : public QueryNode<VertexID> {
       if (FLAGS_use_vertex_key) {
         auto kvstore = context_->env()->kvstore_;
         auto vertexKey = NebulaKeyUtils::vertexKey(context_->vIdLen(), partId, vId);
-        std::string value;
-        ret = kvstore->get(context_->spaceId(), partId, vertexKey, &value);
+        // only check existence, the pinned value saves copying it out
+        kvstore::PinnedValue value;
+        ret = kvstore->getPinned(
+            context_->spaceId(), partId, vertexKey, &value, context_->canReadFromFollower());
         if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
           return nebula::cpp2::ErrorCode::SUCCEEDED;
         } else if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -65,7 +67,8 @@ class GetTagPropNode : public QueryNode<VertexID> {
         // check if vId has any valid tag by prefix scan
         std::unique_ptr<kvstore::KVIterator> iter;
         auto tagPrefix = NebulaKeyUtils::tagPrefix(context_->vIdLen(), partId, vId);
-        ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, tagPrefix, &iter);
+        ret = context_->env()->kvstore_->prefix(
+            context_->spaceId(), partId, tagPrefix, &iter, context_->canReadFromFollower());
         if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return ret;
         } else if (!iter->valid()) {
@@ -155,6 +158,37 @@ class GetTagPropNode : public QueryNode<VertexID> {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+ private:
+  /**
+   * @brief Read the tags of all tag nodes in one batch, and hand the pinned values to them. The
+   * batched read is in the duration of this node, the tag nodes only count their own work.
+   */
+  nebula::cpp2::ErrorCode readTags(PartitionID partId, const VertexID& vId) {
+    keys_.clear();
+    for (auto* tagNode : tagNodes_) {
+      keys_.emplace_back(
+          NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagNode->tagId()));
+    }
+    auto [code, status] = context_->env()->kvstore_->multiGetPinned(
+        context_->spaceId(), partId, keys_, &values_, context_->canReadFromFollower());
+    // regard key not found as succeed as well, the tag node is invalid then
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return code;
+    }
+    for (size_t i = 0; i < tagNodes_.size(); i++) {
+      if (!status[i].ok() && !status[i].isKeyNotFound()) {
+        return nebula::cpp2::ErrorCode::E_UNKNOWN;
+      }
+      auto ret = tagNodes_[i]->execute(
+          partId, vId, std::move(keys_[i]), status[i].ok() ? &values_[i] : nullptr);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
  private:
   RuntimeContext* context_;
   std::vector<TagNode*> tagNodes_;
@@ -163,6 +197,9 @@ class GetTagPropNode : public QueryNode<VertexID> {
   Expression* filter_{nullptr};
   const std::size_t limit_{std::numeric_limits<std::size_t>::max()};
   TagContext* tagContext_;
+  // Reused by each vertex
+  std::vector<std::string> keys_;
+  std::vector<kvstore::PinnedValue> values_;
 };
 
 class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
@@ -70,8 +70,14 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
     }
 
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->planContext_->spaceId_, partId, start, prefix, &iter, enableReadFollower_);
+    // scan is a full partition scan, so don't pollute the block cache of online queries
+    auto kvRet = context_->env()->kvstore_->rangeWithPrefix(context_->planContext_->spaceId_,
+                                                            partId,
+                                                            start,
+                                                            prefix,
+                                                            &iter,
+                                                            enableReadFollower_,
+                                                            kvstore::ScanMode::kBulk);
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -100,7 +106,7 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
         break;
       }
       auto value = iter->val();
-      tagNodes_[tagIdIndex->second]->doExecute(key.toString(), value.toString());
+      tagNodes_[tagIdIndex->second]->doExecute(key, value);
     }  // iterate key
     if (static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit) {
       ret = collectOneRow(isIntId, vIdLen, currentVertexId);
@@ -244,8 +250,14 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
     }
 
     std::unique_ptr<kvstore::KVIterator> iter;
-    auto kvRet = context_->env()->kvstore_->rangeWithPrefix(
-        context_->spaceId(), partId, start, prefix, &iter, enableReadFollower_);
+    // scan is a full partition scan, so don't pollute the block cache of online queries
+    auto kvRet = context_->env()->kvstore_->rangeWithPrefix(context_->spaceId(),
+                                                            partId,
+                                                            start,
+                                                            prefix,
+                                                            &iter,
+                                                            enableReadFollower_,
+                                                            kvstore::ScanMode::kBulk);
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
@@ -265,7 +277,7 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
         continue;
       }
       auto value = iter->val();
-      edgeNodes_[edgeNodeIndex->second]->doExecute(key.toString(), value.toString());
+      edgeNodes_[edgeNodeIndex->second]->doExecute(key, value);
       ret = collectOneRow(isIntId, vIdLen);
       if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
         return ret;
@@ -6,8 +6,12 @@
 #ifndef STORAGE_EXEC_STORAGEITERATOR_H_
 #define STORAGE_EXEC_STORAGEITERATOR_H_
 
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
 #include "codec/RowReaderWrapper.h"
 #include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "kvstore/Common.h"
 #include "kvstore/KVIterator.h"
 #include "storage/CommonUtils.h"
 #include "storage/StorageFlags.h"
@@ -59,6 +63,103 @@ class StorageIterator {
   virtual RowReaderWrapper* reader() const = 0;
 };
 
+/**
+ * @brief Iterator over the adjacency index keys of a vertex, which returns the key and value of
+ * the edges in the adjacency order, so it could be wrapped by SingleEdgeIterator the same as the
+ * iterator of edge prefix.
+ *
+ * The value of each edge is read by a point lookup. The index keys whose edge doesn't exist, or
+ * whose sort value doesn't match the edge, are stale and skipped.
+ */
+class AdjacencyIterator : public kvstore::KVIterator {
+ public:
+  /**
+   * @brief Construct a new Adjacency Iterator object
+   *
+   * @param context
+   * @param partId
+   * @param iter Kvstore's iterator of the adjacency prefix.
+   * @param schemas EdgeType's all version schemas, the latest one has the adjacency order.
+   */
+  AdjacencyIterator(RuntimeContext* context,
+                    PartitionID partId,
+                    std::unique_ptr<kvstore::KVIterator> iter,
+                    const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas)
+      : context_(context), partId_(partId), iter_(std::move(iter)), schemas_(schemas) {
+    CHECK(!!iter_);
+    seek();
+  }
+
+  bool valid() const override {
+    return valid_;
+  }
+
+  void next() override {
+    iter_->next();
+    seek();
+  }
+
+  void prev() override {
+    LOG(FATAL) << "Adjacency iterator could not move backward";
+  }
+
+  folly::StringPiece key() const override {
+    return edgeKey_;
+  }
+
+  folly::StringPiece val() const override {
+    return kvstore::toStringPiece(val_);
+  }
+
+  /**
+   * @brief Error code of reading the edges, the iterator stops at the first failure
+   */
+  nebula::cpp2::ErrorCode code() const {
+    return code_;
+  }
+
+ private:
+  // Move to the first index key whose edge is live, starting from the current one
+  void seek() {
+    valid_ = false;
+    auto vIdLen = context_->vIdLen();
+    for (; iter_->valid(); iter_->next()) {
+      edgeKey_ = NebulaKeyUtils::adjacencyToEdgeKey(vIdLen, iter_->key());
+      code_ = context_->env()->kvstore_->getPinned(context_->spaceId(),
+                                                   partId_,
+                                                   edgeKey_,
+                                                   &val_,
+                                                   context_->canReadFromFollower());
+      if (code_ == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        code_ = nebula::cpp2::ErrorCode::SUCCEEDED;
+        continue;
+      } else if (code_ != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << "Read edge of adjacency index failed: "
+                   << apache::thrift::util::enumNameSafe(code_);
+        return;
+      }
+      RowReaderWrapper reader;
+      reader.reset(*schemas_, val());
+      // The bad format one is reported by SingleEdgeIterator
+      if (!reader || CommonUtils::adjacencyValue(schemas_->back().get(), reader.get()) ==
+                         NebulaKeyUtils::getAdjacencyValue(vIdLen, iter_->key())) {
+        valid_ = true;
+        return;
+      }
+    }
+  }
+
+  RuntimeContext* context_;
+  PartitionID partId_;
+  std::unique_ptr<kvstore::KVIterator> iter_;
+  const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas_;
+
+  bool valid_{false};
+  nebula::cpp2::ErrorCode code_{nebula::cpp2::ErrorCode::SUCCEEDED};
+  std::string edgeKey_;
+  kvstore::PinnedValue val_;
+};
+
 /**
  * @brief Iterator of single specified type
  *
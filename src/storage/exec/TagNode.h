@@ -21,6 +21,7 @@ namespace storage {
 class TagNode final : public IterateNode<VertexID> {
  public:
   using RelNode::doExecute;
+  using RelNode::execute;
 
   /**
    * @brief Construct a new Tag Node object
@@ -63,9 +64,12 @@ class TagNode final : public IterateNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", tagId " << tagId_ << ", prop size "
             << props_->size();
     key_ = NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_);
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &value_);
+    // decode the value in place, it is pinned until the next read or clear
+    ret = context_->env()->kvstore_->getPinned(
+        context_->spaceId(), partId, key_, &value_, context_->canReadFromFollower());
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
-      return doExecute(key_, value_);
+      resetReader();
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       // regard key not found as succeed as well, upper node will handle it
       return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -80,13 +84,51 @@ class TagNode final : public IterateNode<VertexID> {
    * @param value Next value to be read
    * @return nebula::cpp2::ErrorCode
    */
-  nebula::cpp2::ErrorCode doExecute(const std::string& key, const std::string& value) {
-    key_ = key;
-    value_ = value;
+  nebula::cpp2::ErrorCode doExecute(folly::StringPiece key, folly::StringPiece value) {
+    key_.assign(key.data(), key.size());
+    // the value may come from an iterator which moves on, so keep a copy of it
+    value_.PinSelf(kvstore::toSlice(value));
     resetReader();
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  /**
+   * @brief Take the value which is read by the upper node in a batch, instead of reading it again.
+   * The duration and dependencies are handled as `RelNode::execute' does.
+   *
+   * @param partId
+   * @param vId
+   * @param key Tag key
+   * @param value Pinned value of the key, it is moved into the node. nullptr if key not found
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode execute(PartitionID partId,
+                                  const VertexID& vId,
+                                  std::string key,
+                                  kvstore::PinnedValue* value) {
+    duration_.resume();
+    auto ret = doExecute(partId, vId, std::move(key), value);
+    duration_.pause();
+    return ret;
+  }
+
+  nebula::cpp2::ErrorCode doExecute(PartitionID partId,
+                                    const VertexID& vId,
+                                    std::string key,
+                                    kvstore::PinnedValue* value) {
+    valid_ = false;
+    auto ret = RelNode::doExecute(partId, vId);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    key_ = std::move(key);
+    if (value != nullptr) {
+      value_ = std::move(*value);
+      resetReader();
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   /**
    * @brief Collect tag's prop
    *
@@ -116,7 +158,7 @@ class TagNode final : public IterateNode<VertexID> {
   }
 
   folly::StringPiece val() const override {
-    return value_;
+    return kvstore::toStringPiece(value_);
   }
 
   RowReaderWrapper* reader() const override {
@@ -134,13 +176,13 @@ class TagNode final : public IterateNode<VertexID> {
   void clear() {
     valid_ = false;
     key_.clear();
-    value_.clear();
+    value_.Reset();
     reader_.reset();
   }
 
  private:
   void resetReader() {
-    reader_.reset(*schemas_, value_);
+    reader_.reset(*schemas_, val());
     if (!reader_ ||
         (ttl_.has_value() &&
          CommonUtils::checkDataExpiredForTTL(
@@ -163,7 +205,7 @@ class TagNode final : public IterateNode<VertexID> {
 
   bool valid_ = false;
   std::string key_;
-  std::string value_;
+  kvstore::PinnedValue value_;
   RowReaderWrapper reader_;
 };
 
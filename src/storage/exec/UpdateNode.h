@@ -839,7 +839,24 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
         }
       }
     }
-    // step 3, insert new edge data
+    // step 3, replace the adjacency index key if the edge type has an adjacency order
+    if (schema_->getAdjacencyOrderCol() != nullptr) {
+      auto nReader = RowReaderWrapper::getEdgePropReader(
+          context_->env()->schemaMan_, context_->spaceId(), std::abs(edgeType_), nVal);
+      if (!nReader) {
+        LOG(ERROR) << "Bad format row";
+        return std::nullopt;
+      }
+      auto nak = CommonUtils::adjacencyKey(context_->vIdLen(), key_, schema_, nReader.get());
+      if (!val_.empty() && reader_ != nullptr) {
+        auto oak = CommonUtils::adjacencyKey(context_->vIdLen(), key_, schema_, reader_);
+        if (oak != nak) {
+          batchHolder->remove(std::move(oak));
+        }
+      }
+      batchHolder->put(std::move(nak), "");
+    }
+    // step 4, insert new edge data
     batchHolder->put(std::move(key_), std::move(nVal));
 
     // extra phase: if there are some extra requirement.
@@ -21,6 +21,7 @@
 #include "storage/exec/IndexSelectionNode.h"
 #include "storage/exec/IndexTopNNode.h"
 #include "storage/exec/IndexVertexScanNode.h"
+#include "storage/query/MorselScheduler.h"
 
 namespace nebula {
 namespace storage {
@@ -71,10 +72,16 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
     onFinished();
     return;
   }
-  if (!FLAGS_query_concurrently) {
-    runInSingleThread(req.get_parts(), std::move(plan));
+  // The size of an index scan is unknown before scanning, so the morsel is a whole part, and the
+  // parts run concurrently only if there are idle threads in the reader pool
+  const auto& parts = req.get_parts();
+  auto parallelism = MorselScheduler::parallelism(parts.size(), executor_);
+  if (!FLAGS_query_concurrently && parallelism <= 1) {
+    MorselScheduler::recordParallelism(1);
+    runInSingleThread(parts, std::move(plan));
   } else {
-    runInMultipleThread(req.get_parts(), std::move(plan));
+    MorselScheduler::recordParallelism(parts.size());
+    runInMultipleThread(parts, std::move(plan));
   }
 }
 ::nebula::cpp2::ErrorCode LookupProcessor::prepare(const cpp2::LookupIndexRequest& req) {
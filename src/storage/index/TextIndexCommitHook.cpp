@@ -0,0 +1,337 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/index/TextIndexCommitHook.h"
+
+#include "codec/RowReaderWrapper.h"
+#include "common/base/ErrorOr.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace storage {
+
+using plugin::TextIndexKeyUtils;
+
+class TextIndexCommitHook::IndexApplier final : public kvstore::CommitHook::Applier {
+ public:
+  IndexApplier(TextIndexCommitHook* hook,
+               GraphSpaceID spaceId,
+               PartitionID partId,
+               size_t vIdLen,
+               std::shared_ptr<const Defines> partDefines,
+               kvstore::KVEngine* engine,
+               kvstore::WriteBatch* batch)
+      : hook_(hook),
+        spaceId_(spaceId),
+        partId_(partId),
+        vIdLen_(vIdLen),
+        defines_(std::move(partDefines)),
+        engine_(engine),
+        batch_(batch) {}
+
+  nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
+    if (isFulltext(key)) {
+      return applyFulltext(key, &value);
+    }
+    return apply(key, &value);
+  }
+
+  nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
+    if (isFulltext(key)) {
+      return applyFulltext(key, nullptr);
+    }
+    return apply(key, nullptr);
+  }
+
+  void committed() override {
+    if (changed_.has_value()) {
+      hook_->setDefines(spaceId_, partId_, std::move(*changed_));
+    }
+  }
+
+ private:
+  static bool isFulltext(folly::StringPiece key) {
+    return key.size() >= sizeof(PartitionID) + sizeof(char) + sizeof(int32_t) &&
+           NebulaKeyUtils::isFulltext(key);
+  }
+
+  // The definitions changed in the batch take effect for the rest of it
+  const Defines* current() const {
+    if (changed_.has_value()) {
+      return &*changed_;
+    }
+    return defines_.get();
+  }
+
+  nebula::cpp2::ErrorCode applyFulltext(folly::StringPiece key, const folly::StringPiece* value) {
+    auto kind = TextIndexKeyUtils::getKind(key);
+    if (kind == TextIndexKeyUtils::kDefine) {
+      if (!changed_.has_value()) {
+        changed_ = defines_ != nullptr ? *defines_ : Defines();
+      }
+      // The index defined again with other fields, or dropped, is not built any more
+      auto schemaId = TextIndexKeyUtils::getSchemaId(key);
+      auto name = TextIndexKeyUtils::getIndexName(key);
+      bool same = false;
+      auto schema = changed_->find(schemaId);
+      if (value != nullptr && schema != changed_->end()) {
+        auto index = schema->second.find(name.str());
+        same = index != schema->second.end() &&
+               index->second == TextIndexKeyUtils::decodeTerms(*value);
+      }
+      if (!same) {
+        auto code = batch_->remove(TextIndexKeyUtils::builtKey(partId_, schemaId, name));
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return code;
+        }
+      }
+      applyDefine(*changed_, key, value);
+    } else if (kind == TextIndexKeyUtils::kReindex && value != nullptr) {
+      // Index the current value of the tag or edge again, the reindex key itself is not kept
+      auto code = batch_->remove(key);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      auto dataKey = TextIndexKeyUtils::getDataKey(key);
+      auto changed = dataOverlay_.find(dataKey.str());
+      if (changed != dataOverlay_.end()) {
+        if (!changed->second.has_value()) {
+          return apply(dataKey, nullptr);
+        }
+        auto val = *changed->second;
+        folly::StringPiece piece(val);
+        return apply(dataKey, &piece);
+      }
+      std::string val;
+      code = engine_->get(dataKey.str(), &val);
+      if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        return apply(dataKey, nullptr);
+      } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      folly::StringPiece piece(val);
+      return apply(dataKey, &piece);
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode apply(folly::StringPiece key, const folly::StringPiece* value) {
+    auto* indexed = current();
+    if (indexed == nullptr || indexed->empty()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    int32_t schemaId = 0;
+    bool isTag = NebulaKeyUtils::isTag(vIdLen_, key);
+    if (isTag) {
+      schemaId = NebulaKeyUtils::getTagId(vIdLen_, key);
+    } else if (NebulaKeyUtils::isEdge(vIdLen_, key)) {
+      schemaId = NebulaKeyUtils::getEdgeType(vIdLen_, key);
+      // Only the out edge is indexed
+      if (schemaId < 0) {
+        return nebula::cpp2::ErrorCode::SUCCEEDED;
+      }
+    } else {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto found = indexed->find(schemaId);
+    if (found == indexed->end()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    const auto& indexes = found->second;
+
+    RowReaderWrapper reader;
+    std::string docKey;
+    if (isTag) {
+      if (value != nullptr) {
+        reader = RowReaderWrapper::getTagPropReader(hook_->schemaMan_, spaceId_, schemaId, *value);
+      }
+      docKey = NebulaKeyUtils::getVertexId(vIdLen_, key).str();
+    } else {
+      if (value != nullptr) {
+        reader =
+            RowReaderWrapper::getEdgePropReader(hook_->schemaMan_, spaceId_, schemaId, *value);
+      }
+      docKey = TextIndexKeyUtils::edgeDocKey(NebulaKeyUtils::getSrcId(vIdLen_, key),
+                                             NebulaKeyUtils::getRank(vIdLen_, key),
+                                             NebulaKeyUtils::getDstId(vIdLen_, key));
+    }
+    if (value != nullptr && reader == nullptr) {
+      // The schema version of row is not in the local cache yet, e.g. the cache of follower is
+      // behind the leader. The logs are committed again later instead of leaving the document out
+      // of the index.
+      LOG(WARNING) << "Get reader failed, schema id " << schemaId << ", delay the commit";
+      return nebula::cpp2::ErrorCode::E_WRITE_STALLED;
+    }
+    if (value != nullptr) {
+      dataOverlay_[key.str()] = value->str();
+    } else {
+      dataOverlay_[key.str()] = std::nullopt;
+    }
+
+    for (const auto& [name, fields] : indexes) {
+      auto forwardKey = TextIndexKeyUtils::forwardKey(partId_, schemaId, name, docKey);
+      auto oldTerms = getTerms(forwardKey);
+      if (!nebula::ok(oldTerms)) {
+        return nebula::error(oldTerms);
+      }
+      for (const auto& term : nebula::value(oldTerms)) {
+        auto code = batch_->remove(
+            TextIndexKeyUtils::postingKey(partId_, schemaId, name, term, docKey));
+        if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return code;
+        }
+      }
+
+      std::vector<std::string> newTerms;
+      if (value != nullptr) {
+        std::map<std::string, std::vector<uint32_t>> postings;
+        uint32_t pos = 0;
+        for (const auto& field : fields) {
+          auto v = reader->getValueByName(field);
+          if (!v.isStr()) {
+            continue;
+          }
+          for (auto& token : plugin::TextTokenizer::tokenize(v.getStr(), pos)) {
+            pos = token.pos + 1;
+            postings[std::move(token.term)].emplace_back(token.pos);
+          }
+          pos += plugin::TextTokenizer::kFieldGap;
+        }
+        for (const auto& [term, positions] : postings) {
+          auto code = batch_->put(
+              TextIndexKeyUtils::postingKey(partId_, schemaId, name, term, docKey),
+              plugin::PostingCodec::encode(positions));
+          if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+            return code;
+          }
+          newTerms.emplace_back(term);
+        }
+      }
+
+      auto code = newTerms.empty()
+                      ? batch_->remove(forwardKey)
+                      : batch_->put(forwardKey, TextIndexKeyUtils::encodeTerms(newTerms));
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      overlay_[std::move(forwardKey)] = std::move(newTerms);
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  // The terms of document, the ones changed in the batch are not visible in engine yet
+  ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>> getTerms(
+      const std::string& forwardKey) {
+    auto iter = overlay_.find(forwardKey);
+    if (iter != overlay_.end()) {
+      return iter->second;
+    }
+    std::string val;
+    auto code = engine_->get(forwardKey, &val);
+    if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+      return std::vector<std::string>();
+    } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return code;
+    }
+    return TextIndexKeyUtils::decodeTerms(val);
+  }
+
+  TextIndexCommitHook* hook_;
+  GraphSpaceID spaceId_;
+  PartitionID partId_;
+  size_t vIdLen_;
+  // The definitions when the batch begins, and the ones changed in the batch
+  std::shared_ptr<const Defines> defines_;
+  std::optional<Defines> changed_;
+  kvstore::KVEngine* engine_;
+  kvstore::WriteBatch* batch_;
+  // The tags and edges of the indexed schemas changed in the batch
+  std::unordered_map<std::string, std::optional<std::string>> dataOverlay_;
+  std::unordered_map<std::string, std::vector<std::string>> overlay_;
+};
+
+std::unique_ptr<kvstore::CommitHook::Applier> TextIndexCommitHook::begin(
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    kvstore::KVEngine* engine,
+    kvstore::WriteBatch* batch) {
+  auto vIdLen = schemaMan_->getSpaceVidLen(spaceId);
+  if (!vIdLen.ok()) {
+    return nullptr;
+  }
+  // The part without builtin index only looks at the define keys, the data keys are skipped
+  // before they are decoded
+  return std::make_unique<IndexApplier>(
+      this, spaceId, partId, vIdLen.value(), defines(spaceId, partId), engine, batch);
+}
+
+void TextIndexCommitHook::load(GraphSpaceID spaceId,
+                               PartitionID partId,
+                               kvstore::KVEngine* engine) {
+  Defines loaded;
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code =
+      engine->prefix(TextIndexKeyUtils::kindPrefix(partId, TextIndexKeyUtils::kDefine), &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    LOG(FATAL) << "Load the builtin fulltext indexes failed, space " << spaceId << ", part "
+               << partId;
+  }
+  for (; iter->valid(); iter->next()) {
+    auto value = iter->val();
+    applyDefine(loaded, iter->key(), &value);
+  }
+  setDefines(spaceId, partId, std::move(loaded));
+}
+
+// static
+void TextIndexCommitHook::applyDefine(Defines& partDefines,
+                                      folly::StringPiece key,
+                                      const folly::StringPiece* value) {
+  auto schemaId = TextIndexKeyUtils::getSchemaId(key);
+  auto name = TextIndexKeyUtils::getIndexName(key).str();
+  if (value != nullptr) {
+    partDefines[schemaId][name] = TextIndexKeyUtils::decodeTerms(*value);
+    return;
+  }
+  auto found = partDefines.find(schemaId);
+  if (found != partDefines.end()) {
+    found->second.erase(name);
+    if (found->second.empty()) {
+      partDefines.erase(found);
+    }
+  }
+}
+
+std::shared_ptr<const TextIndexCommitHook::Defines> TextIndexCommitHook::defines(
+    GraphSpaceID spaceId, PartitionID partId) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto space = defines_.find(spaceId);
+  if (space == defines_.end()) {
+    return nullptr;
+  }
+  auto part = space->second.find(partId);
+  return part != space->second.end() ? part->second : nullptr;
+}
+
+void TextIndexCommitHook::setDefines(GraphSpaceID spaceId,
+                                     PartitionID partId,
+                                     Defines partDefines) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (partDefines.empty()) {
+    auto space = defines_.find(spaceId);
+    if (space != defines_.end()) {
+      space->second.erase(partId);
+      if (space->second.empty()) {
+        defines_.erase(space);
+      }
+    }
+    return;
+  }
+  defines_[spaceId][partId] = std::make_shared<const Defines>(std::move(partDefines));
+}
+
+}  // namespace storage
+}  // namespace nebula
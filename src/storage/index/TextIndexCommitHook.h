@@ -0,0 +1,63 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_INDEX_TEXTINDEXCOMMITHOOK_H_
+#define STORAGE_INDEX_TEXTINDEXCOMMITHOOK_H_
+
+#include "common/base/Base.h"
+#include "common/meta/SchemaManager.h"
+#include "kvstore/CommitHook.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Maintain the builtin fulltext indexes when the tags and edges are committed.
+ *
+ * For each document changed, the postings of its old terms are removed and the ones of its new
+ * terms are written, the terms of document are kept in the forward key to find the old postings.
+ * The indexes maintained are the ones defined in the part, so all peers apply the same logs with
+ * the same indexes. The definitions of each part are kept in memory, loaded when the part starts
+ * and changed when the define keys are committed. The built key of an index defined again with
+ * other fields, or dropped, is removed, so it is not searched until rebuilt. A reindex key makes
+ * the current value of a document indexed again, which is how the rebuild job backfills. Range
+ * removes are not handled, the postings left are filtered by the text search.
+ */
+class TextIndexCommitHook final : public kvstore::CommitHook {
+ public:
+  explicit TextIndexCommitHook(meta::SchemaManager* schemaMan) : schemaMan_(schemaMan) {}
+
+  std::unique_ptr<Applier> begin(GraphSpaceID spaceId,
+                                 PartitionID partId,
+                                 kvstore::KVEngine* engine,
+                                 kvstore::WriteBatch* batch) override;
+
+  void load(GraphSpaceID spaceId, PartitionID partId, kvstore::KVEngine* engine) override;
+
+ private:
+  class IndexApplier;
+
+  // The fields of the builtin indexes defined in a part, by schema id and index name
+  using Defines = std::unordered_map<int32_t, std::map<std::string, std::vector<std::string>>>;
+
+  static void applyDefine(Defines& partDefines,
+                          folly::StringPiece key,
+                          const folly::StringPiece* value);
+
+  // nullptr if there is no builtin index defined in the part
+  std::shared_ptr<const Defines> defines(GraphSpaceID spaceId, PartitionID partId);
+
+  void setDefines(GraphSpaceID spaceId, PartitionID partId, Defines partDefines);
+
+  meta::SchemaManager* schemaMan_;
+  std::mutex lock_;
+  std::unordered_map<GraphSpaceID, std::unordered_map<PartitionID, std::shared_ptr<const Defines>>>
+      defines_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_INDEX_TEXTINDEXCOMMITHOOK_H_
@@ -0,0 +1,239 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/index/TextSearchProcessor.h"
+
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace storage {
+
+ProcessorCounters kTextSearchCounters;
+
+using plugin::PostingCodec;
+using plugin::TextIndexKeyUtils;
+using plugin::TextQuery;
+
+void TextSearchProcessor::process(const cpp2::TextSearchRequest& req) {
+  spaceId_ = req.get_space_id();
+  auto code = getSpaceVidLen(spaceId_);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    for (auto& partId : req.get_parts()) {
+      pushResultCode(code, partId);
+    }
+    onFinished();
+    return;
+  }
+  const auto& schemaId = req.get_schema_id();
+  isEdge_ = schemaId.getType() == nebula::cpp2::SchemaID::Type::edge_type;
+  schemaId_ = isEdge_ ? schemaId.get_edge_type() : schemaId.get_tag_id();
+  indexName_ = req.get_index_name();
+  limit_ = req.get_limit();
+
+  auto query = TextQuery::parse(req.get_query());
+  if (!query.ok()) {
+    LOG(ERROR) << query.status();
+    for (auto& partId : req.get_parts()) {
+      pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_PARM, partId);
+    }
+    onFinished();
+    return;
+  }
+
+  if (isEdge_) {
+    result_.colNames = {kSrc, kRank, kDst, "_score"};
+  } else {
+    result_.colNames = {kVid, "_score"};
+  }
+  for (auto& partId : req.get_parts()) {
+    code = searchPart(partId, query.value());
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      handleErrorCode(code, spaceId_, partId);
+    }
+  }
+  resp_.data_ref() = std::move(result_);
+  onFinished();
+}
+
+nebula::cpp2::ErrorCode TextSearchProcessor::searchPart(PartitionID partId,
+                                                        const TextQuery& query) {
+  // The index not rebuilt in the part yet would miss the documents written before it
+  std::string built;
+  auto code = env_->kvstore_->get(
+      spaceId_, partId, TextIndexKeyUtils::builtKey(partId, schemaId_, indexName_), &built);
+  if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND;
+  } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto prefix = TextIndexKeyUtils::indexPrefix(
+      partId, TextIndexKeyUtils::kPosting, schemaId_, indexName_);
+  Matched scores;
+  bool first = true;
+  for (const auto& clause : query.clauses) {
+    auto ret = clause.kind == TextQuery::Clause::Kind::kPhrase
+                   ? matchPhrase(partId, clause.terms)
+                   : clause.kind == TextQuery::Clause::Kind::kTerm
+                         ? matchTerms(partId, prefix + clause.terms.front() + '\0', true)
+                         : matchTerms(partId, prefix + clause.terms.front(), false);
+    if (!nebula::ok(ret)) {
+      return nebula::error(ret);
+    }
+    auto matched = std::move(nebula::value(ret));
+    if (first) {
+      scores = std::move(matched);
+      first = false;
+    } else {
+      for (auto iter = scores.begin(); iter != scores.end();) {
+        auto found = matched.find(iter->first);
+        if (found == matched.end()) {
+          iter = scores.erase(iter);
+        } else {
+          iter->second += found->second;
+          ++iter;
+        }
+      }
+    }
+    if (scores.empty()) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+  }
+
+  std::vector<std::pair<std::string, double>> docs(scores.begin(), scores.end());
+  std::sort(docs.begin(), docs.end(), [](const auto& a, const auto& b) {
+    return a.second > b.second || (a.second == b.second && a.first < b.first);
+  });
+  int64_t count = 0;
+  for (const auto& [docKey, score] : docs) {
+    if (limit_ > 0 && count >= limit_) {
+      break;
+    }
+    auto exists = docExists(partId, docKey);
+    if (!nebula::ok(exists)) {
+      return nebula::error(exists);
+    }
+    if (!nebula::value(exists)) {
+      continue;
+    }
+    if (isEdge_) {
+      folly::StringPiece doc(docKey);
+      auto rank = readInt<EdgeRanking>(doc.data() + spaceVidLen_, sizeof(EdgeRanking));
+      result_.emplace_back(Row({vid(doc.subpiece(0, spaceVidLen_)),
+                                rank,
+                                vid(doc.subpiece(spaceVidLen_ + sizeof(EdgeRanking))),
+                                score}));
+    } else {
+      result_.emplace_back(Row({vid(docKey), score}));
+    }
+    count++;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, TextSearchProcessor::Matched> TextSearchProcessor::matchTerms(
+    PartitionID partId, const std::string& prefix, bool exact) {
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code = env_->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  Matched matched;
+  for (; iter->valid(); iter->next()) {
+    auto rest = iter->key().subpiece(prefix.size());
+    // The prefix of term ends in the middle of term, the docKey follows the end of term
+    auto docKey = exact ? rest : rest.subpiece(rest.find('\0') + 1);
+    matched[docKey.str()] += PostingCodec::decode(iter->val()).size();
+  }
+  return matched;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, TextSearchProcessor::Matched> TextSearchProcessor::matchPhrase(
+    PartitionID partId, const std::vector<std::string>& terms) {
+  auto prefix = TextIndexKeyUtils::indexPrefix(
+      partId, TextIndexKeyUtils::kPosting, schemaId_, indexName_);
+  auto termPrefix = prefix + terms.front() + '\0';
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code = env_->kvstore_->prefix(spaceId_, partId, termPrefix, &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  // The start positions of the phrase in each document
+  std::unordered_map<std::string, std::vector<uint32_t>> starts;
+  for (; iter->valid(); iter->next()) {
+    auto docKey = iter->key().subpiece(termPrefix.size());
+    starts.emplace(docKey.str(), PostingCodec::decode(iter->val()));
+  }
+
+  for (size_t i = 1; i < terms.size() && !starts.empty(); i++) {
+    for (auto it = starts.begin(); it != starts.end();) {
+      std::string val;
+      code = env_->kvstore_->get(
+          spaceId_,
+          partId,
+          TextIndexKeyUtils::postingKey(partId, schemaId_, indexName_, terms[i], it->first),
+          &val);
+      if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        it = starts.erase(it);
+        continue;
+      } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+      auto positions = PostingCodec::decode(val);
+      auto& cands = it->second;
+      cands.erase(std::remove_if(cands.begin(),
+                                 cands.end(),
+                                 [&positions, i](uint32_t pos) {
+                                   return !std::binary_search(
+                                       positions.begin(), positions.end(), pos + i);
+                                 }),
+                  cands.end());
+      if (cands.empty()) {
+        it = starts.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  Matched matched;
+  for (auto& [docKey, positions] : starts) {
+    matched.emplace(docKey, positions.size());
+  }
+  return matched;
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, bool> TextSearchProcessor::docExists(PartitionID partId,
+                                                                      folly::StringPiece docKey) {
+  std::string key;
+  if (isEdge_) {
+    auto rank = readInt<EdgeRanking>(docKey.data() + spaceVidLen_, sizeof(EdgeRanking));
+    key = NebulaKeyUtils::edgeKey(spaceVidLen_,
+                                  partId,
+                                  docKey.subpiece(0, spaceVidLen_).str(),
+                                  schemaId_,
+                                  rank,
+                                  docKey.subpiece(spaceVidLen_ + sizeof(EdgeRanking)).str());
+  } else {
+    key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, docKey.str(), schemaId_);
+  }
+  std::string val;
+  auto code = env_->kvstore_->get(spaceId_, partId, key, &val);
+  if (code == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+    return false;
+  } else if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  return true;
+}
+
+Value TextSearchProcessor::vid(folly::StringPiece raw) const {
+  if (isIntId_) {
+    return Value(*reinterpret_cast<const int64_t*>(raw.data()));
+  }
+  return Value(raw.subpiece(0, raw.find_first_of('\0')).toString());
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,66 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_INDEX_TEXTSEARCHPROCESSOR_H_
+#define STORAGE_INDEX_TEXTSEARCHPROCESSOR_H_
+
+#include "common/base/Base.h"
+#include "common/base/ErrorOr.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+#include "storage/BaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+extern ProcessorCounters kTextSearchCounters;
+
+/**
+ * @brief Search the builtin fulltext index of each part, the score of document is the sum of
+ * the frequencies of clauses matched in it. The part where the index is not rebuilt yet fails
+ * with E_INDEX_NOT_FOUND.
+ */
+class TextSearchProcessor : public BaseProcessor<cpp2::TextSearchResponse> {
+ public:
+  static TextSearchProcessor* instance(StorageEnv* env,
+                                       const ProcessorCounters* counters = &kTextSearchCounters) {
+    return new TextSearchProcessor(env, counters);
+  }
+
+  void process(const cpp2::TextSearchRequest& req);
+
+ protected:
+  TextSearchProcessor(StorageEnv* env, const ProcessorCounters* counters)
+      : BaseProcessor<cpp2::TextSearchResponse>(env, counters) {}
+
+ private:
+  // docKey -> score
+  using Matched = std::unordered_map<std::string, double>;
+
+  nebula::cpp2::ErrorCode searchPart(PartitionID partId, const plugin::TextQuery& query);
+
+  ErrorOr<nebula::cpp2::ErrorCode, Matched> matchTerms(PartitionID partId,
+                                                       const std::string& prefix,
+                                                       bool exact);
+
+  ErrorOr<nebula::cpp2::ErrorCode, Matched> matchPhrase(PartitionID partId,
+                                                        const std::vector<std::string>& terms);
+
+  // The postings left by range removes are skipped
+  ErrorOr<nebula::cpp2::ErrorCode, bool> docExists(PartitionID partId, folly::StringPiece docKey);
+
+  Value vid(folly::StringPiece raw) const;
+
+  GraphSpaceID spaceId_;
+  bool isEdge_{false};
+  int32_t schemaId_{0};
+  std::string indexName_;
+  int64_t limit_{0};
+  nebula::DataSet result_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_INDEX_TEXTSEARCHPROCESSOR_H_
@@ -46,6 +46,9 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
     return;
   }
   edgeSchema_ = schema.value();
+  hasAdjacencyOrder_ = std::any_of(edgeSchema_.begin(), edgeSchema_.end(), [](const auto& kv) {
+    return kv.second->getAdjacencyOrderCol() != nullptr;
+  });
 
   spaceVidLen_ = ret.value();
   callingNum_ = partEdges.size();
@@ -65,7 +68,8 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
 
   CHECK_NOTNULL(env_->kvstore_);
 
-  if (indexes_.empty()) {
+  // The adjacency index is maintained the same way as the index, which needs the old value
+  if (indexes_.empty() && !hasAdjacencyOrder_) {
     doProcess(req);
   } else {
     doProcessWithIndex(req);
@@ -84,6 +88,10 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
     auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
     std::unordered_set<std::string> visited;
     visited.reserve(newEdges.size());
+    auto fence = statsFence(spaceId_, partId);
+    cpp2::PartStats delta;
+    std::unordered_set<std::string> counted;
+    std::vector<std::string> countKeys;
 
     for (auto& newEdge : newEdges) {
       auto edgeKey = *newEdge.key_ref();
@@ -130,6 +138,17 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
       }
       auto schema = schemaIter->second.get();
 
+      auto edgeType = *edgeKey.edge_type_ref();
+      if (countStats() && edgeType > 0 && counted.emplace(key).second) {
+        if (ifNotExists_) {
+          // The existing ones are skipped above
+          *delta.space_edges_ref() += 1;
+          (*delta.edges_ref())[edgeType] += 1;
+        } else {
+          countKeys.emplace_back(key);
+        }
+      }
+
       auto props = newEdge.get_props();
       WriteResult wRet;
       auto retEnc = encodeRowVal(schema, propNames, props, wRet);
@@ -141,9 +160,15 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
         data.emplace_back(std::move(key), std::move(retEnc.value()));
       }
     }
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED && countStats()) {
+      code = countNew(partId, countKeys, delta);
+    }
     if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
       handleAsync(spaceId_, partId, code);
     } else {
+      if (countStats()) {
+        setStatsDelta(partId, fence, std::move(delta));
+      }
       if (consistOp_) {
         auto batchHolder = std::make_unique<kvstore::BatchHolder>();
         (*consistOp_)(*batchHolder, &data);
@@ -229,6 +254,9 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
   ret.code = nebula::cpp2::ErrorCode::E_RAFT_ATOMIC_OP_FAILED;
   IndexCountWrapper wrapper(env_);
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  auto fence = statsFence(spaceId_, partId);
+  cpp2::PartStats delta;
+  std::vector<std::string> countKeys;
   for (auto& [key, value] : data) {
     auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
     RowReaderWrapper oldReader;
@@ -240,9 +268,9 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
     }
     auto schema = schemaIter->second.get();
 
+    std::string oldVal;
     // only out-edge need to handle index
     if (edgeType > 0) {
-      std::string oldVal;
       if (!ignoreExistedIndex_) {
         // read the old key value and initialize row reader if exists
         auto result = findOldValue(partId, key);
@@ -260,6 +288,14 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
           return ret;
         }
       }
+      if (countStats()) {
+        if (ignoreExistedIndex_) {
+          countKeys.emplace_back(key);
+        } else if (oldVal.empty()) {
+          *delta.space_edges_ref() += 1;
+          (*delta.edges_ref())[edgeType] += 1;
+        }
+      }
       for (const auto& index : indexes_) {
         if (edgeType == index->get_schema_id().get_edge_type()) {
           // step 1, Delete old version index if exists.
@@ -315,7 +351,34 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
         }
       }
     }
-    // step 3, Insert new edge data
+    // step 3, Replace the adjacency index key, both out-edge and in-edge are indexed
+    if (schema->getAdjacencyOrderCol() != nullptr && newReader != nullptr) {
+      if (oldReader == nullptr && (edgeType < 0 || ignoreExistedIndex_)) {
+        auto result = findOldValue(partId, key);
+        if (!nebula::ok(result)) {
+          return ret;
+        }
+        if (!nebula::value(result).empty()) {
+          oldVal = std::move(nebula::value(result));
+          oldReader = RowReaderWrapper::getEdgePropReader(
+              env_->schemaMan_, spaceId_, std::abs(edgeType), oldVal);
+          ret.readSet.emplace_back(key);
+        }
+      }
+      auto newAdjacencyKey =
+          CommonUtils::adjacencyKey(spaceVidLen_, key, schema, newReader.get());
+      if (oldReader != nullptr) {
+        auto oldAdjacencyKey =
+            CommonUtils::adjacencyKey(spaceVidLen_, key, schema, oldReader.get());
+        if (oldAdjacencyKey != newAdjacencyKey) {
+          ret.writeSet.push_back(oldAdjacencyKey);
+          batchHolder->remove(std::move(oldAdjacencyKey));
+        }
+      }
+      ret.writeSet.push_back(newAdjacencyKey);
+      batchHolder->put(std::move(newAdjacencyKey), "");
+    }
+    // step 4, Insert new edge data
     ret.writeSet.push_back(key);
     // for why use a copy not move here:
     // previously, we use atomicOp(a kind of raft log, raft send this log in sync)
@@ -335,12 +398,35 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
   if (consistOp_) {
     (*consistOp_)(*batchHolder, nullptr);
   }
+  if (countStats()) {
+    if (countNew(partId, countKeys, delta) != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    setStatsDelta(partId, fence, std::move(delta));
+  }
 
   ret.code = nebula::cpp2::ErrorCode::SUCCEEDED;
   ret.batch = encodeBatchValue(batchHolder->getBatch());
   return ret;
 }
 
+nebula::cpp2::ErrorCode AddEdgesProcessor::countNew(PartitionID partId,
+                                                    const std::vector<std::string>& keys,
+                                                    cpp2::PartStats& delta) {
+  auto ret = keysExist(spaceId_, partId, keys);
+  if (!nebula::ok(ret)) {
+    return nebula::error(ret);
+  }
+  const auto& exists = nebula::value(ret);
+  for (size_t i = 0; i < keys.size(); i++) {
+    if (!exists[i]) {
+      *delta.space_edges_ref() += 1;
+      (*delta.edges_ref())[NebulaKeyUtils::getEdgeType(spaceVidLen_, keys[i])] += 1;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::string> AddEdgesProcessor::findOldValue(
     PartitionID partId, const folly::StringPiece& rawKey) {
   auto key = NebulaKeyUtils::edgeKey(spaceVidLen_,
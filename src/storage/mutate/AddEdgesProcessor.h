@@ -52,12 +52,19 @@ class AddEdgesProcessor : public BaseProcessor<cpp2::ExecResponse> {
 
   nebula::cpp2::ErrorCode deleteDupEdge(std::vector<cpp2::NewEdge>& edges);
 
+  // Count the out edges not written before in the space stats, checked by one read
+  nebula::cpp2::ErrorCode countNew(PartitionID partId,
+                                   const std::vector<std::string>& keys,
+                                   cpp2::PartStats& delta);
+
  private:
   GraphSpaceID spaceId_;
   std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> indexes_;
   bool ifNotExists_{false};
   bool ignoreExistedIndex_{false};
   meta::EdgeSchema edgeSchema_;
+  // Whether any edge type of the space has an adjacency order
+  bool hasAdjacencyOrder_{false};
 
   /// this is a hook function to keep out-edge and in-edge consist
   using ConsistOper = std::function<void(kvstore::BatchHolder&, std::vector<kvstore::KV>*)>;
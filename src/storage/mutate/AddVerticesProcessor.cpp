@@ -83,6 +83,13 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
     auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
     std::unordered_set<std::string> visited;
     visited.reserve(vertices.size());
+    auto fence = statsFence(spaceId_, partId);
+    cpp2::PartStats delta;
+    std::unordered_set<std::string> counted;
+    // The tags and vertices to count if they are not written before
+    std::vector<std::string> countKeys;
+    std::vector<std::string> countVids;
+    std::unordered_set<std::string> existVids;
     for (auto& vertex : vertices) {
       auto vid = vertex.get_id().getStr();
       const auto& newTags = vertex.get_tags();
@@ -93,6 +100,10 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
         code = nebula::cpp2::ErrorCode::E_INVALID_VID;
         break;
       }
+      if (countStats() && (FLAGS_use_vertex_key || !newTags.empty()) &&
+          counted.emplace(vid).second) {
+        countVids.emplace_back(vid);
+      }
       if (FLAGS_use_vertex_key) {
         data.emplace_back(NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vid), "");
       }
@@ -116,6 +127,7 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
           auto obsIdx = findOldValue(partId, vid, tagId);
           if (nebula::ok(obsIdx)) {
             if (!nebula::value(obsIdx).empty()) {
+              existVids.emplace(NebulaKeyUtils::getVertexId(spaceVidLen_, key).str());
               continue;
             }
           } else {
@@ -123,6 +135,14 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
             break;
           }
         }
+        if (countStats() && counted.emplace(key).second) {
+          if (ifNotExists_) {
+            // The existing ones are skipped above
+            (*delta.tag_vertices_ref())[tagId] += 1;
+          } else {
+            countKeys.emplace_back(key);
+          }
+        }
         auto props = newTag.get_props();
         auto iter = propNamesMap.find(tagId);
         std::vector<std::string> propNames;
@@ -140,9 +160,15 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
         data.emplace_back(std::move(key), std::move(retEnc.value()));
       }
     }
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED && countStats()) {
+      code = countNew(partId, std::move(countKeys), countVids, std::move(existVids), delta);
+    }
     if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
       handleAsync(spaceId_, partId, code);
     } else {
+      if (countStats()) {
+        setStatsDelta(partId, fence, std::move(delta));
+      }
       doPut(spaceId_, partId, std::move(data));
       stats::StatsManager::addValue(kNumVerticesInserted, data.size());
     }
@@ -232,9 +258,18 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
   ret.code = nebula::cpp2::ErrorCode::E_RAFT_ATOMIC_OP_FAILED;
   IndexCountWrapper wrapper(env_);
   auto batchHolder = std::make_unique<kvstore::BatchHolder>();
+  auto fence = statsFence(spaceId_, partId);
+  cpp2::PartStats delta;
+  std::vector<std::string> countKeys;
+  std::vector<std::string> countVids;
+  std::unordered_set<std::string> existVids;
   for (auto& vertice : vertices) {
+    if (countStats()) {
+      countVids.emplace_back(vertice.substr(sizeof(PartitionID)));
+    }
     batchHolder->put(std::string(vertice), "");
   }
+  std::unordered_set<std::string> countedVids;
   for (auto& [key, value] : data) {
     auto vId = NebulaKeyUtils::getVertexId(spaceVidLen_, key);
     auto tagId = NebulaKeyUtils::getTagId(spaceVidLen_, key);
@@ -248,12 +283,16 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
       return ret;
     }
     auto schema = schemaIter->second.get();
+    if (countStats() && !FLAGS_use_vertex_key && countedVids.emplace(vId.str()).second) {
+      countVids.emplace_back(vId.str());
+    }
     std::string oldVal;
     if (!ignoreExistedIndex_) {
       // read the old key value and initialize row reader if exists
       auto result = findOldValue(partId, vId.str(), tagId);
       if (nebula::ok(result)) {
         if (ifNotExists_ && !nebula::value(result).empty()) {
+          existVids.emplace(vId.str());
           continue;
         } else if (!nebula::value(result).empty()) {
           oldVal = std::move(nebula::value(result));
@@ -266,6 +305,15 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
         return ret;
       }
     }
+    if (countStats()) {
+      if (ignoreExistedIndex_) {
+        countKeys.emplace_back(key);
+      } else if (!oldVal.empty()) {
+        existVids.emplace(vId.str());
+      } else {
+        (*delta.tag_vertices_ref())[tagId] += 1;
+      }
+    }
     for (const auto& index : indexes_) {
       if (tagId == index->get_schema_id().get_tag_id()) {
         // step 1, Delete old version index if exists.
@@ -326,11 +374,66 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
     ret.writeSet.emplace_back(key);
     batchHolder->put(std::string(key), std::string(value));
   }
+  if (countStats()) {
+    if (countNew(partId, std::move(countKeys), countVids, std::move(existVids), delta) !=
+        nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return ret;
+    }
+    setStatsDelta(partId, fence, std::move(delta));
+  }
   ret.batch = encodeBatchValue(batchHolder->getBatch());
   ret.code = nebula::cpp2::ErrorCode::SUCCEEDED;
   return ret;
 }
 
+nebula::cpp2::ErrorCode AddVerticesProcessor::countNew(PartitionID partId,
+                                                       std::vector<std::string> tagKeys,
+                                                       const std::vector<std::string>& vids,
+                                                       std::unordered_set<std::string> existVids,
+                                                       cpp2::PartStats& delta) {
+  auto keys = std::move(tagKeys);
+  auto tagNum = keys.size();
+  if (FLAGS_use_vertex_key) {
+    for (const auto& vid : vids) {
+      keys.emplace_back(NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vid));
+    }
+  }
+  auto ret = keysExist(spaceId_, partId, keys);
+  if (!nebula::ok(ret)) {
+    return nebula::error(ret);
+  }
+  const auto& exists = nebula::value(ret);
+  for (size_t i = 0; i < tagNum; i++) {
+    if (exists[i]) {
+      existVids.emplace(NebulaKeyUtils::getVertexId(spaceVidLen_, keys[i]).str());
+    } else {
+      (*delta.tag_vertices_ref())[NebulaKeyUtils::getTagId(spaceVidLen_, keys[i])] += 1;
+    }
+  }
+  for (size_t i = 0; i < vids.size(); i++) {
+    // The vids of tag keys are padded
+    auto padded = vids[i];
+    padded.append(spaceVidLen_ - padded.size(), '\0');
+    bool vertexExist = false;
+    if (FLAGS_use_vertex_key) {
+      vertexExist = exists[tagNum + i];
+    } else if (existVids.count(padded) != 0) {
+      vertexExist = true;
+    } else {
+      // None of the tags written exists, check the other tags of the vertex
+      auto result = vertexExists(spaceId_, partId, vids[i]);
+      if (!nebula::ok(result)) {
+        return nebula::error(result);
+      }
+      vertexExist = nebula::value(result);
+    }
+    if (!vertexExist) {
+      *delta.space_vertices_ref() += 1;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::string> AddVerticesProcessor::findOldValue(
     PartitionID partId, const VertexID& vId, TagID tagId) {
   auto key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vId, tagId);
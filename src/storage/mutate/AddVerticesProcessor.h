@@ -46,6 +46,15 @@ class AddVerticesProcessor : public BaseProcessor<cpp2::ExecResponse> {
 
   void deleteDupVid(std::vector<cpp2::NewVertex>& vertices);
 
+  // Count the tags and vertices not written before in the space stats. The tags, and the vertex
+  // keys if use_vertex_key is on, are checked by one read. Otherwise a vertex exists if any tag
+  // written exists, only the others are checked by prefix.
+  nebula::cpp2::ErrorCode countNew(PartitionID partId,
+                                   std::vector<std::string> tagKeys,
+                                   const std::vector<std::string>& vids,
+                                   std::unordered_set<std::string> existVids,
+                                   cpp2::PartStats& delta);
+
   kvstore::MergeableAtomicOpResult addVerticesWithIndex(PartitionID partId,
                                                         const std::vector<kvstore::KV>& data,
                                                         const std::vector<std::string>& vertices);
@@ -48,14 +48,26 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
   }
   indexes_ = std::move(iRet).value();
 
+  auto schemas = env_->schemaMan_->getAllLatestVerEdgeSchema(spaceId_);
+  if (schemas.ok()) {
+    const auto& edgeSchema = schemas.value();
+    hasAdjacencyOrder_ = std::any_of(edgeSchema.begin(), edgeSchema.end(), [](const auto& kv) {
+      return kv.second->getAdjacencyOrderCol() != nullptr;
+    });
+  }
+
   CHECK_NOTNULL(env_->kvstore_);
-  if (indexes_.empty()) {
+  // The adjacency index keys are removed the same way as the index, which needs the value
+  if (indexes_.empty() && !hasAdjacencyOrder_) {
     // Operate every part, the graph layer guarantees the unique of the edgeKey
     for (auto& part : partEdges) {
       std::vector<std::string> keys;
       keys.reserve(32);
       auto partId = part.first;
       auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+      auto fence = statsFence(spaceId_, partId);
+      cpp2::PartStats delta;
+      std::vector<std::string> countKeys;
       for (auto& edgeKey : part.second) {
         if (!NebulaKeyUtils::isValidVidLen(
                 spaceVidLen_, edgeKey.src_ref()->getStr(), edgeKey.dst_ref()->getStr())) {
@@ -72,12 +84,32 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
                                             *edgeKey.edge_type_ref(),
                                             *edgeKey.ranking_ref(),
                                             edgeKey.dst_ref()->getStr());
+        if (countStats() && *edgeKey.edge_type_ref() > 0) {
+          countKeys.emplace_back(edge);
+        }
         keys.emplace_back(edge.data(), edge.size());
       }
+      if (code == nebula::cpp2::ErrorCode::SUCCEEDED && countStats()) {
+        // The out edges existing are counted, checked by one read
+        auto exists = keysExist(spaceId_, partId, countKeys);
+        if (nebula::ok(exists)) {
+          for (size_t i = 0; i < countKeys.size(); i++) {
+            if (nebula::value(exists)[i]) {
+              *delta.space_edges_ref() -= 1;
+              (*delta.edges_ref())[NebulaKeyUtils::getEdgeType(spaceVidLen_, countKeys[i])] -= 1;
+            }
+          }
+        } else {
+          code = nebula::error(exists);
+        }
+      }
       if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
         handleAsync(spaceId_, partId, code);
         continue;
       }
+      if (countStats()) {
+        setStatsDelta(partId, fence, std::move(delta));
+      }
 
       HookFuncPara para;
       if (tossHookFunc_) {
@@ -160,6 +192,8 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
     PartitionID partId, const std::vector<cpp2::EdgeKey>& edges) {
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  auto fence = statsFence(spaceId_, partId);
+  cpp2::PartStats delta;
   for (auto& edge : edges) {
     auto type = *edge.edge_type_ref();
     auto srcId = (*edge.src_ref()).getStr();
@@ -210,8 +244,23 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           }
         }
       }
+      // Both out-edge and in-edge are in the adjacency index
+      if (schema != nullptr && schema->getAdjacencyOrderCol() != nullptr) {
+        if (reader == nullptr) {
+          reader =
+              RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, std::abs(type), val);
+        }
+        if (reader != nullptr) {
+          batchHolder->remove(
+              CommonUtils::adjacencyKey(spaceVidLen_, key, schema.get(), reader.get()));
+        }
+      }
       batchHolder->remove(std::move(key));
       stats::StatsManager::addValue(kNumEdgesDeleted);
+      if (countStats() && type > 0) {
+        *delta.space_edges_ref() -= 1;
+        (*delta.edges_ref())[type] -= 1;
+      }
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
       continue;
     } else {
@@ -226,6 +275,9 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
     para.batch.emplace(batchHolder.get());
     (*tossHookFunc_)(para);
   }
+  if (countStats()) {
+    setStatsDelta(partId, fence, std::move(delta));
+  }
   return encodeBatchValue(batchHolder->getBatch());
 }
 
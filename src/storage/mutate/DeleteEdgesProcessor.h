@@ -40,6 +40,8 @@ class DeleteEdgesProcessor : public BaseProcessor<cpp2::ExecResponse> {
  private:
   GraphSpaceID spaceId_;
   std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> indexes_;
+  // Whether any edge type of the space has an adjacency order
+  bool hasAdjacencyOrder_{false};
 
  protected:
   // TOSS use this hook function to append some delete operation
@@ -54,13 +54,29 @@ void DeleteTagsProcessor::process(const cpp2::DeleteTagsRequest& req) {
       auto partId = part.first;
       const auto& delTags = part.second;
       keys.clear();
+      auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+      auto fence = statsFence(spaceId_, partId);
+      cpp2::PartStats delta;
       for (const auto& entry : delTags) {
         const auto& vId = entry.get_id().getStr();
+        if (countStats()) {
+          code = countTags(partId, vId, entry.get_tags(), delta);
+          if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+            break;
+          }
+        }
         for (const auto& tagId : entry.get_tags()) {
           auto key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vId, tagId);
           keys.emplace_back(std::move(key));
         }
       }
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleAsync(spaceId_, partId, code);
+        continue;
+      }
+      if (countStats()) {
+        setStatsDelta(partId, fence, std::move(delta));
+      }
       doRemove(spaceId_, partId, std::move(keys));
       stats::StatsManager::addValue(kNumTagsDeleted, keys.size());
     }
@@ -94,8 +110,16 @@ void DeleteTagsProcessor::process(const cpp2::DeleteTagsRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteTagsProcessor::deleteTags(
     PartitionID partId, const std::vector<cpp2::DelTags>& delTags, std::vector<VMLI>& lockedKeys) {
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  auto fence = statsFence(spaceId_, partId);
+  cpp2::PartStats delta;
   for (const auto& entry : delTags) {
     const auto& vId = entry.get_id().getStr();
+    if (countStats()) {
+      auto code = countTags(partId, vId, entry.get_tags(), delta);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+    }
     for (const auto& tagId : entry.get_tags()) {
       auto key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vId, tagId);
       auto tup = std::make_tuple(spaceId_, partId, tagId, vId);
@@ -152,8 +176,39 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteTagsProcessor::deleteTags(
       stats::StatsManager::addValue(kNumTagsDeleted);
     }
   }
+  if (countStats()) {
+    setStatsDelta(partId, fence, std::move(delta));
+  }
   return encodeBatchValue(batchHolder->getBatch());
 }
 
+nebula::cpp2::ErrorCode DeleteTagsProcessor::countTags(PartitionID partId,
+                                                       const VertexID& vId,
+                                                       const std::vector<TagID>& tags,
+                                                       cpp2::PartStats& delta) {
+  auto prefix = NebulaKeyUtils::tagPrefix(spaceVidLen_, partId, vId);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code = env_->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  size_t removed = 0;
+  size_t remained = 0;
+  for (; iter->valid(); iter->next()) {
+    auto tagId = NebulaKeyUtils::getTagId(spaceVidLen_, iter->key());
+    if (std::find(tags.begin(), tags.end(), tagId) != tags.end()) {
+      (*delta.tag_vertices_ref())[tagId] -= 1;
+      removed++;
+    } else {
+      remained++;
+    }
+  }
+  // The vertex is gone with its last tag unless it is counted by the vertex key
+  if (!FLAGS_use_vertex_key && removed > 0 && remained == 0) {
+    *delta.space_vertices_ref() -= 1;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace storage
 }  // namespace nebula
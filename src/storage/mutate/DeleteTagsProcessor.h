@@ -32,6 +32,12 @@ class DeleteTagsProcessor : public BaseProcessor<cpp2::ExecResponse> {
   ErrorOr<nebula::cpp2::ErrorCode, std::string> deleteTags(
       PartitionID partId, const std::vector<cpp2::DelTags>& delTags, std::vector<VMLI>& lockKeys);
 
+  // Count the existing tags of the vertex to be deleted in the changes of the space stats
+  nebula::cpp2::ErrorCode countTags(PartitionID partId,
+                                    const VertexID& vId,
+                                    const std::vector<TagID>& tags,
+                                    cpp2::PartStats& delta);
+
  private:
   GraphSpaceID spaceId_;
   std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> indexes_;
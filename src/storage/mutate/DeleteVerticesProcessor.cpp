@@ -55,6 +55,8 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
       const auto& vertexIds = part.second;
       keys.clear();
       auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
+      auto fence = statsFence(spaceId_, partId);
+      cpp2::PartStats delta;
       for (auto& vid : vertexIds) {
         if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vid.getStr())) {
           LOG(ERROR) << "Space " << spaceId_ << ", vertex length invalid, "
@@ -62,6 +64,12 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
           code = nebula::cpp2::ErrorCode::E_INVALID_VID;
           break;
         }
+        if (countStats()) {
+          code = countVertex(partId, vid.getStr(), delta);
+          if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+            break;
+          }
+        }
         keys.emplace_back(NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vid.getStr()));
         auto prefix = NebulaKeyUtils::tagPrefix(spaceVidLen_, partId, vid.getStr());
         std::unique_ptr<kvstore::KVIterator> iter;
@@ -72,6 +80,9 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
         }
         while (iter->valid()) {
           auto key = iter->key();
+          if (countStats()) {
+            (*delta.tag_vertices_ref())[NebulaKeyUtils::getTagId(spaceVidLen_, key)] -= 1;
+          }
           keys.emplace_back(key.str());
           iter->next();
         }
@@ -80,6 +91,9 @@ void DeleteVerticesProcessor::process(const cpp2::DeleteVerticesRequest& req) {
         handleAsync(spaceId_, partId, code);
         continue;
       }
+      if (countStats()) {
+        setStatsDelta(partId, fence, std::move(delta));
+      }
       doRemove(spaceId_, partId, std::move(keys));
       stats::StatsManager::addValue(kNumVerticesDeleted, keys.size());
     }
@@ -113,6 +127,8 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteVerticesProcessor::deleteVer
     PartitionID partId, const std::vector<Value>& vertices, std::vector<VMLI>& target) {
   target.reserve(vertices.size());
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  auto fence = statsFence(spaceId_, partId);
+  cpp2::PartStats delta;
   for (auto& vertex : vertices) {
     if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vertex.getStr())) {
       LOG(ERROR) << "Space " << spaceId_ << ", vertex length invalid, "
@@ -120,6 +136,12 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteVerticesProcessor::deleteVer
       auto code = nebula::cpp2::ErrorCode::E_INVALID_VID;
       return code;
     }
+    if (countStats()) {
+      auto code = countVertex(partId, vertex.getStr(), delta);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
+    }
     batchHolder->remove(NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vertex.getStr()));
     auto prefix = NebulaKeyUtils::tagPrefix(spaceVidLen_, partId, vertex.getStr());
     std::unique_ptr<kvstore::KVIterator> iter;
@@ -181,12 +203,31 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteVerticesProcessor::deleteVer
       }
       batchHolder->remove(key.str());
       stats::StatsManager::addValue(kNumVerticesDeleted);
+      if (countStats()) {
+        (*delta.tag_vertices_ref())[tagId] -= 1;
+      }
       iter->next();
     }
   }
 
+  if (countStats()) {
+    setStatsDelta(partId, fence, std::move(delta));
+  }
   return encodeBatchValue(batchHolder->getBatch());
 }
 
+nebula::cpp2::ErrorCode DeleteVerticesProcessor::countVertex(PartitionID partId,
+                                                             const VertexID& vId,
+                                                             cpp2::PartStats& delta) {
+  auto exists = vertexExists(spaceId_, partId, vId);
+  if (!nebula::ok(exists)) {
+    return nebula::error(exists);
+  }
+  if (nebula::value(exists)) {
+    *delta.space_vertices_ref() -= 1;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace storage
 }  // namespace nebula
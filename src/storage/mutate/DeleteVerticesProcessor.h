@@ -33,6 +33,11 @@ class DeleteVerticesProcessor : public BaseProcessor<cpp2::ExecResponse> {
                                                                const std::vector<Value>& vertices,
                                                                std::vector<VMLI>& target);
 
+  // Count the vertex to be deleted in the changes of the space stats
+  nebula::cpp2::ErrorCode countVertex(PartitionID partId,
+                                      const VertexID& vId,
+                                      cpp2::PartStats& delta);
+
  private:
   GraphSpaceID spaceId_;
   std::vector<std::shared_ptr<nebula::meta::cpp2::IndexItem>> indexes_;
@@ -58,12 +58,13 @@ void GetDstBySrcProcessor::doProcess(const cpp2::GetDstBySrcRequest& req) {
     onFinished();
     return;
   }
-
-  if (!FLAGS_query_concurrently) {
-    runInSingleThread(req);
-  } else {
-    runInMultipleThread(req);
-  }
+  withReadIndex(req, [this](const cpp2::GetDstBySrcRequest& r) {
+    if (!FLAGS_query_concurrently) {
+      runInSingleThread(r);
+    } else {
+      runInMultipleThread(r);
+    }
+  });
 }
 
 void GetDstBySrcProcessor::runInSingleThread(const cpp2::GetDstBySrcRequest& req) {
@@ -73,6 +74,11 @@ void GetDstBySrcProcessor::runInSingleThread(const cpp2::GetDstBySrcRequest& req
   std::unordered_set<PartitionID> failedParts;
   for (const auto& partEntry : req.get_parts()) {
     auto partId = partEntry.first;
+    auto code = readIndexCode(partId);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      handleErrorCode(code, spaceId_, partId);
+      continue;
+    }
     for (const auto& src : partEntry.second) {
       auto vId = src.getStr();
 
@@ -168,6 +174,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetDstBySrcProces
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
                       }
+                      auto code = readIndexCode(partId);
+                      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+                        return std::make_pair(code, partId);
+                      }
                       auto plan = buildPlan(context, result);
                       for (const auto& src : input) {
                         auto& vId = src.getStr();
@@ -54,7 +54,10 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
     onFinished();
     return;
   }
+  withReadIndex(req, [this](const cpp2::GetNeighborsRequest& r) { runQuery(r); });
+}
 
+void GetNeighborsProcessor::runQuery(const cpp2::GetNeighborsRequest& req) {
   int64_t limit = FLAGS_max_edge_returned_per_vertex;
   bool random = false;
   if ((*req.traverse_spec_ref()).limit_ref().has_value()) {
@@ -66,11 +69,12 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
     }
   }
 
-  // todo(doodle): specify by each query
-  if (!FLAGS_query_concurrently) {
+  // The limit is of each vertex, so the vertices of a part could be split into morsels
+  auto morsels = MorselScheduler::schedule(req.get_parts(), executor_);
+  if (morsels.empty()) {
     runInSingleThread(req, limit, random);
   } else {
-    runInMultipleThread(req, limit, random);
+    runInMultipleThread(req, morsels, limit, random);
   }
 }
 
@@ -85,6 +89,11 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
   for (const auto& partEntry : req.get_parts()) {
     contexts_.front().resultStat_ = ResultStatus::NORMAL;
     auto partId = partEntry.first;
+    auto code = readIndexCode(partId);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      handleErrorCode(code, spaceId_, partId);
+      continue;
+    }
     for (const auto& vid : partEntry.second) {
       auto vId = vid.getStr();
 
@@ -114,21 +123,23 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
 }
 
 void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest& req,
+                                                const std::vector<Morsel>& morsels,
                                                 int64_t limit,
                                                 bool random) {
   memory::MemoryCheckOffGuard offGuard;
-  for (size_t i = 0; i < req.get_parts().size(); i++) {
+  for (size_t i = 0; i < morsels.size(); i++) {
     nebula::DataSet result = resultDataSet_;
     results_.emplace_back(std::move(result));
     contexts_.emplace_back(RuntimeContext(planContext_.get()));
     expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
   }
-  size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
-  for (const auto& [partId, vids] : req.get_parts()) {
-    futures.emplace_back(
-        runInExecutor(&contexts_[i], &expCtxs_[i], &results_[i], partId, vids, limit, random));
-    i++;
+  for (size_t i = 0; i < morsels.size(); i++) {
+    const auto& morsel = morsels[i];
+    const auto& vids = req.get_parts().at(morsel.partId);
+    std::vector<nebula::Value> input(vids.begin() + morsel.begin, vids.begin() + morsel.end);
+    futures.emplace_back(runInExecutor(
+        &contexts_[i], &expCtxs_[i], &results_[i], morsel.partId, std::move(input), limit, random));
   }
 
   folly::collectAll(futures)
@@ -137,20 +148,28 @@ void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest&
         memory::MemoryCheckGuard guard;
         CHECK(!t.hasException());
         const auto& tries = t.value();
-        size_t sum = 0;
+        // The results of a part are dropped if any morsel of it failed
+        std::unordered_set<PartitionID> failedParts;
         for (size_t j = 0; j < tries.size(); j++) {
           if (tries[j].hasException()) {
             onError();
             return;
           }
+          const auto& [code, partId] = tries[j].value();
+          if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+              failedParts.find(partId) == failedParts.end()) {
+            failedParts.emplace(partId);
+            handleErrorCode(code, spaceId_, partId);
+          }
+        }
+        size_t sum = 0;
+        for (size_t j = 0; j < tries.size(); j++) {
           sum += results_[j].size();
         }
         resultDataSet_.rows.reserve(sum);
+        // Merge in the order of morsels, which is the same as running in a single thread
         for (size_t j = 0; j < tries.size(); j++) {
-          const auto& [code, partId] = tries[j].value();
-          if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-            handleErrorCode(code, spaceId_, partId);
-          } else {
+          if (failedParts.find(tries[j].value().second) == failedParts.end()) {
             resultDataSet_.append(std::move(results_[j]));
           }
         }
@@ -168,7 +187,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
     StorageExpressionContext* expCtx,
     nebula::DataSet* result,
     PartitionID partId,
-    const std::vector<nebula::Value>& vids,
+    std::vector<nebula::Value> vids,
     int64_t limit,
     bool random) {
   return folly::via(
@@ -178,6 +197,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                if (memoryExceeded_) {
                  return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED, partId);
                }
+               auto code = readIndexCode(partId);
+               if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+                 return std::make_pair(code, partId);
+               }
                auto plan = buildPlan(context, expCtx, result, limit, random);
                for (const auto& vid : input) {
                  auto vId = vid.getStr();
@@ -332,6 +355,10 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::checkAndBuildContexts(
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     return code;
   }
+  code = buildAdjacencyOrder(req.get_traverse_spec());
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
   code = buildYields(req);
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     return code;
@@ -390,6 +417,35 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::buildEdgeContext(const cpp2::Trav
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+nebula::cpp2::ErrorCode GetNeighborsProcessor::buildAdjacencyOrder(const cpp2::TraverseSpec& req) {
+  if (!req.order_by_ref().has_value() || req.order_by_ref()->empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  // Only the edges of a single edge type could be sorted by its adjacency order column
+  const auto& orderBy = *req.order_by_ref();
+  if (orderBy.size() != 1 || edgeContext_.propContexts_.size() != 1 ||
+      req.random_ref().value_or(false)) {
+    VLOG(1) << "Order by is only supported on the adjacency order of a single edge type";
+    return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+  }
+  auto edgeType = edgeContext_.propContexts_.front().first;
+  auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
+  if (iter == edgeContext_.schemas_.end()) {
+    return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
+  }
+  const auto& schema = iter->second.back();
+  const auto* col = schema->getAdjacencyOrderCol();
+  bool desc = orderBy.front().get_direction() == cpp2::OrderDirection::DESCENDING;
+  if (col == nullptr || *col != orderBy.front().get_prop() ||
+      desc != schema->isAdjacencyOrderDesc()) {
+    VLOG(1) << "Order by " << orderBy.front().get_prop() << " mismatches the adjacency order of "
+            << "edge " << edgeType;
+    return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+  }
+  edgeContext_.adjacencyOrder_ = true;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 void GetNeighborsProcessor::buildTagColName(const std::vector<cpp2::VertexProp>& tagProps) {
   for (const auto& tagProp : tagProps) {
     auto tagId = tagProp.get_tag();
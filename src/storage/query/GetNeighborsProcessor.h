@@ -10,6 +10,7 @@
 
 #include "common/base/Base.h"
 #include "storage/exec/StoragePlan.h"
+#include "storage/query/MorselScheduler.h"
 #include "storage/query/QueryBaseProcessor.h"
 
 namespace nebula {
@@ -60,8 +61,13 @@ class GetNeighborsProcessor
  private:
   void doProcess(const cpp2::GetNeighborsRequest& req);
 
+  // Run the query once the contexts are built and the read index of each part returned
+  void runQuery(const cpp2::GetNeighborsRequest& req);
+
   nebula::cpp2::ErrorCode buildTagContext(const cpp2::TraverseSpec& req);
   nebula::cpp2::ErrorCode buildEdgeContext(const cpp2::TraverseSpec& req);
+  // The edges are returned in order only if they could be read from the adjacency index
+  nebula::cpp2::ErrorCode buildAdjacencyOrder(const cpp2::TraverseSpec& req);
 
   // build tag/edge col name in response when prop specified
   void buildTagColName(const std::vector<cpp2::VertexProp>& tagProps);
@@ -71,14 +77,17 @@ class GetNeighborsProcessor
   nebula::cpp2::ErrorCode handleEdgeStatProps(const std::vector<cpp2::StatProp>& statProps);
 
   void runInSingleThread(const cpp2::GetNeighborsRequest& req, int64_t limit, bool random);
-  void runInMultipleThread(const cpp2::GetNeighborsRequest& req, int64_t limit, bool random);
+  void runInMultipleThread(const cpp2::GetNeighborsRequest& req,
+                           const std::vector<Morsel>& morsels,
+                           int64_t limit,
+                           bool random);
 
   folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> runInExecutor(
       RuntimeContext* context,
       StorageExpressionContext* expCtx,
       nebula::DataSet* result,
       PartitionID partId,
-      const std::vector<nebula::Value>& vids,
+      std::vector<nebula::Value> vids,
       int64_t limit,
       bool random);
 
@@ -46,13 +46,14 @@ void GetPropProcessor::doProcess(const cpp2::GetPropRequest& req) {
     onFinished();
     return;
   }
-
-  // todo(doodle): specify by each query
-  if (!FLAGS_query_concurrently) {
-    runInSingleThread(req);
-  } else {
-    runInMultipleThread(req);
-  }
+  withReadIndex(req, [this](const cpp2::GetPropRequest& r) {
+    auto morsels = MorselScheduler::schedule(r.get_parts(), executor_);
+    if (morsels.empty()) {
+      runInSingleThread(r);
+    } else {
+      runInMultipleThread(r, morsels);
+    }
+  });
 }
 
 void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
@@ -63,6 +64,11 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
     auto plan = buildTagPlan(&contexts_.front(), &resultDataSet_);
     for (const auto& partEntry : req.get_parts()) {
       auto partId = partEntry.first;
+      auto code = readIndexCode(partId);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(code, spaceId_, partId);
+        continue;
+      }
       for (const auto& row : partEntry.second) {
         auto vId = row.values[0].getStr();
 
@@ -86,6 +92,11 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
     auto plan = buildEdgePlan(&contexts_.front(), &resultDataSet_);
     for (const auto& partEntry : req.get_parts()) {
       auto partId = partEntry.first;
+      auto code = readIndexCode(partId);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(code, spaceId_, partId);
+        continue;
+      }
       for (const auto& row : partEntry.second) {
         cpp2::EdgeKey edgeKey;
         edgeKey.src_ref() = row.values[0].getStr();
@@ -116,18 +127,21 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
   onFinished();
 }
 
-void GetPropProcessor::runInMultipleThread(const cpp2::GetPropRequest& req) {
+void GetPropProcessor::runInMultipleThread(const cpp2::GetPropRequest& req,
+                                           const std::vector<Morsel>& morsels) {
   memory::MemoryCheckOffGuard offGuard;
-  for (size_t i = 0; i < req.get_parts().size(); i++) {
+  for (size_t i = 0; i < morsels.size(); i++) {
     nebula::DataSet result = resultDataSet_;
     results_.emplace_back(std::move(result));
     contexts_.emplace_back(RuntimeContext(planContext_.get()));
   }
-  size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
-  for (const auto& [partId, rows] : req.get_parts()) {
-    futures.emplace_back(runInExecutor(&contexts_[i], &results_[i], partId, rows));
-    i++;
+  for (size_t i = 0; i < morsels.size(); i++) {
+    const auto& morsel = morsels[i];
+    const auto& rows = req.get_parts().at(morsel.partId);
+    std::vector<nebula::Row> input(rows.begin() + morsel.begin, rows.begin() + morsel.end);
+    futures.emplace_back(
+        runInExecutor(&contexts_[i], &results_[i], morsel.partId, std::move(input)));
   }
 
   folly::collectAll(futures)
@@ -136,23 +150,34 @@ void GetPropProcessor::runInMultipleThread(const cpp2::GetPropRequest& req) {
         memory::MemoryCheckGuard guard;
         CHECK(!t.hasException());
         const auto& tries = t.value();
-        size_t sum = 0;
+        // The results of a part are dropped if any morsel of it failed
+        std::unordered_set<PartitionID> failedParts;
         for (size_t j = 0; j < tries.size(); j++) {
           if (tries[j].hasException()) {
             onError();
             return;
           }
+          const auto& [code, partId] = tries[j].value();
+          if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+              failedParts.find(partId) == failedParts.end()) {
+            failedParts.emplace(partId);
+            handleErrorCode(code, spaceId_, partId);
+          }
+        }
+        size_t sum = 0;
+        for (size_t j = 0; j < tries.size(); j++) {
           sum += results_[j].size();
         }
-        resultDataSet_.rows.reserve(sum);
+        resultDataSet_.rows.reserve(std::min(sum, limit_));
         for (size_t j = 0; j < tries.size(); j++) {
-          const auto& [code, partId] = tries[j].value();
-          if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-            handleErrorCode(code, spaceId_, partId);
-          } else {
+          if (failedParts.find(tries[j].value().second) == failedParts.end()) {
             resultDataSet_.append(std::move(results_[j]));
           }
         }
+        // Each morsel is limited by itself, the limit of the request is applied after merged
+        if (resultDataSet_.rows.size() > limit_) {
+          resultDataSet_.rows.resize(limit_);
+        }
         this->onProcessFinished();
         this->onFinished();
       })
@@ -166,7 +191,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
     RuntimeContext* context,
     nebula::DataSet* result,
     PartitionID partId,
-    const std::vector<nebula::Row>& rows) {
+    std::vector<nebula::Row> rows) {
   return folly::via(executor_,
                     [this, context, result, partId, input = std::move(rows)]() {
                       memory::MemoryCheckGuard guard;
@@ -174,6 +199,10 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                         return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED,
                                               partId);
                       }
+                      auto code = readIndexCode(partId);
+                      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+                        return std::make_pair(code, partId);
+                      }
                       if (!isEdge_) {
                         auto plan = buildTagPlan(context, result);
                         for (const auto& row : input) {
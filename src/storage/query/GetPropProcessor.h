@@ -8,6 +8,7 @@
 
 #include "common/base/Base.h"
 #include "storage/exec/StoragePlan.h"
+#include "storage/query/MorselScheduler.h"
 #include "storage/query/QueryBaseProcessor.h"
 
 namespace nebula {
@@ -73,13 +74,13 @@ class GetPropProcessor : public QueryBaseProcessor<cpp2::GetPropRequest, cpp2::G
   void buildEdgeColName(const std::vector<cpp2::EdgeProp>& edgeProps);
 
   void runInSingleThread(const cpp2::GetPropRequest& req);
-  void runInMultipleThread(const cpp2::GetPropRequest& req);
+  void runInMultipleThread(const cpp2::GetPropRequest& req, const std::vector<Morsel>& morsels);
 
   folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> runInExecutor(
       RuntimeContext* context,
       nebula::DataSet* result,
       PartitionID partId,
-      const std::vector<nebula::Row>& rows);
+      std::vector<nebula::Row> rows);
 
  private:
   std::vector<RuntimeContext> contexts_;
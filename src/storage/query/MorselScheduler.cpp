@@ -0,0 +1,61 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/query/MorselScheduler.h"
+
+#include <folly/executors/ThreadPoolExecutor.h>
+#include <thrift/lib/cpp/concurrency/ThreadManager.h>
+
+#include "storage/stats/StorageStats.h"
+
+namespace nebula {
+namespace storage {
+
+std::vector<Morsel> MorselScheduler::split(
+    const std::vector<std::pair<PartitionID, size_t>>& sizes, size_t parallelism) {
+  size_t total = 0;
+  for (const auto& size : sizes) {
+    total += size.second;
+  }
+  parallelism = std::max<size_t>(parallelism, 1);
+  auto target = std::max<size_t>((total + parallelism - 1) / parallelism, 1);
+  std::vector<Morsel> morsels;
+  morsels.reserve(parallelism + sizes.size());
+  for (const auto& [partId, size] : sizes) {
+    auto num = std::max<size_t>((size + target - 1) / target, 1);
+    for (size_t i = 0; i < num; i++) {
+      morsels.emplace_back(Morsel{partId, size * i / num, size * (i + 1) / num});
+    }
+  }
+  return morsels;
+}
+
+size_t MorselScheduler::parallelism(size_t maxParallelism, folly::Executor* executor) {
+  if (!FLAGS_query_adaptive_concurrency || executor == nullptr || maxParallelism <= 1) {
+    return 1;
+  }
+  return std::min(maxParallelism, idleThreads(executor) + 1);
+}
+
+void MorselScheduler::recordParallelism(size_t parallelism) {
+  stats::StatsManager::addValue(kQueryParallelism, parallelism);
+}
+
+size_t MorselScheduler::idleThreads(folly::Executor* executor) {
+  size_t idle = 0;
+  size_t pending = 0;
+  if (auto* pool = dynamic_cast<folly::ThreadPoolExecutor*>(executor)) {
+    auto stats = pool->getPoolStats();
+    idle = stats.idleThreadCount;
+    pending = stats.pendingTaskCount;
+  } else if (auto* pool = dynamic_cast<apache::thrift::concurrency::ThreadManager*>(executor)) {
+    idle = pool->idleWorkerCount();
+    pending = pool->pendingTaskCount();
+  }
+  return idle > pending ? idle - pending : 0;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,97 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_QUERY_MORSELSCHEDULER_H_
+#define STORAGE_QUERY_MORSELSCHEDULER_H_
+
+#include <folly/Executor.h>
+
+#include "common/base/Base.h"
+#include "common/thrift/ThriftTypes.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief The input in [begin, end) of a part, which is the unit of a read request run by one
+ * thread of the reader pool
+ */
+struct Morsel {
+  PartitionID partId;
+  size_t begin;
+  size_t end;
+};
+
+/**
+ * @brief Decide how many threads a read request runs on. Instead of one thread for each part, the
+ * input of the parts is split into morsels by its size and the idle threads of the reader pool, so
+ * that a request of a single big part is parallelized as well, and a request doesn't take the
+ * threads from others when the pool is busy.
+ */
+class MorselScheduler final {
+ public:
+  /**
+   * @brief Split the input of parts into morsels, and record the parallelism of the request.
+   *
+   * @tparam Parts Map from part id to the input of the part
+   * @param parts
+   * @param executor Reader pool which runs the morsels
+   * @return std::vector<Morsel> Morsels in the order of parts and input, empty if the request
+   * should be run in the calling thread
+   */
+  template <typename Parts>
+  static std::vector<Morsel> schedule(const Parts& parts, folly::Executor* executor) {
+    std::vector<std::pair<PartitionID, size_t>> sizes;
+    sizes.reserve(parts.size());
+    size_t total = 0;
+    for (const auto& part : parts) {
+      sizes.emplace_back(part.first, part.second.size());
+      total += part.second.size();
+    }
+    auto morselSize = static_cast<size_t>(std::max(FLAGS_query_morsel_size, 1));
+    auto num = parallelism((total + morselSize - 1) / morselSize, executor);
+    std::vector<Morsel> morsels;
+    if (num > 1 || (FLAGS_query_concurrently && executor != nullptr)) {
+      morsels = split(sizes, num);
+    }
+    recordParallelism(morsels.empty() ? 1 : morsels.size());
+    return morsels;
+  }
+
+  /**
+   * @brief Split the input of each part into morsels of about the same size, so that there are
+   * about "parallelism" morsels in total. Each part has one morsel at least.
+   *
+   * @param sizes Part id and the input size of each part
+   * @param parallelism
+   * @return std::vector<Morsel>
+   */
+  static std::vector<Morsel> split(const std::vector<std::pair<PartitionID, size_t>>& sizes,
+                                   size_t parallelism);
+
+  /**
+   * @brief Return how many threads could be used by a request, which is limited by the idle
+   * threads of the executor. The calling thread is always available.
+   *
+   * @param maxParallelism Max threads the request could use, e.g. the number of morsels
+   * @param executor
+   * @return size_t In [1, maxParallelism], 1 if the executor is nullptr
+   */
+  static size_t parallelism(size_t maxParallelism, folly::Executor* executor);
+
+  /**
+   * @brief Record the number of threads a request runs on in the stats
+   */
+  static void recordParallelism(size_t parallelism);
+
+ private:
+  // The threads of the executor which are idle and not waited by any pending task
+  static size_t idleThreads(folly::Executor* executor);
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_QUERY_MORSELSCHEDULER_H_
@@ -4,6 +4,7 @@
  */
 
 #include "common/expression/SubscriptExpression.h"
+#include "storage/StorageFlags.h"
 
 namespace nebula {
 namespace storage {
@@ -695,5 +696,69 @@ void QueryBaseProcessor<REQ, RESP>::profilePlan(const StoragePlan<IdType>& plan)
   }
 }
 
+/**
+ * @brief Request the read index of all parts when reading from follower, and run the query once
+ * all of them returned. Without read index, a follower may return the data which has been
+ * overwritten on leader. The request is copied only when the read index is needed, because the
+ * query then continues on the thread which fulfills the last read index.
+ *
+ * @tparam REQ Request type.
+ * @tparam RESP Response type.
+ * @param req Request, whose parts are all requested at once.
+ * @param run Run the query, the result of each part is got by readIndexCode.
+ */
+template <typename REQ, typename RESP>
+void QueryBaseProcessor<REQ, RESP>::withReadIndex(const REQ& req,
+                                                  std::function<void(const REQ&)>&& run) {
+  if (!FLAGS_follower_read_index || !planContext_->canReadFromFollower_) {
+    run(req);
+    return;
+  }
+  const auto& parts = req.get_parts();
+  std::vector<PartitionID> partIds;
+  std::vector<folly::Future<nebula::cpp2::ErrorCode>> futures;
+  partIds.reserve(parts.size());
+  futures.reserve(parts.size());
+  for (const auto& part : parts) {
+    auto promise = std::make_shared<folly::Promise<nebula::cpp2::ErrorCode>>();
+    partIds.emplace_back(part.first);
+    futures.emplace_back(promise->getFuture());
+    this->env_->kvstore_->asyncReadIndex(
+        spaceId_, part.first, [promise](nebula::cpp2::ErrorCode code) { promise->setValue(code); });
+  }
+  folly::Executor* executor = executor_;
+  if (executor == nullptr) {
+    executor = &folly::InlineExecutor::instance();
+  }
+  folly::collectAll(futures).via(executor).thenValue(
+      [this, req, partIds = std::move(partIds), run = std::move(run)](auto&& tries) {
+        for (size_t i = 0; i < tries.size(); i++) {
+          readIndexCodes_[partIds[i]] = tries[i].hasValue()
+                                            ? tries[i].value()
+                                            : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+        }
+        MemoryCheckScope wrapper(this, [&run, &req] { run(req); });
+      });
+}
+
+/**
+ * @brief Get the read index result of the part requested by withReadIndex. The codes are all
+ * filled before the query runs, so it could be called concurrently, e.g. by each morsel of the
+ * part.
+ *
+ * @tparam REQ Request type.
+ * @tparam RESP Response type.
+ * @param partId
+ * @return nebula::cpp2::ErrorCode SUCCEEDED if the part is ready to read.
+ */
+template <typename REQ, typename RESP>
+nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::readIndexCode(PartitionID partId) const {
+  auto iter = readIndexCodes_.find(partId);
+  if (iter == readIndexCodes_.end()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  return iter->second;
+}
+
 }  // namespace storage
 }  // namespace nebula
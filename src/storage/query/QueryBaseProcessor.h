@@ -6,6 +6,9 @@
 #ifndef STORAGE_QUERY_QUERYBASEPROCESSOR_H_
 #define STORAGE_QUERY_QUERYBASEPROCESSOR_H_
 
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
 #include "common/base/Base.h"
 #include "common/context/ExpressionContext.h"
 #include "common/expression/ArithmeticExpression.h"
@@ -142,6 +145,10 @@ struct EdgeContext {
   size_t offset_;
   size_t statCount_ = 0;
 
+  // scan the adjacency index instead of the edges, so the edges of each vertex are iterated in
+  // the adjacency order of the edge type
+  bool adjacencyOrder_ = false;
+
   // additional operator for eventually-consistent edges
   std::vector<std::pair<std::string, std::string>> kvAppend;
   std::vector<std::string> kvErased;
@@ -206,6 +213,13 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   template <typename IdType>
   void profilePlan(const StoragePlan<IdType>& plan);
 
+  // When reading from follower, request the read index of each part at once, and run the query
+  // once all of them returned, so the follower reads are linearizable without blocking a thread
+  void withReadIndex(const REQ& req, std::function<void(const REQ&)>&& run);
+
+  // Whether the part is ready to serve linearizable reads, could be called concurrently
+  nebula::cpp2::ErrorCode readIndexCode(PartitionID partId) const;
+
  protected:
   GraphSpaceID spaceId_;
   folly::Executor* executor_{nullptr};
@@ -219,6 +233,9 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   std::unordered_set<std::string> valueProps_;
 
   nebula::DataSet resultDataSet_;
+
+  // Result of read index of each part, filled before the query runs and read only after that
+  std::unordered_map<PartitionID, nebula::cpp2::ErrorCode> readIndexCodes_;
 };
 
 }  // namespace storage
@@ -13,6 +13,7 @@ stats::CounterId kNumVerticesInserted;
 stats::CounterId kNumEdgesDeleted;
 stats::CounterId kNumTagsDeleted;
 stats::CounterId kNumVerticesDeleted;
+stats::CounterId kQueryParallelism;
 
 void initStorageStats() {
   kNumEdgesInserted = stats::StatsManager::registerStats("num_edges_inserted", "rate, sum");
@@ -20,6 +21,8 @@ void initStorageStats() {
   kNumEdgesDeleted = stats::StatsManager::registerStats("num_edges_deleted", "rate, sum");
   kNumTagsDeleted = stats::StatsManager::registerStats("num_tags_deleted", "rate, sum");
   kNumVerticesDeleted = stats::StatsManager::registerStats("num_vertices_deleted", "rate, sum");
+  kQueryParallelism =
+      stats::StatsManager::registerHisto("query_parallelism", 1, 0, 128, "avg, p95, p99");
 
 #ifndef BUILD_STANDALONE
   initMetaClientStats();
@@ -15,6 +15,8 @@ extern stats::CounterId kNumVerticesInserted;
 extern stats::CounterId kNumEdgesDeleted;
 extern stats::CounterId kNumTagsDeleted;
 extern stats::CounterId kNumVerticesDeleted;
+// Number of threads each read request runs on
+extern stats::CounterId kQueryParallelism;
 
 /**
  * @brief Init storage statistic points for storage/meta client/kv
@@ -0,0 +1,295 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "mock/AdHocSchemaManager.h"
+#include "mock/MockCluster.h"
+#include "storage/mutate/AddEdgesProcessor.h"
+#include "storage/mutate/DeleteEdgesProcessor.h"
+#include "storage/mutate/UpdateEdgeProcessor.h"
+#include "storage/query/GetNeighborsProcessor.h"
+#include "storage/test/QueryTestUtils.h"
+
+namespace nebula {
+namespace storage {
+
+ObjectPool objPool;
+auto pool = &objPool;
+
+constexpr GraphSpaceID kSpace = 1;
+// The adjacency list of edge rate is ordered by score in descending order
+constexpr EdgeType kRate = 103;
+
+struct RateEdge {
+  VertexID src;
+  EdgeType type;
+  VertexID dst;
+  int64_t score;
+};
+
+void mockRateEdgeSchema(StorageEnv* env) {
+  auto* schemaMan = dynamic_cast<mock::AdHocSchemaManager*>(env->schemaMan_);
+  ASSERT_NE(nullptr, schemaMan);
+  auto schema = std::make_shared<meta::NebulaSchemaProvider>(0);
+  schema->addField("score", nebula::cpp2::PropertyType::INT64, 0, true);
+  meta::cpp2::SchemaProp prop;
+  prop.adjacency_order_col_ref() = "score";
+  prop.adjacency_order_desc_ref() = true;
+  schema->setProp(std::move(prop));
+  schemaMan->addEdgeSchema(kSpace, kRate, std::move(schema));
+}
+
+PartitionID partOf(int32_t totalParts, const VertexID& vId) {
+  return std::hash<std::string>()(vId) % totalParts + 1;
+}
+
+cpp2::EdgeKey edgeKeyOf(const RateEdge& edge) {
+  cpp2::EdgeKey key;
+  key.src_ref() = edge.src;
+  key.edge_type_ref() = edge.type;
+  key.ranking_ref() = 0;
+  key.dst_ref() = edge.dst;
+  return key;
+}
+
+void addRateEdges(StorageEnv* env, int32_t totalParts, const std::vector<RateEdge>& edges) {
+  cpp2::AddEdgesRequest req;
+  req.space_id_ref() = kSpace;
+  req.if_not_exists_ref() = false;
+  for (const auto& edge : edges) {
+    cpp2::NewEdge newEdge;
+    newEdge.key_ref() = edgeKeyOf(edge);
+    newEdge.props_ref() = std::vector<Value>{Value(edge.score)};
+    (*req.parts_ref())[partOf(totalParts, edge.src)].emplace_back(std::move(newEdge));
+  }
+  auto* processor = AddEdgesProcessor::instance(env, nullptr);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  EXPECT_EQ(0, resp.result.failed_parts.size());
+}
+
+// Returns the adjacency keys of the vertex in the order of key
+std::vector<std::string> readAdjacency(StorageEnv* env,
+                                       int32_t totalParts,
+                                       const VertexID& vId,
+                                       EdgeType type) {
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(kSpace).value();
+  auto partId = partOf(totalParts, vId);
+  auto prefix = NebulaKeyUtils::adjacencyPrefix(vIdLen, partId, vId, type);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  std::vector<std::string> keys;
+  auto code = env->kvstore_->prefix(kSpace, partId, prefix, &iter);
+  EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+  for (; iter != nullptr && iter->valid(); iter->next()) {
+    keys.emplace_back(iter->key().str());
+  }
+  return keys;
+}
+
+std::vector<std::string> expectedAdjacency(StorageEnv* env,
+                                           int32_t totalParts,
+                                           const std::vector<RateEdge>& edges) {
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(kSpace).value();
+  std::vector<std::string> keys;
+  for (const auto& edge : edges) {
+    keys.emplace_back(
+        NebulaKeyUtils::adjacencyKey(vIdLen,
+                                     partOf(totalParts, edge.src),
+                                     edge.src,
+                                     edge.type,
+                                     NebulaKeyUtils::encodeAdjacencyValue(Value(edge.score), true),
+                                     0,
+                                     edge.dst));
+  }
+  return keys;
+}
+
+TEST(AdjacencyIndexTest, AddTest) {
+  fs::TempDir rootPath("/tmp/AdjacencyIndexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  mockRateEdgeSchema(env);
+
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 1},
+                {"Tim Duncan", kRate, "Lakers", 3},
+                {"Tim Duncan", kRate, "Hawks", 2},
+                {"Spurs", -kRate, "Tim Duncan", 1}});
+  EXPECT_EQ(expectedAdjacency(env,
+                              totalParts,
+                              {{"Tim Duncan", kRate, "Lakers", 3},
+                               {"Tim Duncan", kRate, "Hawks", 2},
+                               {"Tim Duncan", kRate, "Spurs", 1}}),
+            readAdjacency(env, totalParts, "Tim Duncan", kRate));
+  EXPECT_EQ(expectedAdjacency(env, totalParts, {{"Spurs", -kRate, "Tim Duncan", 1}}),
+            readAdjacency(env, totalParts, "Spurs", -kRate));
+}
+
+TEST(AdjacencyIndexTest, OverwriteTest) {
+  fs::TempDir rootPath("/tmp/AdjacencyIndexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  mockRateEdgeSchema(env);
+
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 1},
+                {"Tim Duncan", kRate, "Lakers", 3},
+                {"Spurs", -kRate, "Tim Duncan", 1}});
+  // The key of the old score is replaced, the same score keeps the only key
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 5},
+                {"Tim Duncan", kRate, "Lakers", 3},
+                {"Spurs", -kRate, "Tim Duncan", 5}});
+  EXPECT_EQ(expectedAdjacency(env,
+                              totalParts,
+                              {{"Tim Duncan", kRate, "Spurs", 5},
+                               {"Tim Duncan", kRate, "Lakers", 3}}),
+            readAdjacency(env, totalParts, "Tim Duncan", kRate));
+  EXPECT_EQ(expectedAdjacency(env, totalParts, {{"Spurs", -kRate, "Tim Duncan", 5}}),
+            readAdjacency(env, totalParts, "Spurs", -kRate));
+}
+
+TEST(AdjacencyIndexTest, DeleteTest) {
+  fs::TempDir rootPath("/tmp/AdjacencyIndexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  mockRateEdgeSchema(env);
+
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 1},
+                {"Tim Duncan", kRate, "Lakers", 3},
+                {"Spurs", -kRate, "Tim Duncan", 1}});
+
+  cpp2::DeleteEdgesRequest req;
+  req.space_id_ref() = kSpace;
+  for (const auto& edge : std::vector<RateEdge>{{"Tim Duncan", kRate, "Spurs", 1},
+                                                {"Spurs", -kRate, "Tim Duncan", 1}}) {
+    (*req.parts_ref())[partOf(totalParts, edge.src)].emplace_back(edgeKeyOf(edge));
+  }
+  auto* processor = DeleteEdgesProcessor::instance(env, nullptr);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  EXPECT_EQ(0, resp.result.failed_parts.size());
+
+  EXPECT_EQ(expectedAdjacency(env, totalParts, {{"Tim Duncan", kRate, "Lakers", 3}}),
+            readAdjacency(env, totalParts, "Tim Duncan", kRate));
+  EXPECT_TRUE(readAdjacency(env, totalParts, "Spurs", -kRate).empty());
+}
+
+TEST(AdjacencyIndexTest, UpdateTest) {
+  fs::TempDir rootPath("/tmp/AdjacencyIndexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  mockRateEdgeSchema(env);
+
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 1}, {"Tim Duncan", kRate, "Lakers", 3}});
+
+  RateEdge edge{"Tim Duncan", kRate, "Spurs", 1};
+  cpp2::UpdateEdgeRequest req;
+  req.space_id_ref() = kSpace;
+  req.part_id_ref() = partOf(totalParts, edge.src);
+  req.edge_key_ref() = edgeKeyOf(edge);
+  cpp2::UpdatedProp prop;
+  prop.name_ref() = "score";
+  prop.value_ref() = Expression::encode(*ConstantExpression::make(pool, 10L));
+  req.updated_props_ref() = std::vector<cpp2::UpdatedProp>{std::move(prop)};
+  req.insertable_ref() = false;
+
+  auto* processor = UpdateEdgeProcessor::instance(env, nullptr);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  auto resp = std::move(fut).get();
+  EXPECT_EQ(0, (*resp.result_ref()).failed_parts.size());
+
+  EXPECT_EQ(expectedAdjacency(env,
+                              totalParts,
+                              {{"Tim Duncan", kRate, "Spurs", 10},
+                               {"Tim Duncan", kRate, "Lakers", 3}}),
+            readAdjacency(env, totalParts, "Tim Duncan", kRate));
+}
+
+TEST(AdjacencyIndexTest, GetNeighborsOrderTest) {
+  fs::TempDir rootPath("/tmp/AdjacencyIndexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+  mockRateEdgeSchema(env);
+
+  addRateEdges(env,
+               totalParts,
+               {{"Tim Duncan", kRate, "Spurs", 1},
+                {"Tim Duncan", kRate, "Lakers", 3},
+                {"Tim Duncan", kRate, "Hawks", 2},
+                {"Tim Duncan", kRate, "Bulls", 4}});
+  // Overwrite one edge, so its old adjacency key must not be read
+  addRateEdges(env, totalParts, {{"Tim Duncan", kRate, "Bulls", 0}});
+
+  auto buildRequest = [&](cpp2::OrderDirection direction) {
+    auto req = QueryTestUtils::buildRequest(
+        totalParts, {"Tim Duncan"}, {kRate}, {}, {{kRate, {"score", kDst}}});
+    cpp2::OrderBy orderBy;
+    orderBy.prop_ref() = "score";
+    orderBy.direction_ref() = direction;
+    (*req.traverse_spec_ref()).order_by_ref() = std::vector<cpp2::OrderBy>{std::move(orderBy)};
+    (*req.traverse_spec_ref()).limit_ref() = 3;
+    return req;
+  };
+  {
+    LOG(INFO) << "OrderByAdjacencyOrder";
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(buildRequest(cpp2::OrderDirection::DESCENDING));
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    ASSERT_EQ(1, (*resp.vertices_ref()).rows.size());
+    // vId, stat, rate, expr
+    ASSERT_EQ(4, (*resp.vertices_ref()).rows[0].values.size());
+    const auto& edges = (*resp.vertices_ref()).rows[0].values[2].getList().values;
+    std::vector<Value> expected = {List({3L, "Lakers"}), List({2L, "Hawks"}), List({1L, "Spurs"})};
+    EXPECT_EQ(expected, edges);
+  }
+  {
+    LOG(INFO) << "OrderByMismatch";
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(buildRequest(cpp2::OrderDirection::ASCENDING));
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(1, (*resp.result_ref()).failed_parts.size());
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_INVALID_PARM,
+              (*resp.result_ref()).failed_parts.front().get_code());
+  }
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -5,6 +5,9 @@
 
 #include <folly/Benchmark.h>
 #include <gtest/gtest.h>
+#if ENABLE_JEMALLOC
+#include <jemalloc/jemalloc.h>
+#endif
 
 #include "common/fs/TempDir.h"
 #include "storage/exec/EdgeNode.h"
@@ -303,6 +306,107 @@ void prefix(int32_t iters,
   }
 }
 
+#if ENABLE_JEMALLOC
+// Count the allocations of the benchmark thread. The thread is bound to an arena of its own, so the
+// allocations of the background threads are not counted.
+class AllocCounter {
+ public:
+  AllocCounter() {
+    unsigned arena;
+    size_t size = sizeof(arena);
+    CHECK_EQ(0, mallctl("arenas.create", &arena, &size, nullptr, 0));
+    CHECK_EQ(0, mallctl("thread.arena", nullptr, nullptr, &arena, sizeof(arena)));
+    small_ = folly::stringPrintf("stats.arenas.%u.small.nrequests", arena);
+    large_ = folly::stringPrintf("stats.arenas.%u.large.nrequests", arena);
+  }
+
+  uint64_t count() {
+    // merge the stats in tcache, and refresh the stats
+    CHECK_EQ(0, mallctl("thread.tcache.flush", nullptr, nullptr, nullptr, 0));
+    uint64_t epoch = 1;
+    size_t size = sizeof(epoch);
+    CHECK_EQ(0, mallctl("epoch", &epoch, &size, &epoch, size));
+    uint64_t small = 0, large = 0;
+    size = sizeof(uint64_t);
+    CHECK_EQ(0, mallctl(small_.c_str(), &small, &size, nullptr, 0));
+    CHECK_EQ(0, mallctl(large_.c_str(), &large, &size, nullptr, 0));
+    return small + large;
+  }
+
+ private:
+  std::string small_;
+  std::string large_;
+};
+#endif
+
+// Point read the tag of each vertex and decode the props, either copy the value out of kvstore or
+// decode it from the pinned block directly. The allocations per iteration are recorded in counters
+// when jemalloc is used.
+void tagGet(int32_t iters,
+            folly::UserCounters& counters,
+            const std::vector<nebula::VertexID>& vertex,
+            const std::vector<std::string>& playerProps,
+            bool pinned) {
+  nebula::GraphSpaceID spaceId = 1;
+  nebula::TagID player = 1;
+  std::hash<std::string> hash;
+  auto* env = gCluster->storageEnv_.get();
+  auto vIdLen = env->schemaMan_->getSpaceVidLen(spaceId).value();
+  auto totalParts = gCluster->getTotalParts();
+  auto tagSchemas = env->schemaMan_->getAllVerTagSchema(spaceId).value();
+  auto tagSchemaIter = tagSchemas.find(player);
+  CHECK(tagSchemaIter != tagSchemas.end());
+  auto* tagSchema = &(tagSchemaIter->second);
+
+  std::vector<std::pair<nebula::PartitionID, std::string>> keys;
+  BENCHMARK_SUSPEND {
+    for (const auto& vId : vertex) {
+      nebula::PartitionID partId = (hash(vId) % totalParts) + 1;
+      keys.emplace_back(partId, nebula::NebulaKeyUtils::tagKey(vIdLen, partId, vId, player));
+    }
+  }
+  nebula::RowReaderWrapper reader;
+  std::string value;
+  nebula::kvstore::PinnedValue pinnedValue;
+#if ENABLE_JEMALLOC
+  static AllocCounter allocCounter;
+  uint64_t allocs = 0;
+  BENCHMARK_SUSPEND {
+    allocs = allocCounter.count();
+  }
+#endif
+  for (decltype(iters) i = 0; i < iters; i++) {
+    for (const auto& [partId, key] : keys) {
+      folly::StringPiece val;
+      if (pinned) {
+        auto code = env->kvstore_->getPinned(spaceId, partId, key, &pinnedValue);
+        CHECK_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
+        val = nebula::kvstore::toStringPiece(pinnedValue);
+      } else {
+        std::string copied;
+        auto code = env->kvstore_->get(spaceId, partId, key, &copied);
+        CHECK_EQ(code, nebula::cpp2::ErrorCode::SUCCEEDED);
+        value = std::move(copied);
+        val = value;
+      }
+      reader.reset(*tagSchema, val);
+      CHECK_NOTNULL(reader);
+      for (const auto& prop : playerProps) {
+        auto v = reader->getValueByName(prop);
+        folly::doNotOptimizeAway(v);
+      }
+    }
+  }
+#if ENABLE_JEMALLOC
+  BENCHMARK_SUSPEND {
+    counters["allocs/iter"] =
+        static_cast<int64_t>((allocCounter.count() - allocs) / std::max<uint64_t>(iters, 1));
+  }
+#else
+  UNUSED(counters);
+#endif
+}
+
 void encodeBench(int32_t iters,
                  const std::vector<nebula::VertexID>& vertex,
                  const std::vector<std::string>& playerProps,
@@ -364,6 +468,41 @@ BENCHMARK_RELATIVE(OneVertexOnePropertyOnlyKV, iters) {
 
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_COUNTERS(TenVertexTagGet, counters, iters) {
+  tagGet(iters,
+         counters,
+         {"Tim Duncan",
+          "Kobe Bryant",
+          "Stephen Curry",
+          "Manu Ginobili",
+          "Joel Embiid",
+          "Giannis Antetokounmpo",
+          "Yao Ming",
+          "Damian Lillard",
+          "Dirk Nowitzki",
+          "Klay Thompson"},
+         {"name", "age", "avgScore"},
+         false);
+}
+BENCHMARK_COUNTERS_RELATIVE(TenVertexTagGetPinned, counters, iters) {
+  tagGet(iters,
+         counters,
+         {"Tim Duncan",
+          "Kobe Bryant",
+          "Stephen Curry",
+          "Manu Ginobili",
+          "Joel Embiid",
+          "Giannis Antetokounmpo",
+          "Yao Ming",
+          "Damian Lillard",
+          "Dirk Nowitzki",
+          "Klay Thompson"},
+         {"name", "age", "avgScore"},
+         true);
+}
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK(NoFilter, iters) {
   go(iters, {"Tim Duncan"}, {"name"}, {"teamName"});
 }
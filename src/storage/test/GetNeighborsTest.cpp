@@ -529,6 +529,69 @@ TEST(GetNeighborsTest, GoFromMultiVerticesTest) {
   FLAGS_query_concurrently = false;
 }
 
+TEST(GetNeighborsTest, MorselTest) {
+  {
+    LOG(INFO) << "Split";
+    // 3 vertices for each morsel: part 1 is split into 4 morsels, part 2 is small and part 3 is
+    // empty, which have one morsel each
+    auto morsels = MorselScheduler::split({{1, 10}, {2, 2}, {3, 0}}, 4);
+    std::vector<std::tuple<PartitionID, size_t, size_t>> actual;
+    for (const auto& morsel : morsels) {
+      actual.emplace_back(morsel.partId, morsel.begin, morsel.end);
+    }
+    std::vector<std::tuple<PartitionID, size_t, size_t>> expected = {
+        {1, 0, 2}, {1, 2, 5}, {1, 5, 7}, {1, 7, 10}, {2, 0, 2}, {3, 0, 0}};
+    EXPECT_EQ(expected, actual);
+
+    // one morsel for each part if no idle thread
+    EXPECT_EQ(3, MorselScheduler::split({{1, 10}, {2, 2}, {3, 0}}, 1).size());
+    EXPECT_EQ(1, MorselScheduler::parallelism(10, nullptr));
+  }
+
+  fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockEdgeData(env, totalParts));
+  auto threadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+
+  TagID player = 1;
+  EdgeType serve = 101;
+  {
+    LOG(INFO) << "OneOutEdgeMultiProperty";
+    // Each vertex is a morsel if there are idle threads, the result is the same in any case
+    FLAGS_query_morsel_size = 1;
+    std::vector<VertexID> vertices = {"Tim Duncan",
+                                      "Tony Parker",
+                                      "LaMarcus Aldridge",
+                                      "Rudy Gay",
+                                      "Marco Belinelli",
+                                      "Danny Green",
+                                      "Kyle Anderson",
+                                      "Aron Baynes",
+                                      "Boris Diaw",
+                                      "Tiago Splitter"};
+    std::vector<EdgeType> over = {serve};
+    std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+    std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+    tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+    edges.emplace_back(serve, std::vector<std::string>{"teamName", "startYear", "endYear"});
+    auto req = QueryTestUtils::buildRequest(totalParts, vertices, over, tags, edges);
+
+    auto* processor = GetNeighborsProcessor::instance(env, nullptr, threadPool.get());
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+
+    ASSERT_EQ(0, (*resp.result_ref()).failed_parts.size());
+    // vId, stat, player, serve, expr
+    QueryTestUtils::checkResponse(*resp.vertices_ref(), vertices, over, tags, edges, 10, 5);
+    FLAGS_query_morsel_size = 256;
+  }
+}
+
 TEST(GetNeighborsTest, StatTest) {
   fs::TempDir rootPath("/tmp/GetNeighborsTest.XXXXXX");
   mock::MockCluster cluster;
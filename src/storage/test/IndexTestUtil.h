@@ -125,7 +125,8 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
                                 const std::string& start,
                                 const std::string& end,
                                 std::unique_ptr<KVIterator>* iter,
-                                bool) override {
+                                bool,
+                                kvstore::ScanMode) override {
     CHECK_EQ(spaceId, spaceId_);
     std::unique_ptr<MockKVIterator> mockIter;
     mockIter = std::make_unique<MockKVIterator>(kv_, kv_.lower_bound(start));
@@ -139,8 +140,10 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
                                  const std::string& prefix,
                                  std::unique_ptr<KVIterator>* iter,
                                  bool canReadFromFollower = false,
-                                 const void* snapshot = nullptr) override {
+                                 const void* snapshot = nullptr,
+                                 kvstore::ScanMode mode = kvstore::ScanMode::kDefault) override {
     UNUSED(canReadFromFollower);
+    UNUSED(mode);
     UNUSED(spaceId);
     UNUSED(partId);
     UNUSED(snapshot);  // Pity that mock kv don't have snap.
@@ -162,12 +165,15 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
   }
 
   // Get all results with prefix starting from start
-  nebula::cpp2::ErrorCode rangeWithPrefix(GraphSpaceID spaceId,
-                                          PartitionID partId,
-                                          const std::string& start,
-                                          const std::string& prefix,
-                                          std::unique_ptr<KVIterator>* iter,
-                                          bool canReadFromFollower = false) override {
+  nebula::cpp2::ErrorCode rangeWithPrefix(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      const std::string& start,
+      const std::string& prefix,
+      std::unique_ptr<KVIterator>* iter,
+      bool canReadFromFollower = false,
+      kvstore::ScanMode mode = kvstore::ScanMode::kDefault) override {
+    UNUSED(mode);
     UNUSED(canReadFromFollower);
     UNUSED(spaceId);
     UNUSED(partId);
@@ -192,6 +198,9 @@ class MockKVStore : public ::nebula::kvstore::KVStore {
     LOG(FATAL) << "Unexpect";
     return ::nebula::cpp2::ErrorCode::SUCCEEDED;
   }
+  void asyncReadIndex(GraphSpaceID, PartitionID, ::nebula::kvstore::KVCallback cb) override {
+    cb(::nebula::cpp2::ErrorCode::SUCCEEDED);
+  }
 
   void asyncMultiPut(GraphSpaceID,
                      PartitionID,
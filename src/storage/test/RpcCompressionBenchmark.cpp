@@ -0,0 +1,138 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/io/Compression.h>
+#include <gtest/gtest.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include "common/fs/TempDir.h"
+#include "storage/query/GetNeighborsProcessor.h"
+#include "storage/test/QueryTestUtils.h"
+
+DEFINE_uint64(max_rank, 1000, "max rank of each edge");
+
+std::unique_ptr<nebula::mock::MockCluster> gCluster;
+nebula::storage::cpp2::GetNeighborsResponse gResponse;
+std::string gCompact;
+
+namespace nebula {
+namespace storage {
+
+void setUp(const char* path, EdgeRanking maxRank) {
+  gCluster = std::make_unique<nebula::mock::MockCluster>();
+  gCluster->initStorageKV(path);
+  auto* env = gCluster->storageEnv_.get();
+  auto totalParts = gCluster->getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+  ASSERT_EQ(true, QueryTestUtils::mockBenchEdgeData(env, totalParts, 1, maxRank));
+}
+
+// The response of going over serve from ten players, with the properties of both
+cpp2::GetNeighborsResponse getNeighbors() {
+  TagID player = 1;
+  EdgeType serve = 101;
+  std::vector<VertexID> vertices = {"Tim Duncan",
+                                    "Kobe Bryant",
+                                    "Stephen Curry",
+                                    "Manu Ginobili",
+                                    "Joel Embiid",
+                                    "Giannis Antetokounmpo",
+                                    "Yao Ming",
+                                    "Damian Lillard",
+                                    "Dirk Nowitzki",
+                                    "Klay Thompson"};
+  std::vector<std::pair<TagID, std::vector<std::string>>> tags;
+  std::vector<std::pair<EdgeType, std::vector<std::string>>> edges;
+  tags.emplace_back(player, std::vector<std::string>{"name", "age", "avgScore"});
+  edges.emplace_back(serve,
+                     std::vector<std::string>{"teamName", "startYear", "endYear", "teamCareer"});
+  auto totalParts = gCluster->getTotalParts();
+  auto req = QueryTestUtils::buildRequest(totalParts, vertices, {serve}, tags, edges);
+  auto* processor =
+      GetNeighborsProcessor::instance(gCluster->storageEnv_.get(), nullptr, nullptr);
+  auto fut = processor->getFuture();
+  processor->process(req);
+  return std::move(fut).get();
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+void compress(int32_t iters, folly::io::CodecType type) {
+  auto codec = folly::io::getCodec(type);
+  auto buf = folly::IOBuf::wrapBuffer(gCompact.data(), gCompact.size());
+  for (decltype(iters) i = 0; i < iters; i++) {
+    auto compressed = codec->compress(buf.get());
+    folly::doNotOptimizeAway(compressed);
+  }
+}
+
+void uncompress(int32_t iters, folly::io::CodecType type) {
+  std::unique_ptr<folly::io::Codec> codec;
+  std::unique_ptr<folly::IOBuf> compressed;
+  BENCHMARK_SUSPEND {
+    codec = folly::io::getCodec(type);
+    compressed = codec->compress(folly::IOBuf::wrapBuffer(gCompact.data(), gCompact.size()).get());
+  }
+  for (decltype(iters) i = 0; i < iters; i++) {
+    auto buf = codec->uncompress(compressed.get());
+    folly::doNotOptimizeAway(buf);
+  }
+}
+
+BENCHMARK(SerializeBinary, iters) {
+  for (decltype(iters) i = 0; i < iters; i++) {
+    auto val = apache::thrift::BinarySerializer::serialize<std::string>(gResponse);
+    folly::doNotOptimizeAway(val);
+  }
+}
+BENCHMARK_RELATIVE(SerializeCompact, iters) {
+  for (decltype(iters) i = 0; i < iters; i++) {
+    auto val = apache::thrift::CompactSerializer::serialize<std::string>(gResponse);
+    folly::doNotOptimizeAway(val);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(CompressZstd, iters) {
+  compress(iters, folly::io::CodecType::ZSTD);
+}
+BENCHMARK_RELATIVE(CompressZlib, iters) {
+  compress(iters, folly::io::CodecType::ZLIB);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(UncompressZstd, iters) {
+  uncompress(iters, folly::io::CodecType::ZSTD);
+}
+BENCHMARK_RELATIVE(UncompressZlib, iters) {
+  uncompress(iters, folly::io::CodecType::ZLIB);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+  nebula::fs::TempDir rootPath("/tmp/RpcCompressionBenchmark.XXXXXX");
+  nebula::storage::setUp(rootPath.path(), FLAGS_max_rank);
+  gResponse = nebula::storage::getNeighbors();
+  gCompact = apache::thrift::CompactSerializer::serialize<std::string>(gResponse);
+  auto binary = apache::thrift::BinarySerializer::serialize<std::string>(gResponse);
+  auto buf = folly::IOBuf::wrapBuffer(gCompact.data(), gCompact.size());
+  LOG(INFO) << "Binary: " << binary.size() << " bytes, compact: " << gCompact.size()
+            << " bytes, compact with zstd: "
+            << folly::io::getCodec(folly::io::CodecType::ZSTD)
+                   ->compress(buf.get())
+                   ->computeChainDataLength()
+            << " bytes, compact with zlib: "
+            << folly::io::getCodec(folly::io::CodecType::ZLIB)
+                   ->compress(buf.get())
+                   ->computeChainDataLength()
+            << " bytes";
+  folly::runBenchmarks();
+  gCluster.reset();
+  return 0;
+}
@@ -12,8 +12,12 @@
 #include "mock/MockData.h"
 #include "storage/admin/AdminTaskManager.h"
 #include "storage/admin/StatsTask.h"
+#include "storage/SpaceStatsManager.h"
+#include "storage/StorageFlags.h"
 #include "storage/mutate/AddEdgesProcessor.h"
 #include "storage/mutate/AddVerticesProcessor.h"
+#include "storage/mutate/DeleteEdgesProcessor.h"
+#include "storage/mutate/DeleteVerticesProcessor.h"
 #include "storage/test/TestUtils.h"
 
 namespace nebula {
@@ -390,6 +394,151 @@ TEST_F(StatsTaskTest, StatsTagAndEdgeData) {
   }
 }
 
+static nebula::meta::cpp2::StatsItem runStatsTask(StorageEnv* env,
+                                                  AdminTaskManager* manager,
+                                                  const std::vector<PartitionID>& parts) {
+  cpp2::TaskPara parameter;
+  parameter.space_id_ref() = 1;
+  parameter.parts_ref() = parts;
+
+  cpp2::AddTaskRequest request;
+  request.job_type_ref() = meta::cpp2::JobType::STATS;
+  request.job_id_ref() = ++gJobId;
+  request.task_id_ref() = 16;
+  request.para_ref() = std::move(parameter);
+
+  nebula::meta::cpp2::StatsItem statsItem;
+  auto callback = [&](nebula::cpp2::ErrorCode ret, nebula::meta::cpp2::StatsItem& result) {
+    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED &&
+        result.get_status() == nebula::meta::cpp2::JobStatus::FINISHED) {
+      statsItem = std::move(result);
+    }
+  };
+  TaskContext context(request, callback);
+  auto task = std::make_shared<StatsTask>(env, std::move(context));
+  manager->addAsyncTask(task);
+  do {
+    usleep(50);
+  } while (!manager->isFinished(context.jobId_, context.taskId_));
+  for (int i = 0; i < 50; i++) {
+    if (statsItem.get_status() == nebula::meta::cpp2::JobStatus::FINISHED) {
+      break;
+    }
+    sleep(1);
+  }
+  return statsItem;
+}
+
+// The counters maintained by the writes are the same as the ones scanned
+TEST_F(StatsTaskTest, StatsByCounters) {
+  std::vector<PartitionID> parts = {1, 2, 3, 4, 5, 6};
+  SpaceStatsManager spaceStats;
+  ASSERT_TRUE(spaceStats.init(env_->kvstore_));
+  env_->spaceStats_ = &spaceStats;
+
+  auto expectSame = [](const nebula::meta::cpp2::StatsItem& lhs,
+                       const nebula::meta::cpp2::StatsItem& rhs) {
+    ASSERT_EQ(nebula::meta::cpp2::JobStatus::FINISHED, lhs.get_status());
+    ASSERT_EQ(nebula::meta::cpp2::JobStatus::FINISHED, rhs.get_status());
+    EXPECT_EQ(*lhs.space_vertices_ref(), *rhs.space_vertices_ref());
+    EXPECT_EQ(*lhs.space_edges_ref(), *rhs.space_edges_ref());
+    EXPECT_EQ(*lhs.tag_vertices_ref(), *rhs.tag_vertices_ref());
+    EXPECT_EQ(*lhs.edges_ref(), *rhs.edges_ref());
+  };
+  auto byCountersThenScan = [&]() {
+    auto byCounters = runStatsTask(env_, manager_, parts);
+    auto interval = FLAGS_stats_reconcile_interval_secs;
+    FLAGS_stats_reconcile_interval_secs = 0;
+    auto byScan = runStatsTask(env_, manager_, parts);
+    FLAGS_stats_reconcile_interval_secs = interval;
+    expectSame(byCounters, byScan);
+  };
+
+  // The counters are reconciled by the first scan
+  auto scanned = runStatsTask(env_, manager_, parts);
+  ASSERT_EQ(nebula::meta::cpp2::JobStatus::FINISHED, scanned.get_status());
+  EXPECT_EQ(81, *scanned.space_vertices_ref());
+  EXPECT_EQ(167, *scanned.space_edges_ref());
+  expectSame(scanned, runStatsTask(env_, manager_, parts));
+
+  // Delete vertices and edges
+  {
+    auto* processor = DeleteVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockDeleteVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, resp.result.failed_parts.size());
+  }
+  {
+    auto* processor = DeleteEdgesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockDeleteEdgesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, resp.result.failed_parts.size());
+  }
+  byCountersThenScan();
+
+  // Add them back, the changes are persisted by flush
+  {
+    auto* processor = AddVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, resp.result.failed_parts.size());
+  }
+  {
+    auto* processor = AddEdgesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddEdgesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    EXPECT_EQ(0, resp.result.failed_parts.size());
+  }
+  spaceStats.flush();
+  byCountersThenScan();
+
+  env_->spaceStats_ = nullptr;
+  spaceStats.stop();
+}
+
+// The changes computed before the part is reconciled or by a follower are dropped
+TEST_F(StatsTaskTest, StaleChangesDropped) {
+  GraphSpaceID spaceId = 1;
+  PartitionID partId = 1;
+  SpaceStatsManager spaceStats;
+  ASSERT_TRUE(spaceStats.init(env_->kvstore_));
+  env_->spaceStats_ = &spaceStats;
+
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, StatsTask::reconcile(env_, spaceId, partId));
+  auto ret = spaceStats.get(spaceId, partId);
+  ASSERT_TRUE(nebula::ok(ret));
+  auto reconciled = nebula::value(ret);
+  ASSERT_TRUE(spaceStats.isReconciled(spaceId, partId, reconciled));
+
+  cpp2::PartStats delta;
+  delta.space_edges_ref() = 1;
+  auto stale = spaceStats.fence(spaceId, partId);
+  ASSERT_GE(stale.term, 0);
+  ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, StatsTask::reconcile(env_, spaceId, partId));
+  spaceStats.add(spaceId, partId, stale, delta);
+  SpaceStatsManager::Fence follower;
+  spaceStats.add(spaceId, partId, follower, delta);
+  ret = spaceStats.get(spaceId, partId);
+  ASSERT_TRUE(nebula::ok(ret));
+  EXPECT_EQ(*reconciled.space_edges_ref(), *nebula::value(ret).space_edges_ref());
+
+  spaceStats.add(spaceId, partId, spaceStats.fence(spaceId, partId), delta);
+  ret = spaceStats.get(spaceId, partId);
+  ASSERT_TRUE(nebula::ok(ret));
+  EXPECT_EQ(*reconciled.space_edges_ref() + 1, *nebula::value(ret).space_edges_ref());
+
+  env_->spaceStats_ = nullptr;
+  spaceStats.stop();
+}
+
 }  // namespace storage
 }  // namespace nebula
 
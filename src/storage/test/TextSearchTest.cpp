@@ -0,0 +1,224 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "common/plugin/fulltext/builtin/TextIndex.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "mock/AdHocSchemaManager.h"
+#include "mock/MockCluster.h"
+#include "mock/MockData.h"
+#include "storage/index/TextIndexCommitHook.h"
+#include "storage/admin/RebuildFTIndexTask.h"
+#include "storage/index/TextSearchProcessor.h"
+#include "storage/mutate/AddVerticesProcessor.h"
+#include "storage/mutate/DeleteVerticesProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+class TextSearchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    rootPath_ = std::make_unique<fs::TempDir>("/tmp/TextSearchTest.XXXXXX");
+    cluster_.commitHookFactory_ = [](meta::SchemaManager* schemaMan) {
+      return std::make_shared<TextIndexCommitHook>(schemaMan);
+    };
+    cluster_.initStorageKV(rootPath_->path());
+    env_ = cluster_.storageEnv_.get();
+
+    meta::cpp2::FTIndex index;
+    index.space_id_ref() = 1;
+    nebula::cpp2::SchemaID schemaId;
+    schemaId.tag_id_ref() = 1;
+    index.depend_schema_ref() = std::move(schemaId);
+    index.fields_ref() = {"name"};
+    index.analyzer_ref() = plugin::kBuiltinAnalyzer;
+    schemaMan_ = dynamic_cast<mock::AdHocSchemaManager*>(env_->schemaMan_);
+    ASSERT_NE(nullptr, schemaMan_);
+    schemaMan_->addFTIndex("player_name", std::move(index));
+  }
+
+  // Define the indexes in meta in the parts and backfill them
+  void rebuild() {
+    cpp2::TaskPara para;
+    para.space_id_ref() = 1;
+    para.parts_ref() = {1, 2, 3, 4, 5, 6};
+    cpp2::AddTaskRequest req;
+    req.job_type_ref() = meta::cpp2::JobType::REBUILD_FULLTEXT_INDEX;
+    req.para_ref() = std::move(para);
+    RebuildFTIndexTask task(env_, TaskContext(req, [](nebula::cpp2::ErrorCode, auto&) {}));
+    auto ret = task.genSubTasks();
+    ASSERT_TRUE(nebula::ok(ret));
+    for (auto& subTask : nebula::value(ret)) {
+      ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, subTask.invoke());
+    }
+  }
+
+  // The posting and forward keys
+  void expectNoIndexKeys() {
+    for (PartitionID partId = 1; partId <= 6; partId++) {
+      for (auto kind : {plugin::TextIndexKeyUtils::kPosting, plugin::TextIndexKeyUtils::kForward}) {
+        std::unique_ptr<kvstore::KVIterator> iter;
+        auto prefix = plugin::TextIndexKeyUtils::kindPrefix(partId, kind);
+        auto code = env_->kvstore_->prefix(1, partId, prefix, &iter);
+        ASSERT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+        EXPECT_FALSE(iter->valid());
+      }
+    }
+  }
+
+  nebula::DataSet search(const std::string& query,
+                         int64_t limit = 0,
+                         nebula::cpp2::ErrorCode expected = nebula::cpp2::ErrorCode::SUCCEEDED) {
+    cpp2::TextSearchRequest req;
+    req.space_id_ref() = 1;
+    req.parts_ref() = {1, 2, 3, 4, 5, 6};
+    nebula::cpp2::SchemaID schemaId;
+    schemaId.tag_id_ref() = 1;
+    req.schema_id_ref() = std::move(schemaId);
+    req.index_name_ref() = "player_name";
+    req.query_ref() = query;
+    req.limit_ref() = limit;
+
+    auto* processor = TextSearchProcessor::instance(env_, nullptr);
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    if (expected == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      EXPECT_EQ(0, resp.result.failed_parts.size());
+    } else {
+      EXPECT_EQ(6, resp.result.failed_parts.size());
+      for (const auto& part : resp.result.failed_parts) {
+        EXPECT_EQ(expected, part.code);
+      }
+    }
+    return resp.data_ref().has_value() ? *resp.data_ref() : nebula::DataSet();
+  }
+
+  static std::set<std::string> vids(const nebula::DataSet& data) {
+    std::set<std::string> result;
+    for (const auto& row : data.rows) {
+      result.emplace(row.values[0].getStr());
+    }
+    return result;
+  }
+
+  std::unique_ptr<fs::TempDir> rootPath_;
+  mock::MockCluster cluster_;
+  StorageEnv* env_{nullptr};
+  mock::AdHocSchemaManager* schemaMan_{nullptr};
+};
+
+TEST_F(TextSearchTest, SearchTest) {
+  {
+    auto* processor = AddVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+  }
+  {
+    // The index in meta is not maintained until it is defined in the parts by the rebuild, which
+    // backfills the existing vertices. It is not searched before that.
+    EXPECT_TRUE(search("tim", 0, nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND).rows.empty());
+    rebuild();
+  }
+  {
+    auto result = search("tim");
+    std::vector<std::string> expected = {kVid, "_score"};
+    EXPECT_EQ(expected, result.colNames);
+    EXPECT_EQ(std::set<std::string>({"Tim Duncan"}), vids(result));
+    EXPECT_EQ(1.0, result.rows[0].values[1].getFloat());
+  }
+  {
+    // Case insensitive
+    auto result = search("TONY PARKER");
+    EXPECT_EQ(std::set<std::string>({"Tony Parker"}), vids(result));
+    EXPECT_EQ(2.0, result.rows[0].values[1].getFloat());
+  }
+  {
+    auto result = search("\"tony parker\"");
+    EXPECT_EQ(std::set<std::string>({"Tony Parker"}), vids(result));
+    result = search("\"parker tony\"");
+    EXPECT_TRUE(result.rows.empty());
+  }
+  {
+    auto result = search("gasol");
+    EXPECT_EQ(std::set<std::string>({"Pau Gasol", "Marc Gasol"}), vids(result));
+    result = search("gasol", 1);
+    EXPECT_EQ(1, result.rows.size());
+  }
+  {
+    auto result = search("dun*");
+    EXPECT_EQ(std::set<std::string>({"Tim Duncan"}), vids(result));
+    result = search("tim parker");
+    EXPECT_TRUE(result.rows.empty());
+  }
+  {
+    // The postings are removed with the vertices
+    auto* processor = DeleteVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockDeleteVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+
+    EXPECT_TRUE(search("tim").rows.empty());
+    EXPECT_TRUE(search("\"tony parker\"").rows.empty());
+    expectNoIndexKeys();
+  }
+  {
+    // The vertices added after the rebuild are indexed when committed
+    auto* processor = AddVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+    EXPECT_EQ(std::set<std::string>({"Tim Duncan"}), vids(search("tim")));
+  }
+}
+
+TEST_F(TextSearchTest, DropIndex) {
+  rebuild();
+  {
+    auto* processor = AddVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+  }
+  EXPECT_EQ(std::set<std::string>({"Tim Duncan"}), vids(search("tim")));
+
+  // The keys of the dropped index are removed by the rebuild, and no longer maintained
+  schemaMan_->removeFTIndex("player_name");
+  rebuild();
+  EXPECT_TRUE(search("tim", 0, nebula::cpp2::ErrorCode::E_INDEX_NOT_FOUND).rows.empty());
+  expectNoIndexKeys();
+  {
+    auto* processor = AddVerticesProcessor::instance(env_, nullptr);
+    auto req = mock::MockData::mockAddVerticesReq();
+    auto fut = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(fut).get();
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+  }
+  expectNoIndexKeys();
+}
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,107 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/base/Base.h"
+#include "tools/bulk-load/BulkLoader.h"
+
+void printHelp() {
+  fprintf(stderr,
+          R"(  ./bulk_load --space_name=<space name> --tag=<tag name> --input=<path>
+
+required:
+       --space_name=<space name>
+         A space name must be given.
+
+       --tag=<tag name> | --edge=<edge name>
+         The tag or edge the rows belong to, only one of them could be given.
+
+       --input=<path>
+         Path to the input file. A vertex row is the vid followed by the properties, an edge
+         row is the src, the dst, the rank if --with_rank is set, and the properties.
+
+optional:
+       --meta_server=<ip:port,...>
+         A list of meta severs' ip:port separated by comma.
+         Default: 127.0.0.1:45500
+
+       --format= csv | columnar
+         csv: one row each line, the fields could be quoted by '"'.
+         columnar: the binary columnar format, see ColumnarReader in BulkLoader.h.
+         Default: csv
+
+       --props=<list of property name>
+         The properties of each row separated by comma, the missing properties take their
+         default values.
+         Default: all properties of the latest schema, in the order of the schema
+
+       --delimiter=<char>
+         Delimiter of the csv fields.
+         Default: ,
+
+       --csv_header=<true|false>
+         Whether to skip the first line of csv.
+         Default: false
+
+       --with_rank=<true|false>
+         Whether the edge rows have the rank column.
+         Default: false
+
+       --skip_bad_rows=<true|false>
+         Skip the rows failed to parse or encode instead of stopping.
+         Default: false
+
+       --output=<path>
+         Directory of the sst files, the files of a part are put in <output>/<part id>/.
+         Default: ./sst
+
+       --max_buffer_mb=<N>
+         The key values are sorted and written once the buffered ones exceed N MB.
+         Default: 256
+
+The output directory could be copied to hdfs or a path visible to all storaged, and loaded by
+  SUBMIT JOB DOWNLOAD HDFS "hdfs://<host>:<port>/<path>" or "file:///<path>"
+  SUBMIT JOB INGEST
+
+)");
+}
+
+void printParams() {
+  std::cout << "===========================PARAMS============================\n";
+  std::cout << "meta server: " << FLAGS_meta_server << "\n";
+  std::cout << "space name: " << FLAGS_space_name << "\n";
+  std::cout << "tag: " << FLAGS_tag << "\n";
+  std::cout << "edge: " << FLAGS_edge << "\n";
+  std::cout << "props: " << FLAGS_props << "\n";
+  std::cout << "input: " << FLAGS_input << "\n";
+  std::cout << "format: " << FLAGS_format << "\n";
+  std::cout << "output: " << FLAGS_output << "\n";
+  std::cout << "===========================PARAMS============================\n\n";
+}
+
+int main(int argc, char *argv[]) {
+  if (argc == 1) {
+    printHelp();
+    return EXIT_FAILURE;
+  } else {
+    folly::init(&argc, &argv, true);
+  }
+
+  google::SetStderrLogging(google::FATAL);
+
+  printParams();
+
+  nebula::storage::BulkLoader loader;
+  auto status = loader.init();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  status = loader.run();
+  if (!status.ok()) {
+    std::cerr << "Error: " << status << "\n\n";
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
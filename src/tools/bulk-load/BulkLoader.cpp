@@ -0,0 +1,652 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "tools/bulk-load/BulkLoader.h"
+
+#include <folly/lang/Bits.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/base/MurmurHash2.h"
+#include "common/datatypes/Geography.h"
+#include "common/fs/FileUtils.h"
+#include "common/time/TimeUtils.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "storage/CommonUtils.h"
+
+DEFINE_string(space_name, "", "The space name.");
+DEFINE_string(meta_server, "127.0.0.1:45500", "Meta servers' address.");
+DEFINE_string(tag, "", "The tag to load, either tag or edge should be given.");
+DEFINE_string(edge, "", "The edge to load, either tag or edge should be given.");
+DEFINE_string(props, "", "The properties of each row separated by comma, all by default.");
+DEFINE_string(input, "", "Path to the input file.");
+DEFINE_string(format, "csv", "Format of the input file, csv | columnar");
+DEFINE_string(delimiter, ",", "Delimiter of the csv fields.");
+DEFINE_bool(csv_header, false, "Whether the first line of csv is the header.");
+DEFINE_bool(with_rank, false, "Whether the rank of edge follows the dst column.");
+DEFINE_bool(skip_bad_rows, false, "Skip the rows failed to encode instead of stopping.");
+DEFINE_string(output, "./sst", "Directory of the sst files, one sub directory per part.");
+DEFINE_int64(max_buffer_mb, 256, "Write sst files once the buffered key values exceed it.");
+
+namespace nebula {
+namespace storage {
+
+using nebula::cpp2::PropertyType;
+
+Status CsvReader::open(const std::string& path) {
+  file_.open(path);
+  if (!file_.is_open()) {
+    return Status::Error("Failed to open '%s'.", path.c_str());
+  }
+  if (header_) {
+    std::string line;
+    std::getline(file_, line);
+    lineNum_++;
+  }
+  return Status::OK();
+}
+
+StatusOr<bool> CsvReader::next(std::vector<Value>& row) {
+  std::string line;
+  do {
+    if (!std::getline(file_, line)) {
+      return false;
+    }
+    lineNum_++;
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+  } while (line.empty());
+
+  auto fields = split(line, delimiter_);
+  if (!fields.ok()) {
+    return fields.status();
+  }
+  if (fields.value().size() != types_.size()) {
+    return Status::Error(
+        "Expect %zu fields, but got %zu.", types_.size(), fields.value().size());
+  }
+  row.clear();
+  for (size_t i = 0; i < types_.size(); i++) {
+    auto value = toValue(fields.value()[i], types_[i]);
+    if (!value.ok()) {
+      return value.status();
+    }
+    row.emplace_back(std::move(value).value());
+  }
+  return true;
+}
+
+// static
+StatusOr<std::vector<std::string>> CsvReader::split(const std::string& line, char delimiter) {
+  std::vector<std::string> fields;
+  std::string field;
+  bool quoted = false;
+  for (size_t i = 0; i < line.size(); i++) {
+    auto c = line[i];
+    if (quoted) {
+      if (c != '"') {
+        field += c;
+      } else if (i + 1 < line.size() && line[i + 1] == '"') {
+        field += '"';
+        i++;
+      } else {
+        quoted = false;
+      }
+    } else if (c == '"') {
+      quoted = true;
+    } else if (c == delimiter) {
+      fields.emplace_back(std::move(field));
+      field.clear();
+    } else {
+      field += c;
+    }
+  }
+  if (quoted) {
+    return Status::Error("Unterminated quote.");
+  }
+  fields.emplace_back(std::move(field));
+  return fields;
+}
+
+// static
+StatusOr<Value> CsvReader::toValue(const std::string& field, PropertyType type) {
+  if (field.empty() && type != PropertyType::STRING && type != PropertyType::FIXED_STRING) {
+    return Value(NullType::__NULL__);
+  }
+  try {
+    switch (type) {
+      case PropertyType::BOOL: {
+        auto lower = field;
+        folly::toLowerAscii(lower);
+        if (lower == "true") {
+          return Value(true);
+        } else if (lower == "false") {
+          return Value(false);
+        }
+        return Status::Error("Bad bool `%s'.", field.c_str());
+      }
+      case PropertyType::INT8:
+      case PropertyType::INT16:
+      case PropertyType::INT32:
+      case PropertyType::INT64:
+      case PropertyType::TIMESTAMP:
+        return Value(folly::to<int64_t>(field));
+      case PropertyType::FLOAT:
+      case PropertyType::DOUBLE:
+        return Value(folly::to<double>(field));
+      case PropertyType::STRING:
+      case PropertyType::FIXED_STRING:
+        return Value(field);
+      case PropertyType::DATE: {
+        auto result = time::TimeUtils::parseDate(field);
+        if (!result.ok()) {
+          return result.status();
+        }
+        return Value(result.value());
+      }
+      case PropertyType::TIME: {
+        auto result = time::TimeUtils::parseTime(field);
+        if (!result.ok()) {
+          return result.status();
+        }
+        if (result.value().withTimeZone) {
+          return Value(result.value().t);
+        }
+        return Value(time::TimeUtils::timeToUTC(result.value().t));
+      }
+      case PropertyType::DATETIME: {
+        auto result = time::TimeUtils::parseDateTime(field);
+        if (!result.ok()) {
+          return result.status();
+        }
+        if (result.value().withTimeZone) {
+          return Value(result.value().dt);
+        }
+        return Value(time::TimeUtils::dateTimeToUTC(result.value().dt));
+      }
+      case PropertyType::GEOGRAPHY: {
+        auto result = Geography::fromWKT(field, true, true);
+        if (!result.ok()) {
+          return result.status();
+        }
+        return Value(std::move(result).value());
+      }
+      default:
+        return Status::Error("Unsupported property type %d.", static_cast<int32_t>(type));
+    }
+  } catch (const std::exception& e) {
+    return Status::Error("Bad value `%s': %s.", field.c_str(), e.what());
+  }
+}
+
+Status ColumnarReader::open(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return Status::Error("Failed to open '%s'.", path.c_str());
+  }
+  char magic[sizeof(kMagic)];
+  uint32_t numColumns = 0;
+  file.read(magic, sizeof(magic));
+  file.read(reinterpret_cast<char*>(&numColumns), sizeof(numColumns));
+  file.read(reinterpret_cast<char*>(&numRows_), sizeof(numRows_));
+  if (!file || memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    return Status::Error("'%s' is not a columnar file.", path.c_str());
+  }
+  numColumns = folly::Endian::little(numColumns);
+  numRows_ = folly::Endian::little(numRows_);
+  if (numColumns != types_.size()) {
+    return Status::Error("Expect %zu columns, but got %u.", types_.size(), numColumns);
+  }
+  for (uint32_t i = 0; i < numColumns; i++) {
+    uint64_t offset = 0;
+    if (!file.read(reinterpret_cast<char*>(&offset), sizeof(offset))) {
+      return Status::Error("Failed to read the offset of column %u.", i);
+    }
+    auto column = std::make_unique<std::ifstream>(path, std::ios::binary);
+    if (!column->seekg(folly::Endian::little(offset))) {
+      return Status::Error("Failed to seek to column %u.", i);
+    }
+    columns_.emplace_back(std::move(column));
+  }
+  return Status::OK();
+}
+
+StatusOr<bool> ColumnarReader::next(std::vector<Value>& row) {
+  if (rowNum_ >= numRows_) {
+    return false;
+  }
+  rowNum_++;
+  row.clear();
+  for (size_t i = 0; i < types_.size(); i++) {
+    auto value = read(*columns_[i], types_[i]);
+    if (!value.ok()) {
+      return value.status();
+    }
+    row.emplace_back(std::move(value).value());
+  }
+  return true;
+}
+
+StatusOr<Value> ColumnarReader::read(std::ifstream& column, PropertyType type) {
+  uint8_t isNull = 0;
+  if (!column.read(reinterpret_cast<char*>(&isNull), sizeof(isNull))) {
+    return Status::Error("Unexpected end of column.");
+  }
+  if (isNull) {
+    return Value(NullType::__NULL__);
+  }
+  switch (type) {
+    case PropertyType::BOOL: {
+      uint8_t val = 0;
+      if (!column.read(reinterpret_cast<char*>(&val), sizeof(val))) {
+        return Status::Error("Unexpected end of column.");
+      }
+      return Value(val != 0);
+    }
+    case PropertyType::INT8:
+    case PropertyType::INT16:
+    case PropertyType::INT32:
+    case PropertyType::INT64:
+    case PropertyType::TIMESTAMP: {
+      int64_t val = 0;
+      if (!column.read(reinterpret_cast<char*>(&val), sizeof(val))) {
+        return Status::Error("Unexpected end of column.");
+      }
+      return Value(folly::Endian::little(val));
+    }
+    case PropertyType::FLOAT:
+    case PropertyType::DOUBLE: {
+      double val = 0;
+      if (!column.read(reinterpret_cast<char*>(&val), sizeof(val))) {
+        return Status::Error("Unexpected end of column.");
+      }
+      return Value(val);
+    }
+    default: {
+      uint32_t len = 0;
+      if (!column.read(reinterpret_cast<char*>(&len), sizeof(len))) {
+        return Status::Error("Unexpected end of column.");
+      }
+      std::string text(folly::Endian::little(len), '\0');
+      if (!column.read(text.data(), text.size())) {
+        return Status::Error("Unexpected end of column.");
+      }
+      return CsvReader::toValue(text, type);
+    }
+  }
+}
+
+Status BulkLoader::init() {
+  auto status = initMeta();
+  if (!status.ok()) {
+    return status;
+  }
+
+  status = initSchema();
+  if (!status.ok()) {
+    return status;
+  }
+
+  return initReader();
+}
+
+Status BulkLoader::initMeta() {
+  auto addrs = network::NetworkUtils::toHosts(FLAGS_meta_server);
+  if (!addrs.ok()) {
+    return addrs.status();
+  }
+
+  auto ioExecutor = std::make_shared<folly::IOThreadPoolExecutor>(1);
+  meta::MetaClientOptions options;
+  options.skipConfig_ = true;
+  metaClient_ = std::make_unique<meta::MetaClient>(ioExecutor, std::move(addrs.value()), options);
+  if (!metaClient_->waitForMetadReady(1)) {
+    return Status::Error("Meta is not ready: '%s'.", FLAGS_meta_server.c_str());
+  }
+  schemaMng_ = std::make_unique<meta::ServerBasedSchemaManager>();
+  schemaMng_->init(metaClient_.get());
+
+  if (FLAGS_space_name.empty()) {
+    return Status::Error("Space name is not given.");
+  }
+  auto space = schemaMng_->toGraphSpaceID(FLAGS_space_name);
+  if (!space.ok()) {
+    return Status::Error("Space '%s' not found in meta server.", FLAGS_space_name.c_str());
+  }
+  spaceId_ = space.value();
+
+  auto spaceVidLen = metaClient_->getSpaceVidLen(spaceId_);
+  if (!spaceVidLen.ok()) {
+    return spaceVidLen.status();
+  }
+  spaceVidLen_ = spaceVidLen.value();
+
+  auto vidType = metaClient_->getSpaceVidType(spaceId_);
+  if (!vidType.ok()) {
+    return vidType.status();
+  }
+  spaceVidType_ = vidType.value();
+
+  auto partNum = metaClient_->partsNum(spaceId_);
+  if (!partNum.ok()) {
+    return Status::Error("Get partition number from '%s' failed.", FLAGS_space_name.c_str());
+  }
+  partNum_ = partNum.value();
+  return Status::OK();
+}
+
+Status BulkLoader::initSchema() {
+  if (FLAGS_tag.empty() == FLAGS_edge.empty()) {
+    return Status::Error("Either a tag or an edge should be given.");
+  }
+  isEdge_ = !FLAGS_edge.empty();
+  schemaName_ = isEdge_ ? FLAGS_edge : FLAGS_tag;
+  StatusOr<std::vector<std::shared_ptr<meta::cpp2::IndexItem>>> indexes;
+  if (isEdge_) {
+    auto edgeType = schemaMng_->toEdgeType(spaceId_, schemaName_);
+    if (!edgeType.ok()) {
+      return Status::Error("Edge '%s' not found in meta.", schemaName_.c_str());
+    }
+    schemaId_ = edgeType.value();
+    schema_ = schemaMng_->getEdgeSchema(spaceId_, schemaId_);
+    indexes = metaClient_->getEdgeIndexesFromCache(spaceId_);
+  } else {
+    auto tagId = schemaMng_->toTagID(spaceId_, schemaName_);
+    if (!tagId.ok()) {
+      return Status::Error("Tag '%s' not found in meta.", schemaName_.c_str());
+    }
+    schemaId_ = tagId.value();
+    schema_ = schemaMng_->getTagSchema(spaceId_, schemaId_);
+    indexes = metaClient_->getTagIndexesFromCache(spaceId_);
+  }
+  if (schema_ == nullptr) {
+    return Status::Error("Schema of '%s' not found in meta.", schemaName_.c_str());
+  }
+  if (!indexes.ok()) {
+    return indexes.status();
+  }
+  for (auto& index : indexes.value()) {
+    const auto& schemaId = index->get_schema_id();
+    auto id = isEdge_ ? schemaId.get_edge_type() : schemaId.get_tag_id();
+    if (id == schemaId_) {
+      indexes_.emplace_back(index);
+    }
+  }
+
+  if (FLAGS_props.empty()) {
+    for (size_t i = 0; i < schema_->getNumFields(); i++) {
+      propNames_.emplace_back(schema_->getFieldName(i));
+    }
+  } else {
+    folly::split(',', FLAGS_props, propNames_, true);
+    for (const auto& name : propNames_) {
+      if (schema_->field(name) == nullptr) {
+        return Status::Error("Property '%s' not found in '%s'.", name.c_str(), schemaName_.c_str());
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status BulkLoader::initReader() {
+  // Columns of a row: vid, or src, dst and optional rank, followed by the properties
+  auto vidType =
+      spaceVidType_ == PropertyType::INT64 ? PropertyType::INT64 : PropertyType::STRING;
+  std::vector<PropertyType> types = {vidType};
+  if (isEdge_) {
+    types.emplace_back(vidType);
+    if (FLAGS_with_rank) {
+      types.emplace_back(PropertyType::INT64);
+    }
+  }
+  for (const auto& name : propNames_) {
+    types.emplace_back(schema_->getFieldType(name));
+  }
+
+  if (FLAGS_format == "csv") {
+    if (FLAGS_delimiter.size() != 1) {
+      return Status::Error("Delimiter should be a single character.");
+    }
+    reader_ = std::make_unique<CsvReader>(std::move(types), FLAGS_delimiter[0], FLAGS_csv_header);
+  } else if (FLAGS_format == "columnar") {
+    reader_ = std::make_unique<ColumnarReader>(std::move(types));
+  } else {
+    return Status::Error("Unknown format '%s'.", FLAGS_format.c_str());
+  }
+  return reader_->open(FLAGS_input);
+}
+
+Status BulkLoader::run() {
+  auto maxBufferedBytes = static_cast<size_t>(FLAGS_max_buffer_mb) * 1024 * 1024;
+  std::vector<Value> row;
+  while (true) {
+    auto ret = reader_->next(row);
+    Status status = Status::OK();
+    if (!ret.ok()) {
+      status = ret.status();
+    } else if (!ret.value()) {
+      break;
+    } else {
+      status = addRow(row);
+    }
+    if (!status.ok()) {
+      if (!FLAGS_skip_bad_rows) {
+        return Status::Error("Row %zu: %s", reader_->rowNum(), status.toString().c_str());
+      }
+      LOG(WARNING) << "Skip row " << reader_->rowNum() << ": " << status;
+      numBadRows_++;
+      continue;
+    }
+    numRows_++;
+    if (bufferedBytes_ >= maxBufferedBytes) {
+      status = flush();
+      if (!status.ok()) {
+        return status;
+      }
+    }
+  }
+  auto status = flush();
+  if (!status.ok()) {
+    return status;
+  }
+  std::cout << "Loaded " << numRows_ << " rows, skipped " << numBadRows_ << " rows, wrote "
+            << numKeys_ << " keys into " << FLAGS_output << "\n";
+  return Status::OK();
+}
+
+Status BulkLoader::addRow(const std::vector<Value>& row) {
+  return isEdge_ ? addEdge(row) : addVertex(row);
+}
+
+Status BulkLoader::addVertex(const std::vector<Value>& row) {
+  auto vid = toVid(row[0]);
+  if (!vid.ok()) {
+    return vid.status();
+  }
+  auto encoded = encodeProps(row, 1);
+  if (!encoded.ok()) {
+    return encoded.status();
+  }
+  auto partId = partOf(vid.value());
+  auto status = addIndexes(partId, encoded.value(), vid.value());
+  if (!status.ok()) {
+    return status;
+  }
+  add(partId,
+      NebulaKeyUtils::tagKey(spaceVidLen_, partId, vid.value(), schemaId_),
+      std::move(encoded).value());
+  return Status::OK();
+}
+
+Status BulkLoader::addEdge(const std::vector<Value>& row) {
+  auto src = toVid(row[0]);
+  if (!src.ok()) {
+    return src.status();
+  }
+  auto dst = toVid(row[1]);
+  if (!dst.ok()) {
+    return dst.status();
+  }
+  EdgeRanking rank = 0;
+  if (FLAGS_with_rank) {
+    if (!row[2].isInt()) {
+      return Status::Error("Rank should be an integer.");
+    }
+    rank = row[2].getInt();
+  }
+  auto encoded = encodeProps(row, FLAGS_with_rank ? 3 : 2);
+  if (!encoded.ok()) {
+    return encoded.status();
+  }
+  // The out edge is stored in the part of src, and the in edge in the part of dst
+  auto srcPart = partOf(src.value());
+  auto dstPart = partOf(dst.value());
+  auto status = addIndexes(srcPart, encoded.value(), src.value(), rank, dst.value());
+  if (!status.ok()) {
+    return status;
+  }
+  add(srcPart,
+      NebulaKeyUtils::edgeKey(spaceVidLen_, srcPart, src.value(), schemaId_, rank, dst.value()),
+      encoded.value());
+  add(dstPart,
+      NebulaKeyUtils::edgeKey(spaceVidLen_, dstPart, dst.value(), -schemaId_, rank, src.value()),
+      std::move(encoded).value());
+  return Status::OK();
+}
+
+StatusOr<std::string> BulkLoader::encodeProps(const std::vector<Value>& row, size_t start) {
+  RowWriterV2 writer(schema_.get());
+  for (size_t i = 0; i < propNames_.size(); i++) {
+    auto wRet = writer.setValue(propNames_[i], row[start + i]);
+    if (wRet != WriteResult::SUCCEEDED) {
+      return Status::Error(
+          "Bad value of '%s', error %d.", propNames_[i].c_str(), static_cast<int32_t>(wRet));
+    }
+  }
+  auto wRet = writer.finish();
+  if (wRet != WriteResult::SUCCEEDED) {
+    return Status::Error("Failed to encode the row, error %d.", static_cast<int32_t>(wRet));
+  }
+  return std::move(writer).moveEncodedStr();
+}
+
+StatusOr<std::string> BulkLoader::toVid(const Value& value) {
+  if (spaceVidType_ == PropertyType::INT64) {
+    if (!value.isInt()) {
+      return Status::Error("Vid should be an integer.");
+    }
+    auto vid = value.getInt();
+    return std::string(reinterpret_cast<const char*>(&vid), sizeof(vid));
+  }
+  if (!value.isStr() || !NebulaKeyUtils::isValidVidLen(spaceVidLen_, value.getStr())) {
+    return Status::Error("Vid should be a string not longer than %d.", spaceVidLen_);
+  }
+  return value.getStr();
+}
+
+PartitionID BulkLoader::partOf(const VertexID& vid) const {
+  // The int64 vid of 8 bytes is partitioned by its value, to be compatible with version 1.0
+  uint64_t hash = 0;
+  if (vid.size() == 8) {
+    memcpy(static_cast<void*>(&hash), vid.data(), 8);
+  } else {
+    MurmurHash2 murmur;
+    hash = murmur(vid.data());
+  }
+  return hash % partNum_ + 1;
+}
+
+Status BulkLoader::addIndexes(PartitionID partId,
+                              const std::string& encoded,
+                              const VertexID& src,
+                              EdgeRanking rank,
+                              const VertexID& dst) {
+  if (indexes_.empty()) {
+    return Status::OK();
+  }
+  auto reader = RowReaderWrapper::getRowReader(schema_.get(), encoded);
+  if (!reader) {
+    return Status::Error("Failed to read the encoded row.");
+  }
+  // The index value keeps the ttl field if there is one
+  auto ttl = CommonUtils::ttlValue(schema_.get(), reader.get());
+  auto indexVal = ttl.ok() ? IndexKeyUtils::indexVal(std::move(ttl).value()) : "";
+  for (const auto& index : indexes_) {
+    auto values = IndexKeyUtils::collectIndexValues(reader.get(), index.get(), schema_.get());
+    if (!values.ok()) {
+      return values.status();
+    }
+    auto keys = isEdge_ ? IndexKeyUtils::edgeIndexKeys(spaceVidLen_,
+                                                       partId,
+                                                       index->get_index_id(),
+                                                       src,
+                                                       rank,
+                                                       dst,
+                                                       std::move(values).value())
+                        : IndexKeyUtils::vertexIndexKeys(spaceVidLen_,
+                                                         partId,
+                                                         index->get_index_id(),
+                                                         src,
+                                                         std::move(values).value());
+    for (auto& key : keys) {
+      add(partId, std::move(key), indexVal);
+    }
+  }
+  return Status::OK();
+}
+
+void BulkLoader::add(PartitionID partId, std::string key, std::string val) {
+  bufferedBytes_ += key.size() + val.size();
+  buffers_[partId].emplace_back(std::move(key), std::move(val));
+}
+
+Status BulkLoader::flush() {
+  auto inputName = fs::FileUtils::basename(FLAGS_input.c_str());
+  for (auto& [partId, kvs] : buffers_) {
+    if (kvs.empty()) {
+      continue;
+    }
+    // Keep the order of the same key, so the latest row wins as inserting
+    std::stable_sort(
+        kvs.begin(), kvs.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    auto dir = folly::stringPrintf("%s/%d", FLAGS_output.c_str(), partId);
+    if (!fs::FileUtils::exist(dir) && !fs::FileUtils::makeDir(dir)) {
+      return Status::Error("Failed to create '%s'.", dir.c_str());
+    }
+    auto path = folly::stringPrintf(
+        "%s/%s-%s-%d.sst", dir.c_str(), schemaName_.c_str(), inputName.c_str(), fileSeq_);
+    rocksdb::Options options;
+    rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+    auto s = writer.Open(path);
+    if (!s.ok()) {
+      return Status::Error("Failed to open '%s': %s", path.c_str(), s.ToString().c_str());
+    }
+    for (size_t i = 0; i < kvs.size(); i++) {
+      if (i + 1 < kvs.size() && kvs[i + 1].first == kvs[i].first) {
+        continue;
+      }
+      s = writer.Put(kvs[i].first, kvs[i].second);
+      if (!s.ok()) {
+        return Status::Error("Failed to write '%s': %s", path.c_str(), s.ToString().c_str());
+      }
+      numKeys_++;
+    }
+    s = writer.Finish();
+    if (!s.ok()) {
+      return Status::Error("Failed to finish '%s': %s", path.c_str(), s.ToString().c_str());
+    }
+  }
+  buffers_.clear();
+  bufferedBytes_ = 0;
+  fileSeq_++;
+  return Status::OK();
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,205 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef TOOLS_BULKLOAD_BULKLOADER_H_
+#define TOOLS_BULKLOAD_BULKLOADER_H_
+
+#include <fstream>
+
+#include "clients/meta/MetaClient.h"
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/base/StatusOr.h"
+#include "common/meta/ServerBasedSchemaManager.h"
+#include "kvstore/Common.h"
+
+DECLARE_string(space_name);
+DECLARE_string(meta_server);
+DECLARE_string(tag);
+DECLARE_string(edge);
+DECLARE_string(props);
+DECLARE_string(input);
+DECLARE_string(format);
+DECLARE_string(delimiter);
+DECLARE_bool(csv_header);
+DECLARE_bool(with_rank);
+DECLARE_bool(skip_bad_rows);
+DECLARE_string(output);
+DECLARE_int64(max_buffer_mb);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Reads the rows to load, a row has a value for each column, the values are typed by the
+ * types of the columns given.
+ */
+class InputReader {
+ public:
+  virtual ~InputReader() = default;
+
+  virtual Status open(const std::string& path) = 0;
+
+  // Read the next row, false if all rows have been read
+  virtual StatusOr<bool> next(std::vector<Value>& row) = 0;
+
+  // Position of the latest row for error messages
+  virtual size_t rowNum() const = 0;
+};
+
+/**
+ * @brief Rows in csv, one line for each row. Fields could be quoted by '"', and '""' in a quoted
+ * field is a '"', but line breaks in fields are not supported. Empty fields are null except for
+ * the string columns.
+ */
+class CsvReader : public InputReader {
+ public:
+  CsvReader(std::vector<nebula::cpp2::PropertyType> types, char delimiter, bool header)
+      : types_(std::move(types)), delimiter_(delimiter), header_(header) {}
+
+  Status open(const std::string& path) override;
+
+  StatusOr<bool> next(std::vector<Value>& row) override;
+
+  size_t rowNum() const override {
+    return lineNum_;
+  }
+
+  // Split a line into fields
+  static StatusOr<std::vector<std::string>> split(const std::string& line, char delimiter);
+
+  // Convert the text of a field to a value of the type
+  static StatusOr<Value> toValue(const std::string& field, nebula::cpp2::PropertyType type);
+
+ private:
+  std::vector<nebula::cpp2::PropertyType> types_;
+  char delimiter_;
+  bool header_;
+  std::ifstream file_;
+  size_t lineNum_{0};
+};
+
+/**
+ * @brief Rows in a simple binary columnar file, all integers are little endian:
+ *
+ *   magic "NBCOLV1\0" (8 bytes) | number of columns (uint32) | number of rows (uint64)
+ *   | offset of each column from the beginning of the file (uint64 each) | columns
+ *
+ * A column has a value for each row, and a value is a null flag (uint8, 1 for null) followed by
+ * the data if it is not null: uint8 for bool, int64 for integers and timestamp, double for
+ * float and double, and for all other types the length (uint32) and bytes of the text, which is
+ * the same as in csv. Each column is read by its own stream, so the file is never loaded fully.
+ */
+class ColumnarReader : public InputReader {
+ public:
+  explicit ColumnarReader(std::vector<nebula::cpp2::PropertyType> types)
+      : types_(std::move(types)) {}
+
+  Status open(const std::string& path) override;
+
+  StatusOr<bool> next(std::vector<Value>& row) override;
+
+  size_t rowNum() const override {
+    return rowNum_;
+  }
+
+  static constexpr char kMagic[] = "NBCOLV1";
+
+ private:
+  StatusOr<Value> read(std::ifstream& column, nebula::cpp2::PropertyType type);
+
+ private:
+  std::vector<nebula::cpp2::PropertyType> types_;
+  std::vector<std::unique_ptr<std::ifstream>> columns_;
+  uint64_t numRows_{0};
+  size_t rowNum_{0};
+};
+
+/**
+ * @brief Build the sst files of a tag or an edge type for bulk load.
+ *
+ * Rows are encoded by RowWriterV2 with the latest schema, the keys and index keys are built in
+ * the same way as inserting, and then dispatched to the parts of their vertices. The key values
+ * of each part are buffered, and written as a sorted sst file under <output>/<part id>/ once the
+ * buffer is full. The output could be put on hdfs or a local path, and loaded by
+ * `SUBMIT JOB DOWNLOAD HDFS "hdfs://..."` or `"file://..."`, and then `SUBMIT JOB INGEST`.
+ */
+class BulkLoader {
+  friend class BulkLoaderTest;
+
+ public:
+  BulkLoader() = default;
+
+  ~BulkLoader() = default;
+
+  Status init();
+
+  Status run();
+
+ private:
+  Status initMeta();
+
+  Status initSchema();
+
+  Status initReader();
+
+  // Encode a row into the key values of the data and indexes
+  Status addRow(const std::vector<Value>& row);
+
+  Status addVertex(const std::vector<Value>& row);
+
+  Status addEdge(const std::vector<Value>& row);
+
+  // Encode the properties of the row starting from the column
+  StatusOr<std::string> encodeProps(const std::vector<Value>& row, size_t start);
+
+  // The key of a vid value in the space, checking its length
+  StatusOr<std::string> toVid(const Value& value);
+
+  // The part of vid, the same as MetaClient::partId
+  PartitionID partOf(const VertexID& vid) const;
+
+  // Build the index key values of the encoded row, dst and rank are ignored for vertices
+  Status addIndexes(PartitionID partId,
+                    const std::string& encoded,
+                    const VertexID& src,
+                    EdgeRanking rank = 0,
+                    const VertexID& dst = "");
+
+  void add(PartitionID partId, std::string key, std::string val);
+
+  // Write the buffered key values into sst files
+  Status flush();
+
+ private:
+  std::unique_ptr<meta::MetaClient> metaClient_;
+  std::unique_ptr<meta::ServerBasedSchemaManager> schemaMng_;
+  GraphSpaceID spaceId_;
+  int32_t spaceVidLen_;
+  nebula::cpp2::PropertyType spaceVidType_;
+  int32_t partNum_;
+
+  bool isEdge_{false};
+  // Tag id or edge type
+  int32_t schemaId_;
+  std::string schemaName_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> schema_;
+  std::vector<std::string> propNames_;
+  std::vector<std::shared_ptr<meta::cpp2::IndexItem>> indexes_;
+  std::unique_ptr<InputReader> reader_;
+
+  std::unordered_map<PartitionID, std::vector<KV>> buffers_;
+  size_t bufferedBytes_{0};
+  // Sequence of the sst files written
+  int32_t fileSeq_{0};
+
+  int64_t numRows_{0};
+  int64_t numBadRows_{0};
+  int64_t numKeys_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // TOOLS_BULKLOAD_BULKLOADER_H_
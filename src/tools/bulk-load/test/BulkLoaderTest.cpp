@@ -0,0 +1,365 @@
+/* Copyright (c) 2023 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+#include <rocksdb/sst_file_reader.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "common/fs/FileUtils.h"
+#include "common/fs/TempDir.h"
+#include "common/utils/IndexKeyUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+#include "tools/bulk-load/BulkLoader.h"
+
+namespace nebula {
+namespace storage {
+
+using nebula::cpp2::PropertyType;
+
+class BulkLoaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    schema_ = std::make_shared<meta::NebulaSchemaProvider>(0);
+    schema_->addField("name", PropertyType::STRING);
+    schema_->addField("age", PropertyType::INT64);
+  }
+
+  // Set up the loader as init does with the meta of a space of kPartNum parts
+  void setUp(BulkLoader& loader,
+             bool isEdge,
+             std::vector<std::shared_ptr<meta::cpp2::IndexItem>> indexes = {}) {
+    loader.spaceId_ = 1;
+    loader.spaceVidLen_ = kVidLen;
+    loader.spaceVidType_ = PropertyType::FIXED_STRING;
+    loader.partNum_ = kPartNum;
+    loader.isEdge_ = isEdge;
+    loader.schemaId_ = kSchemaId;
+    loader.schemaName_ = isEdge ? "like" : "person";
+    loader.schema_ = schema_;
+    loader.propNames_ = {"name", "age"};
+    loader.indexes_ = std::move(indexes);
+  }
+
+  std::shared_ptr<meta::cpp2::IndexItem> ageIndex(bool isEdge) {
+    auto index = std::make_shared<meta::cpp2::IndexItem>();
+    index->index_id_ref() = kIndexId;
+    if (isEdge) {
+      index->schema_id_ref()->edge_type_ref() = kSchemaId;
+    } else {
+      index->schema_id_ref()->tag_id_ref() = kSchemaId;
+    }
+    meta::cpp2::ColumnDef col;
+    col.name = "age";
+    col.type.type_ref() = PropertyType::INT64;
+    index->fields_ref() = {col};
+    return index;
+  }
+
+  std::string ageIndexKey(PartitionID partId,
+                          const VertexID& src,
+                          int64_t age,
+                          bool isEdge,
+                          const VertexID& dst = "") {
+    auto index = ageIndex(isEdge);
+    auto values = IndexKeyUtils::encodeValues({Value(age)}, index.get());
+    auto keys = isEdge ? IndexKeyUtils::edgeIndexKeys(
+                             kVidLen, partId, kIndexId, src, 0, dst, std::move(values))
+                       : IndexKeyUtils::vertexIndexKeys(
+                             kVidLen, partId, kIndexId, src, std::move(values));
+    CHECK_EQ(1u, keys.size());
+    return keys[0];
+  }
+
+  Status addRow(BulkLoader& loader, std::vector<Value> row) {
+    return loader.addRow(row);
+  }
+
+  Status flush(BulkLoader& loader) {
+    return loader.flush();
+  }
+
+  const std::unordered_map<PartitionID, std::vector<KV>>& buffers(const BulkLoader& loader) {
+    return loader.buffers_;
+  }
+
+  PartitionID partOf(const BulkLoader& loader, const VertexID& vid) {
+    return loader.partOf(vid);
+  }
+
+  int64_t numKeys(const BulkLoader& loader) {
+    return loader.numKeys_;
+  }
+
+  Value propOf(const std::string& encoded, const std::string& prop) {
+    auto reader = RowReaderWrapper::getRowReader(schema_.get(), encoded);
+    CHECK(reader != nullptr);
+    return reader->getValueByName(prop);
+  }
+
+  static constexpr int32_t kVidLen = 8;
+  static constexpr int32_t kPartNum = 3;
+  static constexpr int32_t kSchemaId = 2;
+  static constexpr IndexID kIndexId = 10;
+
+  std::shared_ptr<meta::NebulaSchemaProvider> schema_;
+};
+
+// Write a columnar file, each column is the encoded values of all rows
+static void writeColumnar(const std::string& path,
+                          uint64_t numRows,
+                          const std::vector<std::string>& columns,
+                          const char* magic = ColumnarReader::kMagic) {
+  std::ofstream file(path, std::ios::binary);
+  uint32_t numColumns = columns.size();
+  file.write(magic, sizeof(ColumnarReader::kMagic));
+  file.write(reinterpret_cast<const char*>(&numColumns), sizeof(numColumns));
+  file.write(reinterpret_cast<const char*>(&numRows), sizeof(numRows));
+  uint64_t offset = sizeof(ColumnarReader::kMagic) + sizeof(numColumns) + sizeof(numRows) +
+                    columns.size() * sizeof(uint64_t);
+  for (const auto& column : columns) {
+    file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    offset += column.size();
+  }
+  for (const auto& column : columns) {
+    file.write(column.data(), column.size());
+  }
+}
+
+template <typename T>
+static void appendValue(std::string& column, T val) {
+  column.push_back('\0');
+  column.append(reinterpret_cast<const char*>(&val), sizeof(val));
+}
+
+static void appendText(std::string& column, const std::string& text) {
+  uint32_t len = text.size();
+  column.push_back('\0');
+  column.append(reinterpret_cast<const char*>(&len), sizeof(len));
+  column.append(text);
+}
+
+static void appendNull(std::string& column) {
+  column.push_back('\1');
+}
+
+TEST(CsvReaderTest, Split) {
+  {
+    auto fields = CsvReader::split("a,b,,c", ',');
+    ASSERT_TRUE(fields.ok());
+    EXPECT_EQ((std::vector<std::string>{"a", "b", "", "c"}), fields.value());
+  }
+  {
+    // The delimiter and the escaped quote in a quoted field
+    auto fields = CsvReader::split("\"a,b\",\"say \"\"hi\"\"\",c", ',');
+    ASSERT_TRUE(fields.ok());
+    EXPECT_EQ((std::vector<std::string>{"a,b", "say \"hi\"", "c"}), fields.value());
+  }
+  {
+    auto fields = CsvReader::split("a|b,c|", '|');
+    ASSERT_TRUE(fields.ok());
+    EXPECT_EQ((std::vector<std::string>{"a", "b,c", ""}), fields.value());
+  }
+  {
+    auto fields = CsvReader::split("a,\"b", ',');
+    EXPECT_FALSE(fields.ok());
+  }
+}
+
+TEST(CsvReaderTest, ToValue) {
+  EXPECT_EQ(Value(12), CsvReader::toValue("12", PropertyType::INT64).value());
+  EXPECT_EQ(Value(-3), CsvReader::toValue("-3", PropertyType::INT8).value());
+  EXPECT_EQ(Value(1.5), CsvReader::toValue("1.5", PropertyType::DOUBLE).value());
+  EXPECT_EQ(Value(true), CsvReader::toValue("TRUE", PropertyType::BOOL).value());
+  EXPECT_EQ(Value(false), CsvReader::toValue("false", PropertyType::BOOL).value());
+  EXPECT_EQ(Value("abc"), CsvReader::toValue("abc", PropertyType::STRING).value());
+  EXPECT_EQ(Value(Date(2023, 1, 2)), CsvReader::toValue("2023-01-02", PropertyType::DATE).value());
+
+  // Empty fields are null except for strings
+  EXPECT_TRUE(CsvReader::toValue("", PropertyType::INT64).value().isNull());
+  EXPECT_TRUE(CsvReader::toValue("", PropertyType::DATE).value().isNull());
+  EXPECT_EQ(Value(""), CsvReader::toValue("", PropertyType::STRING).value());
+
+  EXPECT_FALSE(CsvReader::toValue("12a", PropertyType::INT64).ok());
+  EXPECT_FALSE(CsvReader::toValue("yes", PropertyType::BOOL).ok());
+  EXPECT_FALSE(CsvReader::toValue("abc", PropertyType::DOUBLE).ok());
+  EXPECT_FALSE(CsvReader::toValue("2023-13-02", PropertyType::DATE).ok());
+}
+
+TEST(CsvReaderTest, Next) {
+  fs::TempDir dir("/tmp/CsvReaderTest.XXXXXX");
+  auto path = folly::stringPrintf("%s/input.csv", dir.path());
+  {
+    std::ofstream file(path);
+    file << "vid,age\r\n"
+         << "a,1\r\n"
+         << "\n"
+         << "b,\n"
+         << "c,2,3\n";
+  }
+  CsvReader reader({PropertyType::STRING, PropertyType::INT64}, ',', true);
+  ASSERT_TRUE(reader.open(path).ok());
+  std::vector<Value> row;
+  ASSERT_TRUE(reader.next(row).value());
+  EXPECT_EQ((std::vector<Value>{"a", 1}), row);
+  EXPECT_EQ(2, reader.rowNum());
+  // The empty line is skipped
+  ASSERT_TRUE(reader.next(row).value());
+  EXPECT_EQ(Value("b"), row[0]);
+  EXPECT_TRUE(row[1].isNull());
+  EXPECT_EQ(4, reader.rowNum());
+  // The row of too many fields
+  EXPECT_FALSE(reader.next(row).ok());
+  EXPECT_EQ(5, reader.rowNum());
+  auto ret = reader.next(row);
+  ASSERT_TRUE(ret.ok());
+  EXPECT_FALSE(ret.value());
+}
+
+TEST(ColumnarReaderTest, Next) {
+  fs::TempDir dir("/tmp/ColumnarReaderTest.XXXXXX");
+  auto path = folly::stringPrintf("%s/input.col", dir.path());
+  std::string ids, names, flags;
+  appendValue<int64_t>(ids, 1);
+  appendValue<int64_t>(ids, 2);
+  appendText(names, "Tom");
+  appendNull(names);
+  appendValue<uint8_t>(flags, 1);
+  appendValue<uint8_t>(flags, 0);
+  writeColumnar(path, 2, {ids, names, flags});
+
+  ColumnarReader reader({PropertyType::INT64, PropertyType::STRING, PropertyType::BOOL});
+  ASSERT_TRUE(reader.open(path).ok());
+  std::vector<Value> row;
+  ASSERT_TRUE(reader.next(row).value());
+  EXPECT_EQ((std::vector<Value>{1, "Tom", true}), row);
+  ASSERT_TRUE(reader.next(row).value());
+  EXPECT_EQ(Value(2), row[0]);
+  EXPECT_TRUE(row[1].isNull());
+  EXPECT_EQ(Value(false), row[2]);
+  EXPECT_EQ(2, reader.rowNum());
+  EXPECT_FALSE(reader.next(row).value());
+}
+
+TEST(ColumnarReaderTest, BadFile) {
+  fs::TempDir dir("/tmp/ColumnarReaderTest.XXXXXX");
+  auto path = folly::stringPrintf("%s/input.col", dir.path());
+  std::string ids;
+  appendValue<int64_t>(ids, 1);
+  {
+    writeColumnar(path, 1, {ids}, "NBCOLV0");
+    ColumnarReader reader({PropertyType::INT64});
+    EXPECT_FALSE(reader.open(path).ok());
+  }
+  {
+    // The number of columns does not match
+    writeColumnar(path, 1, {ids});
+    ColumnarReader reader({PropertyType::INT64, PropertyType::INT64});
+    EXPECT_FALSE(reader.open(path).ok());
+  }
+  {
+    // There are fewer values than rows
+    writeColumnar(path, 2, {ids});
+    ColumnarReader reader({PropertyType::INT64});
+    ASSERT_TRUE(reader.open(path).ok());
+    std::vector<Value> row;
+    ASSERT_TRUE(reader.next(row).value());
+    EXPECT_FALSE(reader.next(row).ok());
+  }
+}
+
+TEST_F(BulkLoaderTest, VertexKeys) {
+  BulkLoader loader;
+  setUp(loader, false, {ageIndex(false)});
+  ASSERT_TRUE(addRow(loader, {"v1", "Tom", 18}).ok());
+
+  auto partId = partOf(loader, "v1");
+  const auto& kvs = buffers(loader).at(partId);
+  ASSERT_EQ(2, kvs.size());
+  // The index key is built before the data key
+  EXPECT_EQ(ageIndexKey(partId, "v1", 18, false), kvs[0].first);
+  EXPECT_EQ(NebulaKeyUtils::tagKey(kVidLen, partId, "v1", kSchemaId), kvs[1].first);
+  EXPECT_EQ(Value("Tom"), propOf(kvs[1].second, "name"));
+  EXPECT_EQ(Value(18), propOf(kvs[1].second, "age"));
+}
+
+TEST_F(BulkLoaderTest, EdgeKeys) {
+  BulkLoader loader;
+  setUp(loader, true, {ageIndex(true)});
+  ASSERT_TRUE(addRow(loader, {"v1", "v2", "Tom", 18}).ok());
+
+  // The out edge and the index are in the part of src, the in edge is in the part of dst
+  auto srcPart = partOf(loader, "v1");
+  auto dstPart = partOf(loader, "v2");
+  auto outKey =
+      NebulaKeyUtils::edgeKey(kVidLen, srcPart, "v1", kSchemaId, 0, "v2");
+  auto inKey =
+      NebulaKeyUtils::edgeKey(kVidLen, dstPart, "v2", -kSchemaId, 0, "v1");
+  auto indexKey = ageIndexKey(srcPart, "v1", 18, true, "v2");
+  std::set<std::string> srcKeys, dstKeys;
+  for (const auto& [key, val] : buffers(loader).at(srcPart)) {
+    srcKeys.emplace(key);
+    if (key == outKey) {
+      EXPECT_EQ(Value("Tom"), propOf(val, "name"));
+    }
+  }
+  for (const auto& [key, val] : buffers(loader).at(dstPart)) {
+    dstKeys.emplace(key);
+    if (key == inKey) {
+      EXPECT_EQ(Value(18), propOf(val, "age"));
+    }
+  }
+  EXPECT_TRUE(srcKeys.count(outKey));
+  EXPECT_TRUE(srcKeys.count(indexKey));
+  EXPECT_TRUE(dstKeys.count(inKey));
+  EXPECT_EQ(srcPart == dstPart ? 3 : 2, srcKeys.size());
+}
+
+TEST_F(BulkLoaderTest, BadRows) {
+  BulkLoader loader;
+  setUp(loader, false);
+  // The vid is longer than the vid length of the space
+  EXPECT_FALSE(addRow(loader, {"a_very_long_vid", "Tom", 18}).ok());
+  // The vid of a fixed string space is not an integer
+  EXPECT_FALSE(addRow(loader, {1, "Tom", 18}).ok());
+  // The value does not match the type of the property
+  EXPECT_FALSE(addRow(loader, {"v1", "Tom", "18"}).ok());
+  EXPECT_TRUE(buffers(loader).empty());
+}
+
+TEST_F(BulkLoaderTest, FlushDedup) {
+  fs::TempDir dir("/tmp/BulkLoaderTest.XXXXXX");
+  FLAGS_output = dir.path();
+  FLAGS_input = "person.csv";
+
+  BulkLoader loader;
+  setUp(loader, false);
+  ASSERT_TRUE(addRow(loader, {"v1", "Tom", 18}).ok());
+  ASSERT_TRUE(addRow(loader, {"v2", "Jerry", 20}).ok());
+  ASSERT_TRUE(addRow(loader, {"v1", "Tom", 19}).ok());
+  ASSERT_TRUE(flush(loader).ok());
+  EXPECT_TRUE(buffers(loader).empty());
+  EXPECT_EQ(2, numKeys(loader));
+
+  // The same vertex loaded twice is written once, and the latest row wins as inserting
+  auto partId = partOf(loader, "v1");
+  auto partDir = folly::stringPrintf("%s/%d", dir.path(), partId);
+  auto files = fs::FileUtils::listAllFilesInDir(partDir.c_str(), true, "*.sst");
+  ASSERT_EQ(1, files.size());
+  rocksdb::SstFileReader reader((rocksdb::Options()));
+  ASSERT_TRUE(reader.Open(files[0]).ok());
+  std::unique_ptr<rocksdb::Iterator> iter(reader.NewIterator(rocksdb::ReadOptions()));
+  auto key = NebulaKeyUtils::tagKey(kVidLen, partId, "v1", kSchemaId);
+  size_t count = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    if (iter->key().ToString() == key) {
+      count++;
+      EXPECT_EQ(Value(19), propOf(iter->value().ToString(), "age"));
+    }
+  }
+  EXPECT_EQ(1, count);
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -544,6 +544,46 @@ Feature: Geo base
       | "LINESTRING(3 8, 4.7 73.23)"    |
       | "POLYGON((0 1, 1 2, 2 3, 0 1))" |
       | "POINT(72.3 84.6)"              |
+    # kNN by the geo index
+    When profiling query:
+      """
+      LOOKUP ON any_shape YIELD ST_ASText(any_shape.geo) AS geo, ST_Distance(any_shape.geo, ST_Point(3, 8)) AS d | ORDER BY $-.d | LIMIT 3 | YIELD $-.geo AS geo
+      """
+    Then the result should be, in any order:
+      | geo                             |
+      | "POINT(3 8)"                    |
+      | "LINESTRING(3 8, 4.7 73.23)"    |
+      | "POLYGON((0 1, 1 2, 2 3, 0 1))" |
+    And the execution plan should be:
+      | id | name            | dependencies | operator info |
+      | 6  | Project         | 5            |               |
+      | 5  | TopN            | 4            |               |
+      | 4  | Project         | 3            |               |
+      | 3  | GeoKnnIndexScan | 0            |               |
+      | 0  | Start           |              |               |
+    When profiling query:
+      """
+      LOOKUP ON any_shape YIELD ST_ASText(any_shape.geo) AS geo, ST_Distance(ST_Point(72, 84), any_shape.geo) AS d | ORDER BY $-.d | LIMIT 1 | YIELD $-.geo AS geo
+      """
+    Then the result should be, in any order:
+      | geo                |
+      | "POINT(72.3 84.6)" |
+    And the execution plan should be:
+      | id | name            | dependencies | operator info |
+      | 6  | Project         | 5            |               |
+      | 5  | TopN            | 4            |               |
+      | 4  | Project         | 3            |               |
+      | 3  | GeoKnnIndexScan | 0            |               |
+      | 0  | Start           |              |               |
+    # The point far from all geographies is beyond the max radius of rings, the rest of index
+    # is scanned at once
+    When executing query:
+      """
+      LOOKUP ON any_shape YIELD ST_ASText(any_shape.geo) AS geo, ST_Distance(ST_Point(-150, -60), any_shape.geo) AS d | ORDER BY $-.d | LIMIT 1 | YIELD $-.geo AS geo
+      """
+    Then the result should be, in any order:
+      | geo                             |
+      | "POLYGON((0 1, 1 2, 2 3, 0 1))" |
     When executing query:
       """
       LOOKUP ON any_shape WHERE ST_Distance(any_shape.geo, ST_Point($p4.longitude[0], $p4.latitude[1])) < $p4.latitude[2] YIELD id(vertex)
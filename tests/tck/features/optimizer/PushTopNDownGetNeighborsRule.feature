@@ -0,0 +1,126 @@
+# Copyright (c) 2023 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+Feature: Push TopN down GetNeighbors rule
+
+  Background:
+    Given an empty graph
+    And create a space with following options:
+      | partition_num  | 1                |
+      | replica_factor | 1                |
+      | vid_type       | FIXED_STRING(32) |
+    And having executed:
+      """
+      CREATE EDGE rate(score int) adjacency_order = "score" DESC;
+      CREATE EDGE plain(score int);
+      """
+    And wait 3 seconds
+    And having executed:
+      """
+      INSERT EDGE rate(score) VALUES "a"->"b":(4), "a"->"c":(5), "a"->"d":(1), "a"->"e":(3),
+                                     "b"->"c":(2);
+      INSERT EDGE plain(score) VALUES "a"->"b":(4), "a"->"c":(5), "a"->"d":(1);
+      """
+
+  Scenario: push topN down to ExpandAll by the adjacency order
+    When profiling query:
+      """
+      GO FROM "a" OVER rate YIELD rate.score AS score, rate._dst AS dst |
+      ORDER BY $-.score DESC |
+      LIMIT 2
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 5     | "c" |
+      | 4     | "b" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info                                                                    |
+      | 7  | TopN      | 4            |                                                                                  |
+      | 4  | Project   | 3            |                                                                                  |
+      | 3  | ExpandAll | 2            | {"limit": "2", "orderBy": "[{\"direction\":\"DESCENDING\",\"prop\":\"score\"}]"} |
+      | 2  | Expand    | 1            |                                                                                  |
+      | 1  | Start     |              |                                                                                  |
+    When profiling query:
+      """
+      GO FROM "c" OVER rate REVERSELY YIELD rate.score AS score, rate._dst AS dst |
+      ORDER BY $-.score DESC |
+      LIMIT 1
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 5     | "a" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info                                                                    |
+      | 7  | TopN      | 4            |                                                                                  |
+      | 4  | Project   | 3            |                                                                                  |
+      | 3  | ExpandAll | 2            | {"limit": "1", "orderBy": "[{\"direction\":\"DESCENDING\",\"prop\":\"score\"}]"} |
+      | 2  | Expand    | 1            |                                                                                  |
+      | 1  | Start     |              |                                                                                  |
+    When profiling query:
+      """
+      GO 2 STEPS FROM "a" OVER rate YIELD rate.score AS score, rate._dst AS dst |
+      ORDER BY $-.score DESC |
+      LIMIT 1
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 2     | "c" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info                                                                    |
+      | 7  | TopN      | 4            |                                                                                  |
+      | 4  | Project   | 3            |                                                                                  |
+      | 3  | ExpandAll | 2            | {"limit": "1", "orderBy": "[{\"direction\":\"DESCENDING\",\"prop\":\"score\"}]"} |
+      | 2  | Expand    | 1            |                                                                                  |
+      | 1  | Start     |              |                                                                                  |
+
+  Scenario: fail to push topN down to ExpandAll
+    When profiling query:
+      """
+      GO FROM "a" OVER rate YIELD rate.score AS score, rate._dst AS dst |
+      ORDER BY $-.score |
+      LIMIT 2
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 1     | "d" |
+      | 3     | "e" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info     |
+      | 7  | TopN      | 4            |                   |
+      | 4  | Project   | 3            |                   |
+      | 3  | ExpandAll | 2            | {"orderBy": "[]"} |
+      | 2  | Expand    | 1            |                   |
+      | 1  | Start     |              |                   |
+    When profiling query:
+      """
+      GO FROM "a" OVER plain YIELD plain.score AS score, plain._dst AS dst |
+      ORDER BY $-.score DESC |
+      LIMIT 2
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 5     | "c" |
+      | 4     | "b" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info     |
+      | 7  | TopN      | 4            |                   |
+      | 4  | Project   | 3            |                   |
+      | 3  | ExpandAll | 2            | {"orderBy": "[]"} |
+      | 2  | Expand    | 1            |                   |
+      | 1  | Start     |              |                   |
+    When profiling query:
+      """
+      GO 1 TO 2 STEPS FROM "a" OVER rate YIELD rate.score AS score, rate._dst AS dst |
+      ORDER BY $-.score DESC |
+      LIMIT 1
+      """
+    Then the result should be, in order:
+      | score | dst |
+      | 5     | "c" |
+    And the execution plan should be:
+      | id | name      | dependencies | operator info     |
+      | 7  | TopN      | 4            |                   |
+      | 4  | Project   | 3            |                   |
+      | 3  | ExpandAll | 2            | {"orderBy": "[]"} |
+      | 2  | Expand    | 1            |                   |
+      | 1  | Start     |              |                   |